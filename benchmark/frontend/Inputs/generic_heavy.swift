@@ -0,0 +1,85 @@
+// Generics-heavy input: constrained protocols, generic types, and enough
+// instantiations to exercise signature validation and specialization
+// machinery in the type checker.
+
+protocol Shape {
+  associatedtype Scalar
+  func area() -> Scalar
+}
+
+protocol Container {
+  associatedtype Element
+  var count: Int { get }
+  func element(at index: Int) -> Element
+}
+
+struct Box<T> : Container {
+  var items: [T]
+  var count: Int { return items.count }
+  func element(at index: Int) -> T { return items[index] }
+}
+
+struct Pair<A, B> {
+  var first: A
+  var second: B
+  func swapped() -> Pair<B, A> {
+    return Pair<B, A>(first: second, second: first)
+  }
+}
+
+struct Square : Shape {
+  var side: Double
+  func area() -> Double { return side * side }
+}
+
+struct Circle : Shape {
+  var radius: Double
+  func area() -> Double { return 3.14159 * radius * radius }
+}
+
+func totalArea<S : Shape where S.Scalar == Double>(shapes: [S]) -> Double {
+  var total = 0.0
+  for shape in shapes {
+    total += shape.area()
+  }
+  return total
+}
+
+func firstTwo<C : Container>(c: C) -> Pair<C.Element, C.Element> {
+  return Pair(first: c.element(at: 0), second: c.element(at: 1))
+}
+
+func zipBoxes<A, B>(a: Box<A>, _ b: Box<B>) -> [Pair<A, B>] {
+  var result: [Pair<A, B>] = []
+  var i = 0
+  while i < a.count && i < b.count {
+    result.append(Pair(first: a.element(at: i), second: b.element(at: i)))
+    i += 1
+  }
+  return result
+}
+
+extension Box where T : Shape, T.Scalar == Double {
+  func combinedArea() -> Double {
+    return totalArea(items)
+  }
+}
+
+func instantiateEverything() -> Int {
+  let ints = Box(items: [1, 2, 3])
+  let doubles = Box(items: [1.0, 2.0])
+  let strings = Box(items: ["a", "b", "c"])
+  let squares = Box(items: [Square(side: 1.0), Square(side: 2.0)])
+  let circles = Box(items: [Circle(radius: 1.0)])
+
+  let p1 = firstTwo(ints)
+  let p2 = firstTwo(doubles)
+  let p3 = firstTwo(strings)
+  let zipped = zipBoxes(ints, strings)
+  let swapped = p3.swapped()
+  let nested = Pair(first: p1, second: p2)
+
+  let areas = squares.combinedArea() + circles.combinedArea()
+  return ints.count + zipped.count + swapped.first.characters.count +
+         nested.first.first + Int(areas)
+}
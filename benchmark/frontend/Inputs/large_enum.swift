@@ -0,0 +1,474 @@
+// Large-enum input: a wide enum plus exhaustive switches, exercising
+// name lookup, exhaustiveness checking, and SILGen switch lowering.
+
+enum Inventory {
+  case RedBox
+  case RedKey
+  case RedDoor
+  case RedLamp
+  case RedStar
+  case RedTree
+  case RedRock
+  case RedWave
+  case RedCloud
+  case RedStone
+  case GreenBox
+  case GreenKey
+  case GreenDoor
+  case GreenLamp
+  case GreenStar
+  case GreenTree
+  case GreenRock
+  case GreenWave
+  case GreenCloud
+  case GreenStone
+  case BlueBox
+  case BlueKey
+  case BlueDoor
+  case BlueLamp
+  case BlueStar
+  case BlueTree
+  case BlueRock
+  case BlueWave
+  case BlueCloud
+  case BlueStone
+  case AmberBox
+  case AmberKey
+  case AmberDoor
+  case AmberLamp
+  case AmberStar
+  case AmberTree
+  case AmberRock
+  case AmberWave
+  case AmberCloud
+  case AmberStone
+  case CyanBox
+  case CyanKey
+  case CyanDoor
+  case CyanLamp
+  case CyanStar
+  case CyanTree
+  case CyanRock
+  case CyanWave
+  case CyanCloud
+  case CyanStone
+  case PlumBox
+  case PlumKey
+  case PlumDoor
+  case PlumLamp
+  case PlumStar
+  case PlumTree
+  case PlumRock
+  case PlumWave
+  case PlumCloud
+  case PlumStone
+  case JadeBox
+  case JadeKey
+  case JadeDoor
+  case JadeLamp
+  case JadeStar
+  case JadeTree
+  case JadeRock
+  case JadeWave
+  case JadeCloud
+  case JadeStone
+  case GoldBox
+  case GoldKey
+  case GoldDoor
+  case GoldLamp
+  case GoldStar
+  case GoldTree
+  case GoldRock
+  case GoldWave
+  case GoldCloud
+  case GoldStone
+  case OnyxBox
+  case OnyxKey
+  case OnyxDoor
+  case OnyxLamp
+  case OnyxStar
+  case OnyxTree
+  case OnyxRock
+  case OnyxWave
+  case OnyxCloud
+  case OnyxStone
+  case TealBox
+  case TealKey
+  case TealDoor
+  case TealLamp
+  case TealStar
+  case TealTree
+  case TealRock
+  case TealWave
+  case TealCloud
+  case TealStone
+  case CoralBox
+  case CoralKey
+  case CoralDoor
+  case CoralLamp
+  case CoralStar
+  case CoralTree
+  case CoralRock
+  case CoralWave
+  case CoralCloud
+  case CoralStone
+  case SlateBox
+  case SlateKey
+  case SlateDoor
+  case SlateLamp
+  case SlateStar
+  case SlateTree
+  case SlateRock
+  case SlateWave
+  case SlateCloud
+  case SlateStone
+  case OliveBox
+  case OliveKey
+  case OliveDoor
+  case OliveLamp
+  case OliveStar
+  case OliveTree
+  case OliveRock
+  case OliveWave
+  case OliveCloud
+  case OliveStone
+  case PearlBox
+  case PearlKey
+  case PearlDoor
+  case PearlLamp
+  case PearlStar
+  case PearlTree
+  case PearlRock
+  case PearlWave
+  case PearlCloud
+  case PearlStone
+  case IvoryBox
+  case IvoryKey
+  case IvoryDoor
+  case IvoryLamp
+  case IvoryStar
+  case IvoryTree
+  case IvoryRock
+  case IvoryWave
+  case IvoryCloud
+  case IvoryStone
+}
+
+func weight(item: Inventory) -> Int {
+  switch item {
+  case .RedBox: return 0
+  case .RedKey: return 1
+  case .RedDoor: return 2
+  case .RedLamp: return 3
+  case .RedStar: return 4
+  case .RedTree: return 5
+  case .RedRock: return 6
+  case .RedWave: return 7
+  case .RedCloud: return 8
+  case .RedStone: return 9
+  case .GreenBox: return 10
+  case .GreenKey: return 11
+  case .GreenDoor: return 12
+  case .GreenLamp: return 13
+  case .GreenStar: return 14
+  case .GreenTree: return 15
+  case .GreenRock: return 16
+  case .GreenWave: return 17
+  case .GreenCloud: return 18
+  case .GreenStone: return 19
+  case .BlueBox: return 20
+  case .BlueKey: return 21
+  case .BlueDoor: return 22
+  case .BlueLamp: return 23
+  case .BlueStar: return 24
+  case .BlueTree: return 25
+  case .BlueRock: return 26
+  case .BlueWave: return 27
+  case .BlueCloud: return 28
+  case .BlueStone: return 29
+  case .AmberBox: return 30
+  case .AmberKey: return 31
+  case .AmberDoor: return 32
+  case .AmberLamp: return 33
+  case .AmberStar: return 34
+  case .AmberTree: return 35
+  case .AmberRock: return 36
+  case .AmberWave: return 37
+  case .AmberCloud: return 38
+  case .AmberStone: return 39
+  case .CyanBox: return 40
+  case .CyanKey: return 41
+  case .CyanDoor: return 42
+  case .CyanLamp: return 43
+  case .CyanStar: return 44
+  case .CyanTree: return 45
+  case .CyanRock: return 46
+  case .CyanWave: return 47
+  case .CyanCloud: return 48
+  case .CyanStone: return 49
+  case .PlumBox: return 50
+  case .PlumKey: return 51
+  case .PlumDoor: return 52
+  case .PlumLamp: return 53
+  case .PlumStar: return 54
+  case .PlumTree: return 55
+  case .PlumRock: return 56
+  case .PlumWave: return 57
+  case .PlumCloud: return 58
+  case .PlumStone: return 59
+  case .JadeBox: return 60
+  case .JadeKey: return 61
+  case .JadeDoor: return 62
+  case .JadeLamp: return 63
+  case .JadeStar: return 64
+  case .JadeTree: return 65
+  case .JadeRock: return 66
+  case .JadeWave: return 67
+  case .JadeCloud: return 68
+  case .JadeStone: return 69
+  case .GoldBox: return 70
+  case .GoldKey: return 71
+  case .GoldDoor: return 72
+  case .GoldLamp: return 73
+  case .GoldStar: return 74
+  case .GoldTree: return 75
+  case .GoldRock: return 76
+  case .GoldWave: return 77
+  case .GoldCloud: return 78
+  case .GoldStone: return 79
+  case .OnyxBox: return 80
+  case .OnyxKey: return 81
+  case .OnyxDoor: return 82
+  case .OnyxLamp: return 83
+  case .OnyxStar: return 84
+  case .OnyxTree: return 85
+  case .OnyxRock: return 86
+  case .OnyxWave: return 87
+  case .OnyxCloud: return 88
+  case .OnyxStone: return 89
+  case .TealBox: return 90
+  case .TealKey: return 91
+  case .TealDoor: return 92
+  case .TealLamp: return 93
+  case .TealStar: return 94
+  case .TealTree: return 95
+  case .TealRock: return 96
+  case .TealWave: return 97
+  case .TealCloud: return 98
+  case .TealStone: return 99
+  case .CoralBox: return 100
+  case .CoralKey: return 101
+  case .CoralDoor: return 102
+  case .CoralLamp: return 103
+  case .CoralStar: return 104
+  case .CoralTree: return 105
+  case .CoralRock: return 106
+  case .CoralWave: return 107
+  case .CoralCloud: return 108
+  case .CoralStone: return 109
+  case .SlateBox: return 110
+  case .SlateKey: return 111
+  case .SlateDoor: return 112
+  case .SlateLamp: return 113
+  case .SlateStar: return 114
+  case .SlateTree: return 115
+  case .SlateRock: return 116
+  case .SlateWave: return 117
+  case .SlateCloud: return 118
+  case .SlateStone: return 119
+  case .OliveBox: return 120
+  case .OliveKey: return 121
+  case .OliveDoor: return 122
+  case .OliveLamp: return 123
+  case .OliveStar: return 124
+  case .OliveTree: return 125
+  case .OliveRock: return 126
+  case .OliveWave: return 127
+  case .OliveCloud: return 128
+  case .OliveStone: return 129
+  case .PearlBox: return 130
+  case .PearlKey: return 131
+  case .PearlDoor: return 132
+  case .PearlLamp: return 133
+  case .PearlStar: return 134
+  case .PearlTree: return 135
+  case .PearlRock: return 136
+  case .PearlWave: return 137
+  case .PearlCloud: return 138
+  case .PearlStone: return 139
+  case .IvoryBox: return 140
+  case .IvoryKey: return 141
+  case .IvoryDoor: return 142
+  case .IvoryLamp: return 143
+  case .IvoryStar: return 144
+  case .IvoryTree: return 145
+  case .IvoryRock: return 146
+  case .IvoryWave: return 147
+  case .IvoryCloud: return 148
+  case .IvoryStone: return 149
+  }
+}
+
+func label(item: Inventory) -> String {
+  switch item {
+  case .RedBox: return "RedBox"
+  case .RedKey: return "RedKey"
+  case .RedDoor: return "RedDoor"
+  case .RedLamp: return "RedLamp"
+  case .RedStar: return "RedStar"
+  case .RedTree: return "RedTree"
+  case .RedRock: return "RedRock"
+  case .RedWave: return "RedWave"
+  case .RedCloud: return "RedCloud"
+  case .RedStone: return "RedStone"
+  case .GreenBox: return "GreenBox"
+  case .GreenKey: return "GreenKey"
+  case .GreenDoor: return "GreenDoor"
+  case .GreenLamp: return "GreenLamp"
+  case .GreenStar: return "GreenStar"
+  case .GreenTree: return "GreenTree"
+  case .GreenRock: return "GreenRock"
+  case .GreenWave: return "GreenWave"
+  case .GreenCloud: return "GreenCloud"
+  case .GreenStone: return "GreenStone"
+  case .BlueBox: return "BlueBox"
+  case .BlueKey: return "BlueKey"
+  case .BlueDoor: return "BlueDoor"
+  case .BlueLamp: return "BlueLamp"
+  case .BlueStar: return "BlueStar"
+  case .BlueTree: return "BlueTree"
+  case .BlueRock: return "BlueRock"
+  case .BlueWave: return "BlueWave"
+  case .BlueCloud: return "BlueCloud"
+  case .BlueStone: return "BlueStone"
+  case .AmberBox: return "AmberBox"
+  case .AmberKey: return "AmberKey"
+  case .AmberDoor: return "AmberDoor"
+  case .AmberLamp: return "AmberLamp"
+  case .AmberStar: return "AmberStar"
+  case .AmberTree: return "AmberTree"
+  case .AmberRock: return "AmberRock"
+  case .AmberWave: return "AmberWave"
+  case .AmberCloud: return "AmberCloud"
+  case .AmberStone: return "AmberStone"
+  case .CyanBox: return "CyanBox"
+  case .CyanKey: return "CyanKey"
+  case .CyanDoor: return "CyanDoor"
+  case .CyanLamp: return "CyanLamp"
+  case .CyanStar: return "CyanStar"
+  case .CyanTree: return "CyanTree"
+  case .CyanRock: return "CyanRock"
+  case .CyanWave: return "CyanWave"
+  case .CyanCloud: return "CyanCloud"
+  case .CyanStone: return "CyanStone"
+  case .PlumBox: return "PlumBox"
+  case .PlumKey: return "PlumKey"
+  case .PlumDoor: return "PlumDoor"
+  case .PlumLamp: return "PlumLamp"
+  case .PlumStar: return "PlumStar"
+  case .PlumTree: return "PlumTree"
+  case .PlumRock: return "PlumRock"
+  case .PlumWave: return "PlumWave"
+  case .PlumCloud: return "PlumCloud"
+  case .PlumStone: return "PlumStone"
+  case .JadeBox: return "JadeBox"
+  case .JadeKey: return "JadeKey"
+  case .JadeDoor: return "JadeDoor"
+  case .JadeLamp: return "JadeLamp"
+  case .JadeStar: return "JadeStar"
+  case .JadeTree: return "JadeTree"
+  case .JadeRock: return "JadeRock"
+  case .JadeWave: return "JadeWave"
+  case .JadeCloud: return "JadeCloud"
+  case .JadeStone: return "JadeStone"
+  case .GoldBox: return "GoldBox"
+  case .GoldKey: return "GoldKey"
+  case .GoldDoor: return "GoldDoor"
+  case .GoldLamp: return "GoldLamp"
+  case .GoldStar: return "GoldStar"
+  case .GoldTree: return "GoldTree"
+  case .GoldRock: return "GoldRock"
+  case .GoldWave: return "GoldWave"
+  case .GoldCloud: return "GoldCloud"
+  case .GoldStone: return "GoldStone"
+  case .OnyxBox: return "OnyxBox"
+  case .OnyxKey: return "OnyxKey"
+  case .OnyxDoor: return "OnyxDoor"
+  case .OnyxLamp: return "OnyxLamp"
+  case .OnyxStar: return "OnyxStar"
+  case .OnyxTree: return "OnyxTree"
+  case .OnyxRock: return "OnyxRock"
+  case .OnyxWave: return "OnyxWave"
+  case .OnyxCloud: return "OnyxCloud"
+  case .OnyxStone: return "OnyxStone"
+  case .TealBox: return "TealBox"
+  case .TealKey: return "TealKey"
+  case .TealDoor: return "TealDoor"
+  case .TealLamp: return "TealLamp"
+  case .TealStar: return "TealStar"
+  case .TealTree: return "TealTree"
+  case .TealRock: return "TealRock"
+  case .TealWave: return "TealWave"
+  case .TealCloud: return "TealCloud"
+  case .TealStone: return "TealStone"
+  case .CoralBox: return "CoralBox"
+  case .CoralKey: return "CoralKey"
+  case .CoralDoor: return "CoralDoor"
+  case .CoralLamp: return "CoralLamp"
+  case .CoralStar: return "CoralStar"
+  case .CoralTree: return "CoralTree"
+  case .CoralRock: return "CoralRock"
+  case .CoralWave: return "CoralWave"
+  case .CoralCloud: return "CoralCloud"
+  case .CoralStone: return "CoralStone"
+  case .SlateBox: return "SlateBox"
+  case .SlateKey: return "SlateKey"
+  case .SlateDoor: return "SlateDoor"
+  case .SlateLamp: return "SlateLamp"
+  case .SlateStar: return "SlateStar"
+  case .SlateTree: return "SlateTree"
+  case .SlateRock: return "SlateRock"
+  case .SlateWave: return "SlateWave"
+  case .SlateCloud: return "SlateCloud"
+  case .SlateStone: return "SlateStone"
+  case .OliveBox: return "OliveBox"
+  case .OliveKey: return "OliveKey"
+  case .OliveDoor: return "OliveDoor"
+  case .OliveLamp: return "OliveLamp"
+  case .OliveStar: return "OliveStar"
+  case .OliveTree: return "OliveTree"
+  case .OliveRock: return "OliveRock"
+  case .OliveWave: return "OliveWave"
+  case .OliveCloud: return "OliveCloud"
+  case .OliveStone: return "OliveStone"
+  case .PearlBox: return "PearlBox"
+  case .PearlKey: return "PearlKey"
+  case .PearlDoor: return "PearlDoor"
+  case .PearlLamp: return "PearlLamp"
+  case .PearlStar: return "PearlStar"
+  case .PearlTree: return "PearlTree"
+  case .PearlRock: return "PearlRock"
+  case .PearlWave: return "PearlWave"
+  case .PearlCloud: return "PearlCloud"
+  case .PearlStone: return "PearlStone"
+  case .IvoryBox: return "IvoryBox"
+  case .IvoryKey: return "IvoryKey"
+  case .IvoryDoor: return "IvoryDoor"
+  case .IvoryLamp: return "IvoryLamp"
+  case .IvoryStar: return "IvoryStar"
+  case .IvoryTree: return "IvoryTree"
+  case .IvoryRock: return "IvoryRock"
+  case .IvoryWave: return "IvoryWave"
+  case .IvoryCloud: return "IvoryCloud"
+  case .IvoryStone: return "IvoryStone"
+  }
+}
+
+func total() -> Int {
+  let sample: [Inventory] = [.RedBox, .GreenWave, .CyanStone, .OnyxCloud, .IvoryStone]
+  var sum = 0
+  for item in sample {
+    sum += weight(item) + label(item).characters.count
+  }
+  return sum
+}
@@ -0,0 +1,53 @@
+// Expression-checker-heavy input: literal-rich expressions and closures
+// whose types the constraint solver has to infer.
+
+func mixedArithmetic() -> Double {
+  let a = 1 + 2 * 3 - 4 / 2 + 5 % 3
+  let b = 1.5 * 2.0 + 3.25 - 0.75 / 0.5
+  let c = Double(a) + b * 2.0 - 1.0 / 4.0
+  let d = c + Double(a * a) - b * b + 0.125
+  let e = (d + 1.0) * (d - 1.0) + (b + 2.0) * (b - 2.0)
+  return e + c + b + Double(a)
+}
+
+func literalCollections() -> Int {
+  let xs = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]
+  let ys = [1.0, 2.5, 3.75, 4.125, 5.0625]
+  let pairs = [(1, "one"), (2, "two"), (3, "three"), (4, "four")]
+  let table = [1: "one", 2: "two", 3: "three", 4: "four", 5: "five"]
+  let nested = [[1, 2], [3, 4], [5, 6], [7, 8]]
+  var total = 0
+  for x in xs { total += x }
+  for y in ys { total += Int(y) }
+  for (n, _) in pairs { total += n }
+  for (k, _) in table { total += k }
+  for row in nested { for x in row { total += x } }
+  return total
+}
+
+func closureInference() -> Int {
+  let xs = [5, 3, 8, 1, 9, 2, 7, 4, 6]
+  let doubled = xs.map { $0 * 2 }
+  let odds = xs.filter { $0 % 2 == 1 }
+  let sum = xs.reduce(0) { $0 + $1 }
+  let scaled = xs.map { x in x * x + 1 }
+  let chained = xs.map { $0 + 1 }.filter { $0 > 3 }.reduce(0, combine: +)
+  return doubled.count + odds.count + sum + scaled.count + chained
+}
+
+func ternariesAndCoercions(flag: Bool) -> Double {
+  let a = flag ? 1 : 2
+  let b = flag ? 1.5 : 2.5
+  let c = flag ? a : a + 1
+  let d = flag ? b + 1.0 : b - 1.0
+  let e = Double(flag ? c * 2 : c * 3) + (flag ? d : -d)
+  return e + (flag ? 0.5 : 1.5)
+}
+
+func optionalChains(x: Int?, y: Int?) -> Int {
+  let a = x ?? 0
+  let b = y ?? a
+  let c = (x ?? 1) + (y ?? 2) + a + b
+  let d = x.map { $0 + 1 } ?? c
+  return a + b + c + d
+}
@@ -0,0 +1,50 @@
+// String-literal-heavy input: lots of literals, interpolation, and
+// concatenation, exercising literal protocol conformance lookup and
+// string lowering in SILGen.
+
+let colorNames = [
+  "alabaster", "amber", "amethyst", "aqua", "azure", "beige", "bronze",
+  "burgundy", "cerulean", "charcoal", "chartreuse", "cobalt", "copper",
+  "coral", "crimson", "cyan", "ebony", "emerald", "fuchsia", "gold",
+  "indigo", "ivory", "jade", "lavender", "magenta", "maroon", "mauve",
+  "ochre", "olive", "onyx", "orchid", "pearl", "periwinkle", "plum",
+  "russet", "saffron", "sapphire", "scarlet", "sepia", "sienna", "silver",
+  "slate", "teal", "topaz", "turquoise", "ultramarine", "umber", "vermilion",
+  "violet", "viridian",
+]
+
+let greetings = [
+  "en": "Hello, world!",
+  "fr": "Bonjour tout le monde !",
+  "de": "Hallo, Welt!",
+  "es": "¡Hola, mundo!",
+  "it": "Ciao, mondo!",
+  "pt": "Olá, mundo!",
+  "ja": "こんにちは世界",
+  "ko": "안녕하세요 세계",
+  "ru": "Привет, мир!",
+  "el": "Γειά σου, κόσμε!",
+]
+
+func describe(name: String, index: Int) -> String {
+  let header = "== entry \(index): \(name) =="
+  let body = "the color \(name) has \(name.characters.count) letters"
+  let footer = "-- end of \(name) (\(index + 1) of \(colorNames.count)) --"
+  return header + "\n" + body + "\n" + footer + "\n"
+}
+
+func catalog() -> String {
+  var result = "catalog of \(colorNames.count) colors:\n"
+  var index = 0
+  for name in colorNames {
+    result += describe(name, index: index)
+    index += 1
+  }
+  for (code, greeting) in greetings {
+    result += "[\(code)] \(greeting)\n"
+  }
+  result += "escapes: \t tab, \n newline, \\ backslash, \" quote, \u{1F600}\n"
+  result += "done: " + String(index) + " entries, " +
+            String(greetings.count) + " greetings"
+  return result
+}
@@ -0,0 +1,42 @@
+// Corpus file for the SourceKit editing-session benchmark.  The recorded
+// session in editor_session.session refers to byte offsets in this file;
+// keep the two in sync when editing either one.
+
+struct Point {
+  var x: Double
+  var y: Double
+
+  func squaredDistanceTo(other: Point) -> Double {
+    let dx = x - other.x
+    let dy = y - other.y
+    return dx * dx + dy * dy
+  }
+}
+
+class PathBuilder {
+  private var points: [Point] = []
+
+  var count: Int {
+    return points.count
+  }
+
+  func add(point: Point) {
+    points.append(point)
+  }
+
+  func totalSquaredLength() -> Double {
+    var length = 0.0
+    var previous: Point? = nil
+    for point in points {
+      if let from = previous {
+        length += from.squaredDistanceTo(point)
+      }
+      previous = point
+    }
+    return length
+  }
+}
+
+func describe(builder: PathBuilder) -> String {
+  return "path with \(builder.count) points"
+}
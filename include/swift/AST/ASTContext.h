@@ -352,6 +352,31 @@ public:
   /// specified string.
   Identifier getIdentifier(StringRef Str) const;
 
+  /// \name Qualified lookup memoization
+  ///
+  /// DeclContext::lookupQualified memoizes the transitive superclass and
+  /// protocol expansion it computes for a nominal type, since completion and
+  /// type checking repeat the same lookups constantly. Entries are
+  /// invalidated wholesale whenever any type gains an extension or a
+  /// conformance, because either can change an expansion.
+  /// @{
+
+  /// Retrieve the memoized qualified-lookup expansion for \p nominal with
+  /// the given lookup options, or None if none is cached.
+  Optional<ArrayRef<NominalTypeDecl *>>
+  getQualifiedLookupExpansion(NominalTypeDecl *nominal,
+                              unsigned lookupOptions);
+
+  /// Memoize the qualified-lookup expansion for \p nominal.
+  void setQualifiedLookupExpansion(NominalTypeDecl *nominal,
+                                   unsigned lookupOptions,
+                                   ArrayRef<NominalTypeDecl *> types);
+
+  /// Invalidate all memoized qualified-lookup expansions.
+  void invalidateQualifiedLookupExpansions();
+
+  /// @}
+
   /// Retrieve the declaration of Swift.ErrorType.
   NominalTypeDecl *getExceptionTypeDecl() const;
   CanType getExceptionType() const;
@@ -798,11 +823,14 @@ public:
   ArchetypeBuilder *getOrCreateArchetypeBuilder(CanGenericSignature sig,
                                                 ModuleDecl *mod);
 
-  /// Set the stored archetype builder for the given canonical generic
-  /// signature and module.
-  void setArchetypeBuilder(CanGenericSignature sig,
-                           ModuleDecl *mod,
-                           std::unique_ptr<ArchetypeBuilder> builder);
+  /// Release any stored archetype builders that are no longer referenced
+  /// by a lazily-resolved archetype.
+  ///
+  /// The stored builders are only a cache; a released builder is simply
+  /// recreated from its generic signature if it is ever requested again.
+  /// This is useful once type checking has finished, when most builders
+  /// will never be touched again.
+  void releaseUnreferencedArchetypeBuilders();
 
   /// Retrieve the inherited name set for the given class.
   const InheritedNameSet *getAllPropertyNames(ClassDecl *classDecl,
@@ -813,6 +841,14 @@ public:
                             clang::ObjCInterfaceDecl *classDecl,
                             bool forInstance);
 
+  /// Retrieve the USR cached for the given declaration, if it has already
+  /// been computed.
+  Optional<StringRef> getUSR(const Decl *D);
+
+  /// Cache the USR computed for the given declaration. The string is copied
+  /// into the ASTContext's allocator.
+  void setUSR(const Decl *D, StringRef USR);
+
 private:
   friend class Decl;
   Optional<RawComment> getRawComment(const Decl *D);
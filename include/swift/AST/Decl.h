@@ -3225,6 +3225,11 @@ public:
     LazySemanticInfo.Superclass.setPointerAndInt(superclass, true);
   }
 
+  /// Whether the superclass (or the lack of one) has been computed yet.
+  bool isSuperclassComputed() const {
+    return LazySemanticInfo.Superclass.getInt();
+  }
+
   /// Retrieve the status of circularity checking for class inheritance.
   CircularityCheck getCircularityCheck() const {
     return static_cast<CircularityCheck>(ClassDeclBits.Circularity);
@@ -123,6 +123,10 @@ public:
   /// Instrument code to generate profiling information.
   unsigned GenerateProfile : 1;
 
+  /// Path to LLVM profile data used to order the method table entries of
+  /// module-private classes by observed call frequency.  Empty if unused.
+  std::string VTableLayoutProfilePath;
+
   /// Whether we should embed the bitcode file.
   IRGenEmbedMode EmbedMode : 2;
 
@@ -17,8 +17,11 @@
 #ifndef SWIFT_AST_LAZYRESOLVER_H
 #define SWIFT_AST_LAZYRESOLVER_H
 
+#include "swift/AST/Identifier.h"
 #include "swift/AST/TypeLoc.h"
 #include "llvm/ADT/Fixnum.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/TinyPtrVector.h"
 
 namespace swift {
 
@@ -138,6 +141,19 @@ public:
     llvm_unreachable("unimplemented");
   }
 
+  /// Attempts to load only the members of \p D whose name has the given
+  /// base name.
+  ///
+  /// Returns None if this loader cannot answer per-name queries for \p D,
+  /// in which case the caller should fall back to loadAllMembers(). Unlike
+  /// loadAllMembers(), the returned declarations are \em not added to \p D's
+  /// member list; they are only guaranteed to have \p D as their declaration
+  /// context.
+  virtual Optional<TinyPtrVector<ValueDecl *>>
+  loadNamedMembers(const Decl *D, DeclName name, uint64_t contextData) {
+    return None;
+  }
+
   /// Populates the given vector with all conformances for \p D.
   ///
   /// The implementation should \em not call setConformances on \p D.
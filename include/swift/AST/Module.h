@@ -27,6 +27,7 @@
 #include "swift/Basic/STLExtras.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
@@ -224,6 +225,14 @@ private:
 
   SmallVector<FileUnit *, 2> Files;
 
+  /// A cache of this module's imports for name lookup, populated the first
+  /// time \c getImportedModulesForLookup walks the files.
+  ///
+  /// This is only used for modules without source files, whose imports never
+  /// change. The module currently being compiled (and the REPL's module)
+  /// picks up new imports as files are added to it.
+  mutable Optional<ArrayRef<ImportedModule>> ImportedModulesForLookupCache;
+
   /// Tracks the file that will generate the module's entry point, either
   /// because it contains a class marked with \@UIApplicationMain
   /// or \@NSApplicationMain, or because it is a script file.
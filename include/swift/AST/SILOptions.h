@@ -100,6 +100,13 @@ public:
 
   /// Use super_method for native super method calls instead of function_ref.
   bool UseNativeSuperMethod = false;
+
+  /// If true, SILGen delays emitting any function definition that cannot be
+  /// referenced from outside the emission unit until it is first referenced,
+  /// so bodies unreachable from external entry points, vtables, witness
+  /// tables and @objc thunks are never lowered.  Bodies that are never
+  /// forced do not get SIL diagnostics.
+  bool EmitReachableFunctionsOnly = false;
 };
 
 } // end namespace swift
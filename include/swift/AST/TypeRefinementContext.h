@@ -161,6 +161,11 @@ private:
                         TypeRefinementContext *Parent, SourceRange SrcRange,
                         const VersionRange &Versions);
 
+  /// Returns the child whose refined range contains the given source
+  /// location, or null if no child's range contains it.
+  TypeRefinementContext *findChildContaining(SourceLoc Loc,
+                                             SourceManager &SM);
+
 public:
   
   /// Create the root refinement context for the given SourceFile.
@@ -233,17 +238,20 @@ public:
   /// versions on which the code contained in this context may run.
   const VersionRange &getPotentialVersions() const { return PotentialVersions; }
 
-  /// Adds a child refinement context.
-  void addChild(TypeRefinementContext *Child) {
-    assert(Child->getSourceRange().isValid());
-    Children.push_back(Child);
-  }
+  /// Adds a child refinement context, keeping the children sorted by the
+  /// start of their refined source ranges.
+  void addChild(TypeRefinementContext *Child);
 
   /// Returns the inner-most TypeRefinementContext descendant of this context
   /// for the given source location.
   TypeRefinementContext *findMostRefinedSubContext(SourceLoc Loc,
                                                    SourceManager &SM);
 
+  /// Returns true if this context is the inner-most context for the given
+  /// source location, i.e. its range contains the location but no child's
+  /// range does.
+  bool isMostRefinedSubContextFor(SourceLoc Loc, SourceManager &SM);
+
   LLVM_ATTRIBUTE_DEPRECATED(
       void dump(SourceManager &SrcMgr) const LLVM_ATTRIBUTE_USED,
       "only for use within the debugger");
@@ -159,6 +159,15 @@ private:
   typedef std::vector<NodePointer> NodeVector;
   NodeVector Children;
 
+  Node(const Node &) = delete;
+  Node &operator=(const Node &) = delete;
+
+  friend struct NodeFactory;
+
+public:
+  // The constructors are public so that NodeFactory can allocate the node
+  // and its reference count together with std::make_shared; use
+  // NodeFactory::create() instead of constructing nodes directly.
   Node(Kind k)
       : NodeKind(k), NodePayloadKind(PayloadKind::None) {
   }
@@ -170,12 +179,6 @@ private:
       : NodeKind(k), NodePayloadKind(PayloadKind::Index) {
     IndexPayload = index;
   }
-  Node(const Node &) = delete;
-  Node &operator=(const Node &) = delete;
-
-  friend struct NodeFactory;
-
-public:
   ~Node();
 
   Kind getKind() const { return NodeKind; }
@@ -266,6 +269,17 @@ std::string
 demangleSymbolAsString(const char *mangledName, size_t mangledNameLength,
                        const DemangleOptions &options = DemangleOptions());
 
+/// \brief Demangle the given string as a Swift symbol, appending the result
+/// to \p out.
+///
+/// This is the buffer-reuse form of demangleSymbolAsString, for callers that
+/// demangle many symbols in a loop. If the name cannot be demangled, the
+/// mangled name itself is appended instead.
+void
+demangleSymbolAsString(const char *mangledName, size_t mangledNameLength,
+                       std::string &out,
+                       const DemangleOptions &options = DemangleOptions());
+
 inline std::string
 demangleSymbolAsString(const std::string &mangledName,
                        const DemangleOptions &options = DemangleOptions()) {
@@ -348,22 +362,32 @@ std::string mangleNode(const NodePointer &root);
 std::string nodeToString(NodePointer Root,
                          const DemangleOptions &Options = DemangleOptions());
 
+/// \brief Transform the node structure in a string, appending the result to
+/// \p Out.
+///
+/// This is the buffer-reuse form of nodeToString, for callers that print
+/// many demanglings in a loop.
+void nodeToString(NodePointer Root, std::string &Out,
+                  const DemangleOptions &Options = DemangleOptions());
+
 struct NodeFactory {
+  // std::make_shared allocates the node and its reference count in a single
+  // allocation, which matters when demangling in bulk.
   static NodePointer create(Node::Kind K) {
-    return NodePointer(new Node(K));
+    return std::make_shared<Node>(K);
   }
   static NodePointer create(Node::Kind K, Node::IndexType Index) {
-    return NodePointer(new Node(K, Index));
+    return std::make_shared<Node>(K, Index);
   }
   static NodePointer create(Node::Kind K, llvm::StringRef Text) {
-    return NodePointer(new Node(K, Text));
+    return std::make_shared<Node>(K, Text.str());
   }
   static NodePointer create(Node::Kind K, std::string &&Text) {
-    return NodePointer(new Node(K, std::move(Text)));
+    return std::make_shared<Node>(K, std::move(Text));
   }
   template <size_t N>
   static NodePointer create(Node::Kind K, const char (&Text)[N]) {
-    return NodePointer(new Node(K, llvm::StringRef(Text)));
+    return std::make_shared<Node>(K, std::string(Text));
   }
 };
 
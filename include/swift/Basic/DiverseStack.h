@@ -15,6 +15,13 @@
 // be trivially movable, meaning that it has a trivial move
 // constructor and a trivial destructor.
 //
+// The stack is backed by a chain of geometrically growing segments.
+// Growing never moves the objects already on the stack: a new segment
+// is chained in front of the full ones instead.  Within a segment,
+// objects are contiguous and iteration is a linear walk; crossing a
+// segment boundary is a pointer chase, but with geometric growth there
+// are only ever a handful of segments.
+//
 //===----------------------------------------------------------------------===//
 
 #ifndef SWIFT_IRGEN_DIVERSESTACK_H
@@ -53,15 +60,55 @@ public:
 /// A base class for DiverseStackImpl.
 class DiverseStackBase {
 public:
+  /// The header of a stack segment.  For heap segments the storage
+  /// directly follows the header in the same allocation; the descriptor
+  /// of a spilled inline buffer is allocated separately and points into
+  /// the buffer.
+  ///
+  /// While a segment is the top of the stack it is described by the
+  /// Begin/End/Allocated members below; its header fields are only
+  /// filled in when the stack grows past it.
+  struct Chunk {
+    /// The next older segment, or null if this is the bottom one.
+    Chunk *Older;
+
+    /// The top of the filled region.  Objects fill the segment from
+    /// End downwards, so the filled region is [Begin, End).
+    char *Begin;
+
+    /// The end of the filled region, which for a frozen segment is
+    /// also the end of its storage.
+    char *End;
+
+    /// Whether the storage follows this header in one heap allocation.
+    bool HeapStorage;
+
+    char *getStorage() { return reinterpret_cast<char *>(this + 1); }
+  };
+  static_assert(sizeof(Chunk) % 16 == 0,
+                "chunk storage would not be sufficiently aligned");
+
   /// The top of the stack.
   char *Begin;
 
-  /// The bottom of the stack, i.e. the end of the allocation.
+  /// The bottom of the top segment, i.e. the end of its allocation.
   char *End;
 
-  /// The beginning of the allocation.
+  /// The beginning of the top segment's allocation.
   char *Allocated;
 
+  /// Older, frozen segments, newest first.  Only the top segment is
+  /// ever pushed to or popped from; older segments are never empty.
+  Chunk *Older;
+
+  /// The total number of bytes stored in older segments.
+  std::size_t OlderBytes;
+
+  /// The most recently emptied heap segment, kept for reuse so that
+  /// push/pop sequences at a segment boundary do not thrash the
+  /// allocator.
+  Chunk *Spare;
+
   bool isAllocatedInline() const {
     return (Allocated == reinterpret_cast<const char *>(this + 1));
   }
@@ -74,12 +121,45 @@ public:
   void initialize(char *end) {
     Begin = End = end;
     Allocated = reinterpret_cast<char*>(this + 1);
+    Older = nullptr;
+    OlderBytes = 0;
+    Spare = nullptr;
+  }
+
+  /// The total number of bytes stored on the stack.
+  std::size_t totalSize() const {
+    return std::size_t(End - Begin) + OlderBytes;
+  }
+
+  /// Returns true if any of the stack's segments is backed by the
+  /// inline buffer.
+  bool hasInlineBackedSegment() const {
+    if (isAllocatedInline())
+      return true;
+    for (Chunk *c = Older; c; c = c->Older)
+      if (!c->HeapStorage)
+        return true;
+    return false;
   }
+
   void copyFrom(const DiverseStackBase &other) {
-    // Ensure that we're large enough to store all the data.
-    std::size_t size = static_cast<std::size_t>(other.End - other.Begin);
+    // Ensure that we're large enough to store all the data in a single
+    // segment.
+    std::size_t size = other.totalSize();
     pushNewStorage(size);
-    std::memcpy(Begin, other.Begin, size);
+
+    // Copy the other stack's segments from the top down; the result is
+    // contiguous even if the source was not.
+    char *dest = Begin;
+    std::size_t topSize = std::size_t(other.End - other.Begin);
+    std::memcpy(dest, other.Begin, topSize);
+    dest += topSize;
+    for (Chunk *c = other.Older; c; c = c->Older) {
+      std::size_t chunkSize = std::size_t(c->End - c->Begin);
+      std::memcpy(dest, c->Begin, chunkSize);
+      dest += chunkSize;
+    }
+    assert(dest == Begin + size);
   }
   void pushNewStorage(std::size_t needed) {
     checkValid();
@@ -91,6 +171,13 @@ public:
   }
   void pushNewStorageSlow(std::size_t needed);
 
+  /// Release the emptied top segment and make the next older segment
+  /// the top of the stack again.
+  void popSegmentSlow();
+
+  /// Free all heap allocations owned by the stack.
+  void destroyStorage();
+
   /// A stable iterator is the equivalent of an index into the stack.
   /// It's an iterator that stays stable across modification of the
   /// stack.
@@ -116,7 +203,7 @@ public:
     }
   };
   stable_iterator stable_begin() const {
-    return stable_iterator(End - Begin);
+    return stable_iterator(totalSize());
   }
   static stable_iterator stable_end() {
     return stable_iterator(0);
@@ -125,7 +212,47 @@ public:
   void checkIterator(stable_iterator it) const {
     assert(it.isValid() && "checking an invalid iterator");
     checkValid();
-    assert(it.Depth <= size_t(End - Begin));
+    assert(it.Depth <= totalSize());
+  }
+
+protected:
+  /// The position of an object on the stack, together with enough of
+  /// the segment structure to keep walking towards the bottom.
+  struct SegmentPosition {
+    char *Ptr;
+    char *SegmentEnd;
+    Chunk *NextOlder;
+  };
+
+  /// Map a stable iterator to the position of the object it refers to.
+  SegmentPosition findPosition(stable_iterator it) const {
+    checkIterator(it);
+    std::size_t depth = it.Depth;
+    if (depth == 0)
+      return { nullptr, nullptr, nullptr };
+
+    std::size_t below = OlderBytes;
+    if (depth > below)
+      return { End - (depth - below), End, Older };
+    for (Chunk *c = Older; c; c = c->Older) {
+      below -= std::size_t(c->End - c->Begin);
+      if (depth > below)
+        return { c->End - (depth - below), c->End, c->Older };
+    }
+    assert(false && "stable iterator does not refer into the stack");
+    return { nullptr, nullptr, nullptr };
+  }
+
+  /// Compute the depth of a position, i.e. the number of bytes between
+  /// it and the bottom of the stack.
+  std::size_t depthOfPosition(const char *ptr, const char *segmentEnd,
+                              const Chunk *nextOlder) const {
+    if (!ptr)
+      return 0;
+    std::size_t depth = std::size_t(segmentEnd - ptr);
+    for (const Chunk *c = nextOlder; c; c = c->Older)
+      depth += std::size_t(c->End - c->Begin);
+    return depth;
   }
 };
 
@@ -143,8 +270,9 @@ protected:
     copyFrom(other);
   }
   DiverseStackImpl(DiverseStackImpl<T> &&other, char *end) {
-    // If the other is allocated inline, just initialize and copy.
-    if (other.isAllocatedInline()) {
+    // If any of the other's segments is backed by its inline buffer,
+    // just initialize and copy.
+    if (other.hasInlineBackedSegment()) {
       initialize(end);
       copyFrom(other);
       return;
@@ -154,20 +282,27 @@ protected:
     Begin = other.Begin;
     End = other.End;
     Allocated = other.Allocated;
+    Older = other.Older;
+    OlderBytes = other.OlderBytes;
+    Spare = other.Spare;
     other.Begin = other.End = other.Allocated = (char*) (&other + 1);
+    other.Older = nullptr;
+    other.OlderBytes = 0;
+    other.Spare = nullptr;
     assert(other.isAllocatedInline());
   }
-  
+
 public:
   ~DiverseStackImpl() {
     checkValid();
-    if (!isAllocatedInline())
-      delete[] Allocated;
+    destroyStorage();
   }
 
   /// Query whether the stack is empty.
   bool empty() const {
     checkValid();
+    // Older segments are never empty, so an empty top segment means an
+    // empty stack.
     return Begin == End;
   }
 
@@ -190,9 +325,26 @@ public:
   class const_iterator;
   class iterator {
     char *Ptr;
+    char *SegmentEnd;
+    DiverseStackBase::Chunk *NextOlder;
     friend class DiverseStackImpl;
     friend class const_iterator;
-    iterator(char *ptr) : Ptr(ptr) {}
+    iterator(char *ptr, char *segmentEnd,
+             DiverseStackBase::Chunk *nextOlder)
+      : Ptr(ptr), SegmentEnd(segmentEnd), NextOlder(nextOlder) {}
+
+    /// Move to the next older segment once the current one has been
+    /// walked completely, or become the end iterator.
+    void crossSegmentBoundary() {
+      assert(Ptr == SegmentEnd);
+      if (auto *c = NextOlder) {
+        Ptr = c->Begin;
+        SegmentEnd = c->End;
+        NextOlder = c->Older;
+      } else {
+        Ptr = SegmentEnd = nullptr;
+      }
+    }
 
   public:
     iterator() = default;
@@ -201,6 +353,8 @@ public:
     T *operator->() const { return reinterpret_cast<T*>(Ptr); }
     iterator &operator++() {
       Ptr += (*this)->allocated_size();
+      if (Ptr == SegmentEnd)
+        crossSegmentBoundary();
       return *this;
     }
     iterator operator++(int _) {
@@ -214,6 +368,8 @@ public:
     template <class U> void advancePast() {
       assert((*this)->allocated_size() == sizeof(U));
       Ptr += sizeof(U);
+      if (Ptr == SegmentEnd)
+        crossSegmentBoundary();
     }
 
     friend bool operator==(iterator a, iterator b) { return a.Ptr == b.Ptr; }
@@ -223,32 +379,59 @@ public:
   using DiverseStackBase::checkIterator;
   void checkIterator(iterator it) const {
     checkValid();
-    assert(Begin <= it.Ptr && it.Ptr <= End);
+    assert((it.Ptr == nullptr || it.Ptr < it.SegmentEnd) &&
+           "iterator does not refer to an object on the stack");
   }
 
-  iterator begin() { checkValid(); return iterator(Begin); }
-  iterator end() { checkValid(); return iterator(End); }
+  iterator begin() {
+    checkValid();
+    if (empty()) return iterator(nullptr, nullptr, nullptr);
+    return iterator(Begin, End, Older);
+  }
+  iterator end() { checkValid(); return iterator(nullptr, nullptr, nullptr); }
   iterator find(stable_iterator it) {
-    checkIterator(it);
-    return iterator(End - it.Depth);
+    SegmentPosition pos = findPosition(it);
+    return iterator(pos.Ptr, pos.SegmentEnd, pos.NextOlder);
   }
   stable_iterator stabilize(iterator it) const {
     checkIterator(it);
-    return stable_iterator(End - it.Ptr);
-  } 
+    return stable_iterator(depthOfPosition(it.Ptr, it.SegmentEnd,
+                                           it.NextOlder));
+  }
 
   class const_iterator {
     const char *Ptr;
+    const char *SegmentEnd;
+    const DiverseStackBase::Chunk *NextOlder;
     friend class DiverseStackImpl;
-    const_iterator(const char *ptr) : Ptr(ptr) {}
+    const_iterator(const char *ptr, const char *segmentEnd,
+                   const DiverseStackBase::Chunk *nextOlder)
+      : Ptr(ptr), SegmentEnd(segmentEnd), NextOlder(nextOlder) {}
+
+    /// Move to the next older segment once the current one has been
+    /// walked completely, or become the end iterator.
+    void crossSegmentBoundary() {
+      assert(Ptr == SegmentEnd);
+      if (auto *c = NextOlder) {
+        Ptr = c->Begin;
+        SegmentEnd = c->End;
+        NextOlder = c->Older;
+      } else {
+        Ptr = SegmentEnd = nullptr;
+      }
+    }
+
   public:
     const_iterator() = default;
-    const_iterator(iterator it) : Ptr(it.Ptr) {}
+    const_iterator(iterator it)
+      : Ptr(it.Ptr), SegmentEnd(it.SegmentEnd), NextOlder(it.NextOlder) {}
 
     const T &operator*() const { return *reinterpret_cast<const T*>(Ptr); }
     const T *operator->() const { return reinterpret_cast<const T*>(Ptr); }
     const_iterator &operator++() {
       Ptr += (*this)->allocated_size();
+      if (Ptr == SegmentEnd)
+        crossSegmentBoundary();
       return *this;
     }
     const_iterator operator++(int _) {
@@ -262,6 +445,8 @@ public:
     template <class U> void advancePast() {
       assert((*this)->allocated_size() == sizeof(U));
       Ptr += sizeof(U);
+      if (Ptr == SegmentEnd)
+        crossSegmentBoundary();
     }
 
     friend bool operator==(const_iterator a, const_iterator b) {
@@ -271,19 +456,28 @@ public:
       return a.Ptr != b.Ptr;
     }
   };
-  const_iterator begin() const { checkValid(); return const_iterator(Begin); }
-  const_iterator end() const { checkValid(); return const_iterator(End); }
+  const_iterator begin() const {
+    checkValid();
+    if (empty()) return const_iterator(nullptr, nullptr, nullptr);
+    return const_iterator(Begin, End, Older);
+  }
+  const_iterator end() const {
+    checkValid();
+    return const_iterator(nullptr, nullptr, nullptr);
+  }
   void checkIterator(const_iterator it) const {
     checkValid();
-    assert(Begin <= it.Ptr && it.Ptr <= End);
+    assert((it.Ptr == nullptr || it.Ptr < it.SegmentEnd) &&
+           "iterator does not refer to an object on the stack");
   }
   const_iterator find(stable_iterator it) const {
-    checkIterator(it);
-    return const_iterator(End - it.Depth);
+    SegmentPosition pos = findPosition(it);
+    return const_iterator(pos.Ptr, pos.SegmentEnd, pos.NextOlder);
   }
   stable_iterator stabilize(const_iterator it) const {
     checkIterator(it);
-    return stable_iterator(End - it.Ptr);
+    return stable_iterator(depthOfPosition(it.Ptr, it.SegmentEnd,
+                                           it.NextOlder));
   }
 
   /// Push a new object onto the stack.
@@ -296,6 +490,8 @@ public:
   void pop() {
     assert(!empty());
     Begin += top().allocated_size();
+    if (Begin == End && Older)
+      popSegmentSlow();
   }
 
   /// Pop an object of known type off the stack.
@@ -303,6 +499,8 @@ public:
     assert(!empty());
     assert(sizeof(U) == top().allocated_size());
     Begin += sizeof(U);
+    if (Begin == End && Older)
+      popSegmentSlow();
   }
 };
 
@@ -446,6 +446,84 @@ private:
   void indent();
 };
 
+/// A streaming JSON emitter.
+///
+/// Unlike \c Output, which walks a value through the traits machinery,
+/// \c Writer is driven directly by the caller and formats each value
+/// straight into the stream, so emitting a message requires no
+/// intermediate objects.  Use it on hot paths -- the driver's parseable
+/// output, statistics reporting -- where building a value tree per
+/// message is measurable; pair it with a caller-provided buffer stream
+/// (e.g. \c llvm::raw_svector_ostream over a \c SmallString) to avoid
+/// heap traffic entirely.
+///
+/// The pretty-printed format matches \c Output exactly, so the two can
+/// be mixed on the same wire protocol.
+class Writer {
+  enum State : uint8_t {
+    ArrayFirstValue,
+    ArrayOtherValue,
+    ObjectFirstKey,
+    ObjectOtherKey
+  };
+
+  llvm::raw_ostream &Stream;
+  SmallVector<State, 8> StateStack;
+  bool PrettyPrint;
+
+public:
+  explicit Writer(llvm::raw_ostream &Stream, bool PrettyPrint = true)
+      : Stream(Stream), PrettyPrint(PrettyPrint) {}
+
+  /// Begin an object, either at the top level, as an array element, or
+  /// after \c attributeBegin().
+  void beginObject();
+  void endObject();
+
+  /// Begin an array, either at the top level, as an array element, or
+  /// after \c attributeBegin().
+  void beginArray();
+  void endArray();
+
+  /// Write the key of an object attribute; the caller emits the value
+  /// next, either as a scalar or by beginning a nested object or array.
+  void attributeBegin(StringRef Key);
+
+  /// Write a scalar value, either as an array element or as the value of
+  /// the preceding \c attributeBegin().  Strings are quoted and escaped.
+  void value(StringRef Val);
+  void value(bool Val);
+  void value(int64_t Val);
+  void value(double Val);
+
+  /// Write a whole scalar object attribute.
+  void attribute(StringRef Key, StringRef Val) {
+    attributeBegin(Key);
+    value(Val);
+  }
+  void attribute(StringRef Key, const char *Val) {
+    attribute(Key, StringRef(Val));
+  }
+  void attribute(StringRef Key, bool Val) {
+    attributeBegin(Key);
+    value(Val);
+  }
+  void attribute(StringRef Key, int64_t Val) {
+    attributeBegin(Key);
+    value(Val);
+  }
+  void attribute(StringRef Key, double Val) {
+    attributeBegin(Key);
+    value(Val);
+  }
+
+private:
+  /// Write any separator and indentation a value needs in the current
+  /// context.
+  void preflightValue();
+  void indent();
+};
+
 template<>
 struct ScalarTraits<bool> {
   static void output(const bool &, llvm::raw_ostream &);
@@ -136,10 +136,25 @@ namespace swift {
     /// ID of the current process for the purposes of AST verification.
     unsigned ASTVerifierProcessId = 1U;
 
+    /// Verify only one out of this many named declarations, selected by a
+    /// deterministic hash of the declaration name.  The default of 1 verifies
+    /// everything.
+    unsigned ASTVerifierSampleRate = 1U;
+
     /// \brief The upper bound, in bytes, of temporary data that can be
     /// allocated by the constraint solver.
     unsigned SolverMemoryThreshold = 15000000;
 
+    /// \brief The upper bound on the number of solver states the constraint
+    /// solver may explore while solving a single expression.
+    unsigned SolverScopeThreshold = 1000000;
+
+    /// \brief The upper bound on the number of solver states that all of the
+    /// diagnostic re-type-checks of a failed expression's subexpressions may
+    /// explore together.  Once exhausted, diagnosis falls back to the
+    /// structural diagnostics, which do not re-run the solver.
+    unsigned DiagnosisScopeBudget = 100000;
+
     /// \brief Perform all dynamic allocations using malloc/free instead of
     /// optimized custom allocator, so that memory debugging tools can be used.
     bool UseMalloc = false;
@@ -14,10 +14,12 @@
 #define SWIFT_SOURCEMANAGER_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -42,6 +44,11 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {};
 
+  /// Per-buffer indexes of line start offsets, built lazily on the first
+  /// line/column query for a buffer.  Buffers are immutable once added, so
+  /// an index never needs to be invalidated.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
 public:
   llvm::SourceMgr &getLLVMSourceMgr() {
     return LLVMSourceMgr;
@@ -180,24 +187,24 @@ public:
   ///
   /// This respects #line directives.
   std::pair<unsigned, unsigned>
-  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
-    return { LineOffset + l, c };
-  }
+  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const;
+
+  /// Returns the lines and columns of both endpoints of \p Range, which
+  /// must lie within a single buffer.
+  ///
+  /// This is cheaper than two separate \c getLineAndColumn calls because
+  /// the endpoints share one buffer search and one line index lookup.
+  ///
+  /// This respects #line directives.
+  std::pair<std::pair<unsigned, unsigned>, std::pair<unsigned, unsigned>>
+  getLineAndColumnRange(CharSourceRange Range, unsigned BufferID = 0) const;
 
   /// Returns the real line number for a source location.
   ///
   /// If \p BufferID is provided, \p Loc must come from that source buffer.
   ///
   /// This does not respect #line directives.
-  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
-  }
+  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const;
 
   StringRef extractText(CharSourceRange Range,
                         Optional<unsigned> BufferID = None) const;
@@ -223,6 +230,14 @@ public:
 private:
   const VirtualFile *getVirtualFile(SourceLoc Loc) const;
 
+  /// Returns the lazily built index of line start offsets for a buffer.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
+  /// Returns the 1-based line number and the line's start offset for the
+  /// line containing the given byte offset in a buffer.
+  std::pair<unsigned, unsigned> findLine(unsigned Offset,
+                                         unsigned BufferID) const;
+
   int getLineOffset(SourceLoc Loc) const {
     if (auto VFile = getVirtualFile(Loc))
       return VFile->LineOffset;
@@ -0,0 +1,59 @@
+//===--- Statistic.h - Frontend performance counters ------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_STATISTIC_H
+#define SWIFT_BASIC_STATISTIC_H
+
+#include "swift/Basic/LLVM.h"
+#include <cstdint>
+
+namespace llvm {
+  class raw_ostream;
+}
+
+namespace swift {
+
+/// Always-on performance counters for a single frontend invocation.
+///
+/// Unlike LLVM's STATISTIC machinery, these counters are compiled into
+/// release compilers: each is a plain increment of a process-wide variable,
+/// cheap enough to leave enabled everywhere. When the frontend is invoked
+/// with -stats-output-path, the final values are written as a JSON object
+/// so build analytics can find pathological files without rerunning the
+/// compiler in a special mode.
+struct CompilationCounters {
+  /// Bytes of source handed to the lexer.
+  uint64_t NumLexedBytes = 0;
+
+  /// Solver scopes pushed while type-checking expressions.
+  uint64_t NumSolverScopes = 0;
+
+  /// SIL instructions inserted into a basic block.
+  uint64_t NumSILInstsCreated = 0;
+
+  /// SIL instructions removed from their basic block.
+  uint64_t NumSILInstsDeleted = 0;
+
+  /// Declarations deserialized from module files.
+  uint64_t NumDeclsDeserialized = 0;
+};
+
+/// Retrieve the counters for the current frontend invocation.
+CompilationCounters &getCompilationCounters();
+
+/// Write the counters to \p os as a single JSON object. \p mainInput
+/// identifies the invocation's primary input file in the output.
+void writeCompilationCounters(llvm::raw_ostream &os, StringRef mainInput);
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_STATISTIC_H
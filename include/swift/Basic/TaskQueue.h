@@ -15,12 +15,14 @@
 
 #include "swift/Basic/LLVM.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/Program.h"
 
 #include <functional>
 #include <memory>
 #include <queue>
+#include <vector>
 
 namespace swift {
 namespace sys {
@@ -144,6 +146,72 @@ public:
   }
 };
 
+/// \brief A TaskQueue which runs tasks on threads within the current process
+/// rather than spawning one subprocess per task.
+///
+/// This avoids paying process startup (and LLVM initialization) once per
+/// task, which dominates the cost of very short tasks. Tasks which cannot be
+/// executed in-process (as determined by the executor function) are spawned
+/// as subprocesses from the worker thread instead.
+///
+/// \note In-process tasks write their output directly to stderr rather than
+/// delivering it through the TaskFinishedCallback's output parameter.
+class ThreadedTaskQueue : public TaskQueue {
+public:
+  // TODO: remove once -Wdocumentation stops warning for \param, \returns on
+  // std::function (<rdar://problem/15665132>).
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdocumentation"
+  /// \brief A function which attempts to execute a task in-process.
+  ///
+  /// \param ExecPath the path to the executable the task was created with
+  /// \param Args the arguments which should be passed to the task
+  ///
+  /// \returns the task's return code, or llvm::None if the task cannot be
+  /// executed in-process and should be spawned as a subprocess instead
+  typedef std::function<llvm::Optional<int>(const char *ExecPath,
+                                            ArrayRef<const char *> Args)>
+    InProcessExecutionFn;
+#pragma clang diagnostic pop
+
+private:
+  class ThreadedTask {
+  public:
+    const char *ExecPath;
+    std::vector<const char *> Args;
+    void *Context;
+
+    ThreadedTask(const char *ExecPath, ArrayRef<const char *> Args,
+                 void *Context)
+      : ExecPath(ExecPath), Args(Args.begin(), Args.end()), Context(Context) {}
+  };
+
+  std::queue<std::unique_ptr<ThreadedTask>> QueuedTasks;
+
+  /// The executor used to run tasks in-process.
+  InProcessExecutionFn ExecuteInProcess;
+
+public:
+  /// \brief Create a new ThreadedTaskQueue instance.
+  ///
+  /// \param ExecuteInProcess the function used to execute tasks in-process
+  /// \param NumberOfParallelTasks the number of worker threads to use. If 0,
+  /// the TaskQueue will choose the most appropriate number for the current
+  /// system.
+  ThreadedTaskQueue(InProcessExecutionFn ExecuteInProcess,
+                    unsigned NumberOfParallelTasks = 0);
+  virtual ~ThreadedTaskQueue();
+
+  virtual void addTask(const char *ExecPath, ArrayRef<const char *> Args,
+                       ArrayRef<const char *> Env = llvm::None,
+                       void *Context = nullptr);
+
+  virtual bool
+  execute(TaskBeganCallback Began = TaskBeganCallback(),
+          TaskFinishedCallback Finished = TaskFinishedCallback(),
+          TaskSignalledCallback Signalled = TaskSignalledCallback());
+};
+
 /// \brief A class which simulates execution of tasks with behavior similar to
 /// TaskQueue.
 class DummyTaskQueue : public TaskQueue {
@@ -0,0 +1,83 @@
+//===--- TraceEvents.h - Chrome-trace event recording -----------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Records timed, named events and writes them out in the JSON format
+// understood by chrome://tracing, so a frontend invocation can be viewed
+// as a flame graph. Recording is disabled by default; when disabled, a
+// TraceEventScope is a single flag test.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_TRACEEVENTS_H
+#define SWIFT_BASIC_TRACEEVENTS_H
+
+#include "swift/Basic/LLVM.h"
+#include <cstdint>
+#include <string>
+
+namespace llvm {
+  class raw_ostream;
+}
+
+namespace swift {
+
+/// Start recording trace events. Must be called before any events are
+/// recorded, typically while the frontend is still single-threaded.
+void enableTraceEvents();
+
+/// Returns true if enableTraceEvents() has been called.
+bool traceEventsEnabled();
+
+/// Record a completed event. Timestamps are microseconds and must come
+/// from traceEventTimeUSec(). Thread-safe.
+void recordTraceEvent(StringRef name, StringRef detail, uint64_t beginUSec,
+                      uint64_t endUSec);
+
+/// The current timestamp, in microseconds since tracing was enabled.
+uint64_t traceEventTimeUSec();
+
+/// Write all recorded events to \p os as a chrome://tracing JSON object.
+/// Traces from separate processes can be aggregated by merging their
+/// "traceEvents" arrays; events carry the process and thread id.
+void writeTraceEvents(llvm::raw_ostream &os);
+
+/// RAII helper recording the lifetime of a scope as a single event.
+class TraceEventScope {
+  StringRef Name;
+  std::string Detail;
+  uint64_t BeginUSec;
+  bool Enabled;
+
+public:
+  /// \p name identifies the kind of work (for example a phase or pass
+  /// name) and becomes the label in the flame graph; \p detail carries
+  /// instance-specific information such as a function name.
+  explicit TraceEventScope(StringRef name, StringRef detail = StringRef())
+      : Name(name), Enabled(traceEventsEnabled()) {
+    if (Enabled) {
+      Detail = detail;
+      BeginUSec = traceEventTimeUSec();
+    }
+  }
+
+  TraceEventScope(const TraceEventScope &) = delete;
+  TraceEventScope &operator=(const TraceEventScope &) = delete;
+
+  ~TraceEventScope() {
+    if (Enabled)
+      recordTraceEvent(Name, Detail, BeginUSec, traceEventTimeUSec());
+  }
+};
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_TRACEEVENTS_H
@@ -117,8 +117,13 @@ public:
   }
   void release() {
     RefCount--;
-    if (RefCount == 0)
-      delete this;
+    if (RefCount == 0) {
+      // Detached scope impls are allocated with the hashtable's allocator;
+      // destroy them the same way.
+      AllocatorTy &Allocator = HT->getAllocator();
+      this->~TreeScopedHashTableScopeImpl();
+      Allocator.Deallocate(this);
+    }
   }
 
   ~TreeScopedHashTableScopeImpl();
@@ -215,7 +220,11 @@ public:
       InlineImpl.ParentScope = ParentScope->getImpl();
     }
 
-    DetachedImpl = new ImplTy(std::move(InlineImpl));
+    // Allocate the detached impl with the hashtable's allocator so that
+    // detaching a scope does not hit the heap when the table uses an arena.
+    DetachedImpl =
+        InlineImpl.HT->getAllocator().template Allocate<ImplTy>();
+    new (DetachedImpl) ImplTy(std::move(InlineImpl));
     DetachedImpl->retain();
     if (DetachedImpl->ParentScope) {
       DetachedImpl->ParentScope->retain();
@@ -83,6 +83,25 @@ unsigned extractFirstUnicodeScalar(StringRef S);
 /// Returns the number of code units in UTF16 representation
 uint64_t getUTF16Length(StringRef Str);
 
+/// Returns true if \p S is a well-formed UTF-8 string.  ASCII prefixes are
+/// checked a machine word at a time.
+bool isWellFormedUTF8(StringRef S);
+
+/// Transcode a UTF-8 string into UTF-16, appending the code units to
+/// \p Result.  ASCII runs are copied a machine word at a time.
+///
+/// \returns false if \p Source contains an ill-formed subsequence, in which
+/// case the contents of \p Result are unspecified.
+bool convertUTF8ToUTF16(StringRef Source, SmallVectorImpl<uint16_t> &Result);
+
+/// Transcode a UTF-16 string into UTF-8, appending the bytes to \p Result.
+/// ASCII runs are copied a machine word at a time.
+///
+/// \returns false if \p Source contains an unpaired surrogate, in which
+/// case the contents of \p Result are unspecified.
+bool convertUTF16ToUTF8(ArrayRef<uint16_t> Source,
+                        SmallVectorImpl<char> &Result);
+
 } // namespace unicode
 } // namespace swift
 
@@ -218,6 +218,13 @@ public:
   std::string getBridgingHeaderContents(StringRef headerPath, off_t &fileSize,
                                         time_t &fileModTime);
 
+  /// Makes a precompiled header (PCH) from the given Objective-C header file
+  /// so that later jobs can import it with -import-objc-header instead of
+  /// reparsing the header.
+  ///
+  /// \returns true if there was an error emitting the PCH.
+  bool emitBridgingPCH(StringRef headerPath, StringRef outputPCHPath);
+
   const clang::Module *getClangOwningModule(ClangNode Node) const;
   bool hasTypedef(const clang::Decl *typeDecl) const;
 
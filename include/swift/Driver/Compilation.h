@@ -20,6 +20,7 @@
 #include "swift/Driver/Job.h"
 #include "swift/Basic/ArrayRefView.h"
 #include "swift/Basic/LLVM.h"
+#include "swift/Basic/TaskQueue.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/TimeValue.h"
@@ -123,6 +124,43 @@ private:
   /// True if temporary files should not be deleted.
   bool SaveTemps;
 
+  /// When true, frontend jobs are run as threads within the driver process
+  /// (sharing a single copy of LLVM's initialized state) rather than being
+  /// spawned as subprocesses.
+  ///
+  /// Requires an in-process executor to have been registered with
+  /// \c setInProcessExecutor; jobs the executor declines still run as
+  /// subprocesses.
+  bool EnableInProcessJobs;
+
+  /// The executor used to run frontend jobs in-process, if in-process job
+  /// execution has been requested.
+  sys::ThreadedTaskQueue::InProcessExecutionFn InProcessExecutor;
+
+  /// If non-empty, the path of a tool that dispatches frontend jobs to
+  /// remote workers.
+  ///
+  /// Each compile job is handed to the tool as its own command line,
+  /// "<tool> <frontend> <args...>".  The tool owns the transport: it is
+  /// responsible for shipping the inputs (typically by content digest),
+  /// running the command on a worker, streaming the outputs back to the
+  /// paths named in the command line, and exiting with the remote exit
+  /// status.  Jobs other than frontend compiles always run locally.
+  std::string RemoteExecutionTool;
+
+  /// If non-empty, the path of a directory used as a content-addressed
+  /// compilation cache.
+  ///
+  /// Before a compile job is scheduled, a key is computed from the compiler
+  /// version, the command line, and the contents of the input files the
+  /// command line names; if the cache holds an entry for that key, the
+  /// job's outputs (object file, swiftmodule, swiftdeps, ...) are restored
+  /// from it and the job is not run.  Outputs of jobs that do run are added
+  /// to the cache.  Inputs that reach the compile through search paths
+  /// rather than the command line are not part of the key, so the cache
+  /// must be cleared when such external dependencies change.
+  std::string CompilationCachePath;
+
   /// When true, dumps information about why files are being scheduled to be
   /// rebuilt.
   bool ShowIncrementalBuildDecisions = false;
@@ -140,7 +178,8 @@ public:
               unsigned NumberOfParallelCommands = 1,
               bool EnableIncrementalBuild = false,
               bool SkipTaskExecution = false,
-              bool SaveTemps = false);
+              bool SaveTemps = false,
+              bool EnableInProcessJobs = false);
   ~Compilation();
 
   const Driver &getDriver() const { return TheDriver; }
@@ -189,6 +228,24 @@ public:
     ShowIncrementalBuildDecisions = value;
   }
 
+  /// Registers the executor used to run frontend jobs in-process when
+  /// in-process job execution has been requested.
+  void setInProcessExecutor(sys::ThreadedTaskQueue::InProcessExecutionFn fn) {
+    InProcessExecutor = std::move(fn);
+  }
+
+  /// Sets the tool used to dispatch frontend jobs to remote workers.
+  void setRemoteExecutionTool(StringRef tool) {
+    assert(RemoteExecutionTool.empty() && "already set");
+    RemoteExecutionTool = tool;
+  }
+
+  /// Sets the directory used as a content-addressed compilation cache.
+  void setCompilationCachePath(StringRef path) {
+    assert(CompilationCachePath.empty() && "already set");
+    CompilationCachePath = path;
+  }
+
   void setCompilationRecordPath(StringRef path) {
     assert(CompilationRecordPath.empty() && "already set");
     CompilationRecordPath = path;
@@ -102,6 +102,18 @@ private:
   /// \sa DependencyMaskTy
   llvm::DenseMap<const void *, std::vector<ProvidesEntryTy>> Provides;
 
+  /// The subset of a node's outgoing edges which actually changed the last
+  /// time its dependency file was loaded.
+  ///
+  /// This permits marking at declaration granularity: after a node is
+  /// rebuilt, only the names it newly provides (or whose interface changed)
+  /// need to be traversed, rather than everything the file has ever
+  /// provided. If a node's interface hash changes without a corresponding
+  /// change to its provides set (e.g. a signature edit), the change cannot
+  /// be attributed to particular names and this conservatively contains the
+  /// node's entire provides set.
+  llvm::DenseMap<const void *, std::vector<ProvidesEntryTy>> ChangedProvides;
+
   /// The "incoming" edge map. Semantically this maps incoming (kind, string)
   /// edges representing dependencies to the nodes that depend on them, as
   /// well as a flag marking whether that (kind, string) pair has been marked
@@ -169,7 +181,8 @@ protected:
   }
 
   void markTransitive(SmallVectorImpl<const void *> &visited,
-                      const void *node, MarkTracerImpl *tracer = nullptr);
+                      const void *node, MarkTracerImpl *tracer = nullptr,
+                      bool onlyChangedProvides = false);
   bool markIntransitive(const void *node) {
     assert(Provides.count(node) && "node is not in the graph");
     return Marked.insert(node).second;
@@ -279,13 +292,20 @@ public:
   ///
   /// If you want to see how each node gets added to \p visited, pass a local
   /// MarkTracer instance to \p tracer.
+  ///
+  /// If \p onlyChangedProvides is set, only the "provides" entries of \p node
+  /// that actually changed the last time its dependency file was loaded are
+  /// traversed, rather than everything the node provides. This is the
+  /// declaration-granularity mode used after a node has been rebuilt; it has
+  /// no effect on the traversal of downstream nodes.
   template <unsigned N>
   void markTransitive(SmallVector<T, N> &visited, T node,
-                      MarkTracer *tracer = nullptr) {
+                      MarkTracer *tracer = nullptr,
+                      bool onlyChangedProvides = false) {
     SmallVector<const void *, N> rawMarked;
     DependencyGraphImpl::markTransitive(rawMarked,
                                         Traits::getAsVoidPointer(node),
-                                        tracer);
+                                        tracer, onlyChangedProvides);
     // FIXME: How can we avoid this copy?
     copyBack(visited, rawMarked);
   }
@@ -19,6 +19,7 @@
 
 #include "swift/AST/IRGenOptions.h"
 #include "swift/Basic/LLVM.h"
+#include "swift/Driver/StatCache.h"
 #include "swift/Driver/Types.h"
 #include "swift/Driver/Util.h"
 #include "llvm/ADT/DenseMap.h"
@@ -157,6 +158,12 @@ private:
   /// stored in it, and will clean them up when torn down.
   mutable llvm::StringMap<ToolChain *> ToolChains;
 
+  /// \brief Cache of filesystem status queries made while constructing the
+  /// job graph for this invocation.
+  ///
+  /// Cleared by the Compilation just before jobs start running.
+  mutable FileStatCache StatCache;
+
 public:
   typedef std::pair<types::ID, const llvm::opt::Arg *> InputPair;
   typedef SmallVector<InputPair, 16> InputList;
@@ -182,6 +189,8 @@ public:
 
   void setCheckInputFilesExist(bool Value) { CheckInputFilesExist = Value; }
 
+  FileStatCache &getStatCache() const { return StatCache; }
+
   /// Construct a compilation object for a command line argument vector.
   ///
   /// \return A Compilation, or nullptr if none was built for the given argument
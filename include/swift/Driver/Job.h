@@ -73,6 +73,11 @@ public:
   void setAdditionalOutputForType(types::ID type, StringRef OutputFilename);
   const std::string &getAdditionalOutputForType(types::ID type) const;
 
+  const llvm::SmallDenseMap<types::ID, std::string, 4> &
+  getAdditionalOutputsMap() const {
+    return AdditionalOutputsMap;
+  }
+
   const std::string &getAnyOutputForType(types::ID type) const;
 
   StringRef getBaseInput(int Index) const { return BaseInputs[Index]; }
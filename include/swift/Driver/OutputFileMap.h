@@ -64,6 +64,22 @@ private:
   ///
   /// \returns true on error, false on success
   bool parse(std::unique_ptr<llvm::MemoryBuffer> Buffer);
+
+  /// Loads a compiled form of the map from \p CachePath, if it exists and was
+  /// compiled from a YAML source with the given size and modification time.
+  ///
+  /// \returns null if there is no valid matching cache; the YAML source must
+  /// be parsed instead.
+  static std::unique_ptr<OutputFileMap>
+  loadFromCompiledCache(StringRef CachePath, uint64_t SourceSize,
+                        uint64_t SourceMTime);
+
+  /// Writes a compiled form of the map to \p CachePath, recording the size
+  /// and modification time of the YAML source it was parsed from. Failure to
+  /// write the cache is not an error; the next invocation parses the YAML
+  /// again.
+  void writeCompiledCache(StringRef CachePath, uint64_t SourceSize,
+                          uint64_t SourceMTime) const;
 };
 
 } // end namespace driver
@@ -0,0 +1,63 @@
+//===--- StatCache.h - Caching of filesystem status queries -----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_DRIVER_STATCACHE_H
+#define SWIFT_DRIVER_STATCACHE_H
+
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/FileSystem.h"
+
+namespace swift {
+namespace driver {
+
+/// \brief A per-invocation cache of filesystem status queries.
+///
+/// The driver asks about the same inputs and outputs repeatedly while
+/// building the action graph, computing job conditions, and checking
+/// incremental state; on a network filesystem each of those queries is a
+/// round trip. The cache remembers both successful results and failures.
+///
+/// The cache must be cleared once jobs start running, since the jobs
+/// themselves change the files the driver asked about.
+class FileStatCache {
+  llvm::StringMap<std::pair<std::error_code, llvm::sys::fs::file_status>>
+      Cache;
+
+public:
+  /// Equivalent to llvm::sys::fs::status, backed by the cache.
+  std::error_code status(StringRef Path,
+                         llvm::sys::fs::file_status &Result) {
+    auto insertion = Cache.insert({Path, {}});
+    auto &entry = insertion.first->second;
+    if (insertion.second)
+      entry.first = llvm::sys::fs::status(Path, entry.second);
+    Result = entry.second;
+    return entry.first;
+  }
+
+  /// Equivalent to llvm::sys::fs::exists, backed by the cache.
+  bool exists(StringRef Path) {
+    llvm::sys::fs::file_status result;
+    return !status(Path, result);
+  }
+
+  /// Forget all cached results, e.g. because jobs are about to run.
+  void clear() {
+    Cache.clear();
+  }
+};
+
+} // end namespace driver
+} // end namespace swift
+
+#endif
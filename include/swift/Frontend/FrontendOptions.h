@@ -115,6 +115,10 @@ public:
   /// The path to which we should output a fixits as source edits.
   std::string FixitsOutputPath;
 
+  /// The path to which we should output index data for the primary source
+  /// file.
+  std::string IndexDataFilePath;
+
   /// Arguments which should be passed in immediate mode.
   std::vector<std::string> ImmediateArgv;
 
@@ -136,6 +140,8 @@ public:
     /// Parse, type-check, and dump type refinement context hierarchy
     DumpTypeRefinementContexts,
 
+    EmitPCH, ///< Emit PCH of the bridging header
+
     EmitSILGen, ///< Emit raw SIL
     EmitSIL, ///< Emit canonical SIL
 
@@ -166,6 +172,10 @@ public:
   /// If set, dumps wall time taken to check each function body to llvm::errs().
   bool DebugTimeFunctionBodies = false;
 
+  /// If set, function bodies are not type-checked. Only suitable for
+  /// invocations that do not generate code, such as parsing or indexing.
+  bool SkipFunctionBodies = false;
+
   /// If set, prints the time taken in each major compilation phase to 
   /// llvm::errs().
   ///
@@ -209,6 +219,14 @@ public:
   /// termination.
   bool PrintClangStats = false;
 
+  /// If non-empty, write the frontend's performance counters to this path as
+  /// JSON when the invocation finishes.
+  std::string StatsOutputPath;
+
+  /// If non-empty, record phase and SIL pass timings and write them to this
+  /// path in chrome://tracing JSON format when the invocation finishes.
+  std::string TraceEventsPath;
+
   /// Indicates whether the playground transformation should be applied.
   bool PlaygroundTransform = false;
 
@@ -62,6 +62,18 @@ public:
   Optional<ValueRefCntPtr> get(const Key &K);
   void set(const Key &K, ValueRefCntPtr V) { setImpl(K, V, /*setChain*/ true); }
 
+  /// \brief Retrieve cached results for the top-level declarations of the
+  /// module under compilation.
+  ///
+  /// Unlike the per-import entries, which are validated by the module file's
+  /// modification time, these results are validated by \p Fingerprint, a hash
+  /// of everything that can affect them (see the caller for what it covers).
+  /// They are kept in memory only and are never chained to the on-disk cache.
+  Optional<ValueRefCntPtr> getCurrentModule(StringRef ModuleName,
+                                            uint64_t Fingerprint);
+  void setCurrentModule(StringRef ModuleName, uint64_t Fingerprint,
+                        ValueRefCntPtr V);
+
 private:
   void setImpl(const Key &K, ValueRefCntPtr V, bool setChain);
 };
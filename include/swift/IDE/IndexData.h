@@ -0,0 +1,45 @@
+//===--- IndexData.h - Routines to emit index data ------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_IDE_INDEX_DATA_H
+#define SWIFT_IDE_INDEX_DATA_H
+
+#include "swift/Basic/LLVM.h"
+
+namespace swift {
+class SourceFile;
+
+namespace ide {
+
+/// Roles of an occurrence in emitted index data.
+enum class IndexOccurrenceRole : unsigned {
+  Declaration = 0x1,
+  Reference   = 0x2,
+};
+
+/// Walks the type-checked \p SF and writes a compact binary record of every
+/// declaration and reference occurrence to \p OS, so that a build can produce
+/// index data as a side effect of compilation instead of a separate
+/// type-checking pass.
+///
+/// The format is a "SIDX" magic and a version byte, followed by a
+/// ULEB128-encoded occurrence count and one occurrence record each of
+/// (USR index, role, line, column) ULEB128 values, followed by a string
+/// table of the referenced USRs.
+///
+/// \returns true if it failed, false on success.
+bool emitIndexData(SourceFile &SF, raw_ostream &OS);
+
+} // namespace ide
+} // namespace swift
+
+#endif // SWIFT_IDE_INDEX_DATA_H
@@ -15,6 +15,8 @@
 
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/OptionSet.h"
+#include "llvm/ADT/Optional.h"
+#include <utility>
 
 namespace swift {
 class ASTContext;
@@ -44,9 +46,17 @@ void printModuleInterface(ModuleDecl *M,
 
 // FIXME: this API should go away when Swift can represent Clang submodules as
 // 'swift::Module *' objects.
-void printSubmoduleInterface(ModuleDecl *M, ArrayRef<StringRef> FullModuleName,
-                             ModuleTraversalOptions TraversalOptions,
-                             ASTPrinter &Printer, const PrintOptions &Options);
+//
+// The interface decls are printed in a stable order, so clients can print a
+// large interface in chunks: \p Range restricts printing to the decls in the
+// half-open index range [Range->first, Range->first + Range->second) of that
+// order. Returns the total number of decls in the interface, which callers
+// can use to schedule follow-up chunks.
+unsigned printSubmoduleInterface(
+    ModuleDecl *M, ArrayRef<StringRef> FullModuleName,
+    ModuleTraversalOptions TraversalOptions, ASTPrinter &Printer,
+    const PrintOptions &Options,
+    Optional<std::pair<unsigned, unsigned>> Range = None);
 
 /// Print the interface for a header that has been imported via the implicit
 /// objc header importing feature.
@@ -96,6 +96,13 @@ namespace swift {
     SwiftStackPromotion() : llvm::FunctionPass(ID) {}
   };
 
+  class SwiftMergeFunctions : public llvm::ModulePass {
+    virtual bool runOnModule(llvm::Module &M) override;
+  public:
+    static char ID;
+    SwiftMergeFunctions() : llvm::ModulePass(ID) {}
+  };
+
 
 } // end namespace swift
 
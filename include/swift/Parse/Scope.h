@@ -35,7 +35,13 @@ class ScopeInfo {
 public:
   typedef std::pair<unsigned, ValueDecl*> ValueScopeEntry;
   
-  typedef TreeScopedHashTable<Identifier, ValueScopeEntry> ScopedHTTy;
+  // Scope entries are bump-allocated out of an arena owned by the hash
+  // table. Popping a scope unlinks its entries but performs no per-entry
+  // frees; the arena is reclaimed wholesale when the parser is destroyed.
+  // Deeply nested code creates and destroys scopes at a high rate, and the
+  // per-entry malloc traffic used to be a measurable parsing hotspot.
+  typedef TreeScopedHashTable<Identifier, ValueScopeEntry,
+                              llvm::BumpPtrAllocator> ScopedHTTy;
   typedef ScopedHTTy::ScopeTy ScopedHTScopeTy;
   typedef ScopedHTTy::DetachedScopeTy ScopedHTDetachedScopeTy;
 
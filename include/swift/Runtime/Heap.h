@@ -18,5 +18,16 @@
 #define SWIFT_RUNTIME_HEAP_H
 
 #include <llvm/Support/Compiler.h>
+#include <cstddef>
+
+namespace swift {
+
+/// Returns the usable size of a small block served from the runtime's
+/// per-thread magazines, or 0 if \p ptr was not allocated from them.
+/// Used by the stdlib's _swift_stdlib_malloc_size shim: the system
+/// allocator cannot answer size queries for magazine blocks.
+size_t swift_magazineBlockSize(const void *ptr);
+
+}
 
 #endif /* SWIFT_RUNTIME_HEAP_H */
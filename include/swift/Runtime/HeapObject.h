@@ -177,6 +177,15 @@ extern "C" void swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask);
 extern "C" void swift_retain(HeapObject *object);
 extern "C" void swift_retain_n(HeapObject *object, uint32_t n);
 
+/// Increments the retain count of an object, non-atomically.
+///
+/// The caller must guarantee that no other thread can access the object,
+/// e.g. because the compiler proved that the object never escapes its
+/// allocating thread.
+///
+/// \param object - may be null, in which case this is a no-op
+extern "C" void swift_nonatomic_retain(HeapObject *object);
+
 static inline void _swift_retain_inlined(HeapObject *object) {
   if (object) {
     object->refCount.increment();
@@ -222,6 +231,14 @@ extern "C" void swift_unpin(HeapObject *object);
 /// It's unlikely that a custom CC would be beneficial here.
 extern "C" void swift_release(HeapObject *object);
 
+/// Decrements the retain count of an object, non-atomically. If the
+/// retain count reaches zero, the object is destroyed.
+///
+/// The caller must guarantee that no other thread can access the object.
+///
+/// \param object - may be null, in which case this is a no-op
+extern "C" void swift_nonatomic_release(HeapObject *object);
+
 /// Atomically decrements the retain count of an object n times. If the retain
 /// count reaches zero, the object is destroyed
 extern "C" void swift_release_n(HeapObject *object, uint32_t n);
@@ -480,6 +497,13 @@ static inline void swift_unownedTakeAssign(UnownedReference *dest,
 /*****************************************************************************/
 
 /// A weak reference value object.  This is ABI.
+///
+/// An initialized native weak reference does not store the object itself;
+/// it stores a tagged pointer to a side-table entry that tracks the object,
+/// so the object's allocation can be freed at deinit even while weak
+/// references to it remain.  The stored value is null for an empty
+/// reference and, under Objective-C interop, may also be an Objective-C
+/// object or tagged pointer.
 struct WeakReference {
   HeapObject *Value;
 };
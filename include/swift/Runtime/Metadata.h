@@ -35,17 +35,17 @@
 namespace swift {
 
 /// A bump pointer for metadata allocations. Since metadata is (currently)
-/// never released, it does not support deallocation. This allocator by itself
-/// is not thread-safe; in concurrent uses, allocations must be guarded by
-/// a lock, such as the per-metadata-cache lock used to guard metadata
-/// instantiations. All allocations are pointer-aligned.
+/// never released, it does not support deallocation. The allocator is
+/// thread-safe: the bump pointer is advanced with a compare-and-swap, so no
+/// lock is needed for concurrent allocations. All allocations are
+/// pointer-aligned.
 class MetadataAllocator {
   /// Address of the next available space. The allocator grabs a page at a time,
   /// so the need for a new page can be determined by page alignment.
   ///
   /// Initializing to -1 instead of nullptr ensures that the first allocation
   /// triggers a page allocation since it will always span a "page" boundary.
-  char *next = (char*)(~(uintptr_t)0U);
+  std::atomic<char *> next{(char*)(~(uintptr_t)0U)};
   
 public:
   MetadataAllocator() = default;
@@ -2434,6 +2434,15 @@ swift_instantiateObjCClass(const ClassMetadata *theClass);
 extern "C" const Metadata *
 swift_getObjCClassMetadata(const ClassMetadata *theClass);
 
+/// \brief Fetch the type metadata for a class, given its runtime (mangled)
+/// name.
+///
+/// Returns null if no class with that name is registered with the runtime.
+/// Successful lookups are cached, so resolving the same name repeatedly only
+/// pays for the lookup once.
+extern "C" const Metadata *
+swift_getTypeByName(const char *name, size_t nameLength);
+
 /// \brief Fetch a unique type metadata object for a foreign type.
 extern "C" const ForeignTypeMetadata *
 swift_getForeignTypeMetadata(ForeignTypeMetadata *nonUnique);
@@ -18,7 +18,6 @@
 #define SWIFT_RUNTIME_ONCE_H
 
 #include "swift/Runtime/HeapObject.h"
-#include <mutex>
 
 namespace swift {
 
@@ -29,8 +28,11 @@ typedef long swift_once_t;
 
 #else
 
-// On other platforms swift_once_t is std::once_flag
-typedef std::once_flag swift_once_t;
+// On other platforms swift_once_t is a word-sized token driven by the
+// runtime's own implementation: zero before initialization, -1 once
+// initialization is complete. The "done" value is ABI; IRGen emits an
+// inline check against it ahead of the runtime call.
+typedef long swift_once_t;
 
 #endif
 
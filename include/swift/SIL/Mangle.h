@@ -166,7 +166,7 @@ class FunctionSignatureSpecializationMangler
 public:
   FunctionSignatureSpecializationMangler(SpecializationPass Pass,
                                          Mangler &M, SILFunction *F);
-  void setArgumentConstantProp(unsigned ArgNo, LiteralInst *LI);
+  void setArgumentConstantProp(unsigned ArgNo, SILInstruction *Constant);
   void setArgumentClosureProp(unsigned ArgNo, PartialApplyInst *PAI);
   void setArgumentClosureProp(unsigned ArgNo, ThinToThickFunctionInst *TTTFI);
   void setArgumentDead(unsigned ArgNo);
@@ -177,7 +177,8 @@ public:
 
 private:
   void mangleSpecialization();
-  void mangleConstantProp(LiteralInst *LI);
+  void mangleConstantProp(SILInstruction *Constant);
+  void mangleConstantValue(SILInstruction *Constant);
   void mangleClosureProp(PartialApplyInst *PAI);
   void mangleClosureProp(ThinToThickFunctionInst *TTTFI);
   void mangleArgument(ArgumentModifierIntBase ArgMod,
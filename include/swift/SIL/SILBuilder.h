@@ -232,7 +232,7 @@ public:
     // AllocRefInsts expand to function calls and can therefore not be
     // counted towards the function prologue.
     assert(!Loc.isInPrologue());
-    return insert(new (F.getModule()) AllocRefInst(
+    return insert(new (F) AllocRefInst(
         createSILDebugLocation(Loc), elementType, F, objc, canAllocOnStack));
   }
 
@@ -241,13 +241,13 @@ public:
     // AllocRefDynamicInsts expand to function calls and can therefore
     // not be counted towards the function prologue.
     assert(!Loc.isInPrologue());
-    return insert(new (F.getModule()) AllocRefDynamicInst(
+    return insert(new (F) AllocRefDynamicInst(
         createSILDebugLocation(Loc), operand, type, objc));
   }
 
   AllocValueBufferInst *
   createAllocValueBuffer(SILLocation Loc, SILType valueType, SILValue operand) {
-    return insert(new (F.getModule()) AllocValueBufferInst(
+    return insert(new (F) AllocValueBufferInst(
         createSILDebugLocation(Loc), valueType, operand));
   }
 
@@ -356,12 +356,10 @@ public:
   }
 
   FunctionRefInst *createFunctionRef(SILLocation Loc, SILFunction *f) {
-    return insert(new (F.getModule())
-                      FunctionRefInst(createSILDebugLocation(Loc), f));
+    return insert(new (F) FunctionRefInst(createSILDebugLocation(Loc), f));
   }
   GlobalAddrInst *createGlobalAddr(SILLocation Loc, SILGlobalVariable *g) {
-    return insert(new (F.getModule())
-                      GlobalAddrInst(createSILDebugLocation(Loc), g));
+    return insert(new (F) GlobalAddrInst(createSILDebugLocation(Loc), g));
   }
 
   IntegerLiteralInst *createIntegerLiteral(IntegerLiteralExpr *E) {
@@ -401,23 +399,22 @@ public:
   }
 
   LoadInst *createLoad(SILLocation Loc, SILValue LV) {
-    return insert(new (F.getModule())
-                      LoadInst(createSILDebugLocation(Loc), LV));
+    return insert(new (F) LoadInst(createSILDebugLocation(Loc), LV));
   }
 
   StoreInst *createStore(SILLocation Loc, SILValue Src, SILValue DestAddr) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       StoreInst(createSILDebugLocation(Loc), Src, DestAddr));
   }
   AssignInst *createAssign(SILLocation Loc, SILValue Src, SILValue DestAddr) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       AssignInst(createSILDebugLocation(Loc), Src, DestAddr));
   }
 
   MarkUninitializedInst *
   createMarkUninitialized(SILLocation Loc, SILValue src,
                           MarkUninitializedInst::Kind k) {
-    return insert(new (F.getModule()) MarkUninitializedInst(
+    return insert(new (F) MarkUninitializedInst(
         createSILDebugLocation(Loc), src, k));
   }
   MarkUninitializedInst *createMarkUninitializedVar(SILLocation Loc,
@@ -438,37 +435,36 @@ public:
   DebugValueInst *createDebugValue(SILLocation Loc, SILValue src,
                                    SILDebugVariable Var = SILDebugVariable()) {
     return insert(DebugValueInst::create(createSILDebugLocation(Loc), src,
-                                         F.getModule(), Var));
+                                         F, Var));
   }
   DebugValueAddrInst *
   createDebugValueAddr(SILLocation Loc, SILValue src,
                        SILDebugVariable Var = SILDebugVariable()) {
     return insert(DebugValueAddrInst::create(createSILDebugLocation(Loc), src,
-                                             F.getModule(), Var));
+                                             F, Var));
   }
 
   LoadWeakInst *createLoadWeak(SILLocation Loc, SILValue src, IsTake_t isTake) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       LoadWeakInst(createSILDebugLocation(Loc), src, isTake));
   }
 
   StoreWeakInst *createStoreWeak(SILLocation Loc, SILValue value, SILValue dest,
                                  IsInitialization_t isInit) {
-    return insert(new (F.getModule()) StoreWeakInst(createSILDebugLocation(Loc),
+    return insert(new (F) StoreWeakInst(createSILDebugLocation(Loc),
                                                     value, dest, isInit));
   }
 
   LoadUnownedInst *createLoadUnowned(SILLocation loc, SILValue src,
                                      IsTake_t isTake) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                     LoadUnownedInst(createSILDebugLocation(loc), src, isTake));
   }
 
   StoreUnownedInst *createStoreUnowned(SILLocation loc, SILValue value,
                                        SILValue dest,
                                        IsInitialization_t isInit) {
-    return insert(new (F.getModule())
-                    StoreUnownedInst(createSILDebugLocation(loc),
+    return insert(new (F) StoreUnownedInst(createSILDebugLocation(loc),
                                      value, dest, isInit));
   }
 
@@ -476,86 +472,85 @@ public:
                                SILValue destAddr, IsTake_t isTake,
                                IsInitialization_t isInitialize) {
     assert(srcAddr.getType() == destAddr.getType());
-    return insert(new (F.getModule()) CopyAddrInst(
+    return insert(new (F) CopyAddrInst(
         createSILDebugLocation(Loc), srcAddr, destAddr, isTake, isInitialize));
   }
 
   ConvertFunctionInst *createConvertFunction(SILLocation Loc, SILValue Op,
                                              SILType Ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       ConvertFunctionInst(createSILDebugLocation(Loc), Op, Ty));
   }
 
   ThinFunctionToPointerInst *
   createThinFunctionToPointer(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) ThinFunctionToPointerInst(
+    return insert(new (F) ThinFunctionToPointerInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   PointerToThinFunctionInst *
   createPointerToThinFunction(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) PointerToThinFunctionInst(
+    return insert(new (F) PointerToThinFunctionInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   UpcastInst *createUpcast(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule())
-                      UpcastInst(createSILDebugLocation(Loc), Op, Ty));
+    return insert(new (F) UpcastInst(createSILDebugLocation(Loc), Op, Ty));
   }
 
   AddressToPointerInst *createAddressToPointer(SILLocation Loc, SILValue Op,
                                                SILType Ty) {
-    return insert(new (F.getModule()) AddressToPointerInst(
+    return insert(new (F) AddressToPointerInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   PointerToAddressInst *createPointerToAddress(SILLocation Loc, SILValue Op,
                                                SILType Ty) {
-    return insert(new (F.getModule()) PointerToAddressInst(
+    return insert(new (F) PointerToAddressInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   UncheckedRefCastInst *createUncheckedRefCast(SILLocation Loc, SILValue Op,
                                                SILType Ty) {
-    return insert(new (F.getModule()) UncheckedRefCastInst(
+    return insert(new (F) UncheckedRefCastInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   UncheckedRefCastAddrInst *
   createUncheckedRefCastAddr(SILLocation Loc, SILValue src, CanType sourceType,
                              SILValue dest, CanType targetType) {
-    return insert(new (F.getModule()) UncheckedRefCastAddrInst(
+    return insert(new (F) UncheckedRefCastAddrInst(
         createSILDebugLocation(Loc), src, sourceType, dest, targetType));
   }
 
   UncheckedAddrCastInst *createUncheckedAddrCast(SILLocation Loc, SILValue Op,
                                                  SILType Ty) {
-    return insert(new (F.getModule()) UncheckedAddrCastInst(
+    return insert(new (F) UncheckedAddrCastInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   UncheckedTrivialBitCastInst *
   createUncheckedTrivialBitCast(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) UncheckedTrivialBitCastInst(
+    return insert(new (F) UncheckedTrivialBitCastInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   UncheckedBitwiseCastInst *
   createUncheckedBitwiseCast(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) UncheckedBitwiseCastInst(
+    return insert(new (F) UncheckedBitwiseCastInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   RefToBridgeObjectInst *createRefToBridgeObject(SILLocation Loc, SILValue Ref,
                                                  SILValue Bits) {
     auto Ty = SILType::getBridgeObjectType(getASTContext());
-    return insert(new (F.getModule()) RefToBridgeObjectInst(
+    return insert(new (F) RefToBridgeObjectInst(
         createSILDebugLocation(Loc), Ref, Bits, Ty));
   }
 
   BridgeObjectToRefInst *createBridgeObjectToRef(SILLocation Loc, SILValue Op,
                                                  SILType Ty) {
-    return insert(new (F.getModule()) BridgeObjectToRefInst(
+    return insert(new (F) BridgeObjectToRefInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
@@ -567,103 +562,102 @@ public:
 
   BridgeObjectToWordInst *createBridgeObjectToWord(SILLocation Loc, SILValue Op,
                                                    SILType Ty) {
-    return insert(new (F.getModule()) BridgeObjectToWordInst(
+    return insert(new (F) BridgeObjectToWordInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   RefToRawPointerInst *createRefToRawPointer(SILLocation Loc, SILValue Op,
                                              SILType Ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       RefToRawPointerInst(createSILDebugLocation(Loc), Op, Ty));
   }
 
   RawPointerToRefInst *createRawPointerToRef(SILLocation Loc, SILValue Op,
                                              SILType Ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       RawPointerToRefInst(createSILDebugLocation(Loc), Op, Ty));
   }
 
   ThinToThickFunctionInst *createThinToThickFunction(SILLocation Loc,
                                                      SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) ThinToThickFunctionInst(
+    return insert(new (F) ThinToThickFunctionInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   ThickToObjCMetatypeInst *createThickToObjCMetatype(SILLocation Loc,
                                                      SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) ThickToObjCMetatypeInst(
+    return insert(new (F) ThickToObjCMetatypeInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   ObjCToThickMetatypeInst *createObjCToThickMetatype(SILLocation Loc,
                                                      SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) ObjCToThickMetatypeInst(
+    return insert(new (F) ObjCToThickMetatypeInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   ObjCProtocolInst *createObjCProtocol(SILLocation Loc, ProtocolDecl *P,
                                        SILType Ty) {
-    return insert(new (F.getModule())
-                      ObjCProtocolInst(createSILDebugLocation(Loc), P, Ty));
+    return insert(new (F) ObjCProtocolInst(createSILDebugLocation(Loc), P, Ty));
   }
 
   UnownedToRefInst *createUnownedToRef(SILLocation Loc, SILValue op,
                                        SILType ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       UnownedToRefInst(createSILDebugLocation(Loc), op, ty));
   }
 
   RefToUnownedInst *createRefToUnowned(SILLocation Loc, SILValue op,
                                        SILType ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       RefToUnownedInst(createSILDebugLocation(Loc), op, ty));
   }
 
   UnmanagedToRefInst *createUnmanagedToRef(SILLocation Loc, SILValue op,
                                            SILType ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       UnmanagedToRefInst(createSILDebugLocation(Loc), op, ty));
   }
 
   RefToUnmanagedInst *createRefToUnmanaged(SILLocation Loc, SILValue op,
                                            SILType ty) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       RefToUnmanagedInst(createSILDebugLocation(Loc), op, ty));
   }
 
   IsNonnullInst *createIsNonnull(SILLocation Loc, SILValue operand) {
-    return insert(new (F.getModule()) IsNonnullInst(
+    return insert(new (F) IsNonnullInst(
         createSILDebugLocation(Loc), operand,
         SILType::getBuiltinIntegerType(1, getASTContext())));
   }
 
   UnconditionalCheckedCastInst *
   createUnconditionalCheckedCast(SILLocation Loc, SILValue op, SILType destTy) {
-    return insert(new (F.getModule()) UnconditionalCheckedCastInst(
+    return insert(new (F) UnconditionalCheckedCastInst(
         createSILDebugLocation(Loc), op, destTy));
   }
 
   UnconditionalCheckedCastAddrInst *createUnconditionalCheckedCastAddr(
       SILLocation Loc, CastConsumptionKind consumption, SILValue src,
       CanType sourceType, SILValue dest, CanType targetType) {
-    return insert(new (F.getModule()) UnconditionalCheckedCastAddrInst(
+    return insert(new (F) UnconditionalCheckedCastAddrInst(
         createSILDebugLocation(Loc), consumption, src, sourceType, dest,
         targetType));
   }
 
   RetainValueInst *createRetainValue(SILLocation Loc, SILValue operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       RetainValueInst(createSILDebugLocation(Loc), operand));
   }
 
   ReleaseValueInst *createReleaseValue(SILLocation Loc, SILValue operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       ReleaseValueInst(createSILDebugLocation(Loc), operand));
   }
 
   AutoreleaseValueInst *createAutoreleaseValue(SILLocation Loc,
                                                SILValue operand) {
-    return insert(new (F.getModule()) AutoreleaseValueInst(
+    return insert(new (F) AutoreleaseValueInst(
         createSILDebugLocation(Loc), operand));
   }
 
@@ -681,7 +675,7 @@ public:
 
   EnumInst *createEnum(SILLocation Loc, SILValue Operand,
                        EnumElementDecl *Element, SILType Ty) {
-    return insert(new (F.getModule()) EnumInst(createSILDebugLocation(Loc),
+    return insert(new (F) EnumInst(createSILDebugLocation(Loc),
                                                Operand, Element, Ty));
   }
 
@@ -715,7 +709,7 @@ public:
                                                SILValue Operand,
                                                EnumElementDecl *Element,
                                                SILType Ty) {
-    return insert(new (F.getModule()) InitEnumDataAddrInst(
+    return insert(new (F) InitEnumDataAddrInst(
         createSILDebugLocation(Loc), Operand, Element, Ty));
   }
 
@@ -723,7 +717,7 @@ public:
                                                  SILValue Operand,
                                                  EnumElementDecl *Element,
                                                  SILType Ty) {
-    return insert(new (F.getModule()) UncheckedEnumDataInst(
+    return insert(new (F) UncheckedEnumDataInst(
         createSILDebugLocation(Loc), Operand, Element, Ty));
   }
 
@@ -738,7 +732,7 @@ public:
   UncheckedTakeEnumDataAddrInst *
   createUncheckedTakeEnumDataAddr(SILLocation Loc, SILValue Operand,
                                   EnumElementDecl *Element, SILType Ty) {
-    return insert(new (F.getModule()) UncheckedTakeEnumDataAddrInst(
+    return insert(new (F) UncheckedTakeEnumDataAddrInst(
         createSILDebugLocation(Loc), Operand, Element, Ty));
   }
 
@@ -752,7 +746,7 @@ public:
 
   InjectEnumAddrInst *createInjectEnumAddr(SILLocation Loc, SILValue Operand,
                                            EnumElementDecl *Element) {
-    return insert(new (F.getModule()) InjectEnumAddrInst(
+    return insert(new (F) InjectEnumAddrInst(
         createSILDebugLocation(Loc), Operand, Element));
   }
 
@@ -780,7 +774,7 @@ public:
 
   TupleExtractInst *createTupleExtract(SILLocation Loc, SILValue Operand,
                                        unsigned FieldNo, SILType ResultTy) {
-    return insert(new (F.getModule()) TupleExtractInst(
+    return insert(new (F) TupleExtractInst(
         createSILDebugLocation(Loc), Operand, FieldNo, ResultTy));
   }
 
@@ -794,20 +788,20 @@ public:
                                                SILValue Operand,
                                                unsigned FieldNo,
                                                SILType ResultTy) {
-    return insert(new (F.getModule()) TupleElementAddrInst(
+    return insert(new (F) TupleElementAddrInst(
         createSILDebugLocation(Loc), Operand, FieldNo, ResultTy));
   }
 
   TupleElementAddrInst *
   createTupleElementAddr(SILLocation Loc, SILValue Operand, unsigned FieldNo) {
-    return insert(new (F.getModule()) TupleElementAddrInst(
+    return insert(new (F) TupleElementAddrInst(
         createSILDebugLocation(Loc), Operand, FieldNo,
         Operand.getType().getTupleElementType(FieldNo)));
   }
 
   StructExtractInst *createStructExtract(SILLocation Loc, SILValue Operand,
                                          VarDecl *Field, SILType ResultTy) {
-    return insert(new (F.getModule()) StructExtractInst(
+    return insert(new (F) StructExtractInst(
         createSILDebugLocation(Loc), Operand, Field, ResultTy));
   }
 
@@ -821,7 +815,7 @@ public:
                                                  SILValue Operand,
                                                  VarDecl *Field,
                                                  SILType ResultTy) {
-    return insert(new (F.getModule()) StructElementAddrInst(
+    return insert(new (F) StructElementAddrInst(
         createSILDebugLocation(Loc), Operand, Field, ResultTy));
   }
 
@@ -833,7 +827,7 @@ public:
 
   RefElementAddrInst *createRefElementAddr(SILLocation Loc, SILValue Operand,
                                            VarDecl *Field, SILType ResultTy) {
-    return insert(new (F.getModule()) RefElementAddrInst(
+    return insert(new (F) RefElementAddrInst(
         createSILDebugLocation(Loc), Operand, Field, ResultTy));
   }
   RefElementAddrInst *createRefElementAddr(SILLocation Loc, SILValue Operand,
@@ -845,7 +839,7 @@ public:
   ClassMethodInst *createClassMethod(SILLocation Loc, SILValue Operand,
                                      SILDeclRef Member, SILType MethodTy,
                                      bool Volatile = false) {
-    return insert(new (F.getModule()) ClassMethodInst(
+    return insert(new (F) ClassMethodInst(
         createSILDebugLocation(Loc), Operand, Member, MethodTy, Volatile));
   }
 
@@ -868,7 +862,7 @@ public:
   SuperMethodInst *createSuperMethod(SILLocation Loc, SILValue Operand,
                                      SILDeclRef Member, SILType MethodTy,
                                      bool Volatile = false) {
-    return insert(new (F.getModule()) SuperMethodInst(
+    return insert(new (F) SuperMethodInst(
         createSILDebugLocation(Loc), Operand, Member, MethodTy, Volatile));
   }
 
@@ -885,32 +879,32 @@ public:
   DynamicMethodInst *createDynamicMethod(SILLocation Loc, SILValue Operand,
                                          SILDeclRef Member, SILType MethodTy,
                                          bool Volatile = false) {
-    return insert(new (F.getModule()) DynamicMethodInst(
+    return insert(new (F) DynamicMethodInst(
         createSILDebugLocation(Loc), Operand, Member, MethodTy, Volatile));
   }
 
   OpenExistentialAddrInst *
   createOpenExistentialAddr(SILLocation Loc, SILValue Operand, SILType SelfTy) {
-    return insert(new (F.getModule()) OpenExistentialAddrInst(
+    return insert(new (F) OpenExistentialAddrInst(
         createSILDebugLocation(Loc), Operand, SelfTy));
   }
 
   OpenExistentialMetatypeInst *createOpenExistentialMetatype(SILLocation Loc,
                                                              SILValue operand,
                                                              SILType selfTy) {
-    return insert(new (F.getModule()) OpenExistentialMetatypeInst(
+    return insert(new (F) OpenExistentialMetatypeInst(
         createSILDebugLocation(Loc), operand, selfTy));
   }
 
   OpenExistentialRefInst *
   createOpenExistentialRef(SILLocation Loc, SILValue Operand, SILType Ty) {
-    return insert(new (F.getModule()) OpenExistentialRefInst(
+    return insert(new (F) OpenExistentialRefInst(
         createSILDebugLocation(Loc), Operand, Ty));
   }
 
   OpenExistentialBoxInst *
   createOpenExistentialBox(SILLocation Loc, SILValue Operand, SILType Ty) {
-    return insert(new (F.getModule()) OpenExistentialBoxInst(
+    return insert(new (F) OpenExistentialBoxInst(
         createSILDebugLocation(Loc), Operand, Ty));
   }
 
@@ -944,7 +938,7 @@ public:
 
   DeinitExistentialAddrInst *createDeinitExistentialAddr(SILLocation Loc,
                                                          SILValue Existential) {
-    return insert(new (F.getModule()) DeinitExistentialAddrInst(
+    return insert(new (F) DeinitExistentialAddrInst(
         createSILDebugLocation(Loc), Existential));
   }
 
@@ -958,82 +952,79 @@ public:
   ProjectBlockStorageInst *createProjectBlockStorage(SILLocation Loc,
                                                      SILValue Storage,
                                                      SILType CaptureTy) {
-    return insert(new (F.getModule()) ProjectBlockStorageInst(
+    return insert(new (F) ProjectBlockStorageInst(
         createSILDebugLocation(Loc), Storage, CaptureTy));
   }
 
   InitBlockStorageHeaderInst *
   createInitBlockStorageHeader(SILLocation Loc, SILValue BlockStorage,
                                SILValue InvokeFunction, SILType BlockType) {
-    return insert(new (F.getModule()) InitBlockStorageHeaderInst(
+    return insert(new (F) InitBlockStorageHeaderInst(
         createSILDebugLocation(Loc), BlockStorage, InvokeFunction, BlockType));
   }
 
   MetatypeInst *createMetatype(SILLocation Loc, SILType Metatype) {
-    return insert(new (F.getModule())
-                      MetatypeInst(createSILDebugLocation(Loc), Metatype));
+    return insert(new (F) MetatypeInst(createSILDebugLocation(Loc), Metatype));
   }
 
   ObjCMetatypeToObjectInst *
   createObjCMetatypeToObject(SILLocation Loc, SILValue Op, SILType Ty) {
-    return insert(new (F.getModule()) ObjCMetatypeToObjectInst(
+    return insert(new (F) ObjCMetatypeToObjectInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   ObjCExistentialMetatypeToObjectInst *
   createObjCExistentialMetatypeToObject(SILLocation Loc, SILValue Op,
                                         SILType Ty) {
-    return insert(new (F.getModule()) ObjCExistentialMetatypeToObjectInst(
+    return insert(new (F) ObjCExistentialMetatypeToObjectInst(
         createSILDebugLocation(Loc), Op, Ty));
   }
 
   ValueMetatypeInst *createValueMetatype(SILLocation Loc, SILType Metatype,
                                          SILValue Base) {
-    return insert(new (F.getModule()) ValueMetatypeInst(
+    return insert(new (F) ValueMetatypeInst(
         createSILDebugLocation(Loc), Metatype, Base));
   }
 
   ExistentialMetatypeInst *
   createExistentialMetatype(SILLocation Loc, SILType Metatype, SILValue Base) {
-    return insert(new (F.getModule()) ExistentialMetatypeInst(
+    return insert(new (F) ExistentialMetatypeInst(
         createSILDebugLocation(Loc), Metatype, Base));
   }
 
   CopyBlockInst *createCopyBlock(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
-                      CopyBlockInst(createSILDebugLocation(Loc), Operand));
+    return insert(new (F) CopyBlockInst(createSILDebugLocation(Loc), Operand));
   }
   StrongRetainInst *createStrongRetain(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       StrongRetainInst(createSILDebugLocation(Loc), Operand));
   }
   StrongReleaseInst *createStrongRelease(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       StrongReleaseInst(createSILDebugLocation(Loc), Operand));
   }
   StrongPinInst *createStrongPin(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
-                      StrongPinInst(createSILDebugLocation(Loc), Operand));
+    return insert(new (F) StrongPinInst(createSILDebugLocation(Loc), Operand));
   }
   StrongUnpinInst *createStrongUnpin(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       StrongUnpinInst(createSILDebugLocation(Loc), Operand));
   }
   StrongRetainUnownedInst *createStrongRetainUnowned(SILLocation Loc,
                                                      SILValue Operand) {
-    return insert(new (F.getModule()) StrongRetainUnownedInst(
+    return insert(new (F) StrongRetainUnownedInst(
         createSILDebugLocation(Loc), Operand));
   }
   UnownedRetainInst *createUnownedRetain(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       UnownedRetainInst(createSILDebugLocation(Loc), Operand));
   }
   UnownedReleaseInst *createUnownedRelease(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       UnownedReleaseInst(createSILDebugLocation(Loc), Operand));
   }
   FixLifetimeInst *createFixLifetime(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       FixLifetimeInst(createSILDebugLocation(Loc), Operand));
   }
   void emitFixLifetime(SILLocation Loc, SILValue Operand) {
@@ -1043,80 +1034,80 @@ public:
   }
   MarkDependenceInst *createMarkDependence(SILLocation Loc, SILValue value,
                                            SILValue base) {
-    return insert(new (F.getModule()) MarkDependenceInst(
+    return insert(new (F) MarkDependenceInst(
         createSILDebugLocation(Loc), value, base));
   }
   IsUniqueInst *createIsUnique(SILLocation Loc, SILValue operand) {
     auto Int1Ty = SILType::getBuiltinIntegerType(1, getASTContext());
-    return insert(new (F.getModule()) IsUniqueInst(createSILDebugLocation(Loc),
+    return insert(new (F) IsUniqueInst(createSILDebugLocation(Loc),
                                                    operand, Int1Ty));
   }
   IsUniqueOrPinnedInst *createIsUniqueOrPinned(SILLocation Loc,
                                                SILValue value) {
     auto Int1Ty = SILType::getBuiltinIntegerType(1, getASTContext());
-    return insert(new (F.getModule()) IsUniqueOrPinnedInst(
+    return insert(new (F) IsUniqueOrPinnedInst(
         createSILDebugLocation(Loc), value, Int1Ty));
   }
 
   DeallocStackInst *createDeallocStack(SILLocation Loc, SILValue operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       DeallocStackInst(createSILDebugLocation(Loc), operand));
   }
   DeallocRefInst *createDeallocRef(SILLocation Loc, SILValue operand,
                                    bool canBeOnStack) {
-    return insert(new (F.getModule()) DeallocRefInst(
+    return insert(new (F) DeallocRefInst(
         createSILDebugLocation(Loc), operand, canBeOnStack));
   }
   DeallocPartialRefInst *createDeallocPartialRef(SILLocation Loc,
                                                  SILValue operand,
                                                  SILValue metatype) {
-    return insert(new (F.getModule()) DeallocPartialRefInst(
+    return insert(new (F) DeallocPartialRefInst(
         createSILDebugLocation(Loc), operand, metatype));
   }
   DeallocBoxInst *createDeallocBox(SILLocation Loc, SILType eltType,
                                    SILValue operand) {
-    return insert(new (F.getModule()) DeallocBoxInst(
+    return insert(new (F) DeallocBoxInst(
         createSILDebugLocation(Loc), eltType, operand));
   }
   DeallocBoxInst *createDeallocBox(SILLocation Loc, SILValue operand) {
     auto eltType =
         operand.getType().castTo<SILBoxType>()->getBoxedAddressType();
-    return insert(new (F.getModule()) DeallocBoxInst(
+    return insert(new (F) DeallocBoxInst(
         createSILDebugLocation(Loc), eltType, operand));
   }
   DeallocExistentialBoxInst *createDeallocExistentialBox(SILLocation Loc,
                                                          CanType concreteType,
                                                          SILValue operand) {
-    return insert(new (F.getModule()) DeallocExistentialBoxInst(
+    return insert(new (F) DeallocExistentialBoxInst(
         createSILDebugLocation(Loc), concreteType, operand));
   }
   DeallocValueBufferInst *createDeallocValueBuffer(SILLocation Loc,
                                                    SILType valueType,
                                                    SILValue operand) {
-    return insert(new (F.getModule()) DeallocValueBufferInst(
+    return insert(new (F) DeallocValueBufferInst(
         createSILDebugLocation(Loc), valueType, operand));
   }
   DestroyAddrInst *createDestroyAddr(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
+    return insert(new (F)
                       DestroyAddrInst(createSILDebugLocation(Loc), Operand));
   }
 
   ProjectValueBufferInst *createProjectValueBuffer(SILLocation Loc,
                                                    SILType valueType,
                                                    SILValue operand) {
-    return insert(new (F.getModule()) ProjectValueBufferInst(
+    return insert(new (F) ProjectValueBufferInst(
         createSILDebugLocation(Loc), valueType, operand));
   }
   ProjectBoxInst *createProjectBox(SILLocation Loc, SILValue boxOperand) {
     auto valueTy =
         boxOperand.getType().castTo<SILBoxType>()->getBoxedAddressType();
 
-    return insert(new (F.getModule()) ProjectBoxInst(
+    return insert(new (F) ProjectBoxInst(
         createSILDebugLocation(Loc), valueTy, boxOperand));
   }
   ProjectBoxInst *createProjectBox(SILLocation Loc, SILType valueTy,
                                    SILValue boxOperand) {
-    return insert(new (F.getModule()) ProjectBoxInst(
+    return insert(new (F) ProjectBoxInst(
         createSILDebugLocation(Loc), valueTy, boxOperand));
   }
 
@@ -1139,8 +1130,7 @@ public:
   //===--------------------------------------------------------------------===//
 
   CondFailInst *createCondFail(SILLocation Loc, SILValue Operand) {
-    return insert(new (F.getModule())
-                      CondFailInst(createSILDebugLocation(Loc), Operand));
+    return insert(new (F) CondFailInst(createSILDebugLocation(Loc), Operand));
   }
 
   BuiltinInst *createBuiltinTrap(SILLocation Loc) {
@@ -1156,13 +1146,13 @@ public:
 
   IndexAddrInst *createIndexAddr(SILLocation Loc, SILValue Operand,
                                  SILValue Index) {
-    return insert(new (F.getModule()) IndexAddrInst(createSILDebugLocation(Loc),
+    return insert(new (F) IndexAddrInst(createSILDebugLocation(Loc),
                                                     Operand, Index));
   }
 
   IndexRawPointerInst *createIndexRawPointer(SILLocation Loc, SILValue Operand,
                                              SILValue Index) {
-    return insert(new (F.getModule()) IndexRawPointerInst(
+    return insert(new (F) IndexRawPointerInst(
         createSILDebugLocation(Loc), Operand, Index));
   }
 
@@ -1171,18 +1161,18 @@ public:
   //===--------------------------------------------------------------------===//
 
   UnreachableInst *createUnreachable(SILLocation Loc) {
-    return insertTerminator(new (F.getModule())
+    return insertTerminator(new (F)
                                 UnreachableInst(createSILDebugLocation(Loc)));
   }
 
   ReturnInst *createReturn(SILLocation Loc, SILValue ReturnValue) {
-    return insertTerminator(new (F.getModule()) ReturnInst(
+    return insertTerminator(new (F) ReturnInst(
         createSILDebugLocation(Loc), ReturnValue));
   }
 
   ThrowInst *createThrow(SILLocation Loc, SILValue errorValue) {
     return insertTerminator(
-        new (F.getModule()) ThrowInst(createSILDebugLocation(Loc), errorValue));
+        new (F) ThrowInst(createSILDebugLocation(Loc), errorValue));
   }
 
   CondBranchInst *createCondBranch(SILLocation Loc, SILValue Cond,
@@ -1270,7 +1260,7 @@ public:
                                                  SILValue op, SILType destTy,
                                                  SILBasicBlock *successBB,
                                                  SILBasicBlock *failureBB) {
-    return insertTerminator(new (F.getModule()) CheckedCastBranchInst(
+    return insertTerminator(new (F) CheckedCastBranchInst(
         createSILDebugLocation(Loc), isExact, op, destTy, successBB,
         failureBB));
   }
@@ -1280,7 +1270,7 @@ public:
                               SILValue src, CanType sourceType, SILValue dest,
                               CanType targetType, SILBasicBlock *successBB,
                               SILBasicBlock *failureBB) {
-    return insertTerminator(new (F.getModule()) CheckedCastAddrBranchInst(
+    return insertTerminator(new (F) CheckedCastAddrBranchInst(
         createSILDebugLocation(Loc), consumption, src, sourceType, dest,
         targetType, successBB, failureBB));
   }
@@ -1426,9 +1426,12 @@ template<typename ImplClass>
 void
 SILCloner<ImplClass>::visitStrongRetainInst(StrongRetainInst *Inst) {
   getBuilder().setCurrentDebugScope(getOpScope(Inst->getDebugScope()));
-  doPostProcess(Inst,
+  auto *Cloned =
     getBuilder().createStrongRetain(getOpLocation(Inst->getLoc()),
-                                    getOpValue(Inst->getOperand())));
+                                    getOpValue(Inst->getOperand()));
+  Cloned->setNonAtomic(Inst->isNonAtomic());
+  Cloned->setCount(Inst->getCount());
+  doPostProcess(Inst, Cloned);
 }
 
 template<typename ImplClass>
@@ -1472,9 +1475,12 @@ template<typename ImplClass>
 void
 SILCloner<ImplClass>::visitStrongReleaseInst(StrongReleaseInst *Inst) {
   getBuilder().setCurrentDebugScope(getOpScope(Inst->getDebugScope()));
-  doPostProcess(Inst,
+  auto *Cloned =
     getBuilder().createStrongRelease(getOpLocation(Inst->getLoc()),
-                                     getOpValue(Inst->getOperand())));
+                                     getOpValue(Inst->getOperand()));
+  Cloned->setNonAtomic(Inst->isNonAtomic());
+  Cloned->setCount(Inst->getCount());
+  doPostProcess(Inst, Cloned);
 }
 
 template<typename ImplClass>
@@ -20,6 +20,8 @@
 #include "swift/SIL/SILBasicBlock.h"
 #include "swift/SIL/SILLinkage.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include <vector>
 
 /// The symbol name used for the program entry point function.
 /// FIXME: Hardcoding this is lame.
@@ -56,7 +58,24 @@ public:
     /// All other cases (e.g. this function is not a method).
     NotRelevant
   };
-    
+
+  /// Conservative side-effect bits which are serialized together with a
+  /// function, so that clients of a module can reason about an external
+  /// function without deserializing its body. The bits mirror the global
+  /// effects of SideEffectAnalysis.
+  enum SummaryEffectBits : unsigned {
+    SummaryMayRead = 0x1,
+    SummaryMayWrite = 0x2,
+    SummaryMayRetain = 0x4,
+    SummaryMayRelease = 0x8,
+    SummaryMayAllocObjects = 0x10,
+    SummaryMayTrap = 0x20,
+    SummaryMayReadRC = 0x40,
+
+    /// All bits set; used if nothing is known about the function.
+    SummaryWorstEffects = 0x7f
+  };
+
 private:
   friend class SILBasicBlock;
   friend class SILModule;
@@ -78,6 +97,20 @@ private:
   /// function references.
   BlockListType BlockList;
 
+  /// The allocator that manages the memory of this function's instructions.
+  ///
+  /// Instruction memory is reclaimed in bulk when the function is destroyed
+  /// or its body is erased, not instruction-by-instruction.
+  mutable llvm::BumpPtrAllocator InstAllocator;
+
+  /// Arenas adopted from functions whose bodies were spliced into this
+  /// function; the spliced instructions live in these arenas.
+  std::vector<llvm::BumpPtrAllocator> AdoptedInstAllocators;
+
+  /// Take over the instruction arenas of \p F after its body was spliced
+  /// into this function.
+  void adoptInstAllocators(SILFunction *F);
+
   /// The SIL location of the function, which provides a link back to the AST.
   /// The function only gets a location after it's been emitted.
   Optional<SILLocation> Location;
@@ -138,7 +171,15 @@ private:
 
   /// The function's effects attribute.
   EffectsKind EK;
-    
+
+  /// The number of instructions the function had when it was serialized, or
+  /// 0 if no summary is available for it.
+  unsigned SummaryInstCount = 0;
+
+  /// The SummaryEffectBits which were serialized with the function.
+  unsigned SummaryEffects = SummaryWorstEffects;
+
+
   /// True if this function is inlined at least once. This means that the
   /// debug info keeps a pointer to this function.
   bool Inlined = false;
@@ -151,6 +192,11 @@ private:
   ///    method itself. In this case we need to create a vtable stub for it.
   bool Zombie = false;
 
+  /// True if this function was deserialized from a module containing
+  /// canonical SIL, which means it already went through the diagnostic
+  /// passes when that module was built.
+  bool WasDeserializedCanonical = false;
+
   SILFunction(SILModule &module, SILLinkage linkage,
               StringRef mangledName, CanSILFunctionType loweredType,
               GenericParamList *contextGenericParams,
@@ -253,6 +299,16 @@ public:
   /// Returns true if this function is dead, but kept in the module's zombie list.
   bool isZombie() const { return Zombie; }
 
+  /// Mark this function as deserialized from a module containing canonical
+  /// SIL, so that the diagnostic passes do not need to run over it again.
+  void setWasDeserializedCanonical(bool V = true) {
+    WasDeserializedCanonical = V;
+  }
+
+  /// Returns true if this function was deserialized from a module containing
+  /// canonical SIL.
+  bool wasDeserializedCanonical() const { return WasDeserializedCanonical; }
+
   /// Returns the calling convention used by this entry point.
   SILFunctionTypeRepresentation getRepresentation() const {
     return getLoweredFunctionType()->getRepresentation();
@@ -420,6 +476,24 @@ public:
   /// \brief Set the function side effect information.
   void setEffectsKind(EffectsKind E) { EK = E; }
 
+  /// \return True if a summary of the serialized body is available. This is
+  /// the case for deserialized functions, even if only the declaration was
+  /// deserialized.
+  bool hasFunctionSummary() const { return SummaryInstCount != 0; }
+
+  /// \return the number of instructions of the serialized function body.
+  unsigned getSummaryInstructionCount() const { return SummaryInstCount; }
+
+  /// \return the conservative SummaryEffectBits which were serialized with
+  /// the function.
+  unsigned getSummaryEffects() const { return SummaryEffects; }
+
+  /// \brief Record the summary which was serialized with the function.
+  void setFunctionSummary(unsigned InstCount, unsigned Effects) {
+    SummaryInstCount = InstCount;
+    SummaryEffects = Effects;
+  }
+
   /// Get this function's global_init attribute.
   ///
   /// The implied semantics are:
@@ -499,6 +573,30 @@ public:
   /// Splice the body of \p F into this function at end.
   void spliceBody(SILFunction *F) {
     getBlocks().splice(begin(), F->getBlocks());
+    // The spliced instructions live in \p F's arena; adopt that memory so
+    // that it survives if \p F is deleted before this function.
+    adoptInstAllocators(F);
+  }
+
+  /// Erase the body of the function, reclaiming the memory of its
+  /// instructions. The function is left as a bodyless declaration; its
+  /// name, type and linkage are preserved.
+  void eraseBody();
+
+  /// Allocate memory for an instruction of this function using its
+  /// instruction arena.
+  void *allocateInst(unsigned Size, unsigned Align) const {
+    return InstAllocator.Allocate(Size, Align);
+  }
+
+  /// The number of bytes reserved for this function's instructions,
+  /// including arenas adopted from spliced functions. For memory
+  /// accounting.
+  size_t getInstMemorySize() const {
+    size_t Size = InstAllocator.getTotalMemory();
+    for (auto &Allocator : AdoptedInstAllocators)
+      Size += Allocator.getTotalMemory();
+    return Size;
   }
 
   /// Return the unique basic block containing a return inst if it
@@ -1424,7 +1424,7 @@ class DebugValueInst : public UnaryInstructionBase<ValueKind::DebugValueInst> {
   DebugValueInst(SILDebugLocation *DebugLoc, SILValue Operand,
                  SILDebugVariable Var);
   static DebugValueInst *create(SILDebugLocation *DebugLoc, SILValue Operand,
-                                SILModule &M, SILDebugVariable Var);
+                                SILFunction &F, SILDebugVariable Var);
 
 public:
   /// Return the underlying variable declaration that this denotes,
@@ -1446,7 +1446,7 @@ class DebugValueAddrInst
   DebugValueAddrInst(SILDebugLocation *DebugLoc, SILValue Operand,
                      SILDebugVariable Var);
   static DebugValueAddrInst *create(SILDebugLocation *DebugLoc,
-                                    SILValue Operand, SILModule &M,
+                                    SILValue Operand, SILFunction &F,
                                     SILDebugVariable Var);
 
 public:
@@ -2189,12 +2189,32 @@ public:
 /// RefCountingInst - An abstract class of instructions which
 /// manipulate the reference count of their object operand.
 class RefCountingInst : public SILInstruction {
+  /// If true, the object operand is known to be used only by the thread
+  /// which allocated it and the operation may be lowered to a non-atomic
+  /// reference counting entry point.
+  bool NonAtomic = false;
+
+  /// The number of reference counting operations this instruction performs.
+  /// A count greater than one is lowered to a single atomic adjustment by
+  /// that amount; the ARC optimizer produces such instructions by
+  /// coalescing adjacent operations on the same object.
+  unsigned Count = 1;
+
 protected:
   RefCountingInst(ValueKind Kind, SILDebugLocation *DebugLoc,
                   SILTypeList *TypeList = 0)
       : SILInstruction(Kind, DebugLoc, TypeList) {}
 
 public:
+  bool isNonAtomic() const { return NonAtomic; }
+  void setNonAtomic(bool value = true) { NonAtomic = value; }
+
+  unsigned getCount() const { return Count; }
+  void setCount(unsigned count) {
+    assert(count >= 1 && "reference counting operation needs a count");
+    Count = count;
+  }
+
   static bool classof(const ValueBase *V) {
     return V->getKind() >= ValueKind::First_RefCountingInst &&
            V->getKind() <= ValueKind::Last_RefCountingInst;
@@ -405,6 +405,14 @@ public:
   bool linkFunction(StringRef Name,
                     LinkingMode LinkAll = LinkingMode::LinkNormal);
 
+  /// Check if a function with the given mangled name exists in this module or
+  /// in one of the modules it can deserialize from. Unlike linkFunction, this
+  /// never deserializes a function body; if the function is only available in
+  /// a serialized module, a declaration for it is created in this module.
+  ///
+  /// \return true if there is such a function.
+  bool hasFunction(StringRef Name);
+
   /// Link in all Witness Tables in the module.
   void linkAllWitnessTables();
 
@@ -503,6 +511,12 @@ public:
   /// invariants.
   void verify() const;
 
+  /// \brief Run only the module-level structural checks of verify():
+  /// symbol uniqueness, globals, vtables and witness tables.  Function
+  /// bodies are not verified.  Used by the pass manager's incremental
+  /// verification, which verifies bodies only for changed functions.
+  void verifyStructure() const;
+
   /// Pretty-print the module.
   void dump(bool Verbose = false) const;
   
@@ -529,11 +543,18 @@ public:
   /// Allocate memory using the module's internal allocator.
   void *allocate(unsigned Size, unsigned Align) const;
 
-  /// Allocate memory for an instruction using the module's internal allocator.
+  /// Allocate memory for an instruction that is not associated with a
+  /// function, using the module's internal allocator.
+  ///
+  /// Most instructions are allocated from the arena of their function via
+  /// SILFunction::allocateInst(); this entry point only serves placeholder
+  /// instructions which must outlive any particular function.
   void *allocateInst(unsigned Size, unsigned Align) const;
 
-  /// Deallocate memory of an instruction.
-  void deallocateInst(SILInstruction *I);
+  /// Expose the allocator that manages module-lifetime SIL memory, for
+  /// memory accounting. Instruction memory is accounted separately, by
+  /// SILFunction::getInstMemorySize().
+  llvm::BumpPtrAllocator &getAllocator() const { return BPA; }
 
   /// \brief Looks up the llvm intrinsic ID and type for the builtin function.
   ///
@@ -431,7 +431,7 @@ class TypeConverter {
 
   llvm::BumpPtrAllocator IndependentBPA;
   /// BumpPtrAllocator for types dependent on contextual generic parameters,
-  /// which is reset when the generic context is popped.
+  /// which is stashed per generic signature when the context is popped.
   llvm::BumpPtrAllocator DependentBPA;
 
   enum : unsigned {
@@ -517,13 +517,26 @@ class TypeConverter {
   /// Insert a mapping into the cache.
   void insert(TypeKey k, const TypeLowering *tl);
   
-  /// Mapping for types independent on contextual generic parameters, which is
-  /// cleared when the generic context is popped.
+  /// Mapping for types independent on contextual generic parameters.
   llvm::DenseMap<CachingTypeKey, const TypeLowering *> IndependentTypes;
   /// Mapping for types dependent on contextual generic parameters, which is
-  /// cleared when the generic context is popped.
+  /// stashed per generic signature when the context is popped.
   llvm::DenseMap<CachingTypeKey, const TypeLowering *> DependentTypes;
-  
+
+  /// The dependent-type cache and its allocations for one generic signature.
+  struct DependentTypeState {
+    llvm::BumpPtrAllocator BPA;
+    llvm::DenseMap<CachingTypeKey, const TypeLowering *> Map;
+  };
+
+  /// Dependent-type caches retained for generic signatures we have already
+  /// lowered in. Cached dependent lowerings are keyed and stored as interface
+  /// types, so they never reference archetypes of the context they were
+  /// computed in, and re-entering a signature (e.g. for every method of the
+  /// same generic type) can reuse them instead of lowering from scratch.
+  llvm::DenseMap<GenericSignature *, DependentTypeState> DependentTypeStates;
+
+
   llvm::DenseMap<SILDeclRef, SILConstantInfo> ConstantTypes;
   
   llvm::DenseMap<OverrideKey, SILConstantInfo> ConstantOverrideTypes;
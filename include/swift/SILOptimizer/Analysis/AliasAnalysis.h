@@ -242,6 +242,14 @@ public:
   MemBehaviorKeyTy toMemoryBehaviorKey(SILValue V1, SILValue V2, RetainObserveKind K);
 
   virtual void invalidate(SILAnalysis::InvalidationKind K) override {
+    // The cached queries only reason about values and the memory behavior of
+    // instructions; the behavior of apply instructions also depends on the
+    // effects of their callees. Passes which merely rearrange the CFG, e.g.
+    // by splitting edges, don't affect either, and deleted values are
+    // evicted eagerly by handleDeleteNotification.
+    if (!(K & (InvalidationKind::Instructions | InvalidationKind::Calls)))
+      return;
+
     AliasCache.clear();
     MemoryBehaviorCache.clear();
   }
@@ -142,6 +142,12 @@ namespace swift {
     /// Maps functions to their analysis provider.
     StorageTy Storage;
 
+    /// The functions for which the currently executed transform has taken
+    /// over the maintenance of the analysis, e.g. by updating a dominator
+    /// tree incrementally while rewriting the CFG. The flags are consumed
+    /// by the next invalidation round.
+    llvm::DenseSet<SILFunction *> PreservedFunctions;
+
     /// Construct a new empty analysis for a specific function \p F.
     virtual AnalysisTy *newFunctionAnalysis(SILFunction *F) = 0;
 
@@ -166,17 +172,38 @@ namespace swift {
       return it.second;
     }
 
+    /// Notify the analysis that the information for \p F is up to date,
+    /// although the currently executed transform modified \p F. The transform
+    /// takes the responsibility for updating the analysis information, e.g.
+    /// by using the incremental update API of the dominator tree. The
+    /// preservation only lasts until the next invalidation of \p F, so this
+    /// must be called right before the transform reports its invalidation
+    /// kind to the pass manager.
+    void preserveAnalysis(SILFunction *F) { PreservedFunctions.insert(F); }
+
     virtual void invalidate(SILAnalysis::InvalidationKind K) override {
+      // The preservation flags are only valid for the invalidation issued by
+      // the transform which preserved the analysis. Consume them now.
+      llvm::DenseSet<SILFunction *> Preserved;
+      std::swap(Preserved, PreservedFunctions);
+
       if (!shouldInvalidate(K)) return;
 
-      for (auto D : Storage)
+      for (auto &D : Storage) {
+        if (Preserved.count(D.first))
+          continue;
         delete D.second;
-
-      Storage.clear();
+        D.second = nullptr;
+      }
     }
 
     virtual void invalidate(SILFunction *F,
                             SILAnalysis::InvalidationKind K) override {
+      // The currently executed transform kept the information for this
+      // function up to date.
+      if (PreservedFunctions.erase(F))
+        return;
+
       if (!shouldInvalidate(K)) return;
 
       auto &it = Storage.FindAndConstruct(F);
@@ -33,6 +33,7 @@ public:
 private:
   SILModule &M;
   llvm::SmallVector<SCC, 32> TheSCCs;
+  llvm::SmallVector<SmallVector<unsigned, 4>, 8> TheSCCLevels;
   llvm::SmallVector<SILFunction *, 32> TheFunctions;
 
   // The callee analysis we use to determine the callees at each call site.
@@ -56,6 +57,15 @@ public:
     return TheSCCs;
   }
 
+  /// Get the SCCs grouped into call-graph levels, bottom-up.
+  ///
+  /// Each element is a list of indices into getSCCs(). Every call from an
+  /// SCC in one level targets an SCC in a strictly earlier level (or the
+  /// SCC itself), so the SCCs within a single level are independent of one
+  /// another and form a natural batch for running function passes on
+  /// separate threads.
+  ArrayRef<SmallVector<unsigned, 4>> getSCCLevels();
+
   /// Get a flattened view of all functions in all the SCCs in
   /// bottom-up order
   ArrayRef<SILFunction *> getFunctions() {
@@ -497,9 +497,15 @@ public:
   }
 
   /// Returns true if \p R is an immediate subregion of this region.
+  ///
+  /// A region's parent ID is assigned when the region is added to its
+  /// parent's subregion list, so checking it is equivalent to searching the
+  /// subregion list but constant time. This matters during construction: we
+  /// perform this query for every successor edge of every exiting subregion
+  /// of a loop, so a linear scan here makes construction super-linear on
+  /// functions with large loops.
   bool containsSubregion(LoopRegion *R) {
-    auto End = subregion_end();
-    return std::find(subregion_begin(), End, R->getID()) != End;
+    return R->ParentID.hasValue() && *R->ParentID == ID;
   }
 
   /// Returns an ArrayRef containing IDs of the exiting subregions of this
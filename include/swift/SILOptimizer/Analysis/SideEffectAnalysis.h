@@ -321,6 +321,11 @@ private:
   /// Get the side-effects of a function, which has an @effects attribute.
   /// Returns true if \a F has an @effects attribute which could be handled.
   static bool getDefinedEffects(FunctionEffects &Effects, SILFunction *F);
+
+  /// Get the side-effects from the summary which was serialized with \p F.
+  /// Returns true if \a F has a summary. All summary effects are treated as
+  /// global effects.
+  static bool getSerializedEffects(FunctionEffects &Effects, SILFunction *F);
   
   /// Get the side-effects of a semantic call.
   /// Return true if \p ASC could be handled.
@@ -0,0 +1,175 @@
+//===--- ValueRangeAnalysis.h - SIL Value Range Analysis ------*- C++ -*---===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A conservative range analysis for builtin integer SSA values.  Ranges are
+// derived from integer literals and the arithmetic which produced a value,
+// and can be refined with the conditions of dominating cond_br terminators.
+// The analysis is used to remove overflow and bounds checks which are
+// redundant given the possible values of their operands.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SILOPTIMIZER_ANALYSIS_VALUERANGEANALYSIS_H
+#define SWIFT_SILOPTIMIZER_ANALYSIS_VALUERANGEANALYSIS_H
+
+#include "swift/SIL/Dominance.h"
+#include "swift/SIL/SILValue.h"
+#include "swift/SILOptimizer/Analysis/Analysis.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/SmallVector.h"
+
+namespace swift {
+
+class BuiltinInst;
+class CondBranchInst;
+class SILFunction;
+class SILInstruction;
+
+/// A conservative, inclusive range of the possible values of an integer SSA
+/// value.  Signed and unsigned bounds are tracked independently; each pair of
+/// bounds is sound on its own.
+class ValueRange {
+  /// The signed bounds (inclusive).
+  llvm::APInt SMin, SMax;
+  /// The unsigned bounds (inclusive).
+  llvm::APInt UMin, UMax;
+
+public:
+  /// Create the full range for \p BitWidth wide values.
+  explicit ValueRange(unsigned BitWidth)
+      : SMin(llvm::APInt::getSignedMinValue(BitWidth)),
+        SMax(llvm::APInt::getSignedMaxValue(BitWidth)),
+        UMin(llvm::APInt::getMinValue(BitWidth)),
+        UMax(llvm::APInt::getMaxValue(BitWidth)) {}
+
+  /// Create the range containing the single value \p Val.
+  explicit ValueRange(const llvm::APInt &Val)
+      : SMin(Val), SMax(Val), UMin(Val), UMax(Val) {}
+
+  unsigned getBitWidth() const { return SMin.getBitWidth(); }
+
+  const llvm::APInt &getSignedMin() const { return SMin; }
+  const llvm::APInt &getSignedMax() const { return SMax; }
+  const llvm::APInt &getUnsignedMin() const { return UMin; }
+  const llvm::APInt &getUnsignedMax() const { return UMax; }
+
+  bool isKnownNonNegative() const { return SMin.isNonNegative(); }
+
+  /// Returns true if the range contains a single value.
+  bool isSingleValue() const { return SMin == SMax || UMin == UMax; }
+
+  /// Tighten the signed bounds.  The bounds only ever shrink; contradictory
+  /// constraints (possible in unreachable code) may produce an empty range.
+  void clampSignedMin(const llvm::APInt &V) {
+    if (V.sgt(SMin)) SMin = V;
+  }
+  void clampSignedMax(const llvm::APInt &V) {
+    if (V.slt(SMax)) SMax = V;
+  }
+
+  /// Tighten the unsigned bounds.
+  void clampUnsignedMin(const llvm::APInt &V) {
+    if (V.ugt(UMin)) UMin = V;
+  }
+  void clampUnsignedMax(const llvm::APInt &V) {
+    if (V.ult(UMax)) UMax = V;
+  }
+
+  /// Widen this range to also cover \p Other.
+  void mergeWith(const ValueRange &Other) {
+    if (Other.SMin.slt(SMin)) SMin = Other.SMin;
+    if (Other.SMax.sgt(SMax)) SMax = Other.SMax;
+    if (Other.UMin.ult(UMin)) UMin = Other.UMin;
+    if (Other.UMax.ugt(UMax)) UMax = Other.UMax;
+  }
+};
+
+/// Return the width of \p V if it is of a fixed-width builtin integer type
+/// and zero otherwise.
+unsigned getFixedBuiltinIntegerWidth(SILValue V);
+
+/// Compute the range of the possible values of \p V by following the
+/// instructions which produced it.  This is context-free: it does not take
+/// branch conditions into account, so the result is valid anywhere \p V is
+/// available, and the function can be used on IR which is being mutated.
+/// \p V must be of a fixed-width builtin integer type.
+ValueRange computeValueRange(SILValue V, unsigned Depth = 0);
+
+/// Flow-sensitive range information for one function.  Refines the
+/// context-free ranges with the conditions of dominating cond_br
+/// terminators, following the same dominance rule as the redundant overflow
+/// check removal: a branch condition holds in the successor (and everything
+/// it dominates) only if the successor has a single predecessor.
+class ValueRangeInfo {
+  /// A comparison known to hold in all blocks dominated by DominatingBlock.
+  /// The relation is canonicalized so that it always reads
+  /// "Left Relation Right".
+  struct BranchConstraint {
+    enum class Relation { EQ, SLT, SLE, ULT, ULE };
+
+    SILBasicBlock *DominatingBlock;
+    SILValue Left;
+    SILValue Right;
+    Relation Rel;
+
+    BranchConstraint(SILBasicBlock *BB, SILValue L, SILValue R, Relation Rel)
+        : DominatingBlock(BB), Left(L), Right(R), Rel(Rel) {}
+  };
+
+  DominanceInfo DT;
+
+  /// All constraints derived from the cond_br terminators of the function.
+  llvm::SmallVector<BranchConstraint, 16> Constraints;
+
+  void registerBranchConstraints(CondBranchInst *CBI);
+  void applyConstraint(const BranchConstraint &C, SILValue V, ValueRange &R);
+
+public:
+  ValueRangeInfo(SILFunction *F);
+
+  /// Return the context-free range of \p V.
+  ValueRange getRange(SILValue V) { return computeValueRange(V); }
+
+  /// Return the range of \p V at the instruction \p At, refined with all
+  /// dominating branch conditions.
+  ValueRange getRangeAt(SILValue V, SILInstruction *At);
+
+  /// Return true if the overflow arithmetic builtin \p BI (one of the
+  /// s/u add/sub/mul _with_overflow builtins) provably cannot overflow at
+  /// the instruction \p At.
+  bool cannotOverflow(BuiltinInst *BI, SILInstruction *At);
+};
+
+class ValueRangeAnalysis : public FunctionAnalysisBase<ValueRangeInfo> {
+public:
+  ValueRangeAnalysis()
+      : FunctionAnalysisBase<ValueRangeInfo>(AnalysisKind::ValueRange) {}
+
+  ValueRangeAnalysis(const ValueRangeAnalysis &) = delete;
+  ValueRangeAnalysis &operator=(const ValueRangeAnalysis &) = delete;
+
+  static bool classof(const SILAnalysis *S) {
+    return S->getKind() == AnalysisKind::ValueRange;
+  }
+
+  ValueRangeInfo *newFunctionAnalysis(SILFunction *F) override {
+    return new ValueRangeInfo(F);
+  }
+
+  virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
+    return K & InvalidationKind::BranchesAndInstructions;
+  }
+};
+
+} // end namespace swift
+
+#endif
@@ -15,7 +15,9 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <vector>
 
@@ -64,7 +66,36 @@ class SILPassManager {
 
   /// Set to true when a pass invalidates an analysis.
   bool currentPassHasInvalidated = false;
-  
+
+  /// Set to true when the current pass reports a module-wide
+  /// invalidation, after which verification cannot be limited to the
+  /// functions in \c CurrentPassChangedFunctions.
+  bool currentPassInvalidatedModule = false;
+
+  /// The functions for which the current pass reported an invalidation.
+  /// Used to scope verification after the pass to what it changed.
+  llvm::SmallPtrSet<SILFunction *, 16> CurrentPassChangedFunctions;
+
+  /// Cumulative statistics for one transformation, gathered when
+  /// -sil-print-pass-stats is enabled.
+  struct PassStatistics {
+    /// Number of times the pass ran.
+    unsigned NumRuns = 0;
+    /// Total wall time spent in the pass, in nanoseconds.
+    int64_t Nanoseconds = 0;
+    /// Net change in the number of SIL instructions across all runs.
+    int64_t InstructionDelta = 0;
+    /// Number of runs which invalidated at least one analysis.
+    unsigned NumInvalidations = 0;
+  };
+
+  /// Per-pass cumulative statistics, keyed by pass name.  Only populated
+  /// when -sil-print-pass-stats is enabled.
+  llvm::StringMap<PassStatistics> PassStats;
+
+  /// Print the contents of \c PassStats as a table, sorted by total time.
+  void printPassStatistics() const;
+
 public:
   /// C'tor. It creates and registers all analysis passes, which are defined
   /// in Analysis.def.
@@ -102,6 +133,7 @@ public:
         AP->invalidate(K);
 
     currentPassHasInvalidated = true;
+    currentPassInvalidatedModule = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -116,6 +148,7 @@ public:
         AP->invalidate(F, K);
     
     currentPassHasInvalidated = true;
+    CurrentPassChangedFunctions.insert(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
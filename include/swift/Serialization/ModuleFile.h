@@ -28,8 +28,11 @@
 #include "llvm/ADT/Fixnum.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Bitcode/BitstreamReader.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <map>
+
 namespace llvm {
   class BitstreamCursor;
   class BitstreamReader;
@@ -231,21 +234,64 @@ public:
     }
   };
 
+  /// A table of offsets for deserializable entities, read lazily from the
+  /// module's memory-mapped input buffer.
+  ///
+  /// On disk this is a blob of fixed-width little-endian offsets; entries
+  /// are decoded and cached only when first accessed, so loading a module's
+  /// index costs page faults proportional to what is actually looked up
+  /// rather than to the number of entities in the module.
+  template <typename EntryTy>
+  class SerializedOffsetTable {
+    /// The on-disk table, pointing into the module's input buffer.
+    StringRef RawOffsets;
+
+    /// Entries which have been accessed, keyed by index.
+    ///
+    /// This is a std::map rather than a DenseMap because callers hold
+    /// references to entries across recursive deserialization, which may
+    /// materialize further entries.
+    std::map<size_t, EntryTy> Materialized;
+
+  public:
+    /// Points this table at its on-disk representation.
+    void initialize(StringRef rawOffsets) {
+      assert(rawOffsets.size() % sizeof(uint32_t) == 0 &&
+             "malformed offset table");
+      RawOffsets = rawOffsets;
+    }
+
+    size_t size() const { return RawOffsets.size() / sizeof(uint32_t); }
+    bool empty() const { return RawOffsets.empty(); }
+
+    EntryTy &operator[](size_t i) {
+      assert(i < size() && "out-of-bounds offset table access");
+      auto known = Materialized.find(i);
+      if (known == Materialized.end()) {
+        uint32_t offset = llvm::support::endian::read32le(
+            RawOffsets.data() + i * sizeof(uint32_t));
+        known = Materialized.emplace(i, EntryTy(offset)).first;
+      }
+      return known->second;
+    }
+  };
+
 private:
   /// Decls referenced by this module.
-  std::vector<Serialized<Decl*>> Decls;
+  SerializedOffsetTable<Serialized<Decl*>> Decls;
 
   /// DeclContexts referenced by this module.
-  std::vector<Serialized<DeclContext*>> DeclContexts;
+  SerializedOffsetTable<Serialized<DeclContext*>> DeclContexts;
 
   /// Local DeclContexts referenced by this module.
-  std::vector<Serialized<DeclContext*>> LocalDeclContexts;
+  SerializedOffsetTable<Serialized<DeclContext*>> LocalDeclContexts;
 
   /// Normal protocol conformances referenced by this module.
-  std::vector<Serialized<NormalProtocolConformance *>> NormalConformances;
+  SerializedOffsetTable<Serialized<NormalProtocolConformance *>>
+    NormalConformances;
 
   /// Types referenced by this module.
-  std::vector<Serialized<Type>> Types;
+  SerializedOffsetTable<Serialized<Type>> Types;
 
   /// Represents an identifier that may or may not have been deserialized yet.
   ///
@@ -261,7 +307,7 @@ private:
   };
 
   /// Identifiers referenced by this module.
-  std::vector<SerializedIdentifier> Identifiers;
+  SerializedOffsetTable<SerializedIdentifier> Identifiers;
 
   class DeclTableInfo;
   using SerializedDeclTable =
@@ -318,6 +364,10 @@ private:
     /// Whether or not ImportDecls is valid.
     unsigned ComputedImportDecls : 1;
 
+    /// Whether an attempt has been made to read the module documentation
+    /// file, if one was provided.
+    unsigned TriedReadingModuleDoc : 1;
+
     /// Whether this module file can be used, and what's wrong if not.
     unsigned Status : 4;
 
@@ -403,6 +453,13 @@ private:
   /// Returns false if there was an error.
   bool readCommentBlock(llvm::BitstreamCursor &cursor);
 
+  /// Reads the module documentation file, if one was provided and has not
+  /// been read already.
+  ///
+  /// The documentation is read lazily, on the first query for a comment;
+  /// a malformed documentation file is treated as if it were missing.
+  void readModuleDocIfPresent();
+
   /// Recursively reads a pattern from \c DeclTypeCursor.
   ///
   /// If the record at the cursor is not a pattern, returns null.
@@ -631,6 +688,15 @@ public:
   Decl *getDecl(serialization::DeclID DID,
                 Optional<DeclContext *> ForcedContext = None);
 
+  /// Returns the full name of the value decl with the given ID without
+  /// deserializing the decl itself, by peeking at its serialized record.
+  ///
+  /// Name lookup uses this to filter out candidates before paying for full
+  /// decl reconstruction. Returns an empty name if the record kind is not
+  /// handled; callers must treat that as "unknown" and fall back to
+  /// deserializing the decl.
+  DeclName getDeclName(serialization::DeclID DID);
+
   /// Returns the decl context with the given ID, deserializing it if needed.
   DeclContext *getDeclContext(serialization::DeclContextID DID);
 
@@ -51,7 +51,7 @@ const uint16_t VERSION_MAJOR = 0;
 /// To ensure that two separate changes don't silently get merged into one
 /// in source control, you should also update the comment to briefly
 /// describe what change you made.
-const uint16_t VERSION_MINOR = 223; // Last change: SIL @inout_aliasable
+const uint16_t VERSION_MINOR = 225; // Last change: SIL function summaries
 
 using DeclID = Fixnum<31>;
 using DeclIDField = BCFixed<31>;
@@ -1434,7 +1434,7 @@ namespace index_block {
 
   using OffsetsLayout = BCGenericRecordLayout<
     BCFixed<4>,  // record ID
-    BCArray<BitOffsetField>
+    BCBlob  // fixed-width little-endian offsets
   >;
 
   using DeclListLayout = BCGenericRecordLayout<
@@ -81,7 +81,12 @@ public:
 
   SILFunction *lookupSILFunction(SILFunction *Callee);
   SILFunction *lookupSILFunction(SILDeclRef Decl);
-  SILFunction *lookupSILFunction(StringRef Name);
+  /// Lookup a SILFunction by name. If \p declarationOnly is set, only a
+  /// declaration is deserialized, even if a body is available.
+  SILFunction *lookupSILFunction(StringRef Name, bool declarationOnly = false);
+  /// Check for the existence of a SILFunction by name without deserializing
+  /// anything; only the function indices of the loaded modules are consulted.
+  bool hasSILFunction(StringRef Name);
   SILVTable *lookupVTable(Identifier Name);
   SILVTable *lookupVTable(const ClassDecl *C) {
     return lookupVTable(C->getName());
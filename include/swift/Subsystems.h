@@ -34,6 +34,7 @@ namespace llvm {
 }
 
 namespace swift {
+  class AbstractFunctionDecl;
   class ArchetypeBuilder;
   class ASTContext;
   class CodeCompletionCallbacksFactory;
@@ -55,6 +56,7 @@ namespace swift {
   class SILParserTUState;
   class SourceFile;
   class SourceManager;
+  class SourceRange;
   class Token;
   class TopLevelContext;
   struct TypeLoc;
@@ -118,6 +120,23 @@ namespace swift {
                              PersistentParserState &PersistentState,
                              CodeCompletionCallbacksFactory *Factory);
 
+  /// \brief Parse only the delayed function body whose source range entirely
+  /// contains \p TargetRange, leaving all other delayed bodies unparsed.
+  ///
+  /// This supports incremental updates for the common IDE case where an edit
+  /// is confined to a single function body: instead of materializing every
+  /// delayed body in \p DC, only the affected one is parsed, and the caller
+  /// can then type check just that function with
+  /// \c typeCheckAbstractFunctionBodyUntil.
+  ///
+  /// \return the function whose body was parsed, or null if no delayed body
+  /// contains \p TargetRange, in which case the caller must fall back to
+  /// processing the whole context.
+  AbstractFunctionDecl *
+  performDelayedParsingOfBodyContaining(DeclContext *DC,
+                                        PersistentParserState &PersistentState,
+                                        SourceRange TargetRange);
+
   /// \brief Lex and return a vector of tokens for the given buffer.
   std::vector<Token> tokenize(const LangOptions &LangOpts,
                               const SourceManager &SM, unsigned BufferID,
@@ -151,7 +170,13 @@ namespace swift {
 
     /// Indicates that the type checker is checking code that will be
     /// immediately executed.
-    ForImmediateMode = 1 << 2
+    ForImmediateMode = 1 << 2,
+
+    /// If set, function bodies are not type-checked. Declarations are still
+    /// validated in full, so name lookup and indexing remain correct, but no
+    /// body-dependent checking (captures, error handling) is performed and
+    /// the resulting AST is not suitable for SILGen.
+    SkipFunctionBodies = 1 << 3
   };
 
   /// Once parsing and name-binding are complete, this walks the AST to resolve
@@ -224,6 +249,20 @@ namespace swift {
   void serialize(ModuleOrSourceFile DC, const SerializationOptions &options,
                  const SILModule *M = nullptr);
 
+  /// Serializes a module or single source file to in-memory buffers instead
+  /// of writing the output files directly.
+  ///
+  /// The buffers contain exactly the bytes that \c serialize would have
+  /// written to \c options.OutputPath and \c options.DocOutputPath. This
+  /// lets the caller overlap the (potentially large) file writes with later
+  /// stages of compilation, such as IRGen. A buffer is only produced if the
+  /// corresponding out-parameter is non-null and its path is non-empty.
+  void serializeToBuffers(ModuleOrSourceFile DC,
+                          const SerializationOptions &options,
+                          std::unique_ptr<llvm::MemoryBuffer> *moduleBuffer,
+                          std::unique_ptr<llvm::MemoryBuffer> *moduleDocBuffer,
+                          const SILModule *M = nullptr);
+
   /// Get the CPU and subtarget feature options to use when emitting code.
   std::tuple<llvm::TargetOptions, std::string, std::vector<std::string>>
   getIRTargetOptions(IRGenOptions &Opts, ASTContext &Ctx);
@@ -27,7 +27,7 @@
 
 /// Minor version changes when new APIs are added in ABI- and source-compatible
 /// way.
-#define SWIFT_DEMANGLE_VERSION_MINOR 2
+#define SWIFT_DEMANGLE_VERSION_MINOR 3
 
 /// @}
 
@@ -53,6 +53,26 @@ size_t swift_demangle_getSimplifiedDemangledName(const char *MangledName,
                                                  char *OutputBuffer,
                                                  size_t Length);
 
+/// \brief Demangle a batch of Swift function names in a single call.
+///
+/// Each name is handled as if by swift_demangle_getDemangledName, but each
+/// distinct mangled name is demangled only once: symbol tables repeat the
+/// same name many times, and the results are cached in a prefix-compressed
+/// map for the duration of the call. Sorting the input is not required, but
+/// keeps the cache's memory compact because adjacent names share prefixes.
+///
+/// \param MangledNames an array of \p NumNames mangled names.
+/// \param OutputBuffers an array of \p NumNames output buffers. Buffers whose
+/// corresponding name is not a Swift-mangled function name are left untouched.
+/// \param BufferLengths the size of each buffer in \p OutputBuffers.
+/// \param NumNames the number of names in the batch.
+///
+/// \returns the number of names that were successfully demangled.
+size_t swift_demangle_getDemangledNames(const char **MangledNames,
+                                        char **OutputBuffers,
+                                        const size_t *BufferLengths,
+                                        size_t NumNames);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
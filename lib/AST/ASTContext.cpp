@@ -36,6 +36,8 @@
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include <algorithm>
 #include <memory>
@@ -83,6 +85,23 @@ struct ASTContext::Implementation {
 
   llvm::StringMap<char, llvm::BumpPtrAllocator&> IdentifierTable;
 
+  /// A small direct-mapped cache in front of IdentifierTable. Source code
+  /// repeats the same identifiers constantly, so most getIdentifier calls
+  /// can be answered here without a full StringMap probe. Entries point at
+  /// the table's interned key data, which is stable for the lifetime of the
+  /// context.
+  enum { IdentifierCacheSize = 512 };
+  StringRef IdentifierCache[IdentifierCacheSize];
+
+  /// Memoized qualified-lookup expansions, keyed on the root nominal type
+  /// and the lookup options that affect the expansion. Each entry is tagged
+  /// with the generation at which it was computed; bumping
+  /// \c QualifiedLookupGeneration invalidates all entries at once.
+  llvm::DenseMap<std::pair<NominalTypeDecl *, unsigned>,
+                 std::pair<unsigned, std::vector<NominalTypeDecl *>>>
+    QualifiedLookupExpansions;
+  unsigned QualifiedLookupGeneration = 0;
+
   /// The declaration of Swift.Bool.
   NominalTypeDecl *BoolDecl = nullptr;
 
@@ -200,6 +219,10 @@ struct ASTContext::Implementation {
   /// \brief Map from Swift declarations to brief comments.
   llvm::DenseMap<const Decl *, StringRef> BriefComments;
 
+  /// \brief Map from Swift declarations to their USRs. The strings are
+  /// allocated in the ASTContext's allocator.
+  llvm::DenseMap<const Decl *, StringRef> USRs;
+
   /// \brief Map from local declarations to their discriminators.
   /// Missing entries implicitly have value 0.
   llvm::DenseMap<const ValueDecl *, unsigned> LocalDiscriminators;
@@ -482,10 +505,43 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   // Make sure null pointers stay null.
   if (Str.data() == nullptr) return Identifier(0);
 
+  // Probe the hot cache first. The known-identifier names interned when the
+  // context was created seed the cache, so the common stdlib names normally
+  // never reach the table.
+  StringRef &Cached =
+      Impl.IdentifierCache[llvm::HashString(Str) %
+                           Implementation::IdentifierCacheSize];
+  if (Cached.data() && Cached.equals(Str))
+    return Identifier(Cached.data());
+
   auto I = Impl.IdentifierTable.insert(std::make_pair(Str, char())).first;
+  Cached = I->getKey();
   return Identifier(I->getKeyData());
 }
 
+Optional<ArrayRef<NominalTypeDecl *>>
+ASTContext::getQualifiedLookupExpansion(NominalTypeDecl *nominal,
+                                        unsigned lookupOptions) {
+  auto known =
+    Impl.QualifiedLookupExpansions.find({nominal, lookupOptions});
+  if (known == Impl.QualifiedLookupExpansions.end() ||
+      known->second.first != Impl.QualifiedLookupGeneration)
+    return None;
+  return llvm::makeArrayRef(known->second.second);
+}
+
+void ASTContext::setQualifiedLookupExpansion(NominalTypeDecl *nominal,
+                                             unsigned lookupOptions,
+                                             ArrayRef<NominalTypeDecl *> types) {
+  auto &entry = Impl.QualifiedLookupExpansions[{nominal, lookupOptions}];
+  entry.first = Impl.QualifiedLookupGeneration;
+  entry.second.assign(types.begin(), types.end());
+}
+
+void ASTContext::invalidateQualifiedLookupExpansions() {
+  ++Impl.QualifiedLookupGeneration;
+}
+
 void ASTContext::lookupInSwiftModule(
                    StringRef name,
                    SmallVectorImpl<ValueDecl *> &results) const {
@@ -1379,12 +1435,23 @@ ArchetypeBuilder *ASTContext::getOrCreateArchetypeBuilder(
   return builder;
 }
 
-void ASTContext::setArchetypeBuilder(CanGenericSignature sig,
-                                     ModuleDecl *mod,
-                                     std::unique_ptr<ArchetypeBuilder> builder) {
-  if (Impl.ArchetypeBuilders.find({sig, mod})
-        == Impl.ArchetypeBuilders.end()) {
-    Impl.ArchetypeBuilders[{sig, mod}] = move(builder);
+void ASTContext::releaseUnreferencedArchetypeBuilders() {
+  // Collect the builders that are still referenced by an archetype whose
+  // nested types have not been resolved yet.  The potential archetypes
+  // recorded alongside them are owned by their builder, so those builders
+  // have to stay alive.
+  llvm::SmallPtrSet<ArchetypeBuilder *, 8> stillReferenced;
+  for (const auto &entry : Impl.LazyArchetypes)
+    stillReferenced.insert(entry.second.first);
+
+  // Drop every builder that is no longer referenced.  The builders are
+  // only a cache; if one is needed again, getOrCreateArchetypeBuilder
+  // recreates it from the generic signature.
+  for (auto entry = Impl.ArchetypeBuilders.begin(),
+            end = Impl.ArchetypeBuilders.end(); entry != end; ) {
+    auto cur = entry++;
+    if (!stillReferenced.count(cur->second.get()))
+      Impl.ArchetypeBuilders.erase(cur);
   }
 }
 
@@ -1458,6 +1525,18 @@ void ASTContext::setBriefComment(const Decl *D, StringRef Comment) {
   Impl.BriefComments[D] = Comment;
 }
 
+Optional<StringRef> ASTContext::getUSR(const Decl *D) {
+  auto Known = Impl.USRs.find(D);
+  if (Known == Impl.USRs.end())
+    return None;
+
+  return Known->second;
+}
+
+void ASTContext::setUSR(const Decl *D, StringRef USR) {
+  Impl.USRs[D] = AllocateCopy(USR);
+}
+
 unsigned ValueDecl::getLocalDiscriminator() const {
   assert(getDeclContext()->isLocalContext());
   auto &discriminators = getASTContext().Impl.LocalDiscriminators;
@@ -1623,6 +1702,7 @@ size_t ASTContext::getTotalMemory() const {
     llvm::capacity_in_bytes(Impl.ModuleLoaders) +
     llvm::capacity_in_bytes(Impl.RawComments) +
     llvm::capacity_in_bytes(Impl.BriefComments) +
+    llvm::capacity_in_bytes(Impl.USRs) +
     llvm::capacity_in_bytes(Impl.LocalDiscriminators) +
     llvm::capacity_in_bytes(Impl.ModuleTypes) +
     llvm::capacity_in_bytes(Impl.GenericParamTypes) +
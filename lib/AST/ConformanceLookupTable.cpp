@@ -216,27 +216,30 @@ void ConformanceLookupTable::forEachInStage(ConformanceStage stage,
   }
 }
 
-void ConformanceLookupTable::inheritConformances(ClassDecl *classDecl, 
+/// Retrieve the location at which the superclass of the given class
+/// was written, falling back to the superclass's own location.
+static SourceLoc getSuperclassLoc(ClassDecl *classDecl,
+                                  ClassDecl *superclassDecl) {
+  for (const auto &inherited : classDecl->getInherited()) {
+    if (auto inheritedType = inherited.getType()) {
+      if (inheritedType->getClassOrBoundGenericClass())
+        return inherited.getSourceRange().Start;
+    }
+  }
+
+  return superclassDecl->getLoc();
+}
+
+void ConformanceLookupTable::inheritConformances(ClassDecl *classDecl,
                                                  ClassDecl *superclassDecl,
                                                  ExtensionDecl *superclassExt,
                                                  LazyResolver *resolver) {
   // Local function to return the location of the superclass. This
   // takes a little digging, so compute on first use and cache it.
   SourceLoc superclassLoc;
-  auto getSuperclassLoc = [&] {
-    if (superclassLoc.isValid())
-      return superclassLoc;
-
-    for (const auto &inherited : classDecl->getInherited()) {
-      if (auto inheritedType = inherited.getType()) {
-        if (inheritedType->getClassOrBoundGenericClass()) {
-          superclassLoc = inherited.getSourceRange().Start;
-          return superclassLoc;
-        }
-      }
-    }
-
-    superclassLoc = superclassDecl->getLoc();
+  auto getLoc = [&] {
+    if (superclassLoc.isInvalid())
+      superclassLoc = getSuperclassLoc(classDecl, superclassDecl);
     return superclassLoc;
   };
 
@@ -249,9 +252,14 @@ void ConformanceLookupTable::inheritConformances(ClassDecl *classDecl,
     // anyway.
     if (!protocols.insert(protocol).second)
       return;
-    
+
+    // A prior single-protocol lookup may already have created the
+    // inherited entry for this protocol; don't add a second one.
+    if (hasInheritedEntry(protocol))
+      return;
+
     // Add the inherited entry.
-    (void)addProtocol(classDecl, protocol, getSuperclassLoc(), 
+    (void)addProtocol(classDecl, protocol, getLoc(),
                       ConformanceSource::forInherited(classDecl));
   };
 
@@ -265,6 +273,23 @@ void ConformanceLookupTable::inheritConformances(ClassDecl *classDecl,
   }
 }
 
+/// Whether the conformances loaded for the given declaration context
+/// already describe the fully resolved table.  The defining module
+/// serializes the result of its own expansion: explicit and implied
+/// conformances become normal conformance records and conformances
+/// picked up from a superclass become inherited conformance records,
+/// all of which loadAllConformances() registers directly.  Re-running
+/// the expansion algorithm over such a context is redundant.
+///
+/// Protocols are excluded because their conformance lists are not
+/// serialized; their inheritance clauses must be expanded as usual.
+static bool hasFullyResolvedConformances(DeclContext *dc) {
+  if (isa<ProtocolDecl>(dc))
+    return false;
+  auto *file = dyn_cast<FileUnit>(dc->getModuleScopeContext());
+  return file && file->getKind() == FileUnitKind::SerializedAST;
+}
+
 void ConformanceLookupTable::updateLookupTable(NominalTypeDecl *nominal,
                                                ConformanceStage stage,
                                                LazyResolver *resolver) {
@@ -273,14 +298,20 @@ void ConformanceLookupTable::updateLookupTable(NominalTypeDecl *nominal,
     // Record all of the explicit conformances.
     forEachInStage(stage, nominal, resolver,
                    [&](NominalTypeDecl *nominal) {
+                     if (hasFullyResolvedConformances(nominal))
+                       return;
+
                      if (resolver)
                        resolver->resolveInheritanceClause(nominal);
 
-                     addProtocols(nominal, nominal->getInherited(), 
+                     addProtocols(nominal, nominal->getInherited(),
                                   ConformanceSource::forExplicit(nominal),
                                   resolver);
                    },
                    [&](ExtensionDecl *ext) {
+                     if (hasFullyResolvedConformances(ext))
+                       return;
+
                      if (resolver)
                        resolver->resolveInheritanceClause(ext);
 
@@ -295,8 +326,13 @@ void ConformanceLookupTable::updateLookupTable(NominalTypeDecl *nominal,
 
     // For classes, expand implied conformances of the superclass,
     // because an implied conformance in the superclass is considered
-    // "fixed" in the subclass.
+    // "fixed" in the subclass.  A deserialized class already carries
+    // the result of this walk as loaded inherited conformance records,
+    // so it skips the superclass expansion.
     if (auto classDecl = dyn_cast<ClassDecl>(nominal)) {
+      if (hasFullyResolvedConformances(classDecl))
+        break;
+
       if (resolver)
         resolver->resolveSuperclass(classDecl);
 
@@ -339,10 +375,12 @@ void ConformanceLookupTable::updateLookupTable(NominalTypeDecl *nominal,
     // Expand inherited conformances.
     forEachInStage(stage, nominal, resolver,
                    [&](NominalTypeDecl *nominal) {
-                     expandImpliedConformances(nominal, nominal, resolver);
+                     if (!hasFullyResolvedConformances(nominal))
+                       expandImpliedConformances(nominal, nominal, resolver);
                    },
                    [&](ExtensionDecl *ext) {
-                     expandImpliedConformances(nominal, ext, resolver);
+                     if (!hasFullyResolvedConformances(ext))
+                       expandImpliedConformances(nominal, ext, resolver);
                    });
     break;
 
@@ -467,9 +505,24 @@ bool ConformanceLookupTable::addProtocol(NominalTypeDecl *nominal,
   // context.
   AllConformances[dc].push_back(entry);
 
+  // A new conformance can change memoized qualified-lookup expansions.
+  ctx.invalidateQualifiedLookupExpansions();
+
   return true;
 }
 
+bool ConformanceLookupTable::hasInheritedEntry(ProtocolDecl *protocol) const {
+  auto known = Conformances.find(protocol);
+  if (known == Conformances.end())
+    return false;
+
+  for (const auto *entry : known->second)
+    if (entry->getKind() == ConformanceEntryKind::Inherited)
+      return true;
+
+  return false;
+}
+
 void ConformanceLookupTable::addProtocols(NominalTypeDecl *nominal,
                                           ArrayRef<TypeLoc> inherited,
                                           ConformanceSource source,
@@ -879,8 +932,41 @@ bool ConformanceLookupTable::lookupConformance(
        ProtocolDecl *protocol, 
        LazyResolver *resolver,
        SmallVectorImpl<ProtocolConformance *> &conformances) {
-  // Update to record all explicit and inherited conformances.
-  updateLookupTable(nominal, ConformanceStage::Inherited, resolver);
+  // Record the explicit conformances of the type and its extensions. The
+  // inherited and implied conformance sets are populated lazily below:
+  // for a class at the bottom of a large hierarchy, running the full
+  // Inherited stage here would materialize hundreds of entries that a
+  // single-protocol query never looks at.
+  updateLookupTable(nominal, ConformanceStage::RecordedExplicit, resolver);
+
+  // For classes, search the superclass chain for just this protocol
+  // rather than inheriting the superclass's entire conformance set. A
+  // hit creates the one inherited entry that the Inherited stage would
+  // have created for this protocol; supersession of explicit entries is
+  // handled by resolveConformances() below, as usual.
+  if (auto classDecl = dyn_cast<ClassDecl>(nominal)) {
+    if (!VisitingSuperclass && !hasInheritedEntry(protocol)) {
+      if (resolver)
+        resolver->resolveSuperclass(classDecl);
+
+      if (Type superclass = classDecl->getSuperclass()) {
+        if (auto superclassDecl = superclass->getClassOrBoundGenericClass()) {
+          // Break infinite recursion when visiting ill-formed classes
+          // with circular inheritance.
+          llvm::SaveAndRestore<bool> visiting(VisitingSuperclass, true);
+
+          superclassDecl->prepareConformanceTable();
+          SmallVector<ProtocolConformance *, 2> superConformances;
+          if (superclassDecl->ConformanceTable->lookupConformance(
+                module, superclassDecl, protocol, resolver,
+                superConformances))
+            addProtocol(classDecl, protocol,
+                        getSuperclassLoc(classDecl, superclassDecl),
+                        ConformanceSource::forInherited(classDecl));
+        }
+      }
+    }
+  }
 
   // Look for conformances to this protocol.
   auto known = Conformances.find(protocol);
@@ -329,6 +329,11 @@ class ConformanceLookupTable {
   void addProtocols(NominalTypeDecl *nominal, ArrayRef<TypeLoc> inherited,
                     ConformanceSource source, LazyResolver *resolver);
 
+  /// Determine whether the table already contains an inherited
+  /// conformance entry for the given protocol, whether created by the
+  /// Inherited stage or by a single-protocol lookup.
+  bool hasInheritedEntry(ProtocolDecl *protocol) const;
+
   /// Expand the implied conformances for the given DeclContext.
   void expandImpliedConformances(NominalTypeDecl *nominal, DeclContext *dc,
                                  LazyResolver *resolver);
@@ -433,10 +438,14 @@ public:
 
   /// Look for conformances to the given protocol.
   ///
+  /// This populates the table lazily for the queried protocol alone;
+  /// the complete inherited and implied conformance sets are only
+  /// expanded when the query cannot be answered without them.
+  ///
   /// \param conformances Will be populated with the set of protocol
   /// conformances found for this protocol and nominal type.
   ///
-  /// \returns true if any conformances were found. 
+  /// \returns true if any conformances were found.
   bool lookupConformance(ModuleDecl *module,
                          NominalTypeDecl *nominal,
                          ProtocolDecl *protocol, 
@@ -2019,7 +2019,12 @@ ExtensionRange NominalTypeDecl::getExtensions() {
 void NominalTypeDecl::addExtension(ExtensionDecl *extension) {
   assert(!extension->NextExtension.getInt() && "Already added extension");
   extension->NextExtension.setInt(true);
-  
+
+  // The extension may introduce conformances, which can change memoized
+  // qualified-lookup expansions.
+  getASTContext().invalidateQualifiedLookupExpansions();
+
+
   // First extension; set both first and last.
   if (!FirstExtension) {
     FirstExtension = extension;
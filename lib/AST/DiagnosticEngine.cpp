@@ -495,6 +495,12 @@ void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
     break;
   }
 
+  // If there is nobody to consume the diagnostic, don't spend any time
+  // computing its location or formatting its text. The error state above has
+  // already been updated.
+  if (Consumers.empty())
+    return;
+
   // Figure out the source location.
   SourceLoc loc = diagnostic.getLoc();
   if (loc.isInvalid() && diagnostic.getDecl()) {
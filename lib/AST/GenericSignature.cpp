@@ -202,14 +202,12 @@ GenericSignature::getCanonicalManglingSignature(ModuleDecl &M) const {
   }
   
   // Otherwise, we need to compute it.
-  // Dump the generic signature into an ArchetypeBuilder that will figure out
-  // the minimal set of requirements.
-  std::unique_ptr<ArchetypeBuilder> builder(new ArchetypeBuilder(M, 
-                                                                 Context.Diags));
-  
-  builder->addGenericSignature(canonical, /*adoptArchetypes*/ false,
-                               /*treatRequirementsAsExplicit*/ true);
-  
+  // Use the archetype builder associated with the canonical signature, which
+  // has already figured out the minimal set of requirements. This way the
+  // requirement graph is built at most once per (signature, module) pair and
+  // is shared with later archetype-resolution queries.
+  auto *builder = Context.getOrCreateArchetypeBuilder(canonical, &M);
+
   // Sort out the requirements.
   struct DependentConstraints {
     CanType baseClass;
@@ -364,7 +362,6 @@ GenericSignature::getCanonicalManglingSignature(ModuleDecl &M) const {
   
   // Cache the result.
   Context.ManglingSignatures.insert({{canonical, &M}, canSig});
-  Context.setArchetypeBuilder(canSig, &M, std::move(builder));
 
   return canSig;
 }
@@ -1132,7 +1132,28 @@ SourceFile::getImportedModules(SmallVectorImpl<Module::ImportedModule> &modules,
 
 void Module::getImportedModulesForLookup(
     SmallVectorImpl<ImportedModule> &modules) const {
+  // Every lookup that walks the import graph re-requests this list for each
+  // module it visits, so cache it. Only modules without source files are
+  // cached; the module currently being compiled picks up new imports as
+  // files are added to it.
+  if (ImportedModulesForLookupCache) {
+    modules.append(ImportedModulesForLookupCache->begin(),
+                   ImportedModulesForLookupCache->end());
+    return;
+  }
+
+  size_t firstImport = modules.size();
   FORWARD(getImportedModulesForLookup, (modules));
+
+  bool hasSourceFiles = std::any_of(getFiles().begin(), getFiles().end(),
+                                    [](const FileUnit *file) {
+    return isa<SourceFile>(file);
+  });
+  if (!hasSourceFiles) {
+    ArrayRef<ImportedModule> imports(modules.begin() + firstImport,
+                                     modules.end());
+    ImportedModulesForLookupCache = getASTContext().AllocateCopy(imports);
+  }
 }
 
 bool Module::isSameAccessPath(AccessPathTy lhs, AccessPathTy rhs) {
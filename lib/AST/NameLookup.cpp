@@ -25,6 +25,7 @@
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/STLExtras.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/TinyPtrVector.h"
 
 using namespace swift;
@@ -688,6 +689,14 @@ class swift::MemberLookupTable {
   /// Lookup table mapping names to the set of declarations with that name.
   LookupTable Lookup;
 
+  /// The names for which the lookup table already contains every member with
+  /// that name, even though the full member lists have not been loaded.
+  /// Populated by named lazy member loading. The value is the last extension
+  /// whose members with that name have been included, analogous to
+  /// LastExtensionIncluded; null means no extensions have been considered
+  /// for the name yet.
+  llvm::DenseMap<DeclName, ExtensionDecl *> LazilyCompleteNames;
+
 public:
   /// Create a new member lookup table.
   explicit MemberLookupTable(ASTContext &ctx);
@@ -710,6 +719,26 @@ public:
                            ExtensionDecl *ext,
                            DeclRange members);
 
+  /// Determine whether the table contains every member of the nominal type
+  /// itself with the given name, courtesy of named lazy member loading.
+  bool isLazilyComplete(DeclName name) const {
+    return LazilyCompleteNames.count(name);
+  }
+
+  /// Note that the table contains every member of the nominal type itself
+  /// with the given name.
+  void markLazilyComplete(DeclName name) {
+    LazilyCompleteNames.insert({name, nullptr});
+  }
+
+  /// Make sure a lazily-complete name also covers all of the extensions of
+  /// \p nominal, loading extension members with that name on demand where
+  /// possible.
+  ///
+  /// Returns false if some extension can only load its entire member list at
+  /// once, in which case the caller should fall back to eager loading.
+  bool updateLazilyCompleteName(NominalTypeDecl *nominal, DeclName name);
+
   /// Iterator into the lookup table.
   typedef LookupTable::iterator iterator;
 
@@ -839,6 +868,40 @@ void MemberLookupTable::updateLookupTable(NominalTypeDecl *nominal) {
   }
 }
 
+bool MemberLookupTable::updateLazilyCompleteName(NominalTypeDecl *nominal,
+                                                 DeclName name) {
+  assert(isLazilyComplete(name));
+
+  // Visit any extensions that have not yet been considered for this name.
+  // Don't hold an iterator into LazilyCompleteNames across the loads below;
+  // loading members can recursively end up back in name lookup.
+  ExtensionDecl *last = LazilyCompleteNames.lookup(name);
+  for (auto next = last ? last->NextExtension.getPointer()
+                        : nominal->FirstExtension;
+       next;
+       (last = next, next = next->NextExtension.getPointer())) {
+    if (!next->isLazy()) {
+      // The extension's members are already available; just index them.
+      addMembers(next->getMembers());
+      continue;
+    }
+
+    auto members = next->getLoader()->loadNamedMembers(
+        next, name, next->getLoaderContextData());
+    if (!members) {
+      // This extension can only load its members all at once. Remember how
+      // far we got and let the caller fall back to eager loading.
+      LazilyCompleteNames[name] = last;
+      return false;
+    }
+    for (auto member : *members)
+      addMember(member);
+  }
+
+  LazilyCompleteNames[name] = last;
+  return true;
+}
+
 void MemberLookupTable::destroy() {
   this->~MemberLookupTable();
 }
@@ -925,6 +988,45 @@ void NominalTypeDecl::makeMemberVisible(ValueDecl *member) {
 
 ArrayRef<ValueDecl *> NominalTypeDecl::lookupDirect(DeclName name,
                                                     bool ignoreNewExtensions) {
+  // With named lazy member loading, a lookup into a context whose members
+  // have not been loaded yet (e.g. a Clang-imported class) can often be
+  // answered by loading just the members with the given name, rather than
+  // the entire member list.
+  if (!LookupTable.getInt() && hasLazyMembers()) {
+    auto &ctx = getASTContext();
+    if (!LookupTable.getPointer())
+      LookupTable.setPointer(new (ctx) MemberLookupTable(ctx));
+    auto *table = LookupTable.getPointer();
+
+    if (!table->isLazilyComplete(name)) {
+      auto members = IterableDeclContext::getLoader()->loadNamedMembers(
+          this, name, IterableDeclContext::getLoaderContextData());
+      if (members) {
+        for (auto member : *members)
+          table->addMember(member);
+        table->markLazilyComplete(name);
+      }
+    }
+
+    if (table->isLazilyComplete(name)) {
+      // Materialize any extensions that have appeared since the last lookup
+      // and bring in their members with this name.
+      bool coveredExtensions = ignoreNewExtensions;
+      if (!ignoreNewExtensions) {
+        (void)getExtensions();
+        coveredExtensions = table->updateLazilyCompleteName(this, name);
+      }
+
+      if (coveredExtensions) {
+        auto known = table->find(name);
+        if (known == table->end())
+          return { };
+        return { known->second.begin(), known->second.size() };
+      }
+    }
+    // The loader could not answer a per-name query; load everything below.
+  }
+
   // Make sure we have the complete list of members (in this nominal and in all
   // extensions).
   if (!ignoreNewExtensions) {
@@ -1250,12 +1352,10 @@ bool DeclContext::lookupQualified(Type type,
       tracker = nullptr;
   }
 
-  // Visit all of the nominal types we know about, discovering any others
-  // we need along the way.
-  while (!stack.empty()) {
-    auto current = stack.back();
-    stack.pop_back();
-
+  // Visit a single nominal type: record the dependency and filter the
+  // results of a direct lookup into it. Used both when walking the supertype
+  // and protocol expansion and when replaying a memoized expansion.
+  auto visitNominalType = [&](NominalTypeDecl *current) {
     if (tracker)
       tracker->addUsedMember({current, member.getBaseName()},isLookupCascading);
 
@@ -1264,7 +1364,6 @@ bool DeclContext::lookupQualified(Type type,
       typeResolver->resolveImplicitConstructors(current);
 
     // Look for results within the current nominal type and its extensions.
-    bool currentIsProtocol = isa<ProtocolDecl>(current);
     for (auto decl : current->lookupDirect(member)) {
       // Resolve the declaration signature when we find the
       // declaration.
@@ -1278,6 +1377,47 @@ bool DeclContext::lookupQualified(Type type,
       if (isAcceptableDecl(current, decl))
         decls.push_back(decl);
     }
+  };
+
+  // The supertype and protocol expansion for a nominal root is the same for
+  // every lookup with the same options, so memoize it on the ASTContext.
+  // Lookups for 'init' are excluded because their walk depends on
+  // inherited-initializer state, not just the type hierarchy.
+  unsigned expansionOptions =
+    options & (NL_VisitSupertypes | NL_ProtocolMembers | NL_DynamicLookup);
+  NominalTypeDecl *expansionRoot = nullptr;
+  if ((options & NL_VisitSupertypes) &&
+      member.getBaseName() != ctx.Id_init &&
+      stack.size() == 1 && type->getAnyNominal() == stack.back())
+    expansionRoot = stack.back();
+
+  if (expansionRoot) {
+    if (auto expansion =
+          ctx.getQualifiedLookupExpansion(expansionRoot, expansionOptions)) {
+      for (auto current : *expansion)
+        visitNominalType(current);
+      stack.clear();
+      expansionRoot = nullptr;
+    }
+  }
+
+  // Visit all of the nominal types we know about, discovering any others
+  // we need along the way.
+  SmallVector<NominalTypeDecl *, 8> expansionOrder;
+  bool expansionIsCacheable = true;
+  while (!stack.empty()) {
+    auto current = stack.back();
+    stack.pop_back();
+
+    // A class whose superclass has not been computed yet would memoize an
+    // incomplete expansion.
+    if (auto classDecl = dyn_cast<ClassDecl>(current))
+      if (!classDecl->isSuperclassComputed())
+        expansionIsCacheable = false;
+    expansionOrder.push_back(current);
+
+    bool currentIsProtocol = isa<ProtocolDecl>(current);
+    visitNominalType(current);
 
     // If we're not supposed to visit our supertypes, we're done.
     if ((options & NL_VisitSupertypes) == 0)
@@ -1323,6 +1463,12 @@ bool DeclContext::lookupQualified(Type type,
       wantProtocolMembers = false;
   }
 
+  // Memoize the expansion we just performed for later lookups into the same
+  // root with the same options.
+  if (expansionRoot && expansionIsCacheable)
+    ctx.setQualifiedLookupExpansion(expansionRoot, expansionOptions,
+                                    expansionOrder);
+
   // If we want to perform lookup into all classes, do so now.
   if (wantLookupInAllClasses) {
     if (tracker)
@@ -21,6 +21,7 @@
 #include "swift/AST/Expr.h"
 #include "swift/AST/TypeRefinementContext.h"
 #include "swift/Basic/SourceManager.h"
+#include <algorithm>
 
 using namespace swift;
 
@@ -136,27 +137,76 @@ void *TypeRefinementContext::operator new(size_t Bytes, ASTContext &C,
   return C.Allocate(Bytes, Alignment);
 }
 
+void TypeRefinementContext::addChild(TypeRefinementContext *Child) {
+  assert(Child->getSourceRange().isValid());
+
+  // Keep the children sorted by the start of their refined ranges so that
+  // lookups can binary search.  The builder introduces children in source
+  // order, so check for the common append case before searching for an
+  // insertion point.  All of the children refine ranges in the same source
+  // buffer, so their locations can be compared directly.
+  if (Children.empty() ||
+      Children.back()->SrcRange.Start.getOpaquePointerValue() <=
+        Child->SrcRange.Start.getOpaquePointerValue()) {
+    Children.push_back(Child);
+    return;
+  }
+
+  auto I = std::upper_bound(
+      Children.begin(), Children.end(), Child,
+      [](const TypeRefinementContext *LHS, const TypeRefinementContext *RHS) {
+        return LHS->SrcRange.Start.getOpaquePointerValue() <
+               RHS->SrcRange.Start.getOpaquePointerValue();
+      });
+  Children.insert(I, Child);
+}
+
+TypeRefinementContext *
+TypeRefinementContext::findChildContaining(SourceLoc Loc, SourceManager &SM) {
+  // The children are sorted by the start of their refined ranges and sibling
+  // ranges are disjoint, so the only child that can contain Loc is the last
+  // one whose range starts at or before it.
+  auto I = std::upper_bound(
+      Children.begin(), Children.end(), Loc,
+      [](SourceLoc Loc, const TypeRefinementContext *TRC) {
+        return Loc.getOpaquePointerValue() <
+               TRC->SrcRange.Start.getOpaquePointerValue();
+      });
+  if (I == Children.begin())
+    return nullptr;
+
+  TypeRefinementContext *Child = *(I - 1);
+  if (!SM.rangeContainsTokenLoc(Child->SrcRange, Loc))
+    return nullptr;
+  return Child;
+}
+
 TypeRefinementContext *
 TypeRefinementContext::findMostRefinedSubContext(SourceLoc Loc,
                                                  SourceManager &SM) {
   assert(Loc.isValid());
-  
+
   if (SrcRange.isValid() && !SM.rangeContainsTokenLoc(SrcRange, Loc))
     return nullptr;
 
-  // For the moment, we perform a linear search here, but we can and should
-  // do something more efficient.
-  for (TypeRefinementContext *Child : Children) {
-    if (auto *Found = Child->findMostRefinedSubContext(Loc, SM)) {
-      return Found;
-    }
-  }
+  if (auto *Child = findChildContaining(Loc, SM))
+    return Child->findMostRefinedSubContext(Loc, SM);
 
   // Loc is in this context's range but not in any child's, so this context
   // must be the inner-most context.
   return this;
 }
 
+bool TypeRefinementContext::isMostRefinedSubContextFor(SourceLoc Loc,
+                                                       SourceManager &SM) {
+  assert(Loc.isValid());
+
+  if (SrcRange.isValid() && !SM.rangeContainsTokenLoc(SrcRange, Loc))
+    return false;
+
+  return findChildContaining(Loc, SM) == nullptr;
+}
+
 void TypeRefinementContext::dump(SourceManager &SrcMgr) const {
   dump(llvm::errs(), SrcMgr);
 }
@@ -29,7 +29,7 @@ static inline StringRef getUSRSpacePrefix() {
   return "s:";
 }
 
-bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+static bool printDeclUSRImpl(const ValueDecl *D, raw_ostream &OS) {
   using namespace Mangle;
 
   if (!isa<FuncDecl>(D) && !D->hasName())
@@ -90,6 +90,26 @@ bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
   return false;
 }
 
+bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+  // USRs for the same declaration are requested over and over again by
+  // indexing and cursor-info; compute each one once and cache it in the
+  // ASTContext.
+  auto &Ctx = D->getASTContext();
+  if (auto USR = Ctx.getUSR(D)) {
+    OS << *USR;
+    return false;
+  }
+
+  llvm::SmallString<128> Buf;
+  llvm::raw_svector_ostream BufOS(Buf);
+  if (printDeclUSRImpl(D, BufOS))
+    return true; // Ignore; don't cache, the decl may not be fully formed yet.
+
+  Ctx.setUSR(D, BufOS.str());
+  OS << BufOS.str();
+  return false;
+}
+
 bool ide::printAccessorUSR(const AbstractStorageDecl *D, AccessorKind AccKind,
                            llvm::raw_ostream &OS) {
   using namespace Mangle;
@@ -2865,8 +2865,22 @@ struct ASTNodeBase {};
 
 void swift::verify(SourceFile &SF) {
 #if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
+  const ASTContext &Context = SF.getASTContext();
+  if (Context.LangOpts.ASTVerifierProcessCount == 1 &&
+      Context.LangOpts.ASTVerifierSampleRate == 1) {
+    Verifier verifier(SF, &SF);
+    SF.walk(verifier);
+    return;
+  }
+
+  // Verify only the selected subset of declarations.  The selection is a
+  // deterministic hash of the declaration name, so repeated runs over the
+  // same source verify the same sample.
   Verifier verifier(SF, &SF);
-  SF.walk(verifier);
+  for (Decl *D : SF.Decls) {
+    if (shouldVerify(D, Context))
+      D->walk(verifier);
+  }
 #endif
 }
 
@@ -2874,8 +2888,9 @@ bool swift::shouldVerify(const Decl *D, const ASTContext &Context) {
 #if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
   unsigned ProcessCount = Context.LangOpts.ASTVerifierProcessCount;
   unsigned ProcessId = Context.LangOpts.ASTVerifierProcessId;
-  if (ProcessCount == 1) {
-    // No parallelism, verify all declarations.
+  unsigned SampleRate = Context.LangOpts.ASTVerifierSampleRate;
+  if (ProcessCount == 1 && SampleRate == 1) {
+    // No parallelism or sampling, verify all declarations.
     return true;
   }
 
@@ -2890,7 +2905,9 @@ bool swift::shouldVerify(const Decl *D, const ASTContext &Context) {
   }
 
   size_t Hash = llvm::hash_value(VD->getNameStr());
-  return Hash % ProcessCount == ProcessId;
+  if (ProcessCount != 1 && Hash % ProcessCount != ProcessId)
+    return false;
+  return Hash % SampleRate == 0;
 #else
   return false;
 #endif
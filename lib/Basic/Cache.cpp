@@ -14,12 +14,24 @@
 #include "Darwin/Cache-Mac.cpp"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements a default caching implementation in the spirit of
+//  the Darwin libcache one: it is sharded to avoid serializing concurrent
+//  clients on a single lock, it evicts least-recently-used entries when
+//  the accumulated cost of a shard exceeds its budget, and it defers
+//  destroying a value that a client has retained until the client releases
+//  it.
+//
+//  The total cost budget can be tuned with the SWIFT_CACHE_COST_LIMIT
+//  environment variable (in bytes).  Setting SWIFT_CACHE_PRINT_STATS makes
+//  each cache print hit/miss/eviction counts when it is destroyed.
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cassert>
+#include <cstdlib>
+#include <string>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -33,12 +45,32 @@ struct DefaultCacheKey {
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
 
-struct DefaultCache {
-  llvm::sys::Mutex Mux;
-  CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
+/// A cache entry, linked into its shard's LRU list.  The head of the list
+/// is the most recently used entry; eviction pops from the tail.
+struct CacheEntry {
+  void *Key;
+  void *Value;
+  size_t Cost;
+  CacheEntry *Prev = nullptr;
+  CacheEntry *Next = nullptr;
 
-  explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
+  CacheEntry(void *Key, void *Value, size_t Cost)
+    : Key(Key), Value(Value), Cost(Cost) {}
+};
+
+/// Book-keeping for one value pointer.  A value may be referenced by more
+/// than one live entry (e.g. an IntrusiveRefCntPtr stored under two keys)
+/// and retained by clients; the value destroy callback for an evicted
+/// entry is deferred until no client retains the value.
+struct ValueRef {
+  /// Outstanding client retains, including the initial retain taken by
+  /// setAndRetain().
+  unsigned Retains = 0;
+  /// Number of live cache entries holding this value.
+  unsigned LiveEntries = 0;
+  /// Destroy callbacks owed for entries that were removed while a client
+  /// still retained the value.
+  unsigned PendingDestroys = 0;
 };
 } // end anonymous namespace
 
@@ -67,76 +99,258 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 }
 
+namespace {
+struct DefaultCache {
+  enum { NumShards = 8 };
+
+  /// Entries hashed by key.  Each shard has its own lock, LRU list and
+  /// cost budget so that concurrent clients only contend when they hash
+  /// to the same shard.
+  struct Shard {
+    llvm::sys::Mutex Mux;
+    llvm::DenseMap<DefaultCacheKey, CacheEntry *> Entries;
+    CacheEntry *Head = nullptr;
+    CacheEntry *Tail = nullptr;
+    size_t TotalCost = 0;
+    size_t CostLimit = 0;
+    uint64_t Hits = 0;
+    uint64_t Misses = 0;
+    uint64_t Evictions = 0;
+  };
+
+  /// Retain counts hashed by value pointer.  Sharded separately from the
+  /// entries because releaseValue() only receives the value.
+  struct ValueShard {
+    llvm::sys::Mutex Mux;
+    llvm::DenseMap<void *, ValueRef> Values;
+  };
+
+  std::string Name;
+  CacheImpl::CallBacks CBs;
+  Shard Shards[NumShards];
+  ValueShard ValueShards[NumShards];
+
+  DefaultCache(StringRef Name, CacheImpl::CallBacks CBs)
+      : Name(Name), CBs(std::move(CBs)) {
+    size_t costLimit = getTotalCostLimit() / NumShards;
+    for (auto &shard : Shards)
+      shard.CostLimit = costLimit;
+  }
+
+  Shard &getShardForKeyHash(uintptr_t Hash) {
+    // DenseMap consumes the low bits of the hash; pick the shard from
+    // higher ones so the two decisions are independent.
+    return Shards[(Hash >> 4) % NumShards];
+  }
+
+  ValueShard &getShardForValue(const void *Value) {
+    return ValueShards[((uintptr_t)Value >> 4) % NumShards];
+  }
+
+  static size_t getTotalCostLimit() {
+    if (const char *Opt = ::getenv("SWIFT_CACHE_COST_LIMIT"))
+      if (size_t Limit = ::atoll(Opt))
+        return Limit;
+    return 64 << 20; // 64MB.
+  }
+
+  /// Record that an entry referencing \p Value came into existence with
+  /// the initial retain of setAndRetain().
+  void retainNewValue(void *Value) {
+    ValueShard &VShard = getShardForValue(Value);
+    llvm::sys::ScopedLock L(VShard.Mux);
+    ValueRef &VR = VShard.Values[Value];
+    ++VR.Retains;
+    ++VR.LiveEntries;
+  }
+
+  void retainValue(void *Value) {
+    ValueShard &VShard = getShardForValue(Value);
+    llvm::sys::ScopedLock L(VShard.Mux);
+    ++VShard.Values[Value].Retains;
+  }
+
+  void releaseValue(void *Value) {
+    ValueShard &VShard = getShardForValue(Value);
+    llvm::sys::ScopedLock L(VShard.Mux);
+    auto It = VShard.Values.find(Value);
+    assert(It != VShard.Values.end() && "releasing an unknown value");
+    ValueRef &VR = It->second;
+    assert(VR.Retains > 0 && "value over-released");
+    if (--VR.Retains > 0)
+      return;
+    unsigned PendingDestroys = VR.PendingDestroys;
+    VR.PendingDestroys = 0;
+    if (VR.LiveEntries == 0)
+      VShard.Values.erase(It);
+    while (PendingDestroys--)
+      CBs.valueDestroyCB(Value, CBs.UserData);
+  }
+
+  /// An entry referencing \p Value was removed from the cache.  Destroy
+  /// the value now if no client retains it, otherwise defer.
+  void releaseEntryValue(void *Value) {
+    ValueShard &VShard = getShardForValue(Value);
+    llvm::sys::ScopedLock L(VShard.Mux);
+    auto It = VShard.Values.find(Value);
+    assert(It != VShard.Values.end() && "removing an entry of unknown value");
+    ValueRef &VR = It->second;
+    assert(VR.LiveEntries > 0);
+    --VR.LiveEntries;
+    if (VR.Retains > 0) {
+      ++VR.PendingDestroys;
+      return;
+    }
+    if (VR.LiveEntries == 0)
+      VShard.Values.erase(It);
+    CBs.valueDestroyCB(Value, CBs.UserData);
+  }
+
+  /// Unlink \p Entry from its shard's LRU list.  The shard lock must be
+  /// held.
+  void unlink(Shard &S, CacheEntry *Entry) {
+    if (Entry->Prev)
+      Entry->Prev->Next = Entry->Next;
+    else
+      S.Head = Entry->Next;
+    if (Entry->Next)
+      Entry->Next->Prev = Entry->Prev;
+    else
+      S.Tail = Entry->Prev;
+    Entry->Prev = Entry->Next = nullptr;
+  }
+
+  /// Link \p Entry at the most-recently-used end of the list.  The shard
+  /// lock must be held.
+  void linkAtHead(Shard &S, CacheEntry *Entry) {
+    Entry->Next = S.Head;
+    Entry->Prev = nullptr;
+    if (S.Head)
+      S.Head->Prev = Entry;
+    S.Head = Entry;
+    if (!S.Tail)
+      S.Tail = Entry;
+  }
+
+  /// Remove \p Entry from the shard, destroying its key immediately and
+  /// its value once no client retains it.  The shard lock must be held.
+  void removeEntry(Shard &S, CacheEntry *Entry) {
+    S.Entries.erase(DefaultCacheKey(Entry->Key, &CBs));
+    unlink(S, Entry);
+    S.TotalCost -= Entry->Cost;
+    CBs.keyDestroyCB(Entry->Key, CBs.UserData);
+    releaseEntryValue(Entry->Value);
+    delete Entry;
+  }
+
+  /// Evict least-recently-used entries until the shard is back under its
+  /// cost budget, never evicting \p Keep.  The shard lock must be held.
+  void evictToCostLimit(Shard &S, CacheEntry *Keep) {
+    while (S.TotalCost > S.CostLimit && S.Tail && S.Tail != Keep) {
+      removeEntry(S, S.Tail);
+      ++S.Evictions;
+    }
+  }
+
+  void printStats() const {
+    uint64_t Hits = 0, Misses = 0, Evictions = 0, Entries = 0, Cost = 0;
+    for (const auto &S : Shards) {
+      Hits += S.Hits;
+      Misses += S.Misses;
+      Evictions += S.Evictions;
+      Entries += S.Entries.size();
+      Cost += S.TotalCost;
+    }
+    llvm::errs() << "swift::sys::Cache '" << Name << "': "
+                 << Hits << " hits, " << Misses << " misses, "
+                 << Evictions << " evictions, " << Entries
+                 << " entries of total cost " << Cost << "\n";
+  }
+};
+} // end anonymous namespace
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
-  return new DefaultCache(CBs);
+  return new DefaultCache(Name, CBs);
 }
 
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  uintptr_t Hash = DCache.CBs.keyHashCB(Key, DCache.CBs.UserData);
+  DefaultCache::Shard &S = DCache.getShardForKeyHash(Hash);
+  llvm::sys::ScopedLock L(S.Mux);
 
   DefaultCacheKey CKey(Key, &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueDestroyCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
-  }
+  auto It = S.Entries.find(CKey);
+  if (It != S.Entries.end())
+    DCache.removeEntry(S, It->second);
 
-  DCache.Entries[CKey] = Value;
+  CacheEntry *Entry = new CacheEntry(Key, Value, Cost);
+  S.Entries[DefaultCacheKey(Key, &DCache.CBs)] = Entry;
+  DCache.linkAtHead(S, Entry);
+  S.TotalCost += Cost;
+  DCache.retainNewValue(Value);
 
-  // FIXME: Not thread-safe! It should avoid deleting the value until
-  // 'releaseValue is called on it.
+  DCache.evictToCostLimit(S, Entry);
 }
 
 bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  uintptr_t Hash =
+      DCache.CBs.keyHashCB(const_cast<void*>(Key), DCache.CBs.UserData);
+  DefaultCache::Shard &S = DCache.getShardForKeyHash(Hash);
+  llvm::sys::ScopedLock L(S.Mux);
 
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    // FIXME: Not thread-safe! It should avoid deleting the value until
-    // 'releaseValue is called on it.
-    *Value_out = Entry->second;
-    return true;
-  }
-  return false;
+  auto It = S.Entries.find(CKey);
+  if (It == S.Entries.end()) {
+    ++S.Misses;
+    return false;
+  }
+
+  CacheEntry *Entry = It->second;
+  DCache.unlink(S, Entry);
+  DCache.linkAtHead(S, Entry);
+  DCache.retainValue(Entry->Value);
+  ++S.Hits;
+  *Value_out = Entry->Value;
+  return true;
 }
 
 void CacheImpl::releaseValue(void *Value) {
-  // FIXME: Implementation.
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  DCache.releaseValue(Value);
 }
 
 bool CacheImpl::remove(const void *Key) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  uintptr_t Hash =
+      DCache.CBs.keyHashCB(const_cast<void*>(Key), DCache.CBs.UserData);
+  DefaultCache::Shard &S = DCache.getShardForKeyHash(Hash);
+  llvm::sys::ScopedLock L(S.Mux);
 
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueDestroyCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
-    return true;
-  }
-  return false;
+  auto It = S.Entries.find(CKey);
+  if (It == S.Entries.end())
+    return false;
+  DCache.removeEntry(S, It->second);
+  return true;
 }
 
 void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
-
-  for (auto Entry : DCache.Entries) {
-    DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueDestroyCB(Entry.second, nullptr);
+  for (auto &S : DCache.Shards) {
+    llvm::sys::ScopedLock L(S.Mux);
+    while (S.Tail)
+      DCache.removeEntry(S, S.Tail);
   }
-  DCache.Entries.clear();
 }
 
 void CacheImpl::destroy() {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  if (::getenv("SWIFT_CACHE_PRINT_STATS"))
+    DCache.printStats();
   removeAll();
-  delete static_cast<DefaultCache*>(Impl);
+  delete &DCache;
 }
 
 #endif // finish default implementation
@@ -22,15 +22,25 @@
 using namespace swift;
 
 ClusteredBitVector ClusteredBitVector::fromAPInt(const llvm::APInt &bits) {
-  // This is not a very efficient algorithm.
   ClusteredBitVector result;
-  for (unsigned i = 0, e = bits.getBitWidth(); i != e; ++i) {
-    if (bits[i]) {
-      result.appendSetBits(1);
-    } else {
-      result.appendClearBits(1);
-    }
+  size_t numBits = bits.getBitWidth();
+  if (numBits == 0)
+    return result;
+
+  // An all-zero value keeps the inline-and-all-clear representation.
+  if (!bits) {
+    result.appendClearBits(numBits);
+    return result;
   }
+
+  // Otherwise, append the words of the value directly.  This assumes that
+  // the chunk size is the same as APInt's; APInt guarantees that the unused
+  // high bits of its last word are zero, which is the same invariant the
+  // chunk storage maintains.
+  static_assert(sizeof(ChunkType) == sizeof(uint64_t),
+                "expected chunks to have APInt's word size");
+  result.reserve(numBits);
+  result.appendReserved(numBits, bits.getRawData());
   return result;
 }
 
@@ -2239,16 +2239,16 @@ swift::Demangle::demangleTypeAsNode(const char *MangledName,
 namespace {
 class NodePrinter {
 private:
-  std::string Str;
+  std::string &Str;
   DemanglerPrinter Printer;
   DemangleOptions Options;
-  
+
 public:
-  NodePrinter(DemangleOptions options) : Printer(Str), Options(options) {}
-  
-  std::string printRoot(NodePointer root) {
+  NodePrinter(DemangleOptions options, std::string &out)
+      : Str(out), Printer(Str), Options(options) {}
+
+  void printRoot(NodePointer root) {
     print(root);
-    return Str;
   }
 
 private:  
@@ -3617,23 +3617,39 @@ void NodePrinter::print(NodePointer pointer, bool asContext, bool suppressType)
 
 std::string Demangle::nodeToString(NodePointer root,
                                    const DemangleOptions &options) {
+  std::string demangling;
+  nodeToString(std::move(root), demangling, options);
+  return demangling;
+}
+
+void Demangle::nodeToString(NodePointer root, std::string &out,
+                            const DemangleOptions &options) {
   if (!root)
-    return "";
+    return;
 
-  return NodePrinter(options).printRoot(root);
+  NodePrinter(options, out).printRoot(root);
 }
 
 std::string Demangle::demangleSymbolAsString(const char *MangledName,
                                              size_t MangledNameLength,
                                              const DemangleOptions &Options) {
-  auto mangled = StringRef(MangledName, MangledNameLength);
+  std::string demangling;
+  demangleSymbolAsString(MangledName, MangledNameLength, demangling, Options);
+  return demangling;
+}
+
+void Demangle::demangleSymbolAsString(const char *MangledName,
+                                      size_t MangledNameLength,
+                                      std::string &Out,
+                                      const DemangleOptions &Options) {
+  size_t initialSize = Out.size();
   auto root = demangleSymbolAsNode(MangledName, MangledNameLength, Options);
-  if (!root) return mangled.str();
+  if (root)
+    nodeToString(std::move(root), Out, Options);
 
-  std::string demangling = nodeToString(std::move(root), Options);
-  if (demangling.empty())
-    return mangled.str();
-  return demangling;
+  // If the name didn't demangle to anything, emit it as-is.
+  if (Out.size() == initialSize)
+    Out.append(MangledName, MangledNameLength);
 }
 
 std::string Demangle::demangleTypeAsString(const char *MangledName,
@@ -19,30 +19,111 @@
 #include "swift/Basic/DiverseStack.h"
 using namespace swift;
 
+/// Return the header of the current top segment, which must be a heap
+/// segment.
+static DiverseStackBase::Chunk *getTopChunk(char *allocated) {
+  return reinterpret_cast<DiverseStackBase::Chunk *>(allocated) - 1;
+}
+
 void DiverseStackBase::pushNewStorageSlow(std::size_t needed) {
-  bool wasInline = isAllocatedInline();
+  checkValid();
 
-  std::size_t capacity = End - Allocated;
-  std::size_t requiredCapacity = capacity + needed;
-  do {
-    capacity = 2 * capacity + 16;
-  } while (capacity < requiredCapacity);
+  // Freeze the current top segment.  Growing never moves the objects
+  // already on the stack: the full segment is chained behind the new one
+  // and stays where it is.
+  std::size_t oldCapacity = End - Allocated;
+  if (Begin != End) {
+    Chunk *frozen;
+    if (isAllocatedInline()) {
+      // The inline buffer has no room for a header; describe it with a
+      // separately allocated one.
+      frozen = new Chunk();
+      frozen->HeapStorage = false;
+    } else {
+      frozen = getTopChunk(Allocated);
+      frozen->HeapStorage = true;
+    }
+    frozen->Begin = Begin;
+    frozen->End = End;
+    frozen->Older = Older;
+    Older = frozen;
+    OlderBytes += End - Begin;
+  } else if (!isAllocatedInline()) {
+    // The top segment is empty and cannot hold the new object; keep it
+    // as the spare.
+    if (Spare)
+      delete[] reinterpret_cast<char *>(Spare);
+    Spare = getTopChunk(Allocated);
+  }
 
-  assert(capacity % 16 == 0 && "not allocating multiple of alignment");
+  // Install the spare chunk if it is big enough, otherwise allocate a
+  // new segment of geometrically growing capacity.
+  Chunk *chunk;
+  if (Spare &&
+      std::size_t(Spare->End - Spare->getStorage()) >= needed) {
+    chunk = Spare;
+    Spare = nullptr;
+  } else {
+    std::size_t capacity = oldCapacity;
+    do {
+      capacity = 2 * capacity + 16;
+    } while (capacity < needed);
 
-  char *oldAllocation = Allocated;
-  char *oldBegin = Begin;
-  std::size_t oldSize = (std::size_t) (End - oldBegin);
+    assert(capacity % 16 == 0 && "not allocating multiple of alignment");
 
-  Allocated = new char[capacity];
-  End = Allocated + capacity;
-  Begin = End - oldSize;
-  std::memcpy(Begin, oldBegin, oldSize);
+    chunk = reinterpret_cast<Chunk *>(new char[sizeof(Chunk) + capacity]);
+    chunk->End = chunk->getStorage() + capacity;
+    chunk->HeapStorage = true;
+  }
 
-  Begin -= needed;
+  Allocated = chunk->getStorage();
+  End = chunk->End;
+  Begin = End - needed;
+}
 
-  if (!wasInline) delete[] oldAllocation;
-}  
+void DiverseStackBase::popSegmentSlow() {
+  assert(Begin == End && "top segment is not empty");
+  assert(Older && "popping a segment without an older one");
+  assert(!isAllocatedInline() &&
+         "the inline buffer cannot have older segments");
+
+  // Keep the emptied segment as the spare so that push/pop sequences at
+  // the boundary do not thrash the allocator.
+  if (Spare)
+    delete[] reinterpret_cast<char *>(Spare);
+  Spare = getTopChunk(Allocated);
+
+  // The next older segment becomes the top of the stack again.
+  Chunk *chunk = Older;
+  Older = chunk->Older;
+  OlderBytes -= std::size_t(chunk->End - chunk->Begin);
+  Begin = chunk->Begin;
+  End = chunk->End;
+  if (chunk->HeapStorage) {
+    Allocated = chunk->getStorage();
+  } else {
+    // The bottom segment is the inline buffer; its descriptor is no
+    // longer needed.
+    Allocated = reinterpret_cast<char *>(this + 1);
+    delete chunk;
+  }
+}
+
+void DiverseStackBase::destroyStorage() {
+  if (!isAllocatedInline())
+    delete[] reinterpret_cast<char *>(getTopChunk(Allocated));
+  Chunk *chunk = Older;
+  while (chunk) {
+    Chunk *older = chunk->Older;
+    if (chunk->HeapStorage)
+      delete[] reinterpret_cast<char *>(chunk);
+    else
+      delete chunk;
+    chunk = older;
+  }
+  if (Spare)
+    delete[] reinterpret_cast<char *>(Spare);
+}
 
 char *DiverseListBase::addNewStorageSlow(std::size_t needed) {
   bool wasInline = isAllocatedInline();
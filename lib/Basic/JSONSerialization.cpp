@@ -152,8 +152,9 @@ void Output::endBitSetScalar() {
   Stream << ']';
 }
 
-void Output::scalarString(StringRef &S, bool MustQuote) {
-  if (MustQuote) {
+/// Write \p S to \p Stream as a quoted JSON string, escaping characters
+/// as required by the JSON standard.
+static void writeQuotedString(llvm::raw_ostream &Stream, StringRef S) {
     Stream << '"';
     for (unsigned char c : S) {
       // According to the JSON standard, the following characters must be
@@ -218,7 +219,11 @@ void Output::scalarString(StringRef &S, bool MustQuote) {
       }
     }
     Stream << '"';
-  }
+}
+
+void Output::scalarString(StringRef &S, bool MustQuote) {
+  if (MustQuote)
+    writeQuotedString(Stream, S);
   else
     Stream << S;
 }
@@ -227,6 +232,114 @@ void Output::indent() {
   Stream.indent(StateStack.size() * 2);
 }
 
+//===----------------------------------------------------------------------===//
+//  Writer
+//===----------------------------------------------------------------------===//
+
+void Writer::beginObject() {
+  preflightValue();
+  StateStack.push_back(ObjectFirstKey);
+  Stream << '{';
+  if (PrettyPrint)
+    Stream << '\n';
+}
+
+void Writer::endObject() {
+  assert(!StateStack.empty() &&
+         (StateStack.back() == ObjectFirstKey ||
+          StateStack.back() == ObjectOtherKey) &&
+         "mismatched endObject");
+  StateStack.pop_back();
+  if (PrettyPrint) {
+    Stream << '\n';
+    indent();
+  }
+  Stream << '}';
+}
+
+void Writer::beginArray() {
+  preflightValue();
+  StateStack.push_back(ArrayFirstValue);
+  Stream << '[';
+  if (PrettyPrint)
+    Stream << '\n';
+}
+
+void Writer::endArray() {
+  assert(!StateStack.empty() &&
+         (StateStack.back() == ArrayFirstValue ||
+          StateStack.back() == ArrayOtherValue) &&
+         "mismatched endArray");
+  StateStack.pop_back();
+  if (PrettyPrint) {
+    Stream << '\n';
+    indent();
+  }
+  Stream << ']';
+}
+
+void Writer::attributeBegin(StringRef Key) {
+  assert(!StateStack.empty() &&
+         (StateStack.back() == ObjectFirstKey ||
+          StateStack.back() == ObjectOtherKey) &&
+         "attribute outside of an object");
+  if (StateStack.back() == ObjectOtherKey) {
+    Stream << ',';
+    if (PrettyPrint)
+      Stream << '\n';
+  } else {
+    StateStack.back() = ObjectOtherKey;
+  }
+  if (PrettyPrint)
+    indent();
+  Stream << '"' << Key << "\":";
+  if (PrettyPrint)
+    Stream << ' ';
+}
+
+void Writer::value(StringRef Val) {
+  preflightValue();
+  writeQuotedString(Stream, Val);
+}
+
+void Writer::value(bool Val) {
+  preflightValue();
+  Stream << (Val ? "true" : "false");
+}
+
+void Writer::value(int64_t Val) {
+  preflightValue();
+  Stream << Val;
+}
+
+void Writer::value(double Val) {
+  preflightValue();
+  Stream << llvm::format("%.16g", Val);
+}
+
+void Writer::preflightValue() {
+  if (StateStack.empty())
+    return;
+  State &Top = StateStack.back();
+  if (Top == ArrayFirstValue || Top == ArrayOtherValue) {
+    if (Top == ArrayOtherValue) {
+      Stream << ',';
+      if (PrettyPrint)
+        Stream << '\n';
+    } else {
+      Top = ArrayOtherValue;
+    }
+    if (PrettyPrint)
+      indent();
+  }
+  // In an object context the separator and key were already written by
+  // attributeBegin().
+}
+
+void Writer::indent() {
+  Stream.indent(StateStack.size() * 2);
+}
+
 //===----------------------------------------------------------------------===//
 //  traits for built-in types
 //===----------------------------------------------------------------------===//
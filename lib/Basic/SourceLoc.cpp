@@ -15,6 +15,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace swift;
 
@@ -185,6 +187,58 @@ StringRef SourceManager::extractText(CharSourceRange Range,
                        Range.getByteLength());
 }
 
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto &Offsets = LineStartOffsets[BufferID];
+  if (Offsets.empty()) {
+    StringRef Buffer = LLVMSourceMgr.getMemoryBuffer(BufferID)->getBuffer();
+    Offsets.push_back(0);
+    // memchr is the fastest portable way to find the newlines; the C library
+    // implementations scan a vector register's worth of bytes per step.
+    const char *Data = Buffer.data();
+    const char *End = Data + Buffer.size();
+    for (const char *Ptr = Data;
+         (Ptr = static_cast<const char *>(memchr(Ptr, '\n', End - Ptr)));)
+      Offsets.push_back(++Ptr - Data);
+  }
+  return Offsets;
+}
+
+std::pair<unsigned, unsigned> SourceManager::findLine(unsigned Offset,
+                                                      unsigned BufferID) const {
+  auto Offsets = getLineStartOffsets(BufferID);
+  auto I = std::upper_bound(Offsets.begin(), Offsets.end(), Offset) - 1;
+  return { I - Offsets.begin() + 1, *I };
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::getLineAndColumn(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  int LineOffset = getLineOffset(Loc);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  auto LineAndStart = findLine(Offset, BufferID);
+  assert(LineOffset + (int)LineAndStart.first > 0 && "bogus line offset");
+  return { LineOffset + LineAndStart.first, Offset - LineAndStart.second + 1 };
+}
+
+std::pair<std::pair<unsigned, unsigned>, std::pair<unsigned, unsigned>>
+SourceManager::getLineAndColumnRange(CharSourceRange Range,
+                                     unsigned BufferID) const {
+  assert(Range.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Range.getStart());
+  return { getLineAndColumn(Range.getStart(), BufferID),
+           getLineAndColumn(Range.getEnd(), BufferID) };
+}
+
+unsigned SourceManager::getLineNumber(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  return findLine(getLocOffsetInBuffer(Loc, BufferID), BufferID).first;
+}
+
 unsigned SourceManager::findBufferContainingLoc(SourceLoc Loc) const {
   assert(Loc.isValid());
   // Search the buffers back-to front, so later alias buffers are
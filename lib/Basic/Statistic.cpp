@@ -0,0 +1,57 @@
+//===--- Statistic.cpp - Frontend performance counters --------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/Statistic.h"
+#include "swift/Basic/JSONSerialization.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+
+static CompilationCounters TheCounters;
+
+CompilationCounters &swift::getCompilationCounters() {
+  return TheCounters;
+}
+
+namespace {
+/// The shape of the emitted JSON object: the counter values plus enough
+/// identity for analytics to attribute them to an input file.
+struct CounterReport {
+  std::string MainInput;
+  CompilationCounters Counters;
+};
+} // end anonymous namespace
+
+namespace swift {
+namespace json {
+  template<>
+  struct ObjectTraits<CounterReport> {
+    static void mapping(Output &out, CounterReport &report) {
+      out.mapRequired("main_input", report.MainInput);
+      out.mapRequired("lexed_bytes", report.Counters.NumLexedBytes);
+      out.mapRequired("solver_scopes", report.Counters.NumSolverScopes);
+      out.mapRequired("sil_insts_created", report.Counters.NumSILInstsCreated);
+      out.mapRequired("sil_insts_deleted", report.Counters.NumSILInstsDeleted);
+      out.mapRequired("decls_deserialized",
+                      report.Counters.NumDeclsDeserialized);
+    }
+  };
+} // namespace json
+} // namespace swift
+
+void swift::writeCompilationCounters(llvm::raw_ostream &os,
+                                     StringRef mainInput) {
+  CounterReport report{mainInput.str(), TheCounters};
+  json::Output yout(os);
+  yout << report;
+  os << "\n";
+}
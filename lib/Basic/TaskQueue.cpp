@@ -19,6 +19,11 @@
 
 #include "swift/Basic/TaskQueue.h"
 
+#include "llvm/ADT/SmallVector.h"
+
+#include <mutex>
+#include <thread>
+
 using namespace swift;
 using namespace swift::sys;
 
@@ -34,6 +39,108 @@ TaskQueue::TaskQueue(unsigned NumberOfParallelTasks)
 
 TaskQueue::~TaskQueue() = default;
 
+// ThreadedTaskQueue implementation
+
+ThreadedTaskQueue::ThreadedTaskQueue(InProcessExecutionFn ExecuteInProcess,
+                                     unsigned NumberOfParallelTasks)
+  : TaskQueue(NumberOfParallelTasks),
+    ExecuteInProcess(std::move(ExecuteInProcess)) {}
+
+ThreadedTaskQueue::~ThreadedTaskQueue() = default;
+
+void ThreadedTaskQueue::addTask(const char *ExecPath,
+                                ArrayRef<const char *> Args,
+                                ArrayRef<const char *> Env, void *Context) {
+  assert(Env.empty() && "ThreadedTaskQueue does not support custom "
+                        "environments for in-process tasks");
+  QueuedTasks.emplace(
+    std::unique_ptr<ThreadedTask>(new ThreadedTask(ExecPath, Args, Context)));
+}
+
+bool ThreadedTaskQueue::execute(TaskQueue::TaskBeganCallback Began,
+                                TaskQueue::TaskFinishedCallback Finished,
+                                TaskQueue::TaskSignalledCallback Signalled) {
+  // Guards QueuedTasks, NextPid, and SubtaskFailed, and serializes the
+  // callbacks so that clients observe the same single-threaded callback
+  // behavior as the subprocess-based TaskQueue.
+  std::mutex QueueLock;
+  bool SubtaskFailed = false;
+  ProcessId NextPid = 0;
+
+  unsigned NumWorkers = getNumberOfParallelTasks();
+  if (NumWorkers == 0)
+    NumWorkers = std::thread::hardware_concurrency();
+  if (NumWorkers == 0)
+    NumWorkers = 1;
+  if (NumWorkers > QueuedTasks.size())
+    NumWorkers = QueuedTasks.size();
+
+  auto workerMain = [&] {
+    while (true) {
+      std::unique_ptr<ThreadedTask> T;
+      ProcessId Pid;
+
+      {
+        std::unique_lock<std::mutex> Lock(QueueLock);
+        if (SubtaskFailed || QueuedTasks.empty())
+          return;
+        T = std::move(QueuedTasks.front());
+        QueuedTasks.pop();
+        Pid = ++NextPid;
+
+        if (Began)
+          Began(Pid, T->Context);
+      }
+
+      // Try to execute the task in-process; fall back to spawning a
+      // subprocess if the executor declines it.
+      llvm::Optional<int> ReturnCode = ExecuteInProcess(T->ExecPath, T->Args);
+
+      std::string ErrorMsg;
+      if (!ReturnCode.hasValue()) {
+        SmallVector<const char *, 128> Argv;
+        Argv.push_back(T->ExecPath);
+        Argv.append(T->Args.begin(), T->Args.end());
+        Argv.push_back(nullptr);
+
+        bool ExecutionFailed = false;
+        ReturnCode = llvm::sys::ExecuteAndWait(T->ExecPath, Argv.data(),
+                                               /*env=*/nullptr,
+                                               /*redirects=*/nullptr,
+                                               /*secondsToWait=*/0,
+                                               /*memoryLimit=*/0, &ErrorMsg,
+                                               &ExecutionFailed);
+        if (ExecutionFailed)
+          ReturnCode = -1;
+      }
+
+      {
+        std::unique_lock<std::mutex> Lock(QueueLock);
+        TaskFinishedResponse Response = TaskFinishedResponse::ContinueExecution;
+        if (ReturnCode.getValue() < 0) {
+          // A negative return code indicates that the task exited abnormally
+          // (or could not be executed at all).
+          if (Signalled)
+            Response = Signalled(Pid, ErrorMsg, StringRef(), T->Context);
+        } else if (Finished) {
+          Response = Finished(Pid, ReturnCode.getValue(), StringRef(),
+                              T->Context);
+        }
+        if (Response == TaskFinishedResponse::StopExecution)
+          SubtaskFailed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> Workers;
+  for (unsigned i = 0; i < NumWorkers; ++i)
+    Workers.push_back(std::thread(workerMain));
+  for (auto &Worker : Workers)
+    Worker.join();
+
+  return SubtaskFailed;
+}
+
 // DummyTaskQueue implementation
 
 DummyTaskQueue::DummyTaskQueue(unsigned NumberOfParallelTasks)
@@ -0,0 +1,105 @@
+//===--- TraceEvents.cpp - Chrome-trace event recording -------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/TraceEvents.h"
+#include "swift/Basic/QuotedString.h"
+#include "llvm/Support/raw_ostream.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace swift;
+
+namespace {
+struct TraceEvent {
+  std::string Name;
+  std::string Detail;
+  uint64_t BeginUSec;
+  uint64_t DurationUSec;
+  unsigned ThreadID;
+};
+
+struct TraceState {
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::chrono::steady_clock::time_point StartTime;
+};
+} // end anonymous namespace
+
+static bool TracingEnabled = false;
+static TraceState *State = nullptr;
+
+/// Small per-thread ids are friendlier in the trace viewer than system
+/// thread ids, and the backend threads are created fresh per invocation
+/// anyway.
+static unsigned getTraceThreadID() {
+  static std::atomic<unsigned> NextThreadID{0};
+  static thread_local unsigned ThisThreadID = NextThreadID++;
+  return ThisThreadID;
+}
+
+void swift::enableTraceEvents() {
+  assert(!TracingEnabled && "tracing already enabled");
+  State = new TraceState();
+  State->StartTime = std::chrono::steady_clock::now();
+  TracingEnabled = true;
+}
+
+bool swift::traceEventsEnabled() {
+  return TracingEnabled;
+}
+
+uint64_t swift::traceEventTimeUSec() {
+  auto elapsed = std::chrono::steady_clock::now() - State->StartTime;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+      .count();
+}
+
+void swift::recordTraceEvent(StringRef name, StringRef detail,
+                             uint64_t beginUSec, uint64_t endUSec) {
+  assert(TracingEnabled && "tracing not enabled");
+  TraceEvent event{name.str(), detail.str(), beginUSec, endUSec - beginUSec,
+                   getTraceThreadID()};
+  std::lock_guard<std::mutex> lock(State->Mutex);
+  State->Events.push_back(std::move(event));
+}
+
+void swift::writeTraceEvents(llvm::raw_ostream &os) {
+  assert(TracingEnabled && "tracing not enabled");
+  std::lock_guard<std::mutex> lock(State->Mutex);
+
+  uint64_t pid = getpid();
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto &event : State->Events) {
+    if (!first)
+      os << ",";
+    first = false;
+    os << "\n{\"name\":" << QuotedString(event.Name)
+       << ",\"cat\":\"swift\",\"ph\":\"X\""
+       << ",\"ts\":" << event.BeginUSec << ",\"dur\":" << event.DurationUSec
+       << ",\"pid\":" << pid << ",\"tid\":" << event.ThreadID;
+    if (!event.Detail.empty())
+      os << ",\"args\":{\"detail\":" << QuotedString(event.Detail) << "}";
+    os << "}";
+  }
+  os << "\n]}\n";
+}
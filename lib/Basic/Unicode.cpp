@@ -11,7 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/Unicode.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
+#include <cstring>
 
 using namespace swift;
 
@@ -94,20 +97,135 @@ unsigned swift::unicode::extractFirstUnicodeScalar(StringRef S) {
   return Scalar;
 }
 
-uint64_t swift::unicode::getUTF16Length(StringRef Str) {
-  uint64_t Length;
-  // Transcode the string to UTF-16 to get its length.
-  SmallVector<UTF16, 128> buffer(Str.size() + 1); // +1 for ending nulls.
-  const UTF8 *fromPtr = (const UTF8 *) Str.data();
-  UTF16 *toPtr = &buffer[0];
-  ConversionResult Result = ConvertUTF8toUTF16(&fromPtr, fromPtr + Str.size(),
-                                               &toPtr, toPtr + Str.size(),
-                                               strictConversion);
-  assert(Result == conversionOK &&
-         "UTF-8 encoded string cannot be converted into UTF-16 encoding");
-  (void)Result;
+/// Returns the number of leading bytes of [Ptr, End) that are ASCII,
+/// examining a machine word at a time.
+static size_t getASCIIPrefixLength(const UTF8 *Ptr, const UTF8 *End) {
+  const uint64_t HighBits = UINT64_C(0x8080808080808080);
+  const UTF8 *Cur = Ptr;
+  uint64_t Word;
+  while (size_t(End - Cur) >= sizeof(Word)) {
+    std::memcpy(&Word, Cur, sizeof(Word));
+    if (Word & HighBits)
+      break;
+    Cur += sizeof(Word);
+  }
+  while (Cur != End && *Cur < 0x80)
+    ++Cur;
+  return Cur - Ptr;
+}
 
-  // The length of the transcoded string in UTF-16 code points.
-  Length = toPtr - &buffer[0];
+uint64_t swift::unicode::getUTF16Length(StringRef Str) {
+  uint64_t Length = 0;
+  const UTF8 *Ptr = reinterpret_cast<const UTF8 *>(Str.begin());
+  const UTF8 *End = reinterpret_cast<const UTF8 *>(Str.end());
+  while (Ptr != End) {
+    // Each ASCII byte transcodes to one UTF-16 code unit.
+    size_t ASCIILength = getASCIIPrefixLength(Ptr, End);
+    Length += ASCIILength;
+    Ptr += ASCIILength;
+    if (Ptr == End)
+      break;
+
+    unsigned NumBytes = getNumBytesForUTF8(*Ptr);
+    assert(NumBytes >= 2 && NumBytes <= size_t(End - Ptr) &&
+           isLegalUTF8Sequence(Ptr, Ptr + NumBytes) &&
+           "UTF-8 encoded string cannot be converted into UTF-16 encoding");
+    // Scalars outside the basic multilingual plane -- four bytes in UTF-8 --
+    // need a surrogate pair; everything else is a single code unit.
+    Length += (NumBytes == 4) ? 2 : 1;
+    Ptr += NumBytes;
+  }
   return Length;
 }
+
+bool swift::unicode::isWellFormedUTF8(StringRef S) {
+  const UTF8 *Ptr = reinterpret_cast<const UTF8 *>(S.begin());
+  const UTF8 *End = reinterpret_cast<const UTF8 *>(S.end());
+  while (Ptr != End) {
+    Ptr += getASCIIPrefixLength(Ptr, End);
+    if (Ptr == End)
+      break;
+
+    unsigned NumBytes = getNumBytesForUTF8(*Ptr);
+    if (NumBytes < 2 || NumBytes > size_t(End - Ptr) ||
+        !isLegalUTF8Sequence(Ptr, Ptr + NumBytes))
+      return false;
+    Ptr += NumBytes;
+  }
+  return true;
+}
+
+bool swift::unicode::convertUTF8ToUTF16(StringRef Source,
+                                        SmallVectorImpl<uint16_t> &Result) {
+  Result.reserve(Result.size() + Source.size());
+  const UTF8 *Ptr = reinterpret_cast<const UTF8 *>(Source.begin());
+  const UTF8 *End = reinterpret_cast<const UTF8 *>(Source.end());
+  while (Ptr != End) {
+    // Widen the ASCII prefix directly.
+    const UTF8 *ASCIIEnd = Ptr + getASCIIPrefixLength(Ptr, End);
+    while (Ptr != ASCIIEnd)
+      Result.push_back(*Ptr++);
+    if (Ptr == End)
+      break;
+
+    // Hand the non-ASCII run -- it ends at the next ASCII byte, since every
+    // lead and continuation byte has the high bit set -- to the generic
+    // converter.  A non-ASCII scalar never needs more code units than it has
+    // UTF-8 bytes, so the run's size bounds the output.
+    const UTF8 *RunEnd = Ptr;
+    while (RunEnd != End && *RunEnd >= 0x80)
+      ++RunEnd;
+    size_t OldSize = Result.size();
+    Result.resize(OldSize + (RunEnd - Ptr));
+    UTF16 *ToPtr = Result.begin() + OldSize;
+    ConversionResult CR =
+        ConvertUTF8toUTF16(&Ptr, RunEnd, &ToPtr, Result.end(),
+                           strictConversion);
+    if (CR != conversionOK)
+      return false;
+    Result.set_size(ToPtr - Result.begin());
+  }
+  return true;
+}
+
+bool swift::unicode::convertUTF16ToUTF8(ArrayRef<uint16_t> Source,
+                                        SmallVectorImpl<char> &Result) {
+  Result.reserve(Result.size() + Source.size());
+  const UTF16 *Ptr = Source.begin();
+  const UTF16 *End = Source.end();
+  while (Ptr != End) {
+    // Narrow the ASCII prefix directly, examining four code units at a time.
+    const uint64_t NonASCIIBits = UINT64_C(0xFF80FF80FF80FF80);
+    uint64_t Word;
+    while (size_t(End - Ptr) >= sizeof(Word) / sizeof(UTF16)) {
+      std::memcpy(&Word, Ptr, sizeof(Word));
+      if (Word & NonASCIIBits)
+        break;
+      for (unsigned i = 0; i != sizeof(Word) / sizeof(UTF16); ++i)
+        Result.push_back(char(*Ptr++));
+    }
+    while (Ptr != End && *Ptr < 0x80)
+      Result.push_back(char(*Ptr++));
+    if (Ptr == End)
+      break;
+
+    // Hand the non-ASCII run to the generic converter.  A non-ASCII code
+    // unit transcodes to at most three UTF-8 bytes (a surrogate pair makes
+    // four bytes out of two units), so three bytes per unit bounds the
+    // output.
+    const UTF16 *RunEnd = Ptr;
+    while (RunEnd != End && *RunEnd >= 0x80)
+      ++RunEnd;
+    size_t OldSize = Result.size();
+    Result.resize(OldSize + 3 * (RunEnd - Ptr));
+    UTF8 *ToPtr = reinterpret_cast<UTF8 *>(Result.begin() + OldSize);
+    ConversionResult CR =
+        ConvertUTF16toUTF8(&Ptr, RunEnd, &ToPtr,
+                           reinterpret_cast<UTF8 *>(Result.end()),
+                           strictConversion);
+    if (CR != conversionOK)
+      return false;
+    Result.set_size(reinterpret_cast<char *>(ToPtr) - Result.begin());
+  }
+  return true;
+}
@@ -33,6 +33,7 @@
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/DeclVisitor.h"
+#include "clang/AST/ExternalASTSource.h"
 #include "clang/Basic/CharInfo.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/Lookup.h"
@@ -4133,77 +4134,8 @@ namespace {
         if (!nd || nd != nd->getCanonicalDecl())
           continue;
 
-        auto member = Impl.importDecl(nd);
-        if (!member) {
-          if (auto method = dyn_cast<clang::ObjCMethodDecl>(nd)) {
-            if (method->getImplementationControl() ==
-                clang::ObjCMethodDecl::Required)
-              hasMissingRequiredMember = true;
-          } else if (auto prop = dyn_cast<clang::ObjCPropertyDecl>(nd)) {
-            if (prop->getPropertyImplementation() ==
-                clang::ObjCPropertyDecl::Required)
-              hasMissingRequiredMember = true;
-          }
-          continue;
-        }
-
-        if (auto objcMethod = dyn_cast<clang::ObjCMethodDecl>(nd)) {
-          // If there is a special declaration associated with this member,
-          // add it now.
-          if (auto special = importSpecialMethod(member, swiftContext)) {
-            if (knownMembers.insert(special).second)
-              members.push_back(special);
-          }
-
-          // If this is a factory method, try to import it as a constructor.
-          if (auto factory = importFactoryMethodAsConstructor(
-                               member,
-                               objcMethod, 
-                               Impl.importSelector(objcMethod->getSelector()),
-                               swiftContext)) {
-            if (*factory)
-              members.push_back(*factory);
-          }
-
-          // Objective-C root class instance methods are reflected on the
-          // metatype as well.
-          if (objcMethod->isInstanceMethod()) {
-            Type swiftTy = swiftContext->getDeclaredTypeInContext();
-            auto swiftClass = swiftTy->getClassOrBoundGenericClass();
-            if (swiftClass && !swiftClass->getSuperclass() &&
-                !decl->getClassMethod(objcMethod->getSelector(),
-                                      /*AllowHidden=*/true)) {
-              auto classMember = VisitObjCMethodDecl(objcMethod, swiftContext,
-                                                     true);
-              if (classMember)
-                members.push_back(classMember);
-            }
-          }
-
-          // Import explicit properties as instance properties, not as separate
-          // getter and setter methods.
-          if (!Impl.isAccessibilityDecl(objcMethod)) {
-            // If this member is a method that is a getter or setter for a
-            // propertythat was imported, don't add it to the list of members
-            // so it won't be found by name lookup. This eliminates the
-            // ambiguity between property names and getter names (by choosing
-            // to only have a variable).
-            if (objcMethod->isPropertyAccessor()) {
-              auto prop = objcMethod->findPropertyDecl(/*checkOverrides=*/false);
-              assert(prop);
-              (void)Impl.importDecl(const_cast<clang::ObjCPropertyDecl *>(prop));
-              // We may have attached this member to an existing property even
-              // if we've failed to import a new property.
-              if (cast<FuncDecl>(member)->isAccessor())
-                continue;
-            } else if (auto *proto = dyn_cast<clang::ObjCProtocolDecl>(decl)) {
-              if (isPotentiallyConflictingSetter(proto, objcMethod))
-                continue;
-            }
-          }
-        }
-
-        members.push_back(member);
+        importObjCMember(nd, decl, swiftContext, members, knownMembers,
+                         hasMissingRequiredMember);
       }
 
       // Hack to deal with unannotated Objective-C protocols. If the protocol
@@ -4222,6 +4154,87 @@ namespace {
 
     }
 
+    /// Import a single member of an Objective-C container, adding the
+    /// resulting Swift declaration(s) to \p members.
+    void importObjCMember(clang::NamedDecl *nd,
+                          const clang::ObjCContainerDecl *decl,
+                          DeclContext *swiftContext,
+                          SmallVectorImpl<Decl *> &members,
+                          llvm::SmallPtrSetImpl<Decl *> &knownMembers,
+                          bool &hasMissingRequiredMember) {
+      auto member = Impl.importDecl(nd);
+      if (!member) {
+        if (auto method = dyn_cast<clang::ObjCMethodDecl>(nd)) {
+          if (method->getImplementationControl() ==
+              clang::ObjCMethodDecl::Required)
+            hasMissingRequiredMember = true;
+        } else if (auto prop = dyn_cast<clang::ObjCPropertyDecl>(nd)) {
+          if (prop->getPropertyImplementation() ==
+              clang::ObjCPropertyDecl::Required)
+            hasMissingRequiredMember = true;
+        }
+        return;
+      }
+
+      if (auto objcMethod = dyn_cast<clang::ObjCMethodDecl>(nd)) {
+        // If there is a special declaration associated with this member,
+        // add it now.
+        if (auto special = importSpecialMethod(member, swiftContext)) {
+          if (knownMembers.insert(special).second)
+            members.push_back(special);
+        }
+
+        // If this is a factory method, try to import it as a constructor.
+        if (auto factory = importFactoryMethodAsConstructor(
+                             member,
+                             objcMethod,
+                             Impl.importSelector(objcMethod->getSelector()),
+                             swiftContext)) {
+          if (*factory)
+            members.push_back(*factory);
+        }
+
+        // Objective-C root class instance methods are reflected on the
+        // metatype as well.
+        if (objcMethod->isInstanceMethod()) {
+          Type swiftTy = swiftContext->getDeclaredTypeInContext();
+          auto swiftClass = swiftTy->getClassOrBoundGenericClass();
+          if (swiftClass && !swiftClass->getSuperclass() &&
+              !decl->getClassMethod(objcMethod->getSelector(),
+                                    /*AllowHidden=*/true)) {
+            auto classMember = VisitObjCMethodDecl(objcMethod, swiftContext,
+                                                   true);
+            if (classMember)
+              members.push_back(classMember);
+          }
+        }
+
+        // Import explicit properties as instance properties, not as separate
+        // getter and setter methods.
+        if (!Impl.isAccessibilityDecl(objcMethod)) {
+          // If this member is a method that is a getter or setter for a
+          // propertythat was imported, don't add it to the list of members
+          // so it won't be found by name lookup. This eliminates the
+          // ambiguity between property names and getter names (by choosing
+          // to only have a variable).
+          if (objcMethod->isPropertyAccessor()) {
+            auto prop = objcMethod->findPropertyDecl(/*checkOverrides=*/false);
+            assert(prop);
+            (void)Impl.importDecl(const_cast<clang::ObjCPropertyDecl *>(prop));
+            // We may have attached this member to an existing property even
+            // if we've failed to import a new property.
+            if (cast<FuncDecl>(member)->isAccessor())
+              return;
+          } else if (auto *proto = dyn_cast<clang::ObjCProtocolDecl>(decl)) {
+            if (isPotentiallyConflictingSetter(proto, objcMethod))
+              return;
+          }
+        }
+      }
+
+      members.push_back(member);
+    }
+
     static bool
     classImplementsProtocol(const clang::ObjCInterfaceDecl *constInterface,
                             const clang::ObjCProtocolDecl *constProto,
@@ -5940,6 +5953,103 @@ ClangImporter::Implementation::loadAllMembers(Decl *D, uint64_t unused,
 
 }
 
+Optional<TinyPtrVector<ValueDecl *>>
+ClangImporter::Implementation::loadNamedMembers(const Decl *D, DeclName name,
+                                                uint64_t unused) {
+  // Per-name member loading needs the Swift name lookup tables.
+  if (!UseSwiftLookupTables)
+    return None;
+
+  assert(D->hasClangNode());
+  auto clangDecl = cast<clang::ObjCContainerDecl>(D->getClangDecl());
+
+  // Inherited constructors are found by walking the superclass's entire
+  // member list, so lookups for 'init' have to load everything. The same
+  // goes for subscripts, whose getters and setters can be declared in
+  // different containers.
+  if (name.getBaseName() == SwiftContext.Id_init ||
+      name.getBaseName() == SwiftContext.Id_subscript)
+    return None;
+
+  // Figure out which class's lookup table entries cover this container, and
+  // reject containers whose member lists have cross-member structure that a
+  // per-name import would miss.
+  const clang::ObjCInterfaceDecl *searchClass;
+  if (auto clangClass = dyn_cast<clang::ObjCInterfaceDecl>(clangDecl)) {
+    clangClass = clangClass->getDefinition();
+    if (!clangClass)
+      return None;
+
+    // Mirrored members of the protocols this class conforms to are
+    // discovered by walking the entire container.
+    if (clangClass->protocol_begin() != clangClass->protocol_end())
+      return None;
+
+    clangDecl = searchClass = clangClass;
+  } else if (auto category = dyn_cast<clang::ObjCCategoryDecl>(clangDecl)) {
+    if (category->protocol_begin() != category->protocol_end())
+      return None;
+
+    searchClass = category->getClassInterface();
+    if (!searchClass)
+      return None;
+  } else {
+    // Protocols compute hasMissingRequiredMembers over their entire member
+    // list; load them eagerly.
+    return None;
+  }
+
+  // Find the lookup table for the Clang module that owns this container.
+  auto &clangCtx = getClangASTContext();
+  const clang::Module *owningModule = nullptr;
+  if (auto *extSource = clangCtx.getExternalSource())
+    owningModule = extSource->getModule(clangDecl->getOwningModuleID());
+  auto *table = findLookupTable(owningModule);
+  if (!table)
+    return None;
+
+  clang::PrettyStackTraceDecl trace(clangDecl, clang::SourceLocation(),
+                                    Instance->getSourceManager(),
+                                    "loading named members for");
+
+  SwiftDeclConverter converter(*this);
+  ImportingEntityRAII Importing(*this);
+
+  auto *container = const_cast<Decl *>(D);
+  DeclContext *DC;
+  if (auto nominal = dyn_cast<NominalTypeDecl>(container))
+    DC = nominal;
+  else
+    DC = cast<ExtensionDecl>(container);
+
+  // The table is keyed by the *class's* context even for members declared in
+  // categories, so filter the results down to the members that lexically
+  // belong to this container. Note that, unlike loadAllMembers, the results
+  // are returned to the caller rather than added to the container; the full
+  // member-list load remains responsible for that.
+  llvm::SmallPtrSet<Decl *, 4> knownMembers;
+  SmallVector<Decl *, 4> members;
+  bool unusedHasMissingRequiredMember = false;
+  for (auto entry : table->lookup(
+           name.getBaseName().str(),
+           const_cast<clang::ObjCInterfaceDecl *>(searchClass))) {
+    auto nd = entry.dyn_cast<clang::NamedDecl *>();
+    if (!nd || nd != nd->getCanonicalDecl())
+      continue;
+    if (nd->getLexicalDeclContext() != clangDecl)
+      continue;
+
+    converter.importObjCMember(nd, clangDecl, DC, members, knownMembers,
+                               unusedHasMissingRequiredMember);
+  }
+
+  TinyPtrVector<ValueDecl *> results;
+  for (auto member : members)
+    if (auto vd = dyn_cast<ValueDecl>(member))
+      results.push_back(vd);
+  return results;
+}
+
 void ClangImporter::Implementation::loadAllConformances(
        const Decl *D, uint64_t contextData,
        SmallVectorImpl<ProtocolConformance *> &Conformances) {
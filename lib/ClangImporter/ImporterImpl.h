@@ -1270,6 +1270,9 @@ public:
   loadAllMembers(Decl *D, uint64_t unused,
                  bool *hasMissingRequiredMembers) override;
 
+  virtual Optional<TinyPtrVector<ValueDecl *>>
+  loadNamedMembers(const Decl *D, DeclName name, uint64_t unused) override;
+
   void
   loadAllConformances(
     const Decl *D, uint64_t contextData,
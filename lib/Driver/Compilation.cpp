@@ -27,14 +27,20 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/YAMLParser.h"
 
+#include <deque>
+
 using namespace swift;
 using namespace swift::sys;
 using namespace swift::driver;
@@ -48,7 +54,8 @@ Compilation::Compilation(const Driver &D, const ToolChain &DefaultToolChain,
                          unsigned NumberOfParallelCommands,
                          bool EnableIncrementalBuild,
                          bool SkipTaskExecution,
-                         bool SaveTemps)
+                         bool SaveTemps,
+                         bool EnableInProcessJobs)
   : TheDriver(D), DefaultToolChain(DefaultToolChain), Diags(Diags),
     Level(Level), InputArgs(std::move(InputArgs)),
     TranslatedArgs(std::move(TranslatedArgs)), ArgsHash(ArgsHash),
@@ -56,7 +63,8 @@ Compilation::Compilation(const Driver &D, const ToolChain &DefaultToolChain,
     NumberOfParallelCommands(NumberOfParallelCommands),
     SkipTaskExecution(SkipTaskExecution),
     EnableIncrementalBuild(EnableIncrementalBuild),
-    SaveTemps(SaveTemps) {
+    SaveTemps(SaveTemps),
+    EnableInProcessJobs(EnableInProcessJobs) {
 };
 
 using CommandSet = llvm::SmallPtrSet<const Job *, 16>;
@@ -215,16 +223,224 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
   }
 }
 
+/// Returns the path of the per-input compile time history, which is kept
+/// next to the compilation record.
+static std::string getCompileTimesPath(StringRef compilationRecordPath) {
+  return (compilationRecordPath + ".times").str();
+}
+
+/// Loads per-input compile times (in milliseconds) recorded by a previous
+/// build. Entries that can't be parsed are silently dropped; the times are
+/// only a scheduling hint.
+static void loadCompileTimes(StringRef path,
+                             llvm::StringMap<uint64_t> &times) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return;
+
+  namespace yaml = llvm::yaml;
+  llvm::SourceMgr SM;
+  yaml::Stream stream(buffer.get()->getMemBufferRef(), SM);
+
+  auto I = stream.begin();
+  if (I == stream.end() || !I->getRoot())
+    return;
+  auto *map = dyn_cast<yaml::MappingNode>(I->getRoot());
+  if (!map)
+    return;
+
+  SmallString<64> keyScratch, valueScratch;
+  // FIXME: LLVM's YAML support does incremental parsing in such a way that
+  // for-range loops break.
+  for (auto i = map->begin(), e = map->end(); i != e; ++i) {
+    auto *key = dyn_cast_or_null<yaml::ScalarNode>(i->getKey());
+    auto *value = dyn_cast_or_null<yaml::ScalarNode>(i->getValue());
+    if (!key || !value)
+      continue;
+    uint64_t milliseconds;
+    if (value->getValue(valueScratch).getAsInteger(10, milliseconds))
+      continue;
+    times[key->getValue(keyScratch)] = milliseconds;
+  }
+}
+
+static void writeCompileTimes(StringRef path,
+                              const llvm::StringMap<uint64_t> &times) {
+  std::error_code error;
+  llvm::raw_fd_ostream out(path, error, llvm::sys::fs::F_None);
+  if (out.has_error()) {
+    // Losing the timing history only costs us scheduling quality.
+    out.clear_error();
+    return;
+  }
+
+  // Sort the entries so the file is stable from one build to the next.
+  SmallVector<const llvm::StringMapEntry<uint64_t> *, 32> entries;
+  for (const auto &entry : times)
+    entries.push_back(&entry);
+  llvm::array_pod_sort(entries.begin(), entries.end(),
+                       [](const llvm::StringMapEntry<uint64_t> *const *lhs,
+                          const llvm::StringMapEntry<uint64_t> *const *rhs)
+                           -> int {
+    return (*lhs)->getKey().compare((*rhs)->getKey());
+  });
+
+  for (const auto *entry : entries)
+    out << "\"" << llvm::yaml::escape(entry->getKey()) << "\": "
+        << entry->getValue() << "\n";
+}
+
+/// Computes the content-addressed cache key for \p Cmd, or returns an empty
+/// string if the job is not cacheable.
+///
+/// The key covers the compiler version, the executable, every argument, and
+/// the contents of every Swift input the command line names.  The non-primary
+/// files of the module appear on a frontend command line too, so a change to
+/// any file of the module changes the keys of all its compile jobs.
+static std::string computeCacheKey(const Job *Cmd) {
+  // Only frontend compile jobs have outputs that are a pure function of
+  // their command line and inputs.
+  if (!isa<CompileJobAction>(Cmd->getSource()))
+    return std::string();
+
+  llvm::MD5 hash;
+  hash.update(version::getSwiftFullVersion());
+  hash.update(StringRef(Cmd->getExecutable()));
+  hash.update(StringRef("\0", 1));
+  for (const char *Arg : Cmd->getArguments()) {
+    StringRef ArgRef(Arg);
+    hash.update(ArgRef);
+    hash.update(StringRef("\0", 1));
+    if (ArgRef.endswith(".swift")) {
+      auto buffer = llvm::MemoryBuffer::getFile(ArgRef);
+      if (!buffer) {
+        // An unreadable input; let the job run and diagnose it.
+        return std::string();
+      }
+      hash.update((*buffer)->getBuffer());
+      hash.update(StringRef("\0", 1));
+    }
+  }
+
+  llvm::MD5::MD5Result hashBuf;
+  hash.final(hashBuf);
+  llvm::SmallString<32> digest;
+  llvm::MD5::stringifyResult(hashBuf, digest);
+  return digest.str().str();
+}
+
+/// Collects the output files of \p Cmd, paired with the file names they use
+/// inside a cache entry.
+static void getCacheableOutputs(
+    const Job *Cmd,
+    SmallVectorImpl<std::pair<std::string, std::string>> &outputs) {
+  const CommandOutput &Output = Cmd->getOutput();
+  unsigned i = 0;
+  for (const std::string &primary : Output.getPrimaryOutputFilenames()) {
+    outputs.push_back({("primary." + llvm::Twine(i)).str(), primary});
+    ++i;
+  }
+  for (const auto &additional : Output.getAdditionalOutputsMap()) {
+    outputs.push_back(
+        {("additional." + types::getTypeName(additional.first)).str(),
+         additional.second});
+  }
+}
+
+/// Tries to restore the outputs of \p Cmd from the cache entry for \p key.
+/// An entry must supply every output, or the job runs as usual.
+static bool fetchFromCompilationCache(StringRef cachePath, StringRef key,
+                                      const Job *Cmd) {
+  llvm::SmallString<128> entryPath(cachePath);
+  llvm::sys::path::append(entryPath, key);
+  if (!llvm::sys::fs::is_directory(entryPath))
+    return false;
+
+  SmallVector<std::pair<std::string, std::string>, 4> outputs;
+  getCacheableOutputs(Cmd, outputs);
+  for (const auto &output : outputs) {
+    llvm::SmallString<128> cachedFile(entryPath);
+    llvm::sys::path::append(cachedFile, output.first);
+    if (llvm::sys::fs::copy_file(cachedFile, output.second))
+      return false;
+  }
+  return true;
+}
+
+/// Adds the outputs of the successfully finished \p Cmd to the cache under
+/// \p key.  Failures only cost future cache hits, so they are ignored.
+static void storeInCompilationCache(StringRef cachePath, StringRef key,
+                                    const Job *Cmd) {
+  if (llvm::sys::fs::create_directories(cachePath))
+    return;
+
+  // Fill a temporary directory first so a concurrent build can never observe
+  // a partial entry, then rename it into place.
+  llvm::SmallString<128> tempPath(cachePath);
+  llvm::sys::path::append(tempPath, (llvm::Twine(key) + ".tmp.%%%%%%").str());
+  llvm::SmallString<128> entryTempPath;
+  if (llvm::sys::fs::createUniqueDirectory(tempPath, entryTempPath))
+    return;
+
+  SmallVector<std::pair<std::string, std::string>, 4> outputs;
+  getCacheableOutputs(Cmd, outputs);
+  for (const auto &output : outputs) {
+    llvm::SmallString<128> cachedFile(entryTempPath);
+    llvm::sys::path::append(cachedFile, output.first);
+    if (llvm::sys::fs::copy_file(output.second, cachedFile)) {
+      (void)llvm::sys::fs::remove_directories(entryTempPath);
+      return;
+    }
+  }
+
+  llvm::SmallString<128> entryPath(cachePath);
+  llvm::sys::path::append(entryPath, key);
+  if (llvm::sys::fs::rename(entryTempPath, entryPath)) {
+    // Another build populated this entry first.
+    (void)llvm::sys::fs::remove_directories(entryTempPath);
+  }
+}
+
 int Compilation::performJobsImpl() {
   // Create a TaskQueue for execution.
   std::unique_ptr<TaskQueue> TQ;
   if (SkipTaskExecution)
     TQ.reset(new DummyTaskQueue(NumberOfParallelCommands));
+  else if (EnableInProcessJobs && InProcessExecutor &&
+           TaskQueue::supportsParallelExecution())
+    TQ.reset(new ThreadedTaskQueue(InProcessExecutor,
+                                   NumberOfParallelCommands));
   else
     TQ.reset(new TaskQueue(NumberOfParallelCommands));
 
   PerformJobsState State;
 
+  // Command lines rewritten to go through the remote execution tool.  The
+  // TaskQueue keeps ArrayRefs into these until the corresponding task runs.
+  std::deque<std::vector<const char *>> RemoteCommandLines;
+
+  // Jobs whose outputs were restored from the compilation cache, awaiting the
+  // bookkeeping a successful run would have done.
+  SmallVector<const Job *, 16> PendingCacheHits;
+
+  // Cache keys for scheduled jobs that missed the compilation cache, so their
+  // outputs can be added to it when they finish.
+  llvm::SmallDenseMap<const Job *, std::string, 16> CacheKeys;
+
+  // Per-input compile times from the previous build, in milliseconds, used
+  // to schedule the longest compiles first. Without this a long compile that
+  // happens to sort last in input order serializes the tail of the build.
+  llvm::StringMap<uint64_t> PreviousCompileTimes;
+  if (!CompilationRecordPath.empty() && !SkipTaskExecution)
+    loadCompileTimes(getCompileTimesPath(CompilationRecordPath),
+                     PreviousCompileTimes);
+
+  /// The compile times measured during this build.
+  llvm::StringMap<uint64_t> MeasuredCompileTimes;
+
+  /// The time at which each running command began execution.
+  llvm::SmallDenseMap<const Job *, llvm::sys::TimeValue, 16> CommandStartTimes;
+
   using DependencyGraph = DependencyGraph<const Job *>;
   DependencyGraph DepGraph;
   SmallPtrSet<const Job *, 16> DeferredCommands;
@@ -265,14 +481,70 @@ int Compilation::performJobsImpl() {
     assert(Cmd->getExtraEnvironment().empty() &&
            "not implemented for compilations with multiple jobs");
     State.ScheduledCommands.insert(Cmd);
-    TQ->addTask(Cmd->getExecutable(), Cmd->getArguments(), llvm::None,
-                (void *)Cmd);
+
+    if (!CompilationCachePath.empty()) {
+      std::string CacheKey = computeCacheKey(Cmd);
+      if (!CacheKey.empty()) {
+        if (fetchFromCompilationCache(CompilationCachePath, CacheKey, Cmd)) {
+          if (Level == OutputLevel::Parseable)
+            parseable_output::emitSkippedMessage(llvm::errs(), *Cmd);
+          PendingCacheHits.push_back(Cmd);
+          return;
+        }
+        CacheKeys.insert({Cmd, CacheKey});
+      }
+    }
+
+    const char *Executable = Cmd->getExecutable();
+    ArrayRef<const char *> Arguments = Cmd->getArguments();
+    if (!RemoteExecutionTool.empty() &&
+        isa<CompileJobAction>(Cmd->getSource())) {
+      // Hand the entire frontend command line to the remote execution tool;
+      // it owns shipping the inputs, running the command on a worker, and
+      // streaming the outputs back.
+      RemoteCommandLines.emplace_back();
+      auto &WrappedArguments = RemoteCommandLines.back();
+      WrappedArguments.push_back(Executable);
+      WrappedArguments.insert(WrappedArguments.end(),
+                              Arguments.begin(), Arguments.end());
+      Executable = RemoteExecutionTool.c_str();
+      Arguments = WrappedArguments;
+    }
+    TQ->addTask(Executable, Arguments, llvm::None, (void *)Cmd);
+  };
+
+  // A job's temporary outputs can only be read by the jobs that list it as
+  // an input, so once all of its consumers have finished the files are dead.
+  // Count the consumers up front and reclaim each producer's temporaries as
+  // soon as the count drops to zero, instead of letting every intermediate
+  // of a large build accumulate until the compilation ends.
+  llvm::SmallDenseMap<const Job *, unsigned, 16> RemainingConsumers;
+  if (!SaveTemps && !TempFilePaths.empty())
+    for (const auto &J : Jobs)
+      for (const Job *Input : J->getInputs())
+        ++RemainingConsumers[Input];
+
+  auto reclaimTemporaryOutputs = [&] (const Job *Cmd) {
+    const CommandOutput &Output = Cmd->getOutput();
+    for (const std::string &path : Output.getPrimaryOutputFilenames())
+      if (isTemporaryFile(path))
+        (void)llvm::sys::fs::remove(path);
+    for (const auto &additional : Output.getAdditionalOutputsMap())
+      if (isTemporaryFile(additional.second))
+        (void)llvm::sys::fs::remove(additional.second);
   };
 
   // When a task finishes, we need to reevaluate the other commands that
   // might have been blocked.
   auto markFinished = [&] (const Job *Cmd) {
-    State.FinishedCommands.insert(Cmd);
+    if (!State.FinishedCommands.insert(Cmd).second)
+      return;
+
+    for (const Job *Input : Cmd->getInputs()) {
+      auto remaining = RemainingConsumers.find(Input);
+      if (remaining != RemainingConsumers.end() && --remaining->second == 0)
+        reclaimTemporaryOutputs(Input);
+    }
 
     auto BlockedIter = State.BlockingCommands.find(Cmd);
     if (BlockedIter != State.BlockingCommands.end()) {
@@ -283,8 +555,93 @@ int Compilation::performJobsImpl() {
     }
   };
 
+  // Performs the bookkeeping for a compile whose outputs are now valid,
+  // whether it just ran successfully or was restored from the compilation
+  // cache: marks it finished and, for incremental builds, reloads its
+  // dependency information and schedules any newly discovered dependents.
+  auto jobFinishedSuccessfully = [&] (const Job *FinishedCmd) {
+    // When a task finishes, we need to reevaluate the other commands that
+    // might have been blocked.
+    markFinished(FinishedCmd);
+
+    // In order to handle both old dependencies that have disappeared and new
+    // dependencies that have arisen, we need to reload the dependency file.
+    if (getIncrementalBuildEnabled()) {
+      const CommandOutput &Output = FinishedCmd->getOutput();
+      StringRef DependenciesFile =
+        Output.getAdditionalOutputForType(types::TY_SwiftDeps);
+      if (!DependenciesFile.empty()) {
+        SmallVector<const Job *, 16> Dependents;
+        bool wasCascading = DepGraph.isMarked(FinishedCmd);
+
+        auto loaded = DepGraph.loadFromPath(FinishedCmd, DependenciesFile);
+        switch (loaded) {
+        case DependencyGraphImpl::LoadResult::HadError:
+          disableIncrementalBuild();
+          for (const Job *Cmd : DeferredCommands)
+            scheduleCommandIfNecessaryAndPossible(Cmd);
+          DeferredCommands.clear();
+          Dependents.clear();
+          break;
+        case DependencyGraphImpl::LoadResult::UpToDate:
+          if (!wasCascading)
+            break;
+          SWIFT_FALLTHROUGH;
+        case DependencyGraphImpl::LoadResult::AffectsDownstream:
+          // If this load discovered new information, we only need to rebuild
+          // the files that depend on the declarations which actually changed,
+          // not on everything this file has ever provided.
+          DepGraph.markTransitive(
+              Dependents, FinishedCmd, /*tracer=*/nullptr,
+              loaded == DependencyGraphImpl::LoadResult::AffectsDownstream);
+          break;
+        }
+
+        for (const Job *Cmd : Dependents) {
+          DeferredCommands.erase(Cmd);
+          noteBuilding(Cmd, "because of dependencies discovered later");
+          scheduleCommandIfNecessaryAndPossible(Cmd);
+        }
+      }
+    }
+  };
+
+  // Retires jobs whose outputs were restored from the compilation cache.
+  // This is deferred until scheduling decisions are being made in response
+  // to finished jobs, so the initial scheduling pass observes the same
+  // dependency-graph state whether or not the cache is enabled.
+  auto processPendingCacheHits = [&] {
+    while (!PendingCacheHits.empty()) {
+      const Job *HitCmd = PendingCacheHits.pop_back_val();
+      jobFinishedSuccessfully(HitCmd);
+    }
+  };
+
+  // Decide what order to offer the jobs to the task queue in. The queue
+  // hands queued tasks to whichever worker frees up first, so feeding it the
+  // historically longest compiles first evens out the end of the build. Jobs
+  // we have no history for are offered first, since they might be long; with
+  // no history at all this leaves the order unchanged.
+  SmallVector<const Job *, 32> JobsInScheduleOrder(getJobs().begin(),
+                                                   getJobs().end());
+  if (!PreviousCompileTimes.empty()) {
+    auto estimatedTime = [&](const Job *Cmd) -> uint64_t {
+      if (!isa<CompileJobAction>(Cmd->getSource()))
+        return 0;
+      auto entry =
+          PreviousCompileTimes.find(Cmd->getOutput().getBaseInput(0));
+      if (entry == PreviousCompileTimes.end())
+        return UINT64_MAX;
+      return entry->second;
+    };
+    std::stable_sort(JobsInScheduleOrder.begin(), JobsInScheduleOrder.end(),
+                     [&](const Job *lhs, const Job *rhs) {
+      return estimatedTime(lhs) > estimatedTime(rhs);
+    });
+  }
+
   // Schedule all jobs we can.
-  for (const Job *Cmd : getJobs()) {
+  for (const Job *Cmd : JobsInScheduleOrder) {
     if (!getIncrementalBuildEnabled()) {
       scheduleCommandIfNecessaryAndPossible(Cmd);
       continue;
@@ -355,7 +712,7 @@ int Compilation::performJobsImpl() {
     // Check all cross-module dependencies as well.
     for (StringRef dependency : DepGraph.getExternalDependencies()) {
       llvm::sys::fs::file_status depStatus;
-      if (!llvm::sys::fs::status(dependency, depStatus))
+      if (!TheDriver.getStatCache().status(dependency, depStatus))
         if (depStatus.getLastModificationTime() < LastBuildTime)
           continue;
 
@@ -383,10 +740,12 @@ int Compilation::performJobsImpl() {
   // Set up a callback which will be called immediately after a task has
   // started. This callback may be used to provide output indicating that the
   // task began.
-  auto taskBegan = [this] (ProcessId Pid, void *Context) {
+  auto taskBegan = [&] (ProcessId Pid, void *Context) {
     // TODO: properly handle task began.
     const Job *BeganCmd = (const Job *)Context;
 
+    CommandStartTimes[BeganCmd] = llvm::sys::TimeValue::now();
+
     // For verbose output, print out each command as it begins execution.
     if (Level == OutputLevel::Verbose)
       BeganCmd->printCommandLine(llvm::errs());
@@ -403,6 +762,18 @@ int Compilation::performJobsImpl() {
                            void *Context) -> TaskFinishedResponse {
     const Job *FinishedCmd = (const Job *)Context;
 
+    // Record how long the compile took so the next build can schedule the
+    // longest ones first.
+    auto startTime = CommandStartTimes.find(FinishedCmd);
+    if (startTime != CommandStartTimes.end()) {
+      if (isa<CompileJobAction>(FinishedCmd->getSource())) {
+        auto elapsed = llvm::sys::TimeValue::now() - startTime->second;
+        MeasuredCompileTimes[FinishedCmd->getOutput().getBaseInput(0)] =
+            elapsed.msec();
+      }
+      CommandStartTimes.erase(startTime);
+    }
+
     if (Level == OutputLevel::Parseable) {
       // Parseable output was requested.
       parseable_output::emitFinishedMessage(llvm::errs(), *FinishedCmd, Pid,
@@ -435,44 +806,20 @@ int Compilation::performJobsImpl() {
           TaskFinishedResponse::StopExecution;
     }
 
-    // When a task finishes, we need to reevaluate the other commands that
-    // might have been blocked.
-    markFinished(FinishedCmd);
-
-    // In order to handle both old dependencies that have disappeared and new
-    // dependencies that have arisen, we need to reload the dependency file.
-    if (getIncrementalBuildEnabled()) {
-      const CommandOutput &Output = FinishedCmd->getOutput();
-      StringRef DependenciesFile =
-        Output.getAdditionalOutputForType(types::TY_SwiftDeps);
-      if (!DependenciesFile.empty()) {
-        SmallVector<const Job *, 16> Dependents;
-        bool wasCascading = DepGraph.isMarked(FinishedCmd);
+    // Add this task's outputs to the compilation cache before anything can
+    // modify them.
+    if (!CompilationCachePath.empty()) {
+      auto CacheKey = CacheKeys.find(FinishedCmd);
+      if (CacheKey != CacheKeys.end())
+        storeInCompilationCache(CompilationCachePath, CacheKey->second,
+                                FinishedCmd);
+    }
 
-        switch (DepGraph.loadFromPath(FinishedCmd, DependenciesFile)) {
-        case DependencyGraphImpl::LoadResult::HadError:
-          disableIncrementalBuild();
-          for (const Job *Cmd : DeferredCommands)
-            scheduleCommandIfNecessaryAndPossible(Cmd);
-          DeferredCommands.clear();
-          Dependents.clear();
-          break;
-        case DependencyGraphImpl::LoadResult::UpToDate:
-          if (!wasCascading)
-            break;
-          SWIFT_FALLTHROUGH;
-        case DependencyGraphImpl::LoadResult::AffectsDownstream:
-          DepGraph.markTransitive(Dependents, FinishedCmd);
-          break;
-        }
+    jobFinishedSuccessfully(FinishedCmd);
 
-        for (const Job *Cmd : Dependents) {
-          DeferredCommands.erase(Cmd);
-          noteBuilding(Cmd, "because of dependencies discovered later");
-          scheduleCommandIfNecessaryAndPossible(Cmd);
-        }
-      }
-    }
+    // Retire any jobs the compilation cache satisfied while dependents were
+    // being scheduled.
+    processPendingCacheHits();
 
     return TaskFinishedResponse::ContinueExecution;
   };
@@ -505,7 +852,14 @@ int Compilation::performJobsImpl() {
     return TaskFinishedResponse::StopExecution;
   };
 
+  // The jobs about to run will change the files the driver has been asking
+  // about, so stop trusting the stat cache from here on.
+  TheDriver.getStatCache().clear();
+
   do {
+    // Retire any jobs the compilation cache satisfied during scheduling.
+    processPendingCacheHits();
+
     // Ask the TaskQueue to execute.
     TQ->execute(taskBegan, taskFinished, taskSignalled);
 
@@ -520,6 +874,7 @@ int Compilation::performJobsImpl() {
       State.ScheduledCommands.insert(Cmd);
       markFinished(Cmd);
     }
+    processPendingCacheHits();
 
     // ...which may allow us to go on and do later tasks.
   } while (Result == 0 && TQ->hasRemainingTasks());
@@ -555,6 +910,14 @@ int Compilation::performJobsImpl() {
     checkForOutOfDateInputs(Diags, InputInfo);
     writeCompilationRecord(CompilationRecordPath, ArgsHash, BuildStartTime,
                            InputInfo);
+
+    // Merge this build's compile times over the previous history, so inputs
+    // that didn't need rebuilding keep their recorded times.
+    for (const auto &measured : MeasuredCompileTimes)
+      PreviousCompileTimes[measured.getKey()] = measured.getValue();
+    if (!PreviousCompileTimes.empty())
+      writeCompileTimes(getCompileTimesPath(CompilationRecordPath),
+                        PreviousCompileTimes);
   }
 
   if (Result == 0)
@@ -579,11 +942,13 @@ int Compilation::performSingleCommand(const Job *Cmd) {
     Cmd->printCommandLine(llvm::errs());
 
   SmallVector<const char *, 128> Argv;
+  if (!RemoteExecutionTool.empty() && isa<CompileJobAction>(Cmd->getSource()))
+    Argv.push_back(RemoteExecutionTool.c_str());
   Argv.push_back(Cmd->getExecutable());
   Argv.append(Cmd->getArguments().begin(), Cmd->getArguments().end());
   Argv.push_back(0);
 
-  const char *ExecPath = Cmd->getExecutable();
+  const char *ExecPath = Argv[0];
   const char **argv = Argv.data();
 
   for (auto &envPair : Cmd->getExtraEnvironment())
@@ -597,6 +962,7 @@ int Compilation::performJobs() {
   if (Level < OutputLevel::Parseable &&
       (SaveTemps || TempFilePaths.empty()) &&
       CompilationRecordPath.empty() &&
+      CompilationCachePath.empty() &&
       Jobs.size() == 1) {
     return performSingleCommand(Jobs.front().get());
   }
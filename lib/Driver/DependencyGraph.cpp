@@ -223,6 +223,13 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
                                                llvm::MemoryBuffer &buffer) {
   auto &provides = Provides[node];
 
+  // Track which provided names are new (or newly provided in an additional
+  // kind) in this load, so that later marking can be restricted to the
+  // declarations that actually changed.
+  auto &changedProvides = ChangedProvides[node];
+  changedProvides.clear();
+  bool interfaceHashChanged = false;
+
   auto dependsCallback = [this, node](StringRef name, DependencyKind kind,
                                       bool isCascading) -> LoadResult {
     if (kind == DependencyKind::ExternalFile)
@@ -250,24 +257,40 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
     return LoadResult::UpToDate;
   };
 
+  auto noteChangedProvide = [&changedProvides](StringRef name,
+                                               DependencyKind kind) {
+    auto iter = std::find_if(changedProvides.begin(), changedProvides.end(),
+                             [name](const ProvidesEntryTy &entry) -> bool {
+      return name == entry.name;
+    });
+    if (iter == changedProvides.end())
+      changedProvides.push_back({name, kind});
+    else
+      iter->kindMask |= kind;
+  };
+
   auto providesCallback =
-      [this, node, &provides](StringRef name, DependencyKind kind,
-                              bool isCascading) -> LoadResult {
+      [&provides, &noteChangedProvide](StringRef name, DependencyKind kind,
+                                       bool isCascading) -> LoadResult {
     assert(isCascading);
     auto iter = std::find_if(provides.begin(), provides.end(),
                              [name](const ProvidesEntryTy &entry) -> bool {
       return name == entry.name;
     });
 
-    if (iter == provides.end())
+    if (iter == provides.end()) {
       provides.push_back({name, kind});
-    else
+      noteChangedProvide(provides.back().name, kind);
+    } else if (!iter->kindMask.contains(kind)) {
       iter->kindMask |= kind;
+      noteChangedProvide(iter->name, kind);
+    }
 
     return LoadResult::UpToDate;
   };
 
-  auto interfaceHashCallback = [this, node](StringRef hash) -> LoadResult {
+  auto interfaceHashCallback =
+      [this, node, &interfaceHashChanged](StringRef hash) -> LoadResult {
     auto insertResult = InterfaceHashes.insert(std::make_pair(node, hash));
 
     if (insertResult.second) {
@@ -279,14 +302,23 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
     auto iter = insertResult.first;
     if (hash != iter->second) {
       iter->second = hash;
+      interfaceHashChanged = true;
       return LoadResult::AffectsDownstream;
     }
 
     return LoadResult::UpToDate;
   };
 
-  return parseDependencyFile(buffer, providesCallback, dependsCallback,
-                             interfaceHashCallback);
+  auto result = parseDependencyFile(buffer, providesCallback, dependsCallback,
+                                    interfaceHashCallback);
+
+  // A changed interface hash cannot be attributed to particular provided
+  // names (e.g. a signature edit leaves the provides set unchanged), so be
+  // conservative and treat everything the node provides as changed.
+  if (interfaceHashChanged)
+    changedProvides = provides;
+
+  return result;
 }
 
 void DependencyGraphImpl::markExternal(SmallVectorImpl<const void *> &visited,
@@ -308,7 +340,8 @@ void DependencyGraphImpl::markExternal(SmallVectorImpl<const void *> &visited,
 
 void
 DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
-                                    const void *node, MarkTracerImpl *tracer) {
+                                    const void *node, MarkTracerImpl *tracer,
+                                    bool onlyChangedProvides) {
   assert(Provides.count(node) && "node is not in the graph");
   llvm::SpecificBumpPtrAllocator<MarkTracerImpl::Entry> scratchAlloc;
 
@@ -321,13 +354,10 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
   SmallVector<WorklistEntry, 16> worklist;
   SmallPtrSet<const void *, 16> visitedSet;
 
-  auto addDependentsToWorklist = [&](const void *next,
-                                     ArrayRef<MarkTracerImpl::Entry> reason) {
-    auto allProvided = Provides.find(next);
-    if (allProvided == Provides.end())
-      return;
-
-    for (const auto &provided : allProvided->second) {
+  auto addProvidesToWorklist = [&](const void *next,
+                                   ArrayRef<MarkTracerImpl::Entry> reason,
+                                   const std::vector<ProvidesEntryTy> &allProvided) {
+    for (const auto &provided : allProvided) {
       auto allDependents = Dependencies.find(provided.name);
       if (allDependents == Dependencies.end())
         continue;
@@ -361,6 +391,14 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
     }
   };
 
+  auto addDependentsToWorklist = [&](const void *next,
+                                     ArrayRef<MarkTracerImpl::Entry> reason) {
+    auto allProvided = Provides.find(next);
+    if (allProvided == Provides.end())
+      return;
+    addProvidesToWorklist(next, reason, allProvided->second);
+  };
+
   auto record = [&](WorklistEntry next) {
     if (!visitedSet.insert(next.Node).second)
       return;
@@ -374,7 +412,17 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
 
   // Always mark through the starting node, even if it's already marked.
   markIntransitive(node);
-  addDependentsToWorklist(node, {});
+  if (onlyChangedProvides) {
+    // Declaration-granularity mode: only traverse the names whose provides
+    // actually changed in the node's most recent load.
+    auto changed = ChangedProvides.find(node);
+    if (changed != ChangedProvides.end())
+      addProvidesToWorklist(node, {}, changed->second);
+    else
+      addDependentsToWorklist(node, {});
+  } else {
+    addDependentsToWorklist(node, {});
+  }
 
   while (!worklist.empty()) {
     auto next = worklist.pop_back_val();
@@ -352,6 +352,16 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
   bool DriverPrintJobs = ArgList->hasArg(options::OPT_driver_print_jobs);
   bool DriverSkipExecution =
     ArgList->hasArg(options::OPT_driver_skip_execution);
+  bool DriverUseInProcessJobs =
+    ArgList->hasArg(options::OPT_driver_use_in_process_jobs);
+  StringRef DriverRemoteExecTool;
+  if (const Arg *A =
+          ArgList->getLastArg(options::OPT_driver_remote_exec_tool))
+    DriverRemoteExecTool = A->getValue();
+  StringRef DriverCompilationCachePath;
+  if (const Arg *A =
+          ArgList->getLastArg(options::OPT_driver_compilation_cache_path))
+    DriverCompilationCachePath = A->getValue();
   bool ShowIncrementalBuildDecisions =
     ArgList->hasArg(options::OPT_driver_show_incremental);
 
@@ -493,7 +503,8 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
                                                  NumberOfParallelCommands,
                                                  Incremental,
                                                  DriverSkipExecution,
-                                                 SaveTemps));
+                                                 SaveTemps,
+                                                 DriverUseInProcessJobs));
 
   buildJobs(Actions, OI, OFM.get(), *C);
 
@@ -507,6 +518,12 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
   if (ShowIncrementalBuildDecisions)
     C->setShowsIncrementalBuildDecisions();
 
+  if (!DriverRemoteExecTool.empty())
+    C->setRemoteExecutionTool(DriverRemoteExecTool);
+
+  if (!DriverCompilationCachePath.empty())
+    C->setCompilationCachePath(DriverCompilationCachePath);
+
   // This has to happen after building jobs, because otherwise we won't even
   // emit .swiftdeps files for the next build.
   if (rebuildEverything)
@@ -701,7 +718,7 @@ static bool checkInputExistence(const Driver &D, const DerivedArgList &Args,
   if (Input == "-")
     return true;
 
-  if (llvm::sys::fs::exists(Input))
+  if (D.getStatCache().exists(Input))
     return true;
 
   Diags.diagnose(SourceLoc(), diag::error_no_such_file_or_directory, Input);
@@ -1577,7 +1594,8 @@ static void addAuxiliaryOutput(Compilation &C, CommandOutput &output,
 /// mtime has not changed), adjust the Job's condition accordingly.
 static void
 handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
-                          StringRef input, bool alwaysRebuildDependents) {
+                          StringRef input, bool alwaysRebuildDependents,
+                          FileStatCache &statCache) {
   if (inputInfo.status == CompileJobAction::InputInfo::NewlyAdded) {
     J->setCondition(Job::Condition::NewlyAdded);
     return;
@@ -1589,7 +1607,7 @@ handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
   }
 
   llvm::sys::fs::file_status inputStatus;
-  if (llvm::sys::fs::status(input, inputStatus))
+  if (statCache.status(input, inputStatus))
     return;
 
   J->setInputModTime(inputStatus.getLastModificationTime());
@@ -1599,7 +1617,7 @@ handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
   Job::Condition condition;
   switch (inputInfo.status) {
   case CompileJobAction::InputInfo::UpToDate:
-    if (!llvm::sys::fs::exists(J->getOutput().getPrimaryOutputFilename()))
+    if (!statCache.exists(J->getOutput().getPrimaryOutputFilename()))
       condition = Job::Condition::RunWithoutCascading;
     else
       condition = Job::Condition::CheckDependencies;
@@ -1879,7 +1897,7 @@ Job *Driver::buildJobsForAction(Compilation &C, const Action *A,
       bool alwaysRebuildDependents =
           C.getArgs().hasArg(options::OPT_driver_always_rebuild_dependents);
       handleCompileJobCondition(J, compileJob->getInputInfo(), BaseInput,
-                                alwaysRebuildDependents);
+                                alwaysRebuildDependents, getStatCache());
     }
   }
 
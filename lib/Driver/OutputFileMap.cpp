@@ -13,18 +13,191 @@
 #include "swift/Driver/OutputFileMap.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <system_error>
 
 using namespace swift;
 using namespace swift::driver;
 
+/// The first bytes of a compiled output file map.
+static const char CompiledMapMagic[] = {'S', 'O', 'F', 'M'};
+
+/// The version of the compiled output file map format. Bump this whenever the
+/// layout of the records changes; stale caches are simply recompiled.
+static const uint32_t CompiledMapVersion = 1;
+
 std::unique_ptr<OutputFileMap> OutputFileMap::loadFromPath(StringRef Path) {
+  // If a compiled form of the map exists next to the YAML source and still
+  // matches the source's size and modification time, use it and skip the
+  // YAML parse entirely.
+  llvm::SmallString<128> CachePath(Path);
+  CachePath += ".bin";
+
+  llvm::sys::fs::file_status Status;
+  bool HaveStatus = !llvm::sys::fs::status(Path, Status);
+  uint64_t SourceSize = 0, SourceMTime = 0;
+  if (HaveStatus) {
+    SourceSize = Status.getSize();
+    SourceMTime = Status.getLastModificationTime().toEpochTime();
+    if (auto OFM = loadFromCompiledCache(CachePath, SourceSize, SourceMTime))
+      return OFM;
+  }
+
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileBufOrErr =
     llvm::MemoryBuffer::getFile(Path);
   if (!FileBufOrErr)
     return nullptr;
-  return loadFromBuffer(std::move(FileBufOrErr.get()));
+  auto OFM = loadFromBuffer(std::move(FileBufOrErr.get()));
+
+  // Compile the parsed map for the next driver invocation. This is purely an
+  // optimization; if it fails the YAML is parsed again next time.
+  if (OFM && HaveStatus)
+    OFM->writeCompiledCache(CachePath, SourceSize, SourceMTime);
+
+  return OFM;
+}
+
+std::unique_ptr<OutputFileMap>
+OutputFileMap::loadFromCompiledCache(StringRef CachePath, uint64_t SourceSize,
+                                     uint64_t SourceMTime) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> BufOrErr =
+    llvm::MemoryBuffer::getFile(CachePath);
+  if (!BufOrErr)
+    return nullptr;
+  std::unique_ptr<llvm::MemoryBuffer> Buffer = std::move(BufOrErr.get());
+
+  const char *Ptr = Buffer->getBufferStart();
+  const char *End = Buffer->getBufferEnd();
+
+  auto readBytes = [&](size_t N) -> const char * {
+    if (size_t(End - Ptr) < N)
+      return nullptr;
+    const char *Result = Ptr;
+    Ptr += N;
+    return Result;
+  };
+  auto read32 = [&](uint32_t &Value) -> bool {
+    const char *P = readBytes(4);
+    if (!P)
+      return false;
+    Value = llvm::support::endian::read32le(P);
+    return true;
+  };
+  auto read64 = [&](uint64_t &Value) -> bool {
+    const char *P = readBytes(8);
+    if (!P)
+      return false;
+    Value = llvm::support::endian::read64le(P);
+    return true;
+  };
+  auto readString = [&](StringRef &Value) -> bool {
+    uint32_t Length;
+    if (!read32(Length))
+      return false;
+    const char *P = readBytes(Length);
+    if (!P)
+      return false;
+    Value = StringRef(P, Length);
+    return true;
+  };
+
+  // Reject the cache unless the header says it was compiled from exactly the
+  // YAML source we are about to read.
+  const char *Magic = readBytes(sizeof(CompiledMapMagic));
+  if (!Magic || memcmp(Magic, CompiledMapMagic, sizeof(CompiledMapMagic)) != 0)
+    return nullptr;
+  uint32_t Version;
+  if (!read32(Version) || Version != CompiledMapVersion)
+    return nullptr;
+  uint64_t Size, MTime;
+  if (!read64(Size) || Size != SourceSize)
+    return nullptr;
+  if (!read64(MTime) || MTime != SourceMTime)
+    return nullptr;
+
+  uint32_t NumInputs;
+  if (!read32(NumInputs))
+    return nullptr;
+
+  std::unique_ptr<OutputFileMap> OFM(new OutputFileMap());
+  for (uint32_t I = 0; I != NumInputs; ++I) {
+    StringRef InputPath;
+    uint32_t NumOutputs;
+    if (!readString(InputPath) || !read32(NumOutputs))
+      return nullptr;
+
+    TypeToPathMap OutputMap;
+    for (uint32_t J = 0; J != NumOutputs; ++J) {
+      StringRef KindName, Path;
+      if (!readString(KindName) || !readString(Path))
+        return nullptr;
+
+      // Kinds are stored by name so that a cache written by a newer swiftc is
+      // still usable; unknown kinds are ignored, just as in the YAML parser.
+      types::ID Kind = types::lookupTypeForName(KindName);
+      if (Kind == types::TY_INVALID)
+        continue;
+
+      OutputMap.insert(std::pair<types::ID, std::string>(Kind, Path));
+    }
+
+    OFM->InputToOutputsMap[InputPath] = std::move(OutputMap);
+  }
+
+  // Trailing garbage means the file is not one of ours.
+  if (Ptr != End)
+    return nullptr;
+
+  return OFM;
+}
+
+void OutputFileMap::writeCompiledCache(StringRef CachePath,
+                                       uint64_t SourceSize,
+                                       uint64_t SourceMTime) const {
+  // Write to a unique sibling and rename it into place, so that a concurrent
+  // driver invocation never reads a partially written cache.
+  int FD;
+  llvm::SmallString<128> TempPath;
+  if (llvm::sys::fs::createUniqueFile(CachePath + "-%%%%%%", FD, TempPath))
+    return;
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::support::endian::Writer<llvm::support::little> LE(OS);
+
+    auto writeString = [&](StringRef Value) {
+      LE.write(uint32_t(Value.size()));
+      OS << Value;
+    };
+
+    OS.write(CompiledMapMagic, sizeof(CompiledMapMagic));
+    LE.write(CompiledMapVersion);
+    LE.write(SourceSize);
+    LE.write(SourceMTime);
+
+    LE.write(uint32_t(InputToOutputsMap.size()));
+    for (auto &InputPair : InputToOutputsMap) {
+      writeString(InputPair.first());
+      const TypeToPathMap &Map = InputPair.second;
+      LE.write(uint32_t(Map.size()));
+      for (auto &OutputPair : Map) {
+        writeString(types::getTypeName(OutputPair.first));
+        writeString(OutputPair.second);
+      }
+    }
+
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return;
+    }
+  }
+
+  if (llvm::sys::fs::rename(TempPath, CachePath))
+    llvm::sys::fs::remove(TempPath);
 }
 
 std::unique_ptr<OutputFileMap> OutputFileMap::loadFromBuffer(StringRef Data) {
@@ -123,7 +123,12 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
 
   Opts.PrintStats |= Args.hasArg(OPT_print_stats);
   Opts.PrintClangStats |= Args.hasArg(OPT_print_clang_stats);
+  if (const Arg *A = Args.getLastArg(OPT_stats_output_path))
+    Opts.StatsOutputPath = A->getValue();
+  if (const Arg *A = Args.getLastArg(OPT_trace_events_path))
+    Opts.TraceEventsPath = A->getValue();
   Opts.DebugTimeFunctionBodies |= Args.hasArg(OPT_debug_time_function_bodies);
+  Opts.SkipFunctionBodies |= Args.hasArg(OPT_skip_function_bodies);
   Opts.DebugTimeCompilation |= Args.hasArg(OPT_debug_time_compilation);
 
   Opts.PlaygroundTransform |= Args.hasArg(OPT_playground);
@@ -177,6 +182,8 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
       Action = FrontendOptions::EmitSIB;
     } else if (Opt.matches(OPT_emit_sibgen)) {
       Action = FrontendOptions::EmitSIBGen;
+    } else if (Opt.matches(OPT_emit_pch)) {
+      Action = FrontendOptions::EmitPCH;
     } else if (Opt.matches(OPT_parse)) {
       Action = FrontendOptions::Parse;
     } else if (Opt.matches(OPT_dump_parse)) {
@@ -372,6 +379,10 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
       break;
     }
 
+    case FrontendOptions::EmitPCH:
+      Suffix = PCH_EXTENSION;
+      break;
+
     case FrontendOptions::EmitSIBGen:
     case FrontendOptions::EmitSIB:
       Suffix = SIB_EXTENSION;
@@ -520,6 +531,10 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
     Opts.FixitsOutputPath = A->getValue();
   }
 
+  if (const Arg *A = Args.getLastArg(OPT_emit_index_data_path)) {
+    Opts.IndexDataFilePath = A->getValue();
+  }
+
   bool IsSIB =
     Opts.RequestedAction == FrontendOptions::EmitSIB ||
     Opts.RequestedAction == FrontendOptions::EmitSIBGen;
@@ -548,6 +563,7 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
     case FrontendOptions::DumpAST:
     case FrontendOptions::PrintAST:
     case FrontendOptions::DumpTypeRefinementContexts:
+    case FrontendOptions::EmitPCH:
     case FrontendOptions::Immediate:
     case FrontendOptions::REPL:
       Diags.diagnose(SourceLoc(), diag::error_mode_cannot_emit_dependencies);
@@ -574,6 +590,7 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
     case FrontendOptions::DumpAST:
     case FrontendOptions::PrintAST:
     case FrontendOptions::DumpTypeRefinementContexts:
+    case FrontendOptions::EmitPCH:
     case FrontendOptions::Immediate:
     case FrontendOptions::REPL:
       Diags.diagnose(SourceLoc(), diag::error_mode_cannot_emit_header);
@@ -602,6 +619,7 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
     case FrontendOptions::DumpAST:
     case FrontendOptions::PrintAST:
     case FrontendOptions::DumpTypeRefinementContexts:
+    case FrontendOptions::EmitPCH:
     case FrontendOptions::EmitSILGen:
     case FrontendOptions::Immediate:
     case FrontendOptions::REPL:
@@ -634,8 +652,12 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
 
   if (const Arg *A = Args.getLastArg(OPT_import_objc_header)) {
     Opts.ImplicitObjCHeaderPath = A->getValue();
+    // A precompiled header can't be copied into the serialized module; jobs
+    // loading the module need access to the original PCH anyway.
+    bool isPCH = llvm::sys::path::extension(Opts.ImplicitObjCHeaderPath)
+                   .endswith(PCH_EXTENSION);
     Opts.SerializeBridgingHeader |=
-      !Opts.PrimaryInput && !Opts.ModuleOutputPath.empty();
+      !isPCH && !Opts.PrimaryInput && !Opts.ModuleOutputPath.empty();
   }
 
   for (const Arg *A : make_range(Args.filtered_begin(OPT_import_module),
@@ -729,6 +751,17 @@ static bool ParseLangArgs(LangOptions &Opts, ArgList &Args,
     Opts.DebugForbidTypecheckPrefix = A->getValue();
   }
 
+  if (const Arg *A = Args.getLastArg(OPT_ast_verifier_sample_rate)) {
+    unsigned rate;
+    if (StringRef(A->getValue()).getAsInteger(10, rate) || rate == 0) {
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(Args), A->getValue());
+      return true;
+    }
+
+    Opts.ASTVerifierSampleRate = rate;
+  }
+
   if (const Arg *A = Args.getLastArg(OPT_solver_memory_threshold)) {
     unsigned threshold;
     if (StringRef(A->getValue()).getAsInteger(10, threshold)) {
@@ -739,7 +772,18 @@ static bool ParseLangArgs(LangOptions &Opts, ArgList &Args,
     
     Opts.SolverMemoryThreshold = threshold;
   }
-  
+
+  if (const Arg *A = Args.getLastArg(OPT_solver_scope_threshold)) {
+    unsigned threshold;
+    if (StringRef(A->getValue()).getAsInteger(10, threshold)) {
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(Args), A->getValue());
+      return true;
+    }
+
+    Opts.SolverScopeThreshold = threshold;
+  }
+
   for (const Arg *A : make_range(Args.filtered_begin(OPT_D),
                                  Args.filtered_end())) {
     Opts.addBuildConfigOption(A->getValue());
@@ -795,6 +839,9 @@ static bool ParseClangImporterArgs(ClangImporterOptions &Opts,
   if (const Arg *A = Args.getLastArg(OPT_target_cpu))
     Opts.TargetCPU = A->getValue();
 
+  if (const Arg *A = Args.getLastArg(OPT_import_objc_header))
+    Opts.BridgingHeader = A->getValue();
+
   for (const Arg *A : make_range(Args.filtered_begin(OPT_Xcc),
                                  Args.filtered_end())) {
     Opts.ExtraArgs.push_back(A->getValue());
@@ -992,6 +1039,8 @@ static bool ParseSILArgs(SILOptions &Opts, ArgList &Args,
 
   Opts.EnableARCOptimizations |= !Args.hasArg(OPT_disable_arc_opts);
   Opts.VerifyAll |= Args.hasArg(OPT_sil_verify_all);
+  Opts.EmitReachableFunctionsOnly |=
+      Args.hasArg(OPT_sil_emit_reachable_functions_only);
   Opts.DebugSerialization |= Args.hasArg(OPT_sil_debug_serialization);
   Opts.EmitVerboseSIL |= Args.hasArg(OPT_emit_verbose_sil);
   Opts.PrintInstCounts |= Args.hasArg(OPT_print_inst_counts);
@@ -1127,6 +1176,9 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
 
   Opts.GenerateProfile |= Args.hasArg(OPT_profile_generate);
 
+  if (const Arg *A = Args.getLastArg(OPT_vtable_layout_profile))
+    Opts.VTableLayoutProfilePath = A->getValue();
+
   if (Args.hasArg(OPT_embed_bitcode))
     Opts.EmbedMode = IRGenEmbedMode::EmbedBitcode;
   else if (Args.hasArg(OPT_embed_bitcode_marker))
@@ -165,6 +165,12 @@ bool CompilerInstance::setup(const CompilerInvocation &Invok) {
     }
 
     // Open the input file.
+    //
+    // This only maps the file; large inputs are mmap'ed by MemoryBuffer and
+    // their pages are faulted in lazily once the parser actually touches
+    // them, so setup time per file is a stat and an open, not a read. The
+    // page cache also shares the contents between the frontend jobs of a
+    // multi-process build.
     using FileOrError = llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>;
     FileOrError InputFileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(File);
     if (!InputFileOrErr) {
@@ -435,6 +441,9 @@ void CompilerInstance::performSema() {
   if (Invocation.getFrontendOptions().actionIsImmediate()) {
     TypeCheckOptions |= TypeCheckingFlags::ForImmediateMode;
   }
+  if (Invocation.getFrontendOptions().SkipFunctionBodies) {
+    TypeCheckOptions |= TypeCheckingFlags::SkipFunctionBodies;
+  }
 
   // Parse the main file last.
   if (MainBufferID != NO_SUCH_BUFFER) {
@@ -491,6 +500,11 @@ void CompilerInstance::performSema() {
       if (auto SF = dyn_cast<SourceFile>(File))
         performWholeModuleTypeChecking(*SF);
   }
+
+  // Type checking is done; release the archetype builders memoized along
+  // the way.  SILGen and IRGen recreate any builder they still need from
+  // its generic signature.
+  Context->releaseUnreferencedArchetypeBuilders();
 }
 
 void CompilerInstance::performParseOnly() {
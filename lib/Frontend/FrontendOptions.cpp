@@ -26,6 +26,7 @@ bool FrontendOptions::actionHasOutput() const {
   case PrintAST:
   case DumpTypeRefinementContexts:
     return false;
+  case EmitPCH:
   case EmitSILGen:
   case EmitSIL:
   case EmitSIBGen:
@@ -53,6 +54,7 @@ bool FrontendOptions::actionIsImmediate() const {
   case DumpInterfaceHash:
   case PrintAST:
   case DumpTypeRefinementContexts:
+  case EmitPCH:
   case EmitSILGen:
   case EmitSIL:
   case EmitSIBGen:
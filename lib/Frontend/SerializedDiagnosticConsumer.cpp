@@ -22,10 +22,15 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 // For constant values only.
 #include "clang/Frontend/SerializedDiagnosticPrinter.h"
@@ -83,6 +88,36 @@ public:
 typedef SmallVector<uint64_t, 64> RecordData;
 typedef SmallVectorImpl<uint64_t> RecordDataImpl;
 
+/// \brief A source location resolved to line and column at capture time,
+/// so that encoding does not need the SourceManager.
+struct QueuedLoc {
+  bool IsValid = false;
+  unsigned Line = 0;
+  unsigned Col = 0;
+};
+
+struct QueuedRange {
+  QueuedLoc Start, End;
+};
+
+struct QueuedFixIt {
+  QueuedRange Range;
+  std::string Text;
+};
+
+/// \brief A diagnostic captured on the thread that emitted it and encoded
+/// into the bitstream later, off the hot path.  Owns copies of all its
+/// strings; the originals are transient.
+struct QueuedDiagnostic {
+  DiagnosticKind Kind;
+  /// The file containing the diagnostic; empty if it has no location.
+  std::string Filename;
+  QueuedLoc Loc;
+  std::string Text;
+  SmallVector<QueuedRange, 2> Ranges;
+  SmallVector<QueuedFixIt, 2> FixIts;
+};
+
 struct SharedState : llvm::RefCountedBase<SharedState> {
   SharedState(std::unique_ptr<raw_ostream> OS)
       : Stream(Buffer), OS(std::move(OS)), EmittedAnyDiagBlocks(false) { }
@@ -105,8 +140,10 @@ struct SharedState : llvm::RefCountedBase<SharedState> {
   /// \brief A text buffer for rendering diagnostic text.
   llvm::SmallString<256> diagBuf;
 
-  /// \brief The collection of files used.
-  llvm::DenseMap<const char *, unsigned> Files;
+  /// \brief The collection of files used, uniqued by name so that a file
+  /// never gets more than one RECORD_FILENAME no matter how many buffers
+  /// refer to it.
+  llvm::StringMap<unsigned> Files;
 
   typedef llvm::DenseMap<const void *, std::pair<unsigned, StringRef> >
   DiagFlagsTy;
@@ -116,8 +153,25 @@ struct SharedState : llvm::RefCountedBase<SharedState> {
 
   /// \brief Whether we have already started emission of any DIAG blocks. Once
   /// this becomes \c true, we never close a DIAG block until we know that we're
-  /// starting another one or we're done.
+  /// starting another one or we're done.  Only touched by the writer thread
+  /// (and by the destructor, after joining it).
   bool EmittedAnyDiagBlocks;
+
+  /// \brief Captured diagnostics waiting to be encoded, in emission order.
+  /// Guarded by \c QueueMutex.
+  std::deque<QueuedDiagnostic> Queue;
+
+  /// \brief Set when no further diagnostics will be enqueued, so the writer
+  /// thread can drain the queue and exit.  Guarded by \c QueueMutex.
+  bool DoneEnqueuing = false;
+
+  std::mutex QueueMutex;
+  std::condition_variable QueueCV;
+
+  /// \brief The thread that encodes queued diagnostics into the bitstream.
+  /// Started lazily on the first diagnostic, so diagnostic-free compilations
+  /// never pay for it.
+  std::thread WriterThread;
 };
 
 /// \brief Diagnostic consumer that serializes diagnostics to a stream.
@@ -138,6 +192,16 @@ public:
     // have these yet in Swift, but if we do we need to add an extra
     // check here.
 
+    // Let the writer thread drain the queue and wait for it.
+    if (State->WriterThread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(State->QueueMutex);
+        State->DoneEnqueuing = true;
+      }
+      State->QueueCV.notify_one();
+      State->WriterThread.join();
+    }
+
     // Finish off any diagnostic we were in the process of emitting.
     if (State->EmittedAnyDiagBlocks)
       exitDiagBlock();
@@ -179,18 +243,24 @@ private:
   unsigned getEmitFile(StringRef Filename);
 
   /// \brief Add a source location to a record.
-  void addLocToRecord(SourceLoc Loc,
-                      SourceManager &SM,
+  void addLocToRecord(const QueuedLoc &Loc,
                       StringRef Filename,
                       RecordDataImpl &Record);
 
-  void addRangeToRecord(CharSourceRange Range, SourceManager &SM,
-                        StringRef Filename, RecordDataImpl &Record);
+  void addRangeToRecord(const QueuedRange &Range, StringRef Filename,
+                        RecordDataImpl &Record);
+
+  /// \brief Encode a captured diagnostic into the bitstream, including its
+  /// bracketing DIAG blocks.  Runs on the writer thread.
+  void encodeDiagnostic(const QueuedDiagnostic &D);
 
-  /// \brief Emit the message payload of a diagnostic to bitcode.
-  void emitDiagnosticMessage(SourceManager &SM, SourceLoc Loc,
-                             DiagnosticKind Kind,
-                             StringRef Text, const DiagnosticInfo &Info);
+  /// \brief Emit the message payload of a diagnostic to bitcode.  Runs on
+  /// the writer thread.
+  void emitDiagnosticMessage(const QueuedDiagnostic &D);
+
+  /// \brief The writer thread's main loop: drains the queue in emission
+  /// order until the consumer is destroyed.
+  void encodeLoop();
 };
 }
 
@@ -201,10 +271,7 @@ namespace swift { namespace serialized_diagnostics {
 }}
 
 unsigned SerializedDiagnosticConsumer::getEmitFile(StringRef Filename) {
-  // NOTE: Using Filename.data() here relies on SourceMgr using
-  // const char* as buffer identifiers.  This is fast, but may
-  // be brittle.  We can always switch over to using a StringMap.
-  unsigned &entry = State->Files[Filename.data()];
+  unsigned &entry = State->Files[Filename];
   if (entry)
     return entry;
 
@@ -224,11 +291,10 @@ unsigned SerializedDiagnosticConsumer::getEmitFile(StringRef Filename) {
   return entry;
 }
 
-void SerializedDiagnosticConsumer::addLocToRecord(SourceLoc Loc,
-                                                  SourceManager &SM,
+void SerializedDiagnosticConsumer::addLocToRecord(const QueuedLoc &Loc,
                                                   StringRef Filename,
                                                   RecordDataImpl &Record) {
-  if (!Loc.isValid()) {
+  if (!Loc.IsValid) {
     // Emit a "sentinel" location.
     Record.push_back((unsigned)0); // File.
     Record.push_back((unsigned)0); // Line.
@@ -237,22 +303,17 @@ void SerializedDiagnosticConsumer::addLocToRecord(SourceLoc Loc,
     return;
   }
 
-  unsigned line, col;
-  std::tie(line, col) = SM.getLineAndColumn(Loc);
-
   Record.push_back(getEmitFile(Filename));
-  Record.push_back(line);
-  Record.push_back(col);
+  Record.push_back(Loc.Line);
+  Record.push_back(Loc.Col);
   Record.push_back(0);
 }
 
-void SerializedDiagnosticConsumer::addRangeToRecord(CharSourceRange Range,
-                                                    SourceManager &SM,
+void SerializedDiagnosticConsumer::addRangeToRecord(const QueuedRange &Range,
                                                     StringRef Filename,
                                                     RecordDataImpl &Record) {
-  assert(Range.isValid());
-  addLocToRecord(Range.getStart(), SM, Filename, Record);
-  addLocToRecord(Range.getEnd(), SM, Filename, Record);
+  addLocToRecord(Range.Start, Filename, Record);
+  addLocToRecord(Range.End, Filename, Record);
 }
 
 /// \brief Map a Swift DiagosticKind to the diagnostic level expected
@@ -430,26 +491,19 @@ void SerializedDiagnosticConsumer::emitBlockInfoBlock() {
 }
 
 void SerializedDiagnosticConsumer::
-emitDiagnosticMessage(SourceManager &SM,
-                      SourceLoc Loc,
-                      DiagnosticKind Kind,
-                      StringRef Text,
-                      const DiagnosticInfo &Info) {
-
+emitDiagnosticMessage(const QueuedDiagnostic &D) {
   // Emit the diagnostic to bitcode.
   llvm::BitstreamWriter &Stream = State->Stream;
   RecordData &Record = State->Record;
   AbbreviationMap &Abbrevs = State->Abbrevs;
 
-  StringRef filename = "";
-  if (Loc.isValid())
-    filename = SM.getIdentifierForBuffer(SM.findBufferContainingLoc(Loc));
+  StringRef filename = D.Filename;
 
   // Emit the RECORD_DIAG record.
   Record.clear();
   Record.push_back(RECORD_DIAG);
-  Record.push_back(getDiagnosticLevel(Kind));
-  addLocToRecord(Loc, SM, filename, Record);
+  Record.push_back(getDiagnosticLevel(D.Kind));
+  addLocToRecord(D.Loc, filename, Record);
 
   // FIXME: Swift diagnostics currently have no category.
   Record.push_back(0);
@@ -457,47 +511,38 @@ emitDiagnosticMessage(SourceManager &SM,
   Record.push_back(0);
 
   // Emit the message.
-  Record.push_back(Text.size());
-  Stream.EmitRecordWithBlob(Abbrevs.get(RECORD_DIAG), Record, Text);
+  Record.push_back(D.Text.size());
+  Stream.EmitRecordWithBlob(Abbrevs.get(RECORD_DIAG), Record, D.Text);
 
-  // If the location is invalid, do not emit source ranges or fixits.
-  if (Loc.isInvalid())
+  // If the location is invalid, there are no source ranges or fixits.
+  if (!D.Loc.IsValid)
     return;
 
   // Emit source ranges.
   auto RangeAbbrev = State->Abbrevs.get(RECORD_SOURCE_RANGE);
-  for (const auto &R : Info.Ranges) {
-    if (R.isInvalid())
-      continue;
+  for (const auto &R : D.Ranges) {
     State->Record.clear();
     State->Record.push_back(RECORD_SOURCE_RANGE);
-    addRangeToRecord(R, SM, filename, State->Record);
+    addRangeToRecord(R, filename, State->Record);
     State->Stream.EmitRecordWithAbbrev(RangeAbbrev, State->Record);
   }
 
   // Emit FixIts.
   auto FixItAbbrev = State->Abbrevs.get(RECORD_FIXIT);
-  for (const auto &F : Info.FixIts) {
-    if (F.getRange().isValid()) {
-      State->Record.clear();
-      State->Record.push_back(RECORD_FIXIT);
-      addRangeToRecord(F.getRange(), SM, filename, State->Record);
-      State->Record.push_back(F.getText().size());
-      Stream.EmitRecordWithBlob(FixItAbbrev, Record, F.getText());
-    }
+  for (const auto &F : D.FixIts) {
+    State->Record.clear();
+    State->Record.push_back(RECORD_FIXIT);
+    addRangeToRecord(F.Range, filename, State->Record);
+    State->Record.push_back(F.Text.size());
+    Stream.EmitRecordWithBlob(FixItAbbrev, Record, F.Text);
   }
 }
 
-void
-SerializedDiagnosticConsumer::handleDiagnostic(SourceManager &SM,
-                                               SourceLoc Loc,
-                                               DiagnosticKind Kind,
-                                               StringRef Text,
-                                               const DiagnosticInfo &Info) {
+void SerializedDiagnosticConsumer::encodeDiagnostic(const QueuedDiagnostic &D) {
   // Enter the block for a non-note diagnostic immediately, rather
   // than waiting for beginDiagnostic, in case associated notes
   // are emitted before we get there.
-  if (Kind != DiagnosticKind::Note) {
+  if (D.Kind != DiagnosticKind::Note) {
     if (State->EmittedAnyDiagBlocks)
       exitDiagBlock();
 
@@ -507,14 +552,93 @@ SerializedDiagnosticConsumer::handleDiagnostic(SourceManager &SM,
 
   // Special-case diagnostics with no location.
   // Make sure we bracket all notes as "sub-diagnostics".
-  bool bracketDiagnostic = (Kind == DiagnosticKind::Note);
+  bool bracketDiagnostic = (D.Kind == DiagnosticKind::Note);
 
   if (bracketDiagnostic)
     enterDiagBlock();
 
-  emitDiagnosticMessage(SM, Loc, Kind, Text, Info);
+  emitDiagnosticMessage(D);
 
   if (bracketDiagnostic)
     exitDiagBlock();
 }
 
+void SerializedDiagnosticConsumer::encodeLoop() {
+  std::deque<QueuedDiagnostic> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(State->QueueMutex);
+      State->QueueCV.wait(lock, [&] {
+        return !State->Queue.empty() || State->DoneEnqueuing;
+      });
+      if (State->Queue.empty() && State->DoneEnqueuing)
+        return;
+      // Drain the whole queue in one batch so the emitting thread is not
+      // blocked for every record.
+      batch.swap(State->Queue);
+    }
+
+    for (const auto &D : batch)
+      encodeDiagnostic(D);
+    batch.clear();
+  }
+}
+
+/// \brief Resolve a source location to line and column now, while the
+/// SourceManager is at hand; the writer thread must not touch it.
+static QueuedLoc getQueuedLoc(SourceLoc Loc, SourceManager &SM) {
+  QueuedLoc Result;
+  if (Loc.isValid()) {
+    Result.IsValid = true;
+    std::tie(Result.Line, Result.Col) = SM.getLineAndColumn(Loc);
+  }
+  return Result;
+}
+
+void
+SerializedDiagnosticConsumer::handleDiagnostic(SourceManager &SM,
+                                               SourceLoc Loc,
+                                               DiagnosticKind Kind,
+                                               StringRef Text,
+                                               const DiagnosticInfo &Info) {
+  // Capture the diagnostic, resolving locations and copying the transient
+  // strings; the writer thread encodes it later.
+  QueuedDiagnostic D;
+  D.Kind = Kind;
+  if (Loc.isValid())
+    D.Filename = SM.getIdentifierForBuffer(SM.findBufferContainingLoc(Loc));
+  D.Loc = getQueuedLoc(Loc, SM);
+  D.Text = Text;
+
+  // If the location is invalid, do not capture source ranges or fixits.
+  if (Loc.isValid()) {
+    for (const auto &R : Info.Ranges) {
+      if (R.isInvalid())
+        continue;
+      D.Ranges.push_back({getQueuedLoc(R.getStart(), SM),
+                          getQueuedLoc(R.getEnd(), SM)});
+    }
+
+    for (const auto &F : Info.FixIts) {
+      if (F.getRange().isInvalid())
+        continue;
+      QueuedFixIt Fix;
+      Fix.Range = {getQueuedLoc(F.getRange().getStart(), SM),
+                   getQueuedLoc(F.getRange().getEnd(), SM)};
+      Fix.Text = F.getText();
+      D.FixIts.push_back(std::move(Fix));
+    }
+  }
+
+  // Diagnostics are emitted serially, so there is no race starting the
+  // writer thread lazily here.
+  if (!State->WriterThread.joinable())
+    State->WriterThread = std::thread([this] { encodeLoop(); });
+
+  {
+    std::lock_guard<std::mutex> lock(State->QueueMutex);
+    State->Queue.push_back(std::move(D));
+  }
+  State->QueueCV.notify_one();
+}
+
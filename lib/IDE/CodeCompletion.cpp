@@ -29,6 +29,7 @@
 #include "swift/Parse/CodeCompletionCallbacks.h"
 #include "swift/Sema/CodeCompletionTypeChecking.h"
 #include "swift/Subsystems.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallString.h"
@@ -4318,6 +4319,41 @@ public:
   }
 };
 
+/// Compute a fingerprint of everything that can affect the current module's
+/// top-level completion results: the set of source files, each file's import
+/// set, and the names and kinds of its top-level declarations.
+///
+/// The fingerprint deliberately ignores declaration bodies and signatures;
+/// edits inside a function body reuse the cached results, while adding,
+/// removing or renaming a top-level declaration or changing an import
+/// invalidates them.
+static uint64_t hashTopLevelContext(const Module *M) {
+  llvm::hash_code hash = llvm::hash_value(M->getName().str());
+  for (const FileUnit *file : M->getFiles()) {
+    auto *SF = dyn_cast<SourceFile>(file);
+    if (!SF)
+      continue;
+
+    hash = llvm::hash_combine(hash, SF->getFilename());
+
+    SmallVector<Module::ImportedModule, 8> imports;
+    SF->getImportedModules(imports, Module::ImportFilter::All);
+    for (auto import : imports) {
+      hash = llvm::hash_combine(hash, import.second->getName().str());
+      for (auto piece : import.first)
+        hash = llvm::hash_combine(hash, piece.first.str());
+    }
+
+    for (Decl *D : SF->Decls) {
+      hash = llvm::hash_combine(hash, unsigned(D->getKind()));
+      if (auto *VD = dyn_cast<ValueDecl>(D))
+        if (VD->hasName())
+          hash = llvm::hash_combine(hash, VD->getName().str());
+    }
+  }
+  return uint64_t(hash);
+}
+
 void CodeCompletionCallbacksImpl::doneParsing() {
   CompletionContext.CodeCompletionKind = Kind;
 
@@ -4634,8 +4670,21 @@ void CodeCompletionCallbacksImpl::doneParsing() {
       const_cast<Module*>(Request.TheModule)
           ->forAllVisibleModules({}, handleImport);
     } else {
-      // Add results from current module.
-      Lookup.getToplevelCompletions(Request.OnlyTypes);
+      // Add results from the current module, reusing cached results when
+      // nothing visible at the top level has changed since they were built.
+      Module *CurrentModule = CurDeclContext->getParentModule();
+      uint64_t Fingerprint = hashTopLevelContext(CurrentModule);
+      StringRef ModuleName = CurrentModule->getName().str();
+      auto V = CompletionContext.Cache.getCurrentModule(ModuleName,
+                                                        Fingerprint);
+      if (!V.hasValue()) {
+        V = CompletionContext.Cache.createValue();
+        CompletionLookup ToplevelLookup((*V)->Sink, P.Context, CurDeclContext);
+        ToplevelLookup.getToplevelCompletions(/*OnlyTypes=*/false);
+        CompletionContext.Cache.setCurrentModule(ModuleName, Fingerprint, *V);
+      }
+      copyCodeCompletionResults(CompletionContext.getResultSink(), (*V)->Sink,
+                                Request.OnlyTypes);
       Lookup.discardTypeResolver();
 
       // Add results for all imported modules.
@@ -17,6 +17,14 @@ namespace swift {
       using Value = CodeCompletionCache::Value;
       using ValueRefCntPtr = CodeCompletionCache::ValueRefCntPtr;
       sys::Cache<Key, ValueRefCntPtr> TheCache{"swift.libIDE.CodeCompletionCache"};
+
+      /// Results for the top-level declarations of the module under
+      /// compilation, together with the fingerprint they were computed from.
+      /// There is only ever one module under compilation, so a single slot
+      /// suffices.
+      std::string CurrentModuleName;
+      uint64_t CurrentModuleFingerprint = 0;
+      ValueRefCntPtr CurrentModuleResults;
     };
   } // end namespace ide
 } // end namespace swift
@@ -79,6 +87,24 @@ void CodeCompletionCache::setImpl(const Key &K, ValueRefCntPtr V,
     nextCache->set(K, V);
 }
 
+Optional<CodeCompletionCache::ValueRefCntPtr>
+CodeCompletionCache::getCurrentModule(StringRef ModuleName,
+                                      uint64_t Fingerprint) {
+  if (!Impl->CurrentModuleResults ||
+      Impl->CurrentModuleName != ModuleName ||
+      Impl->CurrentModuleFingerprint != Fingerprint)
+    return None;
+  return Impl->CurrentModuleResults;
+}
+
+void CodeCompletionCache::setCurrentModule(StringRef ModuleName,
+                                           uint64_t Fingerprint,
+                                           ValueRefCntPtr V) {
+  Impl->CurrentModuleName = ModuleName;
+  Impl->CurrentModuleFingerprint = Fingerprint;
+  Impl->CurrentModuleResults = std::move(V);
+}
+
 CodeCompletionCache::CodeCompletionCache(OnDiskCodeCompletionCache *nextCache)
     : Impl(new CodeCompletionCacheImpl()), nextCache(nextCache) {}
 
@@ -90,12 +116,6 @@ CodeCompletionCache::~CodeCompletionCache() {}
 /// cached results. This isn't expected to change very often.
 static constexpr uint32_t onDiskCompletionCacheVersion = 0;
 
-static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
-  char *Mem = Allocator.Allocate<char>(Str.size());
-  std::copy(Str.begin(), Str.end(), Mem);
-  return StringRef(Mem, Str.size());
-}
-
 static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
                                            ArrayRef<StringRef> Arr) {
   StringRef *Buff = Allocator.Allocate<StringRef>(Arr.size());
@@ -113,14 +133,31 @@ static ArrayRef<std::pair<StringRef, StringRef>> copyStringPairArray(
 }
 
 /// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+///
+/// The results reference strings in \p in directly rather than copying them,
+/// so the buffer's lifetime is tied to the sink's allocator, which is all
+/// that is retained when the results are imported into another sink (see
+/// copyCodeCompletionResults). Since the buffer is typically memory-mapped,
+/// a cold process mostly pays for touching the pages it actually uses.
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::unique_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
   const char *cursor = in->getBufferStart();
   const char *end = in->getBufferEnd();
 
+  // Give the buffer the same lifetime as the sink's allocator.
+  struct ResultStorage {
+    llvm::BumpPtrAllocator Allocator;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  };
+  auto storage = std::make_shared<ResultStorage>();
+  storage->Buffer = std::move(in);
+  assert(V.Sink.Results.empty() && "Expected an empty value");
+  V.Sink.Allocator = std::shared_ptr<llvm::BumpPtrAllocator>(
+      storage, &storage->Allocator);
+
   auto read32le = [end](const char *&cursor) {
     auto result = llvm::support::endian::read32le(cursor);
     cursor += sizeof(result);
@@ -165,9 +202,11 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     if (index == ~0u)
       return "";
 
+    // Return the string in the buffer directly; the buffer is kept alive by
+    // the value.
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -417,14 +456,18 @@ static std::string getName(StringRef cacheDirectory,
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  // Try to find the cached file. Open it without requiring a null
+  // terminator, so that it can be memory-mapped.
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K),
+                                                 /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/
+                                                 false);
   if (!bufferOrErr)
     return None;
 
   // Read the cached results, failing if they are out of date.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V))
     return None;
 
   return V;
@@ -460,7 +503,9 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
   // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename, /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/
+                                                 false);
   if (!bufferOrErr)
     return None;
 
@@ -469,7 +514,7 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V,
                         /*allowOutOfDate*/ true))
     return None;
 
@@ -0,0 +1,116 @@
+//===--- IndexData.cpp - Routines to emit index data ----------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/IDE/IndexData.h"
+#include "swift/IDE/SourceEntityWalker.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/Decl.h"
+#include "swift/AST/Module.h"
+#include "swift/AST/USRGeneration.h"
+#include "swift/Basic/SourceManager.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+#include <vector>
+
+using namespace swift;
+using namespace swift::ide;
+
+namespace {
+
+/// Collects one occurrence record per declaration and reference in a source
+/// file, interning the USR strings so that each is emitted only once.
+class IndexDataCollector : public SourceEntityWalker {
+  SourceManager &SM;
+  unsigned BufferID;
+
+  struct Occurrence {
+    unsigned USRIndex;
+    unsigned Role;
+    unsigned Line;
+    unsigned Column;
+  };
+  std::vector<Occurrence> Occurrences;
+  llvm::StringMap<unsigned> USRIndices;
+  std::vector<std::string> USRs;
+
+public:
+  IndexDataCollector(SourceManager &SM, unsigned BufferID)
+      : SM(SM), BufferID(BufferID) {}
+
+  bool walkToDeclPre(Decl *D, CharSourceRange Range) override {
+    if (auto *VD = dyn_cast<ValueDecl>(D))
+      record(VD, Range.getStart(), IndexOccurrenceRole::Declaration);
+    return true;
+  }
+
+  bool visitDeclReference(ValueDecl *D, CharSourceRange Range,
+                          TypeDecl *CtorTyRef, Type T) override {
+    record(CtorTyRef ? CtorTyRef : D, Range.getStart(),
+           IndexOccurrenceRole::Reference);
+    return true;
+  }
+
+  void emit(raw_ostream &OS) {
+    OS << "SIDX";
+    OS.write(char(1)); // Format version.
+
+    llvm::encodeULEB128(Occurrences.size(), OS);
+    for (const Occurrence &O : Occurrences) {
+      llvm::encodeULEB128(O.USRIndex, OS);
+      llvm::encodeULEB128(O.Role, OS);
+      llvm::encodeULEB128(O.Line, OS);
+      llvm::encodeULEB128(O.Column, OS);
+    }
+
+    llvm::encodeULEB128(USRs.size(), OS);
+    for (const std::string &USR : USRs) {
+      llvm::encodeULEB128(USR.size(), OS);
+      OS << USR;
+    }
+  }
+
+private:
+  void record(const ValueDecl *D, SourceLoc Loc, IndexOccurrenceRole Role) {
+    if (Loc.isInvalid() || !D->hasName())
+      return;
+
+    llvm::SmallString<128> USR;
+    {
+      llvm::raw_svector_ostream OS(USR);
+      if (printDeclUSR(D, OS))
+        return;
+    }
+
+    auto Entry = USRIndices.insert({USR.str(), USRs.size()});
+    if (Entry.second)
+      USRs.push_back(USR.str());
+
+    auto LineCol = SM.getLineAndColumn(Loc, BufferID);
+    Occurrences.push_back(
+        {Entry.first->second, unsigned(Role), LineCol.first, LineCol.second});
+  }
+};
+
+} // unnamed namespace
+
+bool swift::ide::emitIndexData(SourceFile &SF, raw_ostream &OS) {
+  if (!SF.getBufferID().hasValue())
+    return true;
+
+  IndexDataCollector Collector(SF.getASTContext().SourceMgr,
+                               *SF.getBufferID());
+  Collector.walk(SF);
+  Collector.emit(OS);
+  return false;
+}
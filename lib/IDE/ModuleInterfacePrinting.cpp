@@ -133,12 +133,13 @@ static void adjustPrintOptions(PrintOptions &AdjustedOptions) {
   AdjustedOptions.PrintDefaultParameterPlaceholder = true;
 }
 
-void swift::ide::printSubmoduleInterface(
+unsigned swift::ide::printSubmoduleInterface(
        Module *M,
        ArrayRef<StringRef> FullModuleName,
        ModuleTraversalOptions TraversalOptions,
        ASTPrinter &Printer,
-       const PrintOptions &Options) {
+       const PrintOptions &Options,
+       Optional<std::pair<unsigned, unsigned>> Range) {
   auto AdjustedOptions = Options;
   adjustPrintOptions(AdjustedOptions);
 
@@ -166,7 +167,7 @@ void swift::ide::printSubmoduleInterface(
     for (StringRef Name : FullModuleName) {
       InterestingClangModule = InterestingClangModule->findSubmodule(Name);
       if (!InterestingClangModule)
-        return;
+        return 0;
     }
   } else {
     assert(FullModuleName.empty());
@@ -387,12 +388,17 @@ void swift::ide::printSubmoduleInterface(
     return false;
   };
 
+  // Flatten the buckets into the stable interface order: import declarations
+  // first, then imported declarations grouped by submodule name, then Swift
+  // declarations. Ranged printing indexes into this order.
+  SmallVector<Decl *, 64> DeclsInOrder;
+
   // Imports from the stdlib are internal details that don't need to be exposed.
   if (!M->isStdlibModule()) {
     for (auto *D : ImportDecls)
-      PrintDecl(D);
-    Printer << "\n";
+      DeclsInOrder.push_back(D);
   }
+  unsigned NumImportDecls = DeclsInOrder.size();
 
   {
     using ModuleAndName = std::pair<const clang::Module *, std::string>;
@@ -409,17 +415,37 @@ void swift::ide::printSubmoduleInterface(
 
     for (auto CM : ClangModules) {
       for (auto DeclAndLoc : ClangDecls[CM.first])
-        PrintDecl(DeclAndLoc.first);
+        DeclsInOrder.push_back(DeclAndLoc.first);
     }
   }
+  unsigned NumNonSwiftDecls = DeclsInOrder.size();
 
   if (!(TraversalOptions & ModuleTraversal::SkipOverlay) ||
       !InterestingClangModule) {
-    for (auto *D : SwiftDecls) {
-      if (PrintDecl(D))
-        Printer << "\n";
-    }
+    for (auto *D : SwiftDecls)
+      DeclsInOrder.push_back(D);
   }
+
+  unsigned Begin = 0;
+  unsigned End = DeclsInOrder.size();
+  if (Range) {
+    Begin = std::min(Range->first, End);
+    End = std::min(Range->first + Range->second, End);
+  }
+
+  // An empty line separates the imports from the rest of the interface.
+  if (!M->isStdlibModule() && NumImportDecls == 0 && Begin == 0)
+    Printer << "\n";
+
+  for (unsigned Idx = Begin; Idx != End; ++Idx) {
+    bool Printed = PrintDecl(DeclsInOrder[Idx]);
+    if (Idx + 1 == NumImportDecls)
+      Printer << "\n";
+    else if (Printed && Idx >= NumNonSwiftDecls)
+      Printer << "\n";
+  }
+
+  return DeclsInOrder.size();
 }
 
 static SourceLoc getDeclStartPosition(SourceFile &File) {
@@ -243,6 +243,13 @@ class ModelASTWalker : public ASTWalker {
                                       SourceLoc OrigLoc);
   llvm::DenseSet<ASTNode> VisitedNodesInsideIfConfig;
 
+  /// The entire token stream of the buffer, lexed once on first use with
+  /// comments retained and interpolated strings left unsplit. Shared across
+  /// handleAttrRanges calls so that each attributed declaration does not
+  /// re-lex its source range.
+  std::vector<Token> RawTokens;
+  bool RawTokensLexed = false;
+
 public:
   SyntaxModelWalker &Walker;
   ArrayRef<SyntaxNode> TokenNodes;
@@ -273,9 +280,13 @@ private:
   typedef std::pair<const DeclAttribute *, SourceRange> DeclAttributeAndRange;
 
   bool handleSpecialDeclAttribute(const DeclAttribute *Decl,
-                                  std::vector<Token> &Toks);
+                                  ArrayRef<Token> Toks);
   bool handleAttrRanges(ArrayRef<DeclAttributeAndRange> DeclRanges);
 
+  /// Retrieve the tokens of the buffer whose locations fall within
+  /// [\p Begin, \p End), lexing the buffer's token stream on first use.
+  ArrayRef<Token> getRawTokensInRange(SourceLoc Begin, SourceLoc End);
+
   void handleStmtCondition(StmtCondition cond);
 
   bool shouldPassBraceStructureNode(BraceStmt *S);
@@ -1015,8 +1026,30 @@ bool ModelASTWalker::annotateIfConfigConditionIdentifiers(Expr *Cond) {
   return true;
 }
 
+ArrayRef<Token> ModelASTWalker::getRawTokensInRange(SourceLoc Begin,
+                                                    SourceLoc End) {
+  if (!RawTokensLexed) {
+    RawTokens = swift::tokenize(LangOpts, SM, BufferID,
+                                /*Offset=*/0,
+                                /*EndOffset=*/0,
+                                /*KeepComments=*/true,
+                                /*TokenizeInterpolatedString=*/false);
+    RawTokensLexed = true;
+  }
+
+  auto StartsBefore = [&](const Token &Tok, SourceLoc Loc) {
+    return SM.isBeforeInBuffer(Tok.getLoc(), Loc);
+  };
+  auto First = std::lower_bound(RawTokens.begin(), RawTokens.end(),
+                                Begin, StartsBefore);
+  auto Last = std::lower_bound(First, RawTokens.end(), End, StartsBefore);
+  if (First == Last)
+    return ArrayRef<Token>();
+  return llvm::makeArrayRef(&*First, Last - First);
+}
+
 bool ModelASTWalker::handleSpecialDeclAttribute(const DeclAttribute *D,
-                                                std::vector<Token> &Toks) {
+                                                ArrayRef<Token> Toks) {
   if (!D)
     return false;
   if (isa<AvailableAttr>(D)) {
@@ -1091,12 +1124,8 @@ bool ModelASTWalker::handleAttrRanges(ArrayRef<DeclAttributeAndRange> DeclRanges
 
   SourceLoc BeginLoc = DeclRanges.front().second.Start;
 
-  std::vector<Token> Toks = swift::tokenize(
-      LangOpts, SM, BufferID,
-      SM.getLocOffsetInBuffer(BeginLoc, BufferID),
-      SM.getLocOffsetInBuffer(DeclRanges.back().second.End, BufferID),
-      /*KeepComments=*/true,
-      /*TokenizeInterpolatedString=*/false);
+  ArrayRef<Token> Toks =
+      getRawTokensInRange(BeginLoc, DeclRanges.back().second.End);
 
   auto passAttrNode = [&](SourceRange AttrRange) -> bool {
     SourceRange Range = AttrRange;
@@ -18,6 +18,8 @@
 #define SWIFT_IRGEN_CLASSMETADATALAYOUT_H
 
 #include "swift/SIL/SILDeclRef.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "IRGen.h"
 #include "MetadataLayout.h"
 
@@ -100,7 +102,10 @@ private:
     }
 
     // Add entries for the methods.
-    for (auto member : theClass->getMembers()) {
+    SmallVector<Decl *, 16> members(theClass->getMembers().begin(),
+                                    theClass->getMembers().end());
+    orderMethodEntries(theClass, members);
+    for (auto member : members) {
       // If this is a non-overriding final member, we don't need table entries.
       // FIXME: do we really need entries for final overrides?  The
       // superclass should provide the entries it needs, and
@@ -162,6 +167,76 @@ private:
     asImpl().noteEndOfFieldOffsets(theClass);
   }
   
+  /// Establish the order in which \p theClass's own method table entries
+  /// are laid out.  By default this is declaration order.  When profile
+  /// data was supplied with -vtable-layout-profile and the class is never
+  /// visible to other modules, hot methods are moved to the front of the
+  /// class's portion of the table so that frequently dispatched entries
+  /// share its leading cache lines.  Every translation unit of the module
+  /// sees the same flag, so all of them compute the same layout.
+  void orderMethodEntries(ClassDecl *theClass,
+                          SmallVectorImpl<Decl *> &members) {
+    // A class whose method table can be indexed from outside this module
+    // must keep declaration order: other modules lay out the metadata
+    // without the profile.
+    if (theClass->getEffectiveAccess() >= Accessibility::Public)
+      return;
+
+    auto *counts = IGM.getVTableLayoutProfileCounts();
+    if (!counts)
+      return;
+
+    SmallVector<std::pair<uint64_t, Decl *>, 16> keyed;
+    keyed.reserve(members.size());
+    for (auto *member : members)
+      keyed.push_back({getProfiledEntryCount(*counts, member), member});
+
+    // Hottest first.  The stable sort keeps declaration order for ties,
+    // so unprofiled members stay where they were relative to each other.
+    std::stable_sort(keyed.begin(), keyed.end(),
+                     [](const std::pair<uint64_t, Decl *> &lhs,
+                        const std::pair<uint64_t, Decl *> &rhs) {
+                       return lhs.first > rhs.first;
+                     });
+    for (unsigned i = 0, e = members.size(); i != e; ++i)
+      members[i] = keyed[i].second;
+  }
+
+  /// Return the profiled entry count of the hottest method table entry
+  /// \p member introduces, or 0 if the profile does not mention it.
+  uint64_t getProfiledEntryCount(const llvm::StringMap<uint64_t> &counts,
+                                 Decl *member) {
+    auto countFor = [&](AbstractFunctionDecl *fn, SILDeclRef::Kind kind) {
+      SILDeclRef declRef(fn, kind, ResilienceExpansion::Minimal,
+                         SILDeclRef::ConstructAtNaturalUncurryLevel);
+      llvm::SmallString<64> buffer;
+      auto entry = counts.find(declRef.mangle(buffer));
+      return entry == counts.end() ? 0 : entry->second;
+    };
+
+    if (auto *fn = dyn_cast<FuncDecl>(member)) {
+      if (fn->isAccessor())
+        return 0;
+      return countFor(fn, SILDeclRef::Kind::Func);
+    }
+    if (auto *ctor = dyn_cast<ConstructorDecl>(member)) {
+      return std::max(countFor(ctor, SILDeclRef::Kind::Allocator),
+                      countFor(ctor, SILDeclRef::Kind::Initializer));
+    }
+    if (auto *asd = dyn_cast<AbstractStorageDecl>(member)) {
+      if (!asd->hasAccessorFunctions())
+        return 0;
+      uint64_t count = countFor(asd->getGetter(), SILDeclRef::Kind::Func);
+      if (auto *setter = asd->getSetter())
+        count = std::max(count, countFor(setter, SILDeclRef::Kind::Func));
+      if (auto *materializeForSet = asd->getMaterializeForSetFunc())
+        count = std::max(count,
+                         countFor(materializeForSet, SILDeclRef::Kind::Func));
+      return count;
+    }
+    return 0;
+  }
+
   /// Notes the beginning of the field offset vector for a particular ancestor
   /// of a generic-layout class.
   void noteStartOfFieldOffsets(ClassDecl *whichClass) {}
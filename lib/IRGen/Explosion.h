@@ -44,6 +44,15 @@ public:
   Explosion(const Explosion &) = delete;
   Explosion &operator=(const Explosion &) = delete;
   Explosion(Explosion &&other) : NextValue(0) {
+    if (other.NextValue == 0) {
+      // Nothing has been claimed from the other explosion, so just steal
+      // its storage wholesale.  In particular, if a wide aggregate spilled
+      // past the inline capacity, this takes over the heap buffer instead
+      // of allocating a new one.
+      Values.swap(other.Values);
+      return;
+    }
+
     // Do an uninitialized copy of the non-consumed elements.
     Values.reserve(other.size());
     Values.set_size(other.size());
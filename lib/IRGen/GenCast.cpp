@@ -270,9 +270,14 @@ llvm::Value *irgen::emitReferenceToObjCProtocol(IRGenFunction &IGF,
 /// Emit a helper function to look up \c numProtocols witness tables given
 /// a value and a type metadata reference.
 ///
-/// The function's input type is (value, metadataValue, protocol...)
+/// The function's input type is (value, metadataValue, cache, protocol...)
 /// The function's output type is (value, witnessTable...)
 ///
+/// The cache is a call-site-specific inline cache of 2 * \c numProtocols
+/// pointers which remembers the source type of the last successful cast and
+/// the witness tables it produced, so that casting a homogeneous stream of
+/// values only pays for the conformance lookup once.
+///
 /// The value is NULL if the cast failed.
 static llvm::Function *emitExistentialScalarCastFn(IRGenModule &IGM,
                                                    unsigned numProtocols,
@@ -307,6 +312,7 @@ static llvm::Function *emitExistentialScalarCastFn(IRGenModule &IGM,
   llvm::SmallVector<llvm::Type *, 4> returnTys;
   argTys.push_back(IGM.Int8PtrTy);
   argTys.push_back(IGM.TypeMetadataPtrTy);
+  argTys.push_back(IGM.Int8PtrPtrTy);
   returnTys.push_back(IGM.Int8PtrTy);
   for (unsigned i = 0; i < numProtocols; ++i) {
     argTys.push_back(IGM.ProtocolDescriptorPtrTy);
@@ -325,9 +331,11 @@ static llvm::Function *emitExistentialScalarCastFn(IRGenModule &IGM,
 
   auto value = args.claimNext();
   auto ref = args.claimNext();
+  auto cache = args.claimNext();
   auto failBB = IGF.createBasicBlock("fail");
   auto conformsToProtocol = IGM.getConformsToProtocolFn();
-  
+  auto ptrAlign = IGM.getPointerAlignment();
+
   Explosion rets;
   rets.add(value);
 
@@ -339,17 +347,76 @@ static llvm::Function *emitExistentialScalarCastFn(IRGenModule &IGM,
     IGF.Builder.emitBlock(contBB);
   }
 
+  auto refInt8 = IGF.Builder.CreateBitCast(ref, IGM.Int8PtrTy);
+
   // Look up each protocol conformance we want.
   for (unsigned i = 0; i < numProtocols; ++i) {
     auto proto = args.claimNext();
+
+    // The cache entry for this protocol: the source type of the last
+    // successful cast and the witness table it found.
+    Address typeSlot(IGF.Builder.CreateConstInBoundsGEP1_32(
+                         IGM.Int8PtrTy, cache, 2 * i), ptrAlign);
+    Address witnessSlot(IGF.Builder.CreateConstInBoundsGEP1_32(
+                            IGM.Int8PtrTy, cache, 2 * i + 1), ptrAlign);
+
+    // Check the inline cache first. The witness table load is not
+    // address-dependent on the type load, so unlike the lazy metadata
+    // caches we need real acquire/release ordering here to make sure we
+    // never pair a type with the witness table of a previous type.
+    auto cachedType = IGF.Builder.CreateLoad(typeSlot);
+    cachedType->setAtomic(llvm::AtomicOrdering::Acquire);
+    auto hit = IGF.Builder.CreateICmpEQ(cachedType, refInt8);
+    auto hitBB = IGF.createBasicBlock("cacheHit");
+    auto missBB = IGF.createBasicBlock("cacheMiss");
+    auto contBB = IGF.createBasicBlock("cont");
+    IGF.Builder.CreateCondBr(hit, hitBB, missBB);
+
+    // The cached type matches; the witness table is sitting next to it.
+    // We only cache successful casts, so it is known to be non-null.
+    IGF.Builder.emitBlock(hitBB);
+    auto cachedWitness = IGF.Builder.CreateLoad(witnessSlot);
+    auto hitWitness =
+        IGF.Builder.CreateBitCast(cachedWitness, IGM.WitnessTablePtrTy);
+    IGF.Builder.CreateBr(contBB);
+
+    // Otherwise ask the runtime and, on success, try to remember the answer.
+    IGF.Builder.emitBlock(missBB);
     auto witness = IGF.Builder.CreateCall(conformsToProtocol, {ref, proto});
     auto isNull = IGF.Builder.CreateICmpEQ(witness,
                      llvm::ConstantPointerNull::get(IGM.WitnessTablePtrTy));
-    auto contBB = IGF.createBasicBlock("cont");
-    IGF.Builder.CreateCondBr(isNull, failBB, contBB);
-    
+    auto storeBB = IGF.createBasicBlock("cacheStore");
+    IGF.Builder.CreateCondBr(isNull, failBB, storeBB);
+
+    // The entry is written at most once: claim the witness slot with a
+    // compare-and-swap and let only the winning thread publish the type.
+    // With plain stores, two threads caching different types could
+    // interleave so that one thread's type ends up paired with the other
+    // thread's witness table.
+    IGF.Builder.emitBlock(storeBB);
+    auto witnessInt = IGF.Builder.CreatePtrToInt(witness, IGM.IntPtrTy);
+    auto witnessSlotInt = IGF.Builder.CreateBitCast(
+        witnessSlot.getAddress(), IGM.IntPtrTy->getPointerTo());
+    auto claim = IGF.Builder.CreateAtomicCmpXchg(
+        witnessSlotInt, llvm::ConstantInt::get(IGM.IntPtrTy, 0), witnessInt,
+        llvm::AtomicOrdering::Monotonic, llvm::AtomicOrdering::Monotonic);
+    auto won = IGF.Builder.CreateExtractValue(claim, 1);
+    auto publishBB = IGF.createBasicBlock("cachePublish");
+    IGF.Builder.CreateCondBr(won, publishBB, contBB);
+
+    // Publish the type after the witness table it belongs to.  A losing
+    // thread leaves the winner's entry alone and skips caching.
+    IGF.Builder.emitBlock(publishBB);
+    auto typeStore = IGF.Builder.CreateStore(refInt8, typeSlot);
+    typeStore->setAtomic(llvm::AtomicOrdering::Release);
+    IGF.Builder.CreateBr(contBB);
+
     IGF.Builder.emitBlock(contBB);
-    rets.add(witness);
+    auto phi = IGF.Builder.CreatePHI(IGM.WitnessTablePtrTy, 3);
+    phi->addIncoming(hitWitness, hitBB);
+    phi->addIncoming(witness, storeBB);
+    phi->addIncoming(witness, publishBB);
+    rets.add(phi);
   }
   
   // If we succeeded, return the witnesses.
@@ -641,6 +708,20 @@ void irgen::emitScalarExistentialDowncast(IRGenFunction &IGF,
   args.push_back(resultValue);
 
   args.push_back(metadataValue);
+
+  // Allocate an inline cache for this call site. It remembers the source
+  // type of the last successful cast together with the witness tables the
+  // conformance lookup produced for it.
+  auto cacheTy = llvm::ArrayType::get(IGF.IGM.Int8PtrTy,
+                                      2 * witnessTableProtos.size());
+  auto cache = new llvm::GlobalVariable(IGF.IGM.Module, cacheTy,
+                                        /*constant*/ false,
+                                        llvm::GlobalValue::PrivateLinkage,
+                                        llvm::ConstantAggregateZero::get(cacheTy),
+                                        "dynamic_cast_existential_cache");
+  cache->setAlignment(IGF.IGM.getPointerAlignment().getValue());
+  args.push_back(IGF.Builder.CreateBitCast(cache, IGF.IGM.Int8PtrPtrTy));
+
   for (auto proto : witnessTableProtos)
     args.push_back(proto);
 
@@ -22,6 +22,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/ProfileData/CoverageMappingWriter.h"
+#include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/Support/FileSystem.h"
 
 using namespace swift;
@@ -135,3 +136,35 @@ void IRGenModule::emitCoverageMapping() {
 
   addUsedGlobal(CovData);
 }
+
+/// Load the profile named by -vtable-layout-profile and return the entry
+/// counts it records, keyed by SIL function name, or null if no usable
+/// profile was given.
+const llvm::StringMap<uint64_t> *IRGenModule::getVTableLayoutProfileCounts() {
+  if (Opts.VTableLayoutProfilePath.empty())
+    return nullptr;
+
+  if (!VTableLayoutProfileLoaded) {
+    VTableLayoutProfileLoaded = true;
+    auto ReaderOrErr =
+        llvm::IndexedInstrProfReader::create(Opts.VTableLayoutProfilePath);
+    if (std::error_code EC = ReaderOrErr.getError()) {
+      error(SourceLoc(), "cannot read profile data from '" +
+                             Opts.VTableLayoutProfilePath + "': " +
+                             EC.message());
+      return nullptr;
+    }
+    for (const auto &Record : *ReaderOrErr.get()) {
+      if (Record.Counts.empty())
+        continue;
+      // The first counter of a function is its entry count.  If a name
+      // occurs in several records, keep the hottest one.
+      uint64_t &Count = VTableLayoutProfileCounts[Record.Name];
+      Count = std::max(Count, Record.Counts[0]);
+    }
+  }
+
+  if (VTableLayoutProfileCounts.empty())
+    return nullptr;
+  return &VTableLayoutProfileCounts;
+}
@@ -27,6 +27,7 @@
 #include "swift/AST/TypeMemberVisitor.h"
 #include "swift/AST/Types.h"
 #include "swift/Basic/Fallthrough.h"
+#include "swift/Basic/Unicode.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/SIL/FormalLinkage.h"
 #include "swift/SIL/SILDebugScope.h"
@@ -37,7 +38,6 @@
 #include "llvm/IR/GlobalAlias.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Path.h"
-#include "llvm/Support/ConvertUTF.h"
 
 #include "CallingConvention.h"
 #include "Explosion.h"
@@ -2541,6 +2541,20 @@ llvm::Constant *IRGenModule::getAddrOfGlobalString(StringRef data) {
   return address;
 }
 
+/// Get or create a global string constant holding the mangled name of
+/// the given type.
+///
+/// The same types are referenced over and over while emitting metadata,
+/// so cache the mangling itself in addition to the string global.
+llvm::Constant *IRGenModule::getAddrOfMangledTypeName(CanType type) {
+  auto &entry = MangledTypeNames[type];
+  if (entry) return entry;
+
+  llvm::SmallString<32> mangling;
+  entry = getAddrOfGlobalString(mangleType(type, mangling));
+  return entry;
+}
+
 /// Get or create a global UTF-16 string constant.
 ///
 /// \returns an i16* with a null terminator; note that embedded nulls
@@ -2551,19 +2565,14 @@ llvm::Constant *IRGenModule::getAddrOfGlobalUTF16String(StringRef utf8) {
   if (entry) return entry;
 
   // If not, first transcode it to UTF16.
-  SmallVector<UTF16, 128> buffer(utf8.size() + 1); // +1 for ending nulls.
-  const UTF8 *fromPtr = (const UTF8 *) utf8.data();
-  UTF16 *toPtr = &buffer[0];
-  (void) ConvertUTF8toUTF16(&fromPtr, fromPtr + utf8.size(),
-                            &toPtr, toPtr + utf8.size(),
-                            strictConversion);
-
-  // The length of the transcoded string in UTF-8 code points.
-  size_t utf16Length = toPtr - &buffer[0];
+  SmallVector<uint16_t, 128> buffer;
+  bool transcoded = swift::unicode::convertUTF8ToUTF16(utf8, buffer);
+  assert(transcoded && "cannot transcode UTF-8 string to UTF-16");
+  (void) transcoded;
 
   // Null-terminate the UTF-16 string.
-  *toPtr = 0;
-  ArrayRef<UTF16> utf16(&buffer[0], utf16Length + 1);
+  buffer.push_back(0);
+  ArrayRef<uint16_t> utf16(buffer.data(), buffer.size());
 
   auto init = llvm::ConstantDataArray::get(LLVMContext, utf16);
   auto global = new llvm::GlobalVariable(Module, init->getType(), true,
@@ -2669,7 +2678,13 @@ IRGenModule::getAddrOfWitnessTableLazyCacheVariable(
 /// Look up the address of a witness table.
 ///
 /// TODO: This needs to take a flag for the access mode of the witness table,
-/// which may be direct, lazy, or a runtime instantiation template.
+/// which may be direct, lazy, or a runtime instantiation template. A runtime
+/// instantiation template would emit the table as position-independent
+/// relative pointers instantiated on first use through a MetadataCache-style
+/// runtime entry point, so witness tables stop contributing to dyld's rebase
+/// and bind workload at launch. That is an ABI change to the table format and
+/// the conformance records that reference it, so it has to be done in lock
+/// step with the runtime rather than in IRGen alone.
 /// TODO: Use name from witness table here to lookup witness table instead of
 /// recomputing it.
 llvm::Constant*
@@ -3181,40 +3181,54 @@ namespace {
       // Switch over the no-payload cases.
       unsigned casesPerTag = getNumCasesPerTag();
 
+      auto occupiedBits = CommonSpareBits;
+      occupiedBits.flipAll();
+
       auto elti = ElementsWithNoPayload.begin(),
            eltEnd = ElementsWithNoPayload.end();
 
       for (unsigned i = 0; i < NumEmptyElementTags; ++i) {
         assert(elti != eltEnd &&
                "ran out of cases before running out of extra tags?");
-        
+
         auto tagVal = llvm::ConstantInt::get(C, APInt(numTagBits, tagIndex));
-        
+
         // If the payload is empty, there's only one case per tag.
         if (CommonSpareBits.size() == 0) {
           tagSwitch->addCase(tagVal, blockForCase(elti->decl));
-        
+
           ++elti;
           ++tagIndex;
           continue;
         }
-        
+
+        // If there's only one case left for this tag, we can jump to it
+        // directly, without inspecting the payload.
+        if (casesPerTag == 1 || elti + 1 == eltEnd) {
+          tagSwitch->addCase(tagVal, blockForCase(elti->decl));
+
+          ++elti;
+          ++tagIndex;
+          continue;
+        }
+
         auto *tagBB = llvm::BasicBlock::Create(C);
         tagSwitch->addCase(tagVal, tagBB);
 
-        // Switch over the cases for this tag.
+        // Switch over the cases for this tag. The case index is scattered
+        // across the occupied payload bits, so gather it into a contiguous
+        // value first; the resulting switch then has dense case values
+        // starting at zero, which LLVM can lower to a jump table.
         IGF.Builder.emitBlock(tagBB);
-        SmallVector<std::pair<APInt, llvm::BasicBlock *>, 4> cases;
-        
+        llvm::Value *caseIndex
+          = parts.payload.emitGatherSpareBits(IGF, occupiedBits, 0, 32);
+
+        auto *caseSwitch = IGF.Builder.CreateSwitch(caseIndex, unreachableBB);
         for (unsigned idx = 0; idx < casesPerTag && elti != eltEnd; ++idx) {
-          auto val = getEmptyCasePayload(IGF.IGM, tagIndex, idx);
-          cases.push_back({val, blockForCase(elti->decl)});
+          caseSwitch->addCase(llvm::ConstantInt::get(C, APInt(32, idx)),
+                              blockForCase(elti->decl));
           ++elti;
         }
-
-        parts.payload.emitSwitch(IGF, APInt::getAllOnesValue(PayloadBitCount),
-                               cases,
-                               SwitchDefaultDest(unreachableBB, IsUnreachable));
         ++tagIndex;
       }
 
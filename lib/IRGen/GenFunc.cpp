@@ -2240,10 +2240,15 @@ if (Builtin.ID == BuiltinValueKind::id) { \
     if (auto ExpectedPred = IGF.IGM.TargetInfo.OnceDonePredicateValue) {
       auto PredValue = IGF.Builder.CreateLoad(PredPtr,
                                               IGF.IGM.getPointerAlignment());
+      // If the runtime publishes the done state with only a release store,
+      // this check must be the pairing acquire load, or the guarded data
+      // may be read before it is seen initialized.
+      if (IGF.IGM.TargetInfo.OnceDonePredicateNeedsAcquire)
+        PredValue->setAtomic(llvm::AtomicOrdering::Acquire);
       auto ExpectedPredValue = llvm::ConstantInt::getSigned(IGF.IGM.OnceTy,
                                                             *ExpectedPred);
       auto PredIsDone = IGF.Builder.CreateICmpEQ(PredValue, ExpectedPredValue);
-      
+
       notDoneBB = IGF.createBasicBlock("once_not_done");
       doneBB = IGF.createBasicBlock("once_done");
       
@@ -1095,6 +1095,51 @@ void IRGenFunction::emitNativeStrongRelease(llvm::Value *value) {
   emitUnaryRefCountCall(*this, IGM.getNativeStrongReleaseFn(), value);
 }
 
+/// Emit a call to swift_retain_n, performing \p count retains with one
+/// atomic operation.
+void IRGenFunction::emitNativeStrongRetainN(llvm::Value *value,
+                                            unsigned count) {
+  if (doesNotRequireRefCounting(value)) return;
+
+  if (value->getType() != IGM.RefCountedPtrTy)
+    value = Builder.CreateBitCast(value, IGM.RefCountedPtrTy);
+
+  auto *n = llvm::ConstantInt::get(IGM.Int32Ty, count);
+  llvm::CallInst *call =
+    Builder.CreateCall(IGM.getNativeStrongRetainNFn(), {value, n});
+  call->setCallingConv(IGM.RuntimeCC);
+  call->setDoesNotThrow();
+}
+
+/// Emit a call to swift_release_n, performing \p count releases with one
+/// atomic operation.
+void IRGenFunction::emitNativeStrongReleaseN(llvm::Value *value,
+                                             unsigned count) {
+  if (doesNotRequireRefCounting(value)) return;
+
+  if (value->getType() != IGM.RefCountedPtrTy)
+    value = Builder.CreateBitCast(value, IGM.RefCountedPtrTy);
+
+  auto *n = llvm::ConstantInt::get(IGM.Int32Ty, count);
+  llvm::CallInst *call =
+    Builder.CreateCall(IGM.getNativeStrongReleaseNFn(), {value, n});
+  call->setCallingConv(IGM.RuntimeCC);
+  call->setDoesNotThrow();
+}
+
+/// Emit a call to swift_nonatomic_retain. The caller has proved that the
+/// object never escapes its allocating thread.
+void IRGenFunction::emitNativeNonAtomicStrongRetain(llvm::Value *value) {
+  if (doesNotRequireRefCounting(value)) return;
+  emitUnaryRefCountCall(*this, IGM.getNativeNonAtomicStrongRetainFn(), value);
+}
+
+/// Emit a call to swift_nonatomic_release.
+void IRGenFunction::emitNativeNonAtomicStrongRelease(llvm::Value *value) {
+  if (doesNotRequireRefCounting(value)) return;
+  emitUnaryRefCountCall(*this, IGM.getNativeNonAtomicStrongReleaseFn(), value);
+}
+
 void IRGenFunction::emitNativeUnownedInit(llvm::Value *value,
                                           Address dest) {
   dest = Builder.CreateStructGEP(dest, 0, Size(0));
@@ -80,10 +80,7 @@ static Address createPointerSizedGEP(IRGenFunction &IGF,
 }
 
 static llvm::Constant *getMangledTypeName(IRGenModule &IGM, CanType type) {
-  auto name = LinkEntity::forTypeMangling(type);
-  llvm::SmallString<32> mangling;
-  name.mangle(mangling);
-  return IGM.getAddrOfGlobalString(mangling);
+  return IGM.getAddrOfMangledTypeName(type);
 }
 
 llvm::Value *irgen::emitObjCMetadataRefForMetadata(IRGenFunction &IGF,
@@ -2912,6 +2909,7 @@ namespace {
 
     bool HasRuntimeBase = false;
     bool HasRuntimeParent = false;
+    bool HasRuntimeAdjustedSlot = false;
   public:
     /// The 'metadata flags' field in a class is actually a pointer to
     /// the metaclass object for the class.
@@ -3067,9 +3065,10 @@ namespace {
       } else {
         // Leave a zero placeholder to be filled at runtime
         addConstantInt32(0);
+        HasRuntimeAdjustedSlot = true;
       }
     }
-    
+
     void addInstanceAlignMask() {
       if (llvm::Constant *align
             = tryEmitClassConstantFragileInstanceAlignMask(IGM, Target)) {
@@ -3079,6 +3078,7 @@ namespace {
       } else {
         // Leave a zero placeholder to be filled at runtime
         addConstantInt16(0);
+        HasRuntimeAdjustedSlot = true;
       }
     }
 
@@ -3127,8 +3127,10 @@ namespace {
       if (auto offset = tryEmitClassConstantFragileFieldOffset(IGM,Target,var))
         addWord(offset);
       // Otherwise, leave a placeholder for the runtime to populate at runtime.
-      else
+      else {
         addWord(llvm::ConstantInt::get(IGM.IntPtrTy, 0));
+        HasRuntimeAdjustedSlot = true;
+      }
     }
 
     void addMethod(SILDeclRef fn) {
@@ -3157,16 +3159,27 @@ namespace {
 
     void addGenericArgument(ArchetypeType *archetype, ClassDecl *forClass) {
       addWord(llvm::Constant::getNullValue(IGM.TypeMetadataPtrTy));
+      HasRuntimeAdjustedSlot = true;
     }
 
     void addGenericWitnessTable(ArchetypeType *archetype,
                                 ProtocolDecl *protocol, ClassDecl *forClass) {
       addWord(llvm::Constant::getNullValue(IGM.WitnessTablePtrTy));
+      HasRuntimeAdjustedSlot = true;
     }
-    
+
     bool hasRuntimeBase() const {
       return HasRuntimeBase;
     }
+
+    /// True if the metadata contains no slots that are filled in or
+    /// rewritten after emission, so the global can live in a read-only
+    /// section.  ObjC interop always disqualifies a class: realization
+    /// updates the superclass, cache and data fields in place.
+    bool canBeConstant() const {
+      return !IGM.ObjCInterop &&
+             !HasRuntimeBase && !HasRuntimeParent && !HasRuntimeAdjustedSlot;
+    }
   };
 
   class ClassMetadataBuilder :
@@ -3628,18 +3641,21 @@ void irgen::emitClassMetadata(IRGenModule &IGM, ClassDecl *classDecl,
   // TODO: classes nested within generic types
   llvm::Constant *init;
   bool isPattern;
+  bool canBeConstant;
   bool hasRuntimeBase;
   if (classDecl->isGenericContext()) {
     GenericClassMetadataBuilder builder(IGM, classDecl, layout);
     builder.layout();
     init = builder.getInit();
     isPattern = true;
+    canBeConstant = false;
     hasRuntimeBase = builder.hasRuntimeBase();
   } else {
     ClassMetadataBuilder builder(IGM, classDecl, layout);
     builder.layout();
     init = builder.getInit();
     isPattern = false;
+    canBeConstant = builder.canBeConstant();
     hasRuntimeBase = builder.hasRuntimeBase();
   }
 
@@ -3655,11 +3671,7 @@ void irgen::emitClassMetadata(IRGenModule &IGM, ClassDecl *classDecl,
     section = "__DATA,__objc_data, regular";
 
   auto var = IGM.defineTypeMetadata(declaredType, isIndirect, isPattern,
-               // TODO: the metadata global can actually be constant in a very
-               // special case: it's not a pattern, ObjC interoperation isn't
-               // required, there are no class fields, and there is nothing that
-               // needs to be runtime-adjusted.
-               /*isConstant*/ false, init, section);
+                                    canBeConstant, init, section);
 
   // Add non-generic classes to the ObjC class list.
   if (IGM.ObjCInterop && !isPattern && !isIndirect && !hasRuntimeBase) {    
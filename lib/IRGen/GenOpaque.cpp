@@ -21,11 +21,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/IR/DerivedTypes.h"
 
+#include "Explosion.h"
 #include "IRGenFunction.h"
 #include "IRGenModule.h"
+#include "LoadableTypeInfo.h"
 #include "ProtocolInfo.h"
 #include "ValueWitness.h"
 
@@ -774,3 +777,133 @@ llvm::Value *irgen::emitLoadOfExtraInhabitantCount(IRGenFunction &IGF,
   return IGF.Builder.CreateAnd(xiFlags, mask,
                                xiFlags->getName() + ".extraInhabitantCount");
 }
+
+//===----------------------------------------------------------------------===//
+// Outlined copy/destroy helpers
+//===----------------------------------------------------------------------===//
+
+/// The minimal number of scalar components of an aggregate before its
+/// copy/destroy sequences are outlined into shared helper functions.
+/// A value of 0 disables outlining.
+static llvm::cl::opt<unsigned> CopyDestroyOutlineLimit(
+    "irgen-outline-copy-limit", llvm::cl::init(8),
+    llvm::cl::desc("Minimal number of scalar components of an aggregate "
+                   "before its copy/destroy sequences are outlined"));
+
+/// Returns true if the inline copy/destroy sequence for \p ti should be
+/// replaced by a call to an outlined helper function.
+///
+/// Only concrete fixed-layout loadable aggregates are outlined: those are
+/// the types whose per-field sequences get big, and a unique helper name
+/// can be mangled from the type.
+static bool shouldOutlineCopyDestroy(IRGenFunction &IGF, const TypeInfo &ti,
+                                     SILType T) {
+  if (CopyDestroyOutlineLimit == 0)
+    return false;
+
+  // Don't outline the body of an outlined helper again.
+  if (IGF.IsOutlinedCopyDestroyHelper)
+    return false;
+
+  auto *loadableTI = dyn_cast<LoadableTypeInfo>(&ti);
+  if (!loadableTI)
+    return false;
+
+  // POD sequences degenerate to a memcpy anyway.
+  if (loadableTI->isPOD(ResilienceScope::Component))
+    return false;
+
+  // The helper is keyed on the mangled type name, so the type must be
+  // concrete.
+  if (T.hasArchetype())
+    return false;
+
+  ExplosionSchema schema = loadableTI->getSchema();
+  return schema.size() >= CopyDestroyOutlineLimit;
+}
+
+/// Get or create the outlined helper for one (type, operation) pair. The
+/// helper takes \p numArgs pointers to the type's storage type and performs
+/// \p generate on them. It is emitted with linkonce_odr linkage, so
+/// identical helpers from different translation units are merged by the
+/// linker.
+static llvm::Constant *
+getOrCreateOutlinedHelper(IRGenModule &IGM, StringRef opName, SILType T,
+                          const TypeInfo &ti, unsigned numArgs,
+                llvm::function_ref<void(IRGenFunction &IGF,
+                                        ArrayRef<Address> args)> generate) {
+  llvm::SmallString<32> mangledName;
+  IGM.mangleType(T.getSwiftRValueType(), mangledName);
+
+  llvm::SmallString<64> fnName;
+  fnName += "__swift_outlined_";
+  fnName += opName;
+  fnName += "_";
+  fnName += mangledName;
+
+  llvm::Type *ptrTy = ti.getStorageType()->getPointerTo();
+  llvm::SmallVector<llvm::Type *, 2> argTys(numArgs, ptrTy);
+
+  return IGM.getOrCreateHelperFunction(fnName, IGM.VoidTy, argTys,
+    [&](IRGenFunction &IGF) {
+      IGF.IsOutlinedCopyDestroyHelper = true;
+      Explosion params = IGF.collectParameters();
+      llvm::SmallVector<Address, 2> args;
+      for (unsigned i = 0; i != numArgs; ++i)
+        args.push_back(ti.getAddressForPointer(params.claimNext()));
+      generate(IGF, args);
+      IGF.Builder.CreateRetVoid();
+    });
+}
+
+/// Emit a call to an outlined helper with the given addresses as arguments.
+static void emitOutlinedHelperCall(IRGenFunction &IGF, llvm::Constant *fn,
+                                   ArrayRef<Address> args) {
+  llvm::SmallVector<llvm::Value *, 2> argValues;
+  for (Address arg : args)
+    argValues.push_back(arg.getAddress());
+  IGF.Builder.CreateCall(fn, argValues);
+}
+
+bool irgen::tryEmitOutlinedAssignWithCopy(IRGenFunction &IGF,
+                                          const TypeInfo &ti,
+                                          Address dest, Address src,
+                                          SILType T) {
+  if (!shouldOutlineCopyDestroy(IGF, ti, T))
+    return false;
+
+  auto fn = getOrCreateOutlinedHelper(IGF.IGM, "assignWithCopy", T, ti, 2,
+    [&](IRGenFunction &IGF, ArrayRef<Address> args) {
+      ti.assignWithCopy(IGF, args[0], args[1], T);
+    });
+  emitOutlinedHelperCall(IGF, fn, {dest, src});
+  return true;
+}
+
+bool irgen::tryEmitOutlinedInitializeWithCopy(IRGenFunction &IGF,
+                                              const TypeInfo &ti,
+                                              Address dest, Address src,
+                                              SILType T) {
+  if (!shouldOutlineCopyDestroy(IGF, ti, T))
+    return false;
+
+  auto fn = getOrCreateOutlinedHelper(IGF.IGM, "initWithCopy", T, ti, 2,
+    [&](IRGenFunction &IGF, ArrayRef<Address> args) {
+      ti.initializeWithCopy(IGF, args[0], args[1], T);
+    });
+  emitOutlinedHelperCall(IGF, fn, {dest, src});
+  return true;
+}
+
+bool irgen::tryEmitOutlinedDestroy(IRGenFunction &IGF, const TypeInfo &ti,
+                                   Address addr, SILType T) {
+  if (!shouldOutlineCopyDestroy(IGF, ti, T))
+    return false;
+
+  auto fn = getOrCreateOutlinedHelper(IGF.IGM, "destroy", T, ti, 1,
+    [&](IRGenFunction &IGF, ArrayRef<Address> args) {
+      ti.destroy(IGF, args[0], T);
+    });
+  emitOutlinedHelperCall(IGF, fn, {addr});
+  return true;
+}
@@ -27,6 +27,7 @@ namespace swift {
 namespace irgen {
   class Address;
   class IRGenFunction;
+  class TypeInfo;
   class IRGenModule;
   enum class ValueWitness : unsigned;
   class WitnessIndex;
@@ -209,6 +210,21 @@ namespace irgen {
   /// The type must be dynamically known to have extra inhabitant witnesses.
   llvm::Value *emitLoadOfExtraInhabitantCount(IRGenFunction &IGF, SILType T);
 
+  /// If profitable, emit an 'assignWithCopy' operation as a call to a
+  /// shared outlined helper for the type, and return true. Returns false
+  /// if the operation should be emitted inline.
+  bool tryEmitOutlinedAssignWithCopy(IRGenFunction &IGF, const TypeInfo &ti,
+                                     Address dest, Address src, SILType T);
+
+  /// Same as above, for 'initializeWithCopy'.
+  bool tryEmitOutlinedInitializeWithCopy(IRGenFunction &IGF,
+                                         const TypeInfo &ti,
+                                         Address dest, Address src, SILType T);
+
+  /// Same as above, for 'destroy'.
+  bool tryEmitOutlinedDestroy(IRGenFunction &IGF, const TypeInfo &ti,
+                              Address addr, SILType T);
+
 } // end namespace irgen
 } // end namespace swift
 
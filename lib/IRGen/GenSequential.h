@@ -22,6 +22,7 @@
 #include "IRGenModule.h"
 #include "Explosion.h"
 #include "GenEnum.h"
+#include "GenOpaque.h"
 #include "LoadableTypeInfo.h"
 #include "TypeInfo.h"
 #include "StructLayout.h"
@@ -134,6 +135,10 @@ public:
 
   void assignWithCopy(IRGenFunction &IGF, Address dest,
                       Address src, SILType T) const override {
+    // Big per-field sequences are outlined into a shared helper.
+    if (tryEmitOutlinedAssignWithCopy(IGF, *this, dest, src, T))
+      return;
+
     auto offsets = asImpl().getNonFixedOffsets(IGF, T);
     for (auto &field : getFields()) {
       if (field.isEmpty()) continue;
@@ -168,6 +173,10 @@ public:
                LoadableTypeInfo::initializeWithCopy(IGF, dest, src, T);
     }
 
+    // Big per-field sequences are outlined into a shared helper.
+    if (tryEmitOutlinedInitializeWithCopy(IGF, *this, dest, src, T))
+      return;
+
     auto offsets = asImpl().getNonFixedOffsets(IGF, T);
     for (auto &field : getFields()) {
       if (field.isEmpty()) continue;
@@ -202,6 +211,10 @@ public:
   }
 
   void destroy(IRGenFunction &IGF, Address addr, SILType T) const override {
+    // Big per-field sequences are outlined into a shared helper.
+    if (tryEmitOutlinedDestroy(IGF, *this, addr, T))
+      return;
+
     auto offsets = asImpl().getNonFixedOffsets(IGF, T);
     for (auto &field : getFields()) {
       if (field.isPOD()) continue;
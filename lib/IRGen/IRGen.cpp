@@ -81,6 +81,12 @@ static void addSwiftStackPromotionPass(const PassManagerBuilder &Builder,
     PM.add(createSwiftStackPromotionPass());
 }
 
+static void addSwiftMergeFunctionsPass(const PassManagerBuilder &Builder,
+                                       PassManagerBase &PM) {
+  if (Builder.OptLevel > 0)
+    PM.add(createSwiftMergeFunctionsPass());
+}
+
 // FIXME: Copied from clang/lib/CodeGen/CGObjCMac.cpp. 
 // These should be moved to a single definition shared by clang and swift.
 enum ImageInfoFlags {
@@ -138,6 +144,12 @@ void swift::performLLVMOptimizations(IRGenOptions &Opts, llvm::Module *Module,
   PMBuilder.addExtension(PassManagerBuilder::EP_ModuleOptimizerEarly,
                          addSwiftStackPromotionPass);
 
+  // Fold exact duplicates at the very end of the pipeline. This catches most
+  // of the identical thunks and value witnesses with a cheap hash-bucketed
+  // comparison before the code generator has to compile them.
+  PMBuilder.addExtension(PassManagerBuilder::EP_OptimizerLast,
+                         addSwiftMergeFunctionsPass);
+
   // If the optimizer is enabled, we run the ARCOpt pass in the scalar optimizer
   // and the Contract pass as late as possible.
   if (!Opts.DisableLLVMARCOpts) {
@@ -633,10 +645,28 @@ static void performParallelIRGeneration(IRGenOptions &Opts,
     }
   }
 
-  for (auto it = dispatcher.begin(); it != dispatcher.end(); ++it) {
-    IRGenModule *IGM = it->second;
+  // Bail out if there are any errors.
+  if (Ctx.hadError()) return;
+
+  // Compile the largest modules first, so that a big module is not
+  // scheduled as the last piece of work while other threads sit idle.
+  dispatcher.sortQueueBySize();
+
+  std::vector<std::thread> Threads;
+  llvm::sys::Mutex DiagMutex;
+
+  // Start the compilation threads now. Each module is handed to them as
+  // soon as it is finalized below, so the LLVM pipelines of the first
+  // modules already run while the remaining modules are still being
+  // finalized.
+  for (int ThreadIdx = 1; ThreadIdx < numThreads; ++ThreadIdx) {
+    Threads.push_back(std::thread(ThreadEntryPoint, &dispatcher, &DiagMutex,
+                                  ThreadIdx));
+  }
+
+  for (IRGenModule *IGM : dispatcher.getQueue()) {
     llvm::Module *M = IGM->getModule();
-    
+
     // Update the linkage of shared functions/globals.
     // If a shared function/global is referenced from another file it must have
     // weak instead of linkonce linkage. Otherwise LLVM would remove the
@@ -657,18 +687,9 @@ static void performParallelIRGeneration(IRGenOptions &Opts,
 
     IGM->finalize();
     setModuleFlags(*IGM);
-  }
 
-  // Bail out if there are any errors.
-  if (Ctx.hadError()) return;
-
-  std::vector<std::thread> Threads;
-  llvm::sys::Mutex DiagMutex;
-
-  // Start all the threads an do the LLVM compilation.
-  for (int ThreadIdx = 1; ThreadIdx < numThreads; ++ThreadIdx) {
-    Threads.push_back(std::thread(ThreadEntryPoint, &dispatcher, &DiagMutex,
-                                  ThreadIdx));
+    // The module's IR is complete: hand it to the compilation threads.
+    dispatcher.moduleIsReady();
   }
 
   ThreadEntryPoint(&dispatcher, &DiagMutex, 0);
@@ -1868,6 +1868,9 @@ llvm::DIType *IRGenDebugInfo::getOrCreateType(DebugTypeInfo DbgTy) {
     UID = llvm::MDString::get(IGM.getLLVMContext(), MangledName);
     if (llvm::Metadata *CachedTy = DIRefMap.lookup(UID)) {
       auto DITy = cast<llvm::DIType>(CachedTy);
+      // Remember the result for this particular TypeBase pointer as well,
+      // so the next query through it doesn't have to mangle the name again.
+      DITypeCache.insert({DbgTy.getType(), llvm::TrackingMDNodeRef(DITy)});
       return DITy;
     }
   }
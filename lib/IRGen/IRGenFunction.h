@@ -116,6 +116,11 @@ public:
 
   llvm::Function *CurFn;
 
+  /// True if this function is an outlined copy/destroy helper. The value
+  /// operations emitted into such a helper must not try to outline
+  /// themselves again.
+  bool IsOutlinedCopyDestroyHelper = false;
+
   IRGenFunction(IRGenModule &IGM, llvm::Function *fn,
                 const SILDebugScope *DbgScope = nullptr,
                 Optional<SILLocation> DbgLoc = None);
@@ -313,6 +318,10 @@ public:
   void emitNativeStrongInit(llvm::Value *value, Address addr);
   void emitNativeStrongRetain(llvm::Value *value);
   void emitNativeStrongRelease(llvm::Value *value);
+  void emitNativeStrongRetainN(llvm::Value *value, unsigned count);
+  void emitNativeStrongReleaseN(llvm::Value *value, unsigned count);
+  void emitNativeNonAtomicStrongRetain(llvm::Value *value);
+  void emitNativeNonAtomicStrongRelease(llvm::Value *value);
   //   - unowned references
   void emitNativeUnownedRetain(llvm::Value *value);
   void emitNativeUnownedRelease(llvm::Value *value);
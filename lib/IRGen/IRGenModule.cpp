@@ -814,6 +814,28 @@ void IRGenModuleDispatcher::addGenModule(SourceFile *SF, IRGenModule *IGM) {
   Queue.push_back(IGM);
 }
 
+void IRGenModuleDispatcher::sortQueueBySize() {
+  // The number of instructions in a module is a reasonable proxy for the
+  // time its LLVM pipeline will take. Compiling the largest modules first
+  // keeps the last-finished thread from being handed the long pole.
+  auto instructionCount = [](IRGenModule *IGM) -> unsigned {
+    unsigned count = 0;
+    for (llvm::Function &F : IGM->getModule()->getFunctionList())
+      for (llvm::BasicBlock &BB : F)
+        count += BB.size();
+    return count;
+  };
+
+  llvm::DenseMap<IRGenModule *, unsigned> sizes;
+  for (IRGenModule *IGM : Queue)
+    sizes[IGM] = instructionCount(IGM);
+
+  std::stable_sort(Queue.begin(), Queue.end(),
+                   [&sizes](IRGenModule *lhs, IRGenModule *rhs) {
+    return sizes[lhs] > sizes[rhs];
+  });
+}
+
 IRGenModule *IRGenModuleDispatcher::getGenModule(DeclContext *ctxt) {
   if (GenModules.size() == 1 || !ctxt) {
     return getPrimaryIGM();
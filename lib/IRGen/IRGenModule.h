@@ -37,6 +37,8 @@
 #include "ValueWitness.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace llvm {
   class Constant;
@@ -237,13 +239,40 @@ public:
     return it->second;
   }
   
-  /// In multi-threaded compilation fetch the next IRGenModule from the queue.
+  /// In multi-threaded compilation, order the queue so that the largest
+  /// modules are compiled first. Should be called after IR generation is
+  /// complete and before the compilation threads are started, so that the
+  /// longest-running LLVM pipelines are not scheduled last.
+  void sortQueueBySize();
+
+  /// Returns the queue of IRGenModules for multi-threaded compilation, in
+  /// the order in which they are handed to the compilation threads.
+  ArrayRef<IRGenModule *> getQueue() const { return Queue; }
+
+  /// In multi-threaded compilation fetch the next IRGenModule from the
+  /// queue. Blocks until the module is marked as ready for compilation
+  /// (see moduleIsReady). Returns null if all modules have been fetched.
   IRGenModule *fetchFromQueue() {
     int idx = QueueIndex++;
-    if (idx < (int)Queue.size()) {
-      return Queue[idx];
+    if (idx >= (int)Queue.size())
+      return nullptr;
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    QueueCond.wait(lock, [&] { return idx < NumModulesReady; });
+    return Queue[idx];
+  }
+
+  /// Mark the next module in the queue as ready for compilation.
+  ///
+  /// Called after the module's IR is complete and finalized. This lets the
+  /// compilation threads start on the first modules while the remaining
+  /// modules are still being finalized.
+  void moduleIsReady() {
+    {
+      std::lock_guard<std::mutex> lock(QueueMutex);
+      ++NumModulesReady;
+      assert(NumModulesReady <= (int)Queue.size());
     }
-    return nullptr;
+    QueueCond.notify_all();
   }
 
 private:
@@ -288,7 +317,14 @@ private:
   SmallVector<IRGenModule *, 8> Queue;
 
   std::atomic<int> QueueIndex;
-  
+
+  /// Guards NumModulesReady.
+  std::mutex QueueMutex;
+  std::condition_variable QueueCond;
+
+  /// The number of modules in the queue which are ready for compilation.
+  int NumModulesReady = 0;
+
   friend class CurrentIGMPtr;
 };
 
@@ -522,6 +558,7 @@ private:
 public:
   llvm::Constant *getAddrOfGlobalString(StringRef utf8);
   llvm::Constant *getAddrOfGlobalUTF16String(StringRef utf8);
+  llvm::Constant *getAddrOfMangledTypeName(CanType type);
   llvm::Constant *getAddrOfObjCSelectorRef(StringRef selector);
   llvm::Constant *getAddrOfObjCMethodName(StringRef methodName);
   llvm::Constant *getAddrOfObjCProtocolRecord(ProtocolDecl *proto,
@@ -549,6 +586,7 @@ private:
   llvm::DenseSet<const clang::Decl *> GlobalClangDecls;
   llvm::StringMap<llvm::Constant*> GlobalStrings;
   llvm::StringMap<llvm::Constant*> GlobalUTF16Strings;
+  llvm::DenseMap<CanType, llvm::Constant*> MangledTypeNames;
   llvm::StringMap<llvm::Constant*> ObjCSelectorRefs;
   llvm::StringMap<llvm::Constant*> ObjCMethodNames;
 
@@ -605,6 +643,11 @@ private:
   /// created for the SIL functions with those orders.
   SuccessorMap<unsigned, llvm::Function*> EmittedFunctionsByOrder;
 
+  /// Entry counts from the profile named by -vtable-layout-profile,
+  /// keyed by SIL function name.  Loaded lazily.
+  llvm::StringMap<uint64_t> VTableLayoutProfileCounts;
+  bool VTableLayoutProfileLoaded = false;
+
   ObjCProtocolPair getObjCProtocolGlobalVars(ProtocolDecl *proto);
   void emitLazyObjCProtocolDefinitions();
   void emitLazyObjCProtocolDefinition(ProtocolDecl *proto);
@@ -676,6 +719,7 @@ public:
   void emitExtension(ExtensionDecl *D);
   Address emitSILGlobalVariable(SILGlobalVariable *gv);
   void emitCoverageMapping();
+  const llvm::StringMap<uint64_t> *getVTableLayoutProfileCounts();
   void emitSILFunction(SILFunction *f);
   void emitSILWitnessTable(SILWitnessTable *wt);
   void emitSILStaticInitializer();
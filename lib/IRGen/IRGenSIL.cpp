@@ -20,6 +20,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/TinyPtrVector.h"
@@ -29,6 +30,7 @@
 #include "swift/Basic/Range.h"
 #include "swift/Basic/STLExtras.h"
 #include "swift/AST/ASTContext.h"
+#include "swift/AST/Builtins.h"
 #include "swift/AST/IRGenOptions.h"
 #include "swift/AST/Pattern.h"
 #include "swift/AST/Types.h"
@@ -3099,13 +3101,58 @@ void IRGenSILFunction::visitStrongUnpinInst(swift::StrongUnpinInst *i) {
 void IRGenSILFunction::visitStrongRetainInst(swift::StrongRetainInst *i) {
   Explosion lowered = getLoweredExplosion(i->getOperand());
   auto &ti = cast<ReferenceTypeInfo>(getTypeInfo(i->getOperand().getType()));
+  // If the optimizer proved that the object does not escape its allocating
+  // thread, use the non-atomic entry point. This is only implemented for
+  // native Swift reference counting.
+  ReferenceCounting refcounting;
+  if (i->isNonAtomic() &&
+      ti.isSingleRetainablePointer(ResilienceScope::Component, &refcounting) &&
+      refcounting == ReferenceCounting::Native) {
+    llvm::Value *value = lowered.claimNext();
+    for (unsigned n = i->getCount(); n > 0; --n)
+      emitNativeNonAtomicStrongRetain(value);
+    return;
+  }
+  // A coalesced retain performs all of its operations with a single atomic
+  // adjustment. This is only implemented for native Swift reference
+  // counting; the ARC optimizer does not form coalesced operations on
+  // other values.
+  if (i->getCount() != 1 &&
+      ti.isSingleRetainablePointer(ResilienceScope::Component, &refcounting) &&
+      refcounting == ReferenceCounting::Native) {
+    emitNativeStrongRetainN(lowered.claimNext(), i->getCount());
+    return;
+  }
   ti.strongRetain(*this, lowered);
+  for (unsigned n = i->getCount(); n > 1; --n) {
+    Explosion again = getLoweredExplosion(i->getOperand());
+    ti.strongRetain(*this, again);
+  }
 }
 
 void IRGenSILFunction::visitStrongReleaseInst(swift::StrongReleaseInst *i) {
   Explosion lowered = getLoweredExplosion(i->getOperand());
   auto &ti = cast<ReferenceTypeInfo>(getTypeInfo(i->getOperand().getType()));
+  ReferenceCounting refcounting;
+  if (i->isNonAtomic() &&
+      ti.isSingleRetainablePointer(ResilienceScope::Component, &refcounting) &&
+      refcounting == ReferenceCounting::Native) {
+    llvm::Value *value = lowered.claimNext();
+    for (unsigned n = i->getCount(); n > 0; --n)
+      emitNativeNonAtomicStrongRelease(value);
+    return;
+  }
+  if (i->getCount() != 1 &&
+      ti.isSingleRetainablePointer(ResilienceScope::Component, &refcounting) &&
+      refcounting == ReferenceCounting::Native) {
+    emitNativeStrongReleaseN(lowered.claimNext(), i->getCount());
+    return;
+  }
   ti.strongRelease(*this, lowered);
+  for (unsigned n = i->getCount(); n > 1; --n) {
+    Explosion again = getLoweredExplosion(i->getOperand());
+    ti.strongRelease(*this, again);
+  }
 }
 
 /// Given a SILType which is a ReferenceStorageType, return the type
@@ -4433,7 +4480,13 @@ void IRGenSILFunction::visitCondFailInst(swift::CondFailInst *i) {
   // line.
   llvm::BasicBlock *failBB = llvm::BasicBlock::Create(IGM.getLLVMContext());
   llvm::BasicBlock *contBB = llvm::BasicBlock::Create(IGM.getLLVMContext());
-  Builder.CreateCondBr(cond, failBB, contBB);
+  auto *br = Builder.CreateCondBr(cond, failBB, contBB);
+  // The failure path is never taken in a correct program. Give the backend
+  // the same hint __builtin_expect would, so that block placement moves the
+  // trap out of the hot part of the function.
+  llvm::MDBuilder MDHelper(IGM.getLLVMContext());
+  br->setMetadata(llvm::LLVMContext::MD_prof,
+                  MDHelper.createBranchWeights(/*fail*/ 1, /*cont*/ 2000));
   Builder.emitBlock(failBB);
   llvm::Function *trapIntrinsic =
       llvm::Intrinsic::getDeclaration(&IGM.Module, llvm::Intrinsic::ID::trap);
@@ -4497,6 +4550,31 @@ void IRGenSILFunction::visitClassMethodInst(swift::ClassMethodInst *i) {
 static llvm::Constant *getConstantValue(IRGenModule &IGM, llvm::StructType *STy,
                                         TupleInst *TI);
 
+/// Fold a "fptrunc" builtin of a float literal, as accepted by
+/// SILGlobalVariable::canBeStaticInitializer, to a constant of the
+/// lowered element type.
+static llvm::Constant *getConstantFPTrunc(IRGenModule &IGM, llvm::Type *EltTy,
+                                          BuiltinInst *BI) {
+  assert(BI->getBuiltinInfo().ID == BuiltinValueKind::FPTrunc &&
+         "Unexpected builtin in static initializer!");
+  auto *FLI = cast<FloatLiteralInst>(BI->getArguments()[0].getDef());
+
+  const llvm::fltSemantics *semantics;
+  if (EltTy->isHalfTy())
+    semantics = &llvm::APFloat::IEEEhalf;
+  else if (EltTy->isFloatTy())
+    semantics = &llvm::APFloat::IEEEsingle;
+  else if (EltTy->isDoubleTy())
+    semantics = &llvm::APFloat::IEEEdouble;
+  else
+    llvm_unreachable("Unexpected fptrunc type in static initializer!");
+
+  bool losesInfo;
+  llvm::APFloat truncated = FLI->getValue();
+  truncated.convert(*semantics, llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+  return llvm::ConstantFP::get(IGM.LLVMContext, truncated);
+}
+
 /// Generate ConstantStruct for StructInst.
 static llvm::Constant *getConstantValue(IRGenModule &IGM, llvm::StructType *STy,
                                         StructInst *SI) {
@@ -4516,6 +4594,8 @@ static llvm::Constant *getConstantValue(IRGenModule &IGM, llvm::StructType *STy,
       Elts.push_back(getConstantFP(IGM, FLI));
     else if (auto *SLI = dyn_cast<StringLiteralInst>(SI->getOperand(i)))
       Elts.push_back(getAddrOfString(IGM, SLI->getValue(), SLI->getEncoding()));
+    else if (auto *BI = dyn_cast<BuiltinInst>(SI->getOperand(i)))
+      Elts.push_back(getConstantFPTrunc(IGM, STy->getElementType(i), BI));
     else
       llvm_unreachable("Unexpected SILInstruction in static initializer!");
   }
@@ -4542,6 +4622,8 @@ static llvm::Constant *getConstantValue(IRGenModule &IGM, llvm::StructType *STy,
       Elts.push_back(getConstantFP(IGM, FLI));
     else if (auto *SLI = dyn_cast<StringLiteralInst>(TI->getOperand(i)))
       Elts.push_back(getAddrOfString(IGM, SLI->getValue(), SLI->getEncoding()));
+    else if (auto *BI = dyn_cast<BuiltinInst>(TI->getOperand(i)))
+      Elts.push_back(getConstantFPTrunc(IGM, STy->getElementType(i), BI));
     else
       llvm_unreachable("Unexpected SILInstruction in static initializer!");
   }
@@ -116,11 +116,14 @@ SwiftTargetInfo SwiftTargetInfo::get(IRGenModule &IGM) {
   SwiftTargetInfo target(triple.getObjectFormat(), pointerSize);
   
   // On Apple platforms, we implement "once" using dispatch_once, which exposes
-  // -1 as ABI for the "done" value.
-  if (triple.isOSDarwin())
-    target.OnceDonePredicateValue = -1L;
-  // TODO: Do we know this for Linux?
-  
+  // -1 as ABI for the "done" value, and whose writer side synchronizes
+  // strongly enough that the inline check can be a plain load. Elsewhere the
+  // runtime's own implementation of swift_once stores -1 with only release
+  // ordering once initialization is complete, so the inline fast path is
+  // available everywhere but must use an acquire load to pair with it.
+  target.OnceDonePredicateValue = -1L;
+  target.OnceDonePredicateNeedsAcquire = !triple.isOSDarwin();
+
   switch (triple.getArch()) {
   case llvm::Triple::x86_64:
     configureX86_64(IGM, triple, target);
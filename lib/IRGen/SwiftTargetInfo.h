@@ -87,6 +87,13 @@ public:
   /// The value stored in a Builtin.once predicate to indicate that an
   /// initialization has already happened, if known.
   Optional<int64_t> OnceDonePredicateValue = None;
+
+  /// True if the inline check against OnceDonePredicateValue must be an
+  /// acquire load.  Darwin's dispatch_once_f performs a maximally
+  /// synchronizing barrier on the writer side precisely so that readers
+  /// can use a plain load; the portable runtime publishes completion with
+  /// only a release store, which needs a pairing acquire.
+  bool OnceDonePredicateNeedsAcquire = false;
 };
 
 }
@@ -30,14 +30,21 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Config/config.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Linker/Linker.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include <dlfcn.h>
+#include <stdlib.h>
 
 using namespace swift;
 using namespace swift::immediate;
@@ -53,6 +60,81 @@ bool swift::immediate::loadSwiftRuntime(StringRef runtimeLibPath) {
   return loadRuntimeLib("libswiftCore" LTDL_SHLIB_EXT, runtimeLibPath);
 }
 
+namespace {
+
+/// An on-disk cache for JITted object code, keyed on the hash of the
+/// module's IR.
+///
+/// Immediate mode runs the backend over the whole translation unit on
+/// every invocation, even when nothing has changed since the last run.
+/// MCJIT consults the attached ObjectCache before compiling a module, so
+/// a cache hit replaces codegen with a single file load.
+class ImmediateObjectCache : public llvm::ObjectCache {
+  std::string CacheDir;
+
+  /// Returns the path of the cache entry for \p M.
+  std::string getCachePath(const llvm::Module *M) {
+    // Key on the hash of the printed IR.  Target configuration is part of
+    // the printed module, so objects compiled for different targets or CPU
+    // features don't alias.
+    llvm::SmallString<128> IRText;
+    {
+      llvm::raw_svector_ostream OS(IRText);
+      M->print(OS, nullptr);
+    }
+    llvm::MD5 Hash;
+    Hash.update(IRText);
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    llvm::SmallString<32> HashStr;
+    llvm::MD5::stringifyResult(Result, HashStr);
+
+    llvm::SmallString<128> Path(CacheDir);
+    llvm::sys::path::append(Path, HashStr + ".o");
+    return Path.str();
+  }
+
+public:
+  explicit ImmediateObjectCache(StringRef cacheDir) : CacheDir(cacheDir) {
+    // FIXME: Need error-checking.
+    llvm::sys::fs::create_directories(CacheDir);
+  }
+
+  void notifyObjectCompiled(const llvm::Module *M,
+                            llvm::MemoryBufferRef Obj) override {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(getCachePath(M), EC, llvm::sys::fs::F_None);
+    if (EC)
+      return;
+    OS << Obj.getBuffer();
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *M) override {
+    auto Buffer = llvm::MemoryBuffer::getFile(getCachePath(M));
+    if (!Buffer)
+      return nullptr;
+    DEBUG(llvm::dbgs() << "Reusing cached object for module "
+                       << M->getModuleIdentifier() << '\n');
+    return std::move(Buffer.get());
+  }
+};
+
+} // end anonymous namespace
+
+void swift::immediate::setUpObjectCache(llvm::ExecutionEngine *EE) {
+  // The cache persists across processes, so it is opt-in: it is only used
+  // when the user tells us where to keep it.
+  const char *CacheDir = getenv("SWIFT_IMMEDIATE_OBJECT_CACHE");
+  if (!CacheDir || !*CacheDir)
+    return;
+
+  // The ExecutionEngine does not take ownership of the cache, and the REPL
+  // can create more than one engine, so share a single instance for the
+  // lifetime of the process.
+  static ImmediateObjectCache *Cache = new ImmediateObjectCache(CacheDir);
+  EE->setObjectCache(Cache);
+}
+
 static bool tryLoadLibrary(LinkLibrary linkLib,
                            SearchPathOptions searchPathOpts) {
   llvm::SmallString<128> path = linkLib.getName();
@@ -325,6 +407,11 @@ int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
     return -1;
   }
 
+  // Attach the on-disk object cache, if requested.  A cache hit lets
+  // finalizeObject() reuse the machine code from an earlier run instead of
+  // invoking the backend.
+  setUpObjectCache(EE);
+
   DEBUG(llvm::dbgs() << "Module to be executed:\n";
         Module->dump());
 
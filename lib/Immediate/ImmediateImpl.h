@@ -21,6 +21,7 @@
 #include "llvm/ADT/SmallVector.h"
 
 namespace llvm {
+  class ExecutionEngine;
   class Function;
   class Module;
 }
@@ -35,6 +36,14 @@ namespace swift {
 namespace immediate {
 
 bool loadSwiftRuntime(StringRef runtimeLibPath);
+
+/// If the user requested an on-disk object cache, attach it to \p EE.
+///
+/// The cache is keyed on the hash of each module's IR, so a rerun of an
+/// unchanged script (or an equivalent definition entered in a later REPL
+/// session) reuses the machine code compiled by an earlier run instead of
+/// going through the backend again.
+void setUpObjectCache(llvm::ExecutionEngine *EE);
 bool tryLoadLibraries(ArrayRef<LinkLibrary> LinkLibraries,
                       SearchPathOptions SearchPathOpts,
                       DiagnosticEngine &Diags);
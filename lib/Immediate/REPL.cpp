@@ -966,6 +966,10 @@ public:
     builder.setEngineKind(llvm::EngineKind::JIT);
     EE = builder.create();
 
+    // Reuse compiled code from earlier sessions when the user enabled the
+    // on-disk object cache.
+    setUpObjectCache(EE);
+
     IRGenOpts.OutputFilenames.clear();
     IRGenOpts.Optimize = false;
     IRGenOpts.OutputKind = IRGenOutputKind::Module;
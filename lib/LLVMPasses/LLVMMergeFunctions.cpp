@@ -0,0 +1,214 @@
+//===--- LLVMMergeFunctions.cpp - Merge identical functions ---------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass folds functions which are identical instruction for instruction.
+// Swift emits many such functions (thunks, value witnesses and specialized
+// generics with the same layout). In contrast to LLVM's MergeFunctions pass
+// it never compares two functions before it has bucketed all functions by a
+// cheap structural hash, so the quadratic comparison work is limited to the
+// few functions which actually collide. It runs as a single serial pass over
+// the module at the end of the pipeline and keeps no state between modules,
+// which allows it to be used inside the parallel per-module backend
+// pipelines.
+//
+// Only exact duplicates with local linkage and an untaken address are folded;
+// replacing them cannot be observed through function pointer identity, so no
+// thunks are needed.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "swift-merge-functions"
+#include "swift/LLVMPasses/Passes.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+using namespace swift;
+
+STATISTIC(NumIdenticalFunctionsMerged,
+          "Number of identical functions merged");
+
+/// Computes a structural hash of \p F which is invariant under the renaming
+/// of values. Functions which are not identical may share a hash; identical
+/// functions never differ in it.
+static uint64_t structuralHash(const Function &F) {
+  SmallVector<unsigned, 128> Opcodes;
+  for (const BasicBlock &BB : F) {
+    // Mark the block boundaries so that e.g. splitting a block changes the
+    // hash.
+    Opcodes.push_back(~0u);
+    for (const Instruction &I : BB)
+      Opcodes.push_back(I.getOpcode());
+  }
+  // The function type is uniqued in the context, so hashing the pointer is
+  // fine. The hash is only used for bucketing within a single module; it is
+  // never persisted.
+  return hash_combine(F.getFunctionType(), F.getCallingConv(),
+                      hash_combine_range(Opcodes.begin(), Opcodes.end()));
+}
+
+/// Returns true if \p L and \p R are identical instruction for instruction.
+static bool isIdenticalFunction(const Function &L, const Function &R) {
+  if (L.getFunctionType() != R.getFunctionType() ||
+      L.getCallingConv() != R.getCallingConv() ||
+      L.getAttributes() != R.getAttributes() ||
+      L.getAlignment() != R.getAlignment() ||
+      L.hasSection() != R.hasSection() ||
+      (L.hasSection() && L.getSection() != R.getSection()) ||
+      L.hasGC() != R.hasGC() || (L.hasGC() && L.getGC() != R.getGC()) ||
+      L.hasPersonalityFn() != R.hasPersonalityFn() ||
+      (L.hasPersonalityFn() &&
+       L.getPersonalityFn() != R.getPersonalityFn()) ||
+      L.size() != R.size())
+    return false;
+
+  // Establish the correspondence between the values of the two functions by
+  // position: arguments, basic blocks and instructions. This also covers
+  // values which are only referenced further down, like the operands of
+  // phis.
+  DenseMap<const Value *, const Value *> ValueMap;
+  for (auto LI = L.arg_begin(), LE = L.arg_end(), RI = R.arg_begin();
+       LI != LE; ++LI, ++RI)
+    ValueMap[&*LI] = &*RI;
+
+  {
+    auto RI = R.begin();
+    for (const BasicBlock &LBB : L) {
+      const BasicBlock &RBB = *RI++;
+      if (LBB.size() != RBB.size())
+        return false;
+      ValueMap[&LBB] = &RBB;
+      auto RII = RBB.begin();
+      for (const Instruction &LInst : LBB)
+        ValueMap[&LInst] = &*RII++;
+    }
+  }
+
+  // Now verify that corresponding instructions perform the same operation on
+  // corresponding operands.
+  auto RBI = R.begin();
+  for (const BasicBlock &LBB : L) {
+    auto RII = RBI->begin();
+    ++RBI;
+    for (const Instruction &LInst : LBB) {
+      const Instruction &RInst = *RII++;
+      // This checks the opcode, the types and all instruction specific state
+      // like compare predicates, atomic orderings or call attributes.
+      if (!LInst.isSameOperationAs(&RInst))
+        return false;
+      for (unsigned i = 0, e = LInst.getNumOperands(); i != e; ++i) {
+        const Value *LOp = LInst.getOperand(i);
+        const Value *ROp = RInst.getOperand(i);
+        auto Known = ValueMap.find(LOp);
+        if (Known != ValueMap.end()) {
+          if (Known->second != ROp)
+            return false;
+          continue;
+        }
+        // Everything else - constants, globals, metadata - is uniqued in the
+        // context and must match exactly. This intentionally rejects
+        // functions which reference themselves through a constant.
+        if (LOp != ROp)
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+//                          SwiftMergeFunctions Pass
+//===----------------------------------------------------------------------===//
+
+char SwiftMergeFunctions::ID = 0;
+
+INITIALIZE_PASS_BEGIN(SwiftMergeFunctions,
+                      "swift-merge-functions", "Swift merge functions pass",
+                      false, false)
+INITIALIZE_PASS_END(SwiftMergeFunctions,
+                    "swift-merge-functions", "Swift merge functions pass",
+                    false, false)
+
+llvm::ModulePass *swift::createSwiftMergeFunctionsPass() {
+  initializeSwiftMergeFunctionsPass(*llvm::PassRegistry::getPassRegistry());
+  return new SwiftMergeFunctions();
+}
+
+bool SwiftMergeFunctions::runOnModule(Module &M) {
+  // Precompute a hash for every candidate.
+  std::vector<std::pair<uint64_t, Function *>> HashedFuncs;
+  for (Function &F : M) {
+    if (F.isDeclaration() || F.hasAvailableExternallyLinkage() ||
+        F.hasComdat())
+      continue;
+    HashedFuncs.push_back({structuralHash(F), &F});
+  }
+
+  // Sort by hash to form the buckets. The sort is stable, so within a bucket
+  // the module order is preserved and the first function of a bucket becomes
+  // the canonical one, which makes the output deterministic.
+  std::stable_sort(HashedFuncs.begin(), HashedFuncs.end(),
+                   [](const std::pair<uint64_t, Function *> &LHS,
+                      const std::pair<uint64_t, Function *> &RHS) {
+                     return LHS.first < RHS.first;
+                   });
+
+  bool Changed = false;
+  SmallVector<Function *, 16> Obsolete;
+  for (auto I = HashedFuncs.begin(), E = HashedFuncs.end(); I != E;) {
+    // [I, GroupEnd) is the bucket of functions with the same hash.
+    auto GroupEnd = std::next(I);
+    while (GroupEnd != E && GroupEnd->first == I->first)
+      ++GroupEnd;
+
+    // Compare every function in the bucket against the distinct functions
+    // seen so far. Buckets are tiny, so this stays cheap.
+    SmallVector<Function *, 2> Distinct;
+    for (auto FI = I; FI != GroupEnd; ++FI) {
+      Function *F = FI->second;
+      bool Merged = false;
+      for (Function *Canonical : Distinct) {
+        if (!isIdenticalFunction(*Canonical, *F))
+          continue;
+        if (F->hasLocalLinkage() && !F->hasAddressTaken()) {
+          DEBUG(llvm::dbgs() << "merge " << F->getName() << " into "
+                             << Canonical->getName() << "\n");
+          // All uses are direct calls, so no bitcast or thunk is needed.
+          F->replaceAllUsesWith(Canonical);
+          Obsolete.push_back(F);
+          ++NumIdenticalFunctionsMerged;
+          Merged = true;
+          Changed = true;
+        }
+        break;
+      }
+      if (!Merged)
+        Distinct.push_back(F);
+    }
+    I = GroupEnd;
+  }
+
+  for (Function *F : Obsolete)
+    F->eraseFromParent();
+
+  return Changed;
+}
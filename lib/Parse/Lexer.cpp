@@ -20,6 +20,7 @@
 #include "swift/Basic/Fallthrough.h"
 #include "swift/Basic/LangOptions.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/ADT/SmallString.h"
@@ -27,6 +28,7 @@
 #include "llvm/ADT/Twine.h"
 // FIXME: Figure out if this can be migrated to LLVM.
 #include "clang/Basic/CharInfo.h"
+#include <cstring>
 
 using namespace swift;
 
@@ -179,6 +181,8 @@ Lexer::Lexer(const LangOptions &Options,
   BufferEnd = contents.data() + contents.size();
   CurPtr = BufferStart;
 
+  getCompilationCounters().NumLexedBytes += contents.size();
+
   // Initialize code completion.
   if (BufferID == SM.getCodeCompletionBufferID()) {
     const char *Ptr = BufferStart + SM.getCodeCompletionOffset();
@@ -298,8 +302,53 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
       .fixItRemoveChars(NulLoc, NulEndLoc);
 }
 
+/// Advance \p Ptr over a run of printable ASCII characters a word at a time,
+/// stopping at the first byte that is a newline, carriage return, nul, or the
+/// lead byte of a non-ASCII sequence. The caller is responsible for handling
+/// the byte that ends the run.
+///
+/// This is the hot path for skipping over comment bodies; the byte-at-a-time
+/// loops in skipToEndOfLine only have to handle the interesting characters.
+static const char *skipOverPlainCommentBytes(const char *Ptr,
+                                             const char *End) {
+  typedef uintptr_t word_t;
+  const word_t OnesMask = ~(word_t)0 / 0xFF; // 0x0101...01
+  const word_t HighMask = OnesMask << 7;     // 0x8080...80
+
+  // Process a word at a time. The well-known "is there a zero byte in this
+  // word" bit trick lets us test all of the bytes of the word for each
+  // terminator at once.
+  while (End - Ptr >= (ptrdiff_t)sizeof(word_t)) {
+    word_t Word;
+    memcpy(&Word, Ptr, sizeof(word_t));
+
+    word_t HasNul = (Word - OnesMask) & ~Word;
+    word_t LF = Word ^ (OnesMask * '\n');
+    word_t HasLF = (LF - OnesMask) & ~LF;
+    word_t CR = Word ^ (OnesMask * '\r');
+    word_t HasCR = (CR - OnesMask) & ~CR;
+
+    // Word itself contributes the high bits of any non-ASCII bytes.
+    if ((HasNul | HasLF | HasCR | Word) & HighMask)
+      break;
+
+    Ptr += sizeof(word_t);
+  }
+
+  // Finish the tail (and locate the terminator within the last word)
+  // byte by byte.
+  while (Ptr != End) {
+    unsigned char C = *Ptr;
+    if (C == '\n' || C == '\r' || C == '\0' || C >= 0x80)
+      break;
+    ++Ptr;
+  }
+  return Ptr;
+}
+
 void Lexer::skipToEndOfLine() {
   while (1) {
+    CurPtr = skipOverPlainCommentBytes(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -504,6 +553,20 @@ static bool advanceIfValidContinuationOfIdentifier(char const *&ptr,
   return advanceIf(ptr, end, isValidIdentifierContinuationCodePoint);
 }
 
+/// Advance \p ptr over a run of ASCII identifier continuation characters
+/// ([a-zA-Z_$0-9]) without going through the general UTF-8 decoding path.
+/// The caller falls back to advanceIfValidContinuationOfIdentifier for
+/// anything more exotic.
+static void advanceOverASCIIIdentifierBytes(char const *&ptr,
+                                            char const *end) {
+  while (ptr != end) {
+    unsigned char c = *ptr;
+    if (c >= 0x80 || !clang::isIdentifierBody(c, /*dollar*/true))
+      break;
+    ++ptr;
+  }
+}
+
 static bool advanceIfValidStartOfOperator(char const *&ptr,
                                           char const *end) {
   return advanceIf(ptr, end, Identifier::isOperatorStartCodePoint);
@@ -561,7 +624,9 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  do {
+    advanceOverASCIIIdentifierBytes(CurPtr, BufferEnd);
+  } while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart), InSILMode);
   return formToken(Kind, TokStart);
@@ -1133,6 +1198,17 @@ void Lexer::lexStringLiteral() {
   bool wasErroneous = false;
   
   while (true) {
+    // Eat a run of plain string-literal characters in one go. Anything
+    // interesting---quotes, escapes, newlines, nul, or non-ASCII bytes that
+    // need validation---drops us back to lexCharacter below.
+    while (CurPtr != BufferEnd) {
+      unsigned char c = *CurPtr;
+      if (c == '"' || c == '\'' || c == '\\' || c == '\r' || c == '\n' ||
+          c == '\0' || c >= 0x80)
+        break;
+      ++CurPtr;
+    }
+
     if (*CurPtr == '\\' && *(CurPtr + 1) == '(') {
       // Consume tokens until we hit the corresponding ')'.
       CurPtr += 2;
@@ -1303,10 +1379,21 @@ void Lexer::tryLexEditorPlaceholder() {
 StringRef Lexer::getEncodedStringSegment(StringRef Bytes,
                                          SmallVectorImpl<char> &TempString) {
   TempString.clear();
+
+  // Segments without escape sequences can be used directly from the source
+  // buffer, which stays alive for the whole compilation; don't copy them at
+  // all. This matters for sources that embed large literal blobs.
+  size_t FirstEscape = Bytes.find('\\');
+  if (FirstEscape == StringRef::npos)
+    return Bytes;
+
+  // Otherwise copy the escape-free prefix and process the remainder.
+  TempString.append(Bytes.begin(), Bytes.begin() + FirstEscape);
+
   // Note that it is always safe to read one over the end of "Bytes" because
   // we know that there is a terminating " character.  Use BytesPtr to avoid a
   // range check subscripting on the StringRef.
-  const char *BytesPtr = Bytes.begin();
+  const char *BytesPtr = Bytes.begin() + FirstEscape;
   while (BytesPtr != Bytes.end()) {
     char CurChar = *BytesPtr++;
     if (CurChar != '\\') {
@@ -1352,14 +1439,9 @@ StringRef Lexer::getEncodedStringSegment(StringRef Bytes,
       EncodeToUTF8(CharValue, TempString);
   }
   
-  // If we didn't escape or reprocess anything, then we don't need to use the
-  // temporary string, just point to the original one. We know that this
-  // is safe because unescaped strings are always shorter than their escaped
-  // forms (in a valid string).
-  if (TempString.size() == Bytes.size()) {
-    TempString.clear();
-    return Bytes;
-  }
+  // We saw at least one escape sequence, so the encoded string is strictly
+  // shorter than its spelling and lives in the temporary.
+  assert(TempString.size() < Bytes.size() && "escape did not shrink string?");
   return StringRef(TempString.begin(), TempString.size());
 }
 
@@ -1495,6 +1577,11 @@ Restart:
   case '\t':
   case '\f':
   case '\v':
+    // Eat the rest of an indentation run here rather than restarting the
+    // lexer once per character; deeply indented files spend a surprising
+    // amount of time in this case.
+    while (*CurPtr == ' ' || *CurPtr == '\t')
+      ++CurPtr;
     goto Restart;  // Skip whitespace.
 
   case -1:
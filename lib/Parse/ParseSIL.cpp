@@ -95,6 +95,34 @@ namespace {
     llvm::StringMap<std::vector<SILValue>> ForwardMRVLocalValues;
     llvm::StringMap<SourceLoc> ForwardRefLocalValues;
 
+    /// A dense mirror of LocalValues for purely-numeric value names
+    /// ("%123"), which is how the printer names nearly every value in a
+    /// large dump.  The string maps stay authoritative; this only avoids
+    /// hashing the name on every use.
+    std::vector<ValueBase *> NumericLocalValues;
+
+    /// If \p Name consists entirely of decimal digits and is small enough
+    /// for the dense mirror, return its numeric value in \p Index.
+    static bool getNumericValueName(StringRef Name, unsigned &Index) {
+      if (Name.empty() || Name.size() > 6)
+        return false;
+      unsigned Result = 0;
+      for (char c : Name) {
+        if (!isdigit(c))
+          return false;
+        Result = Result * 10 + (c - '0');
+      }
+      Index = Result;
+      return true;
+    }
+
+    /// Record \p Value in the dense mirror under \p Index.
+    void setNumericLocalValue(unsigned Index, ValueBase *Value) {
+      if (NumericLocalValues.size() <= Index)
+        NumericLocalValues.resize(Index + 1);
+      NumericLocalValues[Index] = Value;
+    }
+
     bool performTypeLocChecking(TypeLoc &T, bool IsSIL = true);
     bool parseApplySubstitutions(
                    SmallVectorImpl<ParsedSubstitution> &parsed);
@@ -501,8 +529,15 @@ SILValue SILParser::getLocalValue(UnresolvedValueName Name, SILType Type,
   if (Name.isUndef())
     return SILUndef::get(Type, &SILMod);
 
-  // Check to see if this is already defined.
-  ValueBase *&Entry = LocalValues[Name.Name];
+  // Check to see if this is already defined, consulting the dense mirror
+  // first for numeric names so the common case doesn't hash the name.
+  unsigned NumericName = 0;
+  bool HasNumericName = getNumericValueName(Name.Name, NumericName);
+  ValueBase *Entry = nullptr;
+  if (HasNumericName && NumericName < NumericLocalValues.size())
+    Entry = NumericLocalValues[NumericName];
+  if (!Entry)
+    Entry = LocalValues.lookup(Name.Name);
 
   if (Entry) {
     // If this value is already defined, check it to make sure types match.
@@ -538,6 +573,9 @@ SILValue SILParser::getLocalValue(UnresolvedValueName Name, SILType Type,
 
   if (!Name.isMRV()) {
     Entry = new (SILMod) GlobalAddrInst(getDebugLoc(B, Loc), Type);
+    LocalValues[Name.Name] = Entry;
+    if (HasNumericName)
+      setNumericLocalValue(NumericName, Entry);
     return Entry;
   }
 
@@ -556,6 +594,8 @@ SILValue SILParser::getLocalValue(UnresolvedValueName Name, SILType Type,
 /// method is used to register it and update our symbol table.
 void SILParser::setLocalValue(ValueBase *Value, StringRef Name,
                               SourceLoc NameLoc) {
+  unsigned NumericName = 0;
+  bool HasNumericName = getNumericValueName(Name, NumericName);
   ValueBase *&Entry = LocalValues[Name];
 
   // If this value was already defined, it is either a redefinition, or a
@@ -579,11 +619,15 @@ void SILParser::setLocalValue(ValueBase *Value, StringRef Name,
       SILValue(Entry).replaceAllUsesWith(SILValue(Value));
     }
     Entry = Value;
+    if (HasNumericName)
+      setNumericLocalValue(NumericName, Value);
     return;
   }
 
   // Otherwise, just store it in our map.
   Entry = Value;
+  if (HasNumericName)
+    setNumericLocalValue(NumericName, Value);
 
   // If Entry has multiple values, it may be forward referenced.
   if (Entry->getTypes().size() > 1) {
@@ -1968,8 +2012,6 @@ bool SILParser::parseSILInstruction(SILBasicBlock *BB) {
   UNARY_INSTRUCTION(FixLifetime)
   UNARY_INSTRUCTION(CopyBlock)
   UNARY_INSTRUCTION(StrongPin)
-  UNARY_INSTRUCTION(StrongRetain)
-  UNARY_INSTRUCTION(StrongRelease)
   UNARY_INSTRUCTION(StrongUnpin)
   UNARY_INSTRUCTION(StrongRetainUnowned)
   UNARY_INSTRUCTION(UnownedRetain)
@@ -1984,6 +2026,41 @@ bool SILParser::parseSILInstruction(SILBasicBlock *BB) {
   UNARY_INSTRUCTION(CondFail)
 #undef UNARY_INSTRUCTION
 
+  case ValueKind::StrongRetainInst:
+  case ValueKind::StrongReleaseInst: {
+    bool IsNonAtomic = false;
+    unsigned Count = 1;
+    // Parse the optional [nonatomic] and [count N] attributes.
+    while (P.Tok.is(tok::l_square)) {
+      P.consumeToken(tok::l_square);
+      Identifier Id;
+      if (parseSILIdentifier(Id, diag::expected_in_attribute_list))
+        return true;
+      if (Id.str() == "nonatomic") {
+        IsNonAtomic = true;
+      } else if (Id.str() == "count") {
+        if (parseInteger(Count, diag::expected_in_attribute_list))
+          return true;
+      } else {
+        P.diagnose(P.Tok, diag::expected_in_attribute_list);
+        return true;
+      }
+      if (P.parseToken(tok::r_square, diag::expected_in_attribute_list))
+        return true;
+    }
+    if (parseTypedValueRef(Val, B))
+      return true;
+    RefCountingInst *RCI;
+    if (Opcode == ValueKind::StrongRetainInst)
+      RCI = B.createStrongRetain(InstLoc, Val);
+    else
+      RCI = B.createStrongRelease(InstLoc, Val);
+    RCI->setNonAtomic(IsNonAtomic);
+    RCI->setCount(Count);
+    ResultVal = RCI;
+    break;
+  }
+
  case ValueKind::DebugValueInst:
  case ValueKind::DebugValueAddrInst: {
    if (parseTypedValueRef(Val, B))
@@ -48,6 +48,37 @@ namespace {
     }
   };
 
+/// Parse the delayed body of \p AFD using the state recorded in
+/// \p ParserState.
+static void parseDelayedFunctionBody(
+    AbstractFunctionDecl *AFD, PersistentParserState &ParserState,
+    CodeCompletionCallbacksFactory *CodeCompletionFactory) {
+  assert(AFD->getBodyKind() == FuncDecl::BodyKind::Unparsed);
+
+  SourceFile &SF = *AFD->getDeclContext()->getParentSourceFile();
+  SourceManager &SourceMgr = SF.getASTContext().SourceMgr;
+  unsigned BufferID = SourceMgr.findBufferContainingLoc(AFD->getLoc());
+  Parser TheParser(BufferID, SF, nullptr, &ParserState);
+
+  std::unique_ptr<CodeCompletionCallbacks> CodeCompletion;
+  if (CodeCompletionFactory) {
+    CodeCompletion.reset(
+        CodeCompletionFactory->createCodeCompletionCallbacks(TheParser));
+    TheParser.setCodeCompletionCallbacks(CodeCompletion.get());
+  }
+  bool Parsed = false;
+  if (auto FD = dyn_cast<FuncDecl>(AFD)) {
+    if (FD->isAccessor()) {
+      TheParser.parseAccessorBodyDelayed(AFD);
+      Parsed = true;
+    }
+  }
+  if (!Parsed && ParserState.hasFunctionBodyState(AFD))
+    TheParser.parseAbstractFunctionBodyDelayed(AFD);
+  if (CodeCompletion)
+    CodeCompletion->doneParsing();
+}
+
 /// A visitor that does delayed parsing of function bodies.
 class ParseDelayedFunctionBodies : public ASTWalker {
   PersistentParserState &ParserState;
@@ -62,38 +93,39 @@ public:
     if (auto AFD = dyn_cast<AbstractFunctionDecl>(D)) {
       if (AFD->getBodyKind() != FuncDecl::BodyKind::Unparsed)
         return false;
-      parseFunctionBody(AFD);
+      parseDelayedFunctionBody(AFD, ParserState, CodeCompletionFactory);
       return true;
     }
     return true;
   }
+};
 
-private:
-  void parseFunctionBody(AbstractFunctionDecl *AFD) {
-    assert(AFD->getBodyKind() == FuncDecl::BodyKind::Unparsed);
+/// A visitor that finds the innermost unparsed function body whose recorded
+/// source range entirely contains a given range.
+///
+/// Unparsed bodies have no children in the AST, so the first delayed body
+/// that contains the range is also the innermost one.
+class FindDelayedBodyContaining : public ASTWalker {
+  SourceManager &SourceMgr;
+  SourceRange TargetRange;
 
-    SourceFile &SF = *AFD->getDeclContext()->getParentSourceFile();
-    SourceManager &SourceMgr = SF.getASTContext().SourceMgr;
-    unsigned BufferID = SourceMgr.findBufferContainingLoc(AFD->getLoc());
-    Parser TheParser(BufferID, SF, nullptr, &ParserState);
+public:
+  AbstractFunctionDecl *FoundDecl = nullptr;
 
-    std::unique_ptr<CodeCompletionCallbacks> CodeCompletion;
-    if (CodeCompletionFactory) {
-      CodeCompletion.reset(
-          CodeCompletionFactory->createCodeCompletionCallbacks(TheParser));
-      TheParser.setCodeCompletionCallbacks(CodeCompletion.get());
-    }
-    bool Parsed = false;
-    if (auto FD = dyn_cast<FuncDecl>(AFD)) {
-      if (FD->isAccessor()) {
-        TheParser.parseAccessorBodyDelayed(AFD);
-        Parsed = true;
-      }
+  FindDelayedBodyContaining(SourceManager &SourceMgr, SourceRange TargetRange)
+    : SourceMgr(SourceMgr), TargetRange(TargetRange) {}
+
+  bool walkToDeclPre(Decl *D) override {
+    if (FoundDecl)
+      return false;
+    if (auto AFD = dyn_cast<AbstractFunctionDecl>(D)) {
+      if (AFD->getBodyKind() != FuncDecl::BodyKind::Unparsed)
+        return true;
+      if (SourceMgr.rangeContains(AFD->getBodySourceRange(), TargetRange))
+        FoundDecl = AFD;
+      return false;
     }
-    if (!Parsed && ParserState.hasFunctionBodyState(AFD))
-      TheParser.parseAbstractFunctionBodyDelayed(AFD);
-    if (CodeCompletion)
-      CodeCompletion->doneParsing();
+    return true;
   }
 };
 
@@ -164,6 +196,21 @@ void swift::performDelayedParsing(
     parseDelayedDecl(PersistentState, CodeCompletionFactory);
 }
 
+AbstractFunctionDecl *
+swift::performDelayedParsingOfBodyContaining(
+    DeclContext *DC, PersistentParserState &PersistentState,
+    SourceRange TargetRange) {
+  SourceManager &SourceMgr = DC->getASTContext().SourceMgr;
+  FindDelayedBodyContaining Finder(SourceMgr, TargetRange);
+  DC->walkContext(Finder);
+  if (!Finder.FoundDecl)
+    return nullptr;
+
+  parseDelayedFunctionBody(Finder.FoundDecl, PersistentState,
+                           /*CodeCompletionFactory=*/nullptr);
+  return Finder.FoundDecl;
+}
+
 /// \brief Tokenizes a string literal, taking into account string interpolation.
 static void getStringPartTokens(const Token &Tok, const LangOptions &LangOpts,
                                 const SourceManager &SM,
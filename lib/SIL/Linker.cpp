@@ -126,6 +126,14 @@ bool SILLinkerVisitor::processFunction(StringRef Name) {
   return true;
 }
 
+/// Check if a function with name Name exists in one of the modules we can
+/// deserialize from. Unlike processFunction, this consults only the function
+/// indices of the serialized modules; nothing is deserialized and no
+/// declaration is created.
+bool SILLinkerVisitor::hasFunction(StringRef Name) {
+  return Loader->hasSILFunction(Name);
+}
+
 
 /// Deserialize the VTable mapped to C if it exists and all SIL the VTable
 /// transitively references.
@@ -59,6 +59,11 @@ public:
   /// may reference.
   bool processFunction(StringRef Name);
 
+  /// Check if a function with name Name exists in one of the modules we can
+  /// deserialize from. Nothing is deserialized, only the function indices
+  /// are consulted.
+  bool hasFunction(StringRef Name);
+
   /// Process Decl, recursively deserializing any thing that
   /// the SILFunction corresponding to Decl may reference.
   bool processDeclRef(SILDeclRef Decl);
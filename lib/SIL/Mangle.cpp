@@ -103,10 +103,10 @@ setArgumentClosureProp(unsigned ArgNo, ThinToThickFunctionInst *TTTFI) {
 
 void
 FunctionSignatureSpecializationMangler::
-setArgumentConstantProp(unsigned ArgNo, LiteralInst *LI) {
+setArgumentConstantProp(unsigned ArgNo, SILInstruction *Constant) {
   auto &Info = Args[ArgNo];
   Info.first = ArgumentModifierIntBase(ArgumentModifier::ConstantProp);
-  Info.second = LI;
+  Info.second = Constant;
 }
 
 void
@@ -134,17 +134,51 @@ setArgumentBoxToStack(unsigned ArgNo) {
 }
 
 void
-FunctionSignatureSpecializationMangler::mangleConstantProp(LiteralInst *LI) {
-  Mangler &M = getMangler();
+FunctionSignatureSpecializationMangler::mangleConstantProp(
+    SILInstruction *Constant) {
   llvm::raw_ostream &os = getBuffer();
 
   // Append the prefix for constant propagation 'cp'.
   os << "cp";
 
-  // Then append the unique identifier of our literal.
+  // Then append the unique identifier of the constant.
+  mangleConstantValue(Constant);
+}
+
+void
+FunctionSignatureSpecializationMangler::mangleConstantValue(
+    SILInstruction *LI) {
+  Mangler &M = getMangler();
+  llvm::raw_ostream &os = getBuffer();
+
   switch (LI->getKind()) {
   default:
-    llvm_unreachable("unknown literal");
+    llvm_unreachable("unknown constant");
+  case ValueKind::ThinToThickFunctionInst: {
+    // The conversion adds nothing to the uniqueness of the constant.
+    mangleConstantValue(
+        cast<SILInstruction>(
+            cast<ThinToThickFunctionInst>(LI)->getOperand().getDef()));
+    break;
+  }
+  case ValueKind::MetatypeInst: {
+    os << "mt";
+    M.mangleType(LI->getType(0).getSwiftRValueType(),
+                 ResilienceExpansion::Minimal, 0);
+    break;
+  }
+  case ValueKind::StructInst:
+  case ValueKind::TupleInst: {
+    // A constant aggregate is uniqued by its type and the constants it is
+    // built from, terminated to keep the encoding prefix-free.
+    os << (isa<StructInst>(LI) ? "sa" : "ta");
+    M.mangleType(LI->getType(0).getSwiftRValueType(),
+                 ResilienceExpansion::Minimal, 0);
+    for (auto &Op : LI->getAllOperands())
+      mangleConstantValue(cast<SILInstruction>(Op.get().getDef()));
+    os << "_";
+    break;
+  }
   case ValueKind::FunctionRefInst: {
     SILFunction *F = cast<FunctionRefInst>(LI)->getReferencedFunction();
     os << "fr";
@@ -224,7 +258,7 @@ void FunctionSignatureSpecializationMangler::mangleClosureProp(
 void FunctionSignatureSpecializationMangler::mangleArgument(
     ArgumentModifierIntBase ArgMod, NullablePtr<SILInstruction> Inst) {
   if (ArgMod == ArgumentModifierIntBase(ArgumentModifier::ConstantProp)) {
-    mangleConstantProp(cast<LiteralInst>(Inst.get()));
+    mangleConstantProp(Inst.get());
     return;
   }
 
@@ -93,9 +93,9 @@ void SILBasicBlock::remove(SILInstruction *I) {
 void SILBasicBlock::erase(SILInstruction *I) {
   // Notify the delete handlers that this instruction is going away.
   getModule().notifyDeleteHandlers(&*I);
-  auto *F = getParent();
+  // The instruction's memory is owned by the arena of its function and is
+  // reclaimed in bulk when the function or its body is erased.
   InstList.erase(I);
-  F->getModule().deallocateInst(I);
 }
 
 /// This method unlinks 'self' from the containing SILFunction and deletes it.
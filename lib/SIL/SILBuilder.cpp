@@ -52,7 +52,7 @@ SILInstruction *SILBuilder::tryCreateUncheckedRefCast(SILLocation Loc,
     return nullptr;
 
   return insert(
-      new (M) UncheckedRefCastInst(createSILDebugLocation(Loc), Op, ResultTy));
+      new (F) UncheckedRefCastInst(createSILDebugLocation(Loc), Op, ResultTy));
 }
 
 // Create the appropriate cast instruction based on result type.
@@ -61,7 +61,7 @@ SILInstruction *SILBuilder::createUncheckedBitCast(SILLocation Loc,
                                                    SILType Ty) {
   auto &M = F.getModule();
   if (Ty.isTrivial(M))
-    return insert(new (M) UncheckedTrivialBitCastInst(
+    return insert(new (F) UncheckedTrivialBitCastInst(
         createSILDebugLocation(Loc), Op, Ty));
 
   if (auto refCast = tryCreateUncheckedRefCast(Loc, Op, Ty))
@@ -70,7 +70,7 @@ SILInstruction *SILBuilder::createUncheckedBitCast(SILLocation Loc,
   // The destination type is nontrivial, and may be smaller than the source
   // type, so RC identity cannot be assumed.
   return insert(
-      new (M) UncheckedBitwiseCastInst(createSILDebugLocation(Loc), Op, Ty));
+      new (F) UncheckedBitwiseCastInst(createSILDebugLocation(Loc), Op, Ty));
 }
 
 BranchInst *SILBuilder::createBranch(SILLocation Loc,
@@ -206,7 +206,9 @@ SILBuilder::emitStrongRelease(SILLocation Loc, SILValue Operand) {
     auto *Inst = &*--I;
 
     if (auto *SRA = dyn_cast<StrongRetainInst>(Inst)) {
-      if (SRA->getOperand() == Operand)
+      // A coalesced retain performs more than one operation and cannot be
+      // cancelled against a single release.
+      if (SRA->getOperand() == Operand && SRA->getCount() == 1)
         return SRA;
       // Skip past unrelated retains.
       continue;
@@ -109,16 +109,13 @@ SILFunction::~SILFunction() {
   // an allocator that may recycle freed memory.
   dropAllReferences();
 
-  auto &M = getModule();
   for (auto &BB : *this) {
     for (auto I = BB.begin(), E = BB.end(); I != E;) {
       auto Inst = &*I;
       ++I;
+      // The instruction memory itself is owned by the function's arena and
+      // dies with it.
       SILInstruction::destroy(Inst);
-      // TODO: It is only safe to directly deallocate an
-      // instruction if this BB is being removed in scope
-      // of destructing a SILFunction.
-      M.deallocateInst(Inst);
     }
     BB.InstList.clearAndLeakNodesUnsafely();
   }
@@ -127,6 +124,31 @@ SILFunction::~SILFunction() {
          "Function cannot be deleted while function_ref's still exist");
 }
 
+void SILFunction::eraseBody() {
+  // Drop all operand references first; the body may contain a function_ref
+  // to this function itself or to other dead functions.
+  dropAllReferences();
+
+  // Delete the basic blocks. This destroys the instructions and notifies
+  // any registered delete handlers.
+  while (!BlockList.empty())
+    BlockList.erase(BlockList.begin());
+
+  // All instruction memory is dead now; return the arenas to the system.
+  InstAllocator.Reset();
+  AdoptedInstAllocators.clear();
+}
+
+void SILFunction::adoptInstAllocators(SILFunction *F) {
+  if (F == this)
+    return;
+
+  AdoptedInstAllocators.push_back(std::move(F->InstAllocator));
+  for (auto &Allocator : F->AdoptedInstAllocators)
+    AdoptedInstAllocators.push_back(std::move(Allocator));
+  F->AdoptedInstAllocators.clear();
+}
+
 void SILFunction::setDeclContext(Decl *D) {
   if (!D)
     return;
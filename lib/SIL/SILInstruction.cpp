@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/SIL/SILInstruction.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Basic/type_traits.h"
 #include "swift/Basic/Unicode.h"
 #include "swift/SIL/SILBuilder.h"
@@ -76,12 +77,17 @@ SILBasicBlock *llvm::ilist_traits<SILInstruction>::getContainingBlock() {
 void llvm::ilist_traits<SILInstruction>::addNodeToList(SILInstruction *I) {
   assert(I->ParentBB == 0 && "Already in a list!");
   I->ParentBB = getContainingBlock();
+  // Moving an instruction between blocks counts as a removal and an
+  // insertion, so the two counters always differ by the number of live
+  // instructions.
+  ++swift::getCompilationCounters().NumSILInstsCreated;
 }
 
 void llvm::ilist_traits<SILInstruction>::removeNodeFromList(SILInstruction *I) {
   // When an instruction is removed from a BB, clear the parent pointer.
   assert(I->ParentBB && "Not in a list!");
   I->ParentBB = 0;
+  ++swift::getCompilationCounters().NumSILInstsDeleted;
 }
 
 void llvm::ilist_traits<SILInstruction>::
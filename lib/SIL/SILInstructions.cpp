@@ -46,8 +46,9 @@ static SILTypeList *getAllocStackType(SILType eltTy, SILFunction &F) {
 }
 
 template <typename INST>
-static void *allocateDebugVarCarryingInst(SILModule &M, SILDebugVariable Var) {
-  return M.allocateInst(sizeof(INST) + Var.Name.size(), alignof(INST));
+static void *allocateDebugVarCarryingInst(SILFunction &F,
+                                          SILDebugVariable Var) {
+  return F.allocateInst(sizeof(INST) + Var.Name.size(), alignof(INST));
 }
 
 TailAllocatedDebugVariable::TailAllocatedDebugVariable(SILDebugVariable Var,
@@ -71,7 +72,7 @@ AllocStackInst::AllocStackInst(SILDebugLocation *Loc, SILType elementType,
 AllocStackInst *AllocStackInst::create(SILDebugLocation *Loc,
                                        SILType elementType, SILFunction &F,
                                        SILDebugVariable Var) {
-  void *buf = allocateDebugVarCarryingInst<AllocStackInst>(F.getModule(), Var);
+  void *buf = allocateDebugVarCarryingInst<AllocStackInst>(F, Var);
   return ::new (buf)
       AllocStackInst(Loc, elementType, F, Var);
 }
@@ -108,7 +109,7 @@ AllocBoxInst::AllocBoxInst(SILDebugLocation *Loc, SILType ElementType,
 
 AllocBoxInst *AllocBoxInst::create(SILDebugLocation *Loc, SILType ElementType,
                                    SILFunction &F, SILDebugVariable Var) {
-  void *buf = allocateDebugVarCarryingInst<AllocStackInst>(F.getModule(), Var);
+  void *buf = allocateDebugVarCarryingInst<AllocStackInst>(F, Var);
   return ::new (buf) AllocBoxInst(Loc, ElementType, F, Var);
 }
 
@@ -124,9 +125,9 @@ DebugValueInst::DebugValueInst(SILDebugLocation *DebugLoc, SILValue Operand,
       VarInfo(Var, reinterpret_cast<char *>(this + 1)) {}
 
 DebugValueInst *DebugValueInst::create(SILDebugLocation *DebugLoc,
-                                       SILValue Operand, SILModule &M,
+                                       SILValue Operand, SILFunction &F,
                                        SILDebugVariable Var) {
-  void *buf = allocateDebugVarCarryingInst<DebugValueInst>(M, Var);
+  void *buf = allocateDebugVarCarryingInst<DebugValueInst>(F, Var);
   return ::new (buf) DebugValueInst(DebugLoc, Operand, Var);
 }
 
@@ -136,9 +137,10 @@ DebugValueAddrInst::DebugValueAddrInst(SILDebugLocation *DebugLoc,
       VarInfo(Var, reinterpret_cast<char *>(this + 1)) {}
 
 DebugValueAddrInst *DebugValueAddrInst::create(SILDebugLocation *DebugLoc,
-                                               SILValue Operand, SILModule &M,
+                                               SILValue Operand,
+                                               SILFunction &F,
                                                SILDebugVariable Var) {
-  void *buf = allocateDebugVarCarryingInst<DebugValueAddrInst>(M, Var);
+  void *buf = allocateDebugVarCarryingInst<DebugValueAddrInst>(F, Var);
   return ::new (buf) DebugValueAddrInst(DebugLoc, Operand, Var);
 }
 
@@ -183,8 +185,8 @@ AllocExistentialBoxInst *AllocExistentialBoxInst::create(
     SILType ConcreteLoweredType, ArrayRef<ProtocolConformance *> Conformances,
     SILFunction *F) {
   SILModule &Mod = F->getModule();
-  void *Buffer = Mod.allocateInst(sizeof(AllocExistentialBoxInst),
-                                  alignof(AllocExistentialBoxInst));
+  void *Buffer = F->allocateInst(sizeof(AllocExistentialBoxInst),
+                                 alignof(AllocExistentialBoxInst));
   for (ProtocolConformance *C : Conformances)
     declareWitnessTable(Mod, C);
   return ::new (Buffer) AllocExistentialBoxInst(Loc,
@@ -199,7 +201,7 @@ BuiltinInst *BuiltinInst::create(SILDebugLocation *Loc, Identifier Name,
                                  ArrayRef<Substitution> Substitutions,
                                  ArrayRef<SILValue> Args,
                                  SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(
+  void *Buffer = F.allocateInst(
                               sizeof(BuiltinInst)
                                 + decltype(Operands)::getExtraSize(Args.size())
                                 + sizeof(Substitution) * Substitutions.size(),
@@ -246,7 +248,7 @@ bool swift::doesApplyCalleeHaveSemantics(SILValue callee, StringRef semantics) {
 }
 
 void *swift::allocateApplyInst(SILFunction &F, size_t size, size_t alignment) {
-  return F.getModule().allocateInst(size, alignment);
+  return F.allocateInst(size, alignment);
 }
 
 PartialApplyInst::PartialApplyInst(SILDebugLocation *Loc, SILValue Callee,
@@ -332,13 +334,13 @@ static unsigned getWordsForBitWidth(unsigned bits) {
 
 template<typename INST>
 static void *allocateLiteralInstWithTextSize(SILFunction &F, unsigned length) {
-  return F.getModule().allocateInst(sizeof(INST) + length, alignof(INST));
+  return F.allocateInst(sizeof(INST) + length, alignof(INST));
 }
 
 template<typename INST>
 static void *allocateLiteralInstWithBitSize(SILFunction &F, unsigned bits) {
   unsigned words = getWordsForBitWidth(bits);
-  return F.getModule().allocateInst(
+  return F.allocateInst(
       sizeof(INST) + sizeof(llvm::integerPart)*words, alignof(INST));
 }
 
@@ -465,7 +467,7 @@ AssignInst::AssignInst(SILDebugLocation *Loc, SILValue Src, SILValue Dest)
 MarkFunctionEscapeInst *
 MarkFunctionEscapeInst::create(SILDebugLocation *Loc,
                                ArrayRef<SILValue> Elements, SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(sizeof(MarkFunctionEscapeInst) +
+  void *Buffer = F.allocateInst(sizeof(MarkFunctionEscapeInst) +
                               decltype(Operands)::getExtraSize(Elements.size()),
                                         alignof(MarkFunctionEscapeInst));
   return ::new(Buffer) MarkFunctionEscapeInst(Loc, Elements);
@@ -508,7 +510,7 @@ UnconditionalCheckedCastAddrInst::UnconditionalCheckedCastAddrInst(
 
 StructInst *StructInst::create(SILDebugLocation *Loc, SILType Ty,
                                ArrayRef<SILValue> Elements, SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(sizeof(StructInst) +
+  void *Buffer = F.allocateInst(sizeof(StructInst) +
                             decltype(Operands)::getExtraSize(Elements.size()),
                             alignof(StructInst));
   return ::new(Buffer) StructInst(Loc, Ty, Elements);
@@ -522,7 +524,7 @@ StructInst::StructInst(SILDebugLocation *Loc, SILType Ty,
 
 TupleInst *TupleInst::create(SILDebugLocation *Loc, SILType Ty,
                              ArrayRef<SILValue> Elements, SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(sizeof(TupleInst) +
+  void *Buffer = F.allocateInst(sizeof(TupleInst) +
                             decltype(Operands)::getExtraSize(Elements.size()),
                             alignof(TupleInst));
   return ::new(Buffer) TupleInst(Loc, Ty, Elements);
@@ -725,7 +727,7 @@ BranchInst *BranchInst::create(SILDebugLocation *Loc, SILBasicBlock *DestBB,
 BranchInst *BranchInst::create(SILDebugLocation *Loc,
                                SILBasicBlock *DestBB, ArrayRef<SILValue> Args,
                                SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(sizeof(BranchInst) +
+  void *Buffer = F.allocateInst(sizeof(BranchInst) +
                               decltype(Operands)::getExtraSize(Args.size()),
                             alignof(BranchInst));
   return ::new (Buffer) BranchInst(Loc, DestBB, Args);
@@ -759,7 +761,7 @@ CondBranchInst::create(SILDebugLocation *Loc, SILValue Condition,
   Args.append(TrueArgs.begin(), TrueArgs.end());
   Args.append(FalseArgs.begin(), FalseArgs.end());
 
-  void *Buffer = F.getModule().allocateInst(sizeof(CondBranchInst) +
+  void *Buffer = F.allocateInst(sizeof(CondBranchInst) +
                               decltype(Operands)::getExtraSize(Args.size()),
                             alignof(CondBranchInst));
   return ::new (Buffer) CondBranchInst(Loc, Condition, TrueBB, FalseBB, Args,
@@ -909,7 +911,7 @@ SwitchValueInst *SwitchValueInst::create(
   size_t bufSize = sizeof(SwitchValueInst) +
                    decltype(Operands)::getExtraSize(Cases.size()) +
                    sizeof(SILSuccessor) * numSuccessors;
-  void *buf = F.getModule().allocateInst(bufSize, alignof(SwitchValueInst));
+  void *buf = F.allocateInst(bufSize, alignof(SwitchValueInst));
   return ::new (buf) SwitchValueInst(Loc, Operand, DefaultBB, Cases, BBs);
 }
 
@@ -957,7 +959,7 @@ SelectValueInst::create(SILDebugLocation *Loc, SILValue Operand, SILType Type,
 
   size_t bufSize = sizeof(SelectValueInst) + decltype(Operands)::getExtraSize(
                                                CaseValuesAndResults.size());
-  void *buf = F.getModule().allocateInst(bufSize, alignof(SelectValueInst));
+  void *buf = F.allocateInst(bufSize, alignof(SelectValueInst));
   return ::new (buf)
       SelectValueInst(Loc, Operand, Type, DefaultResult, CaseValuesAndResults);
 }
@@ -998,7 +1000,7 @@ SELECT_ENUM_INST *SelectEnumInstBase::createSelectEnum(
   // and `CaseBBs.size() + (DefaultBB ? 1 : 0)` values.
   unsigned numCases = CaseValues.size();
 
-  void *buf = F.getModule().allocateInst(
+  void *buf = F.allocateInst(
     sizeof(SELECT_ENUM_INST) + sizeof(EnumElementDecl*) * numCases
      + TailAllocatedOperandList<1>::getExtraSize(numCases + (bool)DefaultValue),
     alignof(SELECT_ENUM_INST));
@@ -1119,7 +1121,7 @@ SWITCH_ENUM_INST *SwitchEnumInstBase::createSwitchEnum(
   unsigned numCases = CaseBBs.size();
   unsigned numSuccessors = numCases + (DefaultBB ? 1 : 0);
 
-  void *buf = F.getModule().allocateInst(sizeof(SWITCH_ENUM_INST)
+  void *buf = F.allocateInst(sizeof(SWITCH_ENUM_INST)
                                        + sizeof(EnumElementDecl*) * numCases
                                        + sizeof(SILSuccessor) * numSuccessors,
                                      alignof(SWITCH_ENUM_INST));
@@ -1185,7 +1187,7 @@ DynamicMethodBranchInst *
 DynamicMethodBranchInst::create(SILDebugLocation *Loc, SILValue Operand,
                                 SILDeclRef Member, SILBasicBlock *HasMethodBB,
                                 SILBasicBlock *NoMethodBB, SILFunction &F) {
-  void *Buffer = F.getModule().allocateInst(sizeof(DynamicMethodBranchInst),
+  void *Buffer = F.allocateInst(sizeof(DynamicMethodBranchInst),
                                             alignof(DynamicMethodBranchInst));
   return ::new (Buffer)
       DynamicMethodBranchInst(Loc, Operand, Member, HasMethodBB, NoMethodBB);
@@ -1228,7 +1230,7 @@ WitnessMethodInst::create(SILDebugLocation *Loc, CanType LookupType,
                           SILValue OpenedExistential, bool Volatile) {
   SILModule &Mod = F->getModule();
   void *Buffer =
-      Mod.allocateInst(sizeof(WitnessMethodInst), alignof(WitnessMethodInst));
+      F->allocateInst(sizeof(WitnessMethodInst), alignof(WitnessMethodInst));
 
   declareWitnessTable(Mod, Conformance);
   return ::new (Buffer) WitnessMethodInst(Loc, LookupType, Conformance, Member,
@@ -1240,8 +1242,8 @@ InitExistentialAddrInst *InitExistentialAddrInst::create(
     SILType ConcreteLoweredType, ArrayRef<ProtocolConformance *> Conformances,
     SILFunction *F) {
   SILModule &Mod = F->getModule();
-  void *Buffer = Mod.allocateInst(sizeof(InitExistentialAddrInst),
-                                  alignof(InitExistentialAddrInst));
+  void *Buffer = F->allocateInst(sizeof(InitExistentialAddrInst),
+                                 alignof(InitExistentialAddrInst));
   for (ProtocolConformance *C : Conformances)
     declareWitnessTable(Mod, C);
   return ::new (Buffer) InitExistentialAddrInst(Loc, Existential,
@@ -1256,8 +1258,8 @@ InitExistentialRefInst::create(SILDebugLocation *Loc, SILType ExistentialType,
                                ArrayRef<ProtocolConformance *> Conformances,
                                SILFunction *F) {
   SILModule &Mod = F->getModule();
-  void *Buffer = Mod.allocateInst(sizeof(InitExistentialRefInst),
-                                  alignof(InitExistentialRefInst));
+  void *Buffer = F->allocateInst(sizeof(InitExistentialRefInst),
+                                 alignof(InitExistentialRefInst));
   for (ProtocolConformance *C : Conformances) {
     if (!C)
       continue;
@@ -1291,7 +1293,7 @@ InitExistentialMetatypeInst *InitExistentialMetatypeInst::create(
   unsigned size = sizeof(InitExistentialMetatypeInst);
   size += conformances.size() * sizeof(ProtocolConformance *);
 
-  void *buffer = M.allocateInst(size, alignof(InitExistentialMetatypeInst));
+  void *buffer = F->allocateInst(size, alignof(InitExistentialMetatypeInst));
   for (ProtocolConformance *conformance : conformances)
     if (!M.lookUpWitnessTable(conformance, false).first)
       declareWitnessTable(M, conformance);
@@ -132,11 +132,7 @@ void *SILModule::allocate(unsigned Size, unsigned Align) const {
 }
 
 void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
-  return AlignedAlloc(Size, Align);
-}
-
-void SILModule::deallocateInst(SILInstruction *I) {
-  AlignedFree(I);
+  return allocate(Size, Align);
 }
 
 SILWitnessTable *
@@ -541,6 +537,14 @@ bool SILModule::linkFunction(StringRef Name, SILModule::LinkingMode Mode) {
       .processFunction(Name);
 }
 
+bool SILModule::hasFunction(StringRef Name) {
+  if (lookUpFunction(Name))
+    return true;
+  return SILLinkerVisitor(*this, getSILLoader(), LinkingMode::LinkNormal,
+                          ExternalSource)
+      .hasFunction(Name);
+}
+
 void SILModule::linkAllWitnessTables() {
   getSILLoader()->getAllWitnessTables();
 }
@@ -573,8 +577,10 @@ void SILModule::eraseFunction(SILFunction *F) {
     F->setZombie();
 
     // This opens dead-function-removal opportunities for called functions.
-    // (References are not needed anymore.)
-    F->dropAllReferences();
+    // (References are not needed anymore.) Erasing the body also reclaims
+    // the function's instruction arena: a zombie only needs its name, type
+    // and linkage at IRGen time.
+    F->eraseBody();
   } else {
     FunctionTable.erase(F->getName());
     getFunctionList().erase(F);
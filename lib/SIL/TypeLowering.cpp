@@ -1228,6 +1228,18 @@ TypeConverter::~TypeConverter() {
     if (srcType == mappedType || isa<InOutType>(srcType))
       ti.second->~TypeLowering();
   }
+
+  // Likewise for the dependent TypeLowerings stashed per generic signature.
+  for (auto &state : DependentTypeStates) {
+    for (auto &ti : state.second.Map) {
+      // Destroy only the unique entries.
+      CanType srcType = ti.first.OrigType;
+      if (!srcType) continue;
+      CanType mappedType = ti.second->getLoweredType().getSwiftRValueType();
+      if (srcType == mappedType || isa<LValueType>(srcType))
+        ti.second->~TypeLowering();
+    }
+  }
 }
 
 void *TypeLowering::operator new(size_t size, TypeConverter &tc,
@@ -2313,7 +2325,16 @@ void TypeConverter::pushGenericContext(CanGenericSignature sig) {
   assert(!CurGenericContext && "already in generic context!");
 
   CurGenericContext = sig;
-  
+
+  // If we already lowered dependent types in this signature, take the stashed
+  // cache back instead of starting from scratch.
+  auto stashed = DependentTypeStates.find(sig);
+  if (stashed != DependentTypeStates.end()) {
+    DependentTypes = std::move(stashed->second.Map);
+    DependentBPA = std::move(stashed->second.BPA);
+    DependentTypeStates.erase(stashed);
+  }
+
   // Prepare the ArchetypeBuilder with the generic signature.
   GenericArchetypes.emplace(*M.getSwiftModule(), M.getASTContext().Diags);
   if (GenericArchetypes->addGenericSignature(sig, false))
@@ -2328,20 +2349,14 @@ void TypeConverter::popGenericContext(CanGenericSignature sig) {
   assert(GenericArchetypes.hasValue() && "not in generic context?!");
   assert(CurGenericContext == sig && "unpaired push/pop");
   
-  // Erase our cached TypeLowering objects and associated mappings for dependent
-  // types.
-  // Resetting the DependentBPA will deallocate but not run the destructor of
-  // the dependent TypeLowerings.
-  for (auto &ti : DependentTypes) {
-    // Destroy only the unique entries.
-    CanType srcType = ti.first.OrigType;
-    if (!srcType) continue;
-    CanType mappedType = ti.second->getLoweredType().getSwiftRValueType();
-    if (srcType == mappedType || isa<LValueType>(srcType))
-      ti.second->~TypeLowering();
-  }
+  // Stash our cached TypeLowering objects and associated mappings for
+  // dependent types, keyed by the signature. They store interface types only,
+  // so they remain valid when the same signature is pushed again, and the
+  // TypeConverter destructor takes care of destroying the unique entries.
+  auto &stashed = DependentTypeStates[sig];
+  stashed.Map = std::move(DependentTypes);
+  stashed.BPA = std::move(DependentBPA);
   DependentTypes.clear();
-  DependentBPA.Reset();
   GenericArchetypes.reset();
   CurGenericContext = nullptr;
 }
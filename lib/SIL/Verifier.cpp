@@ -3132,17 +3132,27 @@ void SILGlobalVariable::verify() const {
 
 /// Verify the module.
 void SILModule::verify() const {
+#ifndef NDEBUG
+  verifyStructure();
+
+  // Check all function bodies.
+  for (const SILFunction &f : *this)
+    f.verify();
+#endif
+}
+
+/// Verify the module-level structure without checking function bodies.
+void SILModule::verifyStructure() const {
 #ifndef NDEBUG
   // Uniquing set to catch symbol name collisions.
   llvm::StringSet<> symbolNames;
 
-  // Check all functions.
+  // Check all function names.
   for (const SILFunction &f : *this) {
     if (!symbolNames.insert(f.getName()).second) {
       llvm::errs() << "Symbol redefined: " << f.getName() << "!\n";
       assert(false && "triggering standard assertion failure routine");
     }
-    f.verify();
   }
 
   // Check all globals.
@@ -336,6 +336,13 @@ void emitOrDelayFunction(SILGenModule &SGM,
   // Shared thunks and Clang-imported definitions can always be delayed.
   if (constant.isThunk() || constant.isClangImported()) {
     mayDelay = true;
+  // In demand-driven emission mode, any definition that cannot be referenced
+  // from outside this emission unit waits until it is first referenced;
+  // vtables, witness tables and @objc thunks force their entries, so only
+  // genuinely unreachable bodies stay unemitted.
+  } else if (SGM.M.getOptions().EmitReachableFunctionsOnly) {
+    auto linkage = constant.getLinkage(ForDefinition);
+    mayDelay = !isPossiblyUsedExternally(linkage, SGM.M.isWholeModule());
   // Implicit decls may be delayed if they can't be used externally.
   } else {
     auto linkage = constant.getLinkage(ForDefinition);
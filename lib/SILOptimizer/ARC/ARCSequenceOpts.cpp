@@ -38,9 +38,16 @@ using namespace swift;
 
 STATISTIC(NumRefCountOpsMoved, "Total number of increments moved");
 STATISTIC(NumRefCountOpsRemoved, "Total number of increments removed");
+STATISTIC(NumRefCountOpsCoalesced, "Total number of adjacent increments and "
+                                   "decrements coalesced");
 
 llvm::cl::opt<bool> EnableLoopARC("enable-loop-arc", llvm::cl::init(true));
 
+static llvm::cl::opt<unsigned> ARCBlockLimit(
+    "arc-sequence-opts-block-limit", llvm::cl::init(16384),
+    llvm::cl::desc("Skip the whole-function ARC sequence dataflow for "
+                   "functions with more basic blocks than this"));
+
 //===----------------------------------------------------------------------===//
 //                                Code Motion
 //===----------------------------------------------------------------------===//
@@ -78,6 +85,54 @@ static SILInstruction *createDecrement(SILValue Ptr, SILInstruction *InsertPt) {
   return B.createReleaseValue(Loc, Ptr);
 }
 
+//===----------------------------------------------------------------------===//
+//                      Adjacent Operation Coalescing
+//===----------------------------------------------------------------------===//
+
+/// Merge runs of adjacent strong_retain (or strong_release) instructions on
+/// the same value into a single instruction carrying a count. Such an
+/// instruction lowers to one atomic adjustment by N instead of N separate
+/// read-modify-write operations. This catches the operations that the
+/// pairing analysis proved necessary but could not eliminate.
+static bool coalesceAdjacentRefCountOps(SILFunction &F) {
+  bool Changed = false;
+
+  for (auto &BB : F) {
+    for (auto II = BB.begin(), IE = BB.end(); II != IE;) {
+      SILInstruction *I = &*II;
+      ++II;
+
+      if (!isa<StrongRetainInst>(I) && !isa<StrongReleaseInst>(I))
+        continue;
+      auto *RCI = cast<RefCountingInst>(I);
+
+      // Only atomic operations are worth merging; the non-atomic entry
+      // points are already cheap and have no counted form.
+      if (RCI->isNonAtomic())
+        continue;
+
+      // Gather the immediately following operations of the same kind on the
+      // same value into this instruction's count.
+      unsigned Count = RCI->getCount();
+      while (II != IE) {
+        auto *Next = dyn_cast<RefCountingInst>(&*II);
+        if (!Next || Next->getKind() != RCI->getKind() ||
+            Next->isNonAtomic() ||
+            Next->getOperand(0) != RCI->getOperand(0))
+          break;
+        Count += Next->getCount();
+        ++II;
+        Next->eraseFromParent();
+        ++NumRefCountOpsCoalesced;
+        Changed = true;
+      }
+      RCI->setCount(Count);
+    }
+  }
+
+  return Changed;
+}
+
 //===----------------------------------------------------------------------===//
 //                             Mutating Callback
 //===----------------------------------------------------------------------===//
@@ -222,6 +277,16 @@ class ARCSequenceOpts : public SILFunctionTransform {
     if (!getOptions().EnableARCOptimizations)
       return;
 
+    // The sequence dataflow keeps ref count state maps for every block of the
+    // function. On huge generated functions that dominates -O time and memory
+    // for very little benefit, so leave those functions to the loop-local ARC
+    // passes.
+    if (F->size() > ARCBlockLimit) {
+      DEBUG(llvm::dbgs() << "Skipping ARC sequence opts for " << F->getName()
+                         << ": " << F->size() << " blocks\n");
+      return;
+    }
+
     if (!EnableLoopARC) {
       auto *AA = getAnalysis<AliasAnalysis>();
       auto *POTA = getAnalysis<PostOrderAnalysis>();
@@ -232,6 +297,11 @@ class ARCSequenceOpts : public SILFunctionTransform {
         processFunctionWithoutLoopSupport(*F, true, AA, POTA, RCFI, &PTFI);
         invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
       }
+
+      // Merge any adjacent operations on the same value that the pairing
+      // analysis could not eliminate.
+      if (coalesceAdjacentRefCountOps(*F))
+        invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
       return;
     }
 
@@ -259,6 +329,12 @@ class ARCSequenceOpts : public SILFunctionTransform {
     if (processFunctionWithLoopSupport(*F, AA, POTA, LRFI, LI, RCFI, &PTFI)) {
       invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
     }
+
+    // Merge any adjacent operations on the same value that the pairing
+    // analysis could not eliminate.
+    if (coalesceAdjacentRefCountOps(*F)) {
+      invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
+    }
   }
 
   StringRef getName() override { return "ARC Sequence Opts"; }
@@ -47,10 +47,16 @@ RCStateTransitionKind swift::getRCStateTransitionKind(ValueBase *V) {
   switch (V->getKind()) {
   case ValueKind::StrongRetainInst:
   case ValueKind::RetainValueInst:
+    // A coalesced operation performs several increments at once; it cannot
+    // participate in pairing, which matches operations one to one.
+    if (cast<RefCountingInst>(V)->getCount() != 1)
+      return RCStateTransitionKind::Unknown;
     return RCStateTransitionKind::StrongIncrement;
 
   case ValueKind::StrongReleaseInst:
   case ValueKind::ReleaseValueInst:
+    if (cast<RefCountingInst>(V)->getCount() != 1)
+      return RCStateTransitionKind::Unknown;
     return RCStateTransitionKind::StrongDecrement;
 
   case ValueKind::SILArgument: {
@@ -586,9 +586,13 @@ AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
     return It->second;
   }
 
-  // Flush the cache if the size of the cache is too large.
+  // Flush the cache if the size of the cache is too large. The memory
+  // behavior cache uses the same value indices for its keys, so it has to go
+  // as well: clearing the enumerator restarts its counter, and a new value
+  // could otherwise collide with a stale key.
   if (AliasCache.size() > AliasAnalysisMaxCacheSize) {
     AliasCache.clear();
+    MemoryBehaviorCache.clear();
     ValueBaseToIndex.clear();
   }
 
@@ -78,3 +78,50 @@ void BottomUpFunctionOrder::FindSCCs(SILModule &M) {
   for (auto &F : M)
     DFS(&F);
 }
+
+ArrayRef<SmallVector<unsigned, 4>> BottomUpFunctionOrder::getSCCLevels() {
+  if (!TheSCCLevels.empty())
+    return TheSCCLevels;
+
+  auto SCCs = getSCCs();
+  if (SCCs.empty())
+    return TheSCCLevels;
+
+  // Map each function to the index of the SCC containing it.
+  llvm::DenseMap<SILFunction *, unsigned> SCCIndex;
+  for (unsigned i = 0, e = SCCs.size(); i != e; ++i)
+    for (auto *F : SCCs[i])
+      SCCIndex[F] = i;
+
+  // An SCC's level is one more than the deepest level among its callees,
+  // ignoring calls within the SCC itself. Since getSCCs() is bottom-up,
+  // every callee SCC has already been assigned a level.
+  SmallVector<unsigned, 32> Level(SCCs.size(), 0);
+  unsigned NumLevels = 1;
+  for (unsigned i = 0, e = SCCs.size(); i != e; ++i) {
+    for (auto *F : SCCs[i]) {
+      for (auto &B : *F) {
+        for (auto &I : B) {
+          auto FAS = FullApplySite::isa(&I);
+          if (!FAS)
+            continue;
+
+          for (auto *CalleeFn : BCA->getCalleeList(FAS)) {
+            auto Known = SCCIndex.find(CalleeFn);
+            if (Known == SCCIndex.end() || Known->second == i)
+              continue;
+            assert(Known->second < i && "SCCs are not in bottom-up order!");
+            Level[i] = std::max(Level[i], Level[Known->second] + 1);
+          }
+        }
+      }
+    }
+    NumLevels = std::max(NumLevels, Level[i] + 1);
+  }
+
+  TheSCCLevels.resize(NumLevels);
+  for (unsigned i = 0, e = SCCs.size(); i != e; ++i)
+    TheSCCLevels[Level[i]].push_back(i);
+
+  return TheSCCLevels;
+}
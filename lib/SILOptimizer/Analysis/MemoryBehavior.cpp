@@ -321,9 +321,13 @@ AliasAnalysis::computeMemoryBehavior(SILInstruction *Inst, SILValue V,
     return It->second;
   }
 
-  // Flush the cache if the size of the cache is too large.
+  // Flush the cache if the size of the cache is too large. The alias cache
+  // uses the same value indices for its keys, so it has to go as well:
+  // clearing the enumerator restarts its counter, and a new value could
+  // otherwise collide with a stale key.
   if (MemoryBehaviorCache.size() > MemoryBehaviorAnalysisMaxCacheSize) {
     MemoryBehaviorCache.clear();
+    AliasCache.clear();
     ValueBaseToIndex.clear();
   }
 
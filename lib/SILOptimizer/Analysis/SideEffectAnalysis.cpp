@@ -171,6 +171,24 @@ bool SideEffectAnalysis::getDefinedEffects(FunctionEffects &Effects,
   return false;
 }
 
+bool SideEffectAnalysis::getSerializedEffects(FunctionEffects &Effects,
+                                              SILFunction *F) {
+  if (!F->hasFunctionSummary())
+    return false;
+
+  unsigned Summary = F->getSummaryEffects();
+  Effects.GlobalEffects.Reads = (Summary & SILFunction::SummaryMayRead) != 0;
+  Effects.GlobalEffects.Writes = (Summary & SILFunction::SummaryMayWrite) != 0;
+  Effects.GlobalEffects.Retains =
+      (Summary & SILFunction::SummaryMayRetain) != 0;
+  Effects.GlobalEffects.Releases =
+      (Summary & SILFunction::SummaryMayRelease) != 0;
+  Effects.AllocsObjects = (Summary & SILFunction::SummaryMayAllocObjects) != 0;
+  Effects.Traps = (Summary & SILFunction::SummaryMayTrap) != 0;
+  Effects.ReadsRC = (Summary & SILFunction::SummaryMayReadRC) != 0;
+  return true;
+}
+
 bool SideEffectAnalysis::getSemanticEffects(FunctionEffects &FE,
                                             ArraySemanticsCall ASC) {
   assert(ASC.hasSelf());
@@ -253,7 +271,14 @@ void SideEffectAnalysis::analyzeFunction(FunctionInfo *FInfo,
   }
   
   if (!FInfo->F->isDefinition()) {
-    // We can't assume anything about external functions.
+    // For an external function we can at least use the summary which was
+    // serialized with the function.
+    if (getSerializedEffects(FInfo->FE, FInfo->F)) {
+      DEBUG(llvm::dbgs() << "  -- use serialized summary of " <<
+            FInfo->F->getName() << '\n');
+      return;
+    }
+    // Otherwise we can't assume anything about the function.
     DEBUG(llvm::dbgs() << "  -- is external " << FInfo->F->getName() << '\n');
     FInfo->FE.setWorstEffects();
     return;
@@ -0,0 +1,516 @@
+//===--- ValueRangeAnalysis.cpp - SIL Value Range Analysis ----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "sil-value-range-analysis"
+
+#include "swift/SILOptimizer/Analysis/ValueRangeAnalysis.h"
+#include "swift/SIL/SILArgument.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+using llvm::APInt;
+
+/// Limit on the recursion depth when following the instructions which
+/// produced a value.
+static const unsigned MaxValueRangeDepth = 8;
+
+unsigned swift::getFixedBuiltinIntegerWidth(SILValue V) {
+  auto IntTy = V.getType().getAs<BuiltinIntegerType>();
+  if (!IntTy || !IntTy->isFixedWidth())
+    return 0;
+  return IntTy->getFixedWidth();
+}
+
+/// Compute the range of an addition from the ranges of its operands.
+/// If one of the bound additions overflows we cannot say anything.
+static ValueRange getAddRange(const ValueRange &L, const ValueRange &R) {
+  ValueRange Result(L.getBitWidth());
+  bool Overflow = false;
+  APInt SMin = L.getSignedMin().sadd_ov(R.getSignedMin(), Overflow);
+  if (!Overflow) {
+    APInt SMax = L.getSignedMax().sadd_ov(R.getSignedMax(), Overflow);
+    if (!Overflow) {
+      Result.clampSignedMin(SMin);
+      Result.clampSignedMax(SMax);
+    }
+  }
+  Overflow = false;
+  APInt UMin = L.getUnsignedMin().uadd_ov(R.getUnsignedMin(), Overflow);
+  if (!Overflow) {
+    APInt UMax = L.getUnsignedMax().uadd_ov(R.getUnsignedMax(), Overflow);
+    if (!Overflow) {
+      Result.clampUnsignedMin(UMin);
+      Result.clampUnsignedMax(UMax);
+    }
+  }
+  return Result;
+}
+
+/// Compute the range of a subtraction from the ranges of its operands.
+static ValueRange getSubRange(const ValueRange &L, const ValueRange &R) {
+  ValueRange Result(L.getBitWidth());
+  bool Overflow = false;
+  APInt SMin = L.getSignedMin().ssub_ov(R.getSignedMax(), Overflow);
+  if (!Overflow) {
+    APInt SMax = L.getSignedMax().ssub_ov(R.getSignedMin(), Overflow);
+    if (!Overflow) {
+      Result.clampSignedMin(SMin);
+      Result.clampSignedMax(SMax);
+    }
+  }
+  Overflow = false;
+  APInt UMin = L.getUnsignedMin().usub_ov(R.getUnsignedMax(), Overflow);
+  if (!Overflow) {
+    APInt UMax = L.getUnsignedMax().usub_ov(R.getUnsignedMin(), Overflow);
+    if (!Overflow) {
+      Result.clampUnsignedMin(UMin);
+      Result.clampUnsignedMax(UMax);
+    }
+  }
+  return Result;
+}
+
+/// Compute the range of a multiplication from the ranges of its operands.
+/// Only the easy case of two non-negative operands is handled.
+static ValueRange getMulRange(const ValueRange &L, const ValueRange &R) {
+  ValueRange Result(L.getBitWidth());
+  if (!L.isKnownNonNegative() || !R.isKnownNonNegative())
+    return Result;
+  bool Overflow = false;
+  APInt Max = L.getSignedMax().smul_ov(R.getSignedMax(), Overflow);
+  if (Overflow)
+    return Result;
+  APInt Min = L.getSignedMin() * R.getSignedMin();
+  Result.clampSignedMin(Min);
+  Result.clampSignedMax(Max);
+  Result.clampUnsignedMin(Min);
+  Result.clampUnsignedMax(Max);
+  return Result;
+}
+
+/// Compute the range of the first result of the arithmetic-with-overflow
+/// builtin \p BI.  If the operand ranges prove that the operation cannot
+/// overflow, the result equals the mathematical result and the bound
+/// arithmetic above is exact; otherwise the result may have wrapped and we
+/// return the full range.
+static ValueRange getOverflowBuiltinRange(BuiltinInst *BI, unsigned Width,
+                                          unsigned Depth) {
+  if (getFixedBuiltinIntegerWidth(BI->getOperand(0)) != Width ||
+      getFixedBuiltinIntegerWidth(BI->getOperand(1)) != Width)
+    return ValueRange(Width);
+  ValueRange L = computeValueRange(BI->getOperand(0), Depth + 1);
+  ValueRange R = computeValueRange(BI->getOperand(1), Depth + 1);
+  switch (BI->getBuiltinInfo().ID) {
+  default:
+    break;
+  case BuiltinValueKind::SAddOver:
+  case BuiltinValueKind::UAddOver:
+    return getAddRange(L, R);
+  case BuiltinValueKind::SSubOver:
+  case BuiltinValueKind::USubOver:
+    return getSubRange(L, R);
+  case BuiltinValueKind::SMulOver:
+  case BuiltinValueKind::UMulOver:
+    return getMulRange(L, R);
+  }
+  return ValueRange(Width);
+}
+
+/// Compute the range of the builtin instruction \p BI.
+static ValueRange getBuiltinRange(BuiltinInst *BI, unsigned Width,
+                                  unsigned Depth) {
+  ValueRange Result(Width);
+  switch (BI->getBuiltinInfo().ID) {
+  default:
+    break;
+
+  // For the wrapping operations the bound arithmetic is only used when it
+  // does not overflow, in which case no operand combination can wrap either.
+  case BuiltinValueKind::Add:
+    return getAddRange(computeValueRange(BI->getOperand(0), Depth + 1),
+                       computeValueRange(BI->getOperand(1), Depth + 1));
+  case BuiltinValueKind::Sub:
+    return getSubRange(computeValueRange(BI->getOperand(0), Depth + 1),
+                       computeValueRange(BI->getOperand(1), Depth + 1));
+  case BuiltinValueKind::Mul:
+    return getMulRange(computeValueRange(BI->getOperand(0), Depth + 1),
+                       computeValueRange(BI->getOperand(1), Depth + 1));
+
+  case BuiltinValueKind::ZExt:
+  case BuiltinValueKind::ZExtOrBitCast: {
+    unsigned SrcWidth = getFixedBuiltinIntegerWidth(BI->getOperand(0));
+    if (!SrcWidth || SrcWidth > Width)
+      break;
+    ValueRange Src = computeValueRange(BI->getOperand(0), Depth + 1);
+    // The result is the zero extended unsigned range and is non-negative
+    // if the width actually grew.
+    APInt Min = Src.getUnsignedMin().zext(Width);
+    APInt Max = Src.getUnsignedMax().zext(Width);
+    Result.clampUnsignedMin(Min);
+    Result.clampUnsignedMax(Max);
+    if (SrcWidth < Width) {
+      Result.clampSignedMin(Min);
+      Result.clampSignedMax(Max);
+    }
+    break;
+  }
+
+  case BuiltinValueKind::SExt:
+  case BuiltinValueKind::SExtOrBitCast: {
+    unsigned SrcWidth = getFixedBuiltinIntegerWidth(BI->getOperand(0));
+    if (!SrcWidth || SrcWidth > Width)
+      break;
+    ValueRange Src = computeValueRange(BI->getOperand(0), Depth + 1);
+    APInt Min = Src.getSignedMin().sext(Width);
+    APInt Max = Src.getSignedMax().sext(Width);
+    Result.clampSignedMin(Min);
+    Result.clampSignedMax(Max);
+    if (Min.isNonNegative()) {
+      Result.clampUnsignedMin(Min);
+      Result.clampUnsignedMax(Max);
+    }
+    break;
+  }
+
+  case BuiltinValueKind::Trunc:
+  case BuiltinValueKind::TruncOrBitCast: {
+    unsigned SrcWidth = getFixedBuiltinIntegerWidth(BI->getOperand(0));
+    if (!SrcWidth || SrcWidth < Width)
+      break;
+    ValueRange Src = computeValueRange(BI->getOperand(0), Depth + 1);
+    // Only useful if the source provably fits into the narrow type.
+    if (Src.getUnsignedMax().getActiveBits() > Width)
+      break;
+    APInt Min = Src.getUnsignedMin().trunc(Width);
+    APInt Max = Src.getUnsignedMax().trunc(Width);
+    Result.clampUnsignedMin(Min);
+    Result.clampUnsignedMax(Max);
+    if (Max.isNonNegative()) {
+      Result.clampSignedMin(Min);
+      Result.clampSignedMax(Max);
+    }
+    break;
+  }
+
+  case BuiltinValueKind::And: {
+    // Masking with a constant bounds the result by the mask.
+    for (unsigned Idx = 0; Idx < 2; ++Idx) {
+      if (auto *Mask = dyn_cast<IntegerLiteralInst>(BI->getOperand(Idx))) {
+        Result.clampUnsignedMax(Mask->getValue());
+        if (Mask->getValue().isNonNegative()) {
+          Result.clampSignedMin(APInt::getNullValue(Width));
+          Result.clampSignedMax(Mask->getValue());
+        }
+      }
+    }
+    break;
+  }
+
+  case BuiltinValueKind::LShr: {
+    if (auto *Shift = dyn_cast<IntegerLiteralInst>(BI->getOperand(1))) {
+      if (Shift->getValue().uge(Width))
+        break;
+      unsigned Amount = Shift->getValue().getZExtValue();
+      ValueRange Src = computeValueRange(BI->getOperand(0), Depth + 1);
+      APInt Max = Src.getUnsignedMax().lshr(Amount);
+      Result.clampUnsignedMax(Max);
+      if (Amount > 0 || Max.isNonNegative()) {
+        Result.clampSignedMin(APInt::getNullValue(Width));
+        Result.clampSignedMax(Max);
+      }
+    }
+    break;
+  }
+
+  case BuiltinValueKind::UDiv: {
+    if (auto *Divisor = dyn_cast<IntegerLiteralInst>(BI->getOperand(1))) {
+      if (!Divisor->getValue())
+        break;
+      ValueRange Src = computeValueRange(BI->getOperand(0), Depth + 1);
+      APInt Max = Src.getUnsignedMax().udiv(Divisor->getValue());
+      Result.clampUnsignedMax(Max);
+      if (Max.isNonNegative()) {
+        Result.clampSignedMin(APInt::getNullValue(Width));
+        Result.clampSignedMax(Max);
+      }
+    }
+    break;
+  }
+
+  case BuiltinValueKind::URem: {
+    if (auto *Divisor = dyn_cast<IntegerLiteralInst>(BI->getOperand(1))) {
+      if (!Divisor->getValue())
+        break;
+      APInt Max = Divisor->getValue() - 1;
+      Result.clampUnsignedMax(Max);
+      if (Max.isNonNegative()) {
+        Result.clampSignedMin(APInt::getNullValue(Width));
+        Result.clampSignedMax(Max);
+      }
+    }
+    break;
+  }
+  }
+  return Result;
+}
+
+ValueRange swift::computeValueRange(SILValue V, unsigned Depth) {
+  unsigned Width = getFixedBuiltinIntegerWidth(V);
+  assert(Width && "value is not a fixed-width builtin integer");
+
+  if (Depth >= MaxValueRangeDepth)
+    return ValueRange(Width);
+
+  if (auto *IL = dyn_cast<IntegerLiteralInst>(V))
+    return ValueRange(IL->getValue());
+
+  if (auto *BI = dyn_cast<BuiltinInst>(V))
+    return getBuiltinRange(BI, Width, Depth);
+
+  // The first result of an arithmetic-with-overflow builtin.
+  if (auto *TEI = dyn_cast<TupleExtractInst>(V)) {
+    auto *BI = dyn_cast<BuiltinInst>(TEI->getOperand());
+    if (BI && TEI->getFieldNo() == 0)
+      return getOverflowBuiltinRange(BI, Width, Depth);
+    return ValueRange(Width);
+  }
+
+  // Look through struct wrappers such as Int around Builtin.Int64.
+  if (auto *SEI = dyn_cast<StructExtractInst>(V)) {
+    if (auto *SI = dyn_cast<StructInst>(SEI->getOperand()))
+      return computeValueRange(SI->getFieldValue(SEI->getField()), Depth + 1);
+    return ValueRange(Width);
+  }
+
+  // The result of a select is bounded by all of its case results.
+  if (auto *SVI = dyn_cast<SelectValueInst>(V)) {
+    ValueRange Result =
+        computeValueRange(SILValue(SVI->getDefaultResult()), Depth + 1);
+    for (unsigned i = 0, e = SVI->getNumCases(); i != e; ++i)
+      Result.mergeWith(computeValueRange(SVI->getCase(i).second, Depth + 1));
+    return Result;
+  }
+
+  return ValueRange(Width);
+}
+
+//===----------------------------------------------------------------------===//
+//                             ValueRangeInfo
+//===----------------------------------------------------------------------===//
+
+ValueRangeInfo::ValueRangeInfo(SILFunction *F) : DT(F) {
+  for (auto &BB : *F)
+    if (auto *CBI = dyn_cast<CondBranchInst>(BB.getTerminator()))
+      registerBranchConstraints(CBI);
+}
+
+void ValueRangeInfo::registerBranchConstraints(CondBranchInst *CBI) {
+  auto *CMP = dyn_cast<BuiltinInst>(CBI->getCondition());
+  if (!CMP)
+    return;
+
+  SILValue Left = CMP->getOperand(0);
+  SILValue Right = CMP->getOperand(1);
+  unsigned Width = getFixedBuiltinIntegerWidth(Left);
+  if (!Width || getFixedBuiltinIntegerWidth(Right) != Width)
+    return;
+
+  // The condition only holds in the successor (and the blocks it dominates)
+  // if the successor has a single predecessor; otherwise the blocks it
+  // dominates can be reached without passing the branch.
+  SILBasicBlock *TrueBB = CBI->getTrueBB();
+  SILBasicBlock *FalseBB = CBI->getFalseBB();
+  if (!TrueBB->getSinglePredecessor())
+    TrueBB = nullptr;
+  if (!FalseBB->getSinglePredecessor())
+    FalseBB = nullptr;
+
+  typedef BranchConstraint::Relation Relation;
+
+  // On the true edge the comparison holds; on the false edge its negation
+  // holds.  Both are canonicalized to "Left Relation Right".
+  switch (CMP->getBuiltinInfo().ID) {
+  default:
+    return;
+  case BuiltinValueKind::ICMP_EQ:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Left, Right, Relation::EQ});
+    return;
+  case BuiltinValueKind::ICMP_NE:
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Left, Right, Relation::EQ});
+    return;
+  case BuiltinValueKind::ICMP_SLT:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Left, Right, Relation::SLT});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Right, Left, Relation::SLE});
+    return;
+  case BuiltinValueKind::ICMP_SLE:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Left, Right, Relation::SLE});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Right, Left, Relation::SLT});
+    return;
+  case BuiltinValueKind::ICMP_SGT:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Right, Left, Relation::SLT});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Left, Right, Relation::SLE});
+    return;
+  case BuiltinValueKind::ICMP_SGE:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Right, Left, Relation::SLE});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Left, Right, Relation::SLT});
+    return;
+  case BuiltinValueKind::ICMP_ULT:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Left, Right, Relation::ULT});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Right, Left, Relation::ULE});
+    return;
+  case BuiltinValueKind::ICMP_ULE:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Left, Right, Relation::ULE});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Right, Left, Relation::ULT});
+    return;
+  case BuiltinValueKind::ICMP_UGT:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Right, Left, Relation::ULT});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Left, Right, Relation::ULE});
+    return;
+  case BuiltinValueKind::ICMP_UGE:
+    if (TrueBB)
+      Constraints.push_back({TrueBB, Right, Left, Relation::ULE});
+    if (FalseBB)
+      Constraints.push_back({FalseBB, Left, Right, Relation::ULT});
+    return;
+  }
+}
+
+void ValueRangeInfo::applyConstraint(const BranchConstraint &C, SILValue V,
+                                     ValueRange &R) {
+  typedef BranchConstraint::Relation Relation;
+
+  if (C.Left == V) {
+    // V Relation Other.
+    ValueRange Other = computeValueRange(C.Right);
+    switch (C.Rel) {
+    case Relation::EQ:
+      R.clampSignedMin(Other.getSignedMin());
+      R.clampSignedMax(Other.getSignedMax());
+      R.clampUnsignedMin(Other.getUnsignedMin());
+      R.clampUnsignedMax(Other.getUnsignedMax());
+      return;
+    case Relation::SLT:
+      if (!Other.getSignedMax().isMinSignedValue())
+        R.clampSignedMax(Other.getSignedMax() - 1);
+      return;
+    case Relation::SLE:
+      R.clampSignedMax(Other.getSignedMax());
+      return;
+    case Relation::ULT:
+      if (Other.getUnsignedMax() != 0)
+        R.clampUnsignedMax(Other.getUnsignedMax() - 1);
+      return;
+    case Relation::ULE:
+      R.clampUnsignedMax(Other.getUnsignedMax());
+      return;
+    }
+  }
+
+  // Other Relation V.
+  ValueRange Other = computeValueRange(C.Left);
+  switch (C.Rel) {
+  case Relation::EQ:
+    R.clampSignedMin(Other.getSignedMin());
+    R.clampSignedMax(Other.getSignedMax());
+    R.clampUnsignedMin(Other.getUnsignedMin());
+    R.clampUnsignedMax(Other.getUnsignedMax());
+    return;
+  case Relation::SLT:
+    if (!Other.getSignedMin().isMaxSignedValue())
+      R.clampSignedMin(Other.getSignedMin() + 1);
+    return;
+  case Relation::SLE:
+    R.clampSignedMin(Other.getSignedMin());
+    return;
+  case Relation::ULT:
+    if (!Other.getUnsignedMin().isMaxValue())
+      R.clampUnsignedMin(Other.getUnsignedMin() + 1);
+    return;
+  case Relation::ULE:
+    R.clampUnsignedMin(Other.getUnsignedMin());
+    return;
+  }
+}
+
+ValueRange ValueRangeInfo::getRangeAt(SILValue V, SILInstruction *At) {
+  ValueRange R = computeValueRange(V);
+  for (auto &C : Constraints) {
+    if (C.Left != V && C.Right != V)
+      continue;
+    if (!DT.dominates(C.DominatingBlock, At->getParent()))
+      continue;
+    applyConstraint(C, V, R);
+  }
+  return R;
+}
+
+bool ValueRangeInfo::cannotOverflow(BuiltinInst *BI, SILInstruction *At) {
+  unsigned Width = getFixedBuiltinIntegerWidth(BI->getOperand(0));
+  if (!Width || getFixedBuiltinIntegerWidth(BI->getOperand(1)) != Width)
+    return false;
+
+  ValueRange L = getRangeAt(BI->getOperand(0), At);
+  ValueRange R = getRangeAt(BI->getOperand(1), At);
+  bool Overflow = false, Overflow2 = false;
+
+  switch (BI->getBuiltinInfo().ID) {
+  default:
+    return false;
+  case BuiltinValueKind::SAddOver:
+    L.getSignedMin().sadd_ov(R.getSignedMin(), Overflow);
+    L.getSignedMax().sadd_ov(R.getSignedMax(), Overflow2);
+    return !Overflow && !Overflow2;
+  case BuiltinValueKind::UAddOver:
+    L.getUnsignedMax().uadd_ov(R.getUnsignedMax(), Overflow);
+    return !Overflow;
+  case BuiltinValueKind::SSubOver:
+    L.getSignedMin().ssub_ov(R.getSignedMax(), Overflow);
+    L.getSignedMax().ssub_ov(R.getSignedMin(), Overflow2);
+    return !Overflow && !Overflow2;
+  case BuiltinValueKind::USubOver:
+    // A - B cannot underflow if A >= B for all possible values.
+    return L.getUnsignedMin().uge(R.getUnsignedMax());
+  case BuiltinValueKind::SMulOver: {
+    // Check all four corner products.
+    APInt Corners[2][2] = {{L.getSignedMin(), L.getSignedMax()},
+                           {R.getSignedMin(), R.getSignedMax()}};
+    for (unsigned i = 0; i < 2; ++i)
+      for (unsigned j = 0; j < 2; ++j) {
+        Corners[0][i].smul_ov(Corners[1][j], Overflow);
+        if (Overflow)
+          return false;
+      }
+    return true;
+  }
+  case BuiltinValueKind::UMulOver:
+    L.getUnsignedMax().umul_ov(R.getUnsignedMax(), Overflow);
+    return !Overflow;
+  }
+}
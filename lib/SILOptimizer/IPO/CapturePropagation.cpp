@@ -46,23 +46,34 @@ protected:
 };
 } // namespace
 
-static LiteralInst *getConstant(SILValue V) {
+/// Return the instruction to propagate as the constant for \p V, or null if
+/// \p V is not a foldable constant.
+static SILInstruction *getConstant(SILValue V) {
   if (auto I = dyn_cast<ThinToThickFunctionInst>(V))
     return getConstant(I->getOperand());
-  return dyn_cast<LiteralInst>(V);
-}
-
-static bool isOptimizableConstant(SILValue V) {
   // We do not optimize string literals of length > 32 since we would need to
   // encode them into the symbol name for uniqueness.
   if (auto *SLI = dyn_cast<StringLiteralInst>(V))
-    return SLI->getValue().size() <= 32;
-  return true;
+    return SLI->getValue().size() <= 32 ? SLI : nullptr;
+  // Metatypes of fully concrete types are constants.
+  if (auto *MTI = dyn_cast<MetatypeInst>(V)) {
+    if (MTI->getType().getSwiftRValueType()->hasArchetype())
+      return nullptr;
+    return MTI;
+  }
+  // A struct or tuple is a constant if everything it is built from is.
+  if (isa<StructInst>(V) || isa<TupleInst>(V)) {
+    auto *Aggregate = cast<SILInstruction>(V.getDef());
+    for (auto &Op : Aggregate->getAllOperands())
+      if (!getConstant(Op.get()))
+        return nullptr;
+    return Aggregate;
+  }
+  return dyn_cast<LiteralInst>(V);
 }
 
 static bool isConstant(SILValue V) {
-  V = getConstant(V);
-  return V && isOptimizableConstant(V);
+  return getConstant(V) != nullptr;
 }
 
 static llvm::SmallString<64> getClonedName(PartialApplyInst *PAI,
@@ -74,7 +85,7 @@ static llvm::SmallString<64> getClonedName(PartialApplyInst *PAI,
   auto P = Mangle::SpecializationPass::CapturePropagation;
   Mangle::FunctionSignatureSpecializationMangler Mangler(P, M, F);
 
-  // We know that all arguments are literal insts.
+  // We know that all arguments are foldable constants.
   auto Args = PAI->getArguments();
   for (unsigned i : indices(Args))
     Mangler.setArgumentConstantProp(i, getConstant(Args[i]));
@@ -133,7 +144,8 @@ protected:
 } // namespace
 
 /// Clone a constant value. Recursively walk the operand chain through cast
-/// instructions to ensure that all dependents are cloned. Note that the
+/// instructions and constant aggregates to ensure that all dependents are
+/// cloned. Note that the
 /// original value may not belong to the same function as the one being cloned
 /// by cloneBlocks() (they may be from the partial apply caller).
 void CapturePropagationCloner::cloneConstValue(SILValue Val) {
@@ -147,11 +159,10 @@ void CapturePropagationCloner::cloneConstValue(SILValue Val) {
   if (II != InstructionMap.end())
     return;
 
-  if (Inst->getNumOperands() > 0) {
-    // Only handle single operands for simple recursion without a worklist.
-    assert(Inst->getNumOperands() == 1 && "expected single-operand cast");
-    cloneConstValue(Inst->getOperand(0));
-  }
+  // Clone everything the constant is built from first: the single operand of
+  // a cast, or all elements of a constant aggregate.
+  for (auto &Op : Inst->getAllOperands())
+    cloneConstValue(Op.get());
   visit(Inst);
 }
 
@@ -267,17 +278,27 @@ void CapturePropagation::rewritePartialApply(PartialApplyInst *OrigPAI,
 }
 
 /// For now, we conservative only specialize if doing so can eliminate dynamic
-/// dispatch.
+/// dispatch, or expose a projection of a propagated constant aggregate to the
+/// constant folder.
 ///
 /// TODO: Check for other profitable constant propagation, like builtin compare.
-static bool isProfitable(SILFunction *Callee) {
+static bool isProfitable(SILFunction *Callee, PartialApplyInst *PAI) {
   SILBasicBlock *EntryBB = &*Callee->begin();
-  for (auto *Arg : EntryBB->getBBArgs()) {
+  unsigned FirstCapturedIdx =
+      EntryBB->bbarg_size() - PAI->getArguments().size();
+  for (unsigned Idx : indices(EntryBB->getBBArgs())) {
+    SILArgument *Arg = EntryBB->getBBArg(Idx);
     for (auto *Operand : Arg->getUses()) {
-      if (auto *AI = dyn_cast<ApplyInst>(Operand->getUser())) {
+      auto *User = Operand->getUser();
+      if (auto *AI = dyn_cast<ApplyInst>(User)) {
         if (AI->getCallee() == Operand->get())
           return true;
       }
+      // Projecting an element out of a captured constant aggregate yields a
+      // constant the mandatory passes can fold.
+      if (Idx >= FirstCapturedIdx &&
+          (isa<StructExtractInst>(User) || isa<TupleExtractInst>(User)))
+        return true;
     }
   }
   return false;
@@ -301,7 +322,7 @@ bool CapturePropagation::optimizePartialApply(PartialApplyInst *PAI) {
       return false;
   }
   SILFunction *SubstF = FRI->getReferencedFunction();
-  if (SubstF->isExternalDeclaration() || !isProfitable(SubstF))
+  if (SubstF->isExternalDeclaration() || !isProfitable(SubstF, PAI))
     return false;
 
   DEBUG(llvm::dbgs() << "Specializing closure for constant arguments:\n"
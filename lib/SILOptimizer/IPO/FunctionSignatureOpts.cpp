@@ -839,6 +839,14 @@ moveFunctionBodyToNewFunctionWithName(SILFunction *F,
   F->setThunk(IsThunk);
   assert(F->getDebugScope()->SILFn != NewF->getDebugScope()->SILFn);
 
+  // If the old entry point is visible to other modules, serialize its
+  // forwarding body.  Optimized clients then deserialize and inline the
+  // thunk and bind directly to the optimized entry point, which shares the
+  // original function's public linkage; unoptimized clients keep calling
+  // the old symbol with the old ABI.
+  if (hasPublicVisibility(F->getLinkage()) && !F->isFragile())
+    F->setFragile(IsFragile);
+
   return NewF;
 }
 
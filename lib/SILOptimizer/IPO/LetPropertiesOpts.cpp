@@ -312,8 +312,20 @@ LetPropertiesOpt::getInitializer(NominalTypeDecl *NTD, VarDecl *Property,
         // Find the SIL body of this initializer.
         auto SDR = SILDeclRef(FD, InitializerKind);
         Init = Module->lookUpFunction(SDR);
+        if (!Init) {
+          // The initializer is not in this module.  If the defining module
+          // serialized its body (e.g. a fragile initializer), link it in
+          // and analyze it like a local one.  If only a declaration can be
+          // deserialized, findStoredValue fails on the empty body and the
+          // property is conservatively rejected.
+          Module->linkFunction(SDR, SILModule::LinkingMode::LinkAll);
+          Init = Module->lookUpFunction(SDR);
+        }
+        // If the body is not available at all, nothing is known about the
+        // value this initializer stores; the property must be rejected, or
+        // the remaining initializers would wrongly be taken as exhaustive.
         if (!Init)
-          continue;
+          return false;
         // Analyze the body of the constructor.
         SmallVector<SILInstruction *, 8> Insns;
         if (!findStoredValue(Init, Property, Insns))
@@ -0,0 +1,295 @@
+//===--- MergeFunctions.cpp - Merge identical functions -------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Generic specialization and thunk emission frequently produce functions
+// whose bodies are structurally identical. This pass finds such duplicates
+// and redirects all function_ref instructions to a single representative so
+// that the duplicates become dead and are cleaned up by dead function
+// elimination instead of being lowered through IRGen and LLVM.
+//
+// Functions are bucketed by a structural hash over their instruction kinds
+// and then compared instruction by instruction under a mapping of values and
+// basic blocks. The duplicate definitions themselves are left in place: they
+// may still be referenced from vtables, witness tables or other modules, in
+// which case they simply stay alive.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "sil-merge-functions"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Utils/Local.h"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SIL/SILUndef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+STATISTIC(NumFunctionsMerged, "Number of identical functions merged");
+
+/// Returns true if \p F may be considered for merging at all.
+static bool isEligibleFunction(SILFunction *F) {
+  if (F->isExternalDeclaration())
+    return false;
+
+  // ObjC entry points are called by name through the runtime.
+  if (F->getRepresentation() == SILFunctionTypeRepresentation::ObjCMethod)
+    return false;
+
+  return true;
+}
+
+/// Computes a hash over the structure of \p F which is invariant under the
+/// value and block renamings that areEquivalentFunctions tolerates. Functions
+/// with different hashes can not be equivalent.
+static uint64_t getStructuralHash(SILFunction *F) {
+  llvm::SmallVector<unsigned, 64> Data;
+  Data.push_back(F->size());
+  for (SILBasicBlock &BB : *F) {
+    Data.push_back(BB.getNumBBArg());
+    for (SILInstruction &I : BB)
+      Data.push_back(unsigned(I.getKind()));
+  }
+  // Keep clear of the DenseMap key sentinels.
+  return uint64_t(llvm::hash_combine_range(Data.begin(), Data.end())) >> 2;
+}
+
+namespace {
+
+/// Compares two functions instruction by instruction, building up a mapping
+/// from the values and blocks of the first function to the values and blocks
+/// of the second.
+class FunctionComparator {
+  llvm::DenseMap<const ValueBase *, const ValueBase *> ValueMap;
+  llvm::DenseMap<const SILBasicBlock *, const SILBasicBlock *> BlockMap;
+
+  /// Returns true if operand \p V1 of the first function corresponds to
+  /// operand \p V2 of the second.
+  bool isMappedValue(SILValue V1, SILValue V2) {
+    if (V1.getResultNumber() != V2.getResultNumber())
+      return false;
+    if (isa<SILUndef>(V1.getDef()))
+      return isa<SILUndef>(V2.getDef()) && V1.getType() == V2.getType();
+    auto Iter = ValueMap.find(V1.getDef());
+    return Iter != ValueMap.end() && Iter->second == V2.getDef();
+  }
+
+  /// Returns true if the successor blocks of \p T1 correspond to the
+  /// successor blocks of \p T2.
+  bool hasMappedSuccessors(TermInst *T1, TermInst *T2) {
+    auto Succs1 = T1->getSuccessors();
+    auto Succs2 = T2->getSuccessors();
+    if (Succs1.size() != Succs2.size())
+      return false;
+    for (unsigned i = 0, e = Succs1.size(); i != e; ++i)
+      if (BlockMap[Succs1[i].getBB()] != Succs2[i].getBB())
+        return false;
+    return true;
+  }
+
+  /// Returns true if the terminators \p T1 and \p T2 match under the value
+  /// and block mapping. isIdenticalTo does not handle terminators, so the
+  /// supported kinds are compared here; unsupported kinds conservatively
+  /// fail the comparison.
+  bool matchTerminators(TermInst *T1, TermInst *T2) {
+    if (T1->getKind() != T2->getKind() ||
+        T1->getNumOperands() != T2->getNumOperands())
+      return false;
+
+    for (unsigned i = 0, e = T1->getNumOperands(); i != e; ++i)
+      if (!isMappedValue(T1->getOperand(i), T2->getOperand(i)))
+        return false;
+
+    if (!hasMappedSuccessors(T1, T2))
+      return false;
+
+    switch (T1->getKind()) {
+    case ValueKind::BranchInst:
+    case ValueKind::ReturnInst:
+    case ValueKind::ThrowInst:
+    case ValueKind::UnreachableInst:
+      return true;
+    case ValueKind::CondBranchInst:
+      return cast<CondBranchInst>(T1)->getTrueArgs().size() ==
+             cast<CondBranchInst>(T2)->getTrueArgs().size();
+    case ValueKind::TryApplyInst:
+      return cast<TryApplyInst>(T1)->getSubstitutions() ==
+             cast<TryApplyInst>(T2)->getSubstitutions();
+    case ValueKind::SwitchEnumInst:
+      return matchSwitchEnum(cast<SwitchEnumInst>(T1),
+                             cast<SwitchEnumInst>(T2));
+    case ValueKind::SwitchEnumAddrInst:
+      return matchSwitchEnum(cast<SwitchEnumAddrInst>(T1),
+                             cast<SwitchEnumAddrInst>(T2));
+    case ValueKind::CheckedCastBranchInst: {
+      auto *CCB1 = cast<CheckedCastBranchInst>(T1);
+      auto *CCB2 = cast<CheckedCastBranchInst>(T2);
+      return CCB1->isExact() == CCB2->isExact() &&
+             CCB1->getCastType() == CCB2->getCastType();
+    }
+    default:
+      return false;
+    }
+  }
+
+  template <typename SwitchInstTy>
+  bool matchSwitchEnum(SwitchInstTy *S1, SwitchInstTy *S2) {
+    if (S1->getNumCases() != S2->getNumCases() ||
+        S1->hasDefault() != S2->hasDefault())
+      return false;
+    // The successor blocks have already been matched; the case elements must
+    // select them in the same order.
+    for (unsigned i = 0, e = S1->getNumCases(); i != e; ++i)
+      if (S1->getCase(i).first != S2->getCase(i).first)
+        return false;
+    return true;
+  }
+
+public:
+  /// Returns true if \p F1 and \p F2 have equivalent definitions, i.e.
+  /// redirecting a reference from one to the other can not change program
+  /// behavior.
+  bool areEquivalentFunctions(SILFunction *F1, SILFunction *F2) {
+    if (F1->getLoweredFunctionType() != F2->getLoweredFunctionType())
+      return false;
+
+    // Attributes are either visible to callers or drive later passes (e.g.
+    // array semantics), so only merge exact matches.
+    if (F1->isFragile() != F2->isFragile() ||
+        F1->isTransparent() != F2->isTransparent() ||
+        F1->isThunk() != F2->isThunk() ||
+        F1->getInlineStrategy() != F2->getInlineStrategy() ||
+        F1->getEffectsKind() != F2->getEffectsKind() ||
+        F1->getSemanticsAttr() != F2->getSemanticsAttr())
+      return false;
+
+    if (F1->size() != F2->size())
+      return false;
+
+    // First map all blocks and their arguments so that forward references in
+    // terminators and block argument uses can be resolved.
+    auto BI2 = F2->begin();
+    for (SILBasicBlock &BB1 : *F1) {
+      SILBasicBlock *BB2 = &*BI2++;
+      if (BB1.getNumBBArg() != BB2->getNumBBArg())
+        return false;
+      BlockMap[&BB1] = BB2;
+      for (unsigned i = 0, e = BB1.getNumBBArg(); i != e; ++i) {
+        if (BB1.getBBArg(i)->getType() != BB2->getBBArg(i)->getType())
+          return false;
+        ValueMap[BB1.getBBArg(i)] = BB2->getBBArg(i);
+      }
+    }
+
+    // Now compare the instructions in both functions in lockstep.
+    BI2 = F2->begin();
+    for (SILBasicBlock &BB1 : *F1) {
+      SILBasicBlock *BB2 = &*BI2++;
+      auto II2 = BB2->begin();
+      for (SILInstruction &I1 : BB1) {
+        if (II2 == BB2->end())
+          return false;
+        SILInstruction *I2 = &*II2++;
+        if (auto *T1 = dyn_cast<TermInst>(&I1)) {
+          if (!matchTerminators(T1, cast<TermInst>(I2)))
+            return false;
+        } else if (!I1.isIdenticalTo(I2, [this](SILValue V1, SILValue V2) {
+                     return isMappedValue(V1, V2);
+                   })) {
+          return false;
+        }
+        ValueMap[&I1] = I2;
+      }
+      if (II2 != BB2->end())
+        return false;
+    }
+    return true;
+  }
+};
+
+class MergeFunctions : public SILModuleTransform {
+
+  StringRef getName() override { return "SIL Function Merging"; }
+
+  void run() override {
+    // Find for each function the first structurally identical function in
+    // module order, if any.
+    llvm::DenseMap<uint64_t, SmallVector<SILFunction *, 2>> Buckets;
+    llvm::DenseMap<SILFunction *, SILFunction *> Replacement;
+    for (SILFunction &F : *getModule()) {
+      if (!isEligibleFunction(&F))
+        continue;
+      auto &Bucket = Buckets[getStructuralHash(&F)];
+      bool FoundRepresentative = false;
+      for (SILFunction *Representative : Bucket) {
+        if (FunctionComparator().areEquivalentFunctions(&F, Representative)) {
+          DEBUG(llvm::dbgs() << "Merging " << F.getName() << " into "
+                             << Representative->getName() << "\n");
+          Replacement[&F] = Representative;
+          FoundRepresentative = true;
+          NumFunctionsMerged++;
+          break;
+        }
+      }
+      if (!FoundRepresentative)
+        Bucket.push_back(&F);
+    }
+    if (Replacement.empty())
+      return;
+
+    // Redirect all function_ref instructions from duplicates to their
+    // representatives. The duplicates become dead unless something else, like
+    // a vtable or external visibility, keeps them alive.
+    for (SILFunction &F : *getModule()) {
+      bool Changed = false;
+      for (SILBasicBlock &BB : F) {
+        for (auto Iter = BB.begin(); Iter != BB.end();) {
+          auto *FRI = dyn_cast<FunctionRefInst>(&*Iter);
+          ++Iter;
+          if (!FRI)
+            continue;
+          auto Found = Replacement.find(FRI->getReferencedFunction());
+          if (Found == Replacement.end())
+            continue;
+          SILFunction *Representative = Found->second;
+
+          // A fragile function may only reference fragile or public symbols.
+          if (F.isFragile() && !Representative->isFragile() &&
+              !isValidLinkageForFragileRef(Representative->getLinkage()))
+            continue;
+
+          SILBuilderWithScope Builder(FRI);
+          auto *NewFRI =
+              Builder.createFunctionRef(FRI->getLoc(), Representative);
+          FRI->replaceAllUsesWith(NewFRI);
+          FRI->eraseFromParent();
+          Changed = true;
+        }
+      }
+      if (Changed)
+        invalidateAnalysis(&F, SILAnalysis::InvalidationKind::CallsAndInstructions);
+    }
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createMergeFunctions() {
+  return new MergeFunctions();
+}
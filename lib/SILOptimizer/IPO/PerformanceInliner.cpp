@@ -66,7 +66,12 @@ namespace {
   // Benefit if the operand of an apply gets constant, e.g. if a closure is
   // passed to an apply instruction in the callee.
   const unsigned ConstCalleeBenefit = 150;
-  
+
+  // Benefit for inlining a lazy sequence adapter, i.e. a function marked
+  // with the "sequence.adapter" semantics.  Inlining these fuses chains of
+  // map/filter generators into a single loop over the base sequence.
+  const unsigned SequenceAdapterBenefit = 150;
+
   // Additional benefit for each loop level.
   const unsigned LoopBenefitFactor = 40;
   
@@ -74,6 +79,12 @@ namespace {
   // increasing the code size.
   const unsigned TrivialFunctionThreshold = 20;
 
+  // If the summary serialized with an external function reports at least this
+  // many instructions, its body is not worth deserializing for inlining. The
+  // limit is generous because the instruction count over-estimates the
+  // inlining cost: many instructions are free.
+  const unsigned MaxSummaryInstructionCount = 2048;
+
   // Represents a value in integer constant evaluation.
   struct IntConst {
     IntConst() : isValid(false), isFromCaller(false) { }
@@ -229,8 +240,18 @@ namespace {
     /// B into A.
     llvm::DenseSet<std::pair<StringRef, StringRef>> InlinedFunctions;
 
+    /// Caches the cost of a function's body, summed over all instructions
+    /// without any call-site specific branch pruning. Entries are dropped
+    /// whenever a function is changed by inlining, devirtualization or
+    /// specialization.
+    llvm::DenseMap<SILFunction *, unsigned> FunctionCostCache;
+
     SILFunction *getEligibleFunction(FullApplySite AI);
 
+    unsigned getFunctionCost(SILFunction *Callee);
+
+    bool isProfitableInColdBlock(SILFunction *Callee);
+
     bool isProfitableToInline(FullApplySite AI, unsigned loopDepthOfAI,
                               DominanceAnalysis *DA,
                               SILLoopAnalysis *LA,
@@ -738,19 +759,43 @@ bool SILPerformanceInliner::isProfitableToInline(FullApplySite AI,
   
   if (Callee->getInlineStrategy() == AlwaysInline)
     return true;
-  
+
+  unsigned Benefit = InlineCostThreshold > 0 ? InlineCostThreshold :
+                                               RemovedCallBenefit;
+  Benefit += loopDepthOfAI * LoopBenefitFactor;
+
+  // Lazy sequence adapters (e.g. the next() of a map or filter generator)
+  // are kept out of the early inliner so that the high-level passes and the
+  // specializer see the adapter composition.  Once eligible, inlining them
+  // fuses the adapter stages into a single loop and exposes their stored
+  // closures to the closure specializer, so boost the benefit.
+  if (Callee->hasDefinedSemantics() &&
+      Callee->getSemanticsString().startswith("sequence.adapter"))
+    Benefit += SequenceAdapterBenefit + loopDepthOfAI * LoopBenefitFactor;
+
+  if (TestThreshold < 0) {
+    // The cost of the callee with all of its blocks counted is an upper bound
+    // for the call-site specific cost computed below, and the threshold can
+    // only grow during the analysis. If even the whole body is within the
+    // initial threshold, the call site does not need to be analyzed at all.
+    unsigned MinThreshold = AI.getFunction()->isThunk() ?
+                                TrivialFunctionThreshold : Benefit;
+    if (getFunctionCost(Callee) <= MinThreshold) {
+      DEBUG(llvm::dbgs() << "        YES: trivially within threshold, "
+            "cost: " << getFunctionCost(Callee) << "\n");
+      return true;
+    }
+  }
+
   ConstantTracker constTracker(Callee, &callerTracker, AI);
-  
+
   DominanceInfo *DT = DA->get(Callee);
   SILLoopInfo *LI = LA->get(Callee);
 
   DominanceOrder domOrder(&Callee->front(), DT, Callee->size());
-  
+
   // Calculate the inlining cost of the callee.
   unsigned CalleeCost = 0;
-  unsigned Benefit = InlineCostThreshold > 0 ? InlineCostThreshold :
-                                               RemovedCallBenefit;
-  Benefit += loopDepthOfAI * LoopBenefitFactor;
   int testThreshold = TestThreshold;
 
   while (SILBasicBlock *block = domOrder.getNext()) {
@@ -817,26 +862,39 @@ bool SILPerformanceInliner::isProfitableToInline(FullApplySite AI,
   return true;
 }
 
+/// Return the cost of \p Callee, i.e. the sum of the costs of all its
+/// instructions, without accounting for any branches which become dead at a
+/// specific call site.
+///
+/// This is an upper bound for the call-site specific cost computed in
+/// isProfitableToInline, and is cached across all call sites of the callee.
+unsigned SILPerformanceInliner::getFunctionCost(SILFunction *Callee) {
+  auto CacheIter = FunctionCostCache.find(Callee);
+  if (CacheIter != FunctionCostCache.end())
+    return CacheIter->second;
+
+  unsigned Cost = 0;
+  for (SILBasicBlock &Block : *Callee) {
+    for (SILInstruction &I : Block) {
+      Cost += unsigned(instructionInlineCost(I));
+    }
+  }
+  FunctionCostCache[Callee] = Cost;
+  return Cost;
+}
+
 /// Return true if inlining this call site into a cold block is profitable.
-static bool isProfitableInColdBlock(SILFunction *Callee) {
+bool SILPerformanceInliner::isProfitableInColdBlock(SILFunction *Callee) {
   if (Callee->getInlineStrategy() == AlwaysInline)
     return true;
 
   // Testing with the TestThreshold disables inlining into cold blocks.
   if (TestThreshold >= 0)
     return false;
-  
-  unsigned CalleeCost = 0;
-  
-  for (SILBasicBlock &Block : *Callee) {
-    for (SILInstruction &I : Block) {
-      auto ICost = instructionInlineCost(I);
-      CalleeCost += (unsigned)ICost;
 
-      if (CalleeCost > TrivialFunctionThreshold)
-        return false;
-    }
-  }
+  unsigned CalleeCost = getFunctionCost(Callee);
+  if (CalleeCost > TrivialFunctionThreshold)
+    return false;
 
   DEBUG(llvm::dbgs() << "        YES: ready to inline into cold block, cost:"
         << CalleeCost << "\n");
@@ -849,6 +907,16 @@ static void tryLinkCallee(FullApplySite Apply) {
   auto *F = Apply.getCalleeFunction();
   if (!F || F->isDefinition()) return;
 
+  // If the summary serialized with the callee already tells us that it is
+  // too big to ever get inlined, don't bother deserializing the body.
+  // Functions with shared visibility must still be linked because IRGen
+  // needs their definitions.
+  if (F->hasFunctionSummary() && !F->isTransparent() &&
+      F->getInlineStrategy() != AlwaysInline &&
+      !hasSharedVisibility(F->getLinkage()) &&
+      F->getSummaryInstructionCount() > MaxSummaryInstructionCount)
+    return;
+
   auto &M = Apply.getFunction()->getModule();
   M.linkFunction(F, SILModule::LinkingMode::LinkAll);
 }
@@ -992,6 +1060,7 @@ bool SILPerformanceInliner::devirtualizeAndSpecializeApplies(
       // What about side-effects analysis? What about type analysis?
       MT->invalidateAnalysis(Apply.getFunction(),
                              SILAnalysis::InvalidationKind::Everything);
+      FunctionCostCache.erase(Apply.getFunction());
     }
   }
 
@@ -1212,6 +1281,7 @@ void SILPerformanceInliner::inlineDevirtualizeAndSpecialize(
       if (Inlined) {
         MT->invalidateAnalysis(WorkItem,
                                SILAnalysis::InvalidationKind::FunctionBody);
+        FunctionCostCache.erase(WorkItem);
 
         // FIXME: Update inlineCallsIntoFunction to collect all
         //        remaining applies after inlining, not just those
@@ -22,6 +22,8 @@
 #include "swift/SILOptimizer/Analysis/IVAnalysis.h"
 #include "swift/SILOptimizer/Analysis/LoopAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
+#include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
+#include "swift/SILOptimizer/Analysis/ValueRangeAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/CFG.h"
@@ -136,7 +138,7 @@ static bool isReleaseSafeArrayReference(SILValue Ref,
 static ArrayBoundsEffect
 mayChangeArraySize(SILInstruction *I, ArrayCallKind &Kind, SILValue &Array,
                    ArraySet &ReleaseSafeArrayReferences,
-                   RCIdentityFunctionInfo *RCIA) {
+                   RCIdentityFunctionInfo *RCIA, SideEffectAnalysis *SEA) {
   Array = SILValue();
   Kind = ArrayCallKind::kNone;
 
@@ -180,6 +182,19 @@ mayChangeArraySize(SILInstruction *I, ArrayCallKind &Kind, SILValue &Array,
   if (!I->mayHaveSideEffects())
     return ArrayBoundsEffect::kNone;
 
+  // A call can only change the size of an array if it writes to memory or
+  // releases an object (which may run a deinit that does). The side-effect
+  // summaries are computed bottom-up over the call graph, so this also
+  // accepts helper functions which merely forward arrays to other readonly
+  // code.
+  if (auto FAS = FullApplySite::isa(I)) {
+    SideEffectAnalysis::FunctionEffects E;
+    SEA->getEffects(E, FAS);
+    if (E.getMemBehavior(RetainObserveKind::IgnoreRetains) <=
+        SILInstruction::MemoryBehavior::MayRead)
+      return ArrayBoundsEffect::kNone;
+  }
+
   // A store to an alloc_stack can't possibly store to the array size which is
   // stored in a runtime allocated object sub field of an alloca.
   if (auto *SI = dyn_cast<StoreInst>(I)) {
@@ -238,13 +253,14 @@ class ABCAnalysis {
 
   ArraySet &ReleaseSafeArrayReferences;
   RCIdentityFunctionInfo *RCIA;
+  SideEffectAnalysis *SEA;
   bool LoopMode;
 
 public:
   ABCAnalysis(bool loopMode, ArraySet &ReleaseSafe,
-              RCIdentityFunctionInfo *rcia)
+              RCIdentityFunctionInfo *rcia, SideEffectAnalysis *sea)
       : allArraysInMemoryAreUnsafe(false),
-        ReleaseSafeArrayReferences(ReleaseSafe), RCIA(rcia),
+        ReleaseSafeArrayReferences(ReleaseSafe), RCIA(rcia), SEA(sea),
         LoopMode(loopMode) {}
 
   ABCAnalysis(const ABCAnalysis &) = delete;
@@ -291,8 +307,8 @@ private:
   void analyseInstruction(SILInstruction *Inst) {
     SILValue Array;
     ArrayCallKind K;
-    auto BoundsEffect =
-        mayChangeArraySize(Inst, K, Array, ReleaseSafeArrayReferences, RCIA);
+    auto BoundsEffect = mayChangeArraySize(
+        Inst, K, Array, ReleaseSafeArrayReferences, RCIA, SEA);
 
     if (BoundsEffect == ArrayBoundsEffect::kMayChangeAny) {
       DEBUG(llvm::dbgs() << " no safe because kMayChangeAny " << *Inst);
@@ -343,8 +359,9 @@ getArrayIndexPair(SILValue Array, SILValue ArrayIndex, ArrayCallKind K) {
 /// after an instruction that may modify any array allowing removal of redundant
 /// checks up to that point and after that point.
 static bool removeRedundantChecksInBlock(SILBasicBlock &BB, ArraySet &Arrays,
-                                         RCIdentityFunctionInfo *RCIA) {
-  ABCAnalysis ABC(false, Arrays, RCIA);
+                                         RCIdentityFunctionInfo *RCIA,
+                                         SideEffectAnalysis *SEA) {
+  ABCAnalysis ABC(false, Arrays, RCIA, SEA);
   IndexedArraySet RedundantChecks;
   bool Changed = false;
 
@@ -554,14 +571,15 @@ static bool isSignedLessEqual(SILValue Start, SILValue End, SILBasicBlock &BB) {
   return false;
 }
 
+/// Returns true if \p Start is known to be strictly less than \p End for all
+/// possible values.  This covers constant bounds and everything else the
+/// value range analysis can bound, e.g. a count masked to a small value.
 static bool isLessThan(SILValue Start, SILValue End) {
-  auto S = dyn_cast<IntegerLiteralInst>(Start.getDef());
-  if (!S)
-    return false;
-  auto E = dyn_cast<IntegerLiteralInst>(End.getDef());
-  if (!E)
+  unsigned Width = getFixedBuiltinIntegerWidth(Start);
+  if (!Width || getFixedBuiltinIntegerWidth(End) != Width)
     return false;
-  return S->getValue().slt(E->getValue());
+  return computeValueRange(Start).getSignedMax().slt(
+      computeValueRange(End).getSignedMin());
 }
 
 static BuiltinValueKind swapCmpID(BuiltinValueKind ID) {
@@ -1063,7 +1081,8 @@ static bool hoistChecksInLoop(DominanceInfo *DT, DominanceInfoNode *DTNode,
 /// based redundant bounds check removal.
 static bool hoistBoundsChecks(SILLoop *Loop, DominanceInfo *DT, SILLoopInfo *LI,
                               IVInfo &IVs, ArraySet &Arrays,
-                              RCIdentityFunctionInfo *RCIA, bool ShouldVerify) {
+                              RCIdentityFunctionInfo *RCIA,
+                              SideEffectAnalysis *SEA, bool ShouldVerify) {
   auto *Header = Loop->getHeader();
   if (!Header) return false;
 
@@ -1082,7 +1101,7 @@ static bool hoistBoundsChecks(SILLoop *Loop, DominanceInfo *DT, SILLoopInfo *LI,
 
   // Collect safe arrays. Arrays are safe if there is no function call that
   // could mutate their size in the loop.
-  ABCAnalysis ABC(true, Arrays, RCIA);
+  ABCAnalysis ABC(true, Arrays, RCIA, SEA);
   for (auto *BB : Loop->getBlocks()) {
     ABC.analyseBlock(BB);
   }
@@ -1195,6 +1214,7 @@ public:
     IVInfo &IVs = *IVA->get(F);
     auto *RCIA = getAnalysis<RCIdentityAnalysis>()->get(F);
     auto *DestAnalysis = PM->getAnalysis<DestructorAnalysis>();
+    auto *SEA = PM->getAnalysis<SideEffectAnalysis>();
 
     if (ShouldReportBoundsChecks) { reportBoundsChecks(F); };
     // Collect all arrays in this function. A release is only 'safe' if we know
@@ -1222,7 +1242,7 @@ public:
     // Remove redundant checks on a per basic block basis.
     bool Changed = false;
     for (auto &BB : *F)
-      Changed |= removeRedundantChecksInBlock(BB, ReleaseSafeArrays, RCIA);
+      Changed |= removeRedundantChecksInBlock(BB, ReleaseSafeArrays, RCIA, SEA);
 
     if (ShouldReportBoundsChecks) { reportBoundsChecks(F); };
 
@@ -1246,7 +1266,8 @@ public:
 
         while (!Worklist.empty()) {
           Changed |= hoistBoundsChecks(Worklist.pop_back_val(), DT, LI, IVs,
-                                       ReleaseSafeArrays, RCIA, ShouldVerify);
+                                       ReleaseSafeArrays, RCIA, SEA,
+                                       ShouldVerify);
         }
       }
 
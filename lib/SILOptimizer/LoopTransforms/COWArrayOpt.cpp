@@ -27,6 +27,7 @@
 #include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
 #include "swift/SILOptimizer/Analysis/LoopAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
+#include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/CFG.h"
@@ -339,6 +340,7 @@ class COWArrayOpt {
   typedef StructUseCollector::UserOperList UserOperList;
 
   RCIdentityFunctionInfo *RCIA;
+  SideEffectAnalysis *SEA;
   SILFunction *Function;
   SILLoop *Loop;
   SILBasicBlock *Preheader;
@@ -386,9 +388,9 @@ class COWArrayOpt {
   // analysing.
   SILValue CurrentArrayAddr;
 public:
-  COWArrayOpt(RCIdentityFunctionInfo *RCIA, SILLoop *L,
-              DominanceAnalysis *DA)
-      : RCIA(RCIA), Function(L->getHeader()->getParent()), Loop(L),
+  COWArrayOpt(RCIdentityFunctionInfo *RCIA, SideEffectAnalysis *SEA,
+              SILLoop *L, DominanceAnalysis *DA)
+      : RCIA(RCIA), SEA(SEA), Function(L->getHeader()->getParent()), Loop(L),
         Preheader(L->getLoopPreheader()), DomTree(DA->get(Function)),
         ColdBlocks(DA), CachedSafeLoop(false, false) {}
 
@@ -399,6 +401,7 @@ protected:
   SmallPtrSetImpl<SILBasicBlock*> &getReachingBlocks();
   bool isRetainReleasedBeforeMutate(SILInstruction *RetainInst,
                                     bool IsUniquelyIdentifiedArray = true);
+  bool isHarmlessReadOnlyCall(SILInstruction *Inst);
   bool checkSafeArrayAddressUses(UserList &AddressUsers);
   bool checkSafeArrayValueUses(UserList &ArrayValueUsers);
   bool checkSafeArrayElementUse(SILInstruction *UseInst, SILValue ArrayVal);
@@ -493,6 +496,26 @@ static bool isNonMutatingArraySemanticCall(SILInstruction *Inst) {
   }
 }
 
+/// \return true if the call \p Inst is harmless with regard to make_mutable
+/// hoisting: it may read from the array but can neither write to memory nor
+/// retain or release anything. Such a call can neither mutate the array nor
+/// bump the reference count of the array storage, which is the only thing
+/// that can interfere with make_mutable.
+///
+/// The side-effect summaries are computed bottom-up over the call graph, so
+/// this also accepts calls to functions which merely forward the array to
+/// other readonly functions.
+bool COWArrayOpt::isHarmlessReadOnlyCall(SILInstruction *Inst) {
+  auto *AI = dyn_cast<ApplyInst>(Inst);
+  if (!AI)
+    return false;
+
+  SideEffectAnalysis::FunctionEffects E;
+  SEA->getEffects(E, AI);
+  return E.getMemBehavior(RetainObserveKind::ObserveRetains) <=
+         SILInstruction::MemoryBehavior::MayRead;
+}
+
 /// \return true if the given retain instruction is followed by a release on the
 /// same object prior to any potential mutating operation.
 bool COWArrayOpt::isRetainReleasedBeforeMutate(SILInstruction *RetainInst,
@@ -526,6 +549,10 @@ bool COWArrayOpt::isRetainReleasedBeforeMutate(SILInstruction *RetainInst,
     if (isNonMutatingArraySemanticCall(&*II))
       continue;
 
+    // So are calls which cannot write, retain or release.
+    if (isHarmlessReadOnlyCall(&*II))
+      continue;
+
     if (IsUniquelyIdentifiedArray) {
       // It is okay for an identified loop to have releases in between a retain
       // and a release. We can end up here if we have two retains in a row and
@@ -583,6 +610,11 @@ bool COWArrayOpt::checkSafeArrayAddressUses(UserList &AddressUsers) {
         continue;
       }
 
+      // The array cannot escape through a call which cannot write, retain or
+      // release it.
+      if (isHarmlessReadOnlyCall(AI))
+        continue;
+
       DEBUG(llvm::dbgs() << "    Skipping Array: may escape through call!\n    "
             << *UseInst);
       return false;
@@ -653,6 +685,11 @@ bool COWArrayOpt::checkSafeArrayValueUses(UserList &ArrayValueUsers) {
       if (ArraySemanticsCall(AI))
         continue;
 
+      // Calls without write, retain or release effects cannot mutate the
+      // array or keep an additional reference to its storage.
+      if (isHarmlessReadOnlyCall(AI))
+        continue;
+
       // Found an unsafe or unknown user. The Array may escape here.
       DEBUG(llvm::dbgs() << "    Skipping Array: unsafe call!\n    "
             << *UseInst);
@@ -1539,6 +1576,7 @@ class COWArrayOptPass : public SILFunctionTransform {
 
     auto *DA = PM->getAnalysis<DominanceAnalysis>();
     auto *LA = PM->getAnalysis<SILLoopAnalysis>();
+    auto *SEA = PM->getAnalysis<SideEffectAnalysis>();
     auto *RCIA =
       PM->getAnalysis<RCIdentityAnalysis>()->get(getFunction());
     SILLoopInfo *LI = LA->get(getFunction());
@@ -1566,7 +1604,7 @@ class COWArrayOptPass : public SILFunctionTransform {
 
     bool HasChanged = false;
     for (auto *L : Loops)
-      HasChanged |= COWArrayOpt(RCIA, L, DA).run();
+      HasChanged |= COWArrayOpt(RCIA, SEA, L, DA).run();
 
       if (HasChanged) {
         invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
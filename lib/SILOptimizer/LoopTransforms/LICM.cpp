@@ -391,6 +391,18 @@ struct LoopNestSummary {
 
 /// \brief Optimize the loop tree bottom up propagating loop's summaries up the
 /// loop tree.
+///
+/// TODO: When a load can not be hoisted because the loop stores through a
+/// potentially aliasing address, we could version the loop: test at runtime
+/// that the accessed objects are disjoint (for arrays, that their storage
+/// references differ) and branch to a loop body with the loads hoisted,
+/// falling back to the conservative body otherwise. Two inout arrays can
+/// share their storage via COW, so static alias analysis can never prove
+/// disjointness for them. Doing this soundly requires reasoning at the level
+/// of array semantic calls (a raw pointer comparison does not rule out
+/// partial overlap), so it belongs next to the array property specialization
+/// in COWArrayOpt.cpp, which already knows how to clone a loop nest and
+/// branch on a runtime check.
 class LoopTreeOptimization {
   llvm::DenseMap<SILLoop *, std::unique_ptr<LoopNestSummary>>
       LoopNestSummaryMap;
@@ -13,6 +13,7 @@
 #define DEBUG_TYPE "sil-passmanager"
 
 #include "swift/Basic/DemangleWrappers.h"
+#include "swift/Basic/TraceEvents.h"
 #include "swift/SILOptimizer/PassManager/PassManager.h"
 #include "swift/SIL/SILFunction.h"
 #include "swift/SIL/SILModule.h"
@@ -24,6 +25,7 @@
 #include "swift/SILOptimizer/Analysis/BasicCalleeAnalysis.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/TimeValue.h"
 #include "llvm/Support/GraphWriter.h"
 
@@ -47,6 +49,12 @@ llvm::cl::opt<unsigned> SILNumOptPassesToRun(
     "sil-opt-pass-count", llvm::cl::init(UINT_MAX),
     llvm::cl::desc("Stop optimizing after <N> optimization passes"));
 
+llvm::cl::opt<bool> SILPrintPassStats(
+    "sil-print-pass-stats", llvm::cl::init(false),
+    llvm::cl::desc("Print a per-pass summary table (runs, total time, "
+                   "instruction delta, invalidations) when the pass manager "
+                   "is destroyed"));
+
 llvm::cl::opt<std::string>
     SILPrintOnlyFun("sil-print-only-function", llvm::cl::init(""),
                     llvm::cl::desc("Only print out the sil for this function"));
@@ -80,6 +88,25 @@ llvm::cl::opt<bool> SILVerifyWithoutInvalidation(
     "sil-verify-without-invalidation", llvm::cl::init(false),
     llvm::cl::desc("Verify after passes even if the pass has not invalidated"));
 
+llvm::cl::opt<bool> SILVerifyFullModule(
+    "sil-verify-full-module", llvm::cl::init(false),
+    llvm::cl::desc("After a module pass, verify the whole module instead of "
+                   "only the functions the pass reported changes to"));
+
+static int64_t countInstructions(SILFunction *F) {
+  int64_t count = 0;
+  for (auto &BB : *F)
+    count += std::distance(BB.begin(), BB.end());
+  return count;
+}
+
+static int64_t countInstructions(SILModule *M) {
+  int64_t count = 0;
+  for (auto &F : *M)
+    count += countInstructions(&F);
+  return count;
+}
+
 static bool doPrintBefore(SILTransform *T, SILFunction *F) {
   if (!SILPrintOnlyFun.empty() && F && F->getName() != SILPrintOnlyFun)
     return false;
@@ -188,6 +215,8 @@ void SILPassManager::runPassesOnFunction(PassList FuncTransforms,
       continue;
 
     currentPassHasInvalidated = false;
+    currentPassInvalidatedModule = false;
+    CurrentPassChangedFunctions.clear();
 
     if (SILPrintPassName)
       llvm::dbgs() << "#" << NumPassesRun << " Stage: " << StageName
@@ -201,9 +230,16 @@ void SILPassManager::runPassesOnFunction(PassList FuncTransforms,
       F->dump(Options.EmitVerboseSIL);
     }
 
+    int64_t InstructionsBefore = 0;
+    if (SILPrintPassStats)
+      InstructionsBefore = countInstructions(F);
+
     llvm::sys::TimeValue StartTime = llvm::sys::TimeValue::now();
     Mod->registerDeleteNotificationHandler(SFT);
-    SFT->run();
+    {
+      TraceEventScope traceScope(SFT->getName(), F->getName());
+      SFT->run();
+    }
     Mod->removeDeleteNotificationHandler(SFT);
 
     if (SILPrintPassTime) {
@@ -213,6 +249,16 @@ void SILPassManager::runPassesOnFunction(PassList FuncTransforms,
                    << ")\n";
     }
 
+    if (SILPrintPassStats) {
+      PassStatistics &Stats = PassStats[SFT->getName()];
+      ++Stats.NumRuns;
+      Stats.Nanoseconds +=
+          llvm::sys::TimeValue::now().nanoseconds() - StartTime.nanoseconds();
+      Stats.InstructionDelta += countInstructions(F) - InstructionsBefore;
+      if (currentPassHasInvalidated)
+        ++Stats.NumInvalidations;
+    }
+
     // If this pass invalidated anything, print and verify.
     if (doPrintAfter(SFT, F, currentPassHasInvalidated && SILPrintAll)) {
       llvm::dbgs() << "*** SIL function after " << StageName << " "
@@ -240,29 +286,43 @@ void SILPassManager::runPassesOnFunction(PassList FuncTransforms,
 void SILPassManager::runFunctionPasses(PassList FuncTransforms) {
   BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
   BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
-  auto BottomUpFunctions = BottomUpOrder.getFunctions();
+  auto SCCs = BottomUpOrder.getSCCs();
+  auto SCCLevels = BottomUpOrder.getSCCLevels();
 
   assert(FunctionWorklist.empty() && "Expected empty function worklist!");
 
-  FunctionWorklist.reserve(BottomUpFunctions.size());
-  for (auto I = BottomUpFunctions.rbegin(), E = BottomUpFunctions.rend();
-       I != E; ++I) {
-    auto &F = **I;
-
-    // Only include functions that are definitions, and which have not
-    // been intentionally excluded from optimization.
-    if (F.isDefinition() && F.shouldOptimize())
-      FunctionWorklist.push_back(*I);
-  }
+  // Process one call-graph level at a time, bottom-up. The SCCs within a
+  // level do not call into one another, so each level forms a batch of
+  // independent work. For now each batch is still processed serially;
+  // running its SCCs on separate threads additionally requires thread-safe
+  // SILModule allocation and per-thread analyses.
+  for (auto &LevelSCCs : SCCLevels) {
+    for (auto I = LevelSCCs.rbegin(), E = LevelSCCs.rend(); I != E; ++I) {
+      for (auto FI = SCCs[*I].rbegin(), FE = SCCs[*I].rend(); FI != FE; ++FI) {
+        auto &F = **FI;
+
+        // Bodies deserialized from a module with canonical SIL have already
+        // been through the diagnostic passes when that module was built;
+        // don't spend time running them again.
+        if (Mod->getStage() == SILStage::Raw && F.wasDeserializedCanonical())
+          continue;
+
+        // Only include functions that are definitions, and which have not
+        // been intentionally excluded from optimization.
+        if (F.isDefinition() && F.shouldOptimize())
+          FunctionWorklist.push_back(*FI);
+      }
+    }
 
-  // Pop functions off the worklist, and run all function transforms
-  // on each of them.
-  while (!FunctionWorklist.empty()) {
-    auto *F = FunctionWorklist.back();
+    // Pop functions off the worklist, and run all function transforms
+    // on each of them.
+    while (!FunctionWorklist.empty()) {
+      auto *F = FunctionWorklist.back();
 
-    runPassesOnFunction(FuncTransforms, F);
+      runPassesOnFunction(FuncTransforms, F);
 
-    FunctionWorklist.pop_back();
+      FunctionWorklist.pop_back();
+    }
   }
 }
 
@@ -278,6 +338,8 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
   SMT->injectModule(Mod);
 
   currentPassHasInvalidated = false;
+  currentPassInvalidatedModule = false;
+  CurrentPassChangedFunctions.clear();
 
   if (SILPrintPassName)
     llvm::dbgs() << "#" << NumPassesRun << " Stage: " << StageName
@@ -290,9 +352,16 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
     printModule(Mod, Options.EmitVerboseSIL);
   }
 
+  int64_t InstructionsBefore = 0;
+  if (SILPrintPassStats)
+    InstructionsBefore = countInstructions(Mod);
+
   llvm::sys::TimeValue StartTime = llvm::sys::TimeValue::now();
   Mod->registerDeleteNotificationHandler(SMT);
-  SMT->run();
+  {
+    TraceEventScope traceScope(SMT->getName(), "Module");
+    SMT->run();
+  }
   Mod->removeDeleteNotificationHandler(SMT);
 
   if (SILPrintPassTime) {
@@ -301,6 +370,16 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
     llvm::dbgs() << Delta << " (" << SMT->getName() << ",Module)\n";
   }
 
+  if (SILPrintPassStats) {
+    PassStatistics &Stats = PassStats[SMT->getName()];
+    ++Stats.NumRuns;
+    Stats.Nanoseconds +=
+        llvm::sys::TimeValue::now().nanoseconds() - StartTime.nanoseconds();
+    Stats.InstructionDelta += countInstructions(Mod) - InstructionsBefore;
+    if (currentPassHasInvalidated)
+      ++Stats.NumInvalidations;
+  }
+
   // If this pass invalidated anything, print and verify.
   if (doPrintAfter(SMT, nullptr,
                    currentPassHasInvalidated && SILPrintAll)) {
@@ -312,7 +391,18 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
 
   if (Options.VerifyAll &&
       (currentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+    if (SILVerifyFullModule || currentPassInvalidatedModule) {
+      Mod->verify();
+    } else {
+      // The pass reported exactly which functions it changed; verify those
+      // and the module-level structure.  Membership is tested while walking
+      // the module's function list, so functions the pass deleted are never
+      // touched.  Full verification still happens at pipeline boundaries.
+      Mod->verifyStructure();
+      for (SILFunction &F : *Mod)
+        if (CurrentPassChangedFunctions.count(&F))
+          F.verify();
+    }
     verifyAnalyses();
   }
 }
@@ -395,8 +485,40 @@ void SILPassManager::run() {
   runOneIteration();
 }
 
+void SILPassManager::printPassStatistics() const {
+  // Sort the entries by total time, descending, so the most expensive pass
+  // comes first.
+  std::vector<const llvm::StringMapEntry<PassStatistics> *> Entries;
+  Entries.reserve(PassStats.size());
+  for (const auto &Entry : PassStats)
+    Entries.push_back(&Entry);
+  std::sort(Entries.begin(), Entries.end(),
+            [](const llvm::StringMapEntry<PassStatistics> *LHS,
+               const llvm::StringMapEntry<PassStatistics> *RHS) {
+    return LHS->getValue().Nanoseconds > RHS->getValue().Nanoseconds;
+  });
+
+  llvm::dbgs() << "*** Per-pass statistics";
+  if (!StageName.empty())
+    llvm::dbgs() << " (stage: " << StageName << ")";
+  llvm::dbgs() << " ***\n";
+  llvm::dbgs() << "  time (ms)      runs   inst delta   invalidations   pass\n";
+  for (const auto *Entry : Entries) {
+    const PassStatistics &Stats = Entry->getValue();
+    llvm::dbgs() << llvm::format("%11.3f %9u %12lld %15u   ",
+                                 Stats.Nanoseconds / 1e6, Stats.NumRuns,
+                                 static_cast<long long>(
+                                     Stats.InstructionDelta),
+                                 Stats.NumInvalidations)
+                 << Entry->getKey() << "\n";
+  }
+}
+
 /// D'tor.
 SILPassManager::~SILPassManager() {
+  if (SILPrintPassStats && !PassStats.empty())
+    printPassStatistics();
+
   // Free all transformations.
   for (auto T : Transformations)
     delete T;
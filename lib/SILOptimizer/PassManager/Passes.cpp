@@ -204,6 +204,10 @@ void AddSSAPasses(SILPassManager &PM, OptimizationLevelKind OpLevel) {
 
   PM.addSILLinker();
 
+  // Devirtualize statically known calls before inlining, so that the
+  // inliner sees direct calls.
+  PM.addDevirtualizer();
+
   switch (OpLevel) {
     case OptimizationLevelKind::HighLevel:
       // Does not inline functions with defined semantics.
@@ -339,13 +343,20 @@ void swift::runSILOptimizationPasses(SILModule &Module) {
   PM.addLateCodeMotion();
   PM.addARCSequenceOpts();
 
+  // Mark remaining retains/releases of provably thread-local objects as
+  // non-atomic. This should run after the last ARC optimizer because the
+  // ARC passes do not preserve the non-atomic flag on new instructions.
+  PM.addNonAtomicRC();
+
   PM.runOneIteration();
   PM.resetAndRemoveTransformations();
 
   PM.setStageName("LateLoopOpt");
 
   // Delete dead code and drop the bodies of shared functions.
+  // Identical functions are merged first so that the duplicates become dead.
   PM.addExternalFunctionDefinitionsElimination();
+  PM.addMergeFunctions();
   PM.addDeadFunctionElimination();
 
   // Perform the final lowering transformations.
@@ -356,6 +367,11 @@ void swift::runSILOptimizationPasses(SILModule &Module) {
   PM.addRedundantOverflowCheckRemoval();
   PM.addMergeCondFails();
 
+  // Convert remaining side-effect free diamonds and triangles, including
+  // those created by the optimizer itself, into selects so that the backend
+  // can emit conditional moves for them.
+  PM.addSelectFormation();
+
   // Remove dead code.
   PM.addDCE();
   PM.addSimplifyCFG();
@@ -28,9 +28,11 @@
 #include "swift/SILOptimizer/Analysis/SimplifyInstruction.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/Local.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 
 using namespace swift;
@@ -39,6 +41,18 @@ STATISTIC(NumSimplified, "Number of instructions simplified");
 STATISTIC(NumCombined, "Number of instructions combined");
 STATISTIC(NumDeadInst, "Number of dead insts eliminated");
 
+llvm::cl::opt<bool> SILCombineVisitStats(
+    "sil-combine-visit-stats", llvm::cl::init(false),
+    llvm::cl::desc("Print the number of visits per instruction kind after "
+                   "each SILCombine run"));
+
+static StringRef getValueKindName(ValueKind Kind) {
+  switch (Kind) {
+#define VALUE(Id, Parent) case ValueKind::Id: return #Id;
+#include "swift/SIL/SILNodes.def"
+  }
+}
+
 //===----------------------------------------------------------------------===//
 //                              Utility Methods
 //===----------------------------------------------------------------------===//
@@ -170,6 +184,9 @@ bool SILCombiner::doOneIteration(SILFunction &F, unsigned Iteration) {
     DEBUG(llvm::raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     DEBUG(llvm::dbgs() << "SC: Visiting: " << OrigI << '\n');
 
+    if (SILCombineVisitStats)
+      VisitCountByKind[unsigned(I->getKind())]++;
+
     if (SILInstruction *Result = visit(I)) {
       ++NumCombined;
       // Should we replace the old instruction with a new one?
@@ -180,13 +197,13 @@ bool SILCombiner::doOneIteration(SILFunction &F, unsigned Iteration) {
         DEBUG(llvm::dbgs() << "SC: Old = " << *I << '\n'
                            << "    New = " << *Result << '\n');
 
-        // Everything uses the new instruction now.
+        // Everything uses the new instruction now. This moves all users of I
+        // over to Result and adds them to the worklist; Result itself is new,
+        // so it can not have any other users.
         replaceInstUsesWith(*I, Result);
 
-        // Push the new instruction and any users onto the worklist.
+        // Push the new instruction onto the worklist.
         Worklist.add(Result);
-        Worklist.addUsersToWorklist(Result);
-
 
         eraseInstFromFunction(*I);
       } else {
@@ -211,6 +228,9 @@ bool SILCombiner::doOneIteration(SILFunction &F, unsigned Iteration) {
     // the next iteration.
     auto &TrackingList = *Builder.getTrackingList();
     for (SILInstruction *I : TrackingList) {
+      // Creating a terminator changes the CFG, which invalidates dominance.
+      if (isa<TermInst>(I))
+        DT.reset();
       if (!DeletedInstSet.count(I))
         Worklist.add(I);
     }
@@ -246,10 +266,31 @@ bool SILCombiner::runOnFunction(SILFunction &F) {
     Iteration++;
   }
 
+  if (SILCombineVisitStats) {
+    llvm::SmallVector<std::pair<unsigned, unsigned>, 32> Counts;
+    for (auto Entry : VisitCountByKind)
+      Counts.push_back({Entry.second, Entry.first});
+    std::sort(Counts.begin(), Counts.end(),
+              std::greater<std::pair<unsigned, unsigned>>());
+    llvm::errs() << "SILCombine visits for " << F.getName() << ":\n";
+    for (auto &Count : Counts)
+      llvm::errs() << "  " << getValueKindName(ValueKind(Count.second)) << ": "
+                   << Count.first << '\n';
+    VisitCountByKind.clear();
+  }
+
   // Cleanup the builder and return whether or not we made any changes.
   return Changed;
 }
 
+/// Return dominance information for the current function, computing it on
+/// first use. The computed tree stays valid until the CFG changes.
+DominanceInfo *SILCombiner::getDominanceInfo() {
+  if (!DT)
+    DT.reset(new DominanceInfo(&Builder.getFunction()));
+  return DT.get();
+}
+
 // Insert the instruction New before instruction Old in Old's parent BB. Add
 // New to the worklist.
 SILInstruction *SILCombiner::insertNewInstBefore(SILInstruction *New,
@@ -312,6 +353,10 @@ SILInstruction *SILCombiner::eraseInstFromFunction(SILInstruction &I,
   DEBUG(llvm::dbgs() << "SC: ERASE " << I << '\n');
 
   assert(hasNoUsesExceptDebug(&I) && "Cannot erase instruction that is used!");
+
+  // Erasing a terminator changes the CFG, which invalidates dominance.
+  if (isa<TermInst>(&I))
+    DT.reset();
   // Make sure that we reprocess all operands now that we reduced their
   // use counts.
   if (I.getNumOperands() < 8 && AddOperandsToWorklist)
@@ -21,6 +21,7 @@
 #ifndef SWIFT_SILOPTIMIZER_PASSMANAGER_SILCOMBINER_H
 #define SWIFT_SILOPTIMIZER_PASSMANAGER_SILCOMBINER_H
 
+#include "swift/SIL/Dominance.h"
 #include "swift/SIL/SILInstruction.h"
 #include "swift/SIL/SILValue.h"
 #include "swift/SIL/SILBuilder.h"
@@ -137,6 +138,15 @@ class SILCombiner :
   /// Cast optimizer
   CastOptimizer CastOpt;
 
+  /// Lazily computed dominance information. It is used to track the
+  /// provenance of existentials across basic blocks and is discarded
+  /// whenever the CFG changes.
+  std::unique_ptr<DominanceInfo> DT;
+
+  /// The number of visits per instruction kind. Only filled when the
+  /// -sil-combine-visit-stats option is set.
+  llvm::DenseMap<unsigned, unsigned> VisitCountByKind;
+
 public:
   SILCombiner(SILBuilder &B, AliasAnalysis *AA, bool removeCondFails)
       : AA(AA), Worklist(), MadeChange(false), RemoveCondFails(removeCondFails),
@@ -154,8 +164,13 @@ public:
     Iteration = 0;
     Worklist.zap();
     MadeChange = false;
+    DT.reset();
   }
 
+  /// Return dominance information for the current function, computing it on
+  /// first use. The computed tree stays valid until the CFG changes.
+  DominanceInfo *getDominanceInfo();
+
   // Insert the instruction New before instruction Old in Old's parent BB. Add
   // New to the worklist.
   SILInstruction *insertNewInstBefore(SILInstruction *New, SILInstruction &Old);
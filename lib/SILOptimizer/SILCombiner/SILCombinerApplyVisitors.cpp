@@ -94,6 +94,83 @@ static bool foldInverseReabstractionThunks(PartialApplyInst *PAI,
   return true;
 }
 
+/// Check whether \p PAI partially applies a reabstraction thunk which merely
+/// forwards its arguments to the closure it captures:
+///
+///   sil @thunk : $(A..., @owned F) -> R {
+///   bb0(%a... : $A..., %closure : $F):
+///     %c = convert_function %closure     // optional
+///     %r = apply %c(%a...)
+///     return %r
+///   }
+///
+/// SILGen emits such thunks for conversions which change the formal function
+/// type but not the lowered calling convention. The thunk's body is itself
+/// the proof that the captured closure is ABI-compatible with the type the
+/// partial_apply produces, so the closure can be used in its place.
+///
+/// Returns the captured closure if the fold is possible.
+static SILValue isIdentityReabstractionThunk(PartialApplyInst *PAI) {
+  SILValue ClosureArg = isPartialApplyOfReabstractionThunk(PAI, false);
+  if (!ClosureArg)
+    return SILValue();
+
+  if (PAI->hasSubstitutions())
+    return SILValue();
+
+  auto *Thunk = PAI->getCalleeFunction();
+  if (!Thunk->isDefinition() || Thunk->size() != 1)
+    return SILValue();
+
+  // The closure is the last argument of the thunk.
+  SILBasicBlock &Entry = Thunk->front();
+  if (Entry.getNumBBArg() == 0)
+    return SILValue();
+  SILValue ClosureParam(Entry.getBBArg(Entry.getNumBBArg() - 1));
+
+  // The body may convert the closure's function type, but must not touch it
+  // otherwise.
+  auto InstIter = Entry.begin();
+  SILValue Callee = ClosureParam;
+  if (auto *CFI = dyn_cast<ConvertFunctionInst>(&*InstIter)) {
+    if (CFI->getOperand() != ClosureParam)
+      return SILValue();
+    Callee = CFI;
+    ++InstIter;
+  }
+
+  // The closure must be applied with the thunk's own arguments, in order.
+  // This includes any indirect result addresses.
+  auto *AI = dyn_cast<ApplyInst>(&*InstIter);
+  if (!AI || AI->getCallee() != Callee || AI->hasSubstitutions())
+    return SILValue();
+  if (AI->getNumArguments() != Entry.getNumBBArg() - 1)
+    return SILValue();
+  for (unsigned i = 0, e = AI->getNumArguments(); i != e; ++i)
+    if (AI->getArgument(i) != SILValue(Entry.getBBArg(i)))
+      return SILValue();
+  ++InstIter;
+
+  auto *RI = dyn_cast<ReturnInst>(&*InstIter);
+  if (!RI || RI->getOperand().getDef() != AI)
+    return SILValue();
+
+  // The thunk must take the closure at +1, matching the +1 result of the
+  // partial_apply; the forwarding apply then passes that +1 on to the
+  // closure's own @callee_owned convention.
+  auto ThunkParams = Thunk->getLoweredFunctionType()->getParameters();
+  if (ThunkParams.back().getConvention() != ParameterConvention::Direct_Owned)
+    return SILValue();
+
+  // The applied closure must have exactly the type the partial_apply
+  // produces. In particular this checks that both are @callee_owned, i.e.
+  // that eliminating the thunk does not change who releases the closure.
+  if (Callee.getType() != PAI->getType())
+    return SILValue();
+
+  return ClosureArg;
+}
+
 SILInstruction *SILCombiner::visitPartialApplyInst(PartialApplyInst *PAI) {
   // partial_apply without any substitutions or arguments is just a
   // thin_to_thick_function.
@@ -107,6 +184,19 @@ SILInstruction *SILCombiner::visitPartialApplyInst(PartialApplyInst *PAI) {
   if (foldInverseReabstractionThunks(PAI, this))
     return nullptr;
 
+  // partial_apply %thunk(%closure) -> %closure, if the thunk only forwards
+  // its arguments to %closure.
+  if (SILValue Closure = isIdentityReabstractionThunk(PAI)) {
+    if (Closure.getType() == PAI->getType()) {
+      replaceInstUsesWith(*PAI, Closure.getDef());
+      eraseInstFromFunction(*PAI);
+      return nullptr;
+    }
+    // The thunk's body converted the closure's type; do the same here.
+    return Builder.createConvertFunction(PAI->getLoc(), Closure,
+                                         PAI->getType());
+  }
+
   tryOptimizeApplyOfPartialApply(PAI);
 
   // Try to delete dead closures.
@@ -629,6 +719,7 @@ static SILValue getInitOrOpenExistential(AllocStackInst *ASI, SILValue &Src) {
 /// find the init_existential, which could be used to  determine a concrete
 /// type of the \p Self.
 static SILInstruction *findInitExistential(FullApplySite AI, SILValue Self,
+                                           DominanceInfo *DT,
                                            SILType &InstanceType) {
   SILInstruction *InitExistential = nullptr;
 
@@ -649,31 +740,39 @@ static SILInstruction *findInitExistential(FullApplySite AI, SILValue Self,
       }
     }
 
+    InitExistentialAddrInst *FoundIE = nullptr;
     for (auto Use : Op.getUses()) {
       SILValue User = Use->getUser();
 
+      if (auto *CAI = dyn_cast<CopyAddrInst>(User)) {
+        // Bail if the existential is re-initialized by a copy_addr; we do
+        // not know which initialization is in effect at the call site.
+        if (CAI->getDest() == Op)
+          return nullptr;
+        continue;
+      }
       if (auto *IE = dyn_cast<InitExistentialAddrInst>(User)) {
-        // IE should dominate Instance.
-        // Without a DomTree we want to be very defensive
-        // and only allow this optimization when it is used
-        // inside the same BB.
-        if (IE->getParent() != AI.getParent())
-          continue;
-
-        InstanceType = Instance->getType();
-        InitExistential = IE;
+        // Bail if the existential is initialized more than once.
+        if (FoundIE)
+          return nullptr;
+        FoundIE = IE;
       }
     }
+
+    // The init_existential_addr is only known to provide the concrete type
+    // of the call if it dominates the apply. This also establishes the
+    // required ordering when both are in the same block.
+    if (FoundIE && DT->properlyDominates(FoundIE, AI.getInstruction())) {
+      InstanceType = Instance->getType();
+      InitExistential = FoundIE;
+    }
   }
 
   if (auto *Instance = dyn_cast<OpenExistentialRefInst>(Self)) {
     if (auto *IE = dyn_cast<InitExistentialRefInst>(Instance->getOperand())) {
-      // IE should dominate Instance.
-      // Without a DomTree we want to be very defensive
-      // and only allow this optimization when it is used
-      // inside the same BB.
-      if (IE->getParent() != AI.getParent())
-        return nullptr;
+      // The init_existential_ref dominates the apply because it is the
+      // operand of the open_existential_ref, which in turn produces the
+      // self argument of the apply.
       InstanceType = Instance->getType();
       InitExistential = IE;
     }
@@ -835,7 +934,8 @@ SILCombiner::propagateConcreteTypeOfInitExistential(FullApplySite AI,
   // Try to find the init_existential, which could be used to
   // determine a concrete type of the self.
   SILType InstanceType;
-  SILInstruction *InitExistential = findInitExistential(AI, Self, InstanceType);
+  SILInstruction *InitExistential =
+      findInitExistential(AI, Self, getDominanceInfo(), InstanceType);
   if (!InitExistential)
     return nullptr;
 
@@ -21,6 +21,7 @@
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ARCAnalysis.h"
 #include "swift/SILOptimizer/Analysis/CFG.h"
+#include "swift/SILOptimizer/Analysis/ValueRangeAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
 #include "swift/SILOptimizer/Utils/Local.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -30,6 +31,64 @@
 using namespace swift;
 using namespace swift::PatternMatch;
 
+/// Try to evaluate an integer comparison from the possible ranges of its
+/// operands.  Returns None if the ranges do not decide the comparison.
+static Optional<bool> evaluateCmpFromRanges(BuiltinValueKind ID, SILValue L,
+                                            SILValue R) {
+  unsigned Width = getFixedBuiltinIntegerWidth(L);
+  if (!Width || getFixedBuiltinIntegerWidth(R) != Width)
+    return None;
+
+  ValueRange LR = computeValueRange(L);
+  ValueRange RR = computeValueRange(R);
+
+  switch (ID) {
+  default:
+    return None;
+  case BuiltinValueKind::ICMP_EQ:
+  case BuiltinValueKind::ICMP_NE:
+    // If the ranges are disjoint the values cannot be equal.
+    if (LR.getSignedMax().slt(RR.getSignedMin()) ||
+        LR.getSignedMin().sgt(RR.getSignedMax()) ||
+        LR.getUnsignedMax().ult(RR.getUnsignedMin()) ||
+        LR.getUnsignedMin().ugt(RR.getUnsignedMax()))
+      return ID == BuiltinValueKind::ICMP_NE;
+    return None;
+  case BuiltinValueKind::ICMP_SLT:
+    if (LR.getSignedMax().slt(RR.getSignedMin()))
+      return true;
+    if (LR.getSignedMin().sge(RR.getSignedMax()))
+      return false;
+    return None;
+  case BuiltinValueKind::ICMP_SLE:
+    if (LR.getSignedMax().sle(RR.getSignedMin()))
+      return true;
+    if (LR.getSignedMin().sgt(RR.getSignedMax()))
+      return false;
+    return None;
+  case BuiltinValueKind::ICMP_SGT:
+    return evaluateCmpFromRanges(BuiltinValueKind::ICMP_SLT, R, L);
+  case BuiltinValueKind::ICMP_SGE:
+    return evaluateCmpFromRanges(BuiltinValueKind::ICMP_SLE, R, L);
+  case BuiltinValueKind::ICMP_ULT:
+    if (LR.getUnsignedMax().ult(RR.getUnsignedMin()))
+      return true;
+    if (LR.getUnsignedMin().uge(RR.getUnsignedMax()))
+      return false;
+    return None;
+  case BuiltinValueKind::ICMP_ULE:
+    if (LR.getUnsignedMax().ule(RR.getUnsignedMin()))
+      return true;
+    if (LR.getUnsignedMin().ugt(RR.getUnsignedMax()))
+      return false;
+    return None;
+  case BuiltinValueKind::ICMP_UGT:
+    return evaluateCmpFromRanges(BuiltinValueKind::ICMP_ULT, R, L);
+  case BuiltinValueKind::ICMP_UGE:
+    return evaluateCmpFromRanges(BuiltinValueKind::ICMP_ULE, R, L);
+  }
+}
+
 SILInstruction *SILCombiner::optimizeBuiltinCompareEq(BuiltinInst *BI,
                                                       bool NegateResult) {
   // Canonicalize boolean comparisons.
@@ -433,6 +492,32 @@ SILInstruction *SILCombiner::visitBuiltinInst(BuiltinInst *I) {
     break;
   }
   
+  // Fold comparisons whose result is decided by the possible ranges of
+  // their operands, e.g. a value masked to a small range compared against
+  // a constant outside of it.
+  switch (I->getBuiltinInfo().ID) {
+  default:
+    break;
+  case BuiltinValueKind::ICMP_EQ:
+  case BuiltinValueKind::ICMP_NE:
+  case BuiltinValueKind::ICMP_SLT:
+  case BuiltinValueKind::ICMP_SLE:
+  case BuiltinValueKind::ICMP_SGT:
+  case BuiltinValueKind::ICMP_SGE:
+  case BuiltinValueKind::ICMP_ULT:
+  case BuiltinValueKind::ICMP_ULE:
+  case BuiltinValueKind::ICMP_UGT:
+  case BuiltinValueKind::ICMP_UGE:
+    if (I->getNumOperands() == 2) {
+      if (auto Result = evaluateCmpFromRanges(I->getBuiltinInfo().ID,
+                                              I->getOperand(0),
+                                              I->getOperand(1)))
+        return Builder.createIntegerLiteral(I->getLoc(), I->getType(),
+                                            APInt(1, *Result ? 1 : 0));
+    }
+    break;
+  }
+
   if (I->getBuiltinInfo().ID == BuiltinValueKind::ICMP_EQ)
     return optimizeBuiltinCompareEq(I, /*Negate Eq result*/ false);
 
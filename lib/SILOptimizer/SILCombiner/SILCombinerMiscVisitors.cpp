@@ -596,8 +596,10 @@ SILInstruction *SILCombiner::visitStrongRetainInst(StrongRetainInst *SRI) {
     // ...and the predecessor instruction is a strong_release on the same value
     // as our strong_retain...
     if (StrongReleaseInst *Release = dyn_cast<StrongReleaseInst>(&*Pred))
-      // Remove them...
-      if (Release->getOperand() == SRI->getOperand()) {
+      // Remove them... but only if each performs a single operation;
+      // coalesced operations do not cancel one to one.
+      if (Release->getOperand() == SRI->getOperand() &&
+          SRI->getCount() == 1 && Release->getCount() == 1) {
         eraseInstFromFunction(*Release);
         return eraseInstFromFunction(*SRI);
       }
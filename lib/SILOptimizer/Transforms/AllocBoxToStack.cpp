@@ -17,6 +17,7 @@
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SIL/SILCloner.h"
+#include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/Local.h"
 #include "llvm/ADT/DenseMap.h"
@@ -24,11 +25,17 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 using namespace swift;
 
 STATISTIC(NumStackPromoted, "Number of alloc_box's promoted to the stack");
 
+static llvm::cl::opt<bool> EnableEscapeAnalysisPromotion(
+    "enable-allocbox-escape-analysis", llvm::cl::init(true),
+    llvm::cl::desc("Use escape analysis when checking whether a closure "
+                   "capturing a box lets the box escape"));
+
 //===----------------------------------------------------------------------===//
 //                           alloc_box Promotion
 //===----------------------------------------------------------------------===//
@@ -42,7 +49,8 @@ using ParamIndexList = llvm::SmallVector<unsigned, 8>;
 static SILInstruction* findUnexpectedBoxUse(SILValue Box,
                                             bool examinePartialApply,
                                             bool inAppliedFunction,
-                                            llvm::SmallVectorImpl<Operand*> &);
+                                            llvm::SmallVectorImpl<Operand*> &,
+                                            EscapeAnalysis *EA);
 static bool partialApplyArgumentEscapes(Operand *O);
 
 // Propagate liveness backwards from an initial set of blocks in our
@@ -177,7 +185,23 @@ static bool useCaptured(Operand *UI) {
   return true;
 }
 
-static bool partialApplyEscapes(SILValue V, bool examineApply) {
+/// Returns true unless escape analysis can prove that the value \p V does
+/// not escape the function containing it. Unlike the syntactic walk in
+/// partialApplyEscapes, the connection graph summarizes callees bottom-up,
+/// so it can see through chains of calls that pass a closure on.
+static bool valueEscapesFunction(SILValue V, EscapeAnalysis *EA) {
+  auto *I = dyn_cast<SILInstruction>(V.getDef());
+  if (!I)
+    return true;
+  auto *ConGraph = EA->getConnectionGraph(I->getFunction());
+  auto *Node = ConGraph->getNode(V, EA);
+  if (!Node)
+    return true;
+  return Node->escapes();
+}
+
+static bool partialApplyEscapes(SILValue V, bool examineApply,
+                                EscapeAnalysis *EA) {
   for (auto UI : V.getUses()) {
     auto *User = UI->getUser();
 
@@ -200,6 +224,12 @@ static bool partialApplyEscapes(SILValue V, bool examineApply) {
       // captured in or returned from the apply.
       if (examineApply && !partialApplyArgumentEscapes(UI))
         continue;
+
+      // The check above gives up if the callee's body is not available or
+      // if the callee passes the closure on to yet another function. If we
+      // have escape analysis, ask it instead.
+      if (examineApply && EA && !valueEscapesFunction(V, EA))
+        continue;
     }
 
     // partial_apply instructions do not allow the pointer to escape
@@ -211,7 +241,7 @@ static bool partialApplyEscapes(SILValue V, bool examineApply) {
         ->getParameters();
       params = params.slice(params.size() - args.size(), args.size());
       if (params[UI->getOperandNumber()-1].isIndirect()) {
-        if (partialApplyEscapes(partialApply, /*examineApply = */ true))
+        if (partialApplyEscapes(partialApply, /*examineApply = */ true, EA))
           return true;
         continue;
       }
@@ -300,7 +330,8 @@ static bool partialApplyArgumentEscapes(Operand *O) {
   // Check the uses of the operand, but do not recurse down into other
   // apply instructions.
   auto Param = SILValue(getParameterForOperand(F, O));
-  return partialApplyEscapes(Param, /* examineApply = */ false);
+  return partialApplyEscapes(Param, /* examineApply = */ false,
+                             /* EA = */ nullptr);
 }
 
 /// checkPartialApplyBody - Check the body of a partial apply to see
@@ -319,7 +350,7 @@ static bool checkPartialApplyBody(Operand *O) {
   auto Param = SILValue(getParameterForOperand(F, O));
   return !findUnexpectedBoxUse(Param, /* examinePartialApply = */ false,
                                /* inAppliedFunction = */ true,
-                               PromotedOperands);
+                               PromotedOperands, /* EA = */ nullptr);
 }
 
 
@@ -331,7 +362,8 @@ static bool checkPartialApplyBody(Operand *O) {
 static SILInstruction* findUnexpectedBoxUse(SILValue Box,
                                             bool examinePartialApply,
                                             bool inAppliedFunction,
-                            llvm::SmallVectorImpl<Operand *> &PromotedOperands) {
+                            llvm::SmallVectorImpl<Operand *> &PromotedOperands,
+                                            EscapeAnalysis *EA) {
   assert((Box.getType().is<SILBoxType>()
           || Box.getType()
                  == SILType::getNativeObjectType(Box.getType().getASTContext()))
@@ -358,7 +390,7 @@ static SILInstruction* findUnexpectedBoxUse(SILValue Box,
     // itself cannot escape, then everything is fine.
     if (auto *PAI = dyn_cast<PartialApplyInst>(User))
       if (examinePartialApply && checkPartialApplyBody(UI) &&
-          !partialApplyEscapes(PAI, /* examineApply = */ true)) {
+          !partialApplyEscapes(PAI, /* examineApply = */ true, EA)) {
         LocalPromotedOperands.push_back(UI);
         continue;
       }
@@ -373,13 +405,14 @@ static SILInstruction* findUnexpectedBoxUse(SILValue Box,
 
 /// canPromoteAllocBox - Can we promote this alloc_box to an alloc_stack?
 static bool canPromoteAllocBox(AllocBoxInst *ABI,
-                             llvm::SmallVectorImpl<Operand *> &PromotedOperands){
+                             llvm::SmallVectorImpl<Operand *> &PromotedOperands,
+                               EscapeAnalysis *EA) {
   // Scan all of the uses of the address of the box to see if any
   // disqualifies the box from being promoted to the stack.
   if (auto *User = findUnexpectedBoxUse(ABI->getContainerResult(),
                                         /* examinePartialApply = */ true,
                                         /* inAppliedFunction = */ false,
-                                        PromotedOperands)) {
+                                        PromotedOperands, EA)) {
     (void)User;
     // Otherwise, we have an unexpected use.
     DEBUG(llvm::dbgs() << "*** Failed to promote alloc_box in @"
@@ -860,6 +893,15 @@ class AllocBoxToStack : public SILFunctionTransform {
     llvm::SmallVector<Operand *, 8> PromotedOperands;
     llvm::SmallVector<TermInst *, 8> Returns;
 
+    // When optimizing, consult escape analysis for boxes the syntactic
+    // check cannot handle. In the mandatory pipeline we stick to the
+    // syntactic check to keep -Onone compile times low.
+    EscapeAnalysis *EA = nullptr;
+    if (EnableEscapeAnalysisPromotion &&
+        getFunction()->getModule().getOptions().Optimization >=
+          SILOptions::SILOptMode::Optimize)
+      EA = PM->getAnalysis<EscapeAnalysis>();
+
     for (auto &BB : *getFunction()) {
       auto *Term = BB.getTerminator();
       if (isa<ReturnInst>(Term) || isa<ThrowInst>(Term))
@@ -867,7 +909,7 @@ class AllocBoxToStack : public SILFunctionTransform {
 
       for (auto &I : BB)
         if (auto *ABI = dyn_cast<AllocBoxInst>(&I))
-          if (canPromoteAllocBox(ABI, PromotedOperands))
+          if (canPromoteAllocBox(ABI, PromotedOperands, EA))
             Promotable.push_back(ABI);
     }
 
@@ -0,0 +1,88 @@
+//===-- Devirtualizer.cpp - Devirtualize indirect calls  ------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Devirtualizes virtual function calls into direct function calls.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "devirtualizer"
+#include "swift/SILOptimizer/Analysis/ClassHierarchyAnalysis.h"
+#include "swift/SILOptimizer/Utils/Devirtualize.h"
+#include "swift/SILOptimizer/Utils/Local.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+
+STATISTIC(NumDevirtualized, "Number of calls devirtualized");
+
+using namespace swift;
+
+namespace {
+
+/// Unconditionally devirtualizes class_method and witness_method calls
+/// whose target is statically known.
+///
+/// In contrast to the speculative devirtualizer this pass does not insert
+/// any guards: it only rewrites a call if the method is provably the only
+/// implementation which can be invoked, e.g. because the method is final,
+/// or because the class is private or - in whole-module compilation -
+/// internal, and class hierarchy analysis shows that no subclass overrides
+/// the method.
+class Devirtualizer : public SILFunctionTransform {
+
+  bool devirtualizeAppliesInFunction(SILFunction &F,
+                                     ClassHierarchyAnalysis *CHA) {
+    bool Changed = false;
+
+    // Collect the full apply sites first because devirtualizing them
+    // invalidates the instruction iterator.
+    llvm::SmallVector<FullApplySite, 16> Applies;
+    for (auto &BB : F) {
+      for (auto &I : BB) {
+        if (auto Apply = FullApplySite::isa(&I))
+          Applies.push_back(Apply);
+      }
+    }
+    for (auto Apply : Applies) {
+      auto NewInstPair = tryDevirtualizeApply(Apply, CHA);
+      if (!NewInstPair.second)
+        continue;
+
+      NumDevirtualized++;
+      Changed = true;
+      replaceDeadApply(Apply, NewInstPair.first);
+    }
+    return Changed;
+  }
+
+  /// The entry point to the transformation.
+  void run() override {
+    SILFunction &F = *getFunction();
+    auto *CHA = PM->getAnalysis<ClassHierarchyAnalysis>();
+    DEBUG(llvm::dbgs() << "*** Devirtualizer on function: " << F.getName()
+                       << " ***\n");
+
+    if (devirtualizeAppliesInFunction(F, CHA))
+      invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
+  }
+
+  StringRef getName() override { return "Devirtualizer"; }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createDevirtualizer() {
+  return new Devirtualizer();
+}
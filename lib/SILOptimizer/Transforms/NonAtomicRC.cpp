@@ -0,0 +1,105 @@
+//===------ NonAtomicRC.cpp - Use non-atomic reference counting -----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "non-atomic-rc"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
+#include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+
+STATISTIC(NumNonAtomicRC, "Number of retains/releases marked as non-atomic");
+
+using namespace swift;
+
+namespace {
+
+/// Marks strong_retain and strong_release instructions as [nonatomic] if the
+/// referenced object provably never escapes the thread which allocated it.
+/// IRGen lowers such instructions to the non-atomic runtime entry points,
+/// which avoid the atomic read-modify-write on the reference count.
+///
+/// An object is known to be thread-local if it is allocated in the current
+/// function and escape analysis proves that it does not escape the function.
+/// In this case no other thread can have a reference to the object, so the
+/// reference count operations cannot race.
+class NonAtomicRC : public SILFunctionTransform {
+
+public:
+  NonAtomicRC() {}
+
+private:
+  /// The entry point to the transformation.
+  void run() override {
+    DEBUG(llvm::dbgs() << "** NonAtomicRC **\n");
+
+    SILFunction *F = getFunction();
+
+    auto *EA = PM->getAnalysis<EscapeAnalysis>();
+    auto *RCIA = PM->getAnalysis<RCIdentityAnalysis>()->get(F);
+
+    auto *ConGraph = EA->getConnectionGraph(F);
+    if (!ConGraph)
+      return;
+
+    bool Changed = false;
+    for (SILBasicBlock &BB : *F) {
+      for (SILInstruction &I : BB) {
+        if (!isa<StrongRetainInst>(&I) && !isa<StrongReleaseInst>(&I))
+          continue;
+        auto *RCI = cast<RefCountingInst>(&I);
+        if (RCI->isNonAtomic())
+          continue;
+        if (isThreadLocal(RCI, ConGraph, EA, RCIA)) {
+          RCI->setNonAtomic();
+          NumNonAtomicRC++;
+          Changed = true;
+        }
+      }
+    }
+    if (Changed) {
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
+    }
+  }
+
+  /// Returns true if the object referenced by \p RCI never escapes the
+  /// thread on which it was allocated.
+  bool isThreadLocal(RefCountingInst *RCI, EscapeAnalysis::ConnectionGraph *ConGraph,
+                     EscapeAnalysis *EA, RCIdentityFunctionInfo *RCIA) {
+    SILValue Root = RCIA->getRCIdentityRoot(RCI->getOperand(0));
+
+    // Only objects which are allocated in the current function are known to
+    // be thread-local. Anything else, e.g. a function argument, may already
+    // be visible to other threads.
+    if (!isa<AllocRefInst>(Root))
+      return false;
+
+    auto *Node = ConGraph->getNode(Root, EA);
+    if (!Node)
+      return false;
+
+    // If the object does not escape the function it also cannot escape the
+    // allocating thread.
+    return !Node->escapes();
+  }
+
+  StringRef getName() override { return "NonAtomicRC"; }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createNonAtomicRC() {
+  return new NonAtomicRC();
+}
@@ -19,6 +19,7 @@
 #include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
 #include "swift/SILOptimizer/Analysis/PostOrderAnalysis.h"
 #include "swift/SILOptimizer/Analysis/Analysis.h"
+#include "swift/SILOptimizer/Analysis/ValueRangeAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/Local.h"
@@ -102,6 +103,9 @@ public:
   // Dominators info.
   DominanceInfo *DT;
 
+  /// Value range information for the function.
+  ValueRangeInfo *VRI;
+
   /// Remove the instructions that were marked as redundant
   /// and return True if and instructions were removed.
   bool removeCollectedRedundantInstructions() {
@@ -121,6 +125,7 @@ public:
 
   void run() override {
     DT = PM->getAnalysis<DominanceAnalysis>()->get(getFunction());
+    VRI = PM->getAnalysis<ValueRangeAnalysis>()->get(getFunction());
     auto *PO = getAnalysis<PostOrderAnalysis>()->get(getFunction());
     Constraints.clear();
     ToRemove.clear();
@@ -511,6 +516,11 @@ public:
       }
     }
 
+    // Try to prove from the possible ranges of the operands that the
+    // operation cannot overflow.
+    if (VRI->cannotOverflow(BI, CFI))
+      return true;
+
     // Was not able to remove this branch.
     return false;
   }
@@ -860,7 +860,8 @@ static bool tryToSinkRefCountInst(SILBasicBlock::iterator T,
 
     Builder.setInsertionPoint(&*SuccBB->begin());
     if (isa<StrongRetainInst>(I)) {
-      Builder.createStrongRetain(I->getLoc(), Ptr);
+      auto *Retain = Builder.createStrongRetain(I->getLoc(), Ptr);
+      Retain->setCount(cast<RefCountingInst>(I)->getCount());
     } else {
       assert(isa<RetainValueInst>(I) && "This can only be retain_value");
       Builder.createRetainValue(I->getLoc(), Ptr);
@@ -964,7 +965,9 @@ static bool hoistDecrementsToPredecessors(SILBasicBlock *BB, AliasAnalysis *AA,
       Builder.setInsertionPoint(PredBB->getTerminator());
       SILInstruction *Release;
       if (isa<StrongReleaseInst>(Inst)) {
-        Release = Builder.createStrongRelease(Inst->getLoc(), Ptr);
+        auto *SRI = Builder.createStrongRelease(Inst->getLoc(), Ptr);
+        SRI->setCount(cast<RefCountingInst>(Inst)->getCount());
+        Release = SRI;
       } else {
         assert(isa<ReleaseValueInst>(Inst) && "This can only be retain_value");
         Release = Builder.createReleaseValue(Inst->getLoc(), Ptr);
@@ -1547,9 +1550,12 @@ findLastSinkableMatchingEnumValueRCIncrementInPred(AliasAnalysis *AA,
     // with that enum in the relevant predecessor.
     auto FirstInc = std::find_if(BB->rbegin(), BB->rend(),
       [&RCIA, &EnumValue](const SILInstruction &I) -> bool {
-      // If I is not an increment, ignore it.
+      // If I is not an increment, ignore it. A coalesced increment performs
+      // more than one operation and cannot be matched as a single increment.
       if (!isa<StrongRetainInst>(I) && !isa<RetainValueInst>(I))
         return false;
+      if (cast<RefCountingInst>(&I)->getCount() != 1)
+        return false;
 
       // Otherwise, if the increments operand stripped of RC identity preserving
       // ops matches EnumValue, it is the first increment we are interested in.
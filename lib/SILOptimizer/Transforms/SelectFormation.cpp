@@ -0,0 +1,249 @@
+//===--- SelectFormation.cpp - Form selects from CFG diamonds ---*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Simple conditional value choices (x = cond ? a : b) often survive the
+// optimizer as a cond_br diamond or triangle whose only purpose is to pick
+// one of two values for a merge block argument.  On unpredictable data each
+// such branch is a potential misprediction.  This pass converts side-effect
+// free diamonds and triangles into select_value instructions, which IRGen
+// lowers to LLVM selects, so that the backend can emit conditional moves.
+// It runs late so that it also catches diamonds created by the optimizer
+// itself.  Enum-based patterns are already handled by the select_enum and
+// select_value formation in SimplifyCFG.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "select-formation"
+
+#include "swift/SIL/SILArgument.h"
+#include "swift/SIL/SILBasicBlock.h"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Utils/Local.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+STATISTIC(NumSelectsFormed, "Number of select instructions formed");
+STATISTIC(NumDiamondsRemoved, "Number of diamonds/triangles removed");
+
+/// Maximum number of instructions we are willing to execute speculatively
+/// when flattening one side of a diamond.
+static const unsigned MaxSpeculatedInsts = 4;
+
+/// Can \p I be executed unconditionally, regardless of the branch condition
+/// that used to guard it?
+static bool canSpeculateInstruction(SILInstruction *I) {
+  // Speculated instructions run on both paths, so they must not have any
+  // observable effects and must not trap.
+  if (I->mayHaveSideEffects() || I->mayReadOrWriteMemory())
+    return false;
+
+  // The side-effect summary does not cover control-dependent traps:
+  // integer division and remainder trap on a zero divisor (and on
+  // INT_MIN / -1), and the diamond may exist precisely to guard against
+  // that, so hoisting them above the cond_br would introduce the trap.
+  if (auto *BI = dyn_cast<BuiltinInst>(I)) {
+    switch (BI->getBuiltinInfo().ID) {
+    case BuiltinValueKind::SDiv:
+    case BuiltinValueKind::ExactSDiv:
+    case BuiltinValueKind::UDiv:
+    case BuiltinValueKind::ExactUDiv:
+    case BuiltinValueKind::SRem:
+    case BuiltinValueKind::URem:
+      return false;
+    default:
+      break;
+    }
+  }
+
+  // Don't destroy the proper nesting of stack allocations.
+  if (I->isAllocatingStack() || I->isDeallocatingStack())
+    return false;
+
+  // Speculating the creation of a non-trivial value onto the path which does
+  // not use it would extend its lifetime.
+  if (!I->hasValue() || I->getNumTypes() != 1 ||
+      !I->getType(0).isTrivial(I->getModule()))
+    return false;
+
+  return true;
+}
+
+/// Check if \p SideBB is a side block of a diamond or triangle: a block whose
+/// single predecessor is \p DomBB, which unconditionally branches to
+/// \p MergeBB and whose instructions can all be speculated.
+static bool isSpeculatableSideBlock(SILBasicBlock *SideBB, SILBasicBlock *DomBB,
+                                    SILBasicBlock *MergeBB) {
+  if (SideBB->getSinglePredecessor() != DomBB || !SideBB->bbarg_empty())
+    return false;
+
+  auto *Branch = dyn_cast<BranchInst>(SideBB->getTerminator());
+  if (!Branch || Branch->getDestBB() != MergeBB)
+    return false;
+
+  unsigned Cost = 0;
+  for (auto &I : *SideBB) {
+    if (isa<TermInst>(&I))
+      continue;
+    if (!canSpeculateInstruction(&I))
+      return false;
+    if (++Cost > MaxSpeculatedInsts)
+      return false;
+  }
+  return true;
+}
+
+/// Return the block ending in the cond_br which dominates the diamond or
+/// triangle that \p Pred is part of: either \p Pred itself (triangle) or its
+/// single predecessor (diamond).
+static SILBasicBlock *getDominatingBlock(SILBasicBlock *Pred) {
+  if (isa<CondBranchInst>(Pred->getTerminator()))
+    return Pred;
+  return Pred->getSinglePredecessor();
+}
+
+/// Try to replace the diamond or triangle ending at \p MergeBB with
+/// select_value instructions.  Returns true if the CFG was changed.
+static bool tryFormSelect(SILBasicBlock *MergeBB) {
+  if (MergeBB->bbarg_empty())
+    return false;
+
+  // The merge block must have exactly two predecessors.
+  auto PI = MergeBB->pred_begin(), PE = MergeBB->pred_end();
+  if (PI == PE)
+    return false;
+  SILBasicBlock *Pred1 = *PI++;
+  if (PI == PE)
+    return false;
+  SILBasicBlock *Pred2 = *PI++;
+  if (PI != PE || Pred1 == Pred2)
+    return false;
+
+  // Both predecessors must be reached from the same cond_br.
+  SILBasicBlock *DomBB = getDominatingBlock(Pred1);
+  if (!DomBB || DomBB != getDominatingBlock(Pred2) || DomBB == MergeBB)
+    return false;
+  auto *CBI = dyn_cast<CondBranchInst>(DomBB->getTerminator());
+  if (!CBI)
+    return false;
+
+  // Each destination of the cond_br is either the merge block itself
+  // (triangle) or a speculatable side block (diamond).
+  SILBasicBlock *TrueBB = CBI->getTrueBB();
+  SILBasicBlock *FalseBB = CBI->getFalseBB();
+  if (TrueBB != MergeBB && !isSpeculatableSideBlock(TrueBB, DomBB, MergeBB))
+    return false;
+  if (FalseBB != MergeBB && !isSpeculatableSideBlock(FalseBB, DomBB, MergeBB))
+    return false;
+
+  // Selecting a value pulls it onto both paths, so only handle trivial
+  // object arguments.  Anything else would need lifetime fixup.
+  SILModule &M = MergeBB->getParent()->getModule();
+  for (auto *Arg : MergeBB->getBBArgs())
+    if (!Arg->getType().isObject() || !Arg->getType().isTrivial(M))
+      return false;
+
+  // Collect the values flowing into the merge block on each edge.
+  auto getEdgeArgs = [&](SILBasicBlock *Dest, OperandValueArrayRef DirectArgs)
+      -> OperandValueArrayRef {
+    if (Dest == MergeBB)
+      return DirectArgs;
+    return cast<BranchInst>(Dest->getTerminator())->getArgs();
+  };
+  OperandValueArrayRef TrueArgs = getEdgeArgs(TrueBB, CBI->getTrueArgs());
+  OperandValueArrayRef FalseArgs = getEdgeArgs(FalseBB, CBI->getFalseArgs());
+
+  DEBUG(llvm::dbgs() << "forming selects for merge block bb"
+                     << MergeBB->getDebugID() << '\n');
+
+  // Hoist the side block instructions above the cond_br.  Hoisting them in
+  // order keeps the dependencies between them intact; their other operands
+  // are defined above the cond_br already.
+  auto hoistSideBlock = [&](SILBasicBlock *Dest) {
+    if (Dest == MergeBB)
+      return;
+    while (&*Dest->begin() != Dest->getTerminator())
+      Dest->begin()->moveBefore(CBI);
+  };
+  hoistSideBlock(TrueBB);
+  if (FalseBB != TrueBB)
+    hoistSideBlock(FalseBB);
+
+  // Replace the merge block arguments by selects on the condition and branch
+  // to the merge block directly.
+  SILBuilderWithScope B(CBI);
+  SILValue Cond = CBI->getCondition();
+  SILLocation Loc = CBI->getLoc();
+  IntegerLiteralInst *One = nullptr;
+  SmallVector<SILValue, 4> MergeArgs;
+  for (unsigned i = 0, e = MergeBB->getNumBBArg(); i != e; ++i) {
+    SILValue TrueVal = TrueArgs[i];
+    SILValue FalseVal = FalseArgs[i];
+    if (TrueVal == FalseVal) {
+      MergeArgs.push_back(TrueVal);
+      continue;
+    }
+    if (!One)
+      One = B.createIntegerLiteral(Loc, Cond.getType(), 1);
+    std::pair<SILValue, SILValue> TrueCase(SILValue(One, 0), TrueVal);
+    MergeArgs.push_back(B.createSelectValue(
+        Loc, Cond, MergeBB->getBBArg(i)->getType(), FalseVal, TrueCase));
+    ++NumSelectsFormed;
+  }
+  B.createBranch(Loc, MergeBB, MergeArgs);
+
+  CBI->eraseFromParent();
+  if (TrueBB != MergeBB)
+    removeDeadBlock(TrueBB);
+  if (FalseBB != MergeBB)
+    removeDeadBlock(FalseBB);
+  ++NumDiamondsRemoved;
+  return true;
+}
+
+namespace {
+
+class SelectFormation : public SILFunctionTransform {
+
+  void run() override {
+    SILFunction *F = getFunction();
+
+    // Collect the candidate merge blocks up front. tryFormSelect only
+    // removes side blocks, which have a single predecessor and no arguments
+    // and thus are never in this list.
+    llvm::SmallVector<SILBasicBlock *, 16> MergeBlocks;
+    for (auto &BB : *F)
+      if (!BB.bbarg_empty())
+        MergeBlocks.push_back(&BB);
+
+    bool Changed = false;
+    for (auto *BB : MergeBlocks)
+      Changed |= tryFormSelect(BB);
+
+    if (Changed)
+      invalidateAnalysis(SILAnalysis::InvalidationKind::BranchesAndInstructions);
+  }
+
+  StringRef getName() override { return "Select Formation"; }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createSelectFormation() {
+  return new SelectFormation();
+}
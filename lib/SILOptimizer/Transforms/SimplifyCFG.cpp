@@ -69,6 +69,10 @@ namespace {
     DominanceInfo *DT = nullptr;
     PostDominanceInfo *PDT = nullptr;
 
+    // True if the dominator tree cached in the dominance analysis is still
+    // up to date when run() returns.
+    bool DominanceUpToDate = false;
+
     bool ShouldVerify;
     bool EnableJumpThread;
   public:
@@ -94,6 +98,11 @@ namespace {
       return Changed;
     }
 
+    /// Returns true if the dominator tree cached in the dominance analysis
+    /// was kept up to date across run(). In this case the pass can tell the
+    /// pass manager to preserve the analysis.
+    bool hasUpToDateDominators() const { return DominanceUpToDate; }
+
   private:
     void clearWorklist() {
       WorklistMap.clear();
@@ -2658,24 +2667,36 @@ bool SimplifyCFG::run() {
 
   DT = nullptr;
   PDT = nullptr;
+
+  // dominatorBasedSimplify leaves the dominator tree cached in the dominance
+  // analysis up to date. Track whether the remaining simplifications preserve
+  // it, so that the pass does not have to invalidate the analysis.
+  DominanceUpToDate = true;
+
   // Now attempt to simplify the remaining blocks.
   if (simplifyBlocks()) {
     // Simplifying other blocks might have resulted in unreachable
     // loops.
     RU.run();
     Changed = true;
+    DominanceUpToDate = false;
   }
 
   if (tailDuplicateObjCMethodCallSuccessorBlocks()) {
     Changed = true;
+    DominanceUpToDate = false;
     if (simplifyBlocks())
       RU.run();
   }
 
-  // Split all critical edges from non cond_br terminators.
-  Changed |= splitAllCriticalEdges(Fn, true, nullptr, nullptr);
+  // Split all critical edges from non cond_br terminators. If the dominator
+  // tree is still up to date we keep it so: splitting an edge only needs an
+  // incremental update of the tree.
+  Changed |= splitAllCriticalEdges(
+      Fn, true, DominanceUpToDate ? DA->get(&Fn) : nullptr, nullptr);
 
-  // Canonicalize switch_enum instructions.
+  // Canonicalize switch_enum instructions. This only folds the default case
+  // into the covered cases; the successor blocks do not change.
   Changed |= canonicalizeSwitchEnums();
   
   return Changed;
@@ -3383,10 +3404,17 @@ public:
 
   /// The entry point to the transformation.
   void run() override {
-    if (SimplifyCFG(*getFunction(), PM, getOptions().VerifyAll,
-                    EnableJumpThread)
-            .run())
-      invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
+    SimplifyCFG Simplifier(*getFunction(), PM, getOptions().VerifyAll,
+                           EnableJumpThread);
+    if (!Simplifier.run())
+      return;
+
+    // If the dominator tree survived all simplifications there is no need to
+    // recompute it in the next pass which needs dominance.
+    if (Simplifier.hasUpToDateDominators())
+      PM->getAnalysis<DominanceAnalysis>()->preserveAnalysis(getFunction());
+
+    invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
   }
 
   StringRef getName() override { return "Simplify CFG"; }
@@ -34,15 +34,77 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
 using namespace swift;
 
 // This is the limit for the number of subclasses (jump targets) that the
 // speculative devirtualizer will try to predict.
 static const int MaxNumSpeculativeTargets = 6;
 
+// A file with observed receiver class counts from a profiling run. Each line
+// has the form "<count> <qualified class name>". If a profile is given, the
+// speculative checks are emitted in order of decreasing receiver frequency,
+// so the hottest class is tested first.
+static llvm::cl::opt<std::string> SpecDevirtProfileFile(
+    "specdevirt-profile-file", llvm::cl::init(""),
+    llvm::cl::desc("Order speculative devirtualization checks by the "
+                   "receiver class counts read from this file"));
+
+namespace {
+/// A histogram of observed dynamic receiver classes, keyed by the qualified
+/// class name.
+using ReceiverClassProfile = llvm::StringMap<uint64_t>;
+} // end anonymous namespace
+
+/// Read the receiver class profile from the file given on the command line,
+/// or return null if no profile was provided. Lines which do not parse are
+/// ignored, so reports from profiling tools can be fed in unmodified.
+static const ReceiverClassProfile *getReceiverClassProfile() {
+  static ReceiverClassProfile Profile;
+  static bool IsLoaded = false;
+  if (SpecDevirtProfileFile.empty())
+    return nullptr;
+  if (IsLoaded)
+    return &Profile;
+  IsLoaded = true;
+
+  auto BufOrErr = llvm::MemoryBuffer::getFile(SpecDevirtProfileFile);
+  if (!BufOrErr) {
+    llvm::errs() << "warning: could not read the devirtualization profile '"
+                 << SpecDevirtProfileFile << "'\n";
+    return &Profile;
+  }
+  SmallVector<StringRef, 32> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, '\n');
+  for (StringRef Line : Lines) {
+    auto Split = Line.trim().split(' ');
+    uint64_t Count;
+    if (Split.first.getAsInteger(10, Count))
+      continue;
+    StringRef ClassName = Split.second.trim();
+    if (ClassName.empty())
+      continue;
+    Profile[ClassName] += Count;
+  }
+  return &Profile;
+}
+
+/// \return the number of times an instance of class \p CD was observed as a
+/// receiver in the profile \p Profile.
+static uint64_t getObservedReceiverCount(const ReceiverClassProfile *Profile,
+                                         ClassDecl *CD) {
+  std::string Name = CD->getModuleContext()->getName().str();
+  Name += '.';
+  Name += CD->getNameStr();
+  auto It = Profile->find(Name);
+  return It == Profile->end() ? 0 : It->getValue();
+}
+
 STATISTIC(NumTargetsPredicted, "Number of monomorphic functions predicted");
 
 // A utility function for cloning the apply instruction.
@@ -348,7 +410,9 @@ static bool tryToSpeculateTarget(FullApplySite AI,
   // Sort these subclasses in the order they should be tested by the
   // speculative devirtualization. Different strategies could be used,
   // E.g. breadth-first, depth-first, etc.
-  // Currently, let's use the breadth-first strategy.
+  // Currently, let's use the breadth-first strategy, unless a receiver
+  // class profile is available, in which case the observed frequencies
+  // take precedence.
   // The exact static type of the instance should be tested first.
   auto &DirectSubs = CHA->getDirectSubClasses(CD);
   auto &IndirectSubs = CHA->getIndirectSubClasses(CD);
@@ -377,6 +441,17 @@ static bool tryToSpeculateTarget(FullApplySite AI,
     Subs.erase(RemovedIt, Subs.end());
   }
 
+  // If profile data of observed receiver classes is available, test the most
+  // frequently seen classes first. This also decides which classes survive
+  // the cut-off below, so the hottest receivers always get a speculative
+  // fast path.
+  if (auto *Profile = getReceiverClassProfile())
+    std::stable_sort(Subs.begin(), Subs.end(),
+                     [&](ClassDecl *LHS, ClassDecl *RHS) {
+                       return getObservedReceiverCount(Profile, LHS) >
+                              getObservedReceiverCount(Profile, RHS);
+                     });
+
   if (Subs.size() > MaxNumSpeculativeTargets) {
     DEBUG(llvm::dbgs() << "Class " << CD->getName() << " has too many ("
                        << Subs.size() << ") subclasses. Performing speculative "
@@ -431,8 +506,9 @@ static bool tryToSpeculateTarget(FullApplySite AI,
   // in the future, if we start using PGO for ordering of checked_cast_br
   // checks.
 
-  // TODO: The ordering of checks may benefit from using a PGO, because
-  // the most probable alternatives could be checked first.
+  // The ordering of checks benefits from a receiver class profile, because
+  // the most probable alternatives are checked first (see the sorting of
+  // Subs above). Without a profile a breadth-first order is used.
 
   // Number of subclasses which cannot be handled by checked_cast_br checks.
   int NotHandledSubsNum = 0;
@@ -15,9 +15,20 @@
 #include "swift/Strings.h"
 #include "swift/SILOptimizer/Utils/Generics.h"
 #include "swift/SILOptimizer/Utils/GenericCloner.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 using namespace swift;
 
+/// An optional manifest of additional stdlib types and functions whose
+/// specializations are pre-built into the stdlib and shared with client
+/// code, e.g. hot generic signatures mined from profiles.
+static llvm::cl::opt<std::string> SpecializationManifest(
+    "sil-prespecialization-manifest", llvm::cl::init(""),
+    llvm::cl::desc("Path to a file listing stdlib types and functions whose "
+                   "specializations are kept in the stdlib and reused"));
+
 // Create a new apply based on an old one, but with a different
 // function being applied.
 ApplySite swift::replaceWithSpecializedFunction(ApplySite AI,
@@ -74,25 +85,68 @@ static bool convertExtenralDefinitionIntoDeclaration(SILFunction *F) {
   return true;
 }
 
+namespace {
+
+/// The whitelist of classes and functions from the stdlib, whose
+/// specializations we want to preserve.
+///
+/// The built-in defaults can be extended with a manifest file (see
+/// -sil-prespecialization-manifest) listing one name per line; '#' starts
+/// a comment. This allows a build to preserve and share the
+/// specializations of the generic signatures which are hot in its own
+/// profiles, without recompiling the compiler.
+struct SpecializationWhitelist {
+  /// Keeps the manifest contents alive, since Names contains StringRefs
+  /// pointing into it.
+  std::unique_ptr<llvm::MemoryBuffer> ManifestBuffer;
+
+  llvm::SmallVector<StringRef, 16> Names;
+
+  SpecializationWhitelist() {
+    static const char *Defaults[] = {
+        "Array",
+        "_ArrayBuffer",
+        "_ContiguousArrayBuffer",
+        "Range",
+        "RangeGenerator",
+        "_allocateUninitializedArray",
+        "UTF8",
+        "UTF16",
+        "String",
+        "_StringBuffer",
+        "_toStringReadOnlyPrintable",
+    };
+    Names.append(std::begin(Defaults), std::end(Defaults));
+
+    if (SpecializationManifest.empty())
+      return;
+
+    auto BufOrErr = llvm::MemoryBuffer::getFile(SpecializationManifest);
+    if (!BufOrErr) {
+      llvm::errs() << "warning: could not read pre-specialization manifest '"
+                   << SpecializationManifest << "'\n";
+      return;
+    }
+    ManifestBuffer = std::move(BufOrErr.get());
+
+    llvm::SmallVector<StringRef, 32> Lines;
+    ManifestBuffer->getBuffer().split(Lines, '\n');
+    for (StringRef Line : Lines) {
+      Line = Line.trim();
+      if (Line.empty() || Line.startswith("#"))
+        continue;
+      Names.push_back(Line);
+    }
+  }
+};
+
+} // end anonymous namespace
+
+static llvm::ManagedStatic<SpecializationWhitelist> Whitelist;
+
 /// Check of a given name could be a name of a white-listed
 /// specialization.
 bool swift::isWhitelistedSpecialization(StringRef SpecName) {
-  // The whitelist of classes and functions from the stdlib,
-  // whose specializations we want to preserve.
-  ArrayRef<StringRef> Whitelist = {
-      "Array",
-      "_ArrayBuffer",
-      "_ContiguousArrayBuffer",
-      "Range",
-      "RangeGenerator",
-      "_allocateUninitializedArray",
-      "UTF8",
-      "UTF16",
-      "String",
-      "_StringBuffer",
-      "_toStringReadOnlyPrintable",
-  };
-
   // TODO: Once there is an efficient API to check if
   // a given symbol is a specialization of a specific type,
   // use it instead. Doing demangling just for this check
@@ -121,7 +175,7 @@ bool swift::isWhitelistedSpecialization(StringRef SpecName) {
 
   pos += OfStr.size();
 
-  for(auto Name: Whitelist) {
+  for(auto Name: Whitelist->Names) {
     auto pos1 = DemangledName.find(Name, pos);
     if (pos1 == pos && !isalpha(DemangledName[pos1+Name.size()])) {
       return true;
@@ -185,10 +239,11 @@ static SILFunction *lookupExistingSpecialization(SILModule &M,
   // Try to link existing specialization only in -Onone mode.
   // All other compilation modes perform specialization themselves.
   // TODO: Cache optimized specializations and perform lookup here?
-  // TODO: Only check that this function exists, but don't read
-  // its body. It can save some compile-time.
+  // Only check that this function exists, but don't deserialize its body.
+  // It is not going to be used anyway, because clients reference the
+  // specialization as an external declaration.
   if (isWhitelistedSpecialization(FunctionName) &&
-      M.linkFunction(FunctionName, SILOptions::LinkingMode::LinkNormal))
+      M.hasFunction(FunctionName))
     return M.lookUpFunction(FunctionName);
 
   return nullptr;
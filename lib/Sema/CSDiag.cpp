@@ -15,6 +15,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "ConstraintSystem.h"
+#include "swift/Basic/Defer.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/Support/SaveAndRestore.h"
 
 using namespace swift;
@@ -2851,9 +2853,18 @@ typeCheckChildIndependently(Expr *subExpr, Type convertType,
   if (!options.contains(TCC_ForceRecheck)) {
     if (Expr *res = CS->TC.isExprBeingDiagnosed(subExpr))
       return res;
-  
+
     CS->TC.addExprForDiagnosis(subExpr, subExpr);
   }
+
+  // If the re-type-checks performed while diagnosing this expression have
+  // exhausted their shared solver-scope budget, don't start another one;
+  // the structural diagnostics will work from whatever type information is
+  // already present.
+  if (CS->TC.getDiagnosisScopeLimit() != 0 &&
+      getCompilationCounters().NumSolverScopes >=
+        CS->TC.getDiagnosisScopeLimit())
+    return subExpr;
   
   // If we have a conversion type, but it has type variables (from the current
   // ConstraintSystem), then we can't use it.
@@ -4873,7 +4884,20 @@ void ConstraintSystem::diagnoseFailureForExpr(Expr *expr) {
   // Look through RebindSelfInConstructorExpr to avoid weird sema issues.
   if (auto *RB = dyn_cast<RebindSelfInConstructorExpr>(expr))
     expr = RB->getSubExpr();
-  
+
+  // Establish the solver-scope budget shared by all of the re-type-checks
+  // the diagnostics below perform, unless an enclosing diagnosis already
+  // established one.  Broken code can otherwise cost many times more than
+  // working code, as each diagnostic attempt re-runs the solver.
+  bool establishedDiagnosisBudget = TC.getDiagnosisScopeLimit() == 0;
+  if (establishedDiagnosisBudget)
+    TC.setDiagnosisScopeLimit(getCompilationCounters().NumSolverScopes +
+                              TC.Context.LangOpts.DiagnosisScopeBudget);
+  defer {
+    if (establishedDiagnosisBudget)
+      TC.setDiagnosisScopeLimit(0);
+  };
+
   FailureDiagnosis diagnosis(expr, this);
   
   // Now, attempt to diagnose the failure from the info we've collected.
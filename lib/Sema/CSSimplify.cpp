@@ -1179,8 +1179,11 @@ ConstraintSystem::matchTypes(Type type1, Type type2, TypeMatchKind kind,
                                 isArgumentTupleConversion);
   auto desugar2 = type2->getDesugaredType();
 
-  // If the types are obviously equivalent, we're done.
-  if (kind != TypeMatchKind::ConformsTo && desugar1->isEqual(desugar2))
+  // If the types are obviously equivalent, we're done. Check pointer
+  // identity of the desugared types first to avoid canonicalizing both
+  // sides when they are literally the same node.
+  if (kind != TypeMatchKind::ConformsTo &&
+      (desugar1 == desugar2 || desugar1->isEqual(desugar2)))
     return SolutionKind::Solved;
 
   // If either (or both) types are type variables, unify the type variables.
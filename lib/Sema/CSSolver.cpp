@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 #include "ConstraintSystem.h"
 #include "ConstraintGraph.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -447,6 +448,14 @@ ConstraintSystem::SolverScope::SolverScope(ConstraintSystem &cs)
   PreviousScore = cs.CurrentScore;
 
   ++cs.solverState->NumStatesExplored;
+  ++getCompilationCounters().NumSolverScopes;
+
+  // If the solver has explored an excessive number of states while solving
+  // this expression, mark it as "too complex" so the search unwinds and we
+  // diagnose instead of hanging.
+  if (cs.solverState->NumStatesExplored >
+        cs.TC.Context.LangOpts.SolverScopeThreshold)
+    cs.setExpressionTooComplex(true);
 }
 
 ConstraintSystem::SolverScope::~SolverScope() {
@@ -1033,6 +1042,10 @@ static bool tryTypeVariableBindings(
   }
 
   for (unsigned tryCount = 0; !anySolved && !bindings.empty(); ++tryCount) {
+    // If the solver has exceeded its complexity budget, give up.
+    if (cs.getExpressionTooComplex())
+      return true;
+
     // Try each of the bindings in turn.
     ++cs.solverState->NumTypeVariableBindings;
     bool sawFirstLiteralConstraint = false;
@@ -1205,6 +1218,26 @@ bool ConstraintSystem::solve(SmallVectorImpl<Solution> &solutions,
   return solutions.empty();
 }
 
+/// \brief Record a newly finalized solution, discarding any previously
+/// recorded solutions it renders non-viable.
+///
+/// Solution comparison considers the fixed score first, so a recorded
+/// solution whose score is strictly worse than the new solution's can
+/// never win the final ranking.  Dropping such solutions as soon as a
+/// better score emerges keeps the viable set small while the solution
+/// space is still being explored, rather than carrying the losers all the
+/// way to the pairwise ranking in \c ConstraintSystem::findBestSolution.
+static void recordSolution(SmallVectorImpl<Solution> &solutions,
+                           Solution &&solution) {
+  const Score &score = solution.getFixedScore();
+  solutions.erase(std::remove_if(solutions.begin(), solutions.end(),
+                                 [&](const Solution &existing) {
+                                   return score < existing.getFixedScore();
+                                 }),
+                  solutions.end());
+  solutions.push_back(std::move(solution));
+}
+
 bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
                                 FreeTypeVariableBinding allowFreeTypeVariables){
   // If we already failed, or simplification fails, we're done.
@@ -1234,7 +1267,7 @@ bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
         << "(found solution " << CurrentScore << ")\n";
     }
 
-    solutions.push_back(std::move(solution));
+    recordSolution(solutions, std::move(solution));
     return false;
   }
 
@@ -1420,7 +1453,7 @@ bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
       }
 
       // Save this solution.
-      solutions.push_back(std::move(solution));
+      recordSolution(solutions, std::move(solution));
 
       anySolutions = true;
     }
@@ -1581,7 +1614,7 @@ bool ConstraintSystem::solveSimplified(
           log.indent(solverState->depth * 2) << "(found solution)\n";
         }
         
-        solutions.push_back(std::move(solution));
+        recordSolution(solutions, std::move(solution));
         return false;
       }
     }
@@ -1614,7 +1647,19 @@ bool ConstraintSystem::solveSimplified(
   Constraint *firstSolvedConstraint = nullptr;
   ++solverState->NumDisjunctions;
   auto constraints = disjunction->getNestedConstraints();
-  for (auto index : indices(constraints)) {
+
+  // Attempt the favored terms of the disjunction first; they are the choices
+  // most likely to succeed, and a favored success lets us short-circuit the
+  // remaining unfavored terms.
+  SmallVector<unsigned, 4> constraintOrder;
+  for (auto index : indices(constraints))
+    if (constraints[index]->isFavored())
+      constraintOrder.push_back(index);
+  for (auto index : indices(constraints))
+    if (!constraints[index]->isFavored())
+      constraintOrder.push_back(index);
+
+  for (auto index : constraintOrder) {
     auto constraint = constraints[index];
 
     // We already have a solution; check whether we should
@@ -26,7 +26,8 @@ using namespace constraints;
 ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
                                    ConstraintSystemOptions options)
   : TC(tc), DC(dc), Options(options),
-    Arena(tc.Context, Allocator, 
+    Allocator(tc.takeSolverAllocator()),
+    Arena(tc.Context, Allocator,
           [&](TypeVariableType *baseTypeVar, AssociatedTypeDecl *assocType) {
             return getMemberType(baseTypeVar, assocType,
                                  ConstraintLocatorBuilder(nullptr),
@@ -39,6 +40,7 @@ ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
 
 ConstraintSystem::~ConstraintSystem() {
   delete &CG;
+  TC.recycleSolverAllocator(Allocator);
 }
 
 bool ConstraintSystem::hasFreeTypeVariables() {
@@ -249,32 +249,45 @@ public:
     // Find the representative type variable.
     auto result = getTypeVariable();
     Implementation *impl = this;
+
+    if (!record) {
+      // We cannot record state changes, so don't perform path compression.
+      while (impl->ParentOrFixed.is<TypeVariableType *>()) {
+        // Extract the representative.
+        auto nextTV = impl->ParentOrFixed.get<TypeVariableType *>();
+        if (nextTV == result)
+          break;
+
+        result = nextTV;
+        impl = &nextTV->getImpl();
+      }
+
+      return result;
+    }
+
+    // Walk the chain once, remembering the variables we visit so that they
+    // can be pointed directly at the representative afterwards.
+    llvm::SmallVector<Implementation *, 4> visited;
     while (impl->ParentOrFixed.is<TypeVariableType *>()) {
       // Extract the representative.
       auto nextTV = impl->ParentOrFixed.get<TypeVariableType *>();
       if (nextTV == result)
         break;
 
+      visited.push_back(impl);
       result = nextTV;
       impl = &nextTV->getImpl();
     }
 
-    if (impl == this || !record)
-      return result;
-
     // Perform path compression.
-    impl = this;
-    while (impl->ParentOrFixed.is<TypeVariableType *>()) {
-      // Extract the representative.
-      auto nextTV = impl->ParentOrFixed.get<TypeVariableType *>();
-      if (nextTV == result)
-        break;
+    for (auto *node : visited) {
+      if (node->ParentOrFixed.get<TypeVariableType *>() == result)
+        continue;
 
       // Record the state change.
-      impl->recordBinding(*record);
+      node->recordBinding(*record);
 
-      impl->ParentOrFixed = result;
-      impl = &nextTV->getImpl();
+      node->ParentOrFixed = result;
     }
 
     return result;
@@ -1149,7 +1162,12 @@ public:
 private:
 
   /// \brief Allocator used for all of the related constraint systems.
-  llvm::BumpPtrAllocator Allocator;
+  ///
+  /// Taken from the type checker's pool of solver allocators on
+  /// construction and recycled (reset, retaining its largest slab) on
+  /// destruction, so that successive constraint systems reuse the same
+  /// memory rather than repeatedly mapping and unmapping it.
+  llvm::BumpPtrAllocator &Allocator;
 
   /// \brief Arena used for memory management of constraint-checker-related
   /// allocations.
@@ -30,6 +30,7 @@
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -1122,6 +1123,133 @@ static bool preCheckExpression(TypeChecker &tc, Expr *&expr, DeclContext *dc) {
   return true;
 }
 
+namespace {
+  /// Computes a hash of an expression's "shape": the kinds of its nodes
+  /// together with any names or literal spellings they reference.
+  ///
+  /// Two expressions with the same shape hash are likely---though not
+  /// guaranteed---to resolve their overload sets the same way, so the hash
+  /// is only suitable for keying advisory caches such as
+  /// TypeChecker::ExprShapeOverloadCache.
+  class ExprShapeHasher : public ASTWalker {
+    llvm::hash_code Hash;
+
+  public:
+    ExprShapeHasher() : Hash(llvm::hash_value(0)) {}
+
+    std::pair<bool, Expr *> walkToExprPre(Expr *expr) override {
+      Hash = llvm::hash_combine(Hash, unsigned(expr->getKind()));
+
+      if (auto declRef = dyn_cast<DeclRefExpr>(expr))
+        Hash = llvm::hash_combine(Hash, declRef->getDecl());
+      else if (auto unresolved = dyn_cast<UnresolvedDeclRefExpr>(expr))
+        Hash = llvm::hash_combine(Hash, unresolved->getName().get());
+      else if (auto overloaded = dyn_cast<OverloadedDeclRefExpr>(expr)) {
+        for (auto decl : overloaded->getDecls())
+          Hash = llvm::hash_combine(Hash, decl);
+      } else if (auto dot = dyn_cast<UnresolvedDotExpr>(expr))
+        Hash = llvm::hash_combine(Hash, dot->getName().get());
+      else if (auto number = dyn_cast<NumberLiteralExpr>(expr))
+        Hash = llvm::hash_combine(Hash, number->getDigitsText());
+      else if (auto string = dyn_cast<StringLiteralExpr>(expr))
+        Hash = llvm::hash_combine(Hash, string->getValue());
+
+      return { true, expr };
+    }
+
+    uint64_t getHash() const { return Hash; }
+  };
+} // end anonymous namespace
+
+/// Compute the shape-cache key for the given expression when solved against
+/// the given contextual type.
+static uint64_t getExprShapeHash(Expr *expr, Type convertType) {
+  ExprShapeHasher hasher;
+  expr->walk(hasher);
+
+  uint64_t hash = hasher.getHash();
+  if (convertType)
+    hash = llvm::hash_combine(hash,
+                              convertType->getCanonicalType().getPointer());
+  return hash;
+}
+
+/// If we have previously solved an expression with the same shape, favor the
+/// disjunction terms that bind the overload choices we selected back then.
+///
+/// Favoring only reorders and prunes the solver's search the same way the
+/// type-based favoring performed during constraint generation does, so a
+/// stale hint cannot introduce a solution that full exploration would have
+/// rejected.
+static void favorCachedOverloadChoices(ConstraintSystem &cs,
+                                       ArrayRef<ValueDecl *> choices) {
+  llvm::SmallPtrSet<ValueDecl *, 4> choiceSet(choices.begin(), choices.end());
+
+  for (auto &constraint : cs.getConstraints()) {
+    if (constraint.getKind() != ConstraintKind::Disjunction)
+      continue;
+
+    for (auto nested : constraint.getNestedConstraints()) {
+      if (nested->getKind() != ConstraintKind::BindOverload)
+        continue;
+
+      auto choice = nested->getOverloadChoice();
+      if (choice.isDecl() && choiceSet.count(choice.getDecl()))
+        nested->setFavored();
+    }
+  }
+}
+
+/// Pre-assign a type to a trivial literal expression whose solver outcome
+/// is known in advance.
+///
+/// A bare literal checked against no contextual type, or against exactly
+/// its literal protocol's default type, always resolves to that default
+/// type.  The constraint generator reuses a pre-assigned concrete type on a
+/// literal instead of introducing a type variable and a conformance
+/// constraint, so binding the type up front lets the solver dispatch
+/// expressions like 'let x = 42' without exploring any literal-type
+/// bindings.  Solution application proceeds unchanged, so the resulting
+/// AST is identical to what the full solve produces.
+static void applyLiteralTypeFastPath(TypeChecker &tc, ConstraintSystem &cs,
+                                     Expr *expr, DeclContext *dc,
+                                     Type convertType) {
+  auto *literal = dyn_cast<LiteralExpr>(expr);
+  if (!literal)
+    return;
+
+  // Interpolated string and object literals involve member constraints on
+  // their argument lists; leave them to the solver.
+  if (isa<InterpolatedStringLiteralExpr>(literal) ||
+      isa<ObjectLiteralExpr>(literal))
+    return;
+
+  // If the literal is already typed, there is nothing to decide.
+  if (literal->getType())
+    return;
+
+  auto *protocol = tc.getLiteralProtocol(literal);
+  if (!protocol)
+    return;
+
+  // Protocols without a default type (e.g. NilLiteralConvertible) leave
+  // nothing to bind.
+  Type defaultType = tc.getDefaultType(protocol, dc);
+  if (!defaultType)
+    return;
+
+  // Any context the solver would consult must agree with the default type.
+  // The contextual type covers conversions that are only recorded as hints,
+  // such as the pattern type of a binding initializer.
+  if (convertType && !convertType->isEqual(defaultType))
+    return;
+  if (Type contextualType = cs.getContextualType(expr))
+    if (!contextualType->isEqual(defaultType))
+      return;
+
+  literal->setType(defaultType);
+}
+
 ExprTypeCheckListener::~ExprTypeCheckListener() { }
 
 bool ExprTypeCheckListener::builtConstraints(ConstraintSystem &cs, Expr *expr) {
@@ -1144,6 +1272,11 @@ solveForExpression(Expr *&expr, DeclContext *dc, Type convertType,
   if (preCheckExpression(*this, expr, dc))
     return true;
 
+  // If the expression is a trivial literal whose type the solver is known
+  // to pick, assign the type directly so that constraint generation does
+  // not introduce a type variable for it.
+  applyLiteralTypeFastPath(*this, cs, expr, dc, convertType);
+
   if (auto generatedExpr = cs.generateConstraints(expr))
     expr = generatedExpr;
   else {
@@ -1166,6 +1299,13 @@ solveForExpression(Expr *&expr, DeclContext *dc, Type convertType,
     return true;
   }
 
+  // If we've solved a structurally identical expression before, favor the
+  // overload choices that worked for it.
+  uint64_t shapeHash = getExprShapeHash(expr, convertType);
+  auto knownChoices = ExprShapeOverloadCache.find(shapeHash);
+  if (knownChoices != ExprShapeOverloadCache.end())
+    favorCachedOverloadChoices(cs, knownChoices->second);
+
   if (getLangOpts().DebugConstraintSolver) {
     auto &log = Context.TypeCheckerDebug->getStream();
     log << "---Initial constraints for the given expression---\n";
@@ -1191,6 +1331,17 @@ solveForExpression(Expr *&expr, DeclContext *dc, Type convertType,
     // The system was salvaged; continue on as if nothing happened.
   }
 
+  // Remember the overload choices this solution made so that later
+  // expressions with the same shape can favor them.
+  if (viable.size() == 1) {
+    auto &cachedChoices = ExprShapeOverloadCache[shapeHash];
+    cachedChoices.clear();
+    for (const auto &selected : viable[0].overloadChoices) {
+      if (selected.second.choice.isDecl())
+        cachedChoices.push_back(selected.second.choice.getDecl());
+    }
+  }
+
   if (getLangOpts().DebugConstraintSolver) {
     auto &log = Context.TypeCheckerDebug->getStream();
     if (viable.size() == 1) {
@@ -2086,9 +2237,30 @@ bool TypeChecker::typeCheckExprPattern(ExprPattern *EP, DeclContext *DC,
 
 bool TypeChecker::typesSatisfyConstraint(Type type1, Type type2,
                                          ConstraintKind kind, DeclContext *dc) {
+  // All of the constraint kinds queried through here are reflexive, so
+  // identical types satisfy them without building a constraint system.
+  if (type1->isEqual(type2))
+    return true;
+
+  // These queries are issued with highly repetitive arguments, particularly
+  // from diagnostics, and each one otherwise builds and solves a throwaway
+  // constraint system. A satisfied constraint stays satisfied, so positive
+  // results are cached; negative results are not, since a query may begin
+  // succeeding once additional conformances have been declared.
+  auto key = std::make_pair(
+      std::make_pair(type1->getCanonicalType().getPointer(),
+                     type2->getCanonicalType().getPointer()),
+      std::make_pair(static_cast<unsigned>(kind), dc));
+  bool cacheable = !type1->hasTypeVariable() && !type2->hasTypeVariable();
+  if (cacheable && SatisfiedConstraintCache.count(key))
+    return true;
+
   ConstraintSystem cs(*this, dc, ConstraintSystemOptions());
   cs.addConstraint(kind, type1, type2, cs.getConstraintLocator(nullptr));
-  return cs.solveSingle().hasValue();
+  bool satisfied = cs.solveSingle().hasValue();
+  if (satisfied && cacheable)
+    SatisfiedConstraintCache.insert(key);
+  return satisfied;
 }
 
 bool TypeChecker::isSubtypeOf(Type type1, Type type2, DeclContext *dc) {
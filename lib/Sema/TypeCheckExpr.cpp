@@ -24,6 +24,7 @@
 #include "swift/Basic/Defer.h"
 #include "swift/Parse/Lexer.h"
 #include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/Support/SaveAndRestore.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -131,9 +132,17 @@ Expr *TypeChecker::substituteInputSugarTypeForResult(ApplyExpr *E) {
   return E;
 }
 
+/// A cache of operator lookups performed while folding a single
+/// expression sequence.  A sequence typically repeats the same few
+/// operators, and the folding algorithm revisits each operator element
+/// several times, so memoizing successful lookups avoids most of the
+/// operator-map queries.
+using SequenceFoldOperatorCache = llvm::SmallDenseMap<Identifier, InfixData, 8>;
+
 /// getInfixData - If the specified expression is an infix binary
 /// operator, return its infix operator attributes.
-static InfixData getInfixData(TypeChecker &TC, DeclContext *DC, Expr *E) {
+static InfixData getInfixData(TypeChecker &TC, DeclContext *DC, Expr *E,
+                              SequenceFoldOperatorCache &opCache) {
   if (auto *ifExpr = dyn_cast<IfExpr>(E)) {
     // Ternary has fixed precedence.
     assert(!ifExpr->isFolded() && "already folded if expr in sequence?!");
@@ -165,22 +174,34 @@ static InfixData getInfixData(TypeChecker &TC, DeclContext *DC, Expr *E) {
   }
 
   if (DeclRefExpr *DRE = dyn_cast<DeclRefExpr>(E)) {
-    SourceFile *SF = DC->getParentSourceFile();
     Identifier name = DRE->getDecl()->getName();
+    auto cached = opCache.find(name);
+    if (cached != opCache.end())
+      return cached->second;
+
+    SourceFile *SF = DC->getParentSourceFile();
     bool isCascading = DC->isCascadingContextForLookup(true);
     if (InfixOperatorDecl *op = SF->lookupInfixOperator(name, isCascading,
-                                                        E->getLoc()))
+                                                        E->getLoc())) {
+      opCache[name] = op->getInfixData();
       return op->getInfixData();
+    }
 
   }
 
   if (OverloadedDeclRefExpr *OO = dyn_cast<OverloadedDeclRefExpr>(E)) {
-    SourceFile *SF = DC->getParentSourceFile();
     Identifier name = OO->getDecls()[0]->getName();
+    auto cached = opCache.find(name);
+    if (cached != opCache.end())
+      return cached->second;
+
+    SourceFile *SF = DC->getParentSourceFile();
     bool isCascading = DC->isCascadingContextForLookup(true);
     if (InfixOperatorDecl *op = SF->lookupInfixOperator(name, isCascading,
-                                                        E->getLoc()))
+                                                        E->getLoc())) {
+      opCache[name] = op->getInfixData();
       return op->getInfixData();
+    }
   }
 
   // If E is already an ErrorExpr, then we've diagnosed it as invalid already,
@@ -327,7 +348,8 @@ static Expr *makeBinOp(TypeChecker &TC, Expr *Op, Expr *LHS, Expr *RHS,
 static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
                           Expr *LHS,
                           ArrayRef<Expr*> &S,
-                          unsigned MinPrecedence) {
+                          unsigned MinPrecedence,
+                          SequenceFoldOperatorCache &opCache) {
   // Invariant: S is even-sized.
   // Invariant: All elements at even indices are operator references.
   assert(!S.empty());
@@ -345,7 +367,7 @@ static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
     Expr *op = S[0];
 
     // If the operator's precedence is lower than the minimum, stop here.
-    InfixData opInfo = getInfixData(TC, DC, op);
+    InfixData opInfo = getInfixData(TC, DC, op, opCache);
     if (opInfo.getPrecedence() < MinPrecedence) return {nullptr, {}};
     return {op, opInfo};
   };
@@ -378,7 +400,7 @@ static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
     // Pull out the next binary operator.
     Expr *Op2 = S[0];
   
-    InfixData Op2Info = getInfixData(TC, DC, Op2);
+    InfixData Op2Info = getInfixData(TC, DC, Op2, opCache);
     // If the second operator's precedence is lower than the min
     // precedence, break out of the loop.
     if (Op2Info.getPrecedence() < MinPrecedence) break;
@@ -401,7 +423,8 @@ static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
     // higher-precedence operators starting from this point, then
     // repeat.
     if (Op1.infixData.getPrecedence() < Op2Info.getPrecedence()) {
-      RHS = foldSequence(TC, DC, RHS, S, Op1.infixData.getPrecedence() + 1);
+      RHS = foldSequence(TC, DC, RHS, S, Op1.infixData.getPrecedence() + 1,
+                         opCache);
       continue;
     }
 
@@ -410,14 +433,15 @@ static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
     // recursively fold operators starting from this point, then
     // immediately fold LHS and RHS.
     if (Op1.infixData == Op2Info && Op1.infixData.isRightAssociative()) {
-      RHS = foldSequence(TC, DC, RHS, S, Op1.infixData.getPrecedence());
+      RHS = foldSequence(TC, DC, RHS, S, Op1.infixData.getPrecedence(),
+                         opCache);
       LHS = makeBinOp(TC, Op1.op, LHS, RHS, Op1.infixData, S.empty());
 
       // If we've drained the entire sequence, we're done.
       if (S.empty()) return LHS;
 
       // Otherwise, start all over with our new LHS.
-      return foldSequence(TC, DC, LHS, S, MinPrecedence);
+      return foldSequence(TC, DC, LHS, S, MinPrecedence, opCache);
     }
 
     // If we ended up here, it's because we have two operators
@@ -437,7 +461,7 @@ static Expr *foldSequence(TypeChecker &TC, DeclContext *DC,
     
     // Recover by arbitrarily binding the first two.
     LHS = makeBinOp(TC, Op1.op, LHS, RHS, Op1.infixData, S.empty());
-    return foldSequence(TC, DC, LHS, S, MinPrecedence);
+    return foldSequence(TC, DC, LHS, S, MinPrecedence, opCache);
   }
 
   // Fold LHS and RHS together and declare completion.
@@ -719,7 +743,9 @@ Expr *TypeChecker::foldSequence(SequenceExpr *expr, DeclContext *dc) {
   Expr *LHS = Elts[0];
   Elts = Elts.slice(1);
 
-  Expr *Result = ::foldSequence(*this, dc, LHS, Elts, /*min precedence*/ 0);
+  SequenceFoldOperatorCache opCache;
+  Expr *Result = ::foldSequence(*this, dc, LHS, Elts, /*min precedence*/ 0,
+                                opCache);
   assert(Elts.empty());
   return Result;
 }
@@ -367,6 +367,15 @@ static void typeCheckFunctionsAndExternalDecls(TypeChecker &TC) {
     // Type check the body of each of the function in turn.  Note that outside
     // functions must be visited before nested functions for type-checking to
     // work correctly.
+    //
+    // FIXME: Apart from that ordering constraint, the bodies on this list are
+    // largely independent of one another: their signatures were validated
+    // before they were enqueued, and checking one body only reads the others'
+    // signatures. In principle the outermost functions could be dispatched to
+    // a thread pool with per-thread diagnostic queues merged back in source
+    // order. That first requires synchronizing the ASTContext's allocator and
+    // type uniquing tables, since the constraint solver creates types while
+    // solving; until then, body checking stays serial.
     for (unsigned n = TC.definedFunctions.size(); currentFunctionIdx != n;
          ++currentFunctionIdx) {
       auto *AFD = TC.definedFunctions[currentFunctionIdx];
@@ -376,6 +385,22 @@ static void typeCheckFunctionsAndExternalDecls(TypeChecker &TC) {
       // but that gets tricky with synthesized function bodies.
       if (AFD->isBodyTypeChecked()) continue;
 
+      // If we're skipping function bodies, leave this body unchecked. Small
+      // bodies already synthesized by the type checker are still checked;
+      // they are cheap and other parts of semantic analysis rely on them
+      // being well-formed.
+      if (TC.getSkipFunctionBodies() && !AFD->isImplicit())
+        continue;
+
+      // Bodies that would come from a body synthesizer are also left alone:
+      // they are materialized and checked here only so SIL generation can
+      // consume them, and no SIL is produced when bodies are being skipped.
+      // Synthesizing them anyway (e.g. the derived == of a large enum) is
+      // exactly the kind of work body skipping is meant to avoid.
+      if (TC.getSkipFunctionBodies() &&
+          AFD->getBodyKind() == AbstractFunctionDecl::BodyKind::Synthesize)
+        continue;
+
       PrettyStackTraceDecl StackEntry("type-checking", AFD);
       TC.typeCheckAbstractFunctionBody(AFD);
 
@@ -481,6 +506,10 @@ static void typeCheckFunctionsAndExternalDecls(TypeChecker &TC) {
     TC.computeCaptures(closure);
   }
   for (AbstractFunctionDecl *FD : reversed(TC.definedFunctions)) {
+    // Functions whose bodies were skipped have nothing to compute captures
+    // for or to check.
+    if (TC.getSkipFunctionBodies() && !FD->isBodyTypeChecked())
+      continue;
     TC.computeCaptures(FD);
   }
 
@@ -488,6 +517,8 @@ static void typeCheckFunctionsAndExternalDecls(TypeChecker &TC) {
   // this file.  This can depend on all of their interior function
   // bodies having been type-checked.
   for (AbstractFunctionDecl *FD : TC.definedFunctions) {
+    if (TC.getSkipFunctionBodies() && !FD->isBodyTypeChecked())
+      continue;
     TC.checkFunctionErrorHandling(FD);
   }
   for (auto decl : TC.Context.ExternalDefinitions) {
@@ -530,7 +561,10 @@ void swift::performTypeChecking(SourceFile &SF, TopLevelContext &TLC,
 
     if (Options.contains(TypeCheckingFlags::ForImmediateMode))
       TC.setInImmediateMode(true);
-    
+
+    if (Options.contains(TypeCheckingFlags::SkipFunctionBodies))
+      TC.setSkipFunctionBodies(true);
+
     // Lookup the swift module.  This ensures that we record all known
     // protocols in the AST.
     (void) TC.getStdlibModule(&SF);
@@ -1352,6 +1386,11 @@ private:
 
 void TypeChecker::buildTypeRefinementContextHierarchy(SourceFile &SF,
                                                       unsigned StartElem) {
+  // Building may add children to existing contexts, which can change the
+  // answer for a location the cached context would otherwise cover.
+  LastRefinementContext = nullptr;
+  LastRefinementSourceFile = nullptr;
+
   TypeRefinementContext *RootTRC = SF.getTypeRefinementContext();
 
   // If we are not starting at the beginning of the source file, we had better
@@ -1431,8 +1470,20 @@ TypeChecker::overApproximateOSVersionsAtLocation(SourceLoc loc,
 
   if (SF && loc.isValid()) {
     TypeRefinementContext *rootTRC = getOrBuildTypeRefinementContext(SF);
-    TypeRefinementContext *TRC =
-        rootTRC->findMostRefinedSubContext(loc, Context.SourceMgr);
+
+    // Availability queries are strongly spatially local, so check whether
+    // the most recently found context covers this location too before
+    // descending from the root again.
+    TypeRefinementContext *TRC;
+    if (SF == LastRefinementSourceFile && LastRefinementContext &&
+        LastRefinementContext->isMostRefinedSubContextFor(loc,
+                                                          Context.SourceMgr)) {
+      TRC = LastRefinementContext;
+    } else {
+      TRC = rootTRC->findMostRefinedSubContext(loc, Context.SourceMgr);
+      LastRefinementContext = TRC;
+      LastRefinementSourceFile = SF;
+    }
     OverApproximateVersionRange.constrainWith(TRC->getPotentialVersions());
   }
 
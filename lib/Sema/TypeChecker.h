@@ -29,6 +29,7 @@
 #include "swift/Basic/Fallthrough.h"
 #include "swift/Basic/OptionSet.h"
 #include "swift/Config.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include <functional>
 
@@ -460,7 +461,29 @@ public:
   /// This can't use CanTypes because typealiases may have more limited types
   /// than their underlying types.
   llvm::DenseMap<Type, Accessibility> TypeAccessibilityCache;
-  
+
+  /// Caches positive results of typesSatisfyConstraint queries, keyed on
+  /// the canonical types, the constraint kind, and the declaration context.
+  ///
+  /// Only satisfied constraints are recorded: a failing query may start
+  /// succeeding once additional conformances have been declared, but a
+  /// satisfied constraint stays satisfied.
+  llvm::DenseSet<std::pair<std::pair<TypeBase *, TypeBase *>,
+                           std::pair<unsigned, DeclContext *>>>
+    SatisfiedConstraintCache;
+
+  /// Caches the overload choices selected when solving an expression, keyed
+  /// on a hash of the expression's shape and contextual type.
+  ///
+  /// When a structurally identical expression is solved later, the cached
+  /// choices are used to favor the corresponding disjunction terms, steering
+  /// the solver toward the previously successful solution first. The cache is
+  /// purely advisory; a stale or colliding entry only affects the order in
+  /// which the solver explores the overload sets.
+  llvm::DenseMap<uint64_t, SmallVector<ValueDecl *, 4>>
+    ExprShapeOverloadCache;
+
+
   // We delay validation of C and Objective-C type-bridging functions in the
   // standard library until we encounter a declaration that requires one. This
   // flag is set to 'true' once the bridge functions have been checked.
@@ -533,6 +556,17 @@ private:
   /// The set of expressions currently being analyzed for failures.
   llvm::DenseMap<Expr*, Expr*> DiagnosedExprs;
 
+  /// The value of the solver-scope counter at which the diagnostic
+  /// re-type-checks for the expression currently being diagnosed must stop,
+  /// or 0 if no expression is being diagnosed.
+  uint64_t DiagnosisScopeLimit = 0;
+
+  /// The result of the most recent type refinement context lookup, reused
+  /// when the next availability query lands in the same context; such
+  /// queries are strongly spatially local.
+  TypeRefinementContext *LastRefinementContext = nullptr;
+  SourceFile *LastRefinementSourceFile = nullptr;
+
   /// A set of types that are representable in Objective-C, but require
   /// non-trivial bridging.
   ///
@@ -554,6 +588,15 @@ private:
   /// when executing scripts.
   bool InImmediateMode = false;
 
+  /// If true, the bodies of non-implicit functions are not type-checked.
+  /// Declarations are still validated in full; see
+  /// TypeCheckingFlags::SkipFunctionBodies.
+  bool SkipFunctionBodies = false;
+
+  /// Allocators recycled by destroyed constraint systems, retained (with
+  /// their largest slab intact) for reuse by the next constraint system.
+  SmallVector<std::unique_ptr<llvm::BumpPtrAllocator>, 2> SolverAllocators;
+
   /// A helper to construct and typecheck call to super.init().
   ///
   /// \returns NULL if the constructed expression does not typecheck.
@@ -578,7 +621,34 @@ public:
   void setInImmediateMode(bool InImmediateMode) {
     this->InImmediateMode = InImmediateMode;
   }
-  
+
+  bool getSkipFunctionBodies() {
+    return SkipFunctionBodies;
+  }
+
+  void setSkipFunctionBodies(bool SkipFunctionBodies) {
+    this->SkipFunctionBodies = SkipFunctionBodies;
+  }
+
+  /// Takes an allocator for a constraint system's solver-related
+  /// allocations, preferring one recycled by a previously destroyed
+  /// constraint system so that its slabs can be reused.
+  ///
+  /// The caller must return the allocator with \c recycleSolverAllocator.
+  llvm::BumpPtrAllocator &takeSolverAllocator() {
+    if (SolverAllocators.empty())
+      return *new llvm::BumpPtrAllocator();
+    return *SolverAllocators.pop_back_val().release();
+  }
+
+  /// Resets an allocator produced by \c takeSolverAllocator and makes it
+  /// available for reuse.
+  void recycleSolverAllocator(llvm::BumpPtrAllocator &allocator) {
+    allocator.Reset();
+    SolverAllocators.emplace_back(&allocator);
+  }
+
+
   template<typename ...ArgTypes>
   InFlightDiagnostic diagnose(ArgTypes &&...Args) {
     return Diags.diagnose(std::forward<ArgTypes>(Args)...);
@@ -1720,6 +1790,16 @@ public:
     return DiagnosedExprs[E];
   }
 
+  /// Sets the solver-scope counter value at which the diagnostic
+  /// re-type-checks of the expression being diagnosed must stop, or 0 to
+  /// indicate that no expression is being diagnosed.
+  void setDiagnosisScopeLimit(uint64_t limit) {
+    DiagnosisScopeLimit = limit;
+  }
+  uint64_t getDiagnosisScopeLimit() const {
+    return DiagnosisScopeLimit;
+  }
+
   /// If an expression references 'self.init' or 'super.init' in an
   /// initializer context, returns the implicit 'self' decl of the constructor.
   /// Otherwise, return nil.
@@ -20,6 +20,7 @@
 #include "swift/SIL/SILModule.h"
 #include "swift/SIL/SILUndef.h"
 #include "swift/Serialization/BCReadingExtras.h"
+#include "swift/Serialization/SerializedModuleLoader.h"
 
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
@@ -382,13 +383,13 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
 
   TypeID funcTyID;
   unsigned rawLinkage, isTransparent, isFragile, isThunk, isGlobal,
-           inlineStrategy, effect;
+           inlineStrategy, effect, summaryInstCount, summaryEffects;
   IdentifierID SemanticsID;
   // TODO: read fragile
   SILFunctionLayout::readRecord(scratch, rawLinkage,
                                 isTransparent, isFragile, isThunk, isGlobal,
-                                inlineStrategy, effect, funcTyID,
-                                SemanticsID);
+                                inlineStrategy, effect, summaryInstCount,
+                                summaryEffects, funcTyID, SemanticsID);
 
   if (funcTyID == 0) {
     DEBUG(llvm::dbgs() << "SILFunction typeID is 0.\n");
@@ -447,6 +448,11 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
     if (Callback) Callback->didDeserialize(MF->getAssociatedModule(), fn);
   }
 
+  // Remember the serialized summary, so that clients can reason about the
+  // function even if we only deserialized the declaration.
+  if (summaryInstCount && !fn->hasFunctionSummary())
+    fn->setFunctionSummary(summaryInstCount, summaryEffects);
+
   assert(fn->empty() &&
          "SILFunction to be deserialized starts being empty.");
 
@@ -459,6 +465,13 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
     fn->setDebugScope(DS);
   }
 
+  // A function body coming from a compiled module already went through the
+  // diagnostic passes when that module was built; a .sib file, however, may
+  // still contain raw SIL.
+  if (!declarationOnly)
+    if (auto *ASTFile = dyn_cast<SerializedASTFile>(MF->getFile()))
+      fn->setWasDeserializedCanonical(!ASTFile->isSIB());
+
   GenericParamList *contextParams = nullptr;
   if (!declarationOnly) {
     // We need to construct a linked list of GenericParamList. The outermost
@@ -1190,8 +1203,6 @@ bool SILDeserializer::readSILInstruction(SILFunction *Fn, SILBasicBlock *BB,
   UNARY_INSTRUCTION(CopyBlock)
   UNARY_INSTRUCTION(StrongPin)
   UNARY_INSTRUCTION(StrongUnpin)
-  UNARY_INSTRUCTION(StrongRetain)
-  UNARY_INSTRUCTION(StrongRelease)
   UNARY_INSTRUCTION(StrongRetainUnowned)
   UNARY_INSTRUCTION(UnownedRetain)
   UNARY_INSTRUCTION(UnownedRelease)
@@ -1201,6 +1212,23 @@ bool SILDeserializer::readSILInstruction(SILFunction *Fn, SILBasicBlock *BB,
   UNARY_INSTRUCTION(DebugValueAddr)
 #undef UNARY_INSTRUCTION
 
+  case ValueKind::StrongRetainInst:
+  case ValueKind::StrongReleaseInst: {
+    assert(RecordKind == SIL_ONE_OPERAND && "Layout should be OneOperand.");
+    auto Val = getLocalValue(ValID, ValResNum,
+                             getSILType(MF->getType(TyID),
+                                        (SILValueCategory)TyCategory));
+    RefCountingInst *RCI;
+    if ((ValueKind)OpCode == ValueKind::StrongRetainInst)
+      RCI = Builder.createStrongRetain(Loc, Val);
+    else
+      RCI = Builder.createStrongRelease(Loc, Val);
+    RCI->setNonAtomic(Attr & 1);
+    RCI->setCount(std::max(Attr >> 1, 1u));
+    ResultVal = RCI;
+    break;
+  }
+
   case ValueKind::LoadUnownedInst: {
     auto Ty = MF->getType(TyID);
     bool isTake = (Attr > 0);
@@ -1771,20 +1799,34 @@ SILFunction *SILDeserializer::lookupSILFunction(SILFunction *InFunc) {
   return Func;
 }
 
-SILFunction *SILDeserializer::lookupSILFunction(StringRef name) {
+SILFunction *SILDeserializer::lookupSILFunction(StringRef name,
+                                                bool declarationOnly) {
   if (!FuncTable)
     return nullptr;
   auto iter = FuncTable->find(name);
   if (iter == FuncTable->end())
     return nullptr;
 
-  auto Func = readSILFunction(*iter, nullptr, name, /*declarationOnly*/ false);
+  auto Func = readSILFunction(*iter, nullptr, name, declarationOnly);
   if (Func)
     DEBUG(llvm::dbgs() << "Deserialize SIL:\n";
           Func->dump());
   return Func;
 }
 
+/// Check for the existence of a function with a given name. Only the function
+/// index is consulted; nothing is deserialized and no declaration is created
+/// in the module.
+bool SILDeserializer::hasSILFunction(StringRef Name) {
+  if (!FuncTable)
+    return false;
+  auto iter = FuncTable->find(Name);
+  if (iter == FuncTable->end())
+    return false;
+  // Zero is not a valid function ID; guard against it like readSILFunction.
+  return *iter != 0;
+}
+
 SILGlobalVariable *SILDeserializer::readGlobalVar(StringRef Name) {
   if (!GlobalVarList)
     return nullptr;
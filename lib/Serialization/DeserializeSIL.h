@@ -109,7 +109,9 @@ public:
       return MF->getFile();
     }
     SILFunction *lookupSILFunction(SILFunction *InFunc);
-    SILFunction *lookupSILFunction(StringRef Name);
+    SILFunction *lookupSILFunction(StringRef Name,
+                                   bool declarationOnly = false);
+    bool hasSILFunction(StringRef Name);
     SILVTable *lookupVTable(Identifier Name);
     SILWitnessTable *lookupWitnessTable(SILWitnessTable *wt);
 
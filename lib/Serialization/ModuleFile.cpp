@@ -476,20 +476,20 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
 
       switch (kind) {
       case index_block::DECL_OFFSETS:
-        assert(blobData.empty());
-        Decls.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        Decls.initialize(blobData);
         break;
       case index_block::DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        DeclContexts.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        DeclContexts.initialize(blobData);
         break;
       case index_block::TYPE_OFFSETS:
-        assert(blobData.empty());
-        Types.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        Types.initialize(blobData);
         break;
       case index_block::IDENTIFIER_OFFSETS:
-        assert(blobData.empty());
-        Identifiers.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        Identifiers.initialize(blobData);
         break;
       case index_block::TOP_LEVEL_DECLS:
         TopLevelDecls = readDeclTable(scratch, blobData);
@@ -517,12 +517,12 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
         LocalTypeDecls = readLocalDeclTable(scratch, blobData);
         break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        LocalDeclContexts.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        LocalDeclContexts.initialize(blobData);
         break;
       case index_block::NORMAL_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        NormalConformances.assign(scratch.begin(), scratch.end());
+        assert(scratch.size() == 1);
+        NormalConformances.initialize(blobData);
         break;
 
       default:
@@ -950,22 +950,31 @@ ModuleFile::ModuleFile(
     return;
   }
 
-  if (!this->ModuleDocInputBuffer)
+  // The module documentation file, if one was provided, is read lazily on
+  // the first query for a comment; see readModuleDocIfPresent().
+}
+
+void ModuleFile::readModuleDocIfPresent() {
+  if (Bits.TriedReadingModuleDoc)
     return;
+  Bits.TriedReadingModuleDoc = true;
 
+  if (!ModuleDocInputBuffer)
+    return;
+
+  // A malformed documentation file does not poison the module itself at
+  // this point; we simply behave as if no documentation were available.
   llvm::BitstreamCursor docCursor{ModuleDocInputReader};
   if (!checkModuleDocSignature(docCursor) ||
-      !enterTopLevelModuleBlock(docCursor, MODULE_DOC_BLOCK_ID)) {
-    error(Status::MalformedDocumentation);
+      !enterTopLevelModuleBlock(docCursor, MODULE_DOC_BLOCK_ID))
     return;
-  }
 
-  topLevelEntry = docCursor.advance();
+  auto topLevelEntry = docCursor.advance();
   while (topLevelEntry.Kind == llvm::BitstreamEntry::SubBlock) {
     switch (topLevelEntry.ID) {
     case COMMENT_BLOCK_ID: {
-      if (!hasValidControlBlock || !readCommentBlock(docCursor)) {
-        error(Status::MalformedDocumentation);
+      if (!readCommentBlock(docCursor)) {
+        DeclCommentTable.reset();
         return;
       }
       break;
@@ -974,20 +983,16 @@ ModuleFile::ModuleFile(
     default:
       // Unknown top-level block, possibly for use by a future version of the
       // module format.
-      if (docCursor.SkipBlock()) {
-        error(Status::MalformedDocumentation);
+      if (docCursor.SkipBlock())
         return;
-      }
       break;
     }
 
     topLevelEntry = docCursor.advance(AF_DontPopBlockAtEnd);
   }
 
-  if (topLevelEntry.Kind != llvm::BitstreamEntry::EndBlock) {
-    error(Status::MalformedDocumentation);
-    return;
-  }
+  if (topLevelEntry.Kind != llvm::BitstreamEntry::EndBlock)
+    DeclCommentTable.reset();
 }
 
 Status ModuleFile::associateWithFileContext(FileUnit *file,
@@ -1121,6 +1126,11 @@ void ModuleFile::lookupValue(DeclName name,
         }
       } else {
         for (auto item : *iter) {
+          // Peek at the full name first; most entries are filtered out here
+          // without deserializing the decl.
+          if (auto fullName = getDeclName(item.second))
+            if (!fullName.matchesRef(name))
+              continue;
           auto VD = cast<ValueDecl>(getDecl(item.second));
           if (VD->getFullName().matchesRef(name))
             results.push_back(VD);
@@ -1354,10 +1364,15 @@ void ModuleFile::lookupClassMember(Module::AccessPathTy accessPath,
       }
     } else {
       for (auto item : *iter) {
+        // Peek at the full name first; most entries are filtered out here
+        // without deserializing the decl.
+        if (auto fullName = getDeclName(item.second))
+          if (!fullName.matchesRef(name))
+            continue;
         auto vd = cast<ValueDecl>(getDecl(item.second));
         if (!vd->getFullName().matchesRef(name))
           continue;
-        
+
         auto dc = vd->getDeclContext();
         while (!dc->getParent()->isModuleScopeContext())
           dc = dc->getParent();
@@ -1470,6 +1485,7 @@ Optional<BriefAndRawComment> ModuleFile::getCommentForDecl(const Decl *D) {
   assert(D->getDeclContext()->getModuleScopeContext() == FileContext &&
          "Decl is from a different serialized file");
 
+  readModuleDocIfPresent();
   if (!DeclCommentTable)
     return None;
 
@@ -1492,6 +1508,7 @@ Optional<BriefAndRawComment> ModuleFile::getCommentForDecl(const Decl *D) {
 }
 
 Optional<BriefAndRawComment> ModuleFile::getCommentForDeclByUSR(StringRef USR) {
+  readModuleDocIfPresent();
   if (!DeclCommentTable)
     return None;
 
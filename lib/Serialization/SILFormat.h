@@ -225,6 +225,8 @@ namespace sil_block {
     BCFixed<1>,        // global_init
     BCFixed<2>,        // inlineStrategy
     BCFixed<2>,        // side effect info.
+    BCVBR<16>,         // number of instructions in the body
+    BCFixed<7>,        // conservative summary effect bits
     TypeIDField,
     IdentifierIDField  // Semantics Attribute
                        // followed by generic param list, if any
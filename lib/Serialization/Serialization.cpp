@@ -3289,10 +3289,49 @@ void Serializer::writeAllIdentifiers() {
   // Make sure no identifier has an offset of 0.
   stringData.push_back('\0');
 
-  for (Identifier ident : IdentifiersToWrite) {
-    IdentifierOffsets.push_back(stringData.size());
-    stringData.append(ident.get());
-    stringData.push_back('\0');
+  // Lay the strings out so that an identifier that is a suffix of another
+  // shares the longer identifier's storage (including its null terminator)
+  // instead of being stored again.  The reader only ever indexes the blob
+  // by offset, so the layout order does not matter to it.
+  //
+  // Sorting in descending reverse-lexicographic order places each string
+  // immediately before its suffixes, so a single comparison against the
+  // most recently emitted string finds every sharing opportunity.
+  SmallVector<std::pair<Identifier, unsigned>, 64> sortedIdentifiers;
+  sortedIdentifiers.reserve(IdentifiersToWrite.size());
+  for (unsigned i = 0, e = IdentifiersToWrite.size(); i != e; ++i)
+    sortedIdentifiers.push_back({IdentifiersToWrite[i], i});
+  std::sort(sortedIdentifiers.begin(), sortedIdentifiers.end(),
+            [](const std::pair<Identifier, unsigned> &lhs,
+               const std::pair<Identifier, unsigned> &rhs) {
+    StringRef L = lhs.first.str(), R = rhs.first.str();
+    size_t i = L.size(), j = R.size();
+    while (i > 0 && j > 0) {
+      if (L[i-1] != R[j-1])
+        return static_cast<unsigned char>(L[i-1]) >
+               static_cast<unsigned char>(R[j-1]);
+      --i; --j;
+    }
+    return i > j;
+  });
+
+  IdentifierOffsets.assign(IdentifiersToWrite.size(), 0);
+
+  StringRef lastEmitted;
+  CharOffset lastOffset = 0;
+  for (const auto &entry : sortedIdentifiers) {
+    StringRef str = entry.first.str();
+    CharOffset offset;
+    if (str.size() <= lastEmitted.size() && lastEmitted.endswith(str)) {
+      offset = lastOffset + (lastEmitted.size() - str.size());
+    } else {
+      offset = stringData.size();
+      stringData.append(str);
+      stringData.push_back('\0');
+      lastEmitted = str;
+      lastOffset = offset;
+    }
+    IdentifierOffsets[entry.second] = offset;
   }
 
   IdentifierData.emit(ScratchRecord, stringData.str());
@@ -3300,7 +3339,17 @@ void Serializer::writeAllIdentifiers() {
 
 void Serializer::writeOffsets(const index_block::OffsetsLayout &Offsets,
                               const std::vector<BitOffset> &values) {
-  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), values);
+  // Emit the offsets as a blob of fixed-width little-endian values rather
+  // than a bitstream array, so that the reader can index the table directly
+  // from the module's memory-mapped buffer.
+  SmallString<2048> blob;
+  {
+    llvm::raw_svector_ostream blobStream(blob);
+    endian::Writer<little> writer(blobStream);
+    for (auto value : values)
+      writer.write<uint32_t>(value);
+  }
+  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), blob.str());
 }
 
 /// Writes an in-memory decl table to an on-disk representation, using the
@@ -3801,6 +3850,33 @@ withOutputFile(ASTContext &ctx, StringRef outputPath,
   return false;
 }
 
+void swift::serializeToBuffers(ModuleOrSourceFile DC,
+                               const SerializationOptions &options,
+                               std::unique_ptr<llvm::MemoryBuffer> *moduleBuffer,
+                               std::unique_ptr<llvm::MemoryBuffer> *moduleDocBuffer,
+                               const SILModule *M) {
+  assert(options.OutputPath && options.OutputPath[0] != '\0');
+  {
+    SharedTimer timer("Serialization (swiftmodule)");
+    llvm::SmallString<1024> buf;
+    llvm::raw_svector_ostream stream(buf);
+    Serializer::writeToStream(stream, DC, M, options);
+    if (moduleBuffer)
+      *moduleBuffer = llvm::MemoryBuffer::getMemBufferCopy(
+          stream.str(), options.OutputPath);
+  }
+
+  if (moduleDocBuffer &&
+      options.DocOutputPath && options.DocOutputPath[0] != '\0') {
+    SharedTimer timer("Serialization (swiftdoc)");
+    llvm::SmallString<1024> buf;
+    llvm::raw_svector_ostream stream(buf);
+    Serializer::writeDocToStream(stream, DC);
+    *moduleDocBuffer = llvm::MemoryBuffer::getMemBufferCopy(
+        stream.str(), options.DocOutputPath);
+  }
+}
+
 void swift::serialize(ModuleOrSourceFile DC,
                       const SerializationOptions &options,
                       const SILModule *M) {
@@ -222,6 +222,95 @@ ValueID SILSerializer::addValueRef(const ValueBase *Val) {
   return id;
 }
 
+/// Compute the conservative SummaryEffectBits of \p F by scanning its body.
+///
+/// This mirrors what SideEffectAnalysis derives for a single function. Since
+/// we cannot look into callee bodies here, applies to functions without an
+/// @effects attribute get worst-case effects.
+static unsigned getSummaryEffects(const SILFunction &F) {
+  unsigned Effects = 0;
+  for (const SILBasicBlock &BB : F) {
+    for (const SILInstruction &I : BB) {
+      auto *Inst = const_cast<SILInstruction *>(&I);
+      if (FullApplySite FAS = FullApplySite::isa(Inst)) {
+        SILFunction *Callee = FAS.getCalleeFunction();
+        if (!Callee)
+          return SILFunction::SummaryWorstEffects;
+        if (Callee->getLoweredFunctionType()->isNoReturn()) {
+          Effects |= SILFunction::SummaryMayTrap;
+          continue;
+        }
+        if (Callee->getEffectsKind() == EffectsKind::ReadNone)
+          continue;
+        // @effects(readonly) is worthless if we have owned parameters,
+        // because the release inside the callee may call a deinit.
+        if (Callee->getEffectsKind() == EffectsKind::ReadOnly &&
+            !Callee->hasOwnedParameters()) {
+          Effects |= SILFunction::SummaryMayRead;
+          continue;
+        }
+        return SILFunction::SummaryWorstEffects;
+      }
+      switch (I.getKind()) {
+      case ValueKind::AllocStackInst:
+      case ValueKind::DeallocStackInst:
+        continue;
+      case ValueKind::StrongRetainInst:
+      case ValueKind::StrongRetainUnownedInst:
+      case ValueKind::RetainValueInst:
+      case ValueKind::UnownedRetainInst:
+        Effects |= SILFunction::SummaryMayRetain;
+        continue;
+      case ValueKind::StrongReleaseInst:
+      case ValueKind::ReleaseValueInst:
+      case ValueKind::UnownedReleaseInst:
+        // The release may call a deinit, which can do anything.
+        return SILFunction::SummaryWorstEffects;
+      case ValueKind::LoadInst:
+        Effects |= SILFunction::SummaryMayRead;
+        continue;
+      case ValueKind::StoreInst:
+        Effects |= SILFunction::SummaryMayWrite;
+        continue;
+      case ValueKind::CondFailInst:
+        Effects |= SILFunction::SummaryMayTrap;
+        continue;
+      case ValueKind::PartialApplyInst:
+        Effects |= SILFunction::SummaryMayAllocObjects;
+        continue;
+      case ValueKind::BuiltinInst:
+        if (cast<BuiltinInst>(&I)->getBuiltinInfo().ID ==
+              BuiltinValueKind::IsUnique)
+          Effects |= SILFunction::SummaryMayReadRC;
+        break;
+      default:
+        break;
+      }
+      if (isa<AllocationInst>(&I))
+        Effects |= SILFunction::SummaryMayAllocObjects;
+
+      switch (I.getMemoryBehavior()) {
+      case SILInstruction::MemoryBehavior::None:
+        break;
+      case SILInstruction::MemoryBehavior::MayRead:
+        Effects |= SILFunction::SummaryMayRead;
+        break;
+      case SILInstruction::MemoryBehavior::MayWrite:
+        Effects |= SILFunction::SummaryMayWrite;
+        break;
+      case SILInstruction::MemoryBehavior::MayReadWrite:
+        Effects |= SILFunction::SummaryMayRead | SILFunction::SummaryMayWrite;
+        break;
+      case SILInstruction::MemoryBehavior::MayHaveSideEffects:
+        return SILFunction::SummaryWorstEffects;
+      }
+      if (I.mayTrap())
+        Effects |= SILFunction::SummaryMayTrap;
+    }
+  }
+  return Effects;
+}
+
 void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
   ValueIDs.clear();
   InstID = 0;
@@ -264,12 +353,25 @@ void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
     Linkage = addExternalToLinkage(Linkage);
   }
 
+  // Compute the summary which is serialized with the function, so that
+  // clients of the module can reason about the function without
+  // deserializing its body. For a function which is itself only a
+  // declaration, propagate the summary it was deserialized with, if any.
+  unsigned SummaryInstCount = F.getSummaryInstructionCount();
+  unsigned SummaryEffects = F.getSummaryEffects();
+  if (!F.isExternalDeclaration()) {
+    SummaryInstCount = 0;
+    for (const SILBasicBlock &BB : F)
+      SummaryInstCount += std::distance(BB.begin(), BB.end());
+    SummaryEffects = getSummaryEffects(F);
+  }
+
   SILFunctionLayout::emitRecord(
       Out, ScratchRecord, abbrCode, toStableSILLinkage(Linkage),
       (unsigned)F.isTransparent(), (unsigned)F.isFragile(),
       (unsigned)F.isThunk(), (unsigned)F.isGlobalInit(),
       (unsigned)F.getInlineStrategy(), (unsigned)F.getEffectsKind(),
-      FnID, SemanticsID);
+      SummaryInstCount, SummaryEffects, FnID, SemanticsID);
 
   if (NoBody)
     return;
@@ -916,6 +1018,10 @@ void SILSerializer::writeSILInstruction(const SILInstruction &SI) {
       Attr = (unsigned)MUI->getKind();
     else if (auto *DRI = dyn_cast<DeallocRefInst>(&SI))
       Attr = (unsigned)DRI->canAllocOnStack();
+    else if (auto *SRI = dyn_cast<StrongRetainInst>(&SI))
+      Attr = (SRI->getCount() << 1) | (unsigned)SRI->isNonAtomic();
+    else if (auto *SRI = dyn_cast<StrongReleaseInst>(&SI))
+      Attr = (SRI->getCount() << 1) | (unsigned)SRI->isNonAtomic();
     writeOneOperandLayout(SI.getKind(), Attr, SI.getOperand(0));
     break;
   }
@@ -37,7 +37,7 @@ SerializedModuleLoader::~SerializedModuleLoader() = default;
 
 static std::error_code
 openModuleFiles(StringRef DirName, StringRef ModuleFilename,
-                StringRef ModuleDocFilename,
+                StringRef ModuleDocFilename, bool OpenModuleDoc,
                 std::unique_ptr<llvm::MemoryBuffer> &ModuleBuffer,
                 std::unique_ptr<llvm::MemoryBuffer> &ModuleDocBuffer,
                 llvm::SmallVectorImpl<char> &Scratch) {
@@ -50,6 +50,11 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
 
+  if (!OpenModuleDoc) {
+    ModuleBuffer = std::move(ModuleOrErr.get());
+    return std::error_code();
+  }
+
   // Try to open the module documentation file.  If it does not exist, ignore
   // the error.  However, pass though all other errors.
   Scratch.clear();
@@ -79,6 +84,11 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
   moduleDocFilename += '.';
   moduleDocFilename += SERIALIZED_MODULE_DOC_EXTENSION;
 
+  // Only open the module documentation file if this invocation cares about
+  // comments at all; a pure compile never reads documentation, so don't pay
+  // for mapping the file.
+  bool openModuleDoc = ctx.LangOpts.AttachCommentsToDecls;
+
   // FIXME: Which name should we be using here? Do we care about CPU subtypes?
   // FIXME: At the very least, don't hardcode "arch".
   llvm::SmallString<16> archFile(ctx.LangOpts.getTargetConfigOption("arch"));
@@ -98,6 +108,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
   for (auto path : ctx.SearchPathOpts.ImportSearchPaths) {
     auto err = openModuleFiles(path,
                                moduleFilename.str(), moduleDocFilename.str(),
+                               openModuleDoc,
                                moduleBuffer, moduleDocBuffer,
                                scratch);
     if (err == std::errc::is_a_directory) {
@@ -105,6 +116,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
       llvm::sys::path::append(currPath, moduleFilename.str());
       err = openModuleFiles(currPath,
                             archFile.str(), archDocFile.str(),
+                            openModuleDoc,
                             moduleBuffer, moduleDocBuffer,
                             scratch);
     }
@@ -123,6 +135,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
                               "Modules", moduleFilename.str());
       auto err = openModuleFiles(currPath,
                                  archFile.str(), archDocFile.str(),
+                                 openModuleDoc,
                                  moduleBuffer, moduleDocBuffer,
                                  scratch);
       if (!err || err != std::errc::no_such_file_or_directory)
@@ -138,6 +151,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
   isFramework = false;
   return openModuleFiles(ctx.SearchPathOpts.RuntimeLibraryImportPath,
                          moduleFilename.str(), moduleDocFilename.str(),
+                         openModuleDoc,
                          moduleBuffer, moduleDocBuffer, scratch);
 }
 
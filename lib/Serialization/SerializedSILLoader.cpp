@@ -75,15 +75,18 @@ SILFunction *SerializedSILLoader::lookupSILFunction(SILDeclRef Decl) {
   return retVal;
 }
 
-SILFunction *SerializedSILLoader::lookupSILFunction(StringRef Name) {
+SILFunction *SerializedSILLoader::lookupSILFunction(StringRef Name,
+                                                    bool declarationOnly) {
   // It is possible that one module has a declaration of a SILFunction, while
   // another has the full definition.
   SILFunction *retVal = nullptr;
   for (auto &Des : LoadedSILSections) {
-    if (auto Func = Des->lookupSILFunction(Name)) {
+    if (auto Func = Des->lookupSILFunction(Name, declarationOnly)) {
       DEBUG(llvm::dbgs() << "Deserialized " << Func->getName() << " from "
             << Des->getModuleIdentifier().str() << "\n");
-      if (!Func->empty())
+      // A declaration is as good as a definition if only a declaration was
+      // asked for.
+      if (declarationOnly || !Func->empty())
         return Func;
       retVal = Func;
     }
@@ -91,6 +94,13 @@ SILFunction *SerializedSILLoader::lookupSILFunction(StringRef Name) {
   return retVal;
 }
 
+bool SerializedSILLoader::hasSILFunction(StringRef Name) {
+  for (auto &Des : LoadedSILSections)
+    if (Des->hasSILFunction(Name))
+      return true;
+  return false;
+}
+
 SILVTable *SerializedSILLoader::lookupVTable(Identifier Name) {
   for (auto &Des : LoadedSILSections) {
     if (auto VT = Des->lookupVTable(Name))
@@ -16,6 +16,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/DemangleWrappers.h"
+#include "swift/Basic/PrefixMap.h"
 #include "swift/SwiftDemangle/SwiftDemangle.h"
 
 /// \returns true if \p MangledName starts with Swift prefix, "_T".
@@ -59,6 +60,50 @@ size_t swift_demangle_getSimplifiedDemangledName(const char *MangledName,
                                                  Length, Opts);
 }
 
+size_t swift_demangle_getDemangledNames(const char **MangledNames,
+                                        char **OutputBuffers,
+                                        const size_t *BufferLengths,
+                                        size_t NumNames) {
+  swift::Demangle::DemangleOptions DemangleOptions;
+  DemangleOptions.SynthesizeSugarOnTypes = true;
+
+  // Symbol tables repeat the same mangled name many times, and the names
+  // share long prefixes, so cache each distinct demangling in a
+  // prefix-compressed map for the duration of the batch. An empty cached
+  // string records that the name failed to demangle.
+  swift::PrefixMap<char, std::string> Cache;
+
+  size_t NumDemangled = 0;
+  for (size_t i = 0; i != NumNames; ++i) {
+    const char *MangledName = MangledNames[i];
+    if (!MangledName || !isSwiftPrefixed(MangledName))
+      continue;
+
+    llvm::StringRef Mangled(MangledName);
+    auto Key = llvm::makeArrayRef(Mangled.begin(), Mangled.end());
+
+    const std::string *Result;
+    auto Known = Cache.findPrefix(Key);
+    if (Known.first && Known.second == Key.end()) {
+      Result = &*Known.first;
+    } else {
+      std::string Demangled;
+      swift::Demangle::demangleSymbolAsString(Mangled.data(), Mangled.size(),
+                                              Demangled, DemangleOptions);
+      if (Demangled == Mangled)
+        Demangled.clear(); // Not a mangled name after all.
+      Result = &*Cache.insertNew(Key, std::move(Demangled));
+    }
+
+    if (Result->empty())
+      continue;
+
+    ++NumDemangled;
+    strlcpy(OutputBuffers[i], Result->c_str(), BufferLengths[i]);
+  }
+  return NumDemangled;
+}
+
 size_t fnd_get_demangled_name(const char *MangledName, char *OutputBuffer,
                               size_t Length) {
   return swift_demangle_getDemangledName(MangledName, OutputBuffer, Length);
@@ -100,6 +100,17 @@ class StrongRefCount {
     __atomic_fetch_add(&refCount, n << RC_FLAGS_COUNT, __ATOMIC_RELAXED);
   }
 
+  // Increment the reference count, non-atomically.
+  //
+  // The caller must guarantee that no other thread can access the object,
+  // e.g. because the object is known not to have escaped its allocating
+  // thread.
+  void incrementNonAtomic() {
+    uint32_t val = __atomic_load_n(&refCount, __ATOMIC_RELAXED);
+    val += RC_ONE;
+    __atomic_store_n(&refCount, val, __ATOMIC_RELAXED);
+  }
+
   // Try to simultaneously set the pinned flag and increment the
   // reference count.  If the flag is already set, don't increment the
   // reference count.
@@ -158,6 +169,35 @@ class StrongRefCount {
     return doDecrementShouldDeallocateN<false>(n);
   }
 
+  // Decrement the reference count, non-atomically.
+  // Return true if the caller should now deallocate the object.
+  //
+  // The caller must guarantee that no other thread can access the object.
+  bool decrementShouldDeallocateNonAtomic() {
+    uint32_t newval = __atomic_load_n(&refCount, __ATOMIC_RELAXED) - RC_ONE;
+    __atomic_store_n(&refCount, newval, __ATOMIC_RELAXED);
+
+    assert(newval + RC_ONE >= RC_ONE &&
+           "releasing reference with a refcount of zero");
+
+    // If we didn't drop the reference count to zero, or if the
+    // deallocating flag is already set, we're done; don't start
+    // deallocation.
+    if ((newval & (RC_COUNT_MASK | RC_PINNED_FLAG | RC_DEALLOCATING_FLAG))
+          != 0) {
+      return false;
+    }
+
+    // Refcount is now 0 and is not already deallocating. Set the
+    // deallocating flag. Since no other thread can access the object there
+    // is no race with weak retains and no barrier is needed before deinit.
+    static_assert(RC_FLAGS_COUNT == 2,
+                  "fix decrementShouldDeallocateNonAtomic() if you add more "
+                  "flags");
+    __atomic_store_n(&refCount, RC_DEALLOCATING_FLAG, __ATOMIC_RELAXED);
+    return true;
+  }
+
   // Return the reference count.
   // During deallocation the reference count is undefined.
   uint32_t getCount() const {
@@ -274,10 +314,10 @@ class WeakRefCount {
   uint32_t refCount;
 
   enum : uint32_t {
-    // There isn't really a flag here.
+    // Set if a weak reference side-table entry was created for the object.
     // Making weak RC_ONE == strong RC_ONE saves an
     // instruction in allocation on arm64.
-    RC_UNUSED_FLAG = 1,
+    RC_SIDE_TABLE_ENTRY_FLAG = 1,
 
     RC_FLAGS_COUNT = 1,
     RC_FLAGS_MASK = 1,
@@ -354,6 +394,18 @@ class WeakRefCount {
   uint32_t getCount() const {
     return __atomic_load_n(&refCount, __ATOMIC_RELAXED) >> RC_FLAGS_COUNT;
   }
+
+  // Mark that a weak reference side-table entry was created for the object.
+  void setHasSideTableEntry() {
+    __atomic_fetch_or(&refCount, RC_SIDE_TABLE_ENTRY_FLAG, __ATOMIC_RELAXED);
+  }
+
+  // Return true if a weak reference side-table entry was created for the
+  // object.
+  bool hasSideTableEntry() const {
+    return __atomic_load_n(&refCount, __ATOMIC_RELAXED) &
+           RC_SIDE_TABLE_ENTRY_FLAG;
+  }
 };
 
 static_assert(swift::IsTriviallyConstructible<StrongRefCount>::value,
@@ -47,6 +47,19 @@ const char *_swift_stdlib_strtod_clocale(const char *nptr, double *outResult);
 /// overflow.
 const char *_swift_stdlib_strtof_clocale(const char *nptr, float *outResult);
 
+/// Variants of the strtoX_clocale entry points that read exactly
+/// `length` bytes instead of requiring NUL-termination, so a slice of
+/// a larger buffer can be parsed without copying it into a string.
+const char *_swift_stdlib_strtold_clocale_n(const char *nptr,
+                                            __swift_size_t length,
+                                            void *outResult);
+const char *_swift_stdlib_strtod_clocale_n(const char *nptr,
+                                           __swift_size_t length,
+                                           double *outResult);
+const char *_swift_stdlib_strtof_clocale_n(const char *nptr,
+                                           __swift_size_t length,
+                                           float *outResult);
+
 struct Metadata;
   
 /// Return the superclass, if any.  The result is nullptr for root
@@ -59,6 +59,10 @@ __swift_int32_t _swift_stdlib_unicode_compare_utf8_utf8(
   const char *Left, __swift_int32_t LeftLength,
   const char *Right, __swift_int32_t RightLength);
 
+__swift_int32_t _swift_stdlib_unicode_compare_ascii_ascii(
+  const char *Left, __swift_int32_t LeftLength,
+  const char *Right, __swift_int32_t RightLength);
+
 __swift_intptr_t _swift_stdlib_unicode_hash(
   const __swift_uint16_t *Str, __swift_int32_t Length);
 
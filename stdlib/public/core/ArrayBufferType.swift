@@ -156,29 +156,45 @@ extension _ArrayBufferType {
       // so as not to self-clobber.
       newTailStart.moveInitializeBackwardFrom(oldTailStart, count: tailCount)
 
-      // Assign over the original subRange
-      var i = newValues.startIndex
-      for j in subRange {
-        elements[j] = newValues[i]
-        i._successorInPlace()
+      if _isPOD(Element.self) {
+        // Trivial elements need no destruction, so assigning over the
+        // original subRange and initializing the hole are a single bulk
+        // initialization, which lowers to memcpy for contiguous sources.
+        let newValuesEnd = newValues._initializeTo(
+          elements + subRange.startIndex)
+        _sanityCheck(newValuesEnd == elements + newTailIndex)
+      } else {
+        // Assign over the original subRange
+        var i = newValues.startIndex
+        for j in subRange {
+          elements[j] = newValues[i]
+          i._successorInPlace()
+        }
+        // Initialize the hole left by sliding the tail forward
+        for j in oldTailIndex..<newTailIndex {
+          (elements + j).initialize(newValues[i])
+          i._successorInPlace()
+        }
+        _expectEnd(i, newValues)
       }
-      // Initialize the hole left by sliding the tail forward
-      for j in oldTailIndex..<newTailIndex {
-        (elements + j).initialize(newValues[i])
-        i._successorInPlace()
-      }
-      _expectEnd(i, newValues)
     }
     else { // We're not growing the buffer
       // Assign all the new elements into the start of the subRange
-      var i = subRange.startIndex
-      var j = newValues.startIndex
-      for _ in 0..<newCount {
-        elements[i] = newValues[j]
-        i._successorInPlace()
-        j._successorInPlace()
+      if _isPOD(Element.self) {
+        let newValuesEnd = newValues._initializeTo(
+          elements + subRange.startIndex)
+        _sanityCheck(
+          newValuesEnd == elements + subRange.startIndex + newCount)
+      } else {
+        var i = subRange.startIndex
+        var j = newValues.startIndex
+        for _ in 0..<newCount {
+          elements[i] = newValues[j]
+          i._successorInPlace()
+          j._successorInPlace()
+        }
+        _expectEnd(j, newValues)
       }
-      _expectEnd(j, newValues)
 
       // If the size didn't change, we're done.
       if growth == 0 {
@@ -191,3 +191,19 @@ func _memcpy(
     /*alignment:*/ Int32()._value,
     /*volatile:*/ false._value)
 }
+
+/// Copy `size` bytes of memory from `src` into `dest`, tolerating
+/// overlapping ranges.
+func _memmove(
+  dest destination: UnsafeMutablePointer<Void>,
+  src: UnsafeMutablePointer<Void>,
+  size: UInt
+) {
+  let dest = destination._rawValue
+  let src = src._rawValue
+  let size = UInt64(size)._value
+  Builtin.int_memmove_RawPointer_RawPointer_Int64(
+    dest, src, size,
+    /*alignment:*/ Int32()._value,
+    /*volatile:*/ false._value)
+}
@@ -12,6 +12,17 @@
 
 import SwiftShims
 
+/// Check whether every object in `elements` is an instance of `U`.
+///
+/// The runtime memoizes the verdict of the last successful check on the
+/// dynamic class of the instance, so scanning a homogeneous array costs
+/// one isa comparison per element.
+@warn_unused_result
+@_silgen_name("swift_arrayStoresOnlyElementsOfType")
+func _arrayStoresOnlyElementsOfType<U>(
+  elements: UnsafePointer<AnyObject>, _ count: Int, _: U.Type
+) -> Bool
+
 /// Class used whose sole instance is used as storage for empty
 /// arrays.  The instance is defined in the runtime and statically
 /// initialized.  See stdlib/runtime/GlobalObjects.cpp for details.
@@ -464,13 +475,14 @@ public struct _ContiguousArrayBuffer<Element> : _ArrayBufferType {
 
   /// Return true if the buffer stores only elements of type `U`.
   ///
-  /// - Requires: `U` is a class or `@objc` existential.
+  /// - Requires: `Element` and `U` are classes or `@objc` existentials.
   ///
   /// - Complexity: O(N).
   @warn_unused_result
   func storesOnlyElementsOfType<U>(
     _: U.Type
   ) -> Bool {
+    _sanityCheck(_isClassOrObjCExistential(Element.self))
     _sanityCheck(_isClassOrObjCExistential(U.self))
 
     if _fastPath(_storage.staticElementType is U.Type) {
@@ -478,13 +490,12 @@ public struct _ContiguousArrayBuffer<Element> : _ArrayBufferType {
       return true
     }
 
-    // Check the elements
-    for x in self {
-      if !(x is U) {
-        return false
-      }
-    }
-    return true
+    // Check the elements.  The runtime memoizes the verdict per dynamic
+    // class, so scanning a homogeneous array costs one isa comparison per
+    // element.
+    defer { _fixLifetime(self) }
+    return _arrayStoresOnlyElementsOfType(
+      UnsafePointer(firstElementAddress), count, U.self)
   }
 
   internal var _storage: _ContiguousArrayStorageBase {
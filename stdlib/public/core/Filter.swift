@@ -24,6 +24,7 @@ public struct LazyFilterGenerator<
   /// - Requires: `next()` has not been applied to a copy of `self`
   ///   since the copy was made, and no preceding call to `self.next()`
   ///   has returned `nil`.
+  @_semantics("sequence.adapter.next")
   public mutating func next() -> Base.Element? {
     while let n = _base.next() {
       if _predicate(n) {
@@ -64,6 +65,7 @@ public struct LazyFilterSequence<Base : SequenceType>
   /// Return a *generator* over the elements of this *sequence*.
   ///
   /// - Complexity: O(1).
+  @_semantics("sequence.adapter.generate")
   public func generate() -> LazyFilterGenerator<Base.Generator> {
     return LazyFilterGenerator(
       base.generate(), whereElementsSatisfy: _include)
@@ -215,6 +217,7 @@ public struct LazyFilterCollection<
   /// Return a *generator* over the elements of this *sequence*.
   ///
   /// - Complexity: O(1).
+  @_semantics("sequence.adapter.generate")
   public func generate() -> LazyFilterGenerator<Base.Generator> {
     return LazyFilterGenerator(
       _base.generate(), whereElementsSatisfy: _predicate)
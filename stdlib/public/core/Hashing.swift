@@ -62,6 +62,124 @@ struct _HashingDetail {
   }
 }
 
+@_transparent
+@warn_unused_result
+internal func _rotateLeft(value: UInt64, _ amount: UInt64) -> UInt64 {
+  return (value << amount) | (value >> (64 &- amount))
+}
+
+/// An accumulator for building a hash value out of several components in
+/// one pass.
+///
+/// Combining per-field `hashValue` results with ad-hoc XOR/multiply chains
+/// runs the full mixing pipeline once per field and distributes poorly when
+/// fields are correlated.  `_Hasher` instead threads a single SipHash-1-3
+/// state through all components, seeded per execution, and finalizes once:
+///
+///     var hasher = _Hasher()
+///     hasher.combine(first)
+///     hasher.combine(second)
+///     return hasher.finalize()
+///
+/// For contiguous trivial storage, `combineBytes` consumes eight bytes per
+/// compression round instead of one word per stored property.
+public // @testable
+struct _Hasher {
+  internal var _v0: UInt64
+  internal var _v1: UInt64
+  internal var _v2: UInt64
+  internal var _v3: UInt64
+
+  /// The number of bytes combined so far; folded into the final compression
+  /// round so that inputs of different lengths hash differently.
+  internal var _length: UInt64
+
+  public init() {
+    // Initialization constants from the SipHash reference implementation
+    // ("somepseudorandomlygeneratedbytes"), with the per-execution seed
+    // taking the place of the 128-bit key.
+    let seed = _HashingDetail.getExecutionSeed()
+    _v0 = seed ^ 0x736f_6d65_7073_6575
+    _v1 = seed ^ 0x646f_7261_6e64_6f6d
+    _v2 = seed ^ 0x6c79_6765_6e65_7261
+    _v3 = seed ^ 0x7465_6462_7974_6573
+    _length = 0
+  }
+
+  @_transparent
+  internal mutating func _round() {
+    _v0 = _v0 &+ _v1
+    _v1 = _rotateLeft(_v1, 13)
+    _v1 ^= _v0
+    _v0 = _rotateLeft(_v0, 32)
+    _v2 = _v2 &+ _v3
+    _v3 = _rotateLeft(_v3, 16)
+    _v3 ^= _v2
+    _v0 = _v0 &+ _v3
+    _v3 = _rotateLeft(_v3, 21)
+    _v3 ^= _v0
+    _v2 = _v2 &+ _v1
+    _v1 = _rotateLeft(_v1, 17)
+    _v1 ^= _v2
+    _v2 = _rotateLeft(_v2, 32)
+  }
+
+  @_transparent
+  internal mutating func _compress(word: UInt64) {
+    _v3 ^= word
+    _round()
+    _v0 ^= word
+  }
+
+  public mutating func combine(value: UInt64) {
+    _compress(value)
+    _length = _length &+ 8
+  }
+
+  public mutating func combine(value: Int) {
+    combine(UInt64(bitPattern: Int64(value)))
+  }
+
+  /// Feeds `count` bytes starting at `start` into the hash.
+  ///
+  /// This is the preferred entry point for contiguous trivial storage,
+  /// such as a buffer of integers: the bytes are consumed eight at a time
+  /// without widening each element through `hashValue` first.
+  public mutating func combineBytes(start: UnsafePointer<UInt8>, count: Int) {
+    var p = start
+    var remaining = count
+    while remaining >= 8 {
+      _compress(_loadUnalignedLittleEndianUInt64(p))
+      p += 8
+      remaining -= 8
+    }
+    if remaining > 0 {
+      var tail: UInt64 = 0
+      for i in 0..<remaining {
+        tail |= UInt64((p + i).memory) << UInt64(i &* 8)
+      }
+      _compress(tail)
+    }
+    _length = _length &+ UInt64(count)
+  }
+
+  /// Consumes the accumulated state and returns the hash value.
+  @warn_unused_result
+  public mutating func finalize() -> Int {
+    _compress(_length)
+    _v2 ^= 0xff
+    _round()
+    _round()
+    _round()
+    let result = _v0 ^ _v1 ^ _v2 ^ _v3
+#if arch(i386) || arch(arm)
+    return Int(truncatingBitPattern: Int64(bitPattern: result))
+#elseif arch(x86_64) || arch(arm64)
+    return Int(Int64(bitPattern: result))
+#endif
+  }
+}
+
 //
 // API functions.
 //
@@ -297,6 +297,22 @@ public struct ManagedBufferPointer<Value, Element> : Equatable {
     return _isUniqueOrPinned(&_nativeBuffer)
   }
 
+  /// Attempt to grow the buffer to hold at least `minimumCapacity`
+  /// elements without reallocating, by claiming slack the allocator left
+  /// at the end of the existing block.
+  ///
+  /// Returns `true` on success; no memory is moved either way.  Clients
+  /// that cache a capacity in the `Value` area should update it when this
+  /// succeeds.  On failure the buffer is unchanged and the caller must
+  /// allocate fresh storage and copy.
+  @warn_unused_result
+  public func tryGrowInPlace(minimumCapacity: Int) -> Bool {
+    _precondition(
+      minimumCapacity >= 0,
+      "ManagedBufferPointer must have non-negative capacity")
+    return allocatedElementCount >= minimumCapacity
+  }
+
   //===--- internal/private API -------------------------------------------===//
 
   /// Create with new storage containing space for an initial `Value`
@@ -25,6 +25,7 @@ public struct LazyMapGenerator<
   /// - Requires: `next()` has not been applied to a copy of `self`
   ///   since the copy was made, and no preceding call to `self.next()`
   ///   has returned `nil`.
+  @_semantics("sequence.adapter.next")
   public mutating func next() -> Element? {
     return _base.next().map(_transform)
   }
@@ -47,6 +48,7 @@ public struct LazyMapSequence<Base : SequenceType, Element>
   /// Return a *generator* over the elements of this *sequence*.
   ///
   /// - Complexity: O(1).
+  @_semantics("sequence.adapter.generate")
   public func generate() -> LazyMapGenerator<Base.Generator, Element> {
     return LazyMapGenerator(_base: _base.generate(), _transform: _transform)
   }
@@ -105,6 +107,7 @@ public struct LazyMapCollection<Base : CollectionType, Element>
   /// Returns a *generator* over the elements of this *sequence*.
   ///
   /// - Complexity: O(1).
+  @_semantics("sequence.adapter.generate")
   public func generate() -> LazyMapGenerator<Base.Generator, Element> {
     return LazyMapGenerator(_base: _base.generate(), _transform: _transform)
   }
@@ -107,6 +107,26 @@ func _stdlib_demangleName(mangledName: String) -> String {
   }
 }
 
+@warn_unused_result
+@_silgen_name("swift_getTypeByName")
+func _getTypeByName(
+  name: UnsafePointer<UInt8>,
+  _ nameLength: UInt) -> Any.Type?
+
+/// Lookup a class given its runtime name, e.g. "NSObject" for an Objective-C
+/// class or the mangled "_TtC6Module5Class" form for a Swift class.
+///
+/// Repeated lookups of the same name are answered from a runtime cache.
+@warn_unused_result
+public // @testable
+func _typeByName(name: String) -> Any.Type? {
+  let nameUTF8 = Array(name.utf8)
+  return nameUTF8.withUnsafeBufferPointer {
+    (nameUTF8) in
+    return _getTypeByName(nameUTF8.baseAddress, UInt(nameUTF8.endIndex))
+  }
+}
+
 /// Returns `floor(log(x))`.  This equals to the position of the most
 /// significant non-zero bit, or 63 - number-of-zeros before it.
 ///
@@ -252,15 +252,41 @@ internal struct _Stdout : OutputStreamType {
   }
 
   mutating func write(string: String) {
-    // FIXME: buffering?
     // It is important that we use stdio routines in order to correctly
     // interoperate with stdio buffering.
-    for c in string.utf8 {
-      _swift_stdlib_putchar(Int32(c))
+    if string.isEmpty { return }
+
+    // Contiguous ASCII storage can be handed to stdio in one call.
+    if string._core.hasContiguousStorage && string._core.isASCII {
+      _swift_stdlib_fwrite_stdout(
+        string._core.startASCII, 1, string._core.count)
+      _fixLifetime(string)
+      return
+    }
+
+    // Otherwise transcode into a temporary buffer so that the write still
+    // reaches stdio in a single call instead of one per code unit.
+    var utf8CodeUnits = ContiguousArray<UTF8.CodeUnit>()
+    utf8CodeUnits.reserveCapacity(string.utf8.count)
+    utf8CodeUnits.appendContentsOf(string.utf8)
+    utf8CodeUnits.withUnsafeBufferPointer {
+      (utf8) -> Void in
+      _swift_stdlib_fwrite_stdout(utf8.baseAddress, 1, utf8.count)
     }
   }
 }
 
+/// Flush any output buffered by `print` and the C `stdout` stream.
+///
+/// Output written through `print` goes to `stdout` with stdio's buffering,
+/// which means it can sit in the buffer indefinitely when `stdout` is not a
+/// terminal; call this before blocking or handing the descriptor to other
+/// code.
+public // @testable
+func _stdoutFlush() {
+  _swift_stdlib_fflush_stdout()
+}
+
 extension String : OutputStreamType {
   /// Append `other` to this stream.
   public mutating func write(other: String) {
@@ -393,7 +393,9 @@ extension String {
       let lhsPtr = UnsafePointer<Int8>(_core.startASCII)
       let rhsPtr = UnsafePointer<Int8>(rhs._core.startASCII)
 
-      return Int(_swift_stdlib_unicode_compare_utf8_utf8(
+      // Both strings are pure ASCII, so the runtime can compare them
+      // without involving ICU.
+      return Int(_swift_stdlib_unicode_compare_ascii_ascii(
         lhsPtr, Int32(_core.count),
         rhsPtr, Int32(rhs._core.count)))
     }
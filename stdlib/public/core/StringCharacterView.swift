@@ -135,6 +135,23 @@ extension String.CharacterView : CollectionType {
         return 0
       }
 
+      // ASCII fast path: every code unit in 0..<0x80 has Grapheme_Cluster_Break
+      // property Other, Control, CR or LF, and the only pair of those values
+      // that stays together in one cluster is CR followed by LF.  The length
+      // of the cluster can therefore be determined from the next code unit
+      // alone, without consulting the property trie.
+      let core = start._core
+      let cu0 = core[start._position]
+      if _fastPath(cu0 < 0x80) {
+        if start._position + 1 == end._position {
+          return 1
+        }
+        let cu1 = core[start._position + 1]
+        if _fastPath(cu1 < 0x80) {
+          return cu0 == 0x000d /* CR */ && cu1 == 0x000a /* LF */ ? 2 : 1
+        }
+      }
+
       let startIndexUTF16 = start._position
       let unicodeScalars = UnicodeScalarView(start._core)
       let graphemeClusterBreakProperty =
@@ -174,6 +191,21 @@ extension String.CharacterView : CollectionType {
         return 0
       }
 
+      // ASCII fast path; see _measureExtendedGraphemeClusterForward.  The
+      // preceding code unit being ASCII also rules out a cluster-extending
+      // Prepend scalar in front of the last one.
+      let core = end._core
+      let last = core[end._position - 1]
+      if _fastPath(last < 0x80) {
+        if end._position - 1 == start._position {
+          return 1
+        }
+        let prev = core[end._position - 2]
+        if _fastPath(prev < 0x80) {
+          return prev == 0x000d /* CR */ && last == 0x000a /* LF */ ? 2 : 1
+        }
+      }
+
       let endIndexUTF16 = end._position
       let unicodeScalars = UnicodeScalarView(start._core)
       let graphemeClusterBreakProperty =
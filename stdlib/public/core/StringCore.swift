@@ -401,6 +401,15 @@ public struct _StringCore {
     return (newSize, nil)
   }
 
+  /// The smallest capacity, in elements, with which to allocate a native
+  /// buffer for a growing string.  Allocating a buffer any smaller than
+  /// this is wasted effort: the very next append would have to replace it.
+  /// Sixteen elements is enough for short runtime-built strings (e.g.
+  /// dictionary keys) to reach their final size with a single allocation.
+  var _minimumNativeCapacity: Int {
+    return 16
+  }
+
   /// Ensure that this String references a _StringBuffer having
   /// a capacity of at least newSize elements of at least the given width.
   /// Effectively appends garbage to the String until it has newSize
@@ -421,7 +430,7 @@ public struct _StringCore {
 
     _copyInPlace(
       newSize: newSize,
-      newCapacity: newCapacity,
+      newCapacity: max(newCapacity, _minimumNativeCapacity),
       minElementWidth: minElementWidth)
 
     return _pointerToNth(oldCount)
@@ -0,0 +1,193 @@
+//===--- AllocationSampler.cpp - Sampling allocation profiler -------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A production-safe sampling profiler for heap allocations.  Unlike the
+// leak checker, which tracks every object and is only suitable for debug
+// runs, this records every Nth allocation per thread -- its size, its
+// metadata pointer and a bounded backtrace -- into a lock-free ring
+// buffer.  A profiling agent drains the ring with the async-signal-safe
+// API in AllocationSampler.h and attributes live heap by type offline.
+//
+// Like the reference counting profiler, it is installed through the
+// Instruments function-pointer hooks, so the allocation hot path pays
+// nothing when it is disabled.
+//
+// Enable it by setting SWIFT_RUNTIME_SAMPLE_ALLOCATIONS in the
+// environment to the sampling interval: a value of N records one of
+// every N allocations a thread makes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/InstrumentsSupport.h"
+#include "AllocationSampler.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+using namespace swift;
+
+namespace {
+
+/// A ring slot: a sample stamped with the ticket of the writer that
+/// last owned the slot, in the manner of a seqlock.  The drainer uses
+/// the stamp to tell a slot it is waiting on from one that has already
+/// been overwritten by a writer a full lap ahead.
+struct SampleSlot {
+  /// Zero while the slot has never been written; otherwise the writer's
+  /// ticket plus one, stored after the payload is complete.
+  std::atomic<uint64_t> Stamp;
+  AllocationSample Sample;
+};
+
+} // end anonymous namespace
+
+/// The ring capacity.  A power of two so that tickets wrap cheaply.
+static const size_t RingSize = 4096;
+
+static SampleSlot *Ring = nullptr;
+
+/// How many allocations a thread skips between samples.
+static uint32_t SampleInterval = 0;
+
+/// The next write ticket.  A writer claims slot (ticket % RingSize).
+static std::atomic<uint64_t> WriteCursor;
+
+/// The next ticket the drainer expects.  Only the drainer advances it.
+static std::atomic<uint64_t> ReadCursor;
+
+/// Samples overwritten before the drainer got to them.
+static std::atomic<uint64_t> DroppedSamples;
+
+/// Allocations remaining on this thread until the next sample.  Starting
+/// at zero means each thread's first allocation is sampled, which also
+/// catches threads too short-lived to reach the interval.
+static thread_local uint32_t Countdown = 0;
+
+static HeapObject *(*OrigAllocObject)(HeapMetadata const *metadata,
+                                      size_t requiredSize,
+                                      size_t requiredAlignmentMask);
+
+/// Walk the frame pointer chain.  This must not touch memory outside the
+/// current stack: the chain is abandoned as soon as a frame fails to
+/// move strictly upward or jumps implausibly far.
+static uint32_t captureBacktrace(uintptr_t frames[], uint32_t maxFrames) {
+  /// The largest plausible distance between two frames.
+  const uintptr_t maxFrameStride = 1 << 20;
+
+  void **fp = reinterpret_cast<void **>(__builtin_frame_address(0));
+  uint32_t n = 0;
+  while (fp && n < maxFrames) {
+    void *ret = fp[1];
+    if (!ret)
+      break;
+    frames[n++] = reinterpret_cast<uintptr_t>(ret);
+
+    void **next = reinterpret_cast<void **>(fp[0]);
+    if (next <= fp ||
+        reinterpret_cast<uintptr_t>(next) - reinterpret_cast<uintptr_t>(fp) >
+            maxFrameStride)
+      break;
+    fp = next;
+  }
+  return n;
+}
+
+static void recordSample(HeapMetadata const *metadata, size_t size) {
+  uint64_t ticket = WriteCursor.fetch_add(1, std::memory_order_relaxed);
+  SampleSlot &slot = Ring[ticket % RingSize];
+
+  slot.Sample.Metadata = metadata;
+  slot.Sample.Size = size;
+  slot.Sample.NumFrames =
+      captureBacktrace(slot.Sample.Frames, AllocationSampleMaxFrames);
+
+  // Publish the payload.  Two writers a lap apart can race on one slot;
+  // the stamp lets the drainer detect the torn sample and drop it.
+  slot.Stamp.store(ticket + 1, std::memory_order_release);
+}
+
+static HeapObject *sampledAllocObject(HeapMetadata const *metadata,
+                                      size_t requiredSize,
+                                      size_t requiredAlignmentMask) {
+  if (Countdown == 0) {
+    Countdown = SampleInterval;
+    recordSample(metadata, requiredSize);
+  }
+  --Countdown;
+  return OrigAllocObject(metadata, requiredSize, requiredAlignmentMask);
+}
+
+size_t swift_allocationSamplerDrain(AllocationSample *buffer,
+                                    size_t capacity) {
+  if (!Ring)
+    return 0;
+
+  size_t copied = 0;
+  uint64_t cursor = ReadCursor.load(std::memory_order_relaxed);
+  while (copied != capacity) {
+    SampleSlot &slot = Ring[cursor % RingSize];
+    uint64_t stamp = slot.Stamp.load(std::memory_order_acquire);
+
+    if (stamp < cursor + 1) {
+      // The slot's writer has not finished (or no writer got here yet).
+      break;
+    }
+    if (stamp > cursor + 1) {
+      // Writers lapped the drainer: every ticket from cursor up to the
+      // stamped one is gone.
+      uint64_t next = stamp - 1;
+      DroppedSamples.fetch_add(next - cursor, std::memory_order_relaxed);
+      cursor = next;
+      continue;
+    }
+
+    buffer[copied] = slot.Sample;
+
+    // If the stamp moved while we copied, a writer reused the slot under
+    // us and the copy may be torn; take the loop around again to account
+    // for the dropped tickets.
+    if (slot.Stamp.load(std::memory_order_acquire) != stamp)
+      continue;
+
+    ++copied;
+    ++cursor;
+  }
+
+  ReadCursor.store(cursor, std::memory_order_relaxed);
+  return copied;
+}
+
+uint64_t swift_allocationSamplerDropped(void) {
+  return DroppedSamples.load(std::memory_order_relaxed);
+}
+
+__attribute__((constructor))
+static void installAllocationSampler() {
+  const char *setting = getenv("SWIFT_RUNTIME_SAMPLE_ALLOCATIONS");
+  if (!setting || !*setting)
+    return;
+
+  long interval = atol(setting);
+  if (interval <= 0)
+    return;
+
+  // calloc rather than a static ring so that processes that never enable
+  // sampling don't pay for the storage.
+  Ring = reinterpret_cast<SampleSlot *>(calloc(RingSize, sizeof(SampleSlot)));
+  if (!Ring)
+    return;
+
+  SampleInterval = static_cast<uint32_t>(interval);
+  OrigAllocObject = _swift_allocObject;
+  _swift_allocObject = sampledAllocObject;
+}
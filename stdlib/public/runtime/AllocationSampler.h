@@ -0,0 +1,60 @@
+//===--- AllocationSampler.h ----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// The drain interface of the sampling allocation profiler.  See
+// AllocationSampler.cpp for how sampling is enabled and what it costs.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_STDLIB_RUNTIME_ALLOCATIONSAMPLER_H
+#define SWIFT_STDLIB_RUNTIME_ALLOCATIONSAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace swift {
+
+/// The number of return addresses kept per sample.  Bounding the depth
+/// keeps a sample small enough to copy cheaply; deeper frames are the
+/// least interesting for attribution anyway.
+enum { AllocationSampleMaxFrames = 8 };
+
+/// One sampled allocation.
+struct AllocationSample {
+  /// The metadata pointer of the allocated object.
+  const void *Metadata;
+
+  /// The requested size of the allocation in bytes.
+  size_t Size;
+
+  /// The number of valid entries in Frames.
+  uint32_t NumFrames;
+
+  /// Return addresses of the allocating call stack, innermost first.
+  uintptr_t Frames[AllocationSampleMaxFrames];
+};
+
+} // end namespace swift
+
+/// Copy up to \p capacity pending samples into \p buffer and make room
+/// for new ones; returns the number of samples copied.  Async-signal-safe:
+/// it takes no locks and allocates no memory, so a profiling agent may
+/// call it from a signal handler.  There must be at most one drainer at a
+/// time.
+extern "C" size_t swift_allocationSamplerDrain(swift::AllocationSample *buffer,
+                                               size_t capacity);
+
+/// Returns the number of samples lost so far because the ring buffer
+/// wrapped before they were drained.  Async-signal-safe.
+extern "C" uint64_t swift_allocationSamplerDropped(void);
+
+#endif
@@ -41,9 +41,11 @@
 #endif
 
 #include <dlfcn.h>
+#include <algorithm>
 #include <cstring>
 #include <mutex>
 #include <atomic>
+#include <vector>
 #include <type_traits>
 
 // FIXME: Clang defines max_align_t in stddef.h since 3.6.
@@ -2307,6 +2309,19 @@ static std::once_flag InstallProtocolConformanceAddImageCallbackOnce;
 namespace {
   struct ConformanceSection {
     const ProtocolConformanceRecord *Begin, *End;
+
+    /// The section's records ordered by protocol descriptor.  The records
+    /// themselves live in read-only mapped memory and cannot be sorted in
+    /// place, so this holds pointers into the section.  Built lazily under
+    /// SectionsToScanLock the first time the section is scanned; afterwards
+    /// a cache miss binary-searches this table instead of visiting every
+    /// record in the section.
+    std::vector<const ProtocolConformanceRecord *> ByProtocol;
+
+    ConformanceSection(const ProtocolConformanceRecord *begin,
+                       const ProtocolConformanceRecord *end)
+      : Begin(begin), End(end) {}
+
     const ProtocolConformanceRecord *begin() const {
       return Begin;
     }
@@ -2315,6 +2330,24 @@ namespace {
     }
   };
 
+  /// Orders conformance records by the address of their protocol
+  /// descriptor.  Usable both for sorting a section index and for
+  /// binary-searching it with a bare protocol descriptor as the key.
+  struct ConformanceRecordProtocolOrder {
+    bool operator()(const ProtocolConformanceRecord *lhs,
+                    const ProtocolConformanceRecord *rhs) const {
+      return lhs->getProtocol() < rhs->getProtocol();
+    }
+    bool operator()(const ProtocolConformanceRecord *record,
+                    const ProtocolDescriptor *protocol) const {
+      return record->getProtocol() < protocol;
+    }
+    bool operator()(const ProtocolDescriptor *protocol,
+                    const ProtocolConformanceRecord *record) const {
+      return protocol < record->getProtocol();
+    }
+  };
+
   struct ConformanceCacheEntry {
   private:
     const void *Type; 
@@ -2696,16 +2729,31 @@ recur:
 
   for (; sectionIdx < endSectionIdx; ++sectionIdx) {
     auto &section = C.SectionsToScan[sectionIdx];
+
+    // Build the protocol-sorted index for the section if this is the first
+    // time it is scanned.  This touches each record exactly once; every
+    // later scan of the section only visits the records for the protocol
+    // being queried.
+    if (section.ByProtocol.empty() && section.Begin != section.End) {
+      section.ByProtocol.reserve(section.End - section.Begin);
+      for (const auto &record : section)
+        section.ByProtocol.push_back(&record);
+      std::sort(section.ByProtocol.begin(), section.ByProtocol.end(),
+                ConformanceRecordProtocolOrder());
+    }
+
+    // Find the records for the protocol we are looking up.
+    auto range = std::equal_range(section.ByProtocol.begin(),
+                                  section.ByProtocol.end(), protocol,
+                                  ConformanceRecordProtocolOrder());
+
     // Eagerly pull records for nondependent witnesses into our cache.
-    for (const auto &record : section) {
+    for (auto recordIt = range.first; recordIt != range.second; ++recordIt) {
+      const auto &record = **recordIt;
       // If the record applies to a specific type, cache it.
       if (auto metadata = record.getCanonicalTypeMetadata()) {
         auto P = record.getProtocol();
 
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
         if (!isRelatedType(type, metadata))
           continue;
 
@@ -2735,10 +2783,6 @@ recur:
         auto R = record.getGenericPattern();
         auto P = record.getProtocol();
 
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
         if (!isRelatedType(type, R))
           continue;
 
@@ -2759,6 +2803,86 @@ recur:
   goto recur;
 }
 
+// Type-by-name lookup.
+
+namespace {
+  struct TypeByNameCacheEntry {
+    const char *Name;
+    size_t NameLength;
+    const Metadata *Type;
+
+    TypeByNameCacheEntry() = default;
+    TypeByNameCacheEntry(const char *name, size_t nameLength,
+                         const Metadata *type)
+      : Name(name), NameLength(nameLength), Type(type) {}
+
+    bool matches(const char *name, size_t nameLength) const {
+      return nameLength == NameLength && memcmp(name, Name, nameLength) == 0;
+    }
+  };
+}
+
+/// The cache of lookups performed by swift_getTypeByName.
+static Lazy<ConcurrentMap<size_t, TypeByNameCacheEntry>> TypeByNameCache;
+
+/// A simple hash function for a type name.
+static size_t hashTypeName(const char *name, size_t nameLength) {
+  // FNV-1a.
+  size_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i != nameLength; ++i) {
+    hash ^= (unsigned char)name[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/// Resolve a runtime type name to metadata, without consulting the cache.
+static const Metadata *_lookUpTypeByName(const char *name) {
+#if SWIFT_OBJC_INTEROP
+  // Swift classes register with the Objective-C runtime under their mangled
+  // names, so class lookups can be answered without walking any sections
+  // ourselves.
+  if (Class cls = objc_lookUpClass(name))
+    return swift_getObjCClassMetadata(
+                             reinterpret_cast<const ClassMetadata *>(cls));
+#else
+  (void)name;
+#endif
+  return nullptr;
+}
+
+/// Look up a class type by its runtime (mangled) name.
+const Metadata *
+swift::swift_getTypeByName(const char *name, size_t nameLength) {
+  auto &Cache = TypeByNameCache.get();
+
+  size_t hash = hashTypeName(name, nameLength);
+  ConcurrentList<TypeByNameCacheEntry> &Bucket =
+    Cache.findOrAllocateNode(hash);
+
+  for (auto &Entry : Bucket) {
+    if (Entry.matches(name, nameLength))
+      return Entry.Type;
+  }
+
+  // Make a null-terminated copy of the name for the lookup and, on success,
+  // for the cache entry.
+  char *terminatedName = (char *)malloc(nameLength + 1);
+  memcpy(terminatedName, name, nameLength);
+  terminatedName[nameLength] = 0;
+
+  const Metadata *type = _lookUpTypeByName(terminatedName);
+  if (!type) {
+    // Don't cache failures: the class could be registered later, e.g. by
+    // loading another image.
+    free(terminatedName);
+    return nullptr;
+  }
+
+  Bucket.push_front(TypeByNameCacheEntry(terminatedName, nameLength, type));
+  return type;
+}
+
 // The return type is incorrect.  It is only important that it is
 // passed using 'sret'.
 extern "C" OpaqueExistentialContainer
@@ -3012,7 +3136,7 @@ extern "C" const _ObjectiveCBridgeableWitnessTable
 _TWPVs19_BridgeableMetatypes21_ObjectiveCBridgeables;
 
 static const _ObjectiveCBridgeableWitnessTable *
-findBridgeWitness(const Metadata *T) {
+findBridgeWitnessImpl(const Metadata *T) {
   auto w = swift_conformsToProtocol(T, &_TMps21_ObjectiveCBridgeable);
   if (LLVM_LIKELY(w))
     return reinterpret_cast<const _ObjectiveCBridgeableWitnessTable *>(w);
@@ -3052,6 +3176,36 @@ findBridgeWitness(const Metadata *T) {
   return nullptr;
 }
 
+namespace {
+/// An entry in the cache of _ObjectiveCBridgeable conformances.
+struct BridgeWitnessCacheEntry {
+  const Metadata *Type;
+  const _ObjectiveCBridgeableWitnessTable *Witness;
+};
+}
+
+/// Cached bridging conformances, keyed by the native type being bridged.
+/// Bridging crossings are far hotter than arbitrary casts, so they get a
+/// dedicated table in front of the general conformance cache. Only successful
+/// lookups are cached: a failed lookup can start succeeding when a later
+/// dylib registers the conformance.
+static Lazy<ConcurrentMap<size_t, BridgeWitnessCacheEntry>> BridgeWitnessCache;
+
+static const _ObjectiveCBridgeableWitnessTable *
+findBridgeWitness(const Metadata *T) {
+  ConcurrentList<BridgeWitnessCacheEntry> &Bucket =
+    BridgeWitnessCache.get().findOrAllocateNode(reinterpret_cast<size_t>(T));
+  for (auto &Entry : Bucket) {
+    if (Entry.Type == T)
+      return Entry.Witness;
+  }
+
+  auto w = findBridgeWitnessImpl(T);
+  if (w)
+    Bucket.push_front({T, w});
+  return w;
+}
+
 /// \param value passed at +1, consumed.
 extern "C" HeapObject *swift_bridgeNonVerbatimToObjectiveC(
   OpaqueValue *value, const Metadata *T
@@ -3193,6 +3347,30 @@ extern "C" bool swift_isClassOrObjCExistential(const Metadata *value,
   return swift_isClassOrObjCExistentialImpl(T);
 }
 
+// func _arrayStoresOnlyElementsOfType<U>(
+//     elements: UnsafePointer<AnyObject>, _ count: Int, _: U.Type) -> Bool
+//
+// One-shot element type validation for array downcasts.  Arrays are
+// overwhelmingly homogeneous, so the verdict of the last successful check
+// is memoized on the class of the instance and the scan usually
+// degenerates to one pointer comparison per element.
+extern "C" bool swift_arrayStoresOnlyElementsOfType(
+  const void * const *elements, size_t count,
+  const Metadata *value, const Metadata *targetType
+) {
+  const ClassMetadata *lastMatchedClass = nullptr;
+  for (size_t i = 0; i != count; ++i) {
+    const void *object = elements[i];
+    auto *isa = _swift_getClass(object);
+    if (isa == lastMatchedClass)
+      continue;
+    if (!swift_dynamicCastUnknownClass(object, targetType))
+      return false;
+    lastMatchedClass = isa;
+  }
+  return true;
+}
+
 // func _swift_isClass(x: Any) -> Bool
 extern "C" bool _swift_isClass(OpaqueExistentialContainer *value) {
   bool Result = Metadata::isAnyKindOfClass(value->Type->getKind());
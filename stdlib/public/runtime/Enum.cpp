@@ -249,47 +249,6 @@ swift::swift_storeEnumTagSinglePayload(OpaqueValue *value,
   memcpy(extraTagBitAddr, &extraTagIndex, numExtraTagBytes);
 }
 
-void
-swift::swift_initEnumMetadataMultiPayload(ValueWitnessTable *vwtable,
-                                     EnumMetadata *enumType,
-                                     unsigned numPayloads,
-                                     const TypeLayout * const *payloadLayouts) {
-  // Accumulate the layout requirements of the payloads.
-  size_t payloadSize = 0, alignMask = 0;
-  bool isPOD = true, isBT = true;
-  for (unsigned i = 0; i < numPayloads; ++i) {
-    const TypeLayout *payloadLayout = payloadLayouts[i];
-    payloadSize
-      = std::max(payloadSize, (size_t)payloadLayout->size);
-    alignMask |= payloadLayout->flags.getAlignmentMask();
-    isPOD &= payloadLayout->flags.isPOD();
-    isBT &= payloadLayout->flags.isBitwiseTakable();
-  }
-  
-  // Store the max payload size in the metadata.
-  enumType->getPayloadSize() = payloadSize;
-  
-  // The total size includes space for the tag.
-  unsigned totalSize = payloadSize + getNumTagBytes(payloadSize,
-                                enumType->Description->Enum.getNumEmptyCases(),
-                                numPayloads);
-  
-  // Set up the layout info in the vwtable.
-  vwtable->size = totalSize;
-  vwtable->flags = ValueWitnessFlags()
-    .withAlignmentMask(alignMask)
-    .withPOD(isPOD)
-    .withBitwiseTakable(isBT)
-    // TODO: Extra inhabitants
-    .withExtraInhabitants(false)
-    .withEnumWitnesses(true)
-    .withInlineStorage(ValueWitnessTable::isValueInline(totalSize, alignMask+1))
-    ;
-  vwtable->stride = (totalSize + alignMask) & ~alignMask;
-  
-  installCommonValueWitnesses(vwtable);
-}
-
 namespace {
 struct MultiPayloadLayout {
   size_t payloadSize;
@@ -303,33 +262,35 @@ static MultiPayloadLayout getMultiPayloadLayout(const EnumMetadata *enumType) {
   return {payloadSize, totalSize - payloadSize};
 }
 
+template <unsigned numTagBytes>
 static void storeMultiPayloadTag(OpaqueValue *value,
                                  MultiPayloadLayout layout,
                                  unsigned tag) {
   auto tagBytes = reinterpret_cast<char *>(value) + layout.payloadSize;
-  small_memcpy(tagBytes, &tag, layout.numTagBytes);
+  small_memcpy<numTagBytes>(tagBytes, &tag);
 }
 
 static void storeMultiPayloadValue(OpaqueValue *value,
                                    MultiPayloadLayout layout,
                                    unsigned payloadValue) {
   auto bytes = reinterpret_cast<char *>(value);
-  
+
   memcpy(bytes, &payloadValue,
          std::min(layout.payloadSize, sizeof(payloadValue)));
-  
+
   // If the payload is larger than the value, zero out the rest.
   if (layout.payloadSize > sizeof(payloadValue))
     memset(bytes + sizeof(payloadValue), 0,
            layout.payloadSize - sizeof(payloadValue));
 }
 
+template <unsigned numTagBytes>
 static unsigned loadMultiPayloadTag(const OpaqueValue *value,
                                     MultiPayloadLayout layout) {
   auto tagBytes = reinterpret_cast<const char *>(value) + layout.payloadSize;
 
   unsigned tag = 0;
-  small_memcpy(&tag, tagBytes, layout.numTagBytes);
+  small_memcpy<numTagBytes>(&tag, tagBytes);
 
   return tag;
 }
@@ -343,15 +304,15 @@ static unsigned loadMultiPayloadValue(const OpaqueValue *value,
   return payloadValue;
 }
 
-void
-swift::swift_storeEnumTagMultiPayload(OpaqueValue *value,
-                                      const EnumMetadata *enumType,
-                                      unsigned whichCase) {
-  auto layout = getMultiPayloadLayout(enumType);
+template <unsigned numTagBytes>
+static void storeEnumTagMultiPayloadImpl(OpaqueValue *value,
+                                         const EnumMetadata *enumType,
+                                         MultiPayloadLayout layout,
+                                         unsigned whichCase) {
   unsigned numPayloads = enumType->Description->Enum.getNumPayloadCases();
   if (whichCase < numPayloads) {
     // For a payload case, store the tag after the payload area.
-    storeMultiPayloadTag(value, layout, whichCase);
+    storeMultiPayloadTag<numTagBytes>(value, layout, whichCase);
   } else {
     // For an empty case, factor out the parts that go in the payload and
     // tag areas.
@@ -365,25 +326,25 @@ swift::swift_storeEnumTagMultiPayload(OpaqueValue *value,
       whichTag = numPayloads + (whichEmptyCase >> numPayloadBits);
       whichPayloadValue = whichEmptyCase & ((1U << numPayloads) - 1U);
     }
-    storeMultiPayloadTag(value, layout, whichTag);
+    storeMultiPayloadTag<numTagBytes>(value, layout, whichTag);
     storeMultiPayloadValue(value, layout, whichPayloadValue);
   }
 }
 
-unsigned
-swift::swift_getEnumCaseMultiPayload(const OpaqueValue *value,
-                                     const EnumMetadata *enumType) {
-  auto layout = getMultiPayloadLayout(enumType);
+template <unsigned numTagBytes>
+static unsigned getEnumCaseMultiPayloadImpl(const OpaqueValue *value,
+                                            const EnumMetadata *enumType,
+                                            MultiPayloadLayout layout) {
   unsigned numPayloads = enumType->Description->Enum.getNumPayloadCases();
 
-  unsigned tag = loadMultiPayloadTag(value, layout);
+  unsigned tag = loadMultiPayloadTag<numTagBytes>(value, layout);
   if (tag < numPayloads) {
     // If the tag indicates a payload, then we're done.
     return tag;
   } else {
     // Otherwise, the other part of the discriminator is in the payload.
     unsigned payloadValue = loadMultiPayloadValue(value, layout);
-    
+
     if (layout.payloadSize >= 4) {
       return numPayloads + payloadValue;
     } else {
@@ -393,3 +354,126 @@ swift::swift_getEnumCaseMultiPayload(const OpaqueValue *value,
     }
   }
 }
+
+/// Specialized getEnumTag value witness for a dynamically-laid-out
+/// multi-payload enum with a known extra tag width. Installed at metadata
+/// instantiation time so that reading the tag through the value witness table
+/// is a fixed-width load rather than a byte-wise copy through an opaque
+/// entry point.
+template <unsigned numTagBytes>
+static unsigned multiPayload_getEnumTag(const OpaqueValue *value,
+                                        const Metadata *self) {
+  auto enumType = static_cast<const EnumMetadata *>(self);
+  return getEnumCaseMultiPayloadImpl<numTagBytes>(value, enumType,
+                                          getMultiPayloadLayout(enumType));
+}
+
+/// Specialized destructiveInjectEnumTag value witness, likewise instantiated
+/// per extra tag width.
+template <unsigned numTagBytes>
+static void multiPayload_destructiveInjectEnumTag(OpaqueValue *value,
+                                                  unsigned tag,
+                                                  const Metadata *self) {
+  auto enumType = static_cast<const EnumMetadata *>(self);
+  storeEnumTagMultiPayloadImpl<numTagBytes>(value, enumType,
+                                            getMultiPayloadLayout(enumType),
+                                            tag);
+}
+
+void
+swift::swift_initEnumMetadataMultiPayload(ValueWitnessTable *vwtable,
+                                     EnumMetadata *enumType,
+                                     unsigned numPayloads,
+                                     const TypeLayout * const *payloadLayouts) {
+  // Accumulate the layout requirements of the payloads.
+  size_t payloadSize = 0, alignMask = 0;
+  bool isPOD = true, isBT = true;
+  for (unsigned i = 0; i < numPayloads; ++i) {
+    const TypeLayout *payloadLayout = payloadLayouts[i];
+    payloadSize
+      = std::max(payloadSize, (size_t)payloadLayout->size);
+    alignMask |= payloadLayout->flags.getAlignmentMask();
+    isPOD &= payloadLayout->flags.isPOD();
+    isBT &= payloadLayout->flags.isBitwiseTakable();
+  }
+  
+  // Store the max payload size in the metadata.
+  enumType->getPayloadSize() = payloadSize;
+  
+  // The total size includes space for the tag.
+  unsigned totalSize = payloadSize + getNumTagBytes(payloadSize,
+                                enumType->Description->Enum.getNumEmptyCases(),
+                                numPayloads);
+  
+  // Set up the layout info in the vwtable.
+  vwtable->size = totalSize;
+  vwtable->flags = ValueWitnessFlags()
+    .withAlignmentMask(alignMask)
+    .withPOD(isPOD)
+    .withBitwiseTakable(isBT)
+    // TODO: Extra inhabitants
+    .withExtraInhabitants(false)
+    .withEnumWitnesses(true)
+    .withInlineStorage(ValueWitnessTable::isValueInline(totalSize, alignMask+1))
+    ;
+  vwtable->stride = (totalSize + alignMask) & ~alignMask;
+  
+  installCommonValueWitnesses(vwtable);
+
+  // Install enum tag witnesses specialized for the extra tag width we just
+  // chose, so that tag manipulation through the value witness table is a
+  // fixed-width load or store instead of a byte-wise copy.
+  auto enumVWT = static_cast<EnumValueWitnessTable *>(vwtable);
+  switch (totalSize - payloadSize) {
+  case 1:
+    enumVWT->getEnumTag = multiPayload_getEnumTag<1>;
+    enumVWT->destructiveInjectEnumTag
+      = multiPayload_destructiveInjectEnumTag<1>;
+    break;
+  case 2:
+    enumVWT->getEnumTag = multiPayload_getEnumTag<2>;
+    enumVWT->destructiveInjectEnumTag
+      = multiPayload_destructiveInjectEnumTag<2>;
+    break;
+  case 4:
+    enumVWT->getEnumTag = multiPayload_getEnumTag<4>;
+    enumVWT->destructiveInjectEnumTag
+      = multiPayload_destructiveInjectEnumTag<4>;
+    break;
+  default:
+    crash("Tagbyte values should be 1, 2 or 4.");
+  }
+}
+
+void
+swift::swift_storeEnumTagMultiPayload(OpaqueValue *value,
+                                      const EnumMetadata *enumType,
+                                      unsigned whichCase) {
+  auto layout = getMultiPayloadLayout(enumType);
+  switch (layout.numTagBytes) {
+  case 1:
+    return storeEnumTagMultiPayloadImpl<1>(value, enumType, layout, whichCase);
+  case 2:
+    return storeEnumTagMultiPayloadImpl<2>(value, enumType, layout, whichCase);
+  case 4:
+    return storeEnumTagMultiPayloadImpl<4>(value, enumType, layout, whichCase);
+  default:
+    crash("Tagbyte values should be 1, 2 or 4.");
+  }
+}
+
+unsigned
+swift::swift_getEnumCaseMultiPayload(const OpaqueValue *value,
+                                     const EnumMetadata *enumType) {
+  auto layout = getMultiPayloadLayout(enumType);
+  switch (layout.numTagBytes) {
+  case 1:
+    return getEnumCaseMultiPayloadImpl<1>(value, enumType, layout);
+  case 2:
+    return getEnumCaseMultiPayloadImpl<2>(value, enumType, layout);
+  case 4:
+    return getEnumCaseMultiPayloadImpl<4>(value, enumType, layout);
+  default:
+    crash("Tagbyte values should be 1, 2 or 4.");
+  }
+}
@@ -18,6 +18,8 @@
 //===----------------------------------------------------------------------===//
 
 #include <stdio.h>
+#include "swift/Basic/Lazy.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Debug.h"
 #include "ErrorObject.h"
 #include "Private.h"
@@ -62,11 +64,61 @@ static const FullMetadata<HeapMetadata> ErrorTypeMetadata{
   Metadata{MetadataKind::ErrorObject},
 };
 
+namespace {
+/// An entry in the cache of singleton boxes for empty error values.
+struct EmptyErrorCacheEntry {
+  const Metadata *Type;
+  SwiftError *Box;
+};
+}
+
+/// Singleton boxes for zero-size error values, keyed by type. An error with
+/// an empty payload carries no state beyond its type metadata, so one
+/// immortal box per type can serve every throw of that error.
+static Lazy<ConcurrentMap<size_t, EmptyErrorCacheEntry>> EmptyErrorCache;
+
+/// Return the shared box for a zero-size error value, creating it on the
+/// first throw of the type.
+static BoxPair::Return
+_allocEmptyErrorBox(const Metadata *type,
+                    const WitnessTable *errorConformance) {
+  auto &Cache = EmptyErrorCache.get();
+  ConcurrentList<EmptyErrorCacheEntry> &Bucket =
+    Cache.findOrAllocateNode(reinterpret_cast<size_t>(type));
+  for (auto &Entry : Bucket) {
+    if (Entry.Type == type) {
+      swift_retain(Entry.Box);
+      return BoxPair{Entry.Box, Entry.Box->getValue()};
+    }
+  }
+
+  // Allocate the box normally, then give the cache a permanent reference to
+  // it so that the release balancing the reference we hand out can never
+  // deallocate it. If we race with another thread, both boxes are recorded
+  // and both stay valid; later lookups simply stop at whichever entry they
+  // see first.
+  auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
+  auto allocated = swift_allocObject(&ErrorTypeMetadata,
+                                     sizeAndAlign.first, sizeAndAlign.second);
+  auto error = reinterpret_cast<SwiftError*>(allocated);
+  error->type = type;
+  error->errorConformance = errorConformance;
+  swift_retain(allocated);
+  Bucket.push_front({type, error});
+  return BoxPair{allocated, error->getValue()};
+}
+
 BoxPair::Return
 swift::swift_allocError(const swift::Metadata *type,
                         const swift::WitnessTable *errorConformance,
                         OpaqueValue *initialValue,
                         bool isTake) {
+  // Zero-size values carry no state beyond their type, so all throws of such
+  // an error can share one immortal box, making them allocation-free. There
+  // is no value to copy or take in either way.
+  if (type->getValueWitnesses()->getSize() == 0)
+    return _allocEmptyErrorBox(type, errorConformance);
+
   auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
   
   auto allocated = swift_allocObject(&ErrorTypeMetadata,
@@ -91,6 +143,11 @@ swift::swift_allocError(const swift::Metadata *type,
 
 void
 swift::swift_deallocError(SwiftError *error, const Metadata *type) {
+  // Empty-payload errors share an immortal box per type; the teardown
+  // matching the retain swift_allocError performed is a release.
+  if (type->getValueWitnesses()->getSize() == 0)
+    return swift_release(error);
+
   auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
   swift_deallocObject(error, sizeAndAlign.first, sizeAndAlign.second);
 }
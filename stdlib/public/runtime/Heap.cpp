@@ -18,17 +18,333 @@
 #include "swift/Runtime/Heap.h"
 #include "Private.h"
 #include "swift/Runtime/Debug.h"
+#include "llvm/Support/Compiler.h"
+#include <atomic>
+#include <mutex>
+#include <new>
 #include <stdlib.h>
+#include <sys/mman.h>
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
 
 using namespace swift;
 
+namespace {
+
+/// A simple magazine allocator for small allocations.
+///
+/// Most heap allocations made by Swift code are small: closure contexts,
+/// boxed values and small class instances. Routing all of them through
+/// malloc serializes every allocating thread on the malloc lock. Instead,
+/// small allocations are served from per-thread free lists, segregated by
+/// size class. A thread only touches shared state when it runs out of
+/// memory in a size class and has to refill from the global depot.
+///
+/// All size classes are multiples of the block alignment, so every block
+/// handed out is suitably aligned for a HeapObject.
+class MagazineAllocator {
+public:
+  /// The alignment of all small blocks: 2 * sizeof(void*), the same
+  /// guarantee malloc gives.
+  static const size_t blockAlignment = 2 * sizeof(void *);
+  static const size_t blockAlignMask = blockAlignment - 1;
+
+  /// The size-class granularity.
+  static const size_t sizeClassStep = blockAlignment;
+
+  /// The largest size served from the free lists. Larger allocations go
+  /// directly to malloc.
+  static const size_t maxSmallSize = 256;
+
+  static const size_t numSizeClasses = maxSmallSize / sizeClassStep;
+
+  /// The size of the memory chunks carved into small blocks.
+  static const size_t chunkSize = 64 * 1024;
+
+  /// A free block. The block's memory itself holds the link.
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  /// Returns true if a request can be served from the free lists.
+  static bool isSmallAllocation(size_t size, size_t alignMask) {
+    return size - 1 < maxSmallSize && alignMask <= blockAlignMask;
+  }
+
+  static size_t getSizeClass(size_t size) {
+    assert(size - 1 < maxSmallSize);
+    return (size - 1) / sizeClassStep;
+  }
+
+  /// Returns null if the request cannot be served; the caller falls back
+  /// to malloc, and the resulting block is routed back to free by address.
+  void *alloc(size_t size);
+  void dealloc(void *ptr);
+
+  ~MagazineAllocator();
+
+private:
+  /// The per-thread free lists, indexed by size class.
+  FreeBlock *freeLists[numSizeClasses] = { nullptr };
+
+  /// The unused part of the thread's current chunk for each size class.
+  /// Chunks are dedicated to a single size class so that the chunk header
+  /// describes every block carved from them.
+  char *chunkPos[numSizeClasses] = { nullptr };
+  char *chunkEnd[numSizeClasses] = { nullptr };
+
+  void pushFree(void *ptr, size_t sizeClass) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(ptr);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+  }
+
+  void *refill(size_t sizeClass);
+};
+
+/// The reserved address range all magazine chunks are carved from.
+///
+/// Keeping every chunk inside a single contiguous reservation makes two
+/// queries cheap and exact: deallocation routes a pointer with one range
+/// check instead of trusting the size it was handed, and the stdlib's
+/// malloc_size introspection (_swift_stdlib_malloc_size) can report the
+/// capacity of a block the system allocator has never seen. The
+/// reservation is uncommitted address space; pages materialize only as
+/// chunks are carved out and used.
+struct SmallRegion {
+  /// The size of the reservation. Zero disables the magazines entirely:
+  /// on 32-bit targets address space is too scarce to reserve a range
+  /// large enough that exhausting it could be treated as out-of-memory.
+  static const uint64_t regionSize =
+      sizeof(void *) == 8 ? (uint64_t(16) << 30) : 0;
+
+  /// Every chunk starts with one block-alignment's worth of header
+  /// recording the size of the blocks carved from it. Accesses are
+  /// relaxed: a block pointer only travels to another thread through some
+  /// synchronizing publication, which carries the header write with it.
+  struct ChunkHeader {
+    std::atomic<size_t> blockSize;
+  };
+  static_assert(sizeof(ChunkHeader) <= MagazineAllocator::blockAlignment,
+                "chunk header does not fit in front of the first block");
+
+  /// The chunk-aligned start of the reservation, or null if it has not
+  /// been created (or could not be).
+  static std::atomic<char *> Base;
+
+  /// The offset of the next chunk to hand out.
+  static std::atomic<size_t> NextOffset;
+
+  /// Set when reserving the region failed; the magazines stay disabled.
+  static std::atomic<bool> Failed;
+
+  static bool isDisabled() {
+    return Failed.load(std::memory_order_relaxed);
+  }
+
+  /// Returns true exactly for blocks handed out by the magazines.
+  static bool contains(const void *ptr) {
+    char *base = Base.load(std::memory_order_relaxed);
+    return base != nullptr &&
+           (uintptr_t)ptr - (uintptr_t)base < regionSize;
+  }
+
+  /// Returns the block size of a magazine block, from its chunk's header.
+  static size_t blockSizeOf(const void *ptr) {
+    auto *header = reinterpret_cast<ChunkHeader *>(
+        (uintptr_t)ptr & ~(uintptr_t)(MagazineAllocator::chunkSize - 1));
+    return header->blockSize.load(std::memory_order_relaxed);
+  }
+
+  /// Returns a fresh chunk, or null if the reservation failed or is
+  /// exhausted.
+  static char *reserveChunk();
+
+private:
+  static char *create();
+};
+
+std::atomic<char *> SmallRegion::Base{nullptr};
+std::atomic<size_t> SmallRegion::NextOffset{0};
+std::atomic<bool> SmallRegion::Failed{false};
+
+char *SmallRegion::create() {
+  if (regionSize == 0 || Failed.load(std::memory_order_relaxed))
+    return nullptr;
+
+  // Over-reserve by one chunk so the start can be rounded up to a chunk
+  // boundary; block-to-chunk-header mapping relies on that alignment.
+  size_t mapSize = (size_t)regionSize + MagazineAllocator::chunkSize;
+  void *reservation = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANON | MAP_NORESERVE, -1, 0);
+  if (reservation == MAP_FAILED) {
+    Failed.store(true, std::memory_order_relaxed);
+    return nullptr;
+  }
+  char *aligned = reinterpret_cast<char *>(
+      ((uintptr_t)reservation + MagazineAllocator::chunkSize - 1) &
+      ~(uintptr_t)(MagazineAllocator::chunkSize - 1));
+
+  char *expected = nullptr;
+  if (!Base.compare_exchange_strong(expected, aligned,
+                                    std::memory_order_release,
+                                    std::memory_order_acquire)) {
+    // Another thread created the region first.
+    munmap(reservation, mapSize);
+    return expected;
+  }
+  return aligned;
+}
+
+char *SmallRegion::reserveChunk() {
+  char *base = Base.load(std::memory_order_acquire);
+  if (LLVM_UNLIKELY(base == nullptr)) {
+    base = create();
+    if (base == nullptr)
+      return nullptr;
+  }
+  size_t offset = NextOffset.fetch_add(MagazineAllocator::chunkSize,
+                                       std::memory_order_relaxed);
+  if (LLVM_UNLIKELY(offset >= regionSize))
+    return nullptr;
+  return base + offset;
+}
+
+/// The global depot: free lists donated by exited threads.
+///
+/// Chunks are never given back because live objects may still point into
+/// them. Instead an exiting thread donates its free lists (and the tails
+/// of its current chunks) to the depot, where other threads pick them up
+/// when refilling.
+struct GlobalDepot {
+  std::mutex lock;
+  MagazineAllocator::FreeBlock *freeLists[MagazineAllocator::numSizeClasses]
+    = { nullptr };
+};
+
+static GlobalDepot &getGlobalDepot() {
+  static GlobalDepot TheDepot;
+  return TheDepot;
+}
+
+void *MagazineAllocator::alloc(size_t size) {
+  size_t sizeClass = getSizeClass(size);
+  FreeBlock *block = freeLists[sizeClass];
+  if (LLVM_LIKELY(block != nullptr)) {
+    freeLists[sizeClass] = block->next;
+    return block;
+  }
+  return refill(sizeClass);
+}
+
+void MagazineAllocator::dealloc(void *ptr) {
+  pushFree(ptr, getSizeClass(SmallRegion::blockSizeOf(ptr)));
+}
+
+void *MagazineAllocator::refill(size_t sizeClass) {
+  if (LLVM_UNLIKELY(SmallRegion::isDisabled()))
+    return nullptr;
+
+  size_t blockSize = (sizeClass + 1) * sizeClassStep;
+
+  // First try to adopt a free list from the depot.
+  GlobalDepot &depot = getGlobalDepot();
+  {
+    std::lock_guard<std::mutex> guard(depot.lock);
+    if (FreeBlock *block = depot.freeLists[sizeClass]) {
+      freeLists[sizeClass] = block->next;
+      depot.freeLists[sizeClass] = nullptr;
+      return block;
+    }
+  }
+
+  // Otherwise carve blocks out of the thread's chunk for this size class.
+  if ((size_t)(chunkEnd[sizeClass] - chunkPos[sizeClass]) < blockSize) {
+    // The tail of the old chunk, if any, is smaller than one block and is
+    // wasted; it cannot be donated to another size class because the
+    // chunk header describes all blocks in the chunk.
+    char *chunk = SmallRegion::reserveChunk();
+    if (LLVM_UNLIKELY(chunk == nullptr))
+      return nullptr;
+    auto *header = new (chunk) SmallRegion::ChunkHeader;
+    header->blockSize.store(blockSize, std::memory_order_relaxed);
+    chunkPos[sizeClass] = chunk + blockAlignment;
+    chunkEnd[sizeClass] = chunk + chunkSize;
+  }
+  void *block = chunkPos[sizeClass];
+  chunkPos[sizeClass] += blockSize;
+  return block;
+}
+
+MagazineAllocator::~MagazineAllocator() {
+  // The thread is exiting: donate all free memory to the depot. The chunks
+  // themselves cannot be returned because blocks allocated from them may
+  // outlive this thread.
+  for (size_t i = 0; i < numSizeClasses; ++i) {
+    size_t blockSize = (i + 1) * sizeClassStep;
+    while ((size_t)(chunkEnd[i] - chunkPos[i]) >= blockSize) {
+      chunkEnd[i] -= blockSize;
+      pushFree(chunkEnd[i], i);
+    }
+  }
+  GlobalDepot &depot = getGlobalDepot();
+  std::lock_guard<std::mutex> guard(depot.lock);
+  for (size_t i = 0; i < numSizeClasses; ++i) {
+    if (!freeLists[i])
+      continue;
+    FreeBlock *last = freeLists[i];
+    while (last->next)
+      last = last->next;
+    last->next = depot.freeLists[i];
+    depot.freeLists[i] = freeLists[i];
+    freeLists[i] = nullptr;
+  }
+}
+
+/// The per-thread magazines. The destructor donates the thread's free
+/// memory back to the depot when the thread exits.
+static thread_local MagazineAllocator ThreadMagazines;
+
+} // end anonymous namespace
+
+size_t swift::swift_magazineBlockSize(const void *ptr) {
+  if (LLVM_LIKELY(!SmallRegion::contains(ptr)))
+    return 0;
+  return SmallRegion::blockSizeOf(ptr);
+}
+
 void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
-  // FIXME: use posix_memalign if alignMask is larger than the system guarantee.
+  if (LLVM_LIKELY(MagazineAllocator::isSmallAllocation(size, alignMask))) {
+    if (void *p = ThreadMagazines.alloc(size))
+      return p;
+    // The magazines are disabled or out of address space; fall through.
+  }
+
+  // Over-aligned allocations (e.g. buffers of elements with a SIMD
+  // alignment attribute) cannot rely on malloc's guarantee.  The memory is
+  // still free()-able, so the deallocation path does not change.
+  if (LLVM_UNLIKELY(alignMask > MagazineAllocator::blockAlignMask)) {
+    void *p = nullptr;
+    if (posix_memalign(&p, alignMask + 1, size))
+      swift::crash("Could not allocate memory.");
+    return p;
+  }
+
   void *p = malloc(size);
   if (!p) swift::crash("Could not allocate memory.");
   return p;
 }
 
 void swift::swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask) {
+  // Magazine blocks are routed by address, not by the size the caller
+  // passes: some callers deallocate with the original request size and
+  // some with the capacity reported by malloc_size, but the chunk header
+  // always knows the exact size class of the block.
+  if (LLVM_LIKELY(SmallRegion::contains(ptr))) {
+    ThreadMagazines.dealloc(ptr);
+    return;
+  }
   free(ptr);
 }
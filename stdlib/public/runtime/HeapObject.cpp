@@ -20,15 +20,18 @@
 #include "swift/Runtime/Heap.h"
 #include "swift/Runtime/Metadata.h"
 #include "swift/ABI/System.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/MathExtras.h"
 #include "MetadataCache.h"
 #include "Private.h"
 #include "swift/Runtime/Debug.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
+#include <pthread.h>
 #include <unistd.h>
 #include "../SwiftShims/RuntimeShims.h"
 #if SWIFT_OBJC_INTEROP
@@ -91,7 +94,8 @@ swift::swift_verifyEndOfLifetime(HeapObject *object) {
   if (object->refCount.getCount() != 0)
     swift::fatalError("fatal error: stack object escaped\n");
 
-  if (object->weakRefCount.getCount() != 1)
+  if (object->weakRefCount.getCount() != 1 ||
+      object->weakRefCount.hasSideTableEntry())
     swift::fatalError("fatal error: weak/unowned reference to stack object\n");
 }
 
@@ -336,6 +340,13 @@ static void _swift_retain_n_(HeapObject *object, uint32_t n) {
 }
 auto swift::_swift_retain_n = _swift_retain_n_;
 
+void swift::swift_nonatomic_retain(HeapObject *object) {
+  SWIFT_RETAIN();
+  if (object) {
+    object->refCount.incrementNonAtomic();
+  }
+}
+
 void swift::swift_release(HeapObject *object) {
   SWIFT_RELEASE();
   return _swift_release(object);
@@ -358,6 +369,13 @@ static void _swift_release_n_(HeapObject *object, uint32_t n) {
 }
 auto swift::_swift_release_n = _swift_release_n_;
 
+void swift::swift_nonatomic_release(HeapObject *object) {
+  SWIFT_RELEASE();
+  if (object && object->refCount.decrementShouldDeallocateNonAtomic()) {
+    _swift_release_dealloc(object);
+  }
+}
+
 size_t swift::swift_retainCount(HeapObject *object) {
   return object->refCount.getCount();
 }
@@ -544,6 +562,83 @@ static inline void memset_pattern8(void *b, const void *pattern8, size_t len) {
 }
 #endif
 
+namespace {
+
+/// A side-table entry tracking the native weak references to one object.
+///
+/// The entry is shared by the object and every WeakReference pointing at it;
+/// RefCount counts those owners, and the entry is freed when the last of
+/// them lets go.  Object is the referent; swift_deallocObject clears it
+/// under Lock before the referent's memory is freed, so a weak load holding
+/// Lock sees either null or an object whose memory is still valid.
+struct WeakSideTableEntry {
+  std::atomic<HeapObject *> Object;
+  std::atomic<uint32_t> RefCount;
+  std::atomic_flag Lock;
+
+  explicit WeakSideTableEntry(HeapObject *object)
+      : Object(object), RefCount(1) {
+    Lock.clear(std::memory_order_relaxed);
+  }
+
+  void lock() {
+    while (Lock.test_and_set(std::memory_order_acquire)) {
+      // Spin until the lock is released.  The critical sections are a
+      // handful of instructions, so contention is extremely short-lived.
+    }
+  }
+
+  void unlock() {
+    Lock.clear(std::memory_order_release);
+  }
+};
+
+} // end anonymous namespace
+
+/// Guards WeakSideTable.
+static pthread_mutex_t WeakSideTableLock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Maps live objects to their weak reference side-table entries.  An object
+/// is in the table only while it is alive and has an entry;
+/// swift_deallocObject removes it.
+static Lazy<llvm::DenseMap<HeapObject *, WeakSideTableEntry *>> WeakSideTable;
+
+/// Return the object's side-table entry, creating it if necessary, with its
+/// reference count already incremented on behalf of a new WeakReference.
+static WeakSideTableEntry *getOrCreateWeakSideTableEntry(HeapObject *object) {
+  auto &table = WeakSideTable.get();
+  pthread_mutex_lock(&WeakSideTableLock);
+  auto &entry = table[object];
+  if (!entry) {
+    entry = new WeakSideTableEntry(object);
+    object->weakRefCount.setHasSideTableEntry();
+  }
+  entry->RefCount.fetch_add(1, std::memory_order_relaxed);
+  pthread_mutex_unlock(&WeakSideTableLock);
+  return entry;
+}
+
+/// Drop one reference to a side-table entry, freeing the entry when the
+/// last reference to it goes away.
+static void releaseWeakSideTableEntry(WeakSideTableEntry *entry) {
+  if (entry->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    delete entry;
+}
+
+/// Decode the side-table entry stored in a WeakReference, or return null
+/// for an empty reference.
+static WeakSideTableEntry *getWeakEntry(WeakReference *ref) {
+  return reinterpret_cast<WeakSideTableEntry *>(
+      reinterpret_cast<uintptr_t>(ref->Value) & ~NativeWeakReferenceFlag);
+}
+
+/// Store a side-table entry in a WeakReference, tagged so that the unknown
+/// weak entry points can tell it apart from an Objective-C object.
+static void setWeakEntry(WeakReference *ref, WeakSideTableEntry *entry) {
+  ref->Value = reinterpret_cast<HeapObject *>(
+      reinterpret_cast<uintptr_t>(entry) | NativeWeakReferenceFlag);
+}
+
 void swift::swift_deallocObject(HeapObject *object, size_t allocatedSize,
                                 size_t allocatedAlignMask) {
   SWIFT_DEALLOCATEOBJECT();
@@ -558,6 +653,26 @@ void swift::swift_deallocObject(HeapObject *object, size_t allocatedSize,
   // If we are tracking leaks, stop tracking this object.
   SWIFT_LEAKS_STOP_TRACKING_OBJECT(object);
 
+  // If weak references were formed to the object, detach its side-table
+  // entry: clear the entry's object pointer under the entry lock so that no
+  // weak load can observe the object after its memory is freed, then drop
+  // the object's own reference to the entry.  Outstanding WeakReferences
+  // keep only the small entry alive, not the object's allocation.
+  if (object->weakRefCount.hasSideTableEntry()) {
+    auto &table = WeakSideTable.get();
+    pthread_mutex_lock(&WeakSideTableLock);
+    auto it = table.find(object);
+    assert(it != table.end() && "side-table flag set without an entry");
+    WeakSideTableEntry *entry = it->second;
+    table.erase(it);
+    pthread_mutex_unlock(&WeakSideTableLock);
+
+    entry->lock();
+    entry->Object.store(nullptr, std::memory_order_relaxed);
+    entry->unlock();
+    releaseWeakSideTableEntry(entry);
+  }
+
   // Drop the initial weak retain of the object.
   //
   // If the outstanding weak retain count is 1 (i.e. only the initial
@@ -636,26 +751,40 @@ extern "C" void swift_fixLifetime(OpaqueValue *value) {
 }
 
 void swift::swift_weakInit(WeakReference *ref, HeapObject *value) {
-  ref->Value = value;
-  swift_unownedRetain(value);
+  if (value == nullptr) {
+    ref->Value = nullptr;
+    return;
+  }
+  setWeakEntry(ref, getOrCreateWeakSideTableEntry(value));
 }
 
 void swift::swift_weakAssign(WeakReference *ref, HeapObject *newValue) {
-  swift_unownedRetain(newValue);
-  auto oldValue = ref->Value;
-  ref->Value = newValue;
-  swift_unownedRelease(oldValue);
+  auto oldEntry = getWeakEntry(ref);
+  swift_weakInit(ref, newValue);
+  if (oldEntry)
+    releaseWeakSideTableEntry(oldEntry);
 }
 
 HeapObject *swift::swift_weakLoadStrong(WeakReference *ref) {
-  auto object = ref->Value;
-  if (object == nullptr) return nullptr;
-  if (object->refCount.isDeallocating()) {
-    swift_unownedRelease(object);
+  auto entry = getWeakEntry(ref);
+  if (entry == nullptr) return nullptr;
+
+  // Holding the entry lock keeps swift_deallocObject from freeing the
+  // object between our load and the try-retain, so either we see null or
+  // the object's memory is still valid and swift_tryRetain can safely
+  // inspect its reference count.
+  entry->lock();
+  auto object = entry->Object.load(std::memory_order_relaxed);
+  auto result = object ? swift_tryRetain(object) : nullptr;
+  entry->unlock();
+
+  // If the object is gone, break our reference to the entry eagerly
+  // rather than waiting for the weak reference to be destroyed.
+  if (object == nullptr) {
     ref->Value = nullptr;
-    return nullptr;
+    releaseWeakSideTableEntry(entry);
   }
-  return swift_tryRetain(object);
+  return result;
 }
 
 HeapObject *swift::swift_weakTakeStrong(WeakReference *ref) {
@@ -665,44 +794,47 @@ HeapObject *swift::swift_weakTakeStrong(WeakReference *ref) {
 }
 
 void swift::swift_weakDestroy(WeakReference *ref) {
-  auto tmp = ref->Value;
+  auto entry = getWeakEntry(ref);
   ref->Value = nullptr;
-  swift_unownedRelease(tmp);
+  if (entry)
+    releaseWeakSideTableEntry(entry);
 }
 
 void swift::swift_weakCopyInit(WeakReference *dest, WeakReference *src) {
-  auto object = src->Value;
-  if (object == nullptr) {
+  auto entry = getWeakEntry(src);
+  if (entry == nullptr) {
     dest->Value = nullptr;
-  } else if (object->refCount.isDeallocating()) {
+  } else if (entry->Object.load(std::memory_order_relaxed) == nullptr) {
     src->Value = nullptr;
     dest->Value = nullptr;
-    swift_unownedRelease(object);
+    releaseWeakSideTableEntry(entry);
   } else {
-    dest->Value = object;
-    swift_unownedRetain(object);
+    entry->RefCount.fetch_add(1, std::memory_order_relaxed);
+    setWeakEntry(dest, entry);
   }
 }
 
 void swift::swift_weakTakeInit(WeakReference *dest, WeakReference *src) {
-  auto object = src->Value;
-  dest->Value = object;
-  if (object != nullptr && object->refCount.isDeallocating()) {
+  dest->Value = src->Value;
+  src->Value = nullptr;
+  auto entry = getWeakEntry(dest);
+  if (entry != nullptr &&
+      entry->Object.load(std::memory_order_relaxed) == nullptr) {
     dest->Value = nullptr;
-    swift_unownedRelease(object);
+    releaseWeakSideTableEntry(entry);
   }
 }
 
 void swift::swift_weakCopyAssign(WeakReference *dest, WeakReference *src) {
-  if (auto object = dest->Value) {
-    swift_unownedRelease(object);
+  if (auto entry = getWeakEntry(dest)) {
+    releaseWeakSideTableEntry(entry);
   }
   swift_weakCopyInit(dest, src);
 }
 
 void swift::swift_weakTakeAssign(WeakReference *dest, WeakReference *src) {
-  if (auto object = dest->Value) {
-    swift_unownedRelease(object);
+  if (auto entry = getWeakEntry(dest)) {
+    releaseWeakSideTableEntry(entry);
   }
   swift_weakTakeInit(dest, src);
 }
@@ -24,9 +24,13 @@
 #include "swift/Strings.h"
 #include "MetadataCache.h"
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <new>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sys/mman.h>
 #include <pthread.h>
 #include <unistd.h>
@@ -71,23 +75,35 @@ void *MetadataAllocator::alloc(size_t size) {
     return mem;
   }
   
-  char *end = next + size;
-  
-  // Allocate a new page if we need one.
-  if (LLVM_UNLIKELY(((uintptr_t)next & ~pagesizeMask)
-                      != (((uintptr_t)end & ~pagesizeMask)))){
-    next = (char*)
-      mmap(nullptr, pagesizeMask+1, PROT_READ|PROT_WRITE,
-           MAP_ANON|MAP_PRIVATE, VM_TAG_FOR_SWIFT_METADATA, 0);
-
-    if (next == MAP_FAILED)
-      crash("unable to allocate memory for metadata cache");
-    end = next + size;
+  // Advance the bump pointer with a compare-and-swap, so that concurrent
+  // allocations don't need to take a lock.
+  char *curr = next.load(std::memory_order_relaxed);
+  while (true) {
+    char *end = curr + size;
+
+    // Allocate a new page if we need one.
+    if (LLVM_UNLIKELY(((uintptr_t)curr & ~pagesizeMask)
+                        != (((uintptr_t)end & ~pagesizeMask)))){
+      char *page = (char*)
+        mmap(nullptr, pagesizeMask+1, PROT_READ|PROT_WRITE,
+             MAP_ANON|MAP_PRIVATE, VM_TAG_FOR_SWIFT_METADATA, 0);
+
+      if (page == MAP_FAILED)
+        crash("unable to allocate memory for metadata cache");
+
+      if (next.compare_exchange_weak(curr, page + size,
+                                     std::memory_order_relaxed))
+        return page;
+
+      // Another thread installed a page first; return ours and retry with
+      // the updated bump pointer.
+      munmap(page, pagesizeMask+1);
+      continue;
+    }
+
+    if (next.compare_exchange_weak(curr, end, std::memory_order_relaxed))
+      return curr;
   }
-  
-  char *addr = next;
-  next = end;
-  return addr;
 }
 
 namespace {
@@ -228,6 +244,59 @@ swift::swift_allocateGenericValueMetadata(GenericMetadata *pattern,
   return metadata;
 }
 
+/// Where the opt-in instantiation profile is written, or null when profiling
+/// is disabled. See installMetadataInstantiationProfiler below.
+static FILE *MetadataProfileLog = nullptr;
+
+/// Enable metadata instantiation profiling if it was requested through the
+/// environment. Each cache-miss instantiation is logged with the time it
+/// took, so first-use stalls can be traced back to the generic types that
+/// caused them and hot signatures can be warmed up early by the app itself.
+///
+/// Set SWIFT_RUNTIME_PROFILE_METADATA to enable it. A value of "1" sends the
+/// log to stderr; any other value is treated as a file to write it to.
+__attribute__((constructor))
+static void installMetadataInstantiationProfiler() {
+  const char *setting = getenv("SWIFT_RUNTIME_PROFILE_METADATA");
+  if (!setting || !*setting)
+    return;
+
+  if (strcmp(setting, "1") == 0) {
+    MetadataProfileLog = stderr;
+    return;
+  }
+
+  MetadataProfileLog = fopen(setting, "w");
+  if (!MetadataProfileLog) {
+    fprintf(stderr,
+            "swift runtime: could not open '%s' for the metadata "
+            "instantiation profile; writing it to stderr\n", setting);
+    MetadataProfileLog = stderr;
+  }
+}
+
+/// Instantiate metadata from a pattern on the cache miss path, timing and
+/// logging the instantiation when profiling is enabled.
+static Metadata *createGenericMetadata(GenericMetadata *pattern,
+                                       const void *arguments) {
+  if (!MetadataProfileLog)
+    return pattern->CreateFunction(pattern, arguments);
+
+  auto start = std::chrono::steady_clock::now();
+  auto metadata = pattern->CreateFunction(pattern, arguments);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // The name is demangled outside of the timed region; it is only needed
+  // for the report.
+  std::string name = nameForMetadata(metadata, /*qualified=*/true);
+  fprintf(MetadataProfileLog, "swift metadata instantiation: %8llu ns  %s\n",
+          (unsigned long long)
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count(),
+          name.c_str());
+  return metadata;
+}
+
 /// Entrypoint for non-generic types with resilient layout.
 const Metadata *
 swift::swift_getResilientMetadata(GenericMetadata *pattern) {
@@ -236,7 +305,7 @@ swift::swift_getResilientMetadata(GenericMetadata *pattern) {
   auto entry = getCache(pattern).findOrAdd(nullptr, 0,
     [&]() -> GenericCacheEntry* {
       // Create new metadata to cache.
-      auto metadata = pattern->CreateFunction(pattern, nullptr);
+      auto metadata = createGenericMetadata(pattern, nullptr);
       auto entry = GenericCacheEntry::getFromMetadata(pattern, metadata);
       entry->Value = metadata;
       return entry;
@@ -255,7 +324,7 @@ swift::swift_getGenericMetadata(GenericMetadata *pattern,
   auto entry = getCache(pattern).findOrAdd(genericArgs, numGenericArgs,
     [&]() -> GenericCacheEntry* {
       // Create new metadata to cache.
-      auto metadata = pattern->CreateFunction(pattern, arguments);
+      auto metadata = createGenericMetadata(pattern, arguments);
       auto entry = GenericCacheEntry::getFromMetadata(pattern, metadata);
       entry->Value = metadata;
       return entry;
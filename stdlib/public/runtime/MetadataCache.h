@@ -155,28 +155,32 @@ template <class Entry> class MetadataCache {
   /// This map hash codes of entry refs to a list of entry pairs.
   MDMapTy *Map;
 
-  /// Synchronization of metadata creation.
-  std::mutex *Lock;
-  
+  /// The number of independently locked shards for metadata creation.
+  /// Entries with the same hash code always hit the same shard, so two
+  /// threads which instantiate the same metadata are still serialized,
+  /// but unrelated instantiations can proceed concurrently.
+  static const size_t NumLockShards = 16;
+
+  /// Synchronization of metadata creation, sharded by hash code.
+  std::mutex *Locks;
+
   /// The head of a linked list connecting all the metadata cache entries.
   /// TODO: Remove this when LLDB is able to understand the final data
   /// structure for the metadata cache.
-  const Entry *Head;
+  std::atomic<const Entry *> Head;
 
   /// Allocator for entries of this cache.
   MetadataAllocator Allocator;
-  
+
 public:
-  MetadataCache() : Map(new MDMapTy()), Lock(new std::mutex()) {}
-  ~MetadataCache() { delete Map; delete Lock; }
+  MetadataCache() : Map(new MDMapTy()), Locks(new std::mutex[NumLockShards]) {}
+  ~MetadataCache() { delete Map; delete[] Locks; }
 
   /// Caches are not copyable.
   MetadataCache(const MetadataCache &other) = delete;
   MetadataCache &operator=(const MetadataCache &other) = delete;
 
   /// Get the allocator for metadata in this cache.
-  /// The allocator can only be safely used while the cache is locked during
-  /// an addMetadataEntry call.
   MetadataAllocator &getAllocator() { return Allocator; }
 
   /// Call entryBuilder() and add the generated metadata to the cache.
@@ -186,11 +190,14 @@ public:
   /// and marking it as such generates better code that is easier to analyze
   /// and profile.
   __attribute__ ((noinline))
-  const Entry *addMetadataEntry(EntryRef<Entry> key,
+  const Entry *addMetadataEntry(EntryRef<Entry> key, size_t hash,
                                 ConcurrentList<EntryPair> &Bucket,
                                 llvm::function_ref<Entry *()> entryBuilder) {
-    // Hold a lock to prevent the modification of the cache by multiple threads.
-    std::unique_lock<std::mutex> ConstructionGuard(*Lock);
+    // Hold the lock of the shard that owns this hash code. All insertions
+    // into this bucket go through the same shard, so the re-scan below is
+    // sufficient to detect a racing construction of the same entry, while
+    // entries in other shards can be constructed concurrently.
+    std::unique_lock<std::mutex> ConstructionGuard(Locks[hash % NumLockShards]);
 
     // Some other thread may have setup the value we are about to construct
     // while we were asleep so do a search before constructing a new value.
@@ -202,14 +209,18 @@ public:
     // For some cache types this call may re-entrantly perform additional
     // cache lookups.
     // Notice that the entry is completely constructed before it is inserted
-    // into the map, and that only one entry can be constructed at once
-    // because of the lock above.
+    // into the map, and that two entries with the same key can't be
+    // constructed at once because of the shard lock above.
     Entry *entry = entryBuilder();
     assert(entry);
 
-    // Update the linked list.
-    entry->Next = Head;
-    Head = entry;
+    // Update the linked list. Entries in other shards may be linked
+    // concurrently, so push with a compare-and-swap.
+    entry->Next = Head.load(std::memory_order_relaxed);
+    while (!Head.compare_exchange_weak(entry->Next, entry,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
 
     key = EntryRef<Entry>::forEntry(entry, entry->getNumArguments());
     Bucket.push_front(EntryPair(key, entry));
@@ -251,7 +262,7 @@ public:
     }
 
     // We did not find a key so we will need to create one and store it.
-    return addMetadataEntry(key, Bucket, entryBuilder);
+    return addMetadataEntry(key, hash, Bucket, entryBuilder);
   }
 };
 
@@ -27,6 +27,11 @@ using namespace swift;
 #include <dispatch/dispatch.h>
 static_assert(std::is_same<swift_once_t, dispatch_once_t>::value,
               "swift_once_t and dispatch_once_t must stay in sync");
+#else
+
+#include <atomic>
+#include <thread>
+
 #endif
 // The compiler generates the swift_once_t values as word-sized zero-initialized
 // variables, so we want to make sure swift_once_t isn't larger than the
@@ -41,12 +46,23 @@ void swift::swift_once(swift_once_t *predicate, void (*fn)(void *)) {
 #if defined(__APPLE__)
   dispatch_once_f(predicate, nullptr, fn);
 #else
-  // FIXME: We're relying here on the coincidence that libstdc++ uses pthread's
-  // pthread_once, and that on glibc pthread_once follows a compatible init
-  // process (the token is a word that is atomically incremented from 0 to
-  // 1 to 2 during initialization) to work. We should implement our own version
-  // that we can rely on to continue to work that way.
-  // For more information, see rdar://problem/18499385
-  std::call_once(*predicate, [fn]() { fn(nullptr); });
+  // The predicate is zero before initialization, 1 while some thread is
+  // running the initializer, and -1 once initialization is complete. The -1
+  // "done" value is ABI: IRGen emits an inline check against it ahead of the
+  // call into the runtime (see SwiftTargetInfo::OnceDonePredicateValue), so
+  // the already-initialized case normally never gets here.
+  auto *flag = reinterpret_cast<std::atomic<swift_once_t> *>(predicate);
+
+  swift_once_t expected = 0;
+  if (flag->compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+    fn(nullptr);
+    flag->store(swift_once_t(-1), std::memory_order_release);
+    return;
+  }
+
+  // Another thread claimed the initializer; wait for it to publish the
+  // initialized state.
+  while (flag->load(std::memory_order_acquire) != swift_once_t(-1))
+    std::this_thread::yield();
 #endif
 }
@@ -80,6 +80,24 @@ namespace swift {
     return object == nullptr || isObjCTaggedPointer(object);
   }
 
+  /// Bit set in a WeakReference's stored value when it holds a pointer to a
+  /// native weak reference side-table entry rather than an object. Bit 0 is
+  /// unavailable because Objective-C tagged pointers use it on x86-64; the
+  /// side-table entries are malloc'd, so bit 1 is always clear in the real
+  /// pointer.
+  static const uintptr_t NativeWeakReferenceFlag = 2;
+
+  /// Does the given WeakReference value hold a pointer to a native weak
+  /// reference side-table entry?  Bit 1 alone is not a sufficient test: in
+  /// an Objective-C tagged pointer it is payload, not a reserved bit, so a
+  /// value classifies as a side-table entry only if no tagged-pointer
+  /// reserved bit is set as well.
+  static inline bool isNativeWeakReferenceValue(const void *value) {
+    return (((uintptr_t)value) &
+            (heap_object_abi::ObjCReservedBitsMask | NativeWeakReferenceFlag))
+           == NativeWeakReferenceFlag;
+  }
+
   LLVM_LIBRARY_VISIBILITY
   const ClassMetadata *_swift_getClass(const void *object);
 
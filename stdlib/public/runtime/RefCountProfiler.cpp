@@ -0,0 +1,220 @@
+//===--- RefCountProfiler.cpp - Per-type reference counting profile -------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// An opt-in profiler that counts allocations, retains and releases per
+// metadata pointer, and dumps a report sorted by traffic at process exit.
+// It is installed through the same function-pointer hooks that
+// Instruments.app uses (see InstrumentsSupport.h), so the hot paths pay
+// nothing when it is disabled.
+//
+// Enable it by setting SWIFT_RUNTIME_PROFILE_REFCOUNTS in the environment.
+// A value of "1" sends the report to stderr; any other value is treated as
+// a file to write the report to.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/InstrumentsSupport.h"
+#include "swift/Runtime/Metadata.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace swift;
+
+namespace {
+
+/// One row of the profile: the counters for a single metadata pointer.
+struct TypeCounters {
+  std::atomic<uintptr_t> Metadata;
+  std::atomic<uint64_t> Allocations;
+  std::atomic<uint64_t> Retains;
+  std::atomic<uint64_t> Releases;
+};
+
+} // end anonymous namespace
+
+/// The table is sharded to spread insertion contention; each shard is a
+/// fixed-size open-addressing hash table whose slots are claimed with a
+/// single compare-and-swap, so recording never takes a lock.
+static const size_t ShardCount = 16;
+static const size_t SlotsPerShard = 4096;
+
+static TypeCounters *ProfileTable = nullptr;
+
+/// Counts traffic for metadata pointers that didn't fit in their shard.
+static std::atomic<uint64_t> OverflowEvents;
+
+/// The hooks that were installed before ours; the profiled entry points
+/// delegate to these so that the profiler composes with other tools.
+static HeapObject *(*OrigAllocObject)(HeapMetadata const *metadata,
+                                      size_t requiredSize,
+                                      size_t requiredAlignmentMask);
+static void (*OrigRetain)(HeapObject *object);
+static void (*OrigRetainN)(HeapObject *object, uint32_t n);
+static void (*OrigRelease)(HeapObject *object);
+static void (*OrigReleaseN)(HeapObject *object, uint32_t n);
+
+static TypeCounters *lookupCounters(const void *metadata) {
+  uintptr_t key = reinterpret_cast<uintptr_t>(metadata);
+
+  // Metadata pointers are aligned, so drop the always-zero low bits before
+  // mixing. The Knuth multiplicative constant works on 32-bit targets too.
+  uintptr_t hash = (key >> 4) * 2654435761u;
+  size_t shard = hash % ShardCount;
+  size_t start = (hash / ShardCount) % SlotsPerShard;
+
+  TypeCounters *slots = &ProfileTable[shard * SlotsPerShard];
+  for (size_t i = 0; i != SlotsPerShard; ++i) {
+    TypeCounters &slot = slots[(start + i) % SlotsPerShard];
+    uintptr_t existing = slot.Metadata.load(std::memory_order_acquire);
+    if (existing == key)
+      return &slot;
+    if (existing == 0) {
+      uintptr_t expected = 0;
+      if (slot.Metadata.compare_exchange_strong(expected, key,
+                                                std::memory_order_acq_rel))
+        return &slot;
+      if (expected == key)
+        return &slot;
+      // Another thread claimed this slot for a different type; keep probing.
+    }
+  }
+
+  // The shard is full; don't lose the event entirely.
+  OverflowEvents.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+static HeapObject *profiledAllocObject(HeapMetadata const *metadata,
+                                       size_t requiredSize,
+                                       size_t requiredAlignmentMask) {
+  if (auto *counters = lookupCounters(metadata))
+    counters->Allocations.fetch_add(1, std::memory_order_relaxed);
+  return OrigAllocObject(metadata, requiredSize, requiredAlignmentMask);
+}
+
+static void profiledRetain(HeapObject *object) {
+  if (object)
+    if (auto *counters = lookupCounters(object->metadata))
+      counters->Retains.fetch_add(1, std::memory_order_relaxed);
+  OrigRetain(object);
+}
+
+static void profiledRetainN(HeapObject *object, uint32_t n) {
+  if (object)
+    if (auto *counters = lookupCounters(object->metadata))
+      counters->Retains.fetch_add(n, std::memory_order_relaxed);
+  OrigRetainN(object, n);
+}
+
+static void profiledRelease(HeapObject *object) {
+  if (object)
+    if (auto *counters = lookupCounters(object->metadata))
+      counters->Releases.fetch_add(1, std::memory_order_relaxed);
+  OrigRelease(object);
+}
+
+static void profiledReleaseN(HeapObject *object, uint32_t n) {
+  if (object)
+    if (auto *counters = lookupCounters(object->metadata))
+      counters->Releases.fetch_add(n, std::memory_order_relaxed);
+  OrigReleaseN(object, n);
+}
+
+static void reportRefCountProfile() {
+  // Uninstall the hooks so the report itself isn't counted.
+  _swift_allocObject = OrigAllocObject;
+  _swift_retain = OrigRetain;
+  _swift_retain_n = OrigRetainN;
+  _swift_release = OrigRelease;
+  _swift_release_n = OrigReleaseN;
+
+  std::vector<const TypeCounters *> rows;
+  for (size_t i = 0, e = ShardCount * SlotsPerShard; i != e; ++i) {
+    if (ProfileTable[i].Metadata.load(std::memory_order_relaxed))
+      rows.push_back(&ProfileTable[i]);
+  }
+  std::sort(rows.begin(), rows.end(),
+            [](const TypeCounters *a, const TypeCounters *b) {
+    uint64_t aTraffic = a->Retains.load(std::memory_order_relaxed) +
+                        a->Releases.load(std::memory_order_relaxed);
+    uint64_t bTraffic = b->Retains.load(std::memory_order_relaxed) +
+                        b->Releases.load(std::memory_order_relaxed);
+    return aTraffic > bTraffic;
+  });
+
+  FILE *out = stderr;
+  const char *setting = getenv("SWIFT_RUNTIME_PROFILE_REFCOUNTS");
+  if (setting && strcmp(setting, "1") != 0) {
+    out = fopen(setting, "w");
+    if (!out) {
+      fprintf(stderr,
+              "swift runtime: could not open '%s' for the reference "
+              "counting profile; writing it to stderr\n", setting);
+      out = stderr;
+    }
+  }
+
+  fprintf(out, "Swift reference counting profile: %zu types\n", rows.size());
+  fprintf(out, "%12s %12s %12s  %s\n",
+          "retains", "releases", "allocs", "type");
+  for (auto *row : rows) {
+    auto *metadata =
+      reinterpret_cast<const Metadata *>(row->Metadata.load(
+                                           std::memory_order_relaxed));
+    std::string name = nameForMetadata(metadata, /*qualified=*/true);
+    fprintf(out, "%12llu %12llu %12llu  %s\n",
+            (unsigned long long)row->Retains.load(std::memory_order_relaxed),
+            (unsigned long long)row->Releases.load(std::memory_order_relaxed),
+            (unsigned long long)row->Allocations.load(
+                                  std::memory_order_relaxed),
+            name.c_str());
+  }
+  if (uint64_t overflowed = OverflowEvents.load(std::memory_order_relaxed))
+    fprintf(out, "%llu events not attributed to a type (table full)\n",
+            (unsigned long long)overflowed);
+
+  if (out != stderr)
+    fclose(out);
+}
+
+__attribute__((constructor))
+static void installRefCountProfiler() {
+  const char *setting = getenv("SWIFT_RUNTIME_PROFILE_REFCOUNTS");
+  if (!setting || !*setting)
+    return;
+
+  // calloc rather than a static table so that processes that never enable
+  // profiling don't pay for the storage.
+  ProfileTable = reinterpret_cast<TypeCounters *>(
+    calloc(ShardCount * SlotsPerShard, sizeof(TypeCounters)));
+  if (!ProfileTable)
+    return;
+
+  OrigAllocObject = _swift_allocObject;
+  OrigRetain = _swift_retain;
+  OrigRetainN = _swift_retain_n;
+  OrigRelease = _swift_release;
+  OrigReleaseN = _swift_release_n;
+
+  _swift_allocObject = profiledAllocObject;
+  _swift_retain = profiledRetain;
+  _swift_retain_n = profiledRetainN;
+  _swift_release = profiledRelease;
+  _swift_release_n = profiledReleaseN;
+
+  atexit(reportRefCountProfile);
+}
@@ -26,6 +26,7 @@
 #include "swift/Basic/Demangle.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Lazy.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Heap.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
@@ -37,12 +38,14 @@
 #include <dlfcn.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #if SWIFT_OBJC_INTEROP
 # import <CoreFoundation/CFBase.h> // for CFTypeID
 # include <malloc/malloc.h>
 # include <dispatch/dispatch.h>
+# include <mach-o/dyld.h>
 #endif
 #if SWIFT_RUNTIME_ENABLE_DTRACE
 # include "SwiftRuntimeDTraceProbes.h"
@@ -194,6 +197,75 @@ static NSString *_getClassDescription(Class cls) {
   return NSStringFromClass_fn(cls);
 }
 
+namespace {
+/// An entry in the cache of negative respondsToSelector verdicts.
+struct SelectorCacheEntry {
+  const void *ClassObject;
+  SEL Selector;
+  /// The selector cache generation the verdict was recorded under.
+  size_t Generation;
+};
+}
+
+/// Selectors a class is known not to answer, keyed by (class, selector).
+/// A class_respondsToSelector miss walks the method lists of the whole
+/// superclass chain, and layout code probes the same few unimplemented
+/// delegate selectors on every pass.  Hits are already cached by the
+/// Objective-C method cache, so only misses are recorded here.  Swift
+/// classes never install methods lazily through +resolveInstanceMethod:,
+/// but loading an image can attach categories to existing classes, so
+/// verdicts carry a generation that image loads invalidate.
+static Lazy<ConcurrentMap<size_t, SelectorCacheEntry>> NegativeSelectorCache;
+
+/// Bumped whenever a new image is loaded.  The Objective-C runtime
+/// attaches the image's categories from its own, earlier-registered dyld
+/// callback, so by the time the generation advances the new methods are
+/// already visible to class_respondsToSelector.
+static std::atomic<size_t> SelectorCacheGeneration(1);
+
+static void _selectorCacheImageAdded(const struct mach_header *, intptr_t) {
+  SelectorCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+static size_t getSelectorCacheGeneration() {
+  // Registering the callback also invokes it once per already-loaded
+  // image, which harmlessly advances the generation.
+  static bool registered =
+    (_dyld_register_func_for_add_image(_selectorCacheImageAdded), true);
+  (void)registered;
+  return SelectorCacheGeneration.load(std::memory_order_relaxed);
+}
+
+static size_t hashSelectorPair(const void *cls, SEL sel) {
+  // A simple hash function for the class/selector pair.
+  return (size_t)cls + ((size_t)sel >> 2);
+}
+
+static bool _swift_classRespondsToSelector(Class cls, SEL sel) {
+  // Read the generation before asking the runtime, so that an image load
+  // racing with the query can only make the recorded verdict look stale,
+  // never wrongly fresh.
+  size_t generation = getSelectorCacheGeneration();
+
+  ConcurrentList<SelectorCacheEntry> &Bucket =
+    NegativeSelectorCache.get().findOrAllocateNode(hashSelectorPair(cls, sel));
+  for (auto &Entry : Bucket) {
+    if (Entry.ClassObject == (const void *)cls && Entry.Selector == sel) {
+      // Entries are pushed at the front, so the first match is the newest
+      // verdict for this pair.  A verdict from an older generation may
+      // have been invalidated by a loaded category; re-verify it.
+      if (Entry.Generation == generation)
+        return false;
+      break;
+    }
+  }
+
+  if (class_respondsToSelector(cls, sel))
+    return true;
+
+  Bucket.push_front({(const void *)cls, sel, generation});
+  return false;
+}
 
 @implementation SwiftObject
 + (void)initialize {}
@@ -327,17 +399,19 @@ static NSString *_getClassDescription(Class cls) {
 
 + (BOOL)respondsToSelector:(SEL)sel {
   if (!sel) return NO;
-  return class_respondsToSelector((Class) _swift_getClassOfAllocated(self), sel);
+  return _swift_classRespondsToSelector(
+      (Class) _swift_getClassOfAllocated(self), sel);
 }
 
 - (BOOL)respondsToSelector:(SEL)sel {
   if (!sel) return NO;
-  return class_respondsToSelector((Class) _swift_getClassOfAllocated(self), sel);
+  return _swift_classRespondsToSelector(
+      (Class) _swift_getClassOfAllocated(self), sel);
 }
 
 + (BOOL)instancesRespondToSelector:(SEL)sel {
   if (!sel) return NO;
-  return class_respondsToSelector(self, sel);
+  return _swift_classRespondsToSelector(self, sel);
 }
 
 - (BOOL)conformsToProtocol:(Protocol*)proto {
@@ -856,6 +930,11 @@ void swift::swift_unknownUnownedTakeAssign(UnownedReference *dest,
 // FIXME: these are not really valid implementations; they assume too
 // much about the implementation of ObjC weak references, and the
 // loads from ->Value can race with clears by the runtime.
+//
+// An initialized native weak reference stores a tagged side-table entry
+// pointer, so a stored value is classified syntactically with
+// isNativeWeakReferenceValue rather than by inspecting the pointee.  Only
+// incoming object values are classified by their class.
 
 static void doWeakInit(WeakReference *addr, void *value, bool valueIsNative) {
   assert(value != nullptr);
@@ -893,12 +972,12 @@ void swift::swift_unknownWeakAssign(WeakReference *addr, void *newValue) {
 
   bool newIsNative = usesNativeSwiftReferenceCounting_allocated(newValue);
 
-  // If the existing value is not allocated, this is just an initialize.
   void *oldValue = addr->Value;
-  if (isObjCTaggedPointerOrNull(oldValue))
-    return doWeakInit(addr, newValue, newIsNative);
+  bool oldIsNative = isNativeWeakReferenceValue(oldValue);
 
-  bool oldIsNative = usesNativeSwiftReferenceCounting_allocated(oldValue);
+  // If the existing value is not allocated, this is just an initialize.
+  if (!oldIsNative && isObjCTaggedPointerOrNull(oldValue))
+    return doWeakInit(addr, newValue, newIsNative);
 
   // If they're both native, we can use the native function.
   if (oldIsNative && newIsNative)
@@ -916,51 +995,49 @@ void swift::swift_unknownWeakAssign(WeakReference *addr, void *newValue) {
 
 void *swift::swift_unknownWeakLoadStrong(WeakReference *addr) {
   void *value = addr->Value;
+  if (isNativeWeakReferenceValue(value))
+    return swift_weakLoadStrong(addr);
   if (isObjCTaggedPointerOrNull(value)) return value;
 
-  if (usesNativeSwiftReferenceCounting_allocated(value)) {
-    return swift_weakLoadStrong(addr);
-  } else {
-    return (void*) objc_loadWeakRetained((id*) &addr->Value);
-  }
+  return (void*) objc_loadWeakRetained((id*) &addr->Value);
 }
 
 void *swift::swift_unknownWeakTakeStrong(WeakReference *addr) {
   void *value = addr->Value;
+  if (isNativeWeakReferenceValue(value))
+    return swift_weakTakeStrong(addr);
   if (isObjCTaggedPointerOrNull(value)) return value;
 
-  if (usesNativeSwiftReferenceCounting_allocated(value)) {
-    return swift_weakTakeStrong(addr);
-  } else {
-    void *result = (void*) objc_loadWeakRetained((id*) &addr->Value);
-    objc_destroyWeak((id*) &addr->Value);
-    return result;
-  }
+  void *result = (void*) objc_loadWeakRetained((id*) &addr->Value);
+  objc_destroyWeak((id*) &addr->Value);
+  return result;
 }
 
 void swift::swift_unknownWeakDestroy(WeakReference *addr) {
-  id object = (id) addr->Value;
-  if (isObjCTaggedPointerOrNull(object)) return;
-  doWeakDestroy(addr, usesNativeSwiftReferenceCounting_allocated(object));
+  void *value = addr->Value;
+  if (isNativeWeakReferenceValue(value))
+    return swift_weakDestroy(addr);
+  if (isObjCTaggedPointerOrNull(value)) return;
+  objc_destroyWeak((id*) &addr->Value);
 }
 void swift::swift_unknownWeakCopyInit(WeakReference *dest, WeakReference *src) {
-  id object = (id) src->Value;
-  if (isObjCTaggedPointerOrNull(object)) {
-    dest->Value = (HeapObject*) object;
+  void *value = src->Value;
+  if (isNativeWeakReferenceValue(value))
+    return swift_weakCopyInit(dest, src);
+  if (isObjCTaggedPointerOrNull(value)) {
+    dest->Value = (HeapObject*) value;
     return;
   }
-  if (usesNativeSwiftReferenceCounting_allocated(object))
-    return swift_weakCopyInit(dest, src);
   objc_copyWeak((id*) &dest->Value, (id*) src);
 }
 void swift::swift_unknownWeakTakeInit(WeakReference *dest, WeakReference *src) {
-  id object = (id) src->Value;
-  if (isObjCTaggedPointerOrNull(object)) {
-    dest->Value = (HeapObject*) object;
+  void *value = src->Value;
+  if (isNativeWeakReferenceValue(value))
+    return swift_weakTakeInit(dest, src);
+  if (isObjCTaggedPointerOrNull(value)) {
+    dest->Value = (HeapObject*) value;
     return;
   }
-  if (usesNativeSwiftReferenceCounting_allocated(object))
-    return swift_weakTakeInit(dest, src);
   objc_moveWeak((id*) &dest->Value, (id*) &src->Value);
 }
 void swift::swift_unknownWeakCopyAssign(WeakReference *dest, WeakReference *src) {
@@ -979,6 +1056,42 @@ void swift::swift_unknownWeakTakeAssign(WeakReference *dest, WeakReference *src)
 /******************************* DYNAMIC CASTS *******************************/
 /*****************************************************************************/
 #if SWIFT_OBJC_INTEROP
+namespace {
+/// An entry in the cache of class-to-class cast verdicts.
+struct ClassCastCacheEntry {
+  const void *SourceClass;
+  const ClassMetadata *TargetClass;
+  bool Verdict;
+};
+}
+
+/// Cached isKindOfClass verdicts, keyed by (source class, target class)
+/// pairs. The bridging casts behind 'String as NSString'-style crossings hit
+/// the same few pairs over and over, including the tagged-pointer classes
+/// used for short strings and numbers, and this keeps them out of
+/// objc_msgSend.
+static Lazy<ConcurrentMap<size_t, ClassCastCacheEntry>> ClassCastCache;
+
+static size_t hashClassCastPair(const void *sourceClass,
+                                const ClassMetadata *targetType) {
+  // A simple hash function for the class pair.
+  return (size_t)sourceClass + ((size_t)targetType >> 2);
+}
+
+/// Can isKindOfClass verdicts for instances of the given class be cached?
+/// Only classes using the standard implementations answer from the immutable
+/// superclass chain alone; proxies and other overriders can answer
+/// per-instance.
+static bool isKindOfClassCacheable(Class sourceType) {
+  static IMP NSObjectIMP = class_getMethodImplementation(
+      [NSObject class], @selector(isKindOfClass:));
+  static IMP SwiftObjectIMP = class_getMethodImplementation(
+      [SwiftObject class], @selector(isKindOfClass:));
+  IMP imp = class_getMethodImplementation(sourceType,
+                                          @selector(isKindOfClass:));
+  return imp == NSObjectIMP || imp == SwiftObjectIMP;
+}
+
 const void *
 swift::swift_dynamicCastObjCClass(const void *object,
                                   const ClassMetadata *targetType) {
@@ -986,11 +1099,20 @@ swift::swift_dynamicCastObjCClass(const void *object,
   if (object == nullptr)
     return nullptr;
 
-  if ([(id)object isKindOfClass:(Class)targetType]) {
-    return object;
+  Class sourceType = object_getClass((id)object);
+  ConcurrentList<ClassCastCacheEntry> &Bucket =
+    ClassCastCache.get().findOrAllocateNode(
+      hashClassCastPair(sourceType, targetType));
+  for (auto &Entry : Bucket) {
+    if (Entry.SourceClass == sourceType && Entry.TargetClass == targetType)
+      return Entry.Verdict ? object : nullptr;
   }
 
-  return nullptr;
+  bool verdict = [(id)object isKindOfClass:(Class)targetType];
+  if (isKindOfClassCacheable(sourceType))
+    Bucket.push_front({sourceType, targetType, verdict});
+
+  return verdict ? object : nullptr;
 }
 
 const void *
@@ -1000,12 +1122,11 @@ swift::swift_dynamicCastObjCClassUnconditional(const void *object,
   if (object == nullptr)
     return nullptr;
 
-  if ([(id)object isKindOfClass:(Class)targetType]) {
-    return object;
-  }
+  if (auto result = swift_dynamicCastObjCClass(object, targetType))
+    return result;
 
   Class sourceType = object_getClass((id)object);
-  swift_dynamicCastFailure(reinterpret_cast<const Metadata *>(sourceType), 
+  swift_dynamicCastFailure(reinterpret_cast<const Metadata *>(sourceType),
                            targetType);
 }
 
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <mutex>
 #include <assert.h>
+#include <string.h>
 
 #include <unicode/ustring.h>
 #include <unicode/ucol.h>
@@ -183,6 +184,63 @@ int32_t _swift_stdlib_unicode_compare_utf8_utf8(const char *LeftString,
   return Diff;
 }
 
+/// Compares two strings which are known to consist of ASCII characters only,
+/// with the same root-locale collation semantics as the ICU based functions
+/// above, but without calling into ICU.
+/// Results are the usual string comparison results:
+///  <0 the left string is less than the right string.
+/// ==0 the strings are equal according to their collation.
+///  >0 the left string is greater than the right string.
+extern "C"
+int32_t _swift_stdlib_unicode_compare_ascii_ascii(const char *LeftString,
+                                                  int32_t LeftLength,
+                                                  const char *RightString,
+                                                  int32_t RightLength) {
+  // Equal bytes collate equal. This is the hot case when strings are used as
+  // dictionary keys, and the (vectorized) memcmp of the C library beats
+  // walking collation elements by a wide margin.
+  if (LeftLength == RightLength &&
+      memcmp(LeftString, RightString, LeftLength) == 0)
+    return UCOL_EQUAL;
+
+  // The collation algorithm compares all primary weights before it looks at
+  // the lower levels, so run one pass over the primary weights and, only if
+  // they tie, a second pass over the full collation elements. In the ASCII
+  // subset every character produces exactly one collation element and the
+  // secondary weights are constant, which makes this equivalent to a full
+  // collation of the two strings.
+  const ASCIICollation *Table = ASCIICollation::getTable();
+  for (unsigned Pass = 0; Pass < 2; ++Pass) {
+    const uint32_t Mask = Pass == 0 ? UCOL_PRIMARYORDERMASK : ~0u;
+    int32_t LeftPos = 0;
+    int32_t RightPos = 0;
+    while (true) {
+      // Fetch the next collation element on each side. Zero valued collation
+      // elements are skipped; they don't participate in the ordering
+      // relation.
+      int32_t LeftElem = 0;
+      while (LeftElem == 0 && LeftPos < LeftLength) {
+        const char c = LeftString[LeftPos++];
+        assert((c & 0x80) == 0 && "This table only exists for the ASCII subset");
+        LeftElem = Table->map(c);
+      }
+      int32_t RightElem = 0;
+      while (RightElem == 0 && RightPos < RightLength) {
+        const char c = RightString[RightPos++];
+        assert((c & 0x80) == 0 && "This table only exists for the ASCII subset");
+        RightElem = Table->map(c);
+      }
+      uint32_t LeftWeight = (uint32_t)LeftElem & Mask;
+      uint32_t RightWeight = (uint32_t)RightElem & Mask;
+      if (LeftWeight != RightWeight)
+        return LeftWeight < RightWeight ? UCOL_LESS : UCOL_GREATER;
+      if (LeftElem == 0 && RightElem == 0)
+        break;
+    }
+  }
+  return UCOL_EQUAL;
+}
+
 // These functions use murmurhash2 in its 32 and 64bit forms, which are
 // differentiated by the constants defined below. This seems like a good choice
 // for now because it operates efficiently in blocks rather than bytes, and 
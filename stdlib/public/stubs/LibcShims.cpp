@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "../SwiftShims/LibcShims.h"
+#include "swift/Runtime/Heap.h"
 
 #if defined(__linux__)
 #include <bsd/stdlib.h>
@@ -30,6 +31,14 @@ void _swift_stdlib_free(void *ptr) { free(ptr); }
 
 int _swift_stdlib_putchar(int c) { return putchar(c); }
 
+__swift_size_t _swift_stdlib_fwrite_stdout(const void *ptr,
+                                           __swift_size_t size,
+                                           __swift_size_t nitems) {
+  return fwrite(ptr, size, nitems, stdout);
+}
+
+int _swift_stdlib_fflush_stdout() { return fflush(stdout); }
+
 __swift_size_t _swift_stdlib_strlen(const char *s) { return strlen(s); }
 
 int _swift_stdlib_memcmp(const void *s1, const void *s2, __swift_size_t n) {
@@ -49,21 +58,32 @@ int _swift_stdlib_close(int fd) { return close(fd); }
 
 #if defined(__APPLE__)
 #include <malloc/malloc.h>
-size_t _swift_stdlib_malloc_size(const void *ptr) { return malloc_size(ptr); }
+static size_t _swift_system_malloc_size(const void *ptr) {
+  return malloc_size(ptr);
+}
 #elif defined(__GNU_LIBRARY__)
 #include <malloc.h>
-size_t _swift_stdlib_malloc_size(const void *ptr) {
+static size_t _swift_system_malloc_size(const void *ptr) {
   return malloc_usable_size(const_cast<void *>(ptr));
 }
 #elif defined(__FreeBSD__)
 #include <malloc_np.h>
-size_t _swift_stdlib_malloc_size(const void *ptr) {
+static size_t _swift_system_malloc_size(const void *ptr) {
   return malloc_usable_size(const_cast<void *>(ptr));
 }
 #else
 #error No malloc_size analog known for this platform/libc.
 #endif
 
+size_t _swift_stdlib_malloc_size(const void *ptr) {
+  // Small blocks served from the runtime's magazines are interior
+  // pointers into a larger chunk; the system allocator knows nothing
+  // about them.
+  if (size_t magazine = swift_magazineBlockSize(ptr))
+    return magazine;
+  return _swift_system_malloc_size(ptr);
+}
+
 __swift_uint32_t _swift_stdlib_arc4random(void) { return arc4random(); }
 
 __swift_uint32_t
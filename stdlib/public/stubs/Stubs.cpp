@@ -315,6 +315,117 @@ __mulodi4(di_int a, di_int b, int* overflow)
 }
 #endif
 
+/// Powers of ten that are exactly representable as doubles.  10^22 is
+/// the largest such power.
+static const double ExactPowersOfTen[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+  1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Try to parse the decimal floating point number in [nptr, end)
+/// without going through strtod_l.
+///
+/// This covers the common case -- an optional sign, at most 19
+/// significant digits, and a decimal exponent no further than 22 from
+/// zero -- where the significand fits in 53 bits, so
+/// `significand * 10^exponent` involves only exactly-representable
+/// quantities and a single IEEE rounding produces the correctly
+/// rounded result (Clinger's fast path).  Everything else (hex
+/// floats, infinities, NaNs, long or out-of-range inputs) returns
+/// false so the caller can fall back to strtod_l; inputs accepted
+/// here convert bit-for-bit identically to that fallback.
+static bool _swift_parseDoubleFast(const char *nptr, const char *end,
+                                   double *outResult, const char **outEnd) {
+  const char *p = nptr;
+  if (p == end)
+    return false;
+
+  bool negative = false;
+  if (*p == '+' || *p == '-') {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  // Leave hex floats to strtod_l.
+  if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return false;
+
+  uint64_t significand = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool sawDigits = false;
+
+  while (p != end && *p >= '0' && *p <= '9') {
+    sawDigits = true;
+    // Leading zeros carry no significance.
+    if (significand != 0 || *p != '0') {
+      if (++digits > 19)
+        return false;
+      significand = significand * 10 + uint64_t(*p - '0');
+    }
+    ++p;
+  }
+
+  if (p != end && *p == '.') {
+    ++p;
+    while (p != end && *p >= '0' && *p <= '9') {
+      sawDigits = true;
+      if (significand != 0 || *p != '0') {
+        if (++digits > 19)
+          return false;
+        significand = significand * 10 + uint64_t(*p - '0');
+      }
+      --exponent;
+      ++p;
+    }
+  }
+
+  if (!sawDigits)
+    return false;
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    const char *expStart = p;
+    ++p;
+    bool expNegative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+      expNegative = (*p == '-');
+      ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+      // An 'e' not followed by digits is not part of the number.
+      p = expStart;
+    } else {
+      int explicitExponent = 0;
+      while (p != end && *p >= '0' && *p <= '9') {
+        // Clamp; anything this large falls out of the fast path below
+        // anyway, and clamping avoids overflowing the accumulator.
+        if (explicitExponent < 10000)
+          explicitExponent = explicitExponent * 10 + (*p - '0');
+        ++p;
+      }
+      exponent += expNegative ? -explicitExponent : explicitExponent;
+    }
+  }
+
+  // The significand must convert to double without rounding, and the
+  // scale must be an exact power of ten, for the final operation to be
+  // the only rounding step.
+  if (significand >> 53)
+    return false;
+  if (exponent < -22 || exponent > 22)
+    return false;
+
+  double value = double(significand);
+  if (exponent < 0)
+    value /= ExactPowersOfTen[-exponent];
+  else
+    value *= ExactPowersOfTen[exponent];
+
+  *outResult = negative ? -value : value;
+  *outEnd = p;
+  return true;
+}
+
 // We can't return Float80, but we can receive a pointer to one, so
 // switch the return type and the out parameter on strtold.
 template <typename T>
@@ -341,6 +452,9 @@ extern "C" const char *_swift_stdlib_strtold_clocale(
 
 extern "C" const char *_swift_stdlib_strtod_clocale(
     const char * nptr, double *outResult) {
+  const char *fastEnd;
+  if (_swift_parseDoubleFast(nptr, nptr + strlen(nptr), outResult, &fastEnd))
+    return fastEnd;
   return _swift_stdlib_strtoX_clocale_impl(
     nptr, outResult, HUGE_VAL, strtod_l);
 }
@@ -351,6 +465,52 @@ extern "C" const char *_swift_stdlib_strtof_clocale(
     nptr, outResult, HUGE_VALF, strtof_l);
 }
 
+// strtoX_l requires NUL-termination, so the length-based variants that
+// miss the fast path copy into a scratch buffer first; numbers are
+// short, so the copy almost never leaves the stack.
+template <typename T>
+static const char *_swift_stdlib_strtoX_clocale_n_impl(
+    const char *nptr, size_t length, T *outResult, T huge,
+    T (*posixImpl)(const char *, char **, locale_t)
+) {
+  char stackCopy[128];
+  char *copy = stackCopy;
+  if (length >= sizeof(stackCopy)) {
+    copy = static_cast<char *>(malloc(length + 1));
+    if (!copy)
+      swift::crash("unable to allocate memory for float parsing");
+  }
+  memcpy(copy, nptr, length);
+  copy[length] = '\0';
+  const char *copyEnd =
+      _swift_stdlib_strtoX_clocale_impl(copy, outResult, huge, posixImpl);
+  const char *result = copyEnd ? nptr + (copyEnd - copy) : nullptr;
+  if (copy != stackCopy)
+    free(copy);
+  return result;
+}
+
+extern "C" const char *_swift_stdlib_strtold_clocale_n(
+    const char *nptr, size_t length, void *outResult) {
+  return _swift_stdlib_strtoX_clocale_n_impl(
+    nptr, length, static_cast<long double*>(outResult), HUGE_VALL, strtold_l);
+}
+
+extern "C" const char *_swift_stdlib_strtod_clocale_n(
+    const char *nptr, size_t length, double *outResult) {
+  const char *fastEnd;
+  if (_swift_parseDoubleFast(nptr, nptr + length, outResult, &fastEnd))
+    return fastEnd;
+  return _swift_stdlib_strtoX_clocale_n_impl(
+    nptr, length, outResult, HUGE_VAL, strtod_l);
+}
+
+extern "C" const char *_swift_stdlib_strtof_clocale_n(
+    const char *nptr, size_t length, float *outResult) {
+  return _swift_stdlib_strtoX_clocale_n_impl(
+    nptr, length, outResult, HUGE_VALF, strtof_l);
+}
+
 extern "C" void _swift_stdlib_flockfile_stdout() {
   flockfile(stdout);
 }
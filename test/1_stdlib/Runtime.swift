@@ -621,6 +621,14 @@ enum SomeEnum {
   init() { self = .A }
 }
 
+Runtime.test("typeByName") {
+  expectTrue(_typeByName("DoesNotExist") == nil)
+  expectTrue(_typeByName("_TtC1a9SomeClass")! == SomeClass.self)
+  // A second lookup of the same name is answered from the cache.
+  expectTrue(_typeByName("_TtC1a9SomeClass")! == SomeClass.self)
+  expectTrue(_typeByName("NSObject")! == NSObject.self)
+}
+
 Runtime.test("typeName") {
   expectEqual("a.SomeClass", _typeName(SomeClass.self))
   expectEqual("a.SomeObjCClass", _typeName(SomeObjCClass.self))
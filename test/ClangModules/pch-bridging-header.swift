@@ -0,0 +1,18 @@
+// RUN: rm -rf %t
+// RUN: mkdir -p %t
+
+// First, emit a PCH from the bridging header, then import the PCH in place of
+// the textual header.
+// RUN: %target-swift-frontend -emit-pch %S/Inputs/sdk-bridging-header.h -o %t/sdk-bridging-header.pch
+// RUN: %target-swift-frontend -parse -verify %s -import-objc-header %t/sdk-bridging-header.pch
+
+// REQUIRES: objc_interop
+
+import Foundation
+
+let `true` = Predicate.truePredicate()
+let not = Predicate.not()
+let and = Predicate.and([])
+let or = Predicate.or([not, and])
+
+_ = Predicate.foobar() // expected-error{{type 'Predicate' has no member 'foobar'}}
@@ -0,0 +1,18 @@
+#!/usr/bin/env python
+
+# fake-remote-exec.py simulates a remote execution service for driver tests.
+# It receives a complete frontend command line, notes which primary file it
+# was asked to "dispatch", and then simply runs the command locally.
+
+import os
+import subprocess
+import sys
+
+assert sys.argv[2] == '-frontend'
+
+if '-primary-file' in sys.argv:
+  primaryFile = sys.argv[sys.argv.index('-primary-file') + 1]
+  print "Dispatched", os.path.basename(primaryFile)
+  sys.stdout.flush()
+
+sys.exit(subprocess.call(sys.argv[1:]))
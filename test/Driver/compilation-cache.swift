@@ -0,0 +1,11 @@
+// RUN: rm -rf %t && mkdir -p %t/cache %t/obj1 %t/obj2
+
+// The first build misses the cache and populates an entry per compile job.
+// RUN: cd %t/obj1 && %swiftc_driver -c -driver-compilation-cache-path %t/cache -module-name ThisModule %S/Inputs/main.swift %S/Inputs/lib.swift
+// RUN: find %t/cache -name "primary.0" | count 2
+
+// An identical build restores the outputs without running the frontend.
+// RUN: cd %t/obj2 && %swiftc_driver -c -driver-compilation-cache-path %t/cache -module-name ThisModule %S/Inputs/main.swift %S/Inputs/lib.swift -v 2>&1 | FileCheck -check-prefix=CHECK-HIT -allow-empty %s
+// RUN: ls %t/obj2/main.o %t/obj2/lib.o
+
+// CHECK-HIT-NOT: -frontend
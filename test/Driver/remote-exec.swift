@@ -0,0 +1,15 @@
+// RUN: rm -rf %t && mkdir -p %t
+
+// Compile jobs are handed to the remote execution tool as complete frontend
+// command lines; the fake tool records the dispatch and runs them locally.
+// RUN: cd %t && %swiftc_driver -c -driver-remote-exec-tool %S/Inputs/fake-remote-exec.py -module-name ThisModule -j2 %S/Inputs/main.swift %S/Inputs/lib.swift 2>&1 | FileCheck %s
+// RUN: ls %t/main.o %t/lib.o
+
+// CHECK-DAG: Dispatched main.swift
+// CHECK-DAG: Dispatched lib.swift
+
+// The single-job fast path goes through the tool as well.
+// RUN: %swiftc_driver -c -driver-remote-exec-tool %S/Inputs/fake-remote-exec.py -module-name ThisModule -o %t/single.o %S/Inputs/lib.swift 2>&1 | FileCheck -check-prefix=CHECK-SINGLE %s
+// RUN: ls %t/single.o
+
+// CHECK-SINGLE: Dispatched lib.swift
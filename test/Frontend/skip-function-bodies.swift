@@ -0,0 +1,18 @@
+// RUN: %target-swift-frontend -parse -verify -skip-function-bodies %s
+
+// Declarations are still validated when function bodies are skipped...
+struct HasBadMember {
+  var x: DoesNotExist // expected-error {{use of undeclared type 'DoesNotExist'}}
+}
+
+// ...but errors inside function bodies are not diagnosed.
+func bodyIsNotChecked() {
+  let x: Int = "not an Int"
+  undefinedFunction(x)
+}
+
+class Container {
+  func methodBodyIsNotChecked() {
+    return alsoUndefined
+  }
+}
@@ -0,0 +1,14 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: %target-swift-frontend -parse -primary-file %s -stats-output-path %t/stats.json
+// RUN: FileCheck %s < %t/stats.json
+
+// CHECK: "main_input": "{{.*}}stats-output-path.swift"
+// CHECK: "lexed_bytes": {{[1-9][0-9]*}}
+// CHECK: "solver_scopes": {{[0-9]+}}
+// CHECK: "sil_insts_created": {{[0-9]+}}
+// CHECK: "sil_insts_deleted": {{[0-9]+}}
+// CHECK: "decls_deserialized": {{[0-9]+}}
+
+func f() -> Int {
+  return 1 + 2
+}
@@ -0,0 +1,13 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: %target-swift-frontend -emit-sil -primary-file %s -o /dev/null -trace-events-path %t/trace.json
+// RUN: FileCheck %s < %t/trace.json
+
+// CHECK: {"traceEvents":[
+// CHECK-DAG: "name":"Parsing"
+// CHECK-DAG: "name":"Type checking / Semantic analysis"
+// CHECK-DAG: "name":"SILGen"
+// CHECK: ]}
+
+func f() -> Int {
+  return 1 + 2
+}
@@ -0,0 +1,18 @@
+// RUN: mkdir -p %t
+// RUN: %S/../../utils/split_file.py -o %t %s
+// RUN: %target-swift-frontend -dump-interface-hash %t/a.swift 2> %t/a.hash
+// RUN: %target-swift-frontend -dump-interface-hash %t/b.swift 2> %t/b.hash
+// RUN: cmp %t/a.hash %t/b.hash
+
+// BEGIN a.swift
+// A comment describing f.
+func f() -> Int {
+    return 0
+}
+
+// BEGIN b.swift
+// An edited comment describing f.
+/// Even a new doc comment.
+func f() -> Int {
+    return 0
+}
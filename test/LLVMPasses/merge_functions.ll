@@ -0,0 +1,56 @@
+; RUN: %swift-llvm-opt -swift-merge-functions %s | FileCheck %s
+
+target datalayout = "e-p:64:64:64-S128-i1:8:8-i8:8:8-i16:16:16-i32:32:32-i64:64:64-f16:16:16-f32:32:32-f64:64:64-f128:128:128-v64:64:64-v128:128:128-a0:0:64-s0:64:64-f80:128:128-n8:16:32:64"
+target triple = "x86_64-apple-macosx10.9"
+
+declare i32 @use(i32)
+
+; CHECK-LABEL: define internal i32 @first(i32 %x)
+define internal i32 @first(i32 %x) {
+entry:
+  %a = add i32 %x, 1
+  %b = call i32 @use(i32 %a)
+  ret i32 %b
+}
+
+; The exact duplicate of @first must be folded into it.
+; CHECK-NOT: define internal i32 @duplicate
+
+define internal i32 @duplicate(i32 %x) {
+entry:
+  %a = add i32 %x, 1
+  %b = call i32 @use(i32 %a)
+  ret i32 %b
+}
+
+; A function with a differing constant must survive.
+; CHECK-LABEL: define internal i32 @different(i32 %x)
+define internal i32 @different(i32 %x) {
+entry:
+  %a = add i32 %x, 2
+  %b = call i32 @use(i32 %a)
+  ret i32 %b
+}
+
+; An external duplicate may not be folded.
+; CHECK-LABEL: define i32 @visible(i32 %x)
+define i32 @visible(i32 %x) {
+entry:
+  %a = add i32 %x, 1
+  %b = call i32 @use(i32 %a)
+  ret i32 %b
+}
+
+; CHECK-LABEL: define i32 @caller(i32 %x)
+; CHECK: call i32 @first(i32 %x)
+; CHECK: call i32 @first(i32 %x)
+; CHECK: call i32 @different(i32 %x)
+define i32 @caller(i32 %x) {
+entry:
+  %a = call i32 @first(i32 %x)
+  %b = call i32 @duplicate(i32 %x)
+  %c = call i32 @different(i32 %x)
+  %d = add i32 %a, %b
+  %e = add i32 %d, %c
+  ret i32 %e
+}
@@ -0,0 +1,16 @@
+// RUN: %target-swift-frontend -emit-silgen -sil-emit-reachable-functions-only %s | FileCheck %s
+// RUN: %target-swift-frontend -emit-silgen -sil-emit-reachable-functions-only %s | FileCheck -check-prefix=NEGATIVE %s
+
+// In demand-driven emission mode, a private function is only lowered once
+// something reachable references it.
+
+private func deadHelper() -> Int { return 1 }
+
+private func usedHelper() -> Int { return 2 }
+
+public func entry() -> Int { return usedHelper() }
+
+// CHECK-DAG: sil @_TF4main5entryFT_Si
+// CHECK-DAG: sil private @_TF4mainP{{.*}}10usedHelperFT_Si
+
+// NEGATIVE-NOT: deadHelper
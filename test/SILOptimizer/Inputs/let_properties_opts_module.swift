@@ -0,0 +1,9 @@
+public struct Constants {
+  public let maxValue = 100
+  public init() {}
+}
+
+public class Config {
+  public let limit = 42
+  public init() {}
+}
@@ -0,0 +1,14 @@
+public struct PartialConstants {
+  public let value: Int
+
+  // Serialized: the body is available to clients.
+  @_transparent
+  public init() {
+    value = 100
+  }
+
+  // Not serialized: clients see only the declaration.
+  public init(other: Int) {
+    value = other
+  }
+}
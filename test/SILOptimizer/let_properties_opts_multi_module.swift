@@ -0,0 +1,37 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: %target-swift-frontend -emit-module -O -sil-serialize-all -parse-as-library -module-name LetPropertiesModule %S/Inputs/let_properties_opts_module.swift -o %t/LetPropertiesModule.swiftmodule
+// RUN: %target-swift-frontend -emit-module -O -parse-as-library -module-name LetPropertiesModulePartial %S/Inputs/let_properties_opts_module_partial.swift -o %t/LetPropertiesModulePartial.swiftmodule
+// RUN: %target-swift-frontend %s -O -I %t -emit-sil | FileCheck %s
+
+// Test that let properties of types from another module are folded to their
+// constant initial values, provided the other module serialized the
+// initializer bodies.
+
+import LetPropertiesModule
+import LetPropertiesModulePartial
+
+// CHECK-LABEL: sil @{{.*}}testStructLetFold{{.*}}
+// CHECK: integer_literal ${{.*}}, 100
+// CHECK-NOT: struct_extract
+// CHECK: return
+public func testStructLetFold(x: Constants) -> Int {
+  return x.maxValue
+}
+
+// CHECK-LABEL: sil @{{.*}}testClassLetFold{{.*}}
+// CHECK: integer_literal ${{.*}}, 42
+// CHECK-NOT: ref_element_addr
+// CHECK: return
+public func testClassLetFold(x: Config) -> Int {
+  return x.limit
+}
+
+// A type with one serialized and one opaque initializer must not be folded:
+// the opaque initializer may store a different value.
+
+// CHECK-LABEL: sil @{{.*}}testPartiallySerializedNoFold{{.*}}
+// CHECK-NOT: integer_literal ${{.*}}, 100
+// CHECK: return
+public func testPartiallySerializedNoFold(x: PartialConstants) -> Int {
+  return x.value
+}
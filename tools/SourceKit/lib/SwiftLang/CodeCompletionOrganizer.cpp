@@ -197,7 +197,8 @@ public:
 
   void addCompletionsWithFilter(ArrayRef<Completion *> completions,
                                 StringRef filterText, Options options,
-                                Completion *&exactMatch);
+                                Completion *&exactMatch,
+                                std::vector<Completion *> *matches);
 
   void sort(Options options);
 
@@ -271,8 +272,9 @@ void CodeCompletionOrganizer::preSortCompletions(
 
 void CodeCompletionOrganizer::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText,
-    Completion *&exactMatch) {
-  impl.addCompletionsWithFilter(completions, filterText, options, exactMatch);
+    Completion *&exactMatch, std::vector<Completion *> *matches) {
+  impl.addCompletionsWithFilter(completions, filterText, options, exactMatch,
+                                matches);
 }
 
 void CodeCompletionOrganizer::groupAndSort(const Options &options) {
@@ -426,7 +428,7 @@ static bool isHighPriorityKeyword(CodeCompletionKeywordKind kind) {
 
 void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText, Options options,
-    Completion *&exactMatch) {
+    Completion *&exactMatch, std::vector<Completion *> *matches) {
   assert(rootGroup);
 
   auto &contents = rootGroup->contents;
@@ -494,6 +496,12 @@ void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
       match = completion->getName().startswith_lower(filterText);
     }
 
+    // Record every match, even if it is suppressed below: a longer filter
+    // text can only shrink the match set, so the next keystroke may refine
+    // this set instead of re-filtering everything.
+    if (match && matches)
+      matches->push_back(completion);
+
     if (match && completion->getName().equals_lower(filterText)) {
       if (!exactMatch)
         exactMatch = completion;
@@ -84,9 +84,15 @@ public:
   /// Add \p completions to the organizer, removing any results that don't match
   /// \p filterText and returning \p exactMatch if there is an exact match.
   ///
+  /// If \p matches is non-null and \p filterText is non-empty, it is filled
+  /// with every completion that matched the filter text, including matches
+  /// that are suppressed in the output, so that the next request can refine
+  /// this set instead of the full result list.
+  ///
   /// Precondition: \p completions should be sorted with preSortCompletions().
   void addCompletionsWithFilter(ArrayRef<Completion *> completions,
-                                StringRef filterText, Completion *&exactMatch);
+                                StringRef filterText, Completion *&exactMatch,
+                                std::vector<Completion *> *matches = nullptr);
 
   void groupAndSort(const Options &options);
 
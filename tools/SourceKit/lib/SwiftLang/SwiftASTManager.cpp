@@ -234,6 +234,9 @@ class ASTProducer : public ThreadSafeRefCountedBase<ASTProducer> {
   ThreadSafeRefCntPtr<ASTUnit> AST;
   SmallVector<std::pair<std::string, BufferStamp>, 8> DependencyStamps;
   std::vector<std::pair<SwiftASTConsumerRef, const void*>> QueuedConsumers;
+  /// True while a getASTUnitAsync job for this producer is on the build
+  /// queue but has not served its consumers yet. Guarded by \c Mtx.
+  bool BuildScheduled = false;
   llvm::sys::Mutex Mtx;
 
 public:
@@ -564,9 +567,28 @@ void ASTProducer::getASTUnitAsync(SwiftASTManager::Implementation &MgrImpl,
   SmallVector<ImmutableTextSnapshotRef, 4> Snapshots;
   Snapshots.append(Snaps.begin(), Snaps.end());
 
+  // If a build job for this producer is already waiting on the build queue,
+  // its receiver will pop and serve every consumer that has been enqueued by
+  // the time it finishes, including the one that triggered this call.
+  // Scheduling another job would only repeat the dependency stamp checks
+  // serially on the shared build queue while requests pile up.
+  {
+    llvm::sys::ScopedLock L(Mtx);
+    if (BuildScheduled)
+      return;
+    BuildScheduled = true;
+  }
+
   MgrImpl.ASTBuildQueue.dispatch([ThisProducer, &MgrImpl, Snapshots, Receiver] {
     std::string Error;
     ASTUnitRef Unit = ThisProducer->getASTUnitImpl(MgrImpl, Snapshots, Error);
+    {
+      // Clear the flag before serving consumers: anyone who enqueues from
+      // here on schedules a fresh job, and anyone who enqueued earlier is
+      // served by the pop below.
+      llvm::sys::ScopedLock L(ThisProducer->Mtx);
+      ThisProducer->BuildScheduled = false;
+    }
     Receiver(Unit, Error);
   }, /*isStackDeep=*/true);
 }
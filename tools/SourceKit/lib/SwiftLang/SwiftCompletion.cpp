@@ -646,6 +646,22 @@ ArrayRef<Completion *> CodeCompletion::SessionCache::getSortedCompletions() {
   llvm::sys::ScopedLock L(mtx);
   return sortedCompletions;
 }
+ArrayRef<Completion *>
+CodeCompletion::SessionCache::getFilterCandidates(StringRef filterText,
+                                                  bool fuzzy) {
+  llvm::sys::ScopedLock L(mtx);
+  if (!lastFilterText.empty() && fuzzy == lastFilterWasFuzzy &&
+      filterText.startswith(lastFilterText))
+    return lastFilterMatches;
+  return sortedCompletions;
+}
+void CodeCompletion::SessionCache::setFilterMatches(
+    StringRef filterText, bool fuzzy, std::vector<Completion *> &&matches) {
+  llvm::sys::ScopedLock L(mtx);
+  lastFilterText = filterText;
+  lastFilterWasFuzzy = fuzzy;
+  lastFilterMatches = std::move(matches);
+}
 llvm::MemoryBuffer *CodeCompletion::SessionCache::getBuffer() {
   llvm::sys::ScopedLock L(mtx);
   return buffer.get();
@@ -848,8 +864,16 @@ static void transformAndForwardResults(
       session->getCompletionKind() == CompletionKind::PostfixExpr;
 
   if (!hasEarlyInnerResults) {
-    organizer.addCompletionsWithFilter(session->getSortedCompletions(),
-                                       filterText, exactMatch);
+    // Refine the previous keystroke's match set when the new filter text
+    // merely extends it; otherwise filter the full sorted list.
+    bool fuzzy =
+        options.fuzzyMatching && filterText.size() >= options.minFuzzyLength;
+    std::vector<Completion *> matches;
+    organizer.addCompletionsWithFilter(
+        session->getFilterCandidates(filterText, fuzzy), filterText,
+        exactMatch, filterText.empty() ? nullptr : &matches);
+    if (!filterText.empty())
+      session->setFilterMatches(filterText, fuzzy, std::move(matches));
   }
 
   if (hasEarlyInnerResults &&
@@ -1334,6 +1334,9 @@ class SwiftEditorSyntaxWalker: public ide::SyntaxModelWalker {
   SwiftDocumentStructureWalker DocStructureWalker;
   std::vector<EditorConsumerSyntaxMapEntry> ConsumerSyntaxMap;
   unsigned NestingLevel = 0;
+  /// The location where the edited line range starts, used for a cheap
+  /// "entirely before the edit" test below.
+  SourceLoc EditedStartLoc;
 public:
   SwiftEditorSyntaxWalker(SwiftSyntaxMap &SyntaxMap,
                           SwiftEditorLineRange EditedLineRange,
@@ -1343,16 +1346,33 @@ public:
     : SyntaxMap(SyntaxMap), EditedLineRange(EditedLineRange),
       AffectedRange(AffectedRange), SrcManager(SrcManager), Consumer(Consumer),
       BufferID(BufferID),
-      DocStructureWalker(SrcManager, BufferID, Consumer) { }
+      DocStructureWalker(SrcManager, BufferID, Consumer) {
+    if (EditedLineRange.isValid())
+      EditedStartLoc = SrcManager.getLocForLineCol(BufferID,
+                                                   EditedLineRange.startLine(),
+                                                   1);
+  }
 
   bool walkToNodePre(SyntaxNode Node) override {
     if (Node.Kind == SyntaxNodeKind::CommentMarker)
       return DocStructureWalker.walkToNodePre(Node);
 
     ++NestingLevel;
+
+    // Most tokens of an edited file lie entirely before the edited lines and
+    // leave both the stored syntax map and the consumer entries untouched.
+    // Detect that with a single location comparison before paying for any
+    // line/column computations. Tokens ending exactly at the start of the
+    // edited line take the full path below, which reaches the same early
+    // exit after adjusting for the column.
+    if (EditedLineRange.isValid() && EditedStartLoc.isValid() &&
+        SrcManager.isBeforeInBuffer(Node.Range.getEnd(), EditedStartLoc))
+      return true;
+
     SourceLoc StartLoc = Node.Range.getStart();
-    auto StartLineAndColumn = SrcManager.getLineAndColumn(StartLoc);
-    auto EndLineAndColumn = SrcManager.getLineAndColumn(Node.Range.getEnd());
+    std::pair<unsigned, unsigned> StartLineAndColumn, EndLineAndColumn;
+    std::tie(StartLineAndColumn, EndLineAndColumn) =
+        SrcManager.getLineAndColumnRange(Node.Range, BufferID);
     unsigned StartLine = StartLineAndColumn.first;
     unsigned EndLine = EndLineAndColumn.second > 1 ? EndLineAndColumn.first
                                                    : EndLineAndColumn.first - 1;
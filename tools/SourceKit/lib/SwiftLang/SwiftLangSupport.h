@@ -137,6 +137,9 @@ class SessionCache : public ThreadSafeRefCountedBase<SessionCache> {
   CompletionSink sink;
   std::vector<Completion *> sortedCompletions;
   CompletionKind completionKind;
+  std::string lastFilterText;
+  bool lastFilterWasFuzzy = false;
+  std::vector<Completion *> lastFilterMatches;
   llvm::sys::Mutex mtx;
 
 public:
@@ -147,6 +150,19 @@ public:
         completionKind(completionKind) {}
   void setSortedCompletions(std::vector<Completion *> &&completions);
   ArrayRef<Completion *> getSortedCompletions();
+
+  /// Returns the completions worth filtering for \p filterText. If
+  /// \p filterText extends the filter text of the previous request and both
+  /// requests match in the same mode (\p fuzzy), only the completions that
+  /// matched the previous request are returned; both prefix and subsequence
+  /// matching can only shrink the match set as the pattern grows. Otherwise
+  /// all sorted completions are returned.
+  ArrayRef<Completion *> getFilterCandidates(StringRef filterText, bool fuzzy);
+
+  /// Records the match set of the current request so that the next request
+  /// may refine it via getFilterCandidates.
+  void setFilterMatches(StringRef filterText, bool fuzzy,
+                        std::vector<Completion *> &&matches);
   llvm::MemoryBuffer *getBuffer();
   ArrayRef<std::string> getCompilerArgs();
   CompletionKind getCompletionKind();
@@ -0,0 +1,461 @@
+//===--- sourcekitd-bench.cpp ---------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Replays a recorded editing session against sourcekitd and reports
+// per-request-kind latency percentiles, so that SourceKit latency
+// regressions can be caught before they hit developers.
+//
+// A session file contains one command per line:
+//
+//   open
+//   edit <offset> <length> <text>
+//   complete <offset>
+//   cursor-info <offset>
+//
+// Lines starting with '#' are comments.  Edit text may use '\n', '\t' and
+// '\\' escapes; offsets are byte offsets into the current document.  The
+// syntax map and structure are requested on every open and edit, so their
+// cost is part of those request kinds, matching what an editor pays per
+// keystroke.  Semantic token updates are delivered asynchronously by the
+// service and are not measured here.
+//
+//===----------------------------------------------------------------------===//
+
+#include "sourcekitd/sourcekitd.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+// FIXME: Platform compatibility.
+#include <dispatch/dispatch.h>
+
+using namespace llvm;
+
+namespace {
+struct BenchOptions {
+  StringRef SourceFile;
+  StringRef SessionFile;
+  StringRef OutputFile;
+  unsigned Iterations = 10;
+  unsigned WarmupIterations = 1;
+  ArrayRef<const char *> CompilerArgs;
+};
+
+enum class CommandKind {
+  Open,
+  Edit,
+  Complete,
+  CursorInfo,
+};
+
+struct SessionCommand {
+  CommandKind Kind;
+  unsigned Offset = 0;
+  unsigned Length = 0;
+  std::string Text;
+};
+} // anonymous namespace
+
+static sourcekitd_uid_t KeyRequest;
+static sourcekitd_uid_t KeyCompilerArgs;
+static sourcekitd_uid_t KeyOffset;
+static sourcekitd_uid_t KeyLength;
+static sourcekitd_uid_t KeySourceFile;
+static sourcekitd_uid_t KeySourceText;
+static sourcekitd_uid_t KeyName;
+static sourcekitd_uid_t KeyEnableSyntaxMap;
+static sourcekitd_uid_t KeyEnableSubStructure;
+
+static sourcekitd_uid_t RequestEditorOpen;
+static sourcekitd_uid_t RequestEditorClose;
+static sourcekitd_uid_t RequestEditorReplaceText;
+static sourcekitd_uid_t RequestCodeComplete;
+static sourcekitd_uid_t RequestCursorInfo;
+
+static void initializeRequestUIDs() {
+  KeyRequest = sourcekitd_uid_get_from_cstr("key.request");
+  KeyCompilerArgs = sourcekitd_uid_get_from_cstr("key.compilerargs");
+  KeyOffset = sourcekitd_uid_get_from_cstr("key.offset");
+  KeyLength = sourcekitd_uid_get_from_cstr("key.length");
+  KeySourceFile = sourcekitd_uid_get_from_cstr("key.sourcefile");
+  KeySourceText = sourcekitd_uid_get_from_cstr("key.sourcetext");
+  KeyName = sourcekitd_uid_get_from_cstr("key.name");
+  KeyEnableSyntaxMap = sourcekitd_uid_get_from_cstr("key.enablesyntaxmap");
+  KeyEnableSubStructure =
+      sourcekitd_uid_get_from_cstr("key.enablesubstructure");
+
+  RequestEditorOpen =
+      sourcekitd_uid_get_from_cstr("source.request.editor.open");
+  RequestEditorClose =
+      sourcekitd_uid_get_from_cstr("source.request.editor.close");
+  RequestEditorReplaceText =
+      sourcekitd_uid_get_from_cstr("source.request.editor.replacetext");
+  RequestCodeComplete =
+      sourcekitd_uid_get_from_cstr("source.request.codecomplete");
+  RequestCursorInfo =
+      sourcekitd_uid_get_from_cstr("source.request.cursorinfo");
+}
+
+static StringRef getCommandKindName(CommandKind Kind) {
+  switch (Kind) {
+  case CommandKind::Open: return "open";
+  case CommandKind::Edit: return "edit";
+  case CommandKind::Complete: return "complete";
+  case CommandKind::CursorInfo: return "cursor-info";
+  }
+}
+
+// Returns false and sets 'error' on failure.
+static bool parseOptions(ArrayRef<const char *> Args, BenchOptions &Options,
+                         std::string &Error) {
+  for (unsigned i = 0; i < Args.size(); ++i) {
+    StringRef Opt, Value;
+    std::tie(Opt, Value) = StringRef(Args[i]).split('=');
+    if (Opt == "--") {
+      Options.CompilerArgs = Args.slice(i + 1);
+      break;
+    }
+    if (!Opt.startswith("-")) {
+      Options.SourceFile = Args[i];
+      continue;
+    }
+    Opt = Opt.ltrim("-");
+
+    if (Opt == "session") {
+      Options.SessionFile = Value;
+    } else if (Opt == "o") {
+      Options.OutputFile = Value;
+    } else if (Opt == "iterations") {
+      if (Value.getAsInteger(10, Options.Iterations)) {
+        Error = "expected integer for -iterations=";
+        return false;
+      }
+    } else if (Opt == "warmup") {
+      if (Value.getAsInteger(10, Options.WarmupIterations)) {
+        Error = "expected integer for -warmup=";
+        return false;
+      }
+    } else {
+      Error = std::string("unrecognized option '") + Args[i] + "'";
+      return false;
+    }
+  }
+
+  if (Options.SourceFile.empty()) {
+    Error = "missing <source-file>";
+    return false;
+  }
+  if (Options.SessionFile.empty()) {
+    Error = "missing -session=<session-file>";
+    return false;
+  }
+  return true;
+}
+
+static std::string unescapeText(StringRef Text) {
+  std::string Result;
+  Result.reserve(Text.size());
+  for (unsigned i = 0, e = Text.size(); i != e; ++i) {
+    if (Text[i] == '\\' && i + 1 != e) {
+      switch (Text[++i]) {
+      case 'n': Result += '\n'; break;
+      case 't': Result += '\t'; break;
+      case '\\': Result += '\\'; break;
+      default: Result += Text[i]; break;
+      }
+    } else {
+      Result += Text[i];
+    }
+  }
+  return Result;
+}
+
+// Returns false and sets 'error' on failure.
+static bool parseSessionFile(StringRef Filename,
+                             std::vector<SessionCommand> &Commands,
+                             std::string &Error) {
+  auto FileBufOrErr = MemoryBuffer::getFile(Filename);
+  if (!FileBufOrErr) {
+    Error = std::string("failed to open '") + Filename.str() + "'";
+    return false;
+  }
+
+  unsigned LineNo = 0;
+  SmallVector<StringRef, 64> Lines;
+  FileBufOrErr.get()->getBuffer().split(Lines, '\n');
+  for (StringRef Line : Lines) {
+    ++LineNo;
+    // Only trim the left side; trailing whitespace may be part of escaped
+    // edit text.
+    Line = Line.rtrim("\r").ltrim(" \t");
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+
+    StringRef Verb, Rest;
+    std::tie(Verb, Rest) = Line.split(' ');
+
+    SessionCommand Command;
+    Optional<CommandKind> Kind =
+        StringSwitch<Optional<CommandKind>>(Verb)
+            .Case("open", CommandKind::Open)
+            .Case("edit", CommandKind::Edit)
+            .Case("complete", CommandKind::Complete)
+            .Case("cursor-info", CommandKind::CursorInfo)
+            .Default(None);
+    if (!Kind.hasValue()) {
+      Error = (Twine("unknown command '") + Verb + "' at line " +
+               Twine(LineNo)).str();
+      return false;
+    }
+    Command.Kind = Kind.getValue();
+
+    if (Command.Kind != CommandKind::Open) {
+      StringRef OffsetStr;
+      std::tie(OffsetStr, Rest) = Rest.ltrim(" \t").split(' ');
+      if (OffsetStr.getAsInteger(10, Command.Offset)) {
+        Error = (Twine("expected offset at line ") + Twine(LineNo)).str();
+        return false;
+      }
+    }
+    if (Command.Kind == CommandKind::Edit) {
+      StringRef LengthStr;
+      std::tie(LengthStr, Rest) = Rest.ltrim(" \t").split(' ');
+      if (LengthStr.getAsInteger(10, Command.Length)) {
+        Error = (Twine("expected length at line ") + Twine(LineNo)).str();
+        return false;
+      }
+      Command.Text = unescapeText(Rest);
+    }
+    Commands.push_back(std::move(Command));
+  }
+  return true;
+}
+
+static sourcekitd_object_t
+createCompilerArgs(const BenchOptions &Options) {
+  sourcekitd_object_t Args =
+      sourcekitd_request_array_create(nullptr, 0);
+  if (Options.CompilerArgs.empty()) {
+    sourcekitd_request_array_set_string(Args, SOURCEKITD_ARRAY_APPEND,
+                                        Options.SourceFile.str().c_str());
+  } else {
+    for (const char *Arg : Options.CompilerArgs)
+      sourcekitd_request_array_set_string(Args, SOURCEKITD_ARRAY_APPEND, Arg);
+  }
+  return Args;
+}
+
+static sourcekitd_object_t
+createRequest(const SessionCommand &Command, const BenchOptions &Options,
+              sourcekitd_object_t CompilerArgs) {
+  sourcekitd_object_t Req =
+      sourcekitd_request_dictionary_create(nullptr, nullptr, 0);
+  std::string SourceFile = Options.SourceFile.str();
+
+  switch (Command.Kind) {
+  case CommandKind::Open:
+    sourcekitd_request_dictionary_set_uid(Req, KeyRequest, RequestEditorOpen);
+    sourcekitd_request_dictionary_set_string(Req, KeyName, SourceFile.c_str());
+    sourcekitd_request_dictionary_set_string(Req, KeySourceFile,
+                                             SourceFile.c_str());
+    sourcekitd_request_dictionary_set_int64(Req, KeyEnableSyntaxMap, true);
+    sourcekitd_request_dictionary_set_int64(Req, KeyEnableSubStructure, true);
+    break;
+
+  case CommandKind::Edit:
+    sourcekitd_request_dictionary_set_uid(Req, KeyRequest,
+                                          RequestEditorReplaceText);
+    sourcekitd_request_dictionary_set_string(Req, KeyName, SourceFile.c_str());
+    sourcekitd_request_dictionary_set_int64(Req, KeyOffset, Command.Offset);
+    sourcekitd_request_dictionary_set_int64(Req, KeyLength, Command.Length);
+    sourcekitd_request_dictionary_set_string(Req, KeySourceText,
+                                             Command.Text.c_str());
+    break;
+
+  case CommandKind::Complete:
+    sourcekitd_request_dictionary_set_uid(Req, KeyRequest, RequestCodeComplete);
+    sourcekitd_request_dictionary_set_string(Req, KeySourceFile,
+                                             SourceFile.c_str());
+    sourcekitd_request_dictionary_set_int64(Req, KeyOffset, Command.Offset);
+    sourcekitd_request_dictionary_set_value(Req, KeyCompilerArgs,
+                                            CompilerArgs);
+    break;
+
+  case CommandKind::CursorInfo:
+    sourcekitd_request_dictionary_set_uid(Req, KeyRequest, RequestCursorInfo);
+    sourcekitd_request_dictionary_set_string(Req, KeySourceFile,
+                                             SourceFile.c_str());
+    sourcekitd_request_dictionary_set_int64(Req, KeyOffset, Command.Offset);
+    sourcekitd_request_dictionary_set_value(Req, KeyCompilerArgs,
+                                            CompilerArgs);
+    break;
+  }
+  return Req;
+}
+
+/// Closes the editor document so that the next iteration's 'open' starts
+/// from the same state.
+static void closeDocument(const BenchOptions &Options) {
+  sourcekitd_object_t Req =
+      sourcekitd_request_dictionary_create(nullptr, nullptr, 0);
+  sourcekitd_request_dictionary_set_uid(Req, KeyRequest, RequestEditorClose);
+  sourcekitd_request_dictionary_set_string(Req, KeyName,
+                                           Options.SourceFile.str().c_str());
+  sourcekitd_response_t Resp = sourcekitd_send_request_sync(Req);
+  sourcekitd_response_dispose(Resp);
+  sourcekitd_request_release(Req);
+}
+
+/// Replays the session once, appending per-command latencies in
+/// milliseconds to \p Latencies when \p Record is set.  Returns false if a
+/// request failed.
+static bool replaySession(const std::vector<SessionCommand> &Commands,
+                          const BenchOptions &Options,
+                          sourcekitd_object_t CompilerArgs, bool Record,
+                          std::map<CommandKind, std::vector<double>> &Latencies) {
+  for (const SessionCommand &Command : Commands) {
+    sourcekitd_object_t Req = createRequest(Command, Options, CompilerArgs);
+
+    auto StartTime = std::chrono::steady_clock::now();
+    sourcekitd_response_t Resp = sourcekitd_send_request_sync(Req);
+    auto EndTime = std::chrono::steady_clock::now();
+
+    bool IsError = sourcekitd_response_is_error(Resp);
+    if (IsError)
+      sourcekitd_response_description_dump(Resp);
+    sourcekitd_response_dispose(Resp);
+    sourcekitd_request_release(Req);
+    if (IsError)
+      return false;
+
+    if (Record) {
+      double Ms = std::chrono::duration<double, std::milli>(
+          EndTime - StartTime).count();
+      Latencies[Command.Kind].push_back(Ms);
+    }
+  }
+  closeDocument(Options);
+  return true;
+}
+
+/// Returns the \p Percentile (in [0,100]) of the sorted sample vector
+/// \p Sorted using the nearest-rank method.
+static double getPercentile(const std::vector<double> &Sorted,
+                            double Percentile) {
+  assert(!Sorted.empty());
+  size_t Index = (size_t)((Percentile / 100.0) * Sorted.size());
+  if (Index > 0)
+    --Index;
+  return Sorted[Index];
+}
+
+static void reportResults(std::map<CommandKind, std::vector<double>> &Latencies,
+                          const BenchOptions &Options) {
+  outs() << "request         count    p50 (ms)    p95 (ms)    max (ms)\n";
+
+  std::string CSV;
+  raw_string_ostream CSVOS(CSV);
+  CSVOS << "request,count,p50_ms,p95_ms,max_ms\n";
+  for (auto &Entry : Latencies) {
+    std::vector<double> &Samples = Entry.second;
+    std::sort(Samples.begin(), Samples.end());
+    double P50 = getPercentile(Samples, 50);
+    double P95 = getPercentile(Samples, 95);
+    double Max = Samples.back();
+
+    outs() << format("%-15s %5u %11.3f %11.3f %11.3f\n",
+                     getCommandKindName(Entry.first).str().c_str(),
+                     (unsigned)Samples.size(), P50, P95, Max);
+    CSVOS << getCommandKindName(Entry.first) << ',' << Samples.size() << ','
+          << format("%.3f", P50) << ',' << format("%.3f", P95) << ','
+          << format("%.3f", Max) << '\n';
+  }
+  CSVOS.flush();
+
+  if (!Options.OutputFile.empty()) {
+    std::error_code EC;
+    raw_fd_ostream OS(Options.OutputFile, EC, sys::fs::F_None);
+    if (EC) {
+      errs() << "error: failed to write '" << Options.OutputFile
+             << "': " << EC.message() << '\n';
+      return;
+    }
+    OS << CSV;
+  }
+}
+
+static int skt_main(int argc, const char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+
+  BenchOptions Options;
+  std::string Error;
+  if (!parseOptions(makeArrayRef(argv + 1, argc - 1), Options, Error)) {
+    errs() << "error: " << Error << '\n'
+           << "usage: sourcekitd-bench -session=<session-file> "
+              "[-iterations=N] [-warmup=N] [-o=<results.csv>] "
+              "<source-file> [-- <compiler-args>]\n";
+    return 1;
+  }
+
+  std::vector<SessionCommand> Commands;
+  if (!parseSessionFile(Options.SessionFile, Commands, Error)) {
+    errs() << "error: " << Error << '\n';
+    return 1;
+  }
+  if (Commands.empty()) {
+    errs() << "error: session file contains no commands\n";
+    return 1;
+  }
+
+  sourcekitd_initialize();
+  initializeRequestUIDs();
+  sourcekitd_object_t CompilerArgs = createCompilerArgs(Options);
+
+  std::map<CommandKind, std::vector<double>> Latencies;
+  bool Failed = false;
+  for (unsigned i = 0; i != Options.WarmupIterations && !Failed; ++i)
+    Failed = !replaySession(Commands, Options, CompilerArgs,
+                            /*Record=*/false, Latencies);
+  for (unsigned i = 0; i != Options.Iterations && !Failed; ++i)
+    Failed = !replaySession(Commands, Options, CompilerArgs,
+                            /*Record=*/true, Latencies);
+
+  if (!Failed)
+    reportResults(Latencies, Options);
+
+  sourcekitd_request_release(CompilerArgs);
+  sourcekitd_shutdown();
+  return Failed ? 1 : 0;
+}
+
+int main(int argc, const char **argv) {
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+    int ret = skt_main(argc, argv);
+    exit(ret);
+  });
+
+  dispatch_main();
+}
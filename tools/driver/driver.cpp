@@ -52,6 +52,10 @@ std::string getExecutablePath(const char *FirstArg) {
 extern int frontend_main(ArrayRef<const char *> Args, const char *Argv0,
                          void *MainAddr);
 
+/// Run a resident frontend daemon serving invocations over a Unix socket.
+extern int frontend_daemon_main(ArrayRef<const char *> Args, const char *Argv0,
+                                void *MainAddr);
+
 /// Run 'swift-autolink-extract'.
 extern int autolink_extract_main(ArrayRef<const char *> Args, const char *Argv0,
                                  void *MainAddr);
@@ -157,6 +161,11 @@ int main(int argc_, const char **argv_) {
                                               argv.data()+argv.size()),
                            argv[0], (void *)(intptr_t)getExecutablePath);
     }
+    if (FirstArg == "-frontend-daemon") {
+      return frontend_daemon_main(llvm::makeArrayRef(argv.data()+2,
+                                                     argv.data()+argv.size()),
+                                  argv[0], (void *)(intptr_t)getExecutablePath);
+    }
     if (FirstArg == "-modulewrap") {
       return modulewrap_main(llvm::makeArrayRef(argv.data()+2,
                                                 argv.data()+argv.size()),
@@ -188,6 +197,18 @@ int main(int argc_, const char **argv_) {
     return 1;
 
   if (C) {
+    // Allow frontend jobs to be run as threads in this process if the
+    // compilation asks for it. Jobs for any other tool (or any other copy of
+    // the driver) still run as subprocesses.
+    C->setInProcessExecutor([&](const char *ExecPath,
+                                ArrayRef<const char *> TaskArgs)
+                                -> llvm::Optional<int> {
+      if (Path != ExecPath || TaskArgs.empty() ||
+          StringRef(TaskArgs.front()) != "-frontend")
+        return llvm::None;
+      return frontend_main(TaskArgs.slice(1), argv[0],
+                           (void *)(intptr_t)getExecutablePath);
+    });
     return C->performJobs();
   }
 
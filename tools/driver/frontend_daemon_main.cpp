@@ -0,0 +1,197 @@
+//===-- frontend_daemon_main.cpp - Resident Frontend Daemon ---------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the entry point for 'swift -frontend-daemon', a resident process
+// which accepts frontend invocations over a Unix domain socket and runs them
+// in-process. Clients connect, send a frontend argument vector, and receive
+// the frontend's exit code; the daemon's output streams are redirected to the
+// client connection for the duration of the invocation.
+//
+// A resident frontend amortizes process startup and LLVM initialization
+// across an entire edit-compile cycle. Keeping deserialized module state warm
+// between invocations is planned to build on this entry point.
+//
+// The wire protocol is intentionally trivial: the client sends each argument
+// as a NUL-terminated string and finishes with an empty argument; the daemon
+// replies with the exit code formatted as a NUL-terminated decimal string.
+// An empty argument vector asks the daemon to shut down.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/raw_ostream.h"
+
+#if LLVM_ON_UNIX
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using namespace swift;
+
+extern int frontend_main(ArrayRef<const char *> Args, const char *Argv0,
+                         void *MainAddr);
+
+namespace {
+
+/// Reads NUL-terminated arguments from \p fd until an empty argument is seen.
+///
+/// \returns false if the connection was closed or an I/O error occurred
+/// before the argument vector was complete.
+static bool readArguments(int fd, std::vector<std::string> &args) {
+  std::string current;
+  char buffer[4096];
+
+  while (true) {
+    ssize_t numRead = ::read(fd, buffer, sizeof(buffer));
+    if (numRead < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    if (numRead == 0)
+      return false;
+
+    for (ssize_t i = 0; i < numRead; ++i) {
+      if (buffer[i] != '\0') {
+        current.push_back(buffer[i]);
+        continue;
+      }
+      if (current.empty())
+        return true;
+      args.push_back(current);
+      current.clear();
+    }
+  }
+}
+
+static bool writeAll(int fd, StringRef data) {
+  while (!data.empty()) {
+    ssize_t numWritten = ::write(fd, data.data(), data.size());
+    if (numWritten < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data = data.substr(numWritten);
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int frontend_daemon_main(ArrayRef<const char *> Args, const char *Argv0,
+                         void *MainAddr) {
+  if (Args.size() != 1) {
+    llvm::errs() << "error: -frontend-daemon expects a single socket path\n";
+    return 2;
+  }
+  StringRef SocketPath = Args.front();
+
+  sockaddr_un Address;
+  if (SocketPath.size() >= sizeof(Address.sun_path)) {
+    llvm::errs() << "error: socket path is too long: " << SocketPath << "\n";
+    return 2;
+  }
+  memset(&Address, 0, sizeof(Address));
+  Address.sun_family = AF_UNIX;
+  memcpy(Address.sun_path, SocketPath.data(), SocketPath.size());
+
+  int ListenFD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (ListenFD < 0) {
+    llvm::errs() << "error: unable to create socket: " << strerror(errno)
+                 << "\n";
+    return 2;
+  }
+
+  // Replace any socket left over from a previous daemon.
+  (void)::unlink(Address.sun_path);
+
+  if (::bind(ListenFD, reinterpret_cast<sockaddr *>(&Address),
+             sizeof(Address)) < 0 ||
+      ::listen(ListenFD, /*backlog=*/16) < 0) {
+    llvm::errs() << "error: unable to listen on " << SocketPath << ": "
+                 << strerror(errno) << "\n";
+    ::close(ListenFD);
+    return 2;
+  }
+
+  int SavedStdout = ::dup(STDOUT_FILENO);
+  int SavedStderr = ::dup(STDERR_FILENO);
+
+  bool ShuttingDown = false;
+  while (!ShuttingDown) {
+    int ClientFD = ::accept(ListenFD, nullptr, nullptr);
+    if (ClientFD < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    std::vector<std::string> StringArgs;
+    if (!readArguments(ClientFD, StringArgs)) {
+      ::close(ClientFD);
+      continue;
+    }
+
+    if (StringArgs.empty()) {
+      ShuttingDown = true;
+      (void)writeAll(ClientFD, StringRef("0", 2));
+      ::close(ClientFD);
+      break;
+    }
+
+    SmallVector<const char *, 32> FrontendArgs;
+    for (auto &arg : StringArgs)
+      FrontendArgs.push_back(arg.c_str());
+
+    // Route the frontend's output to the client for the duration of the
+    // invocation. Invocations are handled serially, so this is safe.
+    ::dup2(ClientFD, STDOUT_FILENO);
+    ::dup2(ClientFD, STDERR_FILENO);
+
+    int ReturnCode = frontend_main(FrontendArgs, Argv0, MainAddr);
+
+    llvm::outs().flush();
+    llvm::errs().flush();
+    ::dup2(SavedStdout, STDOUT_FILENO);
+    ::dup2(SavedStderr, STDERR_FILENO);
+
+    std::string Response = std::to_string(ReturnCode);
+    (void)writeAll(ClientFD, StringRef(Response.data(), Response.size() + 1));
+    ::close(ClientFD);
+  }
+
+  ::close(SavedStdout);
+  ::close(SavedStderr);
+  ::close(ListenFD);
+  (void)::unlink(Address.sun_path);
+  return 0;
+}
+
+#else // !LLVM_ON_UNIX
+
+int frontend_daemon_main(llvm::ArrayRef<const char *> Args, const char *Argv0,
+                         void *MainAddr) {
+  llvm::errs() << "error: -frontend-daemon is not supported on this "
+                  "platform\n";
+  return 2;
+}
+
+#endif // LLVM_ON_UNIX
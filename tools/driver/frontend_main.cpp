@@ -28,11 +28,15 @@
 #include "swift/Basic/Fallthrough.h"
 #include "swift/Basic/FileSystem.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Basic/Timer.h"
+#include "swift/Basic/TraceEvents.h"
+#include "swift/ClangImporter/ClangImporter.h"
 #include "swift/Frontend/DiagnosticVerifier.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Frontend/PrintingDiagnosticConsumer.h"
 #include "swift/Frontend/SerializedDiagnosticConsumer.h"
+#include "swift/IDE/IndexData.h"
 #include "swift/Immediate/Immediate.h"
 #include "swift/Option/Options.h"
 #include "swift/PrintAsObjC/PrintAsObjC.h"
@@ -44,6 +48,7 @@
 #include "clang/Frontend/CompilerInstance.h"
 
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
@@ -54,9 +59,11 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/YAMLParser.h"
 
 #include <memory>
+#include <thread>
 #include <unordered_set>
 
 using namespace swift;
@@ -445,6 +452,28 @@ static bool emitReferenceDependencies(DiagnosticEngine &diags,
   return false;
 }
 
+/// Emits index data for the primary source file as a side effect of
+/// compilation.
+static bool emitIndexData(DiagnosticEngine &diags, SourceFile *SF,
+                          const FrontendOptions &opts) {
+  if (!SF) {
+    diags.diagnose(SourceLoc(), diag::emit_index_data_without_primary_file);
+    return true;
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream out(opts.IndexDataFilePath, EC, llvm::sys::fs::F_None);
+
+  if (out.has_error() || EC) {
+    diags.diagnose(SourceLoc(), diag::error_opening_output,
+                   opts.IndexDataFilePath, EC.message());
+    out.clear_error();
+    return true;
+  }
+
+  return ide::emitIndexData(*SF, out);
+}
+
 /// Writes SIL out to the given file.
 static bool writeSIL(SILModule &SM, Module *M, bool EmitVerboseSIL,
                      StringRef OutputFilename, bool SortSIL) {
@@ -595,6 +624,78 @@ private:
   }
 };
 
+/// Writes serialized module buffers to disk on a background thread so that
+/// the file I/O overlaps with whatever the frontend does next (most usefully
+/// IRGen). The destructor joins the thread and diagnoses any failures, so a
+/// writer declared on the stack is safe across all of performCompile's exit
+/// paths.
+///
+/// Each buffer is written to a unique temporary next to its destination and
+/// moved into place with moveFileIfDifferent, matching what the synchronous
+/// serialization path does.
+class BackgroundModuleWriter {
+  ASTContext &Context;
+  std::string ModulePath;
+  std::string DocPath;
+  std::unique_ptr<llvm::MemoryBuffer> ModuleBuffer;
+  std::unique_ptr<llvm::MemoryBuffer> DocBuffer;
+  std::error_code ModuleEC;
+  std::error_code DocEC;
+  std::thread Writer;
+
+  /// Writes \p buffer to \p path via a temporary file. Runs off the main
+  /// thread, so it must not touch the DiagnosticEngine; failures are
+  /// reported through the returned error code instead.
+  static std::error_code writeBuffer(StringRef path,
+                                     llvm::MemoryBuffer &buffer) {
+    namespace fs = llvm::sys::fs;
+    int fd;
+    llvm::SmallString<128> tmpPath;
+    if (std::error_code EC =
+            fs::createUniqueFile(path + "-%%%%%%%%.tmp", fd, tmpPath))
+      return EC;
+    {
+      llvm::raw_fd_ostream out(fd, /*shouldClose=*/true);
+      out.write(buffer.getBufferStart(), buffer.getBufferSize());
+      out.flush();
+      if (out.has_error()) {
+        out.clear_error();
+        fs::remove(tmpPath);
+        return std::make_error_code(std::errc::io_error);
+      }
+    }
+    std::error_code EC = swift::moveFileIfDifferent(tmpPath, path);
+    if (EC)
+      fs::remove(tmpPath);
+    return EC;
+  }
+
+public:
+  BackgroundModuleWriter(ASTContext &ctx, StringRef modulePath,
+                         StringRef docPath,
+                         std::unique_ptr<llvm::MemoryBuffer> moduleBuffer,
+                         std::unique_ptr<llvm::MemoryBuffer> docBuffer)
+      : Context(ctx), ModulePath(modulePath), DocPath(docPath),
+        ModuleBuffer(std::move(moduleBuffer)), DocBuffer(std::move(docBuffer)) {
+    Writer = std::thread([this] {
+      if (ModuleBuffer)
+        ModuleEC = writeBuffer(ModulePath, *ModuleBuffer);
+      if (DocBuffer)
+        DocEC = writeBuffer(DocPath, *DocBuffer);
+    });
+  }
+
+  ~BackgroundModuleWriter() {
+    Writer.join();
+    if (ModuleEC)
+      Context.Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                             ModulePath, ModuleEC.message());
+    if (DocEC)
+      Context.Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                             DocPath, DocEC.message());
+  }
+};
+
 } // anonymous namespace
 
 // This is a separate function so that it shows up in stack traces.
@@ -660,6 +761,15 @@ static bool performCompile(CompilerInstance &Instance,
     return performLLVM(IRGenOpts, Instance.getASTContext(), Module.get());
   }
 
+  // Precompiling a bridging header is handled entirely by the Clang
+  // importer; there is no Swift code to compile.
+  if (Action == FrontendOptions::EmitPCH) {
+    auto clangImporter = static_cast<ClangImporter *>(
+      Instance.getASTContext().getClangModuleLoader());
+    return clangImporter->emitBridgingPCH(Invocation.getInputFilenames()[0],
+                                          opts.getSingleOutputFilename());
+  }
+
   ReferencedNameTracker nameTracker;
   bool shouldTrackReferences = !opts.ReferenceDependenciesFilePath.empty();
   if (shouldTrackReferences)
@@ -723,6 +833,9 @@ static bool performCompile(CompilerInstance &Instance,
     emitReferenceDependencies(Context.Diags, Instance.getPrimarySourceFile(),
                               *Instance.getDependencyTracker(), opts);
 
+  if (!opts.IndexDataFilePath.empty())
+    (void)emitIndexData(Context.Diags, Instance.getPrimarySourceFile(), opts);
+
   if (Context.hadError())
     return true;
 
@@ -755,6 +868,10 @@ static bool performCompile(CompilerInstance &Instance,
       SM = performSILGeneration(*PrimaryFile, Invocation.getSILOptions(),
                                 None, opts.SILSerializeAll);
     } else {
+      // In whole-module mode all files are lowered directly into a single
+      // in-memory SILModule; SIL is never serialized and re-read within one
+      // invocation. Only the explicit .sib workflow round-trips SIL through
+      // the serializer, and that is inherently a cross-process hand-off.
       SM = performSILGeneration(Instance.getMainModule(), Invocation.getSILOptions(),
                                 opts.SILSerializeAll,
                                 true);
@@ -856,6 +973,11 @@ static bool performCompile(CompilerInstance &Instance,
     return false;
   }
 
+  // Declared before the serialization block so that its destructor (which
+  // joins the background write) runs on every exit path below, including the
+  // early returns for EmitSIL and Immediate mode.
+  std::unique_ptr<BackgroundModuleWriter> BackgroundWriter;
+
   if (!opts.ModuleOutputPath.empty() || !opts.ModuleDocOutputPath.empty()) {
     auto DC = PrimarySourceFile ? ModuleOrSourceFile(PrimarySourceFile) :
                                   Instance.getMainModule();
@@ -878,7 +1000,24 @@ static bool performCompile(CompilerInstance &Instance,
       serializationOpts.SerializeOptionsForDebugging =
           !moduleIsPublic || opts.AlwaysSerializeDebuggingOptions;
 
-      serialize(DC, serializationOpts, SM.get());
+      if (Action == FrontendOptions::EmitModuleOnly ||
+          StringRef(serializationOpts.OutputPath) == "-") {
+        // Nothing follows the serialization, so there's nothing to overlap
+        // the file writes with; take the simple synchronous path. (This also
+        // keeps the special handling of "-" for stdout in one place.)
+        serialize(DC, serializationOpts, SM.get());
+      } else {
+        // Serialize into memory on this thread (the serializer walks the AST
+        // and SIL module, which aren't safe to share), then let a background
+        // thread push the bytes to disk while we move on to IRGen.
+        std::unique_ptr<llvm::MemoryBuffer> moduleBuffer;
+        std::unique_ptr<llvm::MemoryBuffer> docBuffer;
+        serializeToBuffers(DC, serializationOpts, &moduleBuffer, &docBuffer,
+                           SM.get());
+        BackgroundWriter.reset(new BackgroundModuleWriter(
+            Context, serializationOpts.OutputPath, opts.ModuleDocOutputPath,
+            std::move(moduleBuffer), std::move(docBuffer)));
+      }
     }
 
     if (Action == FrontendOptions::EmitModuleOnly)
@@ -996,8 +1135,96 @@ static bool dumpAPI(Module *Mod, StringRef OutDir) {
   return false;
 }
 
+int frontend_main(ArrayRef<const char *> Args, const char *Argv0,
+                  void *MainAddr);
+
+/// Attempts to run \p Args as a batch of single-primary-file invocations.
+///
+/// The frontend pipeline operates on a single primary file, so an invocation
+/// listing several '-primary-file' arguments is split into one sub-invocation
+/// per primary, run sequentially within this process. Per-primary output
+/// options are distributed positionally: if such an option appears once per
+/// primary, the i-th occurrence goes to the i-th sub-invocation; if it
+/// appears at most once overall, it is passed through unchanged.
+///
+/// \returns the exit code of the batch if \p Args was a batch invocation,
+/// or llvm::None if it contains at most one primary file.
+static Optional<int> runAsBatch(ArrayRef<const char *> Args,
+                                const char *Argv0, void *MainAddr) {
+  SmallVector<unsigned, 8> primaryIndices;
+  for (unsigned i = 0, e = Args.size(); i + 1 < e; ++i)
+    if (StringRef(Args[i]) == "-primary-file")
+      primaryIndices.push_back(i);
+  if (primaryIndices.size() <= 1)
+    return None;
+
+  // Output options which name files specific to one primary.
+  static const char * const perPrimaryOpts[] = {
+    "-o",
+    "-emit-dependencies-path",
+    "-emit-reference-dependencies-path",
+    "-serialize-diagnostics-path",
+    "-emit-fixits-path",
+  };
+
+  auto countOccurrences = [&](StringRef opt) -> unsigned {
+    unsigned count = 0;
+    for (const char *arg : Args)
+      if (opt == arg)
+        ++count;
+    return count;
+  };
+
+  llvm::StringMap<bool> distributeOpt;
+  for (StringRef opt : perPrimaryOpts)
+    distributeOpt[opt] = countOccurrences(opt) == primaryIndices.size();
+
+  int result = 0;
+  for (unsigned primary = 0, numPrimaries = primaryIndices.size();
+       primary < numPrimaries; ++primary) {
+    SmallVector<const char *, 64> subArgs;
+    llvm::StringMap<unsigned> seenOpt;
+
+    for (unsigned i = 0, e = Args.size(); i < e; ++i) {
+      StringRef arg = Args[i];
+
+      if (arg == "-primary-file") {
+        // Keep only this sub-invocation's primary marker; the file itself
+        // remains an input to every sub-invocation.
+        if (i == primaryIndices[primary])
+          subArgs.push_back(Args[i]);
+        subArgs.push_back(Args[++i]);
+        continue;
+      }
+
+      auto distribute = distributeOpt.find(arg);
+      if (distribute != distributeOpt.end() && distribute->second) {
+        unsigned occurrence = seenOpt[arg]++;
+        if (occurrence == primary) {
+          subArgs.push_back(Args[i]);
+          subArgs.push_back(Args[i + 1]);
+        }
+        ++i;
+        continue;
+      }
+
+      subArgs.push_back(Args[i]);
+    }
+
+    int subResult = frontend_main(subArgs, Argv0, MainAddr);
+    if (subResult != 0 && result == 0)
+      result = subResult;
+  }
+
+  return result;
+}
+
 int frontend_main(ArrayRef<const char *>Args,
                   const char *Argv0, void *MainAddr) {
+  // A batch invocation compiles several primary files in one process.
+  if (auto batchResult = runAsBatch(Args, Argv0, MainAddr))
+    return batchResult.getValue();
+
   llvm::InitializeAllTargets();
   llvm::InitializeAllTargetMCs();
   llvm::InitializeAllAsmPrinters();
@@ -1101,6 +1328,9 @@ int frontend_main(ArrayRef<const char *>Args,
   if (Invocation.getFrontendOptions().DebugTimeCompilation)
     SharedTimer::enableCompilationTimers();
 
+  if (!Invocation.getFrontendOptions().TraceEventsPath.empty())
+    enableTraceEvents();
+
   if (Invocation.getFrontendOptions().PrintStats) {
     llvm::EnableStatistics();
   }
@@ -1140,5 +1370,42 @@ int frontend_main(ArrayRef<const char *>Args,
     }
   }
 
+  const std::string &TraceEventsPath =
+      Invocation.getFrontendOptions().TraceEventsPath;
+  if (!TraceEventsPath.empty()) {
+    std::error_code EC;
+    llvm::raw_fd_ostream TraceOS(TraceEventsPath, EC,
+                                 llvm::sys::fs::F_None);
+    if (EC) {
+      Instance.getDiags().diagnose(SourceLoc(), diag::cannot_open_file,
+                                   TraceEventsPath, EC.message());
+      HadError = true;
+    } else {
+      writeTraceEvents(TraceOS);
+    }
+  }
+
+  const std::string &StatsOutputPath =
+      Invocation.getFrontendOptions().StatsOutputPath;
+  if (!StatsOutputPath.empty()) {
+    std::error_code EC;
+    llvm::raw_fd_ostream StatsOS(StatsOutputPath, EC,
+                                 llvm::sys::fs::F_None);
+    if (EC) {
+      Instance.getDiags().diagnose(SourceLoc(), diag::cannot_open_file,
+                                   StatsOutputPath, EC.message());
+      HadError = true;
+    } else {
+      // Identify the invocation by its primary input if it has one, and by
+      // the module being built otherwise.
+      StringRef MainInput = Invocation.getFrontendOptions().ModuleName;
+      if (auto PrimaryInput = Invocation.getFrontendOptions().PrimaryInput)
+        if (PrimaryInput->isFilename())
+          MainInput = Invocation.getFrontendOptions()
+                          .InputFilenames[PrimaryInput->Index];
+      writeCompilationCounters(StatsOS, MainInput);
+    }
+  }
+
   return (HadError ? 1 : ReturnValue);
 }
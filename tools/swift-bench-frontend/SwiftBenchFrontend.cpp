@@ -0,0 +1,268 @@
+//===--- SwiftBenchFrontend.cpp - Compile-time benchmark harness ----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Times frontend phases over a corpus of Swift inputs, with warmup
+// iterations and variance reporting, and optionally compares the results
+// against a recorded baseline so compile-time regressions fail the build
+// instead of landing silently. The corpus lives in benchmark/frontend.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Subsystems.h"
+#include "swift/Basic/LLVMInitialize.h"
+#include "swift/Frontend/Frontend.h"
+#include "swift/Frontend/PrintingDiagnosticConsumer.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace swift;
+
+static llvm::cl::list<std::string>
+InputFilenames(llvm::cl::desc("input files"), llvm::cl::Positional,
+               llvm::cl::OneOrMore);
+
+static llvm::cl::opt<unsigned>
+NumIterations("iterations", llvm::cl::init(5),
+              llvm::cl::desc("Number of measured iterations per input"));
+
+static llvm::cl::opt<unsigned>
+NumWarmupIterations("warmup", llvm::cl::init(1),
+                    llvm::cl::desc("Number of unmeasured warmup iterations"));
+
+static llvm::cl::opt<std::string>
+OutputFilename("o", llvm::cl::desc("Write results as CSV to this file"));
+
+static llvm::cl::opt<std::string>
+BaselinePath("baseline",
+             llvm::cl::desc("CSV of previous results to compare against"));
+
+static llvm::cl::opt<double>
+MaxRegressionPercent("max-regression", llvm::cl::init(5.0),
+                     llvm::cl::desc("Fail if a mean exceeds the baseline by "
+                                    "more than this percentage"));
+
+static llvm::cl::list<std::string>
+ImportPaths("I", llvm::cl::desc("add a directory to the import search path"));
+
+static llvm::cl::opt<std::string>
+ModuleCachePath("module-cache-path", llvm::cl::desc("Clang module cache path"));
+
+static llvm::cl::opt<std::string>
+ResourceDir("resource-dir",
+            llvm::cl::desc("The directory that holds the compiler resource files"));
+
+static llvm::cl::opt<std::string>
+SDKPath("sdk", llvm::cl::desc("The path to the SDK for use with the clang "
+                              "importer."),
+        llvm::cl::init(""));
+
+static llvm::cl::opt<std::string>
+Triple("target", llvm::cl::desc("target triple"));
+
+// This function isn't referenced outside its translation unit, but it
+// can't use the "static" keyword because its address is used for
+// getMainExecutable (since some platforms don't support taking the
+// address of main, and some platforms can't implement getMainExecutable
+// without being given the address of a function in the main executable).
+void anchorForGetMainExecutable() {}
+
+namespace {
+
+/// One measured compilation of an input.
+struct Sample {
+  uint64_t SemaUSec;
+  uint64_t SILGenUSec;
+};
+
+/// Mean and standard deviation of one phase over all iterations.
+struct PhaseResult {
+  double MeanUSec;
+  double StddevUSec;
+};
+
+} // end anonymous namespace
+
+static uint64_t elapsedUSec(std::chrono::steady_clock::time_point begin,
+                            std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin)
+      .count();
+}
+
+/// Compile \p inputPath through SILGen once, recording per-phase times.
+/// Returns false if the compilation failed.
+static bool runOnce(StringRef mainExecutablePath, StringRef inputPath,
+                    Sample &sample) {
+  CompilerInvocation Invocation;
+  Invocation.setMainExecutablePath(mainExecutablePath);
+  Invocation.setImportSearchPaths(ImportPaths);
+  if (!SDKPath.empty())
+    Invocation.setSDKPath(SDKPath);
+  if (!Triple.empty())
+    Invocation.setTargetTriple(Triple);
+  if (!ResourceDir.empty())
+    Invocation.setRuntimeResourcePath(ResourceDir);
+  Invocation.getClangImporterOptions().ModuleCachePath = ModuleCachePath;
+  Invocation.setModuleName("bench");
+  Invocation.setInputKind(InputFileKind::IFK_Swift);
+  Invocation.addInputFilename(inputPath);
+
+  CompilerInstance CI;
+  PrintingDiagnosticConsumer PrintDiags;
+  CI.addDiagnosticConsumer(&PrintDiags);
+  if (CI.setup(Invocation))
+    return false;
+
+  auto t0 = std::chrono::steady_clock::now();
+  CI.performSema();
+  auto t1 = std::chrono::steady_clock::now();
+  if (CI.getASTContext().hadError())
+    return false;
+
+  auto SILMod = performSILGeneration(CI.getMainModule(), CI.getSILOptions());
+  auto t2 = std::chrono::steady_clock::now();
+  if (CI.getASTContext().hadError())
+    return false;
+
+  sample.SemaUSec = elapsedUSec(t0, t1);
+  sample.SILGenUSec = elapsedUSec(t1, t2);
+  return true;
+}
+
+static PhaseResult summarize(ArrayRef<uint64_t> values) {
+  double sum = 0;
+  for (uint64_t value : values)
+    sum += value;
+  double mean = sum / values.size();
+
+  double sumSquares = 0;
+  for (uint64_t value : values)
+    sumSquares += (value - mean) * (value - mean);
+  double stddev =
+      values.size() > 1 ? std::sqrt(sumSquares / (values.size() - 1)) : 0;
+  return PhaseResult{mean, stddev};
+}
+
+static void reportPhase(llvm::raw_ostream &os, StringRef input,
+                        StringRef phase, const PhaseResult &result) {
+  double cv = result.MeanUSec ? 100.0 * result.StddevUSec / result.MeanUSec : 0;
+  os << llvm::sys::path::filename(input) << "," << phase << ","
+     << llvm::format("%.0f", result.MeanUSec) << ","
+     << llvm::format("%.0f", result.StddevUSec) << ","
+     << llvm::format("%.1f", cv) << "\n";
+}
+
+/// Load a results CSV written by this tool into (file,phase) -> mean.
+static bool loadBaseline(StringRef path,
+                         llvm::StringMap<double> &baseline) {
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(path);
+  if (!bufferOrErr) {
+    llvm::errs() << "error: cannot read baseline '" << path
+                 << "': " << bufferOrErr.getError().message() << "\n";
+    return false;
+  }
+  SmallVector<StringRef, 32> lines;
+  bufferOrErr.get()->getBuffer().split(lines, '\n');
+  for (StringRef line : lines) {
+    line = line.trim();
+    if (line.empty() || line.startswith("#"))
+      continue;
+    SmallVector<StringRef, 5> fields;
+    line.split(fields, ',');
+    if (fields.size() < 3)
+      continue;
+    double mean;
+    if (fields[2].getAsDouble(mean))
+      continue;
+    baseline[(fields[0] + "," + fields[1]).str()] = mean;
+  }
+  return true;
+}
+
+/// Compare one mean against the baseline; returns true on regression.
+static bool checkRegression(StringRef input, StringRef phase,
+                            const PhaseResult &result,
+                            const llvm::StringMap<double> &baseline) {
+  std::string key =
+      (llvm::sys::path::filename(input) + "," + phase).str();
+  auto known = baseline.find(key);
+  if (known == baseline.end())
+    return false;
+  double limit = known->second * (1.0 + MaxRegressionPercent / 100.0);
+  if (result.MeanUSec <= limit)
+    return false;
+  llvm::errs() << "regression: " << key << " took "
+               << llvm::format("%.0f", result.MeanUSec) << " usec, baseline "
+               << llvm::format("%.0f", known->second) << " usec (limit +"
+               << llvm::format("%.1f", MaxRegressionPercent.getValue())
+               << "%)\n";
+  return true;
+}
+
+int main(int argc, char **argv) {
+  INITIALIZE_LLVM(argc, argv);
+
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Swift frontend benchmark harness\n");
+
+  std::string mainExecutablePath = llvm::sys::fs::getMainExecutable(
+      argv[0], reinterpret_cast<void *>(&anchorForGetMainExecutable));
+
+  llvm::StringMap<double> baseline;
+  if (!BaselinePath.empty() && !loadBaseline(BaselinePath, baseline))
+    return 1;
+
+  std::unique_ptr<llvm::raw_fd_ostream> fileOS;
+  if (!OutputFilename.empty()) {
+    std::error_code EC;
+    fileOS.reset(
+        new llvm::raw_fd_ostream(OutputFilename, EC, llvm::sys::fs::F_None));
+    if (EC) {
+      llvm::errs() << "error: cannot open '" << OutputFilename
+                   << "': " << EC.message() << "\n";
+      return 1;
+    }
+  }
+  llvm::raw_ostream &os = fileOS ? *fileOS : llvm::outs();
+  os << "# input,phase,mean_usec,stddev_usec,cv_percent\n";
+
+  bool hadRegression = false;
+  for (const std::string &input : InputFilenames) {
+    std::vector<uint64_t> semaTimes, silGenTimes;
+    for (unsigned i = 0, e = NumWarmupIterations + NumIterations; i != e; ++i) {
+      Sample sample;
+      if (!runOnce(mainExecutablePath, input, sample)) {
+        llvm::errs() << "error: compilation of '" << input << "' failed\n";
+        return 1;
+      }
+      if (i < NumWarmupIterations)
+        continue;
+      semaTimes.push_back(sample.SemaUSec);
+      silGenTimes.push_back(sample.SILGenUSec);
+    }
+
+    PhaseResult sema = summarize(semaTimes);
+    PhaseResult silGen = summarize(silGenTimes);
+    reportPhase(os, input, "sema", sema);
+    reportPhase(os, input, "silgen", silGen);
+    hadRegression |= checkRegression(input, "sema", sema, baseline);
+    hadRegression |= checkRegression(input, "silgen", silGen, baseline);
+  }
+
+  return hadRegression ? 2 : 0;
+}
@@ -53,7 +53,8 @@ InputNames(llvm::cl::Positional, llvm::cl::desc("[mangled name...]"),
                llvm::cl::ZeroOrMore);
 
 static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
-                     const swift::Demangle::DemangleOptions &options) {
+                     const swift::Demangle::DemangleOptions &options,
+                     std::string &scratch) {
   bool hadLeadingUnderscore = false;
   if (name.startswith("__")) {
     hadLeadingUnderscore = true;
@@ -78,10 +79,11 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
     return;
   }
   if (!TreeOnly) {
-    std::string string = swift::Demangle::nodeToString(pointer, options);
+    scratch.clear();
+    swift::Demangle::nodeToString(pointer, scratch, options);
     if (!CompactMode)
       llvm::outs() << name << " ---> ";
-    llvm::outs() << (string.empty() ? name : llvm::StringRef(string));
+    llvm::outs() << (scratch.empty() ? name : llvm::StringRef(scratch));
   }
 }
 
@@ -103,6 +105,10 @@ int main(int argc, char **argv) {
   if (Simplified)
     options = swift::Demangle::DemangleOptions::SimplifiedUIDemangleOptions();
 
+  // Reused across symbols so that demangling a long list of symbols doesn't
+  // allocate a fresh output buffer per symbol.
+  std::string scratch;
+
   if (InputNames.empty()) {
     CompactMode = true;
     auto input = llvm::MemoryBuffer::getSTDIN();
@@ -117,14 +123,14 @@ int main(int argc, char **argv) {
     llvm::SmallVector<llvm::StringRef, 1> matches;
     while (maybeSymbol.match(inputContents, &matches)) {
       llvm::outs() << substrBefore(inputContents, matches.front());
-      demangle(llvm::outs(), matches.front(), options);
+      demangle(llvm::outs(), matches.front(), options, scratch);
       inputContents = substrAfter(inputContents, matches.front());
     }
     llvm::outs() << inputContents;
 
   } else {
     for (llvm::StringRef name : InputNames) {
-      demangle(llvm::outs(), name, options);
+      demangle(llvm::outs(), name, options, scratch);
       llvm::outs() << '\n';
     }
   }
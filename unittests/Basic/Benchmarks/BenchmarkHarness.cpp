@@ -0,0 +1,144 @@
+//===--- BenchmarkHarness.cpp - Microbenchmark driver ---------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "BenchmarkHarness.h"
+#include "swift/Basic/JSONSerialization.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace swift;
+using namespace swift::benchmark;
+
+static llvm::cl::opt<std::string>
+Filter("filter",
+       llvm::cl::desc("Only run benchmarks whose name contains this string"),
+       llvm::cl::value_desc("substring"));
+
+static llvm::cl::opt<std::string>
+JSONPath("json", llvm::cl::desc("Write the results as JSON to the given file"),
+         llvm::cl::value_desc("path"));
+
+static llvm::cl::opt<unsigned>
+MinTimeMS("min-time",
+          llvm::cl::desc("Minimum measurement time per benchmark, "
+                         "in milliseconds"),
+          llvm::cl::init(500));
+
+namespace {
+
+struct BenchmarkEntry {
+  StringRef Name;
+  BenchmarkFn Fn;
+};
+
+struct Result {
+  StringRef Name;
+  uint64_t Iterations;
+  uint64_t TotalNanos;
+
+  double nanosPerIteration() const {
+    return double(TotalNanos) / double(Iterations);
+  }
+};
+
+} // end anonymous namespace
+
+static std::vector<BenchmarkEntry> &getRegistry() {
+  static std::vector<BenchmarkEntry> Registry;
+  return Registry;
+}
+
+Registrar::Registrar(StringRef name, BenchmarkFn fn) {
+  getRegistry().push_back({name, fn});
+}
+
+/// Run one benchmark, growing the iteration count until the timing loop
+/// runs for at least the requested minimum time.
+static Result measure(const BenchmarkEntry &entry) {
+  auto minTime = std::chrono::milliseconds(MinTimeMS);
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations);
+    entry.Fn(state);
+    auto elapsed = state.getElapsed();
+    if (elapsed >= minTime)
+      return {entry.Name, iterations, uint64_t(elapsed.count())};
+
+    // Grow the iteration count aggressively while the measurement is far
+    // too short and the observed time is mostly noise.
+    iterations *= (elapsed * 16 < minTime) ? 16 : 2;
+  }
+}
+
+static void printResults(ArrayRef<Result> results, llvm::raw_ostream &out) {
+  size_t nameWidth = StringRef("benchmark").size();
+  for (const Result &result : results)
+    nameWidth = std::max(nameWidth, result.Name.size());
+
+  out << llvm::left_justify("benchmark", nameWidth)
+      << "    iterations       ns/iter\n";
+  for (const Result &result : results)
+    out << llvm::left_justify(result.Name, nameWidth)
+        << llvm::format("  %12llu", (unsigned long long)result.Iterations)
+        << llvm::format("  %12.2f", result.nanosPerIteration()) << '\n';
+}
+
+static void writeJSON(ArrayRef<Result> results, llvm::raw_ostream &out) {
+  json::Writer writer(out);
+  writer.beginArray();
+  for (const Result &result : results) {
+    writer.beginObject();
+    writer.attribute("name", result.Name);
+    writer.attribute("iterations", int64_t(result.Iterations));
+    writer.attribute("total_ns", int64_t(result.TotalNanos));
+    writer.attribute("ns_per_iteration", result.nanosPerIteration());
+    writer.endObject();
+  }
+  writer.endArray();
+  out << '\n';
+}
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Swift Basic microbenchmark driver\n");
+
+  std::vector<Result> results;
+  for (const BenchmarkEntry &entry : getRegistry()) {
+    if (!Filter.empty() && entry.Name.find(Filter) == StringRef::npos)
+      continue;
+    results.push_back(measure(entry));
+  }
+
+  // Registration order depends on link order; report alphabetically.
+  std::sort(results.begin(), results.end(),
+            [](const Result &a, const Result &b) { return a.Name < b.Name; });
+
+  printResults(results, llvm::outs());
+
+  if (!JSONPath.empty()) {
+    std::error_code EC;
+    llvm::raw_fd_ostream out(JSONPath, EC, llvm::sys::fs::F_None);
+    if (EC) {
+      llvm::errs() << "error opening '" << JSONPath << "': " << EC.message()
+                   << '\n';
+      return 1;
+    }
+    writeJSON(results, out);
+  }
+
+  return 0;
+}
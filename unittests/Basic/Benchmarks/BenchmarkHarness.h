@@ -0,0 +1,98 @@
+//===--- BenchmarkHarness.h - Microbenchmark timing loops -------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A small harness for microbenchmarking the data structures in lib/Basic.
+// Benchmarks are free functions registered with the SWIFT_BENCHMARK macro
+// and written as a timing loop:
+//
+//   SWIFT_BENCHMARK(InsertIntoMap) {
+//     while (state.keepRunning()) {
+//       // One iteration of the measured operation.
+//     }
+//   }
+//
+// Code before the loop is setup and is not measured.  The driver calibrates
+// the iteration count until every benchmark runs for a minimum wall time
+// and reports nanoseconds per iteration, either as a table on stdout or as
+// JSON for the benchmark regression tooling.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_UNITTESTS_BASIC_BENCHMARKS_BENCHMARKHARNESS_H
+#define SWIFT_UNITTESTS_BASIC_BENCHMARKS_BENCHMARKHARNESS_H
+
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/StringRef.h"
+#include <chrono>
+#include <cstdint>
+
+namespace swift {
+namespace benchmark {
+
+/// The state of a single timing run.  The clock starts on the first call to
+/// keepRunning() and stops when the configured iteration count is
+/// exhausted, so per-benchmark setup code is not measured.
+class State {
+  uint64_t NumIterations;
+  uint64_t Remaining;
+  std::chrono::steady_clock::time_point Start;
+  std::chrono::nanoseconds Elapsed;
+
+public:
+  explicit State(uint64_t numIterations)
+      : NumIterations(numIterations), Remaining(numIterations),
+        Elapsed(std::chrono::nanoseconds::zero()) {}
+
+  /// The condition of the timing loop.  Returns true while more iterations
+  /// should be run.
+  bool keepRunning() {
+    if (Remaining == NumIterations)
+      Start = std::chrono::steady_clock::now();
+    if (Remaining == 0) {
+      Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - Start);
+      return false;
+    }
+    --Remaining;
+    return true;
+  }
+
+  uint64_t getNumIterations() const { return NumIterations; }
+  std::chrono::nanoseconds getElapsed() const { return Elapsed; }
+};
+
+/// Prevent the compiler from optimizing away a computed value without
+/// inserting any measurable code.
+template <class T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+using BenchmarkFn = void (*)(State &);
+
+/// Adds a benchmark function to the global registry; use through the
+/// SWIFT_BENCHMARK macro.
+class Registrar {
+public:
+  Registrar(StringRef name, BenchmarkFn fn);
+};
+
+} // end namespace benchmark
+} // end namespace swift
+
+/// Define and register a benchmark function.  The function body follows the
+/// macro and receives a State named \c state.
+#define SWIFT_BENCHMARK(NAME)                                                  \
+  static void NAME(::swift::benchmark::State &state);                          \
+  static ::swift::benchmark::Registrar NAME##Registrar(#NAME, NAME);           \
+  static void NAME(::swift::benchmark::State &state)
+
+#endif // SWIFT_UNITTESTS_BASIC_BENCHMARKS_BENCHMARKHARNESS_H
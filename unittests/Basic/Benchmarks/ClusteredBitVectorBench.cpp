@@ -0,0 +1,79 @@
+//===--- ClusteredBitVectorBench.cpp - ClusteredBitVector timings ---------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// The dominant users of ClusteredBitVector are the spare-bits masks built
+// by type lowering in IRGen.  Most masks are small (a handful of fields of
+// at most a word each) and are built by appending chunks; enum layout then
+// combines and queries them.  The sizes below mirror that usage.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BenchmarkHarness.h"
+#include "swift/Basic/ClusteredBitVector.h"
+
+using namespace swift;
+using namespace swift::benchmark;
+
+/// Build a typical spare-bits mask: eight fields of one word each, with a
+/// few spare bits in some of them.
+SWIFT_BENCHMARK(ClusteredBitVectorBuildMask) {
+  while (state.keepRunning()) {
+    ClusteredBitVector mask;
+    for (unsigned i = 0; i != 8; ++i)
+      mask.add(64, (i & 1) ? 0xFF00000000000000ULL : 0);
+    doNotOptimize(mask.size());
+  }
+}
+
+/// Append one bit at a time, as when building an occupancy mask for a
+/// struct with many small fields.
+SWIFT_BENCHMARK(ClusteredBitVectorAppendSingleBits) {
+  while (state.keepRunning()) {
+    ClusteredBitVector mask;
+    for (unsigned i = 0; i != 256; ++i) {
+      if (i & 1)
+        mask.appendSetBits(1);
+      else
+        mask.appendClearBits(1);
+    }
+    doNotOptimize(mask.size());
+  }
+}
+
+/// Copy a mask and intersect it with another, as enum layout does when
+/// computing the common spare bits of the payload cases.
+SWIFT_BENCHMARK(ClusteredBitVectorCopyAndIntersect) {
+  ClusteredBitVector lhs, rhs;
+  for (unsigned i = 0; i != 8; ++i) {
+    lhs.add(64, 0xFF000000000000FFULL);
+    rhs.add(64, 0x00FF0000000000FFULL);
+  }
+  while (state.keepRunning()) {
+    ClusteredBitVector copy = lhs;
+    copy &= rhs;
+    doNotOptimize(copy.any());
+  }
+}
+
+/// Count and test the bits of a mask, as done when assigning spare bits to
+/// enum tags.
+SWIFT_BENCHMARK(ClusteredBitVectorCountAndTest) {
+  ClusteredBitVector mask;
+  for (unsigned i = 0; i != 8; ++i)
+    mask.add(64, 0xFF00000000000000ULL);
+  while (state.keepRunning()) {
+    size_t setBits = mask.count();
+    for (size_t i = 0, e = mask.size(); i != e; ++i)
+      setBits += mask[i];
+    doNotOptimize(setBits);
+  }
+}
@@ -0,0 +1,61 @@
+//===--- DemangleBench.cpp - Demangler timings ----------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Demangling shows up on hot paths in the debugger support and in
+// diagnostics.  The symbols below are taken from test/Demangle and span
+// the common shapes: methods on nested types, generic functions with
+// requirements, reabstraction thunks, witnesses and closures.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BenchmarkHarness.h"
+#include "swift/Basic/DemangleWrappers.h"
+
+using namespace swift;
+using namespace swift::benchmark;
+
+static const char *const MangledNames[] = {
+  "_TtuRxs8Runciblexs8FungiblerFxwxPS_5Mince",
+  "_TF21class_bound_protocols32class_bound_protocol_composition"
+      "FT1xPS_10ClassBoundS_13NotClassBound__PS0_S1__",
+  "_TFVCC6nested6AClass12AnotherClass7AStruct9aFunctionfT1aSi_S2_",
+  "_TTRGrXFo_iV18switch_abstraction1A_ix_XFo_dS0__ix_",
+  "_TFCF5types1gFT1bSb_T_L0_10Collection3zimfT_T_",
+  "_TFF17capture_promotion22test_capture_promotionFT_FT_SiU_FT_Si_promote0",
+  "_TFIVs8_Processi10_argumentsGSaSS_U_FT_GSaSS_",
+  "_TTWC13call_protocol1CS_1PS_FS1_3foofT_Si",
+  "_TPA__TTRXFo_oSSoSS_dSb_XFo_iSSiSS_dSb_31",
+  "_TtBv4Bi8_",
+};
+
+/// Demangle a batch of symbols to their printed form, as the debugger
+/// support does for each frame.
+SWIFT_BENCHMARK(DemangleSymbolsAsString) {
+  while (state.keepRunning()) {
+    for (const char *name : MangledNames) {
+      std::string result =
+          demangle_wrappers::demangleSymbolAsString(StringRef(name));
+      doNotOptimize(result.size());
+    }
+  }
+}
+
+/// Demangle to the node tree only, without printing, which is what callers
+/// that inspect specific components of a symbol do.
+SWIFT_BENCHMARK(DemangleSymbolsAsNode) {
+  while (state.keepRunning()) {
+    for (const char *name : MangledNames) {
+      auto node = demangle_wrappers::demangleSymbolAsNode(StringRef(name));
+      doNotOptimize(node.get());
+    }
+  }
+}
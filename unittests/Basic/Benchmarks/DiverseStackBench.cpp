@@ -0,0 +1,100 @@
+//===--- DiverseStackBench.cpp - DiverseStack timings ---------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// DiverseStack backs the SILGen cleanup stack: objects of a few different
+// sizes are pushed as scopes are entered, iterated when cleanups are
+// emitted, and popped as scopes are left.  Typical functions push tens of
+// cleanups with nesting depth well below that.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BenchmarkHarness.h"
+#include "swift/Basic/DiverseStack.h"
+
+using namespace swift;
+using namespace swift::benchmark;
+
+namespace {
+
+/// A stand-in for SILGen's Cleanup: a base class carrying its allocated
+/// size, with subclasses of several sizes.
+class Entry {
+  unsigned AllocatedSize;
+
+protected:
+  explicit Entry(unsigned allocatedSize) : AllocatedSize(allocatedSize) {}
+
+public:
+  unsigned allocated_size() const { return AllocatedSize; }
+  bool isActive() const { return AllocatedSize != 0; }
+};
+
+template <unsigned Padding> class SizedEntry : public Entry {
+  char Pad[Padding];
+
+public:
+  SizedEntry() : Entry(sizeof(SizedEntry)) { Pad[0] = 0; }
+};
+
+using SmallEntry = SizedEntry<8>;
+using MediumEntry = SizedEntry<24>;
+using LargeEntry = SizedEntry<56>;
+
+} // end anonymous namespace
+
+/// Push and pop a scope's worth of mixed-size entries, staying within the
+/// inline storage.
+SWIFT_BENCHMARK(DiverseStackPushPop) {
+  while (state.keepRunning()) {
+    DiverseStack<Entry, 128> stack;
+    for (unsigned i = 0; i != 8; ++i) {
+      stack.push<SmallEntry>();
+      stack.push<MediumEntry>();
+    }
+    while (!stack.empty())
+      stack.pop();
+    doNotOptimize(stack.empty());
+  }
+}
+
+/// Push enough entries to overflow the inline storage, as in functions
+/// with deeply nested scopes.
+SWIFT_BENCHMARK(DiverseStackPushPopOverflow) {
+  while (state.keepRunning()) {
+    DiverseStack<Entry, 128> stack;
+    for (unsigned i = 0; i != 32; ++i) {
+      stack.push<SmallEntry>();
+      stack.push<MediumEntry>();
+      stack.push<LargeEntry>();
+    }
+    while (!stack.empty())
+      stack.pop();
+    doNotOptimize(stack.empty());
+  }
+}
+
+/// Walk the stack without modifying it, as when searching for the
+/// innermost active cleanup.
+SWIFT_BENCHMARK(DiverseStackIterate) {
+  DiverseStack<Entry, 128> stack;
+  for (unsigned i = 0; i != 16; ++i) {
+    stack.push<SmallEntry>();
+    stack.push<MediumEntry>();
+    stack.push<LargeEntry>();
+  }
+  while (state.keepRunning()) {
+    unsigned active = 0;
+    for (const Entry &entry : stack)
+      active += entry.isActive();
+    doNotOptimize(active);
+  }
+}
@@ -0,0 +1,84 @@
+//===--- PrefixMapBench.cpp - PrefixMap timings ---------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// PrefixMap keys in the compiler are dominated by mangled names, which
+// share long common prefixes (module and context names) and diverge near
+// the end.  The synthetic key set below reproduces that shape: a few
+// hundred keys, each a context prefix followed by a short unique suffix.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BenchmarkHarness.h"
+#include "swift/Basic/PrefixMap.h"
+#include <string>
+#include <vector>
+
+using namespace swift;
+using namespace swift::benchmark;
+
+static ArrayRef<char> asArray(StringRef str) {
+  return ArrayRef<char>(str.begin(), str.end());
+}
+
+/// Build a mangled-name-like key set with shared prefixes.
+static const std::vector<std::string> &getKeys() {
+  static std::vector<std::string> Keys = [] {
+    const char *Contexts[] = {
+      "_TFC9benchmark12AnotherClass",
+      "_TFC9benchmark6AClass",
+      "_TFV9benchmark7AStruct",
+      "_TFO9benchmark6AnEnum",
+    };
+    const char *Members[] = {
+      "9aFunctionfT1aSi_Si", "9bFunctionfT1bSS_SS", "4initfT_S0_",
+      "7doThingfT1xSi1ySi_Si", "g8propertySi", "s8propertySi",
+    };
+    std::vector<std::string> keys;
+    for (const char *context : Contexts)
+      for (const char *member : Members)
+        for (unsigned i = 0; i != 24; ++i)
+          keys.push_back(std::string(context) + member + std::to_string(i));
+    return keys;
+  }();
+  return Keys;
+}
+
+/// Populate a map from an empty state, the pattern used when building
+/// per-module lookup structures.
+SWIFT_BENCHMARK(PrefixMapInsert) {
+  const auto &keys = getKeys();
+  while (state.keepRunning()) {
+    PrefixMap<char, unsigned> map;
+    unsigned value = 0;
+    for (const std::string &key : keys)
+      map.insert(asArray(key), value++);
+    doNotOptimize(map.empty());
+  }
+}
+
+/// Look up every key in a prebuilt map.
+SWIFT_BENCHMARK(PrefixMapFindPrefix) {
+  const auto &keys = getKeys();
+  PrefixMap<char, unsigned> map;
+  unsigned value = 0;
+  for (const std::string &key : keys)
+    map.insert(asArray(key), value++);
+
+  while (state.keepRunning()) {
+    unsigned found = 0;
+    for (const std::string &key : keys) {
+      auto result = map.findPrefix(asArray(key));
+      found += bool(result.first);
+    }
+    doNotOptimize(found);
+  }
+}
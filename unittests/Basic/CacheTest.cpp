@@ -0,0 +1,84 @@
+#include "swift/Basic/Cache.h"
+#include "gtest/gtest.h"
+
+using namespace swift::sys;
+
+namespace {
+
+/// A value that counts how many live copies of itself exist, so the tests
+/// can observe when the cache destroys its stored copy.
+struct TrackedValue {
+  static int LiveCount;
+
+  int Payload;
+
+  explicit TrackedValue(int Payload) : Payload(Payload) { ++LiveCount; }
+  TrackedValue(const TrackedValue &Other) : Payload(Other.Payload) {
+    ++LiveCount;
+  }
+  ~TrackedValue() { --LiveCount; }
+};
+
+int TrackedValue::LiveCount = 0;
+
+} // end anonymous namespace
+
+TEST(Cache, SetAndGet) {
+  Cache<int, int> TestCache("test");
+  EXPECT_FALSE(TestCache.get(1).hasValue());
+
+  TestCache.set(1, 10);
+  TestCache.set(2, 20);
+  ASSERT_TRUE(TestCache.get(1).hasValue());
+  EXPECT_EQ(10, *TestCache.get(1));
+  ASSERT_TRUE(TestCache.get(2).hasValue());
+  EXPECT_EQ(20, *TestCache.get(2));
+  EXPECT_FALSE(TestCache.get(3).hasValue());
+}
+
+TEST(Cache, ReplaceValue) {
+  Cache<int, int> TestCache("test");
+  TestCache.set(1, 10);
+  TestCache.set(1, 11);
+  ASSERT_TRUE(TestCache.get(1).hasValue());
+  EXPECT_EQ(11, *TestCache.get(1));
+}
+
+TEST(Cache, Remove) {
+  Cache<int, int> TestCache("test");
+  TestCache.set(1, 10);
+  TestCache.set(2, 20);
+
+  EXPECT_TRUE(TestCache.remove(1));
+  EXPECT_FALSE(TestCache.get(1).hasValue());
+  EXPECT_FALSE(TestCache.remove(1));
+  ASSERT_TRUE(TestCache.get(2).hasValue());
+  EXPECT_EQ(20, *TestCache.get(2));
+}
+
+TEST(Cache, Clear) {
+  Cache<int, int> TestCache("test");
+  TestCache.set(1, 10);
+  TestCache.set(2, 20);
+
+  TestCache.clear();
+  EXPECT_FALSE(TestCache.get(1).hasValue());
+  EXPECT_FALSE(TestCache.get(2).hasValue());
+}
+
+TEST(Cache, DestroysValues) {
+  TrackedValue::LiveCount = 0;
+  {
+    Cache<int, TrackedValue> TestCache("test");
+    TestCache.set(1, TrackedValue(10));
+    TestCache.set(2, TrackedValue(20));
+
+    // Replacing and removing entries destroys the stored copies.
+    TestCache.set(1, TrackedValue(11));
+    TestCache.remove(2);
+    EXPECT_EQ(1, TrackedValue::LiveCount);
+    EXPECT_EQ(11, TestCache.get(1)->Payload);
+  }
+  // Destroying the cache destroys the remaining entries.
+  EXPECT_EQ(0, TrackedValue::LiveCount);
+}
@@ -1,4 +1,5 @@
 #include "swift/Basic/ClusteredBitVector.h"
+#include "llvm/ADT/APInt.h"
 #include "gtest/gtest.h"
 
 using namespace swift;
@@ -208,3 +209,36 @@ TEST(ClusteredBitVector, FlipAllBig) {
   EXPECT_EQ(true, vec[7]);
   EXPECT_EQ(1u, vec.count());
 }
+
+TEST(ClusteredBitVector, FromAPInt) {
+  // All-zero values keep the compact representation.
+  auto zeros = ClusteredBitVector::fromAPInt(llvm::APInt(163, 0));
+  EXPECT_EQ(163u, zeros.size());
+  EXPECT_EQ(0u, zeros.count());
+
+  // A single-word value.
+  auto small = ClusteredBitVector::fromAPInt(llvm::APInt(21, 0x55));
+  EXPECT_EQ(21u, small.size());
+  EXPECT_EQ(4u, small.count());
+  EXPECT_EQ(true, small[0]);
+  EXPECT_EQ(false, small[1]);
+  EXPECT_EQ(true, small[6]);
+  EXPECT_EQ(false, small[20]);
+
+  // A multi-word value with a partial last word.
+  llvm::APInt wide(163, 0);
+  wide.setBit(0);
+  wide.setBit(64);
+  wide.setBit(127);
+  wide.setBit(162);
+  auto big = ClusteredBitVector::fromAPInt(wide);
+  EXPECT_EQ(163u, big.size());
+  EXPECT_EQ(4u, big.count());
+  EXPECT_EQ(true, big[0]);
+  EXPECT_EQ(true, big[64]);
+  EXPECT_EQ(true, big[127]);
+  EXPECT_EQ(true, big[162]);
+  EXPECT_EQ(false, big[1]);
+  EXPECT_EQ(false, big[128]);
+  EXPECT_EQ(wide, big.asAPInt());
+}
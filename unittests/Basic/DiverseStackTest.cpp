@@ -0,0 +1,137 @@
+//===--- DiverseStackTest.cpp ---------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2016 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/DiverseStack.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace swift;
+
+namespace {
+
+struct ValueEntry {
+  unsigned Size;
+  unsigned Value;
+  unsigned allocated_size() const { return Size; }
+};
+
+template <unsigned PaddingSize>
+struct PaddedEntry : ValueEntry {
+  char Padding[PaddingSize];
+  explicit PaddedEntry(unsigned value) {
+    Size = sizeof(*this);
+    Value = value;
+    Padding[0] = 0;
+  }
+};
+
+using SmallEntry = PaddedEntry<8>;
+using LargeEntry = PaddedEntry<40>;
+
+} // end anonymous namespace
+
+TEST(DiverseStack, PushPopInline) {
+  DiverseStack<ValueEntry, 64> stack;
+  EXPECT_TRUE(stack.empty());
+  stack.push<SmallEntry>(1);
+  stack.push<SmallEntry>(2);
+  EXPECT_EQ(2u, stack.top().Value);
+  stack.pop();
+  EXPECT_EQ(1u, stack.top().Value);
+  stack.pop();
+  EXPECT_TRUE(stack.empty());
+  EXPECT_TRUE(stack.begin() == stack.end());
+}
+
+TEST(DiverseStack, GrowthPreservesObjects) {
+  // Push far past the inline capacity, so that the stack has to chain in
+  // several segments.
+  DiverseStack<ValueEntry, 64> stack;
+  for (unsigned i = 0; i != 100; ++i)
+    stack.push<LargeEntry>(i);
+
+  // Iteration visits the objects from the top of the stack down, across
+  // all segments.
+  unsigned expected = 100;
+  for (ValueEntry &entry : stack)
+    EXPECT_EQ(--expected, entry.Value);
+  EXPECT_EQ(0u, expected);
+
+  for (unsigned i = 100; i != 0; --i) {
+    EXPECT_EQ(i - 1, stack.top().Value);
+    stack.pop();
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(DiverseStack, StableIteratorsAcrossGrowth) {
+  DiverseStack<ValueEntry, 64> stack;
+  std::vector<DiverseStackImpl<ValueEntry>::stable_iterator> handles;
+  for (unsigned i = 0; i != 50; ++i) {
+    stack.push<SmallEntry>(i);
+    handles.push_back(stack.stable_begin());
+  }
+
+  // Handles taken before the stack grew still find their objects, and
+  // stabilizing the found iterator round-trips.
+  for (unsigned i = 0; i != 50; ++i) {
+    auto it = stack.find(handles[i]);
+    EXPECT_EQ(i, it->Value);
+    EXPECT_TRUE(handles[i] == stack.stabilize(it));
+  }
+
+  // Walking off the deepest object reaches the end of the stack.
+  auto bottom = stack.find(handles[0]);
+  EXPECT_TRUE(++bottom == stack.end());
+}
+
+TEST(DiverseStack, PushPopAtSegmentBoundary) {
+  DiverseStack<ValueEntry, 64> stack;
+  for (unsigned i = 0; i != 16; ++i)
+    stack.push<LargeEntry>(i);
+
+  // Repeatedly popping back into an older segment and pushing again must
+  // preserve the remaining objects.
+  for (unsigned round = 0; round != 100; ++round) {
+    EXPECT_EQ(15u, stack.top().Value);
+    stack.pop();
+    EXPECT_EQ(14u, stack.top().Value);
+    stack.push<LargeEntry>(15);
+  }
+
+  for (unsigned i = 16; i != 0; --i) {
+    EXPECT_EQ(i - 1, stack.top().Value);
+    stack.pop();
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(DiverseStack, CopyAndMove) {
+  DiverseStack<ValueEntry, 64> stack;
+  for (unsigned i = 0; i != 20; ++i)
+    stack.push<LargeEntry>(i);
+
+  // A copy is contiguous but visits the same objects.
+  DiverseStack<ValueEntry, 64> copy(stack);
+  unsigned expected = 20;
+  for (ValueEntry &entry : copy)
+    EXPECT_EQ(--expected, entry.Value);
+  EXPECT_EQ(0u, expected);
+
+  // Moving steals the allocations when possible and works regardless.
+  DiverseStack<ValueEntry, 64> moved(std::move(copy));
+  expected = 20;
+  for (ValueEntry &entry : moved)
+    EXPECT_EQ(--expected, entry.Value);
+  EXPECT_EQ(0u, expected);
+}
@@ -126,3 +126,26 @@ TEST(TreeScopedHashTableTest, IteratorTest) {
   delete S1;
 }
 
+
+TEST(TreeScopedHashTableTest, BumpPtrAllocatedDetach) {
+  using HashtableTy =
+      TreeScopedHashTable<unsigned, unsigned, llvm::BumpPtrAllocator>;
+  using ScopeTy = HashtableTy::ScopeTy;
+  using DetachedScopeTy = HashtableTy::DetachedScopeTy;
+  HashtableTy HT;
+
+  auto S1 = new ScopeTy(HT, 0);
+  HT.insertIntoScope(*S1, 1, 1001);
+
+  auto S2 = new ScopeTy(HT, S1);
+  HT.insertIntoScope(*S2, 2, 2002);
+  DetachedScopeTy Detached = S2->detach();
+  delete S2;
+
+  // The detached scope keeps its entries alive after the stack scope dies.
+  ScopeTy Reentered(std::move(Detached));
+  EXPECT_EQ(1001U, HT.lookup(Reentered, 1));
+  EXPECT_EQ(2002U, HT.lookup(Reentered, 2));
+
+  delete S1;
+}
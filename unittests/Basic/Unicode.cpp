@@ -1,6 +1,9 @@
 #include "swift/Basic/Unicode.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "gtest/gtest.h"
 
+using namespace swift;
 using namespace swift::unicode;
 
 TEST(ExtractExtendedGraphemeCluster, Test1) {
@@ -13,3 +16,65 @@ TEST(IsSingleExtendedGraphemeCluster, Test1) {
   EXPECT_EQ(false, isSingleExtendedGraphemeCluster(""));
   EXPECT_EQ(true, isSingleExtendedGraphemeCluster("a"));
 }
+
+TEST(IsWellFormedUTF8, Test1) {
+  EXPECT_TRUE(isWellFormedUTF8(""));
+  EXPECT_TRUE(isWellFormedUTF8("abc"));
+  EXPECT_TRUE(isWellFormedUTF8("aéb一c\U0001F600d"));
+  // A long ASCII string exercises the word-at-a-time fast path.
+  EXPECT_TRUE(isWellFormedUTF8("the quick brown fox jumps over the lazy dog"));
+
+  // Lone continuation byte.
+  EXPECT_FALSE(isWellFormedUTF8("\x80"));
+  // Truncated two-byte sequence.
+  EXPECT_FALSE(isWellFormedUTF8("\xc3"));
+  // Overlong encoding of '/'.
+  EXPECT_FALSE(isWellFormedUTF8("\xc0\xaf"));
+  // Invalid sequence after an ASCII prefix long enough for the fast path.
+  EXPECT_FALSE(isWellFormedUTF8("0123456789abcdef\xff"));
+}
+
+TEST(ConvertUTF8ToUTF16, Test1) {
+  SmallVector<uint16_t, 16> Result;
+  EXPECT_TRUE(convertUTF8ToUTF16("abc", Result));
+  ASSERT_EQ(3u, Result.size());
+  EXPECT_EQ('a', Result[0]);
+  EXPECT_EQ('b', Result[1]);
+  EXPECT_EQ('c', Result[2]);
+
+  // U+00E9 and U+4E00 are single code units; U+1F600 is a surrogate pair.
+  Result.clear();
+  EXPECT_TRUE(convertUTF8ToUTF16("aé一\U0001F600", Result));
+  ASSERT_EQ(5u, Result.size());
+  EXPECT_EQ(0x61u, Result[0]);
+  EXPECT_EQ(0xe9u, Result[1]);
+  EXPECT_EQ(0x4e00u, Result[2]);
+  EXPECT_EQ(0xd83du, Result[3]);
+  EXPECT_EQ(0xde00u, Result[4]);
+
+  Result.clear();
+  EXPECT_FALSE(convertUTF8ToUTF16("\xc0\xaf", Result));
+}
+
+TEST(ConvertUTF16ToUTF8, Test1) {
+  const uint16_t Mixed[] = {0x61, 0xe9, 0x4e00, 0xd83d, 0xde00, 0x62};
+  SmallVector<char, 16> Result;
+  EXPECT_TRUE(convertUTF16ToUTF8(Mixed, Result));
+  EXPECT_EQ("aé一\U0001F600b",
+            StringRef(Result.data(), Result.size()));
+
+  // An unpaired surrogate is rejected.
+  const uint16_t Unpaired[] = {0x61, 0xd83d, 0x62};
+  Result.clear();
+  EXPECT_FALSE(convertUTF16ToUTF8(Unpaired, Result));
+}
+
+TEST(GetUTF16Length, Test1) {
+  EXPECT_EQ(0u, getUTF16Length(""));
+  EXPECT_EQ(3u, getUTF16Length("abc"));
+  // One unit each for U+0061, U+00E9 and U+4E00; two for U+1F600.
+  EXPECT_EQ(5u, getUTF16Length("aé一\U0001F600"));
+  // A long ASCII string exercises the word-at-a-time fast path.
+  EXPECT_EQ(43u,
+            getUTF16Length("the quick brown fox jumps over the lazy dog"));
+}
@@ -542,6 +542,78 @@ TEST(DependencyGraph, MarkOneNodeTwice2) {
   EXPECT_TRUE(graph.isMarked(2));
 }
 
+TEST(DependencyGraph, MarkOnlyChangedProvides) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0, "provides-nominal: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-nominal: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(2, "depends-nominal: [b]"),
+            LoadResult::UpToDate);
+
+  // Reload 0 with an additional provided name. Only the dependents of the
+  // new name should be marked.
+  EXPECT_EQ(graph.loadFromString(0, "provides-nominal: [a, b]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0, nullptr, /*onlyChangedProvides=*/true);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(2u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_FALSE(graph.isMarked(1));
+  EXPECT_TRUE(graph.isMarked(2));
+}
+
+TEST(DependencyGraph, MarkChangedProvidesNothingNew) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0, "provides-nominal: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-nominal: [a]"),
+            LoadResult::UpToDate);
+
+  // Reload 0 with identical provides. Nothing changed, so nothing
+  // downstream should be marked.
+  EXPECT_EQ(graph.loadFromString(0, "provides-nominal: [a]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0, nullptr, /*onlyChangedProvides=*/true);
+  EXPECT_EQ(0u, marked.size());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_FALSE(graph.isMarked(1));
+}
+
+TEST(DependencyGraph, MarkChangedProvidesInterfaceHash) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "interface-hash: aaa\n"
+                                 "provides-nominal: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-nominal: [a]"),
+            LoadResult::UpToDate);
+
+  // A changed interface hash can't be attributed to a particular name, so
+  // every provided name counts as changed.
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "interface-hash: bbb\n"
+                                 "provides-nominal: [a]"),
+            LoadResult::AffectsDownstream);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0, nullptr, /*onlyChangedProvides=*/true);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_TRUE(graph.isMarked(1));
+}
+
 TEST(DependencyGraph, NotTransitiveOnceMarked) {
   DependencyGraph<uintptr_t> graph;
 
@@ -352,3 +352,22 @@ TEST_F(LexerTest, NestedPlaceholder) {
   std::vector<Token> Toks = checkLex(Source, ExpectedTokens);
   EXPECT_EQ("<#aa#>", Toks[2].getText());
 }
+
+TEST_F(LexerTest, GetEncodedStringSegmentNoCopy) {
+  // Without escape sequences the segment is returned directly and the
+  // scratch buffer is left empty.
+  StringRef Segment("just some plain text");
+  SmallString<16> Buf;
+  StringRef Encoded = Lexer::getEncodedStringSegment(Segment, Buf);
+  EXPECT_EQ(Segment.begin(), Encoded.begin());
+  EXPECT_EQ(Segment, Encoded);
+  EXPECT_TRUE(Buf.empty());
+}
+
+TEST_F(LexerTest, GetEncodedStringSegmentEscapes) {
+  StringRef Segment("head\\n\\u{48}\\ttail");
+  SmallString<16> Buf;
+  StringRef Encoded = Lexer::getEncodedStringSegment(Segment, Buf);
+  EXPECT_EQ("head\nH\ttail", Encoded);
+  EXPECT_EQ(Buf.begin(), Encoded.begin());
+}
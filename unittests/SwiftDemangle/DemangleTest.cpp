@@ -60,3 +60,32 @@ TEST(FunctionNameDemangleTests, IgnoresNonMangledInputs) {
   EXPECT_STREQ("0123456789abcdef", OutputBuffer);
 }
 
+
+TEST(FunctionNameDemangleTests, BatchDemangles) {
+  const char *FunctionNames[] = {
+    "_TFC3foo3bar3basfT3zimCS_3zim_T_",
+    "printf",
+    "_TF4main3fooFT3argGSqGSaSi___T_",
+    // A duplicate, which should be served from the cache.
+    "_TFC3foo3bar3basfT3zimCS_3zim_T_",
+  };
+  const char *DemangledName = "foo.bar.bas (zim : foo.zim) -> ()";
+  const char *DemangledNameWithSugar = "main.foo (arg : [Swift.Int]?) -> ()";
+
+  char Buffers[4][128];
+  strcpy(Buffers[1], "untouched");
+  char *OutputBuffers[] = { Buffers[0], Buffers[1], Buffers[2], Buffers[3] };
+  const size_t BufferLengths[] = { sizeof(Buffers[0]), sizeof(Buffers[1]),
+                                   sizeof(Buffers[2]), sizeof(Buffers[3]) };
+
+  size_t Result = swift_demangle_getDemangledNames(FunctionNames,
+                                                   OutputBuffers,
+                                                   BufferLengths,
+                                                   /*NumNames=*/4);
+
+  EXPECT_EQ(3U, Result);
+  EXPECT_STREQ(DemangledName, Buffers[0]);
+  EXPECT_STREQ("untouched", Buffers[1]);
+  EXPECT_STREQ(DemangledNameWithSugar, Buffers[2]);
+  EXPECT_STREQ(DemangledName, Buffers[3]);
+}
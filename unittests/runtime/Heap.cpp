@@ -0,0 +1,80 @@
+//===--- swift/unittests/runtime/Heap.cpp - Heap allocation tests ---------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2015 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://swift.org/LICENSE.txt for license information
+// See http://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Heap.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace swift;
+
+TEST(HeapTest, slowAllocAlignment) {
+  // Small allocations must be aligned like a heap object.
+  const size_t alignMask = alignof(HeapObject) - 1;
+  for (size_t size = 1; size <= 512; size += 7) {
+    void *ptr = swift_slowAlloc(size, alignMask);
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_EQ((uintptr_t)ptr & alignMask, 0u);
+    memset(ptr, 0xab, size);
+    swift_slowDealloc(ptr, size, alignMask);
+  }
+}
+
+TEST(HeapTest, slowAllocReuse) {
+  // A freed small block is reused for the next allocation of the same size
+  // on the same thread.
+  void *first = swift_slowAlloc(32, 7);
+  swift_slowDealloc(first, 32, 7);
+  void *second = swift_slowAlloc(32, 7);
+  EXPECT_EQ(first, second);
+  swift_slowDealloc(second, 32, 7);
+}
+
+TEST(HeapTest, magazineBlockSize) {
+  // A magazine block reports its rounded-up block size; memory from the
+  // system allocator reports 0.
+  void *small = swift_slowAlloc(20, 7);
+  EXPECT_EQ(32u, swift_magazineBlockSize(small));
+  void *large = swift_slowAlloc(1024, 7);
+  EXPECT_EQ(0u, swift_magazineBlockSize(large));
+  swift_slowDealloc(small, 20, 7);
+  swift_slowDealloc(large, 1024, 7);
+}
+
+TEST(HeapTest, slowDeallocUsableSize) {
+  // Deallocating with the reported usable size instead of the original
+  // request size must return the block to the same size class.
+  void *first = swift_slowAlloc(20, 7);
+  swift_slowDealloc(first, swift_magazineBlockSize(first), 7);
+  void *second = swift_slowAlloc(20, 7);
+  EXPECT_EQ(first, second);
+  swift_slowDealloc(second, 20, 7);
+}
+
+TEST(HeapTest, slowAllocCrossThread) {
+  // Memory allocated on one thread can be freed on another.
+  const size_t numAllocations = 10000;
+  std::vector<void *> ptrs;
+  ptrs.reserve(numAllocations);
+  std::thread allocator([&] {
+    for (size_t i = 0; i < numAllocations; ++i) {
+      void *ptr = swift_slowAlloc(16 + (i % 4) * 16, 7);
+      memset(ptr, 0xcd, 16);
+      ptrs.push_back(ptr);
+    }
+  });
+  allocator.join();
+  for (size_t i = 0; i < numAllocations; ++i)
+    swift_slowDealloc(ptrs[i], 16 + (i % 4) * 16, 7);
+}
@@ -145,6 +145,23 @@ TEST(WeakTest, simple_objc) {
   swift_unknownWeakDestroy(&ref1);
 }
 
+TEST(WeakTest, unknown_tagged_pointer_payload_bits) {
+  // A tagged pointer keeps its payload in the non-reserved bits, so a
+  // payload that happens to have bit 1 set must not be mistaken for a
+  // native weak side-table entry.
+  void *tagged =
+    (void *)(heap_object_abi::ObjCReservedBitsMask | (uintptr_t)0x6);
+
+  WeakReference ref;
+  swift_unknownWeakInit(&ref, tagged);
+
+  void *result = swift_unknownWeakLoadStrong(&ref);
+  ASSERT_EQ(tagged, result);
+
+  result = swift_unknownWeakTakeStrong(&ref);
+  ASSERT_EQ(tagged, result);
+}
+
 TEST(WeakTest, simple_swift_as_unknown) {
   void *o1 = make_swift_object();
   void *o2 = make_swift_object();
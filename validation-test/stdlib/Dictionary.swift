@@ -3886,6 +3886,35 @@ DictionaryTestSuite.test("removeAtIndex") {
   }
 }
 
+DictionaryTestSuite.test("CapacityReservation") {
+  // Pre-sized storage holds the requested number of pairs without
+  // reallocating.
+  var d = Dictionary<Int, Int>(minimumCapacity: 32)
+  let originalCapacity = d._variantStorage.native.capacity
+  for i in 0..<32 {
+    d[i] = i * 10
+  }
+  assert(d._variantStorage.native.capacity == originalCapacity)
+
+  var d2 = Dictionary<Int, Int>()
+  d2.reserveCapacity(128)
+  let reservedCapacity = d2._variantStorage.native.capacity
+  for i in 0..<128 {
+    d2[i] = i * 10
+  }
+  assert(d2._variantStorage.native.capacity == reservedCapacity)
+  assert(d2.count == 128)
+}
+
+DictionaryTestSuite.test("init(uniqueKeysWithValues:)") {
+  let d = Dictionary(uniqueKeysWithValues: [(10, 1010), (20, 1020), (30, 1030)])
+  assert(d.count == 3)
+  assert(d[10]! == 1010)
+  assert(d[20]! == 1020)
+  assert(d[30]! == 1030)
+  assert(d[40] == nil)
+}
+
 DictionaryTestSuite.setUp {
   resetLeaksOfDictionaryKeysValues()
 }
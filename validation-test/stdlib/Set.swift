@@ -3701,4 +3701,24 @@ SetTestSuite.test("mutationDoesNotAffectGenerator/removeAll,keepCapacity=true")
   expectEqualsUnordered([ 1010, 1020, 1030 ], Array(GeneratorSequence(g)))
 }
 
+SetTestSuite.test("CapacityReservation") {
+  // Pre-sized storage holds the requested number of elements without
+  // reallocating.
+  var s = Set<Int>(minimumCapacity: 32)
+  let originalCapacity = s._variantStorage.native.capacity
+  for i in 0..<32 {
+    s.insert(i)
+  }
+  expectEqual(originalCapacity, s._variantStorage.native.capacity)
+
+  var s2 = Set<Int>()
+  s2.reserveCapacity(128)
+  let reservedCapacity = s2._variantStorage.native.capacity
+  for i in 0..<128 {
+    s2.insert(i)
+  }
+  expectEqual(reservedCapacity, s2._variantStorage.native.capacity)
+  expectEqual(128, s2.count)
+}
+
 runAllTests()
@@ -902,6 +902,26 @@ StringTests.test(
     String._compareDeterministicUnicodeCollation, String._compareASCII)
 }
 
+#if !_runtime(_ObjC)
+// Check that the ASCII fast path of the collation agrees with the Unicode
+// Collation Algorithm on multi-character strings: all primary weights are
+// compared before the lower levels are consulted, and zero weight characters
+// are ignored.
+StringTests.test("asciiCollationFastPath") {
+  // Equal strings, decided by the memcmp fast path.
+  expectEqual(0, "abcdefgh"._compareDeterministicUnicodeCollation("abcdefgh"))
+  // A string is greater than any of its proper prefixes.
+  expectLT("ab"._compareDeterministicUnicodeCollation("abc"), 0)
+  // The primary weights decide before case is considered: 'b' > 'a' wins
+  // over 'a' < 'A'.
+  expectGT("ab"._compareDeterministicUnicodeCollation("Aa"), 0)
+  // With equal primary weights, lowercase sorts before uppercase.
+  expectLT("aB"._compareDeterministicUnicodeCollation("Ab"), 0)
+  // Zero weight characters don't participate in the ordering.
+  expectEqual(0, "a\u{0}b"._compareDeterministicUnicodeCollation("ab"))
+}
+#endif
+
 StringTests.test("lowercaseString") {
   // Use setlocale so tolower() is correct on ASCII.
   setlocale(LC_ALL, "C")